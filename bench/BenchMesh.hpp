@@ -0,0 +1,106 @@
+#ifndef BENCH_MESH_HPP_
+#define BENCH_MESH_HPP_
+#include <IModel.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Only the index range and the bounds are read by the mesh tools.
+class BenchModel final : public IModel {
+public:
+	BenchModel(
+		std::uint32_t indexOffset, std::uint32_t indexCount, const ModelBounds& bounds
+	) noexcept : m_indexOffset{ indexOffset }, m_indexCount{ indexCount }, m_bounds{ bounds } {}
+
+	[[nodiscard]]
+	std::uint32_t GetIndexCount() const noexcept override { return m_indexCount; }
+	[[nodiscard]]
+	std::uint32_t GetIndexOffset() const noexcept override { return m_indexOffset; }
+	[[nodiscard]]
+	std::uint32_t GetDiffuseTexIndex() const noexcept override { return 0u; }
+	[[nodiscard]]
+	UVInfo GetDiffuseTexUVInfo() const noexcept override { return {}; }
+	[[nodiscard]]
+	std::uint32_t GetSpecularTexIndex() const noexcept override { return 0u; }
+	[[nodiscard]]
+	UVInfo GetSpecularTexUVInfo() const noexcept override { return {}; }
+	[[nodiscard]]
+	DirectX::XMMATRIX GetModelMatrix() const noexcept override {
+		return DirectX::XMMatrixIdentity();
+	}
+	[[nodiscard]]
+	DirectX::XMFLOAT3 GetModelOffset() const noexcept override { return {}; }
+	[[nodiscard]]
+	ModelBounds GetBoundingBox() const noexcept override { return m_bounds; }
+	[[nodiscard]]
+	Material GetMaterial() const noexcept override { return {}; }
+	[[nodiscard]]
+	bool IsLightSource() const noexcept override { return false; }
+
+private:
+	std::uint32_t m_indexOffset;
+	std::uint32_t m_indexCount;
+	ModelBounds m_bounds;
+};
+
+struct BenchMesh {
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	std::vector<std::shared_ptr<IModel>> models;
+};
+
+// Each model is a grid of quads in the XY plane with vertices of its own, the grids are placed
+// one after the other along X.
+[[nodiscard]]
+inline BenchMesh CreateGridMesh(size_t modelCount, size_t columns, size_t rows) {
+	BenchMesh mesh{};
+
+	const auto stride = static_cast<std::uint32_t>(columns + 1u);
+
+	for (size_t modelIndex = 0u; modelIndex < modelCount; ++modelIndex) {
+		const auto firstVertex = static_cast<std::uint32_t>(std::size(mesh.vertices));
+		const auto indexOffset = static_cast<std::uint32_t>(std::size(mesh.indices));
+		const auto start = static_cast<float>(modelIndex * (columns + 1u));
+
+		for (size_t row = 0u; row <= rows; ++row)
+			for (size_t column = 0u; column <= columns; ++column)
+				mesh.vertices.emplace_back(
+					Vertex{
+						.position = {
+							start + static_cast<float>(column), static_cast<float>(row), 0.f
+						},
+						.normal = { 0.f, 0.f, -1.f },
+						.uv = {
+							static_cast<float>(column) / static_cast<float>(columns),
+							static_cast<float>(row) / static_cast<float>(rows)
+						}
+					}
+				);
+
+		for (size_t row = 0u; row < rows; ++row)
+			for (size_t column = 0u; column < columns; ++column) {
+				const auto corner = firstVertex + static_cast<std::uint32_t>(row * stride + column);
+
+				mesh.indices.insert(
+					std::end(mesh.indices),
+					{ corner, corner + stride, corner + 1u, corner + 1u, corner + stride,
+						corner + stride + 1u }
+				);
+			}
+
+		mesh.models.emplace_back(
+			std::make_shared<BenchModel>(
+				indexOffset, static_cast<std::uint32_t>(std::size(mesh.indices)) - indexOffset,
+				ModelBounds{
+					.positiveAxes = {
+						start + static_cast<float>(columns), static_cast<float>(rows), 0.f
+					},
+					.negativeAxes = { start, 0.f, 0.f }
+				}
+			)
+		);
+	}
+
+	return mesh;
+}
+#endif
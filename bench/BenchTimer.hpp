@@ -0,0 +1,35 @@
+#ifndef BENCH_TIMER_HPP_
+#define BENCH_TIMER_HPP_
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Runs the function runCount times and returns the median run in milliseconds, which a run
+// disturbed by the rest of the machine doesn't move.
+template<typename Function>
+[[nodiscard]]
+double MeasureMilliseconds(size_t runCount, Function&& function) {
+	std::vector<double> runMilliseconds;
+
+	for (size_t run = 0u; run < runCount; ++run) {
+		const auto start = std::chrono::steady_clock::now();
+
+		function();
+
+		runMilliseconds.emplace_back(
+			std::chrono::duration<double, std::milli>{
+				std::chrono::steady_clock::now() - start
+			}.count()
+		);
+	}
+
+	std::ranges::sort(runMilliseconds);
+
+	return runMilliseconds[runCount / 2u];
+}
+
+inline void PrintResult(char const* name, size_t count, double milliseconds) {
+	std::printf("%-40s %10zu %12.3f ms\n", name, count, milliseconds);
+}
+#endif
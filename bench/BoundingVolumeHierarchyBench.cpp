@@ -0,0 +1,189 @@
+#include <BoundingVolumeHierarchy.hpp>
+#include <BenchTimer.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	float Next(float minimum, float maximum) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return minimum + (maximum - minimum) * static_cast<float>(m_state >> 8u) / 16777216.f;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+// The world grows with the model count, so the density stays the same.
+static void PlaceModel(
+	ModelTransformStore& modelStore, size_t modelId, float worldExtent, Random& random
+) noexcept {
+	const float halfSize = random.Next(0.5f, 3.f);
+
+	modelStore.SetBoundingBox(
+		modelId, ModelBounds{
+			.positiveAxes = { halfSize, halfSize, halfSize },
+			.negativeAxes = { -halfSize, -halfSize, -halfSize }
+		}
+	);
+	modelStore.SetModelMatrix(
+		modelId,
+		XMMatrixTranslation(
+			random.Next(-worldExtent, worldExtent), random.Next(-worldExtent, worldExtent),
+			random.Next(-worldExtent, worldExtent)
+		)
+	);
+}
+
+// Refitting is meant for models which move a little each frame.
+static void MoveModel(ModelTransformStore& modelStore, size_t modelId, Random& random) noexcept {
+	modelStore.SetModelMatrix(
+		modelId,
+		XMLoadFloat4x4(&modelStore.GetModelMatrices()[modelId])
+		* XMMatrixTranslation(
+			random.Next(-0.5f, 0.5f), random.Next(-0.5f, 0.5f), random.Next(-0.5f, 0.5f)
+		)
+	);
+}
+
+static void BenchModelCount(size_t modelCount) {
+	const float worldExtent =
+		100.f * std::cbrt(static_cast<float>(modelCount) / 10'000.f);
+
+	Random random{ 11u };
+	ModelTransformStore modelStore{ 1u };
+
+	for (size_t modelIndex = 0u; modelIndex < modelCount; ++modelIndex)
+		PlaceModel(modelStore, modelStore.AddModel(), worldExtent, random);
+
+	PrintResult(
+		"Build", modelCount,
+		MeasureMilliseconds(
+			5u,
+			[&modelStore] {
+				BoundingVolumeHierarchy boundingVolumeHierarchy{};
+				boundingVolumeHierarchy.Update(modelStore);
+			}
+		)
+	);
+
+	BoundingVolumeHierarchy boundingVolumeHierarchy{};
+	boundingVolumeHierarchy.Update(modelStore);
+
+	// A tenth of the models move every frame.
+	PrintResult(
+		"Refit, a tenth moved", modelCount,
+		MeasureMilliseconds(
+			11u,
+			[&] {
+				for (size_t modelId = 0u; modelId < modelCount; modelId += 10u)
+					MoveModel(modelStore, modelId, random);
+
+				boundingVolumeHierarchy.Update(modelStore);
+			}
+		)
+	);
+
+	// A hundredth of the count is added each time, as AddModelSet would.
+	PrintResult(
+		"Incremental insert, 1% new", modelCount / 100u,
+		MeasureMilliseconds(
+			5u,
+			[&] {
+				for (size_t modelIndex = 0u; modelIndex < modelCount / 100u; ++modelIndex)
+					PlaceModel(modelStore, modelStore.AddModel(), worldExtent, random);
+
+				boundingVolumeHierarchy.Update(modelStore);
+			}
+		)
+	);
+
+	const size_t storeModelCount = modelStore.GetModelCount();
+	std::vector<AxisAlignedBox> worldBoxes(storeModelCount);
+
+	for (size_t modelId = 0u; modelId < storeModelCount; ++modelId)
+		worldBoxes[modelId] = GetWorldBox(
+			modelStore.GetModelMatrices()[modelId], modelStore.GetModelOffsets()[modelId],
+			modelStore.GetBoundingBoxes()[modelId]
+		);
+
+	// From outside the world, looking at its centre with a narrow field of view.
+	const XMMATRIX viewProjection =
+		XMMatrixLookAtLH(
+			XMVectorSet(0.f, 0.f, -2.f * worldExtent, 1.f), XMVectorZero(),
+			XMVectorSet(0.f, 1.f, 0.f, 0.f)
+		)
+		* XMMatrixPerspectiveFovLH(
+			XMConvertToRadians(10.f), 16.f / 9.f, 1.f, 4.f * worldExtent
+		);
+
+	FrustumCuller frustum{};
+	frustum.SetViewProjection(viewProjection);
+
+	std::vector<std::uint32_t> modelIds;
+	modelIds.reserve(storeModelCount);
+
+	double milliseconds = MeasureMilliseconds(
+		11u,
+		[&] {
+			modelIds.clear();
+
+			for (size_t modelId = 0u; modelId < storeModelCount; ++modelId)
+				if (frustum.TestBox(worldBoxes[modelId]) != FrustumTest::Outside)
+					modelIds.emplace_back(static_cast<std::uint32_t>(modelId));
+		}
+	);
+	PrintResult("Frustum, every box tested", std::size(modelIds), milliseconds);
+
+	milliseconds = MeasureMilliseconds(
+		11u,
+		[&] {
+			modelIds.clear();
+			boundingVolumeHierarchy.QueryFrustum(frustum, modelIds);
+		}
+	);
+	PrintResult("Frustum query", std::size(modelIds), milliseconds);
+
+	const float boxExtent = worldExtent / 10.f;
+	const AxisAlignedBox queryBox{
+		.minimum = { -boxExtent, -boxExtent, -boxExtent },
+		.maximum = { boxExtent, boxExtent, boxExtent }
+	};
+
+	milliseconds = MeasureMilliseconds(
+		11u,
+		[&] {
+			modelIds.clear();
+			boundingVolumeHierarchy.QueryBox(queryBox, modelIds);
+		}
+	);
+	PrintResult("Box query", std::size(modelIds), milliseconds);
+
+	milliseconds = MeasureMilliseconds(
+		11u,
+		[&] {
+			modelIds.clear();
+			boundingVolumeHierarchy.QueryRay(
+				XMFLOAT3{ -worldExtent, -worldExtent, -worldExtent }, XMFLOAT3{ 1.f, 1.f, 1.f },
+				2.f * worldExtent, modelIds
+			);
+		}
+	);
+	PrintResult("Ray query", std::size(modelIds), milliseconds);
+}
+
+// The count is of the models updated or found.
+int main() {
+	std::printf("%-40s %10s %15s\n", "Bounding volume hierarchy", "Count", "Median");
+
+	for (size_t modelCount : { 10'000u, 100'000u, 1'000'000u })
+		BenchModelCount(modelCount);
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include <MeshletBuilder.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <BenchMesh.hpp>
+#include <BenchTimer.hpp>
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+// Exported meshes rarely keep their triangles in order, so the adjacency has to be followed.
+static void ShuffleTriangles(BenchMesh& mesh) {
+	Random random{ 3u };
+
+	for (const std::shared_ptr<IModel>& model : mesh.models) {
+		std::uint32_t* triangles = std::data(mesh.indices) + model->GetIndexOffset();
+		const std::uint32_t triangleCount = model->GetIndexCount() / 3u;
+
+		for (std::uint32_t triangle = triangleCount; triangle > 1u; --triangle)
+			std::swap_ranges(
+				triangles + (triangle - 1u) * 3u, triangles + triangle * 3u,
+				triangles + random.Next(triangle) * 3u
+			);
+	}
+}
+
+static void BenchMeshletBuild(char const* name, const BenchMesh& mesh, IThreadPool* pool) {
+	const MeshletBuilder meshletBuilder{ MeshletBuilder::Args{ .threadPool = pool } };
+	MeshletBuilder::MeshletData meshletData{};
+
+	PrintResult(
+		name, std::size(mesh.indices) / 3u,
+		MeasureMilliseconds(
+			5u,
+			[&meshletBuilder, &meshletData, &mesh] {
+				meshletData = meshletBuilder.BuildMeshlets(mesh.vertices, mesh.indices, mesh.models);
+			}
+		)
+	);
+
+	const MeshletBuilder::MeshletStats stats = meshletBuilder.GetMeshletStats(meshletData);
+
+	std::printf(
+		"  %zu meshlets, vertex fill %.2f, primitive fill %.2f, %.3f vertices per triangle\n",
+		stats.meshletCount, stats.vertexFillRatio, stats.primitiveFillRatio,
+		stats.verticesPerTriangle
+	);
+}
+
+static void BenchMeshSet(char const* title, BenchMesh mesh, IThreadPool& pool) {
+	std::printf("%s\n", title);
+
+	BenchMeshletBuild("Serial", mesh, nullptr);
+	BenchMeshletBuild("Models on the pool", mesh, &pool);
+
+	ShuffleTriangles(mesh);
+
+	BenchMeshletBuild("Shuffled triangles, serial", mesh, nullptr);
+	BenchMeshletBuild("Shuffled triangles, models on the pool", mesh, &pool);
+}
+
+// The count is of the triangles.
+int main() {
+	std::printf(
+		"%-40s %10s %15s\n%u hardware threads\n", "Meshlet build", "Triangles", "Median",
+		std::thread::hardware_concurrency()
+	);
+
+	WorkStealingThreadPool pool{ WorkStealingThreadPool::Args{} };
+
+	BenchMeshSet("One model of 1000 x 720 quads", CreateGridMesh(1u, 1'000u, 720u), pool);
+	BenchMeshSet("2000 models of 24 x 12 quads", CreateGridMesh(2'000u, 24u, 12u), pool);
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include <ModelDataWriter.hpp>
+#include <JobRunner.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <BenchTimer.hpp>
+#include <thread>
+#include <vector>
+
+static void FillModelStore(ModelTransformStore& modelStore, size_t modelCount) {
+	for (size_t modelIndex = 0u; modelIndex < modelCount; ++modelIndex) {
+		const size_t modelId = modelStore.AddModel();
+		const auto offset = static_cast<float>(modelIndex);
+
+		modelStore.SetModelMatrix(
+			modelId,
+			DirectX::XMMatrixRotationRollPitchYaw(0.f, offset * 0.01f, 0.f)
+			* DirectX::XMMatrixTranslation(offset, 0.f, -offset)
+		);
+		modelStore.SetModelOffset(modelId, DirectX::XMFLOAT3{ offset, 0.f, -offset });
+	}
+}
+
+// Every model is written each frame, as after a camera move.
+static void BenchWriteModels(char const* name, size_t modelCount) {
+	ModelTransformStore modelStore{ 1u };
+	FillModelStore(modelStore, modelCount);
+
+	ModelDataWriter modelDataWriter{ modelStore };
+
+	std::vector<std::uint8_t> modelBuffer(sizeof(ModelDataWriter::ModelBuffer) * modelCount);
+	std::vector<std::uint8_t> materialBuffer(
+		sizeof(ModelDataWriter::MaterialBuffer) * modelCount
+	);
+
+	const DirectX::XMMATRIX viewMatrix = DirectX::XMMatrixLookAtLH(
+		DirectX::XMVectorSet(0.f, 10.f, -10.f, 1.f), DirectX::XMVectorZero(),
+		DirectX::XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	);
+
+	size_t modelsWritten = 0u;
+
+	const double milliseconds = MeasureMilliseconds(
+		21u,
+		[&] {
+			modelsWritten = modelDataWriter.WriteModels<false>(
+				std::data(modelBuffer), std::data(materialBuffer), 0u, viewMatrix, true, {}
+			).modelsWritten;
+		}
+	);
+
+	PrintResult(name, modelsWritten, milliseconds);
+}
+
+int main() {
+	std::printf(
+		"%-40s %10s %15s\n%u hardware threads\n", "Model data write", "Models", "Median",
+		std::thread::hardware_concurrency()
+	);
+
+	for (size_t modelCount : { 1'000u, 10'000u, 100'000u }) {
+		Gaia::threadPool.reset();
+
+		BenchWriteModels("Serial", modelCount);
+
+		Gaia::threadPool = std::make_shared<WorkStealingThreadPool>(
+			WorkStealingThreadPool::Args{}
+		);
+
+		// Below the threshold of the writer the pool isn't used.
+		BenchWriteModels("Chunked on the pool", modelCount);
+	}
+
+	Gaia::threadPool.reset();
+
+	return 0;
+}
@@ -0,0 +1,188 @@
+#include <ModelDataWriter.hpp>
+#include <BenchTimer.hpp>
+#include <memory>
+#include <vector>
+
+class BenchModel final : public IModel {
+public:
+	BenchModel(const DirectX::XMMATRIX& modelMatrix, const DirectX::XMFLOAT3& modelOffset)
+		: m_modelMatrix{}, m_modelOffset{ modelOffset } {
+		DirectX::XMStoreFloat4x4(&m_modelMatrix, modelMatrix);
+	}
+
+	[[nodiscard]]
+	std::uint32_t GetIndexCount() const noexcept override { return 0u; }
+	[[nodiscard]]
+	std::uint32_t GetIndexOffset() const noexcept override { return 0u; }
+	[[nodiscard]]
+	std::uint32_t GetDiffuseTexIndex() const noexcept override { return 0u; }
+	[[nodiscard]]
+	UVInfo GetDiffuseTexUVInfo() const noexcept override { return {}; }
+	[[nodiscard]]
+	std::uint32_t GetSpecularTexIndex() const noexcept override { return 0u; }
+	[[nodiscard]]
+	UVInfo GetSpecularTexUVInfo() const noexcept override { return {}; }
+	[[nodiscard]]
+	DirectX::XMMATRIX GetModelMatrix() const noexcept override {
+		return DirectX::XMLoadFloat4x4(&m_modelMatrix);
+	}
+	[[nodiscard]]
+	DirectX::XMFLOAT3 GetModelOffset() const noexcept override { return m_modelOffset; }
+	[[nodiscard]]
+	ModelBounds GetBoundingBox() const noexcept override {
+		return ModelBounds{
+			.positiveAxes = { 1.f, 1.f, 1.f }, .negativeAxes = { -1.f, -1.f, -1.f }
+		};
+	}
+	[[nodiscard]]
+	Material GetMaterial() const noexcept override { return {}; }
+	[[nodiscard]]
+	bool IsLightSource() const noexcept override { return false; }
+
+private:
+	DirectX::XMFLOAT4X4 m_modelMatrix;
+	DirectX::XMFLOAT3 m_modelOffset;
+};
+
+[[nodiscard]]
+static ModelMaterial GetModelMaterial(const IModel& model) noexcept {
+	const Material material = model.GetMaterial();
+
+	return ModelMaterial{
+		.ambient = material.ambient,
+		.diffuse = material.diffuse,
+		.specular = material.specular,
+		.diffuseTexUVInfo = model.GetDiffuseTexUVInfo(),
+		.specularTexUVInfo = model.GetSpecularTexUVInfo(),
+		.diffuseTexIndex = model.GetDiffuseTexIndex(),
+		.specularTexIndex = model.GetSpecularTexIndex(),
+		.shininess = material.shininess
+	};
+}
+
+struct BenchScene {
+	std::vector<std::shared_ptr<IModel>> models;
+	ModelTransformStore modelStore{ 1u };
+	std::vector<std::uint8_t> modelBuffer;
+	std::vector<std::uint8_t> materialBuffer;
+	DirectX::XMMATRIX viewMatrix;
+};
+
+static void FillScene(BenchScene& scene, size_t modelCount) {
+	for (size_t modelIndex = 0u; modelIndex < modelCount; ++modelIndex) {
+		const auto offset = static_cast<float>(modelIndex);
+		const DirectX::XMMATRIX modelMatrix =
+			DirectX::XMMatrixRotationRollPitchYaw(0.f, offset * 0.01f, 0.f)
+			* DirectX::XMMatrixTranslation(offset, 0.f, -offset);
+
+		auto& model = scene.models.emplace_back(
+			std::make_shared<BenchModel>(modelMatrix, DirectX::XMFLOAT3{ offset, 0.f, -offset })
+		);
+
+		const size_t modelId = scene.modelStore.AddModel();
+
+		scene.modelStore.SetModelMatrix(modelId, modelMatrix);
+		scene.modelStore.SetModelOffset(modelId, model->GetModelOffset());
+		scene.modelStore.SetBoundingBox(modelId, model->GetBoundingBox());
+		scene.modelStore.SetMaterial(modelId, GetModelMaterial(*model));
+	}
+
+	scene.modelBuffer.resize(sizeof(ModelDataWriter::ModelBuffer) * modelCount);
+	scene.materialBuffer.resize(sizeof(ModelDataWriter::MaterialBuffer) * modelCount);
+	scene.viewMatrix = DirectX::XMMatrixLookAtLH(
+		DirectX::XMVectorSet(0.f, 10.f, -10.f, 1.f), DirectX::XMVectorZero(),
+		DirectX::XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	);
+}
+
+// What the update did before the store, every field through the virtual getters.
+static void WriteThroughGetters(BenchScene& scene) {
+	size_t modelOffset = 0u;
+	size_t materialOffset = 0u;
+
+	for (const std::shared_ptr<IModel>& model : scene.models) {
+		const DirectX::XMMATRIX modelMatrix = model->GetModelMatrix();
+
+		const ModelDataWriter::ModelBuffer modelBuffer{
+			.modelMatrix = modelMatrix,
+			.viewNormalMatrix = DirectX::XMMatrixTranspose(
+				DirectX::XMMatrixInverse(nullptr, modelMatrix * scene.viewMatrix)
+			),
+			.modelOffset = model->GetModelOffset(),
+			.boundingBox = model->GetBoundingBox()
+		};
+		const ModelMaterial material = GetModelMaterial(*model);
+
+		memcpy(std::data(scene.modelBuffer) + modelOffset, &modelBuffer, sizeof(modelBuffer));
+		memcpy(std::data(scene.materialBuffer) + materialOffset, &material, sizeof(material));
+
+		modelOffset += sizeof(modelBuffer);
+		materialOffset += sizeof(material);
+	}
+}
+
+static void BenchModelCount(size_t modelCount) {
+	BenchScene scene{};
+	FillScene(scene, modelCount);
+
+	ModelDataWriter modelDataWriter{ scene.modelStore };
+
+	PrintResult(
+		"IModel getters", modelCount,
+		MeasureMilliseconds(21u, [&scene] { WriteThroughGetters(scene); })
+	);
+
+	size_t modelsWritten = 0u;
+
+	const auto writeModels = [&](bool viewChanged, const ModelDataWriter::SyncFunction& sync) {
+		modelsWritten = modelDataWriter.WriteModels<false>(
+			std::data(scene.modelBuffer), std::data(scene.materialBuffer), 0u,
+			scene.viewMatrix, viewChanged, sync
+		).modelsWritten;
+	};
+
+	// Models with a version of 0 are re-read every frame, so the adapter copies every one.
+	const ModelDataWriter::SyncFunction syncFromModels =
+		[&scene](size_t modelStart, size_t modelEnd) {
+			for (size_t modelId = modelStart; modelId < modelEnd; ++modelId) {
+				const IModel& model = *scene.models[modelId];
+
+				scene.modelStore.SetModelMatrix(modelId, model.GetModelMatrix());
+				scene.modelStore.SetModelOffset(modelId, model.GetModelOffset());
+				scene.modelStore.SetBoundingBox(modelId, model.GetBoundingBox());
+				scene.modelStore.SetMaterial(modelId, GetModelMaterial(model));
+			}
+		};
+
+	double milliseconds = MeasureMilliseconds(
+		21u, [&writeModels, &syncFromModels] { writeModels(true, syncFromModels); }
+	);
+	PrintResult("IModel adapter into the store", modelsWritten, milliseconds);
+
+	// The application writes the store and only the moved models are dirty.
+	milliseconds = MeasureMilliseconds(
+		21u,
+		[&scene, &writeModels, modelCount] {
+			for (size_t modelId = 0u; modelId < modelCount; modelId += 10u)
+				scene.modelStore.MarkTransformDirty(modelId);
+
+			writeModels(false, {});
+		}
+	);
+	PrintResult("Store, a tenth of the models moved", modelsWritten, milliseconds);
+
+	milliseconds = MeasureMilliseconds(21u, [&writeModels] { writeModels(true, {}); });
+	PrintResult("Store, the view moved", modelsWritten, milliseconds);
+}
+
+int main() {
+	// Both sides use the general inverse, so only the data layout differs.
+	SetNormalMatrixPath(NormalMatrixPath::Reference);
+
+	std::printf("%-40s %10s %15s\n", "Per model update", "Models", "Median");
+
+	for (size_t modelCount : { 1'000u, 10'000u, 100'000u })
+		BenchModelCount(modelCount);
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include <NormalMatrix.hpp>
+#include <BenchTimer.hpp>
+#include <vector>
+
+struct NormalMatrixInput {
+	std::vector<DirectX::XMFLOAT4X4> modelMatrices;
+	std::vector<std::uint32_t> modelIndices;
+	std::vector<DirectX::XMFLOAT4X4> normalMatrices;
+};
+
+// Rigid transforms with a uniform scale, which the affine paths take.
+[[nodiscard]]
+static NormalMatrixInput MakeInput(size_t matrixCount) {
+	NormalMatrixInput input{};
+
+	for (size_t matrixIndex = 0u; matrixIndex < matrixCount; ++matrixIndex) {
+		const auto step = static_cast<float>(matrixIndex);
+		const float scale = 1.f + step * 0.001f;
+
+		DirectX::XMStoreFloat4x4(
+			&input.modelMatrices.emplace_back(),
+			DirectX::XMMatrixScaling(scale, scale, scale)
+			* DirectX::XMMatrixRotationRollPitchYaw(step * 0.03f, step * 0.02f, step * 0.01f)
+			* DirectX::XMMatrixTranslation(step, -step, step * 0.5f)
+		);
+		input.modelIndices.emplace_back(static_cast<std::uint32_t>(matrixIndex));
+	}
+
+	input.normalMatrices.resize(matrixCount);
+
+	return input;
+}
+
+static void BenchPath(char const* name, NormalMatrixPath path, NormalMatrixInput& input) {
+	SetNormalMatrixPath(path);
+
+	const DirectX::XMMATRIX viewMatrix = DirectX::XMMatrixLookAtLH(
+		DirectX::XMVectorSet(0.f, 10.f, -10.f, 1.f), DirectX::XMVectorZero(),
+		DirectX::XMVectorSet(0.f, 1.f, 0.f, 0.f)
+	);
+	const size_t matrixCount = std::size(input.modelIndices);
+
+	const double milliseconds = MeasureMilliseconds(
+		21u,
+		[&input, &viewMatrix, matrixCount] {
+			ComputeNormalMatrices(
+				std::data(input.modelMatrices), std::data(input.modelIndices), matrixCount,
+				viewMatrix, std::data(input.normalMatrices)
+			);
+		}
+	);
+
+	std::printf(
+		"%-40s %10zu %12.3f ms %8.1f M/s\n", name, matrixCount, milliseconds,
+		static_cast<double>(matrixCount) / milliseconds / 1'000.0
+	);
+}
+
+int main() {
+	std::printf("%-40s %10s %15s %12s\n", "Normal matrices", "Matrices", "Median", "Throughput");
+
+	for (size_t matrixCount : { 1'000u, 100'000u }) {
+		NormalMatrixInput input = MakeInput(matrixCount);
+
+		BenchPath("Reference", NormalMatrixPath::Reference, input);
+		BenchPath("Affine", NormalMatrixPath::Affine, input);
+
+		if (IsAVX2Supported())
+			BenchPath("Affine AVX2", NormalMatrixPath::AffineAVX2, input);
+	}
+
+	return 0;
+}
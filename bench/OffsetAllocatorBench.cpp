@@ -0,0 +1,186 @@
+#include <OffsetAllocator.hpp>
+#include <SizeHelpers.hpp>
+#include <BenchTimer.hpp>
+#include <vector>
+
+// The LinearAllocator D3DHeap and the buffer sub-allocator used before, it only grows.
+class BumpAllocator {
+public:
+	BumpAllocator() noexcept : m_currentOffset{ 0u } {}
+
+	[[nodiscard]]
+	size_t SubAllocate(size_t size, size_t alignment) noexcept {
+		const size_t alignedOffset = Align(m_currentOffset, alignment);
+
+		m_currentOffset = alignedOffset + Align(size, alignment);
+
+		return alignedOffset;
+	}
+
+	[[nodiscard]]
+	size_t GetTotalSize() const noexcept { return m_currentOffset; }
+
+private:
+	size_t m_currentOffset;
+};
+
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+struct AllocationRequest {
+	size_t size;
+	size_t alignment;
+};
+
+// Buffers from 256B to 1MB with the constant buffer and the placement alignments.
+[[nodiscard]]
+static std::vector<AllocationRequest> MakeRequests(size_t requestCount) {
+	Random random{ 5u };
+	std::vector<AllocationRequest> requests;
+
+	for (size_t requestIndex = 0u; requestIndex < requestCount; ++requestIndex)
+		requests.emplace_back(
+			AllocationRequest{
+				.size = 256u << random.Next(13u),
+				.alignment = random.Next(4u) == 0u ? 64_KB : 256u
+			}
+		);
+
+	return requests;
+}
+
+static void PrintNanoseconds(char const* name, size_t operationCount, double milliseconds) {
+	std::printf(
+		"%-40s %10zu %12.3f ms %8.1f ns/op\n", name, operationCount, milliseconds,
+		milliseconds * 1'000'000.0 / static_cast<double>(operationCount)
+	);
+}
+
+static constexpr std::uint32_t s_noHandle = 0xFFFFFFFFu;
+
+static void BenchAllocations(size_t requestCount) {
+	const std::vector<AllocationRequest> requests = MakeRequests(requestCount);
+
+	size_t bumpTotalSize = 0u;
+
+	PrintNanoseconds(
+		"Bump allocate", requestCount,
+		MeasureMilliseconds(
+			21u,
+			[&requests, &bumpTotalSize] {
+				BumpAllocator bumpAllocator{};
+
+				for (const AllocationRequest& request : requests)
+					static_cast<void>(bumpAllocator.SubAllocate(request.size, request.alignment));
+
+				bumpTotalSize = bumpAllocator.GetTotalSize();
+			}
+		)
+	);
+
+	// How the heaps reserve before they are created.
+	PrintNanoseconds(
+		"Offset allocate and grow", requestCount,
+		MeasureMilliseconds(
+			21u,
+			[&requests] {
+				OffsetAllocator offsetAllocator{};
+
+				for (const AllocationRequest& request : requests)
+					static_cast<void>(
+						offsetAllocator.AllocateAndGrow(request.size, request.alignment)
+					);
+			}
+		)
+	);
+
+	std::vector<std::uint32_t> handles(requestCount);
+
+	PrintNanoseconds(
+		"Offset allocate and free all", requestCount * 2u,
+		MeasureMilliseconds(
+			21u,
+			[&requests, &handles, bumpTotalSize] {
+				OffsetAllocator offsetAllocator{ bumpTotalSize };
+
+				for (size_t index = 0u; index < std::size(requests); ++index)
+					handles[index] = offsetAllocator.Allocate(
+						requests[index].size, requests[index].alignment
+					)->handle;
+
+				for (std::uint32_t handle : handles)
+					offsetAllocator.Free(handle);
+			}
+		)
+	);
+
+	// Half the allocations are live at any time, each step frees a random one and allocates
+	// the next request. The heap has three quarters of the room the bump allocator needed.
+	OffsetAllocator offsetAllocator{ bumpTotalSize / 4u * 3u };
+	Random random{ 9u };
+	size_t liveCount = 0u;
+
+	for (; liveCount < requestCount / 2u; ++liveCount) {
+		const std::optional<OffsetAllocator::Allocation> allocation = offsetAllocator.Allocate(
+			requests[liveCount].size, requests[liveCount].alignment
+		);
+
+		handles[liveCount] = allocation ? allocation->handle : s_noHandle;
+	}
+
+	size_t failedCount = 0u;
+	size_t requestIndex = liveCount;
+
+	const double milliseconds = MeasureMilliseconds(
+		5u,
+		[&] {
+			for (size_t step = 0u; step < requestCount; ++step) {
+				const size_t liveIndex = random.Next(static_cast<std::uint32_t>(liveCount));
+				const AllocationRequest& request = requests[requestIndex % requestCount];
+
+				if (handles[liveIndex] != s_noHandle)
+					offsetAllocator.Free(handles[liveIndex]);
+
+				const std::optional<OffsetAllocator::Allocation> allocation =
+					offsetAllocator.Allocate(request.size, request.alignment);
+
+				if (!allocation)
+					++failedCount;
+
+				handles[liveIndex] = allocation ? allocation->handle : s_noHandle;
+				++requestIndex;
+			}
+		}
+	);
+	PrintNanoseconds("Offset churn, free and allocate", requestCount * 2u, milliseconds);
+
+	const OffsetAllocator::Stats stats = offsetAllocator.GetStats();
+
+	std::printf(
+		"  bump size %zu MB, churn capacity %zu MB, %zu of %zu allocations didn't fit, "
+		"fragmentation %.2f\n",
+		bumpTotalSize / 1_MB, stats.capacity / 1_MB, failedCount, requestCount * 5u,
+		offsetAllocator.GetFragmentation()
+	);
+}
+
+int main() {
+	std::printf("%-40s %10s %15s\n", "Allocator", "Operations", "Median");
+
+	for (size_t requestCount : { 1'000u, 100'000u })
+		BenchAllocations(requestCount);
+
+	return 0;
+}
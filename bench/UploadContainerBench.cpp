@@ -0,0 +1,126 @@
+#include <UploadContainer.hpp>
+#include <JobRunner.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <SizeHelpers.hpp>
+#include <BenchTimer.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+struct SyntheticUpload {
+	std::vector<std::uint8_t> source;
+	std::vector<std::uint8_t> destination;
+	size_t rowPitch;
+	size_t height;
+};
+
+// Buffers are a single row. Texture rows are copied into the 256B aligned pitch of the
+// upload heap, so their destinations are larger than the sources.
+[[nodiscard]]
+static std::vector<SyntheticUpload> MakeUploads(
+	size_t bufferCount, size_t bufferSize, size_t textureCount, size_t textureRowPitch,
+	size_t textureHeight
+) {
+	std::vector<SyntheticUpload> uploads;
+
+	for (size_t index = 0u; index < bufferCount; ++index)
+		uploads.emplace_back(
+			SyntheticUpload{
+				.source = std::vector<std::uint8_t>(bufferSize, static_cast<std::uint8_t>(index)),
+				.destination = std::vector<std::uint8_t>(bufferSize),
+				.rowPitch = bufferSize,
+				.height = 1u
+			}
+		);
+
+	for (size_t index = 0u; index < textureCount; ++index)
+		uploads.emplace_back(
+			SyntheticUpload{
+				.source = std::vector<std::uint8_t>(
+					textureRowPitch * textureHeight, static_cast<std::uint8_t>(index)
+				),
+				.destination = std::vector<std::uint8_t>(
+					Align(textureRowPitch, 256u) * textureHeight
+				),
+				.rowPitch = textureRowPitch,
+				.height = textureHeight
+			}
+		);
+
+	return uploads;
+}
+
+static void BenchUploads(char const* name, std::vector<SyntheticUpload>& uploads) {
+	UploadContainer uploadContainer{};
+	UploadContainer::CopyStats copyStats{};
+
+	const double milliseconds = MeasureMilliseconds(
+		11u,
+		[&uploadContainer, &uploads, &copyStats] {
+			for (SyntheticUpload& upload : uploads)
+				if (upload.height == 1u)
+					uploadContainer.AddMemory(
+						std::data(upload.source), std::data(upload.destination), upload.rowPitch
+					);
+				else
+					uploadContainer.AddMemory(
+						std::data(upload.source), std::data(upload.destination), upload.rowPitch,
+						upload.height
+					);
+
+			uploadContainer.CopyData();
+			uploadContainer.WaitForCopies();
+
+			copyStats = uploadContainer.GetCopyStats();
+		}
+	);
+
+	std::printf(
+		"%-40s %10zu %12.3f ms %8.2f GB/s\n", name, std::size(uploads), milliseconds,
+		static_cast<double>(copyStats.bytesCopied) / 1e6 / milliseconds
+	);
+
+	// The batches of the last run, the first one is always copied by the calling thread.
+	for (size_t batchIndex = 0u; batchIndex < std::size(copyStats.batchSeconds); ++batchIndex)
+		std::printf(
+			"  batch %zu %12.3f ms\n", batchIndex, copyStats.batchSeconds[batchIndex] * 1000.
+		);
+}
+
+static void BenchSet(
+	char const* title, size_t bufferCount, size_t bufferSize, size_t textureCount,
+	size_t textureRowPitch, size_t textureHeight
+) {
+	std::vector<SyntheticUpload> uploads = MakeUploads(
+		bufferCount, bufferSize, textureCount, textureRowPitch, textureHeight
+	);
+
+	std::printf("%s\n", title);
+
+	Gaia::threadPool.reset();
+
+	BenchUploads("Serial", uploads);
+
+	Gaia::threadPool = std::make_shared<WorkStealingThreadPool>(WorkStealingThreadPool::Args{});
+
+	// Uploads below a stripe stay on the calling thread.
+	BenchUploads("Batched on the pool", uploads);
+
+	Gaia::threadPool.reset();
+}
+
+// The count is of the uploads, the bandwidth is of the source bytes.
+int main() {
+	std::printf(
+		"%-40s %10s %15s\n%u hardware threads\n", "Upload copy", "Uploads", "Median",
+		std::thread::hardware_concurrency()
+	);
+
+	BenchSet("Many small buffers, 4096 x 16KB", 4'096u, 16_KB, 0u, 0u, 0u);
+	BenchSet("Large buffers, 16 x 8MB", 16u, 8_MB, 0u, 0u, 0u);
+	// A 2000 texel wide RGBA8 row isn't a multiple of the pitch alignment.
+	BenchSet("Textures, 32 x 2000 x 2000 RGBA8", 0u, 0u, 32u, 8'000u, 2'000u);
+	BenchSet("Mixed, 256 x 256KB and 8 textures", 256u, 256_KB, 8u, 8'000u, 2'000u);
+
+	return 0;
+}
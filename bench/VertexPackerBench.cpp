@@ -0,0 +1,122 @@
+#include <VertexPacker.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <BenchMesh.hpp>
+#include <BenchTimer.hpp>
+#include <thread>
+
+using namespace DirectX;
+
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	float Next(float minimum, float maximum) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return minimum + (maximum - minimum) * static_cast<float>(m_state >> 8u) / 16777216.f;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+// Random vertices in a 100 x 10 x 40 box, split into models of a thousand triangles each with
+// the box as their bounds. The normals point anywhere, unlike the flat ones of a grid.
+[[nodiscard]]
+static BenchMesh CreateRandomMesh(size_t vertexCount) {
+	static constexpr std::uint32_t modelIndexCount = 3'000u;
+
+	Random random{ 17u };
+	BenchMesh mesh{};
+
+	for (size_t index = 0u; index < vertexCount; ++index) {
+		Vertex vertex{
+			.position = {
+				random.Next(-50.f, 50.f), random.Next(-5.f, 5.f), random.Next(-20.f, 20.f)
+			},
+			.normal = {},
+			.uv = { random.Next(0.f, 1.f), random.Next(0.f, 1.f) }
+		};
+
+		XMStoreFloat3(
+			&vertex.normal,
+			XMVector3Normalize(
+				XMVectorSet(
+					random.Next(-1.f, 1.f), random.Next(-1.f, 1.f), random.Next(-1.f, 1.f), 0.f
+				)
+			)
+		);
+
+		mesh.vertices.emplace_back(vertex);
+		mesh.indices.emplace_back(static_cast<std::uint32_t>(index));
+	}
+
+	const ModelBounds bounds{
+		.positiveAxes = { 50.f, 5.f, 20.f }, .negativeAxes = { -50.f, -5.f, -20.f }
+	};
+
+	for (size_t indexOffset = 0u; indexOffset + modelIndexCount <= vertexCount;
+		indexOffset += modelIndexCount)
+		mesh.models.emplace_back(
+			std::make_shared<BenchModel>(
+				static_cast<std::uint32_t>(indexOffset), modelIndexCount, bounds
+			)
+		);
+
+	return mesh;
+}
+
+static void BenchPacking(char const* name, const BenchMesh& mesh, IThreadPool* pool) {
+	const VertexPacker vertexPacker{ VertexPacker::Args{ .threadPool = pool } };
+	std::vector<PackedVertex> packedVertices;
+
+	const double milliseconds = MeasureMilliseconds(
+		11u,
+		[&vertexPacker, &packedVertices, &mesh] {
+			packedVertices = vertexPacker.PackVertices(mesh.vertices, mesh.indices, mesh.models);
+		}
+	);
+
+	std::printf(
+		"%-40s %10zu %12.3f ms %8.2f M/s\n", name, std::size(mesh.vertices), milliseconds,
+		static_cast<double>(std::size(mesh.vertices)) / 1'000.0 / milliseconds
+	);
+
+	const VertexPacker::PackingError packingError = vertexPacker.GetPackingError(
+		mesh.vertices, packedVertices, mesh.indices, mesh.models
+	);
+
+	std::printf(
+		"  %zu KB became %zu KB, position error %.2e, normal error %.3f degrees, "
+		"UV error %.2e\n",
+		std::size(mesh.vertices) * sizeof(Vertex) / 1'000u,
+		std::size(packedVertices) * sizeof(PackedVertex) / 1'000u,
+		packingError.maxPositionError, packingError.maxNormalError, packingError.maxUVError
+	);
+}
+
+// The count is of the vertices.
+int main() {
+	std::printf(
+		"%-40s %10s %15s\n%u hardware threads\n", "Vertex packing", "Vertices", "Median",
+		std::thread::hardware_concurrency()
+	);
+
+	WorkStealingThreadPool pool{ WorkStealingThreadPool::Args{} };
+
+	for (size_t vertexCount : { 30'000u, 1'000'000u }) {
+		const BenchMesh mesh = CreateRandomMesh(vertexCount);
+
+		BenchPacking("Random vertices, serial", mesh, nullptr);
+		BenchPacking("Random vertices on the pool", mesh, &pool);
+	}
+
+	// Many models sharing no vertices, each with bounds of its own.
+	const BenchMesh gridMesh = CreateGridMesh(2'000u, 24u, 12u);
+
+	BenchPacking("2000 grid models, serial", gridMesh, nullptr);
+	BenchPacking("2000 grid models on the pool", gridMesh, &pool);
+
+	return 0;
+}
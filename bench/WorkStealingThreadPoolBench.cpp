@@ -0,0 +1,123 @@
+#include <JobRunner.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <BenchTimer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// A fixed amount of arithmetic, so a job costs about the same on every thread.
+[[nodiscard]]
+static std::uint32_t Spin(std::uint32_t seed, size_t iterationCount) noexcept {
+	for (size_t iteration = 0u; iteration < iterationCount; ++iteration)
+		seed = seed * 1664525u + 1013904223u;
+
+	return seed;
+}
+
+static void PrintNanoseconds(char const* name, size_t jobCount, double milliseconds) {
+	std::printf(
+		"%-40s %10zu %12.3f ms %8.1f ns/job\n", name, jobCount, milliseconds,
+		milliseconds * 1'000'000.0 / static_cast<double>(jobCount)
+	);
+}
+
+// Empty jobs from a thread outside the pool all go through the shared queue.
+static void BenchInjectedJobs(WorkStealingThreadPool& pool, size_t jobCount) {
+	std::atomic_size_t jobsRun{ 0u };
+
+	PrintNanoseconds(
+		"Injected empty jobs", jobCount,
+		MeasureMilliseconds(
+			11u,
+			[&pool, &jobsRun, jobCount] {
+				JobCounter counter{};
+
+				for (size_t jobIndex = 0u; jobIndex < jobCount; ++jobIndex)
+					pool.Submit([&jobsRun] { ++jobsRun; }, &counter);
+
+				pool.WaitAndHelp(counter);
+			}
+		)
+	);
+}
+
+// Each root job fans out from a worker, so the children go onto its deque and are stolen.
+static void BenchNestedJobs(WorkStealingThreadPool& pool, size_t jobCount) {
+	const size_t rootCount = std::max(pool.GetWorkerCount(), size_t{ 1u });
+	const size_t childCount = jobCount / rootCount;
+	std::atomic_size_t jobsRun{ 0u };
+
+	PrintNanoseconds(
+		"Nested empty jobs, stolen", rootCount * childCount,
+		MeasureMilliseconds(
+			11u,
+			[&pool, &jobsRun, rootCount, childCount] {
+				JobCounter rootCounter{};
+
+				for (size_t rootIndex = 0u; rootIndex < rootCount; ++rootIndex)
+					pool.Submit(
+						[&pool, &jobsRun, childCount] {
+							JobCounter childCounter{};
+
+							for (size_t childIndex = 0u; childIndex < childCount; ++childIndex)
+								pool.Submit([&jobsRun] { ++jobsRun; }, &childCounter);
+
+							pool.WaitAndHelp(childCounter);
+						},
+						&rootCounter
+					);
+
+				pool.WaitAndHelp(rootCounter);
+			}
+		)
+	);
+}
+
+// The same work split into more jobs than threads, through RunJobs as the renderer does.
+[[nodiscard]]
+static double BenchRunJobs(IThreadPool* pool, size_t jobCount, size_t iterationCount) {
+	std::vector<std::uint32_t> results(jobCount);
+
+	return MeasureMilliseconds(
+		11u,
+		[pool, &results, iterationCount] {
+			Gaia::RunJobs(
+				pool, std::size(results),
+				[&results, iterationCount](size_t jobIndex) {
+					results[jobIndex] = Spin(static_cast<std::uint32_t>(jobIndex), iterationCount);
+				}
+			);
+		}
+	);
+}
+
+int main() {
+	static constexpr size_t emptyJobCount = 100'000u;
+	static constexpr size_t workJobCount = 256u;
+	static constexpr size_t workIterations = 100'000u;
+
+	std::printf(
+		"%-40s %10s %15s\n%u hardware threads\n", "Thread pool", "Jobs", "Median",
+		std::thread::hardware_concurrency()
+	);
+
+	const double serialMilliseconds = BenchRunJobs(nullptr, workJobCount, workIterations);
+	PrintNanoseconds("RunJobs without a pool", workJobCount, serialMilliseconds);
+
+	// More workers than hardware threads only shows the cost of oversubscribing.
+	for (std::uint32_t workerCount : { 1u, 2u, 3u, 7u }) {
+		WorkStealingThreadPool pool{ WorkStealingThreadPool::Args{ .workerCount = workerCount } };
+
+		std::printf("%u workers\n", workerCount);
+
+		BenchInjectedJobs(pool, emptyJobCount);
+		BenchNestedJobs(pool, emptyJobCount);
+
+		const double milliseconds = BenchRunJobs(&pool, workJobCount, workIterations);
+		PrintNanoseconds("RunJobs, 256 equal jobs", workJobCount, milliseconds);
+		std::printf("  speedup over no pool %.2f\n", serialMilliseconds / milliseconds);
+	}
+
+	return 0;
+}
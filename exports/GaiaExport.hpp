@@ -0,0 +1,13 @@
+#ifndef GAIA_EXPORT_HPP_
+#define GAIA_EXPORT_HPP_
+// Only the Windows builds are a DLL, the unit tests elsewhere compile the sources directly.
+#ifdef _WIN32
+#ifdef BUILD_GAIAX
+#define GAIAX_DLL __declspec(dllexport)
+#else
+#define GAIAX_DLL __declspec(dllimport)
+#endif
+#else
+#define GAIAX_DLL
+#endif
+#endif
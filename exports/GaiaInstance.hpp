@@ -1,17 +1,21 @@
-#ifndef GAIA_INSTANCE_HPP_
-#define GAIA_INSTANCE_HPP_
-#include <Renderer.hpp>
-
-#ifdef BUILD_GAIAX
-#define GAIAX_DLL __declspec(dllexport)
-#else
-#define GAIAX_DLL __declspec(dllimport)
-#endif
-
-GAIAX_DLL Renderer* __cdecl CreateGaiaInstance(
-	const char* appName,
-	void* windowHandle,
-	std::uint32_t width, std::uint32_t height,
-	RenderEngineType engineType, std::uint32_t bufferCount = 2u
-);
-#endif
+#ifndef GAIA_INSTANCE_HPP_
+#define GAIA_INSTANCE_HPP_
+#include <Renderer.hpp>
+#include <GaiaExport.hpp>
+
+GAIAX_DLL Renderer* __cdecl CreateGaiaInstance(
+	const char* appName,
+	void* windowHandle,
+	std::uint32_t width, std::uint32_t height,
+	RenderEngineType engineType, std::uint32_t bufferCount = 2u,
+	VertexFormat vertexFormat = VertexFormat::Full
+);
+// Runs on a device without a GPU or a window: the resources are kept on the host, the commands
+// are only recorded and every frame completes at once. For tests and CPU profiling.
+GAIAX_DLL Renderer* __cdecl CreateHeadlessGaiaInstance(
+	const char* appName,
+	std::uint32_t width, std::uint32_t height,
+	RenderEngineType engineType, std::uint32_t bufferCount = 2u,
+	VertexFormat vertexFormat = VertexFormat::Full
+);
+#endif
@@ -0,0 +1,80 @@
+#ifndef MESHLET_BUILDER_HPP_
+#define MESHLET_BUILDER_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <IModel.hpp>
+#include <IThreadPool.hpp>
+#include <GaiaExport.hpp>
+
+// Builds the meshlets of the mesh draw engine from triangle lists. A meshlet grows with the
+// triangles sharing the most vertices with it, so the vertices are reused before it is full.
+class GAIAX_DLL MeshletBuilder {
+public:
+	struct Args {
+		// Up to 256 each, as the primitive indices are packed 10 bits per vertex.
+		std::optional<std::uint32_t> maxVertices = 64u;
+		std::optional<std::uint32_t> maxPrimitives = 126u;
+		// The models are built in parallel on it when there is one.
+		std::optional<IThreadPool*> threadPool = nullptr;
+	};
+
+	// Ready for AddModelInputs and AddMeshletModelSet. The meshlets of each model are in the
+	// order of the models and their offsets are into the two index arrays.
+	struct MeshletData {
+		std::vector<std::vector<Meshlet>> modelMeshlets;
+		std::vector<std::uint32_t> vertexIndices;
+		std::vector<std::uint32_t> primIndices;
+	};
+
+	struct MeshletStats {
+		size_t meshletCount;
+		size_t triangleCount;
+		// How full the meshlets are on average, from 0 to 1.
+		float vertexFillRatio;
+		float primitiveFillRatio;
+		// The vertices sent per triangle, 0.5 for a regular grid is ideal.
+		float verticesPerTriangle;
+	};
+
+public:
+	MeshletBuilder(const Args& arguments);
+
+	// Each model's triangles are at its index offset in the indices. The vertex indices of
+	// the meshlets index the vertices, so those are used as they are.
+	[[nodiscard]]
+	MeshletData BuildMeshlets(
+		const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	) const;
+
+	[[nodiscard]]
+	MeshletStats GetMeshletStats(const MeshletData& meshletData) const noexcept;
+
+	[[nodiscard]]
+	static std::uint32_t PackPrimitive(
+		std::uint32_t vertex0, std::uint32_t vertex1, std::uint32_t vertex2
+	) noexcept;
+
+private:
+	struct ModelMeshlets {
+		std::vector<Meshlet> meshlets;
+		std::vector<std::uint32_t> vertexIndices;
+		std::vector<std::uint32_t> primIndices;
+	};
+
+private:
+	[[nodiscard]]
+	ModelMeshlets BuildModelMeshlets(
+		const std::vector<Vertex>& vertices, const std::uint32_t* triangleIndices,
+		size_t triangleCount
+	) const;
+
+private:
+	std::uint32_t m_maxVertices;
+	std::uint32_t m_maxPrimitives;
+	IThreadPool* m_threadPool;
+};
+#endif
@@ -1,63 +1,215 @@
-#ifndef RENDERER_HPP_
-#define RENDERER_HPP_
-#include <cstdint>
-#include <memory>
-#include <array>
-#include <string>
-#include <IThreadPool.hpp>
-
-#include <IModel.hpp>
-#include <ISharedDataContainer.hpp>
-
-enum class RenderEngineType {
-	IndirectDraw,
-	IndividualDraw,
-	MeshDraw
-};
-
-class Renderer {
-public:
-	struct Resolution {
-		std::uint64_t width;
-		std::uint64_t height;
-	};
-
-	virtual ~Renderer() = default;
-
-	virtual void Resize(std::uint32_t width, std::uint32_t height) = 0;
-
-	[[nodiscard]]
-	virtual Resolution GetFirstDisplayCoordinates() const = 0;
-
-	virtual void SetThreadPool(std::shared_ptr<IThreadPool> threadPoolArg) noexcept = 0;
-	virtual void SetBackgroundColour(const std::array<float, 4>& colour) noexcept = 0;
-	virtual void SetShaderPath(const wchar_t* path) noexcept = 0;
-	virtual void SetSharedDataContainer(
-		std::shared_ptr<ISharedDataContainer> sharedData
-	) noexcept = 0;
-
-	[[nodiscard]]
-	virtual size_t AddTexture(
-		std::unique_ptr<std::uint8_t> textureData, size_t width, size_t height
-	) = 0; // Returns the index of the texture in its Resource Heap
-
-	virtual void AddModelSet(
-		std::vector<std::shared_ptr<IModel>>&& models, const std::wstring& pixelShader
-	) = 0;
-	virtual void AddMeshletModelSet(
-		std::vector<MeshletModel>&& meshletModels, const std::wstring& pixelShader
-	) = 0;
-	virtual void AddModelInputs(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-	) = 0;
-	virtual void AddModelInputs(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
-		std::vector<std::uint32_t>&& gPrimIndices
-	) = 0;
-
-	virtual void Update() = 0;
-	virtual void Render() = 0;
-	virtual void WaitForAsyncTasks() = 0;
-	virtual void ProcessData() = 0;
-};
-#endif
+#ifndef RENDERER_HPP_
+#define RENDERER_HPP_
+#include <cstdint>
+#include <memory>
+#include <array>
+#include <string>
+#include <vector>
+#include <IThreadPool.hpp>
+
+#include <IModel.hpp>
+#include <ModelTransformStore.hpp>
+#include <ISharedDataContainer.hpp>
+
+enum class RenderEngineType {
+	IndirectDraw,
+	IndividualDraw,
+	MeshDraw
+};
+
+class Renderer {
+public:
+	struct Resolution {
+		std::uint64_t width;
+		std::uint64_t height;
+	};
+
+	struct FrameStatistics {
+		std::uint64_t modelsWritten;
+		std::uint64_t materialsWritten;
+		std::uint64_t bytesWritten;
+		std::uint64_t modelsVisible;
+		std::uint64_t modelsCulled;
+		// The stages from the buffer updates up to the present.
+		double frameTaskSeconds;
+		double criticalPathSeconds;
+	};
+
+	// The CPU side of the upload in ProcessData.
+	struct UploadStatistics {
+		std::uint64_t bytesCopied;
+		double copySeconds;
+		double gigabytesPerSecond;
+		// One entry per thread which took part.
+		std::vector<double> threadSeconds;
+	};
+
+	// The graphics and compute commands of the last frame, counted while the recording is
+	// enabled. The barriers are counted one by one, the rest per call.
+	struct CommandStatistics {
+		std::uint64_t binds;
+		// The binds which switch the pipeline object, and the ones setting graphics root
+		// constants.
+		std::uint64_t pipelineChanges;
+		std::uint64_t rootConstantChanges;
+		std::uint64_t draws;
+		std::uint64_t dispatches;
+		std::uint64_t indirectCommands;
+		std::uint64_t barriers;
+		std::uint64_t copies;
+		std::uint64_t clears;
+	};
+
+	// The shader binaries loaded by the pipelines. A hit is a file loaded before, a content hit
+	// a file whose bytes were already mapped under another name.
+	struct ShaderStatistics {
+		std::uint64_t hits;
+		std::uint64_t contentHits;
+		std::uint64_t misses;
+		std::uint64_t bytesMapped;
+	};
+
+	// The pipeline objects loaded from the pipeline cache file and the ones compiled. The
+	// compile time is summed over the threads, so it is above the wall time of the pipeline
+	// stage when they were compiled in parallel.
+	struct PipelineStatistics {
+		std::uint64_t cacheHits;
+		std::uint64_t cacheMisses;
+		double compileSeconds;
+	};
+
+	// The wall time of the stages of ProcessData.
+	struct StartupStatistics {
+		double reserveSeconds;
+		double heapSeconds;
+		double bufferSeconds;
+		double copySeconds;
+		double gpuUploadSeconds;
+		// Reading the pipeline cache, creating the pipelines and writing the cache.
+		double pipelineSeconds;
+		double totalSeconds;
+	};
+
+	// The room for the content added after ProcessData, on top of what was added before.
+	struct RuntimeCapacity {
+		std::uint64_t modelCount;
+		std::uint64_t modelSetCount;
+		std::uint64_t lightCount;
+		std::uint64_t vertexCount;
+		std::uint64_t indexCount;
+		std::uint64_t textureCount;
+		std::uint64_t textureMemorySize;
+		// The size of the upload ring, larger uploads go into the free upload heap space.
+		std::uint64_t uploadMemorySize;
+	};
+
+	virtual ~Renderer() = default;
+
+	virtual void Resize(std::uint32_t width, std::uint32_t height) = 0;
+
+	[[nodiscard]]
+	virtual Resolution GetFirstDisplayCoordinates() const = 0;
+	[[nodiscard]]
+	virtual FrameStatistics GetFrameStatistics() const noexcept = 0;
+	// The names of the stages on the critical path of the last frame, in order.
+	[[nodiscard]]
+	virtual std::vector<std::string> GetFrameCriticalPath() const = 0;
+	[[nodiscard]]
+	virtual UploadStatistics GetUploadStatistics() const = 0;
+	[[nodiscard]]
+	virtual CommandStatistics GetCommandStatistics() const noexcept = 0;
+	[[nodiscard]]
+	virtual ShaderStatistics GetShaderStatistics() const noexcept = 0;
+	[[nodiscard]]
+	virtual PipelineStatistics GetPipelineStatistics() const noexcept = 0;
+	[[nodiscard]]
+	virtual StartupStatistics GetStartupStatistics() const noexcept = 0;
+	[[nodiscard]]
+	virtual ModelTransformStore& GetModelTransformStore() noexcept = 0;
+
+	// Append the ids of the models whose world bounds are hit, ids are indices in the
+	// model store.
+	virtual void QueryModelsInBox(
+		const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum,
+		std::vector<std::uint32_t>& modelIds
+	) = 0;
+	virtual void QueryModelsOnRay(
+		const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		std::vector<std::uint32_t>& modelIds
+	) = 0;
+
+	virtual void SetThreadPool(std::shared_ptr<IThreadPool> threadPoolArg) noexcept = 0;
+	virtual void SetBackgroundColour(const std::array<float, 4>& colour) noexcept = 0;
+	virtual void SetShaderPath(const wchar_t* path) noexcept = 0;
+	// The compiled pipeline objects are kept in this file across runs, the file is read in
+	// ProcessData and written after it and on destruction. Must be called before ProcessData,
+	// without a path nothing is kept.
+	virtual void SetPipelineCachePath(const wchar_t* path) = 0;
+	virtual void SetSharedDataContainer(
+		std::shared_ptr<ISharedDataContainer> sharedData
+	) noexcept = 0;
+	// Must be called before ProcessData. The buffers don't grow, so the adds after it throw
+	// once the capacity is used up.
+	virtual void SetRuntimeCapacity(const RuntimeCapacity& capacity) noexcept = 0;
+	// Logs the commands recorded on the graphics and compute lists, only between frames. The
+	// commands still go to the device, a renderer without a GPU is made with
+	// CreateHeadlessGaiaInstance.
+	virtual void SetCommandRecording(bool enable) = 0;
+	// While it is enabled, Render only reads the camera and the changed models into a frame
+	// packet and a thread of its own renders it, up to the buffer count less one frames
+	// behind. Update does nothing then. The other calls wait for the queued frames, but the
+	// model store must not be written and the statistics are only settled after
+	// WaitForAsyncTasks.
+	virtual void SetRenderThread(bool enable) = 0;
+	// The GPU culling of a frame runs while the previous one is drawn, which draws it with
+	// the culling results from a frame earlier. Only the indirect draw engine culls that way.
+	virtual void SetCullingOverlap(bool enable) = 0;
+	// The visible models of a set that share an index range are drawn with one instanced draw.
+	// Must be called before any model set is added, only the individual draw engine draws that
+	// way and it needs the instanced vertex shaders. The frames with more visible models than
+	// the instance buffer holds are drawn one by one with the plain vertex shaders.
+	virtual void SetAutoInstancing(bool enable) = 0;
+
+	[[nodiscard]]
+	virtual size_t AddTexture(
+		std::unique_ptr<std::uint8_t> textureData, size_t width, size_t height
+	) = 0; // Returns the index of the texture in its Resource Heap
+	// Only after ProcessData, the same goes for removing model sets.
+	virtual void RemoveTexture(size_t textureIndex) = 0;
+
+	// Returns the id of the set, which only removing it needs. The models can be added after
+	// ProcessData as well, their ids in the model store are the ones of removed models first.
+	// The sets with the same pixel shader share its pipeline object.
+	virtual size_t AddModelSet(
+		std::vector<std::shared_ptr<IModel>>&& models, const std::wstring& pixelShader
+	) = 0;
+	// Throws if the set doesn't exist or was already removed.
+	virtual void RemoveModelSet(size_t modelSetId) = 0;
+	virtual void AddMeshletModelSet(
+		std::vector<MeshletModel>&& meshletModels, const std::wstring& pixelShader
+	) = 0;
+	// The index offsets of the models must be the returned one plus their own.
+	[[nodiscard]]
+	virtual ModelInputRange AddModelInputs(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) = 0;
+	// Only for the renderers created with the packed vertex format, the models drawn with
+	// them must have the bounding boxes they were packed in.
+	[[nodiscard]]
+	virtual ModelInputRange AddModelInputs(
+		std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) = 0;
+	// Only after ProcessData. Throws if the inputs don't exist, were already removed or a
+	// model set which isn't removed draws them. The ids of removed inputs are reused.
+	virtual void RemoveModelInputs(size_t inputId) = 0;
+	virtual void AddModelInputs(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
+		std::vector<std::uint32_t>&& gPrimIndices
+	) = 0;
+
+	virtual void Update() = 0;
+	virtual void Render() = 0;
+	virtual void WaitForAsyncTasks() = 0;
+	virtual void ProcessData() = 0;
+};
+#endif
@@ -0,0 +1,73 @@
+#ifndef VERTEX_CACHE_OPTIMISER_HPP_
+#define VERTEX_CACHE_OPTIMISER_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <IModel.hpp>
+#include <IThreadPool.hpp>
+#include <GaiaExport.hpp>
+
+// Reorders the model inputs before they are added, so fewer vertices are shaded again. The
+// triangles only move inside their model's index range, so the models' offsets stay valid.
+class GAIAX_DLL VertexCacheOptimiser {
+public:
+	struct Args {
+		// The FIFO cache the statistics are simulated with.
+		std::optional<std::uint32_t> cacheSize = 16u;
+		// Sorts the clusters of each model so the outer ones are drawn first.
+		std::optional<bool> optimiseOverdraw = true;
+		// Renumbers the vertices in the order they are first used.
+		std::optional<bool> reorderVertices = true;
+		// The models are optimised in parallel on it when there is one.
+		std::optional<IThreadPool*> threadPool = nullptr;
+	};
+
+	struct CacheStats {
+		// Vertices shaded per triangle, 0.5 is the best possible.
+		float acmr;
+		// Vertices shaded per vertex used, 1 is the best possible.
+		float atvr;
+	};
+
+	struct OptimisationStats {
+		CacheStats before;
+		CacheStats after;
+	};
+
+public:
+	VertexCacheOptimiser(const Args& arguments);
+
+	// The indices aren't rebased, so they index the vertices as they would be added.
+	OptimisationStats Optimise(
+		std::vector<Vertex>& vertices, std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	) const;
+
+	[[nodiscard]]
+	CacheStats GetCacheStats(
+		const std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	) const;
+
+private:
+	void OptimiseModel(
+		const std::vector<Vertex>& vertices, std::uint32_t* triangleIndices,
+		size_t triangleCount
+	) const;
+	void SortClusters(
+		const std::vector<Vertex>& vertices, std::uint32_t* triangleIndices,
+		size_t triangleCount
+	) const;
+	static void ReorderVertices(
+		std::vector<Vertex>& vertices, std::vector<std::uint32_t>& indices
+	);
+
+private:
+	std::uint32_t m_cacheSize;
+	bool m_optimiseOverdraw;
+	bool m_reorderVertices;
+	IThreadPool* m_threadPool;
+};
+#endif
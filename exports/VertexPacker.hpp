@@ -0,0 +1,74 @@
+#ifndef VERTEX_PACKER_HPP_
+#define VERTEX_PACKER_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <IModel.hpp>
+#include <IThreadPool.hpp>
+#include <GaiaExport.hpp>
+
+// Packs the vertices for a renderer created with the packed vertex format, 16 bytes instead of
+// 32. The positions are quantised to 16 bits in the bounding box of the models using them.
+class GAIAX_DLL VertexPacker {
+public:
+	struct Args {
+		// The vertices are packed in parallel on it when there is one.
+		std::optional<IThreadPool*> threadPool = nullptr;
+	};
+
+	struct PackingError {
+		// In the model's space.
+		float maxPositionError;
+		// In degrees.
+		float maxNormalError;
+		float maxUVError;
+	};
+
+public:
+	VertexPacker(const Args& arguments);
+
+	// Each model's triangles are at its index offset in the indices, as for AddModelInputs.
+	// The models sharing a vertex must have the same bounding box, and the vertices no model
+	// uses are packed in the bounds of all the vertices.
+	[[nodiscard]]
+	std::vector<PackedVertex> PackVertices(
+		const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	) const;
+
+	// The largest difference between the vertices and the packed ones once decoded.
+	[[nodiscard]]
+	PackingError GetPackingError(
+		const std::vector<Vertex>& vertices, const std::vector<PackedVertex>& packedVertices,
+		const std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	) const;
+
+	// The positions outside the bounds are clamped to them.
+	[[nodiscard]]
+	static PackedVertex PackVertex(const Vertex& vertex, const ModelBounds& bounds) noexcept;
+	[[nodiscard]]
+	static Vertex UnpackVertex(
+		const PackedVertex& packedVertex, const ModelBounds& bounds
+	) noexcept;
+
+private:
+	// The index of the bounds of each vertex, the last bounds are the ones of all the vertices.
+	struct VertexBounds {
+		std::vector<ModelBounds> bounds;
+		std::vector<std::uint32_t> boundsIndices;
+	};
+
+private:
+	[[nodiscard]]
+	static VertexBounds GetVertexBounds(
+		const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	);
+
+private:
+	IThreadPool* m_threadPool;
+};
+#endif
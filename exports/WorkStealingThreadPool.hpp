@@ -0,0 +1,197 @@
+#ifndef WORK_STEALING_THREAD_POOL_HPP_
+#define WORK_STEALING_THREAD_POOL_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <exception>
+#include <IThreadPool.hpp>
+#include <GaiaExport.hpp>
+
+// Counts the unfinished jobs submitted with it. It must outlive them. A job which throws still
+// counts as finished, the first exception is rethrown by the waits on the counter.
+class GAIAX_DLL JobCounter {
+	friend class WorkStealingThreadPool;
+	friend class Job;
+
+public:
+	JobCounter() noexcept;
+
+	[[nodiscard]]
+	bool IsDone() const noexcept;
+
+private:
+	void Increment() noexcept;
+	void Decrement() noexcept;
+
+	void StoreException(std::exception_ptr exception) noexcept;
+	void RethrowException() const;
+
+private:
+	std::atomic_uint32_t m_count;
+	mutable std::mutex m_exceptionMutex;
+	std::exception_ptr m_exception;
+};
+
+// Callables up to the inline size are stored in the job itself, larger ones on the heap.
+class GAIAX_DLL Job {
+public:
+	Job() noexcept;
+	~Job() noexcept;
+
+	template<typename Function>
+	Job(Function&& function, JobCounter* counter) : m_counter{ counter } {
+		using Callable = std::decay_t<Function>;
+
+		if constexpr (
+			sizeof(Callable) <= s_inlineSize && alignof(Callable) <= alignof(std::max_align_t)
+			&& std::is_nothrow_move_constructible_v<Callable>
+		) {
+			new (m_storage) Callable{ std::forward<Function>(function) };
+
+			m_invoke = &InvokeInline<Callable>;
+			m_move = &MoveInline<Callable>;
+			m_destroy = &DestroyInline<Callable>;
+		}
+		else {
+			*reinterpret_cast<Callable**>(m_storage) = new Callable{
+				std::forward<Function>(function)
+			};
+
+			m_invoke = &InvokeHeap<Callable>;
+			m_move = &MoveHeap<Callable>;
+			m_destroy = &DestroyHeap<Callable>;
+		}
+	}
+
+	Job(Job&& other) noexcept;
+	Job& operator=(Job&& other) noexcept;
+
+	Job(const Job&) = delete;
+	Job& operator=(const Job&) = delete;
+
+	// Decrements the counter afterwards and leaves the job empty. The exception of a job with
+	// a counter is stored in it, one without rethrows, which the pool keeps.
+	void Run();
+
+	[[nodiscard]]
+	bool IsEmpty() const noexcept;
+	[[nodiscard]]
+	JobCounter* GetCounter() const noexcept;
+
+private:
+	void Reset() noexcept;
+
+	template<typename Callable>
+	static void InvokeInline(void* storage) {
+		(*std::launder(static_cast<Callable*>(storage)))();
+	}
+	template<typename Callable>
+	static void MoveInline(void* destination, void* source) noexcept {
+		Callable* sourceCallable = std::launder(static_cast<Callable*>(source));
+
+		new (destination) Callable{ std::move(*sourceCallable) };
+		sourceCallable->~Callable();
+	}
+	template<typename Callable>
+	static void DestroyInline(void* storage) noexcept {
+		std::launder(static_cast<Callable*>(storage))->~Callable();
+	}
+
+	template<typename Callable>
+	static void InvokeHeap(void* storage) {
+		(**static_cast<Callable**>(storage))();
+	}
+	template<typename Callable>
+	static void MoveHeap(void* destination, void* source) noexcept {
+		*static_cast<Callable**>(destination) = *static_cast<Callable**>(source);
+	}
+	template<typename Callable>
+	static void DestroyHeap(void* storage) noexcept {
+		delete *static_cast<Callable**>(storage);
+	}
+
+private:
+	// Large enough for a std::function.
+	static constexpr size_t s_inlineSize = 64u;
+
+	alignas(std::max_align_t) std::byte m_storage[s_inlineSize];
+	void (*m_invoke)(void*);
+	void (*m_move)(void*, void*) noexcept;
+	void (*m_destroy)(void*) noexcept;
+	JobCounter* m_counter;
+};
+
+// Every worker has a deque of its own, the jobs submitted from a worker go to its deque and
+// the rest to a shared queue. Idle workers steal from the other deques before sleeping.
+class GAIAX_DLL WorkStealingThreadPool final : public IThreadPool {
+public:
+	struct Args {
+		// Zero picks one less than the hardware threads, as the waiting thread helps.
+		std::optional<std::uint32_t> workerCount = 0u;
+		// Pins each worker to the core of its index, only on Windows.
+		std::optional<bool> pinThreads = false;
+	};
+
+public:
+	WorkStealingThreadPool(const Args& arguments);
+	~WorkStealingThreadPool() noexcept override;
+
+	WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+	WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+	void SubmitWork(std::function<void()> workFunction) override;
+
+	template<typename Function>
+	void Submit(Function&& function, JobCounter* counter = nullptr) {
+		Push(Job{ std::forward<Function>(function), counter });
+	}
+
+	// Runs the queued jobs while the counter isn't done and blocks once there are none.
+	// Rethrows the first exception of the counter's jobs.
+	void WaitAndHelp(const JobCounter& counter);
+	// Only blocks.
+	void Wait(const JobCounter& counter) const;
+	// Rethrows the first exception of the jobs submitted without a counter and forgets it.
+	void RethrowUncountedException();
+
+	[[nodiscard]]
+	size_t GetWorkerCount() const noexcept;
+
+private:
+	struct Worker;
+
+private:
+	void Push(Job&& job);
+	void WorkerLoop(size_t workerIndex);
+	void WakeWorker() noexcept;
+	void RunJob(Job& job) noexcept;
+
+	[[nodiscard]]
+	bool FindJob(std::optional<size_t> workerIndex, Job& job);
+	[[nodiscard]]
+	bool PopInjectedJob(Job& job);
+	[[nodiscard]]
+	std::optional<size_t> GetCurrentWorkerIndex() const noexcept;
+
+private:
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::mutex m_injectedJobsMutex;
+	// A ring, so the jobs don't allocate once it has grown.
+	std::vector<Job> m_injectedJobs;
+	size_t m_injectedFront;
+	std::atomic_size_t m_injectedCount;
+	std::atomic_uint32_t m_wakeEpoch;
+	std::atomic_uint32_t m_sleepingWorkers;
+	std::atomic_bool m_stopping;
+	std::mutex m_uncountedExceptionMutex;
+	std::exception_ptr m_uncountedException;
+};
+#endif
@@ -0,0 +1,25 @@
+#ifndef AXIS_ALIGNED_BOX_HPP_
+#define AXIS_ALIGNED_BOX_HPP_
+#include <DirectXMath.h>
+#include <IModel.hpp>
+
+struct AxisAlignedBox {
+	DirectX::XMFLOAT3 minimum;
+	DirectX::XMFLOAT3 maximum;
+};
+
+[[nodiscard]]
+AxisAlignedBox GetBoxUnion(const AxisAlignedBox& box1, const AxisAlignedBox& box2) noexcept;
+[[nodiscard]]
+float GetBoxSurfaceArea(const AxisAlignedBox& box) noexcept;
+[[nodiscard]]
+bool DoBoxesOverlap(const AxisAlignedBox& box1, const AxisAlignedBox& box2) noexcept;
+
+// Bounds are in model space and placed in the world with the model matrix and then the
+// model offset.
+[[nodiscard]]
+AxisAlignedBox GetWorldBox(
+	const DirectX::XMFLOAT4X4& modelMatrix, const DirectX::XMFLOAT3& modelOffset,
+	const ModelBounds& bounds
+) noexcept;
+#endif
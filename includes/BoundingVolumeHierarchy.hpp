@@ -0,0 +1,72 @@
+#ifndef BOUNDING_VOLUME_HIERARCHY_HPP_
+#define BOUNDING_VOLUME_HIERARCHY_HPP_
+#include <cstdint>
+#include <vector>
+#include <AxisAlignedBox.hpp>
+#include <FrustumCuller.hpp>
+#include <ModelTransformStore.hpp>
+
+class BoundingVolumeHierarchy {
+public:
+	BoundingVolumeHierarchy() noexcept;
+
+	// Inserts the models added to the store since the last call, refits the ones which were
+	// moved and drops the inactive ones. Falls back to a full rebuild when many models are new.
+	void Update(const ModelTransformStore& modelStore) noexcept;
+	void Rebuild() noexcept;
+
+	void QueryFrustum(
+		const FrustumCuller& frustum, std::vector<std::uint32_t>& modelIds
+	) const noexcept;
+	void QueryBox(
+		const AxisAlignedBox& box, std::vector<std::uint32_t>& modelIds
+	) const noexcept;
+	// Direction doesn't need to be normalised, maxDistance is in units of its length.
+	void QueryRay(
+		const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		std::vector<std::uint32_t>& modelIds
+	) const noexcept;
+
+	[[nodiscard]]
+	size_t GetModelCount() const noexcept;
+
+private:
+	struct Node {
+		AxisAlignedBox box;
+		std::uint32_t parent;
+		std::uint32_t left;
+		// The model id of a leaf.
+		std::uint32_t right;
+	};
+
+private:
+	[[nodiscard]]
+	bool IsLeaf(std::uint32_t nodeIndex) const noexcept;
+	[[nodiscard]]
+	std::uint32_t AllocateNode() noexcept;
+	[[nodiscard]]
+	std::uint32_t CreateLeaf(std::uint32_t modelId, const AxisAlignedBox& box) noexcept;
+
+	void InsertLeaf(std::uint32_t leafIndex) noexcept;
+	// The leaf node is freed as well.
+	void RemoveLeaf(std::uint32_t leafIndex) noexcept;
+	void RefitAncestors(std::uint32_t nodeIndex) noexcept;
+	void RefitAll() noexcept;
+	[[nodiscard]]
+	std::uint32_t BuildRange(std::uint32_t* leaves, size_t leafCount) noexcept;
+	void AddSubtreeModels(
+		std::uint32_t nodeIndex, std::vector<std::uint32_t>& modelIds
+	) const noexcept;
+
+private:
+	std::vector<Node> m_nodes;
+	std::vector<std::uint32_t> m_freeNodes;
+	// Indexed by model id, inactive models have no leaf.
+	std::vector<std::uint32_t> m_leafNodes;
+	std::vector<std::uint32_t> m_leafVersions;
+	std::uint32_t m_rootIndex;
+	size_t m_leafCount;
+
+	static constexpr std::uint32_t s_nullNode = 0xFFFFFFFFu;
+};
+#endif
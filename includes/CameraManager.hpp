@@ -1,30 +1,49 @@
-#ifndef CAMERA_MANAGER_HPP_
-#define CAMERA_MANAGER_HPP_
-#include <cstdint>
-#include <DirectXMath.h>
-
-struct CameraMatrices {
-	DirectX::XMMATRIX view;
-	DirectX::XMMATRIX projection;
-};
-
-class CameraManager {
-public:
-	CameraManager() noexcept;
-
-	void CopyData(std::uint8_t* cpuHandle) noexcept;
-
-	void SetCamera(const CameraMatrices& camera) noexcept;
-	void SetSceneResolution(std::uint32_t width, std::uint32_t height) noexcept;
-
-private:
-	void SetProjectionMatrix() noexcept;
-	void FetchCameraData() noexcept;
-
-private:
-	CameraMatrices m_cameraMatrices;
-	float m_fovRadian;
-	float m_sceneWidth;
-	float m_sceneHeight;
-};
-#endif
+#ifndef CAMERA_MANAGER_HPP_
+#define CAMERA_MANAGER_HPP_
+#include <cstdint>
+#include <optional>
+#include <DirectXMath.h>
+
+struct CameraMatrices {
+	DirectX::XMMATRIX view;
+	DirectX::XMMATRIX projection;
+};
+
+class CameraManager {
+public:
+	CameraManager() noexcept;
+
+	void CopyData(std::uint8_t* cpuHandle) noexcept;
+
+	void SetCamera(const CameraMatrices& camera) noexcept;
+	void SetSceneResolution(std::uint32_t width, std::uint32_t height) noexcept;
+	// Used instead of the shared data, for the frames of a frame packet.
+	void SetFrameCamera(
+		const DirectX::XMFLOAT4X4& viewMatrix, std::uint32_t fovAngleInDegree
+	) noexcept;
+	void ClearFrameCamera() noexcept;
+
+	[[nodiscard]]
+	DirectX::XMMATRIX GetViewProjectionMatrix() const noexcept;
+	// The frame camera's if there is one, the shared data's otherwise.
+	[[nodiscard]]
+	DirectX::XMMATRIX GetViewMatrix() const noexcept;
+
+private:
+	struct FrameCamera {
+		DirectX::XMFLOAT4X4 viewMatrix;
+		std::uint32_t fovAngleInDegree;
+	};
+
+private:
+	void SetProjectionMatrix() noexcept;
+	void FetchCameraData() noexcept;
+
+private:
+	CameraMatrices m_cameraMatrices;
+	float m_fovRadian;
+	float m_sceneWidth;
+	float m_sceneHeight;
+	std::optional<FrameCamera> m_frameCamera;
+};
+#endif
@@ -0,0 +1,45 @@
+#ifndef CULLING_SCHEDULE_HPP_
+#define CULLING_SCHEDULE_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Only the fence values and the buffer slots, so it doesn't need a device. The frames are
+// identified by the graphics fence value they signal, which must keep increasing.
+class CullingSchedule {
+public:
+	struct FrameSync {
+		size_t cullSlot;
+		size_t drawSlot;
+		// The CPU waits for the compute queue to reach it before the slot's command
+		// allocator and the buffers the culling reads are reused.
+		std::uint64_t cpuWaitOnCompute;
+		// The last draw reading the slot, the culling mustn't write it before.
+		std::uint64_t computeWaitOnGraphics;
+		std::uint64_t computeSignal;
+		std::uint64_t graphicsWaitOnCompute;
+	};
+
+public:
+	CullingSchedule(size_t slotCount);
+
+	// With the overlap, a frame draws with the results of the culling submitted by the one
+	// before it, so the culling of a frame runs while the previous one is being drawn.
+	void SetOverlap(bool enable) noexcept;
+	// The next frame draws with its own results, for when the arguments have changed.
+	void ResetHistory() noexcept;
+
+	[[nodiscard]]
+	FrameSync ScheduleFrame(size_t slot, std::uint64_t frameFenceValue) noexcept;
+
+	[[nodiscard]]
+	bool IsOverlapEnabled() const noexcept;
+
+private:
+	std::vector<std::uint64_t> m_cullFenceValues;
+	std::vector<std::uint64_t> m_drawFenceValues;
+	size_t m_previousCullSlot;
+	bool m_hasPreviousCull;
+	bool m_overlap;
+};
+#endif
@@ -1,192 +1,212 @@
-#ifndef BUFFER_MANAGER_HPP_
-#define BUFFER_MANAGER_HPP_
-#include <D3DHeaders.hpp>
-#include <D3DDescriptorView.hpp>
-#include <memory>
-#include <vector>
-#include <RootSignatureDynamic.hpp>
-#include <IModel.hpp>
-#include <optional>
-
-class BufferManager {
-public:
-	struct Args {
-		std::optional<std::uint32_t> frameCount;
-		std::optional<bool> modelDataNoBB;
-	};
-
-public:
-	BufferManager(const Args& arguments);
-
-	void BindBuffersToGraphics(
-		ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
-	) const noexcept;
-	void BindBuffersToCompute(
-		ID3D12GraphicsCommandList* computeCmdList, size_t frameIndex
-	) const noexcept;
-	void BindPixelOnlyBuffers(
-		ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
-	) const noexcept;
-
-	void SetComputeRootSignatureLayout(RSLayoutType rsLayout) noexcept;
-	void SetGraphicsRootSignatureLayout(RSLayoutType rsLayout) noexcept;
-
-	void AddOpaqueModels(std::vector<std::shared_ptr<IModel>>&& models) noexcept;
-	void AddOpaqueModels(std::vector<MeshletModel>&& meshletModels) noexcept;
-	void ReserveBuffers(ID3D12Device* device) noexcept;
-	void CreateBuffers(ID3D12Device* device);
-
-	template<bool modelWithNoBB>
-	void Update(size_t frameIndex) const noexcept {
-		const DirectX::XMMATRIX viewMatrix = GetViewMatrix();
-
-		UpdateCameraData(frameIndex);
-		UpdatePerModelData<modelWithNoBB>(frameIndex, viewMatrix);
-		UpdateLightData(frameIndex, viewMatrix);
-		UpdatePixelData(frameIndex);
-	}
-
-private:
-	struct ModelBuffer {
-		DirectX::XMMATRIX modelMatrix;
-		DirectX::XMMATRIX viewNormalMatrix;
-		DirectX::XMFLOAT3 modelOffset;
-		ModelBounds boundingBox;
-	};
-
-	struct ModelBufferNoBB {
-		DirectX::XMMATRIX modelMatrix;
-		DirectX::XMMATRIX viewNormalMatrix;
-		DirectX::XMFLOAT3 modelOffset;
-	};
-
-	struct MaterialBuffer {
-		DirectX::XMFLOAT4 ambient;
-		DirectX::XMFLOAT4 diffuse;
-		DirectX::XMFLOAT4 specular;
-		UVInfo diffuseTexUVInfo;
-		UVInfo specularTexUVInfo;
-		std::uint32_t diffuseTexIndex;
-		std::uint32_t specularTexIndex;
-		float shininess;
-	};
-
-	struct LightBuffer {
-		DirectX::XMFLOAT3 position;
-		DirectX::XMFLOAT4 ambient;
-		DirectX::XMFLOAT4 diffuse;
-		DirectX::XMFLOAT4 specular;
-	};
-
-	struct PixelData {
-		std::uint32_t lightCount;
-	};
-
-private:
-	[[nodiscard]]
-	DirectX::XMMATRIX GetViewMatrix() const noexcept;
-
-	void SetMemoryAddresses() noexcept;
-	void UpdateCameraData(size_t bufferIndex) const noexcept;
-	void UpdateLightData(
-		size_t bufferIndex, const DirectX::XMMATRIX& viewMatrix
-	) const noexcept;
-	void UpdatePixelData(size_t bufferIndex) const noexcept;
-	void CheckLightSourceAndAddOpaque(std::shared_ptr<IModel>&& model) noexcept;
-
-	template<bool modelWithNoBB>
-	void UpdatePerModelData(
-		size_t bufferIndex, const DirectX::XMMATRIX& viewMatrix
-	) const noexcept {
-		size_t modelOffset = 0u;
-		std::uint8_t* modelBufferOffset = m_modelBuffers.GetCPUWPointer(bufferIndex);
-
-		size_t materialOffset = 0u;
-		std::uint8_t* materialBufferOffset = m_materialBuffers.GetCPUWPointer(bufferIndex);
-
-		for (auto& model : m_opaqueModels) {
-			const DirectX::XMMATRIX modelMatrix = model->GetModelMatrix();
-
-			if constexpr (modelWithNoBB)
-				CopyStruct(
-					ModelBufferNoBB{
-						.modelMatrix = modelMatrix,
-						.viewNormalMatrix = DirectX::XMMatrixTranspose(
-							DirectX::XMMatrixInverse(nullptr, modelMatrix * viewMatrix)
-						),
-						.modelOffset = model->GetModelOffset()
-					},
-					modelBufferOffset, modelOffset
-				);
-			else
-				CopyStruct(
-					ModelBuffer{
-					.modelMatrix = modelMatrix,
-					.viewNormalMatrix = DirectX::XMMatrixTranspose(
-						DirectX::XMMatrixInverse(nullptr, modelMatrix * viewMatrix)
-					),
-					.modelOffset = model->GetModelOffset(),
-					.boundingBox = model->GetBoundingBox()
-					},
-					modelBufferOffset, modelOffset
-				);
-
-			const auto& modelMaterial = model->GetMaterial();
-
-			MaterialBuffer material{
-				.ambient = modelMaterial.ambient,
-				.diffuse = modelMaterial.diffuse,
-				.specular = modelMaterial.specular,
-				.diffuseTexUVInfo = model->GetDiffuseTexUVInfo(),
-				.specularTexUVInfo = model->GetSpecularTexUVInfo(),
-				.diffuseTexIndex = model->GetDiffuseTexIndex(),
-				.specularTexIndex = model->GetSpecularTexIndex(),
-				.shininess = modelMaterial.shininess
-			};
-			CopyStruct(material, materialBufferOffset, materialOffset);
-		}
-	}
-
-	template<void(__stdcall ID3D12GraphicsCommandList::* RCBV)(UINT, D3D12_GPU_VIRTUAL_ADDRESS),
-		void(__stdcall ID3D12GraphicsCommandList::* RDT)(UINT, D3D12_GPU_DESCRIPTOR_HANDLE)>
-	void BindBuffers(
-		ID3D12GraphicsCommandList* cmdList, size_t frameIndex, const RSLayoutType& rsLayout
-	) const noexcept {
-		static constexpr auto cameraTypeIndex = static_cast<size_t>(RootSigElement::Camera);
-		(cmdList->*RCBV)(
-			rsLayout[cameraTypeIndex], m_cameraBuffer.GetGPUAddressStart(frameIndex)
-			);
-
-		static constexpr auto modelBufferTypeIndex =
-			static_cast<size_t>(RootSigElement::ModelData);
-		(cmdList->*RDT)(
-			rsLayout[modelBufferTypeIndex], m_modelBuffers.GetGPUDescriptorHandle(frameIndex)
-			);
-	}
-
-	template<typename T>
-	void CopyStruct(
-		const T& data, std::uint8_t* offsetInMemory, size_t& currentOffset
-	) const noexcept {
-		static constexpr size_t stride = sizeof(T);
-
-		memcpy(offsetInMemory + currentOffset, &data, stride);
-		currentOffset += stride;
-	}
-
-private:
-	D3DRootDescriptorView m_cameraBuffer;
-	D3DRootDescriptorView m_pixelDataBuffer;
-	D3DDescriptorView m_modelBuffers;
-	D3DDescriptorView m_materialBuffers;
-	D3DDescriptorView m_lightBuffers;
-
-	RSLayoutType m_graphicsRSLayout;
-	RSLayoutType m_computeRSLayout;
-
-	std::vector<std::shared_ptr<IModel>> m_opaqueModels;
-	std::uint32_t m_frameCount;
-	std::vector<size_t> m_lightModelIndices;
-	bool m_modelDataNoBB;
-};
+#ifndef BUFFER_MANAGER_HPP_
+#define BUFFER_MANAGER_HPP_
+#include <D3DHeaders.hpp>
+#include <D3DDescriptorView.hpp>
+#include <memory>
+#include <vector>
+#include <RootSignatureDynamic.hpp>
+#include <IModel.hpp>
+#include <ModelTransformStore.hpp>
+#include <BoundingVolumeHierarchy.hpp>
+#include <ModelDataWriter.hpp>
+#include <FramePacket.hpp>
+#include <optional>
+
+class BufferManager {
+public:
+	struct Args {
+		std::optional<std::uint32_t> frameCount;
+		std::optional<bool> modelDataNoBB;
+	};
+
+	using UpdateStats = ModelDataWriter::UpdateStats;
+
+public:
+	BufferManager(const Args& arguments);
+
+	void BindBuffersToGraphics(
+		ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
+	) const noexcept;
+	void BindBuffersToCompute(
+		ID3D12GraphicsCommandList* computeCmdList, size_t frameIndex
+	) const noexcept;
+	void BindPixelOnlyBuffers(
+		ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
+	) const noexcept;
+
+	void SetComputeRootSignatureLayout(RSLayoutType rsLayout) noexcept;
+	void SetGraphicsRootSignatureLayout(RSLayoutType rsLayout) noexcept;
+
+	// Returns the model ids. Once the buffers are reserved, ids of removed models are reused
+	// and it throws if there is no spare capacity left.
+	std::vector<std::uint32_t> AddOpaqueModels(
+		const std::vector<std::shared_ptr<IModel>>& models
+	);
+	void AddOpaqueModels(std::vector<MeshletModel>&& meshletModels);
+	void RemoveOpaqueModels(const std::vector<std::uint32_t>& modelIds) noexcept;
+	// If a model which isn't removed draws any of the indices.
+	[[nodiscard]]
+	bool IsIndexRangeUsed(std::uint32_t indexOffset, std::uint32_t indexCount) const noexcept;
+	// The room for models added after the buffers are reserved.
+	void SetSpareCapacity(size_t modelCount, size_t lightCount) noexcept;
+	void ReserveBuffers(ID3D12Device* device) noexcept;
+	void CreateBuffers(ID3D12Device* device);
+
+	// The stages of the per frame update, the model data must be updated before the lights.
+	void UpdateCameraData(size_t frameIndex) const noexcept;
+	void UpdateLightData(size_t frameIndex) const noexcept;
+	void UpdatePixelData(size_t frameIndex) const noexcept;
+
+	template<bool modelWithNoBB>
+	void UpdatePerModelData(size_t frameIndex) {
+		const DirectX::XMMATRIX viewMatrix = GetViewMatrix();
+
+		// The view normal matrices depend on the view, so every model is stale if it moved.
+		const bool viewChanged = CheckAndStoreViewMatrix(frameIndex, viewMatrix);
+
+		m_updateStats = m_modelDataWriter.WriteModels<modelWithNoBB>(
+			m_modelBuffers.GetCPUWPointer(frameIndex),
+			m_materialBuffers.GetCPUWPointer(frameIndex), frameIndex, viewMatrix, viewChanged,
+			m_externalModelSync ? ModelDataWriter::SyncFunction{} :
+				[this](size_t modelStart, size_t modelEnd) {
+					SyncModelStoreRange(modelStart, modelEnd);
+				}
+		);
+	}
+
+	// While it is enabled the update doesn't read the IModels, their changes come in frame
+	// packets instead. The capture runs on the thread which owns the models.
+	void SetExternalModelSync(bool enable) noexcept;
+	void CaptureModelChanges(FramePacket& framePacket);
+	void ApplyFramePacket(const FramePacket& framePacket) noexcept;
+
+	[[nodiscard]]
+	UpdateStats GetUpdateStats() const noexcept;
+	[[nodiscard]]
+	ModelTransformStore& GetModelStore() noexcept;
+	// Brings the hierarchy up to date with the model store first.
+	[[nodiscard]]
+	const BoundingVolumeHierarchy& GetBoundingVolumeHierarchy() noexcept;
+
+private:
+	using ModelBuffer = ModelDataWriter::ModelBuffer;
+	using ModelBufferNoBB = ModelDataWriter::ModelBufferNoBB;
+	using MaterialBuffer = ModelDataWriter::MaterialBuffer;
+
+	struct LightBuffer {
+		DirectX::XMFLOAT3 position;
+		DirectX::XMFLOAT4 ambient;
+		DirectX::XMFLOAT4 diffuse;
+		DirectX::XMFLOAT4 specular;
+	};
+
+	struct PixelData {
+		std::uint32_t lightCount;
+	};
+
+	// The IModel versions last copied into the model store.
+	struct ModelAdapterState {
+		std::uint64_t modelVersion;
+		std::uint64_t materialVersion;
+	};
+
+private:
+	[[nodiscard]]
+	DirectX::XMMATRIX GetViewMatrix() const noexcept;
+
+	void SetMemoryAddresses() noexcept;
+	std::uint32_t CheckLightSourceAndAddOpaque(std::shared_ptr<IModel> model);
+	[[nodiscard]]
+	bool CheckAndStoreViewMatrix(
+		size_t bufferIndex, const DirectX::XMMATRIX& viewMatrix
+	) noexcept;
+
+	void SyncModelStoreRange(size_t modelStart, size_t modelEnd) noexcept;
+	[[nodiscard]]
+	static ModelMaterial GetModelMaterial(const IModel& model) noexcept;
+
+	// Calls the functions with the id of every model whose IModel version has changed.
+	template<typename TransformFunction, typename MaterialFunction>
+	void VisitChangedModels(
+		size_t modelStart, size_t modelEnd, TransformFunction&& onTransformChange,
+		MaterialFunction&& onMaterialChange
+	) {
+		for (size_t index = modelStart; index < modelEnd; ++index) {
+			const auto& model = m_opaqueModels[index];
+
+			if (!model)
+				continue;
+
+			ModelAdapterState& adapterState = m_modelAdapterStates[index];
+
+			const std::uint64_t modelVersion = model->GetModelVersion();
+			if (modelVersion == 0u || modelVersion != adapterState.modelVersion) {
+				adapterState.modelVersion = modelVersion;
+
+				onTransformChange(index, *model);
+			}
+
+			const std::uint64_t materialVersion = model->GetMaterialVersion();
+			if (materialVersion == 0u || materialVersion != adapterState.materialVersion) {
+				adapterState.materialVersion = materialVersion;
+
+				onMaterialChange(index, *model);
+			}
+		}
+	}
+	template<void(__stdcall ID3D12GraphicsCommandList::* RCBV)(UINT, D3D12_GPU_VIRTUAL_ADDRESS),
+		void(__stdcall ID3D12GraphicsCommandList::* RDT)(UINT, D3D12_GPU_DESCRIPTOR_HANDLE)>
+	void BindBuffers(
+		ID3D12GraphicsCommandList* cmdList, size_t frameIndex, const RSLayoutType& rsLayout
+	) const noexcept {
+		static constexpr auto cameraTypeIndex = static_cast<size_t>(RootSigElement::Camera);
+		(cmdList->*RCBV)(
+			rsLayout[cameraTypeIndex], m_cameraBuffer.GetGPUAddressStart(frameIndex)
+			);
+
+		static constexpr auto modelBufferTypeIndex =
+			static_cast<size_t>(RootSigElement::ModelData);
+		(cmdList->*RDT)(
+			rsLayout[modelBufferTypeIndex], m_modelBuffers.GetGPUDescriptorHandle(frameIndex)
+			);
+	}
+
+	template<typename T>
+	void CopyStruct(
+		const T& data, std::uint8_t* offsetInMemory, size_t& currentOffset
+	) const noexcept {
+		static constexpr size_t stride = sizeof(T);
+
+		memcpy(offsetInMemory + currentOffset, &data, stride);
+		currentOffset += stride;
+	}
+
+private:
+	D3DRootDescriptorView m_cameraBuffer;
+	D3DRootDescriptorView m_pixelDataBuffer;
+	D3DDescriptorView m_modelBuffers;
+	D3DDescriptorView m_materialBuffers;
+	D3DDescriptorView m_lightBuffers;
+
+	RSLayoutType m_graphicsRSLayout;
+	RSLayoutType m_computeRSLayout;
+
+	// Indexed by model id, removed models leave an empty slot.
+	std::vector<std::shared_ptr<IModel>> m_opaqueModels;
+	std::vector<ModelAdapterState> m_modelAdapterStates;
+	std::vector<std::uint32_t> m_freeModelIds;
+	ModelTransformStore m_modelStore;
+	ModelDataWriter m_modelDataWriter;
+	BoundingVolumeHierarchy m_boundingVolumeHierarchy;
+	std::vector<DirectX::XMFLOAT4X4> m_frameViewMatrices;
+	std::uint32_t m_frameCount;
+	std::vector<size_t> m_lightModelIndices;
+	size_t m_spareModelCount;
+	size_t m_spareLightCount;
+	size_t m_modelCapacity;
+	size_t m_lightCapacity;
+	bool m_modelDataNoBB;
+	bool m_externalModelSync;
+	UpdateStats m_updateStats;
+};
 #endif
\ No newline at end of file
@@ -1,91 +1,126 @@
-#ifndef COMPUTE_PIPELINE_INDIRECT_DRAW_HPP_
-#define COMPUTE_PIPELINE_INDIRECT_DRAW_HPP_
-#include <D3DHeaders.hpp>
-#include <memory>
-#include <string>
-#include <vector>
-#include <RootSignatureDynamic.hpp>
-#include <D3DPipelineObject.hpp>
-#include <D3DDescriptorView.hpp>
-#include <GaiaDataTypes.hpp>
-#include <IModel.hpp>
-
-class ComputePipelineIndirectDraw {
-public:
-	ComputePipelineIndirectDraw(std::uint32_t frameCount);
-
-	void RecordIndirectArguments(const std::vector<std::shared_ptr<IModel>>& models) noexcept;
-
-	void CreateComputeRootSignature(ID3D12Device* device) noexcept;
-	void CreateComputePipelineObject(
-		ID3D12Device2* device, const std::wstring& shaderPath
-	) noexcept;
-	void CreateBuffers(ID3D12Device* device);
-	void ReserveBuffers(ID3D12Device* device);
-	void RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept;
-	void ReleaseUploadResource() noexcept;
-
-	void BindComputePipeline(
-		ID3D12GraphicsCommandList* computeCommandList
-	) const noexcept;
-	void DispatchCompute(
-		ID3D12GraphicsCommandList* computeCommandList, size_t frameIndex
-	) const noexcept;
-	void ResetCounterBuffer(
-		ID3D12GraphicsCommandList* commandList, size_t frameIndex
-	) const noexcept;
-
-	[[nodiscard]]
-	UINT GetCurrentModelCount() const noexcept;
-	[[nodiscard]]
-	size_t GetCounterCount() const noexcept;
-	[[nodiscard]]
-	RSLayoutType GetComputeRSLayout() const noexcept;
-	[[nodiscard]]
-	ID3D12Resource* GetArgumentBuffer(size_t frameIndex) const noexcept;
-	[[nodiscard]]
-	ID3D12Resource* GetCounterBuffer(size_t frameIndex) const noexcept;
-
-private:
-	[[nodiscard]]
-	std::unique_ptr<RootSignatureDynamic> _createComputeRootSignature(
-		ID3D12Device* device
-	) const noexcept;
-	[[nodiscard]]
-	std::unique_ptr<D3DPipelineObject> _createComputePipelineObject(
-		ID3D12Device2* device, ID3D12RootSignature* computeRootSignature,
-		const std::wstring& shaderPath
-	) const noexcept;
-
-private:
-	std::unique_ptr<RootSignatureBase> m_computeRS;
-	std::unique_ptr<D3DPipelineObject> m_computePSO;
-	RSLayoutType m_computeRSLayout;
-
-	D3DUploadResourceDescriptorView m_argumentBufferSRV;
-	std::vector<D3DDescriptorView> m_argumentBufferUAVs;
-	std::vector<D3DUploadResourceDescriptorView> m_counterBuffers;
-	D3DResourceView m_counterResetBuffer;
-	D3DUploadableResourceView m_cullingDataBuffer;
-	std::vector<ModelDrawArguments> m_indirectArguments;
-	std::vector<std::uint32_t> m_modelCountOffsets;
-	UINT m_modelCount;
-	std::uint32_t m_frameCount;
-
-	static constexpr float THREADBLOCKSIZE = 64.f;
-	static constexpr DirectX::XMFLOAT2 XBOUNDS = { 1.f, -1.f };
-	static constexpr DirectX::XMFLOAT2 YBOUNDS = { 1.f, -1.f };
-	static constexpr DirectX::XMFLOAT2 ZBOUNDS = { 1.f, -1.f };
-	static constexpr UINT64 COUNTERBUFFERSTRIDE =
-		static_cast<UINT64>(sizeof(std::uint32_t) * 2u);
-
-private:
-	struct CullingData {
-		std::uint32_t modelCount;
-		std::uint32_t modelTypes;
-		DirectX::XMFLOAT2 xBounds;
-		DirectX::XMFLOAT2 yBounds;
-		DirectX::XMFLOAT2 zBounds;
-	};
-};
-#endif
+#ifndef COMPUTE_PIPELINE_INDIRECT_DRAW_HPP_
+#define COMPUTE_PIPELINE_INDIRECT_DRAW_HPP_
+#include <D3DHeaders.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <RootSignatureDynamic.hpp>
+#include <D3DPipelineObject.hpp>
+#include <D3DDescriptorView.hpp>
+#include <GaiaDataTypes.hpp>
+#include <IModel.hpp>
+#include <StagingUploader.hpp>
+
+class ComputePipelineIndirectDraw {
+public:
+	// The arguments of a model set and the counter its visible models are counted in.
+	struct ArgumentRange {
+		std::uint32_t argumentOffset;
+		std::uint32_t argumentCount;
+		std::uint32_t counterIndex;
+	};
+
+public:
+	ComputePipelineIndirectDraw(std::uint32_t frameCount);
+
+	// Once the buffers are created, a set takes the range of a removed set if one is large
+	// enough, otherwise it goes after the last range and throws if it doesn't fit.
+	[[nodiscard]]
+	ArgumentRange RecordIndirectArguments(
+		const std::vector<std::shared_ptr<IModel>>& models,
+		const std::vector<std::uint32_t>& modelIds
+	);
+	// The arguments are zeroed, so they are never drawn.
+	void RemoveIndirectArguments(const ArgumentRange& argumentRange);
+	void SetSpareCapacity(size_t modelCount, size_t modelSetCount) noexcept;
+
+	void CreateComputeRootSignature(ID3D12Device* device) noexcept;
+	void CreateComputePipelineObject(
+		ID3D12Device2* device, const std::wstring& shaderPath
+	);
+	void CreateBuffers(ID3D12Device* device);
+	void ReserveBuffers(ID3D12Device* device);
+	void RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept;
+	void ReleaseUploadResource() noexcept;
+	// Must be recorded before the counters are reset.
+	void RecordRuntimeUploads(ID3D12GraphicsCommandList* computeCommandList, size_t frameIndex);
+
+	void BindComputePipeline(
+		ID3D12GraphicsCommandList* computeCommandList
+	) const noexcept;
+	void DispatchCompute(
+		ID3D12GraphicsCommandList* computeCommandList, size_t frameIndex
+	) const noexcept;
+	void ResetCounterBuffer(
+		ID3D12GraphicsCommandList* commandList, size_t frameIndex
+	) const noexcept;
+
+	[[nodiscard]]
+	UINT GetCurrentModelCount() const noexcept;
+	[[nodiscard]]
+	size_t GetCounterCount() const noexcept;
+	[[nodiscard]]
+	RSLayoutType GetComputeRSLayout() const noexcept;
+	[[nodiscard]]
+	ID3D12Resource* GetArgumentBuffer(size_t frameIndex) const noexcept;
+	[[nodiscard]]
+	ID3D12Resource* GetCounterBuffer(size_t frameIndex) const noexcept;
+
+private:
+	[[nodiscard]]
+	std::unique_ptr<RootSignatureDynamic> _createComputeRootSignature(
+		ID3D12Device* device
+	) const noexcept;
+	[[nodiscard]]
+	std::unique_ptr<D3DPipelineObject> _createComputePipelineObject(
+		ID3D12Device2* device, ID3D12RootSignature* computeRootSignature,
+		const std::wstring& shaderPath
+	) const;
+
+	[[nodiscard]]
+	ArgumentRange ReserveArgumentRange(std::uint32_t argumentCount);
+	void StageArguments(const std::vector<ModelDrawArguments>& arguments, UINT argumentOffset);
+	void StageCullingData();
+
+private:
+	std::unique_ptr<RootSignatureBase> m_computeRS;
+	std::unique_ptr<D3DPipelineObject> m_computePSO;
+	RSLayoutType m_computeRSLayout;
+
+	D3DUploadResourceDescriptorView m_argumentBufferSRV;
+	std::vector<D3DDescriptorView> m_argumentBufferUAVs;
+	std::vector<D3DUploadResourceDescriptorView> m_counterBuffers;
+	D3DResourceView m_counterResetBuffer;
+	D3DUploadableResourceView m_cullingDataBuffer;
+	std::vector<ModelDrawArguments> m_indirectArguments;
+	std::vector<std::uint32_t> m_modelCountOffsets;
+	std::vector<ArgumentRange> m_freeArgumentRanges;
+	UINT m_modelCount;
+	std::uint32_t m_frameCount;
+	size_t m_spareModelCount;
+	size_t m_spareModelSetCount;
+	size_t m_argumentCapacity;
+	size_t m_counterCapacity;
+	bool m_buffersCreated;
+	StagingUploader m_stagingUploader;
+	// Each frame has its own counters, which need the new offsets once the table changes.
+	std::uint32_t m_counterTableVersion;
+	std::vector<std::uint32_t> m_counterBufferVersions;
+
+	static constexpr float THREADBLOCKSIZE = 64.f;
+	static constexpr DirectX::XMFLOAT2 XBOUNDS = { 1.f, -1.f };
+	static constexpr DirectX::XMFLOAT2 YBOUNDS = { 1.f, -1.f };
+	static constexpr DirectX::XMFLOAT2 ZBOUNDS = { 1.f, -1.f };
+	static constexpr UINT64 COUNTERBUFFERSTRIDE =
+		static_cast<UINT64>(sizeof(std::uint32_t) * 2u);
+
+private:
+	struct CullingData {
+		std::uint32_t modelCount;
+		std::uint32_t modelTypes;
+		DirectX::XMFLOAT2 xBounds;
+		DirectX::XMFLOAT2 yBounds;
+		DirectX::XMFLOAT2 zBounds;
+	};
+};
+#endif
@@ -1,33 +1,45 @@
-#ifndef D3D_COMMAND_LIST_HPP_
-#define D3D_COMMAND_LIST_HPP_
-#include <D3DHeaders.hpp>
-#include <vector>
-#include <optional>
-
-class D3DCommandList {
-public:
-	struct Args {
-		std::optional<ID3D12Device4*> device;
-		std::optional<D3D12_COMMAND_LIST_TYPE> type;
-		std::optional<bool> cmdList6;
-		std::optional<size_t> allocatorCount = 1u;
-	};
-
-public:
-	D3DCommandList(const Args& arguments);
-
-	void Reset(size_t allocatorIndex);
-	void ResetFirst();
-	void Close() const;
-
-	[[nodiscard]]
-	ID3D12GraphicsCommandList* GetCommandList() const noexcept;
-	[[nodiscard]]
-	ID3D12GraphicsCommandList6* GetCommandList6() const noexcept;
-
-private:
-	ComPtr<ID3D12GraphicsCommandList> m_pCommandList;
-	ComPtr<ID3D12GraphicsCommandList6> m_pCommandList6;
-	std::vector<ComPtr<ID3D12CommandAllocator>> m_pCommandAllocators;
-};
-#endif
+#ifndef D3D_COMMAND_LIST_HPP_
+#define D3D_COMMAND_LIST_HPP_
+#include <D3DHeaders.hpp>
+#include <vector>
+#include <optional>
+#include <RecordingCommandList.hpp>
+
+class D3DCommandList {
+public:
+	struct Args {
+		std::optional<ID3D12Device4*> device;
+		std::optional<D3D12_COMMAND_LIST_TYPE> type;
+		std::optional<bool> cmdList6;
+		std::optional<size_t> allocatorCount = 1u;
+	};
+
+public:
+	D3DCommandList(const Args& arguments);
+
+	void Reset(size_t allocatorIndex);
+	void ResetFirst();
+	void Close() const;
+	// Only between frames. While it is enabled, the lists returned by GetCommandList and
+	// GetCommandList6 log the commands of the current frame.
+	void SetRecording(bool enable);
+
+	[[nodiscard]]
+	ID3D12GraphicsCommandList* GetCommandList() const noexcept;
+	[[nodiscard]]
+	ID3D12GraphicsCommandList6* GetCommandList6() const noexcept;
+	// The list which must be passed to the queue.
+	[[nodiscard]]
+	ID3D12GraphicsCommandList* GetExecutableCommandList() const noexcept;
+	// Null if the recording isn't enabled.
+	[[nodiscard]]
+	RecordingCommandList const* GetRecordingList() const noexcept;
+
+private:
+	ComPtr<ID3D12GraphicsCommandList> m_pCommandList;
+	ComPtr<ID3D12GraphicsCommandList6> m_pCommandList6;
+	std::vector<ComPtr<ID3D12CommandAllocator>> m_pCommandAllocators;
+	ComPtr<RecordingCommandList> m_pRecordingList;
+	D3D12_COMMAND_LIST_TYPE m_type;
+};
+#endif
@@ -0,0 +1,58 @@
+#ifndef D3D_COMMAND_LIST_POOL_HPP_
+#define D3D_COMMAND_LIST_POOL_HPP_
+#include <D3DHeaders.hpp>
+#include <D3DCommandList.hpp>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+// Command lists with an allocator each, for recording on several threads at once. A list is
+// tagged with the fence value of the frame it was submitted in and only handed out again once
+// that value is completed, so its allocator can be reset.
+class D3DCommandListPool {
+public:
+	struct Args {
+		std::optional<ID3D12Device4*> device;
+		std::optional<D3D12_COMMAND_LIST_TYPE> type;
+		std::optional<bool> cmdList6;
+	};
+
+public:
+	D3DCommandListPool(const Args& arguments);
+
+	// Can be called from any thread. The list is reset and ready to record.
+	[[nodiscard]]
+	D3DCommandList* AcquireCommandList();
+	// The lists acquired since the last call are in use until the fence value is completed.
+	void RetireCommandLists(UINT64 fenceValue);
+	void Reclaim(UINT64 completedFenceValue);
+	// Only between frames, applies to the lists acquired afterwards.
+	void SetRecording(bool enable) noexcept;
+
+	// The lists of the last retired frame.
+	[[nodiscard]]
+	const std::vector<D3DCommandList*>& GetFrameCommandLists() const noexcept;
+	[[nodiscard]]
+	size_t GetCommandListCount() const noexcept;
+
+private:
+	struct ListInFlight {
+		std::unique_ptr<D3DCommandList> commandList;
+		UINT64 fenceValue;
+	};
+
+private:
+	ID3D12Device4* m_device;
+	D3D12_COMMAND_LIST_TYPE m_type;
+	bool m_cmdList6;
+	bool m_recording;
+	std::mutex m_listMutex;
+	std::vector<std::unique_ptr<D3DCommandList>> m_freeLists;
+	std::vector<std::unique_ptr<D3DCommandList>> m_acquiredLists;
+	std::deque<ListInFlight> m_listsInFlight;
+	std::vector<D3DCommandList*> m_frameLists;
+	size_t m_listCount;
+};
+#endif
@@ -1,38 +1,49 @@
-#ifndef D3D_FENCE_HPP_
-#define D3D_FENCE_HPP_
-#include <D3DHeaders.hpp>
-#include <queue>
-#include <optional>
-
-class D3DFence {
-public:
-	struct Args {
-		std::optional<ID3D12Device*> device;
-		std::optional<size_t> fenceValueCount = 1u;
-	};
-
-public:
-	D3DFence(const Args& arguments);
-
-	void AdvanceValueInQueue() noexcept;
-	void WaitOnCPU();
-	void WaitOnCPUConditional();
-	void IncreaseFrontValue(UINT64 oldValue) noexcept;
-
-	void SignalFence(UINT64 fenceValue) const;
-	void ResetFenceValues(UINT64 value) noexcept;
-
-	[[nodiscard]]
-	ID3D12Fence* GetFence() const noexcept;
-	[[nodiscard]]
-	UINT64 GetFrontValue() const noexcept;
-
-private:
-	void WaitOnCPU(UINT64 fenceValue);
-
-private:
-	ComPtr<ID3D12Fence> m_fence;
-	std::queue<UINT64> m_fenceValues;
-	HANDLE m_fenceCPUEvent;
-};
-#endif
+#ifndef D3D_FENCE_HPP_
+#define D3D_FENCE_HPP_
+#include <D3DHeaders.hpp>
+#include <queue>
+#include <optional>
+
+class D3DFence {
+public:
+	struct Args {
+		std::optional<ID3D12Device*> device;
+		std::optional<size_t> fenceValueCount = 1u;
+	};
+
+public:
+	D3DFence(const Args& arguments);
+
+	void AdvanceValueInQueue() noexcept;
+	void WaitOnCPU();
+	void WaitOnCPUConditional();
+	void IncreaseFrontValue(UINT64 oldValue) noexcept;
+
+	void SignalFence(UINT64 fenceValue) const;
+	void ResetFenceValues(UINT64 value) noexcept;
+
+	// For a fence another queue waits on. The values signalled on a queue must increase.
+	void SignalOnQueue(ID3D12CommandQueue* queue, UINT64 fenceValue);
+	// Nothing is waited for when the value is zero or already reached.
+	void WaitOnQueue(ID3D12CommandQueue* queue, UINT64 fenceValue) const;
+	void WaitOnCPUConditional(UINT64 fenceValue);
+
+	[[nodiscard]]
+	ID3D12Fence* GetFence() const noexcept;
+	[[nodiscard]]
+	UINT64 GetFrontValue() const noexcept;
+	[[nodiscard]]
+	UINT64 GetCompletedValue() const noexcept;
+	[[nodiscard]]
+	UINT64 GetLastSignalledValue() const noexcept;
+
+private:
+	void WaitOnCPU(UINT64 fenceValue);
+
+private:
+	ComPtr<ID3D12Fence> m_fence;
+	std::queue<UINT64> m_fenceValues;
+	HANDLE m_fenceCPUEvent;
+	UINT64 m_lastSignalledValue;
+};
+#endif
@@ -1,12 +1,12 @@
-#ifndef D3D_HEADERS_HPP_
-#define D3D_HEADERS_HPP_
-
-#define NOMINMAX
-#define STRICT
-
-#include <d3d12.h>
-#include <dxgi1_6.h>
-#include <wrl/client.h>
-
-using Microsoft::WRL::ComPtr;
-#endif
+#ifndef D3D_HEADERS_HPP_
+#define D3D_HEADERS_HPP_
+
+#define NOMINMAX
+#define STRICT
+
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <wrl/client.h>
+
+using Microsoft::WRL::ComPtr;
+#endif
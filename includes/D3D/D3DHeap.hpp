@@ -1,29 +1,38 @@
-#ifndef D3D_HEAP_HPP_
-#define D3D_HEAP_HPP_
-#include <D3DHeaders.hpp>
-#include <optional>
-
-class D3DHeap {
-public:
-	struct Args {
-		std::optional<D3D12_HEAP_TYPE> type;
-	};
-
-public:
-	D3DHeap(const Args& arguments);
-
-	void CreateHeap(ID3D12Device* device);
-
-	[[nodiscard]]
-	size_t ReserveSizeAndGetOffset(size_t heapSize, UINT64 alignment) noexcept;
-
-	[[nodiscard]]
-	ID3D12Heap* GetHeap() const noexcept;
-
-private:
-	D3D12_HEAP_TYPE m_heapType;
-	UINT64 m_maxAlignment;
-	UINT64 m_totalHeapSize;
-	ComPtr<ID3D12Heap> m_pHeap;
-};
-#endif
+#ifndef D3D_HEAP_HPP_
+#define D3D_HEAP_HPP_
+#include <D3DHeaders.hpp>
+#include <OffsetAllocator.hpp>
+#include <optional>
+
+class D3DHeap {
+public:
+	struct Args {
+		std::optional<D3D12_HEAP_TYPE> type;
+	};
+
+public:
+	D3DHeap(const Args& arguments);
+
+	void CreateHeap(ID3D12Device* device);
+
+	// The heap grows to fit every reservation until it is created, afterwards it throws
+	// if there isn't a large enough free block.
+	[[nodiscard]]
+	OffsetAllocator::Allocation ReserveSize(size_t heapSize, UINT64 alignment);
+	void ReleaseSize(std::uint32_t allocationHandle) noexcept;
+	// Extra free space for reservations made after the heap is created, reservations of the
+	// alignment can use all of it.
+	void AddSpareSize(size_t spareSize, UINT64 alignment) noexcept;
+
+	[[nodiscard]]
+	ID3D12Heap* GetHeap() const noexcept;
+	[[nodiscard]]
+	OffsetAllocator::Stats GetAllocationStats() const noexcept;
+
+private:
+	D3D12_HEAP_TYPE m_heapType;
+	UINT64 m_maxAlignment;
+	OffsetAllocator m_allocator;
+	ComPtr<ID3D12Heap> m_pHeap;
+};
+#endif
@@ -1,63 +1,87 @@
-#ifndef D3D_RESOURCE_BUFFER_HPP_
-#define D3D_RESOURCE_BUFFER_HPP_
-#include <D3DResource.hpp>
-#include <LinearAllocator.hpp>
-#include <optional>
-
-template<class ResourceView>
-class _D3DResourceBuffer {
-public:
-	_D3DResourceBuffer(
-		ResourceType type = ResourceType::gpuOnly,
-		D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE
-	) noexcept : m_resourceView{ type, flags } {}
-
-	void ReserveHeapSpace(ID3D12Device* device) {
-		m_resourceView.SetBufferInfo(m_allocator.GetTotalSize());
-		m_resourceView.ReserveHeapSpace(device);
-	}
-
-	[[nodiscard]]
-	size_t ReserveSpaceSuballocatedAndGetOffset(
-		size_t subAllocationSize, size_t subAllocationCount, size_t alignment
-	) noexcept {
-		return m_allocator.SubAllocate(subAllocationSize, subAllocationCount, alignment);
-	}
-	[[nodiscard]]
-	size_t ReserveSpaceAndGetOffset(size_t subAllocationSize) noexcept {
-		return m_allocator.SubAllocate(subAllocationSize, 1u, 4u);
-	}
-	[[nodiscard]]
-	D3D12_GPU_VIRTUAL_ADDRESS GetGPUStartAddress() const noexcept {
-		return m_resourceView.GetFirstGPUAddress();
-	}
-	[[nodiscard]]
-	std::uint8_t* GetCPUStartAddress() const {
-		return m_resourceView.GetFirstCPUWPointer();
-	}
-
-protected:
-	ResourceView m_resourceView;
-	LinearAllocator m_allocator;
-};
-
-class D3DResourceBuffer : public _D3DResourceBuffer<D3DResourceView> {
-public:
-	struct Args {
-		std::optional<ResourceType> type;
-		std::optional<D3D12_RESOURCE_FLAGS> flags = D3D12_RESOURCE_FLAG_NONE;
-	};
-
-public:
-	D3DResourceBuffer(const Args& arguments);
-
-	void CreateResource(ID3D12Device* device);
-};
-
-class D3DUploadableResourceBuffer : public _D3DResourceBuffer<D3DUploadableResourceView> {
-public:
-	void CreateResource(ID3D12Device* device);
-	void RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept;
-	void ReleaseUploadResource() noexcept;
-};
+#ifndef D3D_RESOURCE_BUFFER_HPP_
+#define D3D_RESOURCE_BUFFER_HPP_
+#include <D3DResource.hpp>
+#include <OffsetAllocator.hpp>
+#include <D3DHelperFunctions.hpp>
+#include <optional>
+
+template<class ResourceView>
+class _D3DResourceBuffer {
+public:
+	_D3DResourceBuffer(
+		ResourceType type = ResourceType::gpuOnly,
+		D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE
+	) noexcept : m_resourceView{ type, flags } {}
+
+	void ReserveHeapSpace(ID3D12Device* device) {
+		m_resourceView.SetBufferInfo(m_allocator.GetCapacity());
+		m_resourceView.ReserveHeapSpace(device);
+	}
+
+	// The buffer grows to fit these until its heap space is reserved.
+	[[nodiscard]]
+	size_t ReserveSpaceSuballocatedAndGetOffset(
+		size_t subAllocationSize, size_t subAllocationCount, size_t alignment
+	) noexcept {
+		return m_allocator.AllocateAndGrow(
+			Align(subAllocationSize, alignment) * subAllocationCount, alignment
+		).offset;
+	}
+	[[nodiscard]]
+	size_t ReserveSpaceAndGetOffset(size_t subAllocationSize) noexcept {
+		return m_allocator.AllocateAndGrow(subAllocationSize, 4u).offset;
+	}
+
+	// For allocations made after the resource was created, which can be released.
+	[[nodiscard]]
+	std::optional<OffsetAllocator::Allocation> SubAllocate(
+		size_t subAllocationSize, size_t alignment
+	) noexcept {
+		return m_allocator.Allocate(subAllocationSize, alignment);
+	}
+	void ReleaseSubAllocation(std::uint32_t allocationHandle) noexcept {
+		m_allocator.Free(allocationHandle);
+	}
+
+	[[nodiscard]]
+	OffsetAllocator::Stats GetAllocationStats() const noexcept {
+		return m_allocator.GetStats();
+	}
+	[[nodiscard]]
+	ID3D12Resource* GetResource() const noexcept {
+		return m_resourceView.GetResource();
+	}
+	[[nodiscard]]
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUStartAddress() const noexcept {
+		return m_resourceView.GetFirstGPUAddress();
+	}
+	[[nodiscard]]
+	std::uint8_t* GetCPUStartAddress() const {
+		return m_resourceView.GetFirstCPUWPointer();
+	}
+
+protected:
+	ResourceView m_resourceView;
+	OffsetAllocator m_allocator;
+};
+
+class D3DResourceBuffer : public _D3DResourceBuffer<D3DResourceView> {
+public:
+	struct Args {
+		std::optional<ResourceType> type;
+		std::optional<D3D12_RESOURCE_FLAGS> flags = D3D12_RESOURCE_FLAG_NONE;
+	};
+
+public:
+	D3DResourceBuffer(const Args& arguments);
+
+	void CreateResource(ID3D12Device* device);
+};
+
+class D3DUploadableResourceBuffer : public _D3DResourceBuffer<D3DUploadableResourceView> {
+public:
+	void CreateResource(ID3D12Device* device);
+	void RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept;
+	void ReleaseUploadResource() noexcept;
+};
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef DEFERRED_RELEASE_QUEUE_HPP_
+#define DEFERRED_RELEASE_QUEUE_HPP_
+#include <D3DHeaders.hpp>
+#include <functional>
+#include <deque>
+
+// Holds on to things the GPU might still be using until the frame which last used them is
+// done, so removing them doesn't need to wait on the GPU.
+class DeferredReleaseQueue {
+public:
+	// The fence values must not decrease between pushes.
+	void Push(UINT64 fenceValue, std::function<void()> release);
+	void Release(UINT64 completedFenceValue);
+	void ReleaseAll();
+
+	[[nodiscard]]
+	size_t GetPendingCount() const noexcept;
+
+private:
+	struct Entry {
+		UINT64 fenceValue;
+		std::function<void()> release;
+	};
+
+private:
+	std::deque<Entry> m_entries;
+};
+#endif
@@ -1,23 +1,32 @@
-#ifndef DEVICE_MANAGER_HPP_
-#define DEVICE_MANAGER_HPP_
-#include <D3DHeaders.hpp>
-
-class DeviceManager {
-public:
-	DeviceManager();
-
-	[[nodiscard]]
-	ID3D12Device5* GetDeviceRef() const noexcept;
-	[[nodiscard]]
-	IDXGIFactory4* GetFactoryRef() const noexcept;
-
-private:
-	void GetHardwareAdapter(IDXGIFactory1* pFactory, IDXGIAdapter1** ppAdapter);
-
-private:
-	ComPtr<ID3D12Device5> m_pDevice;
-    ComPtr<IDXGIFactory4> m_pFactory;
-};
-
-constexpr D3D_FEATURE_LEVEL gaiaFeatureLevel = D3D_FEATURE_LEVEL_12_0;
-#endif
+#ifndef DEVICE_MANAGER_HPP_
+#define DEVICE_MANAGER_HPP_
+#include <D3DHeaders.hpp>
+#include <optional>
+
+class DeviceManager {
+public:
+	struct Args {
+		// Without a GPU, the device is a HeadlessDevice and there is no factory.
+		std::optional<bool> headless = false;
+	};
+
+public:
+	DeviceManager(const Args& arguments);
+
+	[[nodiscard]]
+	ID3D12Device5* GetDeviceRef() const noexcept;
+	[[nodiscard]]
+	IDXGIFactory4* GetFactoryRef() const noexcept;
+	[[nodiscard]]
+	bool IsHeadless() const noexcept;
+
+private:
+	void GetHardwareAdapter(IDXGIFactory1* pFactory, IDXGIAdapter1** ppAdapter);
+
+private:
+	ComPtr<ID3D12Device5> m_pDevice;
+    ComPtr<IDXGIFactory4> m_pFactory;
+};
+
+constexpr D3D_FEATURE_LEVEL gaiaFeatureLevel = D3D_FEATURE_LEVEL_12_0;
+#endif
@@ -1,69 +1,153 @@
-#ifndef GRAPHICS_PIPELINE_VERTEX_SHADER_HPP_
-#define GRAPHICS_PIPELINE_VERTEX_SHADER_HPP_
-#include <vector>
-#include <GraphicsPipelineBase.hpp>
-#include <GaiaDataTypes.hpp>
-#include <RootSignatureDynamic.hpp>
-
-class GraphicsPipelineVertexShader : public GraphicsPipelineBase {
-protected:
-	[[nodiscard]]
-	std::unique_ptr<D3DPipelineObject> CreateGraphicsPipelineObjectVS(
-		ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
-		const std::wstring& vertexShader, ID3D12RootSignature* graphicsRootSignature
-	) const noexcept;
-};
-
-class GraphicsPipelineIndirectDraw : public GraphicsPipelineVertexShader {
-public:
-	GraphicsPipelineIndirectDraw() noexcept;
-
-	void ConfigureGraphicsPipelineObject(
-		const std::wstring& pixelShader, UINT modelCount,
-		std::uint32_t modelCountOffset, size_t counterIndex
-	) noexcept;
-
-	void DrawModels(
-		ID3D12CommandSignature* commandSignature, ID3D12GraphicsCommandList* graphicsCommandList,
-		ID3D12Resource* argumentBuffer, ID3D12Resource* counterBuffer
-	) const noexcept;
-
-private:
-	[[nodiscard]]
-	std::unique_ptr<D3DPipelineObject> _createGraphicsPipelineObject(
-		ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
-		ID3D12RootSignature* graphicsRootSignature
-	) const noexcept override;
-
-private:
-	UINT m_modelCount;
-	UINT64 m_counterBufferOffset;
-	UINT64 m_argumentBufferOffset;
-};
-
-class GraphicsPipelineIndividualDraw : public GraphicsPipelineVertexShader {
-public:
-	GraphicsPipelineIndividualDraw() noexcept;
-
-	void ConfigureGraphicsPipelineObject(
-		const std::wstring& pixelShader, size_t modelCount, size_t modelOffset
-	) noexcept;
-
-	void DrawModels(
-		ID3D12GraphicsCommandList* graphicsCommandList,
-		const std::vector<ModelDrawArguments>& drawArguments,
-		const RSLayoutType& graphicsRSLayout
-	) const noexcept;
-
-private:
-	[[nodiscard]]
-	std::unique_ptr<D3DPipelineObject> _createGraphicsPipelineObject(
-		ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
-		ID3D12RootSignature* graphicsRootSignature
-	) const noexcept override;
-
-private:
-	size_t m_modelCount;
-	size_t m_modelOffset;
-};
-#endif
+#ifndef GRAPHICS_PIPELINE_VERTEX_SHADER_HPP_
+#define GRAPHICS_PIPELINE_VERTEX_SHADER_HPP_
+#include <vector>
+#include <unordered_map>
+#include <GraphicsPipelineBase.hpp>
+#include <GaiaDataTypes.hpp>
+#include <RootSignatureDynamic.hpp>
+#include <IModel.hpp>
+
+class GraphicsPipelineVertexShader : public GraphicsPipelineBase {
+public:
+	GraphicsPipelineVertexShader() noexcept;
+
+	// The packed vertices are decoded by vertex shaders of their own.
+	void SetVertexFormat(VertexFormat vertexFormat) noexcept;
+
+protected:
+	[[nodiscard]]
+	std::unique_ptr<D3DPipelineObject> CreateGraphicsPipelineObjectVS(
+		ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
+		const std::wstring& vertexShader, ID3D12RootSignature* graphicsRootSignature
+	) const;
+
+private:
+	VertexFormat m_vertexFormat;
+};
+
+class GraphicsPipelineIndirectDraw : public GraphicsPipelineVertexShader {
+public:
+	GraphicsPipelineIndirectDraw() noexcept;
+
+	void ConfigureGraphicsPipelineObject(
+		const std::wstring& pixelShader, UINT modelCount,
+		std::uint32_t modelCountOffset, size_t counterIndex
+	) noexcept;
+	// Used when the set is removed but the pipeline is kept.
+	void ClearModels() noexcept;
+
+	void DrawModels(
+		ID3D12CommandSignature* commandSignature, ID3D12GraphicsCommandList* graphicsCommandList,
+		ID3D12Resource* argumentBuffer, ID3D12Resource* counterBuffer
+	) const noexcept;
+
+private:
+	[[nodiscard]]
+	std::unique_ptr<D3DPipelineObject> _createGraphicsPipelineObject(
+		ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
+		ID3D12RootSignature* graphicsRootSignature
+	) const override;
+
+private:
+	UINT m_modelCount;
+	UINT64 m_counterBufferOffset;
+	UINT64 m_argumentBufferOffset;
+};
+
+class GraphicsPipelineIndividualDraw : public GraphicsPipelineVertexShader {
+public:
+	GraphicsPipelineIndividualDraw() noexcept;
+
+	void ConfigureGraphicsPipelineObject(const std::wstring& pixelShader) noexcept;
+	// The instanced vertex shaders read the model indices from the instance buffer, at the
+	// batch's offset plus the instance id.
+	void SetInstancing(bool enable) noexcept;
+
+	// With instancing, the object of the plain vertex shader is created as well, for the
+	// frames whose models are drawn one by one.
+	void CreateGraphicsPipeline(
+		ID3D12Device2* device, ID3D12RootSignature* graphicsRootSignature,
+		const std::wstring& shaderPath
+	) override;
+	void SharePipelineObject(const GraphicsPipelineBase& graphicsPipeline) noexcept override;
+
+	using GraphicsPipelineBase::BindGraphicsPipeline;
+	using GraphicsPipelineBase::SwitchGraphicsPipeline;
+
+	// Without instances the plain vertex shader is bound, as the instance buffer isn't.
+	void BindGraphicsPipeline(
+		ID3D12GraphicsCommandList* graphicsCommandList, ID3D12RootSignature* graphicsRS,
+		bool drawInstanced
+	) const noexcept;
+	void SwitchGraphicsPipeline(
+		ID3D12GraphicsCommandList* graphicsCommandList, bool drawInstanced
+	) const noexcept;
+	// Returns the index of the model's mesh, the models with the same index range share it.
+	[[nodiscard]]
+	std::uint32_t AddMesh(const D3D12_DRAW_INDEXED_ARGUMENTS& drawArguments) noexcept;
+	// Once per model added, the mesh is freed with its last model.
+	void RemoveMesh(std::uint32_t meshIndex) noexcept;
+
+	// The models of a set don't have to be contiguous, so the culled ids are handed out
+	// one by one.
+	void ClearVisibleModels() noexcept;
+	void AddVisibleModel(std::uint32_t modelIndex) noexcept;
+
+	// The range is in the visible models, so a set can be split between lists.
+	void DrawModels(
+		ID3D12GraphicsCommandList* graphicsCommandList,
+		const std::vector<ModelDrawArguments>& drawArguments,
+		const RSLayoutType& graphicsRSLayout, size_t visibleStart, size_t visibleEnd
+	) const noexcept;
+
+	// Groups the visible models by their mesh and writes their ids into the instance buffer
+	// from the offset on. Returns the number written.
+	[[nodiscard]]
+	std::uint32_t BuildInstanceBatches(
+		const std::vector<std::uint32_t>& modelMeshIndices,
+		std::uint32_t* instanceModelIndices, std::uint32_t instanceOffset
+	);
+	// The range is in the batches.
+	void DrawInstances(
+		ID3D12GraphicsCommandList* graphicsCommandList, const RSLayoutType& graphicsRSLayout,
+		size_t batchStart, size_t batchEnd
+	) const noexcept;
+
+	[[nodiscard]]
+	size_t GetVisibleModelCount() const noexcept;
+	[[nodiscard]]
+	size_t GetInstanceBatchCount() const noexcept;
+
+private:
+	struct InstanceBatch {
+		std::uint32_t meshIndex;
+		std::uint32_t instanceOffset;
+		std::uint32_t instanceCount;
+	};
+
+private:
+	[[nodiscard]]
+	std::unique_ptr<D3DPipelineObject> _createGraphicsPipelineObject(
+		ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
+		ID3D12RootSignature* graphicsRootSignature
+	) const override;
+
+	[[nodiscard]]
+	ID3D12PipelineState* GetPipelineState(bool drawInstanced) const noexcept;
+
+	[[nodiscard]]
+	static std::uint64_t GetMeshKey(const D3D12_DRAW_INDEXED_ARGUMENTS& drawArguments) noexcept;
+
+private:
+	std::shared_ptr<D3DPipelineObject> m_individualPSO;
+	std::vector<std::uint32_t> m_visibleModels;
+	std::vector<D3D12_DRAW_INDEXED_ARGUMENTS> m_meshArguments;
+	// Keyed by the index offset and count.
+	std::unordered_map<std::uint64_t, std::uint32_t> m_meshIndices;
+	std::vector<std::uint32_t> m_meshModelCounts;
+	std::vector<std::uint32_t> m_freeMeshIndices;
+	std::vector<std::uint32_t> m_meshInstanceOffsets;
+	std::vector<InstanceBatch> m_instanceBatches;
+	bool m_instancing;
+};
+#endif
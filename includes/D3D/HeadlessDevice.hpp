@@ -0,0 +1,266 @@
+#ifndef HEADLESS_DEVICE_HPP_
+#define HEADLESS_DEVICE_HPP_
+#include <D3DHeaders.hpp>
+#include <HeadlessObjects.hpp>
+#include <SizeHelpers.hpp>
+#include <atomic>
+
+// A D3D12 device without a GPU. The heaps, resources, descriptors and fences are kept on the
+// host with made up GPU virtual addresses, the command lists only log and the queues complete
+// their signals right away. The shader binaries and the pipeline descriptions aren't checked.
+class HeadlessDevice final : public ID3D12Device5 {
+public:
+	HeadlessDevice() noexcept;
+
+	// IUnknown
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override;
+	ULONG STDMETHODCALLTYPE AddRef() override;
+	ULONG STDMETHODCALLTYPE Release() override;
+
+	// ID3D12Object
+	HRESULT STDMETHODCALLTYPE GetPrivateData(
+		REFGUID guid, UINT* pDataSize, void* pData
+	) override;
+	HRESULT STDMETHODCALLTYPE SetPrivateData(
+		REFGUID guid, UINT DataSize, const void* pData
+	) override;
+	HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(
+		REFGUID guid, const IUnknown* pData
+	) override;
+	HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override;
+
+	// ID3D12Device
+	UINT STDMETHODCALLTYPE GetNodeCount() override;
+	HRESULT STDMETHODCALLTYPE CreateCommandQueue(
+		const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateCommandAllocator(
+		D3D12_COMMAND_LIST_TYPE type, REFIID riid, void** ppCommandAllocator
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateGraphicsPipelineState(
+		const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateComputePipelineState(
+		const D3D12_COMPUTE_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateCommandList(
+		UINT nodeMask, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* pCommandAllocator,
+		ID3D12PipelineState* pInitialState, REFIID riid, void** ppCommandList
+	) override;
+	HRESULT STDMETHODCALLTYPE CheckFeatureSupport(
+		D3D12_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateDescriptorHeap(
+		const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap
+	) override;
+	UINT STDMETHODCALLTYPE GetDescriptorHandleIncrementSize(
+		D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapType
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateRootSignature(
+		UINT nodeMask, const void* pBlobWithRootSignature, SIZE_T blobLengthInBytes,
+		REFIID riid, void** ppvRootSignature
+	) override;
+	void STDMETHODCALLTYPE CreateConstantBufferView(
+		const D3D12_CONSTANT_BUFFER_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+	) override;
+	void STDMETHODCALLTYPE CreateShaderResourceView(
+		ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc,
+		D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+	) override;
+	void STDMETHODCALLTYPE CreateUnorderedAccessView(
+		ID3D12Resource* pResource, ID3D12Resource* pCounterResource,
+		const D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+	) override;
+	void STDMETHODCALLTYPE CreateRenderTargetView(
+		ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
+		D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+	) override;
+	void STDMETHODCALLTYPE CreateDepthStencilView(
+		ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC* pDesc,
+		D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+	) override;
+	void STDMETHODCALLTYPE CreateSampler(
+		const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+	) override;
+	void STDMETHODCALLTYPE CopyDescriptors(
+		UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts,
+		const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges,
+		const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts,
+		const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType
+	) override;
+	void STDMETHODCALLTYPE CopyDescriptorsSimple(
+		UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart,
+		D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart,
+		D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType
+	) override;
+	D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE GetResourceAllocationInfo(
+		UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs
+	) override;
+	D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE GetCustomHeapProperties(
+		UINT nodeMask, D3D12_HEAP_TYPE heapType
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateCommittedResource(
+		const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags,
+		const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState,
+		const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riidResource, void** ppvResource
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateHeap(
+		const D3D12_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap
+	) override;
+	HRESULT STDMETHODCALLTYPE CreatePlacedResource(
+		ID3D12Heap* pHeap, UINT64 HeapOffset, const D3D12_RESOURCE_DESC* pDesc,
+		D3D12_RESOURCE_STATES InitialState, const D3D12_CLEAR_VALUE* pOptimizedClearValue,
+		REFIID riid, void** ppvResource
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateReservedResource(
+		const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState,
+		const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid, void** ppvResource
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateSharedHandle(
+		ID3D12DeviceChild* pObject, const SECURITY_ATTRIBUTES* pAttributes, DWORD Access,
+		LPCWSTR Name, HANDLE* pHandle
+	) override;
+	HRESULT STDMETHODCALLTYPE OpenSharedHandle(
+		HANDLE NTHandle, REFIID riid, void** ppvObj
+	) override;
+	HRESULT STDMETHODCALLTYPE OpenSharedHandleByName(
+		LPCWSTR Name, DWORD Access, HANDLE* pNTHandle
+	) override;
+	HRESULT STDMETHODCALLTYPE MakeResident(
+		UINT NumObjects, ID3D12Pageable* const* ppObjects
+	) override;
+	HRESULT STDMETHODCALLTYPE Evict(UINT NumObjects, ID3D12Pageable* const* ppObjects) override;
+	HRESULT STDMETHODCALLTYPE CreateFence(
+		UINT64 InitialValue, D3D12_FENCE_FLAGS Flags, REFIID riid, void** ppFence
+	) override;
+	HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override;
+	void STDMETHODCALLTYPE GetCopyableFootprints(
+		const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource, UINT NumSubresources,
+		UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows,
+		UINT64* pRowSizeInBytes, UINT64* pTotalBytes
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateQueryHeap(
+		const D3D12_QUERY_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap
+	) override;
+	HRESULT STDMETHODCALLTYPE SetStablePowerState(BOOL Enable) override;
+	HRESULT STDMETHODCALLTYPE CreateCommandSignature(
+		const D3D12_COMMAND_SIGNATURE_DESC* pDesc, ID3D12RootSignature* pRootSignature,
+		REFIID riid, void** ppvCommandSignature
+	) override;
+	void STDMETHODCALLTYPE GetResourceTiling(
+		ID3D12Resource* pTiledResource, UINT* pNumTilesForEntireResource,
+		D3D12_PACKED_MIP_INFO* pPackedMipDesc,
+		D3D12_TILE_SHAPE* pStandardTileShapeForNonPackedMips, UINT* pNumSubresourceTilings,
+		UINT FirstSubresourceTilingToGet,
+		D3D12_SUBRESOURCE_TILING* pSubresourceTilingsForNonPackedMips
+	) override;
+	LUID STDMETHODCALLTYPE GetAdapterLuid() override;
+
+	// ID3D12Device1
+	HRESULT STDMETHODCALLTYPE CreatePipelineLibrary(
+		const void* pLibraryBlob, SIZE_T BlobLength, REFIID riid, void** ppPipelineLibrary
+	) override;
+	HRESULT STDMETHODCALLTYPE SetEventOnMultipleFenceCompletion(
+		ID3D12Fence* const* ppFences, const UINT64* pFenceValues, UINT NumFences,
+		D3D12_MULTIPLE_FENCE_WAIT_FLAGS Flags, HANDLE hEvent
+	) override;
+	HRESULT STDMETHODCALLTYPE SetResidencyPriority(
+		UINT NumObjects, ID3D12Pageable* const* ppObjects,
+		const D3D12_RESIDENCY_PRIORITY* pPriorities
+	) override;
+
+	// ID3D12Device2
+	HRESULT STDMETHODCALLTYPE CreatePipelineState(
+		const D3D12_PIPELINE_STATE_STREAM_DESC* pDesc, REFIID riid, void** ppPipelineState
+	) override;
+
+	// ID3D12Device3
+	HRESULT STDMETHODCALLTYPE OpenExistingHeapFromAddress(
+		const void* pAddress, REFIID riid, void** ppvHeap
+	) override;
+	HRESULT STDMETHODCALLTYPE OpenExistingHeapFromFileMapping(
+		HANDLE hFileMapping, REFIID riid, void** ppvHeap
+	) override;
+	HRESULT STDMETHODCALLTYPE EnqueueMakeResident(
+		D3D12_RESIDENCY_FLAGS Flags, UINT NumObjects, ID3D12Pageable* const* ppObjects,
+		ID3D12Fence* pFenceToSignal, UINT64 FenceValueToSignal
+	) override;
+
+	// ID3D12Device4
+	HRESULT STDMETHODCALLTYPE CreateCommandList1(
+		UINT nodeMask, D3D12_COMMAND_LIST_TYPE type, D3D12_COMMAND_LIST_FLAGS flags, REFIID riid,
+		void** ppCommandList
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateProtectedResourceSession(
+		const D3D12_PROTECTED_RESOURCE_SESSION_DESC* pDesc, REFIID riid, void** ppSession
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateCommittedResource1(
+		const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags,
+		const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState,
+		const D3D12_CLEAR_VALUE* pOptimizedClearValue,
+		ID3D12ProtectedResourceSession* pProtectedSession, REFIID riidResource,
+		void** ppvResource
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateHeap1(
+		const D3D12_HEAP_DESC* pDesc, ID3D12ProtectedResourceSession* pProtectedSession,
+		REFIID riid, void** ppvHeap
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateReservedResource1(
+		const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState,
+		const D3D12_CLEAR_VALUE* pOptimizedClearValue,
+		ID3D12ProtectedResourceSession* pProtectedSession, REFIID riid, void** ppvResource
+	) override;
+	D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE GetResourceAllocationInfo1(
+		UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs,
+		D3D12_RESOURCE_ALLOCATION_INFO1* pResourceAllocationInfo1
+	) override;
+
+	// ID3D12Device5
+	HRESULT STDMETHODCALLTYPE CreateLifetimeTracker(
+		ID3D12LifetimeOwner* pOwner, REFIID riid, void** ppvTracker
+	) override;
+	void STDMETHODCALLTYPE RemoveDevice() override;
+	HRESULT STDMETHODCALLTYPE EnumerateMetaCommands(
+		UINT* pNumMetaCommands, D3D12_META_COMMAND_DESC* pDescs
+	) override;
+	HRESULT STDMETHODCALLTYPE EnumerateMetaCommandParameters(
+		REFGUID CommandId, D3D12_META_COMMAND_PARAMETER_STAGE Stage,
+		UINT* pTotalStructureSizeInBytes, UINT* pParameterCount,
+		D3D12_META_COMMAND_PARAMETER_DESC* pParameterDescs
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateMetaCommand(
+		REFGUID CommandId, UINT NodeMask, const void* pCreationParametersData,
+		SIZE_T CreationParametersDataSizeInBytes, REFIID riid, void** ppMetaCommand
+	) override;
+	HRESULT STDMETHODCALLTYPE CreateStateObject(
+		const D3D12_STATE_OBJECT_DESC* pDesc, REFIID riid, void** ppStateObject
+	) override;
+	void STDMETHODCALLTYPE GetRaytracingAccelerationStructurePrebuildInfo(
+		const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS* pDesc,
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO* pInfo
+	) override;
+	D3D12_DRIVER_MATCHING_IDENTIFIER_STATUS STDMETHODCALLTYPE CheckDriverMatchingIdentifier(
+		D3D12_SERIALIZED_DATA_TYPE SerializedDataType,
+		const D3D12_SERIALIZED_DATA_DRIVER_MATCHING_IDENTIFIER* pIdentifierToCheck
+	) override;
+
+private:
+	// The address ranges are never given back, 64 bits of them last.
+	[[nodiscard]]
+	D3D12_GPU_VIRTUAL_ADDRESS ReserveAddressRange(UINT64 size) noexcept;
+	static void WriteDescriptor(
+		D3D12_CPU_DESCRIPTOR_HANDLE destination, const HeadlessDescriptor& descriptor
+	) noexcept;
+	[[nodiscard]]
+	static HeadlessDescriptor MakeResourceDescriptor(
+		ID3D12Resource* resource, HeadlessDescriptorType type, DXGI_FORMAT format
+	);
+
+private:
+	std::atomic<ULONG> m_referenceCount;
+	std::atomic<D3D12_GPU_VIRTUAL_ADDRESS> m_nextAddress;
+	HeadlessPrivateData m_privateData;
+
+	static constexpr UINT64 s_addressAlignment = 64_KB;
+};
+#endif
@@ -0,0 +1,288 @@
+#ifndef HEADLESS_OBJECTS_HPP_
+#define HEADLESS_OBJECTS_HPP_
+#include <D3DHeaders.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The objects handed out by the headless device. They keep their descriptions and CPU visible
+// memory on the host, the GPU virtual addresses are made up by the device and never read.
+
+class HeadlessPrivateData {
+public:
+	[[nodiscard]]
+	HRESULT Get(REFGUID guid, UINT* pDataSize, void* pData);
+	[[nodiscard]]
+	HRESULT Set(REFGUID guid, UINT dataSize, const void* pData);
+
+private:
+	struct Entry {
+		GUID guid;
+		std::vector<std::uint8_t> data;
+	};
+
+	std::mutex m_dataMutex;
+	std::vector<Entry> m_entries;
+};
+
+template<typename Interface>
+class HeadlessDeviceChild : public Interface {
+public:
+	HeadlessDeviceChild(ID3D12Device* device) noexcept
+		: m_referenceCount{ 1u }, m_pDevice{ device } {}
+	virtual ~HeadlessDeviceChild() = default;
+
+	// IUnknown
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override {
+		if (!ppvObject)
+			return E_POINTER;
+
+		bool pageable = false;
+
+		if constexpr (std::is_base_of_v<ID3D12Pageable, Interface>)
+			pageable = riid == __uuidof(ID3D12Pageable);
+
+		if (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D12Object)
+			|| riid == __uuidof(ID3D12DeviceChild) || riid == __uuidof(Interface) || pageable) {
+			*ppvObject = static_cast<Interface*>(this);
+			AddRef();
+
+			return S_OK;
+		}
+
+		*ppvObject = nullptr;
+
+		return E_NOINTERFACE;
+	}
+
+	ULONG STDMETHODCALLTYPE AddRef() override {
+		return ++m_referenceCount;
+	}
+
+	ULONG STDMETHODCALLTYPE Release() override {
+		const ULONG referenceCount = --m_referenceCount;
+
+		if (referenceCount == 0u)
+			delete this;
+
+		return referenceCount;
+	}
+
+	// ID3D12Object
+	HRESULT STDMETHODCALLTYPE GetPrivateData(
+		REFGUID guid, UINT* pDataSize, void* pData
+	) override {
+		return m_privateData.Get(guid, pDataSize, pData);
+	}
+
+	HRESULT STDMETHODCALLTYPE SetPrivateData(
+		REFGUID guid, UINT DataSize, const void* pData
+	) override {
+		return m_privateData.Set(guid, DataSize, pData);
+	}
+
+	HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(
+		[[maybe_unused]] REFGUID guid, [[maybe_unused]] const IUnknown* pData
+	) override {
+		return E_NOTIMPL;
+	}
+
+	HRESULT STDMETHODCALLTYPE SetName([[maybe_unused]] LPCWSTR Name) override {
+		return S_OK;
+	}
+
+	// ID3D12DeviceChild
+	HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override {
+		return m_pDevice->QueryInterface(riid, ppvDevice);
+	}
+
+private:
+	std::atomic<ULONG> m_referenceCount;
+	ComPtr<ID3D12Device> m_pDevice;
+	HeadlessPrivateData m_privateData;
+};
+
+using HeadlessRootSignature = HeadlessDeviceChild<ID3D12RootSignature>;
+using HeadlessCommandSignature = HeadlessDeviceChild<ID3D12CommandSignature>;
+
+// Only the heaps the CPU can write or read have memory.
+class HeadlessHeap final : public HeadlessDeviceChild<ID3D12Heap> {
+public:
+	HeadlessHeap(
+		ID3D12Device* device, const D3D12_HEAP_DESC& desc, D3D12_GPU_VIRTUAL_ADDRESS address
+	);
+
+	[[nodiscard]]
+	std::uint8_t* GetMemory() const noexcept;
+	[[nodiscard]]
+	D3D12_GPU_VIRTUAL_ADDRESS GetAddress() const noexcept;
+
+	// ID3D12Heap
+	D3D12_HEAP_DESC STDMETHODCALLTYPE GetDesc() override;
+
+private:
+	D3D12_HEAP_DESC m_desc;
+	D3D12_GPU_VIRTUAL_ADDRESS m_address;
+	std::unique_ptr<std::uint8_t[]> m_memory;
+};
+
+class HeadlessResource final : public HeadlessDeviceChild<ID3D12Resource> {
+public:
+	HeadlessResource(
+		ID3D12Device* device, HeadlessHeap* heap, UINT64 heapOffset,
+		const D3D12_RESOURCE_DESC& desc
+	) noexcept;
+
+	// ID3D12Resource
+	HRESULT STDMETHODCALLTYPE Map(
+		UINT Subresource, const D3D12_RANGE* pReadRange, void** ppData
+	) override;
+	void STDMETHODCALLTYPE Unmap(UINT Subresource, const D3D12_RANGE* pWrittenRange) override;
+	D3D12_RESOURCE_DESC STDMETHODCALLTYPE GetDesc() override;
+	D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE GetGPUVirtualAddress() override;
+	HRESULT STDMETHODCALLTYPE WriteToSubresource(
+		UINT DstSubresource, const D3D12_BOX* pDstBox, const void* pSrcData, UINT SrcRowPitch,
+		UINT SrcDepthPitch
+	) override;
+	HRESULT STDMETHODCALLTYPE ReadFromSubresource(
+		void* pDstData, UINT DstRowPitch, UINT DstDepthPitch, UINT SrcSubresource,
+		const D3D12_BOX* pSrcBox
+	) override;
+	HRESULT STDMETHODCALLTYPE GetHeapProperties(
+		D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags
+	) override;
+
+private:
+	ComPtr<HeadlessHeap> m_pHeap;
+	UINT64 m_heapOffset;
+	D3D12_RESOURCE_DESC m_desc;
+};
+
+enum class HeadlessDescriptorType : std::uint32_t {
+	Empty,
+	ConstantBuffer,
+	ShaderResource,
+	UnorderedAccess,
+	RenderTarget,
+	DepthStencil,
+	Sampler
+};
+
+// What a view was created with, the descriptor copies move these around.
+struct HeadlessDescriptor {
+	D3D12_GPU_VIRTUAL_ADDRESS address;
+	UINT64 size;
+	HeadlessDescriptorType type;
+	DXGI_FORMAT format;
+	ID3D12Resource* resource;
+};
+
+// The CPU handles are pointers to the descriptors.
+class HeadlessDescriptorHeap final : public HeadlessDeviceChild<ID3D12DescriptorHeap> {
+public:
+	HeadlessDescriptorHeap(
+		ID3D12Device* device, const D3D12_DESCRIPTOR_HEAP_DESC& desc,
+		D3D12_GPU_VIRTUAL_ADDRESS address
+	);
+
+	// ID3D12DescriptorHeap
+	D3D12_DESCRIPTOR_HEAP_DESC STDMETHODCALLTYPE GetDesc() override;
+	D3D12_CPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetCPUDescriptorHandleForHeapStart() override;
+	D3D12_GPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetGPUDescriptorHandleForHeapStart() override;
+
+private:
+	D3D12_DESCRIPTOR_HEAP_DESC m_desc;
+	D3D12_GPU_VIRTUAL_ADDRESS m_address;
+	std::vector<HeadlessDescriptor> m_descriptors;
+};
+
+// The queues don't run anything, so a value is complete as soon as it is signalled.
+class HeadlessFence final : public HeadlessDeviceChild<ID3D12Fence> {
+public:
+	HeadlessFence(ID3D12Device* device, UINT64 initialValue) noexcept;
+
+	// ID3D12Fence
+	UINT64 STDMETHODCALLTYPE GetCompletedValue() override;
+	HRESULT STDMETHODCALLTYPE SetEventOnCompletion(UINT64 Value, HANDLE hEvent) override;
+	HRESULT STDMETHODCALLTYPE Signal(UINT64 Value) override;
+
+private:
+	struct PendingEvent {
+		UINT64 value;
+		HANDLE event;
+	};
+
+	std::mutex m_fenceMutex;
+	UINT64 m_completedValue;
+	std::vector<PendingEvent> m_pendingEvents;
+};
+
+class HeadlessCommandAllocator final : public HeadlessDeviceChild<ID3D12CommandAllocator> {
+public:
+	using HeadlessDeviceChild::HeadlessDeviceChild;
+
+	// ID3D12CommandAllocator
+	HRESULT STDMETHODCALLTYPE Reset() override;
+};
+
+// The lists passed to it are dropped, the signals reach the fences right away.
+class HeadlessCommandQueue final : public HeadlessDeviceChild<ID3D12CommandQueue> {
+public:
+	HeadlessCommandQueue(ID3D12Device* device, const D3D12_COMMAND_QUEUE_DESC& desc) noexcept;
+
+	// ID3D12CommandQueue
+	void STDMETHODCALLTYPE UpdateTileMappings(
+		ID3D12Resource* pResource, UINT NumResourceRegions,
+		const D3D12_TILED_RESOURCE_COORDINATE* pResourceRegionStartCoordinates,
+		const D3D12_TILE_REGION_SIZE* pResourceRegionSizes, ID3D12Heap* pHeap, UINT NumRanges,
+		const D3D12_TILE_RANGE_FLAGS* pRangeFlags, const UINT* pHeapRangeStartOffsets,
+		const UINT* pRangeTileCounts, D3D12_TILE_MAPPING_FLAGS Flags
+	) override;
+	void STDMETHODCALLTYPE CopyTileMappings(
+		ID3D12Resource* pDstResource,
+		const D3D12_TILED_RESOURCE_COORDINATE* pDstRegionStartCoordinate,
+		ID3D12Resource* pSrcResource,
+		const D3D12_TILED_RESOURCE_COORDINATE* pSrcRegionStartCoordinate,
+		const D3D12_TILE_REGION_SIZE* pRegionSize, D3D12_TILE_MAPPING_FLAGS Flags
+	) override;
+	void STDMETHODCALLTYPE ExecuteCommandLists(
+		UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists
+	) override;
+	void STDMETHODCALLTYPE SetMarker(UINT Metadata, const void* pData, UINT Size) override;
+	void STDMETHODCALLTYPE BeginEvent(UINT Metadata, const void* pData, UINT Size) override;
+	void STDMETHODCALLTYPE EndEvent() override;
+	HRESULT STDMETHODCALLTYPE Signal(ID3D12Fence* pFence, UINT64 Value) override;
+	HRESULT STDMETHODCALLTYPE Wait(ID3D12Fence* pFence, UINT64 Value) override;
+	HRESULT STDMETHODCALLTYPE GetTimestampFrequency(UINT64* pFrequency) override;
+	HRESULT STDMETHODCALLTYPE GetClockCalibration(
+		UINT64* pGpuTimestamp, UINT64* pCpuTimestamp
+	) override;
+	D3D12_COMMAND_QUEUE_DESC STDMETHODCALLTYPE GetDesc() override;
+
+private:
+	D3D12_COMMAND_QUEUE_DESC m_desc;
+};
+
+class HeadlessPipelineState final : public HeadlessDeviceChild<ID3D12PipelineState> {
+public:
+	using HeadlessDeviceChild::HeadlessDeviceChild;
+
+	// ID3D12PipelineState
+	HRESULT STDMETHODCALLTYPE GetCachedBlob(ID3DBlob** ppBlob) override;
+};
+
+// Hands the object out as riid and drops the creation reference.
+template<typename Object>
+[[nodiscard]]
+HRESULT QueryHeadlessObject(Object* object, REFIID riid, void** ppvObject) {
+	const HRESULT hr = ppvObject ? object->QueryInterface(riid, ppvObject) : S_FALSE;
+
+	object->Release();
+
+	return hr;
+}
+#endif
@@ -0,0 +1,111 @@
+#ifndef OFFSET_ALLOCATOR_HPP_
+#define OFFSET_ALLOCATOR_HPP_
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <optional>
+
+// Two level segregated fit allocator, hands out offsets into a range which it doesn't own.
+// Freeing is constant time, allocating checks at most one block per bin the alignment padding
+// spans, no matter how many blocks there are. Free neighbours are merged immediately.
+class OffsetAllocator {
+public:
+	struct Allocation {
+		size_t offset;
+		std::uint32_t handle;
+	};
+
+	struct Stats {
+		size_t capacity;
+		size_t usedSize;
+		size_t freeSize;
+		size_t largestFreeBlock;
+		size_t freeBlockCount;
+		size_t allocationCount;
+	};
+
+public:
+	OffsetAllocator(size_t capacity = 0u) noexcept;
+
+	// Alignment must be a power of two. Returns nothing if there isn't a large enough block.
+	[[nodiscard]]
+	std::optional<Allocation> Allocate(size_t size, size_t alignment) noexcept;
+	// Grows the capacity by as much as the allocation needs if it doesn't fit.
+	[[nodiscard]]
+	Allocation AllocateAndGrow(size_t size, size_t alignment) noexcept;
+	void Free(std::uint32_t handle) noexcept;
+
+	void Grow(size_t capacity) noexcept;
+	// Grows the capacity so a free range of the size starts at an aligned offset at the end.
+	// Allocations of the alignment whose sizes add up to the size all fit into it.
+	void AddSpareSpace(size_t size, size_t alignment) noexcept;
+
+	[[nodiscard]]
+	size_t GetCapacity() const noexcept;
+	[[nodiscard]]
+	Stats GetStats() const noexcept;
+	// 0 while the free space is a single block, closer to 1 the more it is split up.
+	[[nodiscard]]
+	float GetFragmentation() const noexcept;
+
+private:
+	struct Block {
+		size_t offset;
+		size_t size;
+		std::uint32_t previousPhysical;
+		std::uint32_t nextPhysical;
+		std::uint32_t previousFree;
+		std::uint32_t nextFree;
+		bool free;
+	};
+
+	struct BinIndex {
+		std::uint32_t firstLevel;
+		std::uint32_t secondLevel;
+	};
+
+private:
+	[[nodiscard]]
+	static BinIndex GetBinIndex(size_t size) noexcept;
+	[[nodiscard]]
+	static std::uint32_t GetListIndex(const BinIndex& binIndex) noexcept;
+	// The smallest size whose bin only holds blocks of at least the size.
+	[[nodiscard]]
+	static size_t RoundUpToBin(size_t size) noexcept;
+
+	[[nodiscard]]
+	std::uint32_t CreateBlock(size_t offset, size_t size) noexcept;
+	void ReleaseBlock(std::uint32_t blockIndex) noexcept;
+
+	void InsertFreeBlock(std::uint32_t blockIndex) noexcept;
+	void RemoveFreeBlock(std::uint32_t blockIndex) noexcept;
+	[[nodiscard]]
+	std::uint32_t FindFreeBlock(size_t size) const noexcept;
+	// Checks the heads of the lists the good fit searches skip, so a block which only fits
+	// exactly is still found. Only used when those searches fail.
+	[[nodiscard]]
+	std::uint32_t FindFittingBlock(size_t size, size_t alignment) const noexcept;
+	[[nodiscard]]
+	bool DoesBlockFit(std::uint32_t blockIndex, size_t size, size_t alignment) const noexcept;
+	// Splits the padding and the remainder off a free block and marks the rest as used.
+	[[nodiscard]]
+	Allocation AllocateFromBlock(std::uint32_t blockIndex, size_t size, size_t alignment) noexcept;
+
+private:
+	static constexpr std::uint32_t s_secondLevelBits = 4u;
+	static constexpr std::uint32_t s_secondLevelCount = 1u << s_secondLevelBits;
+	static constexpr std::uint32_t s_firstLevelCount = 64u - s_secondLevelBits + 1u;
+	static constexpr std::uint32_t s_nullBlock = 0xFFFFFFFFu;
+
+	std::vector<Block> m_blocks;
+	std::vector<std::uint32_t> m_unusedBlocks;
+	std::array<std::uint32_t, s_firstLevelCount * s_secondLevelCount> m_freeLists;
+	std::array<std::uint32_t, s_firstLevelCount> m_secondLevelBitmaps;
+	std::uint64_t m_firstLevelBitmap;
+	std::uint32_t m_lastBlock;
+	size_t m_capacity;
+	size_t m_usedSize;
+	size_t m_freeBlockCount;
+	size_t m_allocationCount;
+};
+#endif
@@ -0,0 +1,66 @@
+#ifndef PIPELINE_LIBRARY_HPP_
+#define PIPELINE_LIBRARY_HPP_
+#include <D3DHeaders.hpp>
+#include <PipelineCacheFile.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+// Loads the pipeline objects from an ID3D12PipelineLibrary kept across runs, by the key of
+// their description, and compiles only the ones which aren't there. Without a cache path the
+// pipelines are still shared by their key, but nothing is written.
+class PipelineLibrary {
+public:
+	struct CacheStats {
+		std::uint64_t libraryHits;
+		std::uint64_t misses;
+		// Summed over the threads which compiled.
+		double compileSeconds;
+	};
+
+public:
+	PipelineLibrary() noexcept;
+
+	// Must be set before the cache file is read.
+	void SetCachePath(std::wstring cachePath) noexcept;
+	// A file for another adapter, driver or format version is ignored.
+	void ReadCacheFile(ID3D12Device1* device, IDXGIFactory4* factory);
+	// Only writes if a pipeline was added. The pipelines the file had which weren't used since
+	// it was read are dropped, which rebuilds the library from the ones used.
+	void WriteCacheFile(ID3D12Device1* device);
+
+	// Safe to call from multiple threads.
+	[[nodiscard]]
+	ComPtr<ID3D12PipelineState> CreatePipelineState(
+		ID3D12Device2* device, const D3D12_PIPELINE_STATE_STREAM_DESC& streamDesc,
+		std::uint64_t pipelineKey
+	);
+
+	[[nodiscard]]
+	CacheStats GetCacheStats() const noexcept;
+
+private:
+	[[nodiscard]]
+	static std::uint64_t GetDeviceId(ID3D12Device1* device, IDXGIFactory4* factory) noexcept;
+	[[nodiscard]]
+	static std::wstring GetPipelineName(std::uint64_t pipelineKey);
+
+	void CreateLibrary(ID3D12Device1* device, std::vector<std::uint8_t> libraryData);
+
+private:
+	std::wstring m_cachePath;
+	std::uint64_t m_deviceId;
+	// The library reads from the data it was created with, so it is kept until the library is
+	// released.
+	std::vector<std::uint8_t> m_libraryData;
+	ComPtr<ID3D12PipelineLibrary1> m_pLibrary;
+	std::unordered_set<std::uint64_t> m_libraryKeys;
+	std::unordered_map<std::uint64_t, ComPtr<ID3D12PipelineState>> m_pipelines;
+	bool m_libraryChanged;
+	CacheStats m_stats;
+	mutable std::mutex m_libraryMutex;
+};
+#endif
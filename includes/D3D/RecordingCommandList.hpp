@@ -0,0 +1,306 @@
+#ifndef RECORDING_COMMAND_LIST_HPP_
+#define RECORDING_COMMAND_LIST_HPP_
+#include <D3DHeaders.hpp>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+enum class RecordedCommandType : std::uint8_t {
+	Bind,
+	Draw,
+	Dispatch,
+	Indirect,
+	Barrier,
+	Copy,
+	Clear,
+	Other
+};
+
+struct RecordedCommand {
+	RecordedCommandType type;
+	char const* name;
+	// The instances, thread groups, barriers or elements passed to the call.
+	std::uint32_t count;
+};
+
+// Logs every command into a stream which is cleared on Reset and forwards it to the wrapped
+// list. The list passed to a queue must be the wrapped one. Without a list to forward to, it
+// only logs, which is what the headless device hands out as its command lists.
+class RecordingCommandList final : public ID3D12GraphicsCommandList6 {
+public:
+	RecordingCommandList(
+		ID3D12GraphicsCommandList* commandList, ID3D12GraphicsCommandList6* commandList6,
+		D3D12_COMMAND_LIST_TYPE type
+	) noexcept;
+
+	[[nodiscard]]
+	const std::vector<RecordedCommand>& GetCommands() const noexcept;
+	[[nodiscard]]
+	size_t GetCommandCount(RecordedCommandType type) const noexcept;
+
+	// IUnknown
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override;
+	ULONG STDMETHODCALLTYPE AddRef() override;
+	ULONG STDMETHODCALLTYPE Release() override;
+
+	// ID3D12Object
+	HRESULT STDMETHODCALLTYPE GetPrivateData(
+		REFGUID guid, UINT* pDataSize, void* pData
+	) override;
+	HRESULT STDMETHODCALLTYPE SetPrivateData(
+		REFGUID guid, UINT DataSize, const void* pData
+	) override;
+	HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(
+		REFGUID guid, const IUnknown* pData
+	) override;
+	HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override;
+
+	// ID3D12DeviceChild
+	HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override;
+
+	// ID3D12CommandList
+	D3D12_COMMAND_LIST_TYPE STDMETHODCALLTYPE GetType() override;
+
+	// ID3D12GraphicsCommandList
+	HRESULT STDMETHODCALLTYPE Close() override;
+	HRESULT STDMETHODCALLTYPE Reset(
+		ID3D12CommandAllocator* pAllocator, ID3D12PipelineState* pInitialState
+	) override;
+	void STDMETHODCALLTYPE ClearState(ID3D12PipelineState* pPipelineState) override;
+	void STDMETHODCALLTYPE DrawInstanced(
+		UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation,
+		UINT StartInstanceLocation
+	) override;
+	void STDMETHODCALLTYPE DrawIndexedInstanced(
+		UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation,
+		INT BaseVertexLocation, UINT StartInstanceLocation
+	) override;
+	void STDMETHODCALLTYPE Dispatch(
+		UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ
+	) override;
+	void STDMETHODCALLTYPE CopyBufferRegion(
+		ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer,
+		UINT64 SrcOffset, UINT64 NumBytes
+	) override;
+	void STDMETHODCALLTYPE CopyTextureRegion(
+		const D3D12_TEXTURE_COPY_LOCATION* pDst, UINT DstX, UINT DstY, UINT DstZ,
+		const D3D12_TEXTURE_COPY_LOCATION* pSrc, const D3D12_BOX* pSrcBox
+	) override;
+	void STDMETHODCALLTYPE CopyResource(
+		ID3D12Resource* pDstResource, ID3D12Resource* pSrcResource
+	) override;
+	void STDMETHODCALLTYPE CopyTiles(
+		ID3D12Resource* pTiledResource,
+		const D3D12_TILED_RESOURCE_COORDINATE* pTileRegionStartCoordinate,
+		const D3D12_TILE_REGION_SIZE* pTileRegionSize, ID3D12Resource* pBuffer,
+		UINT64 BufferStartOffsetInBytes, D3D12_TILE_COPY_FLAGS Flags
+	) override;
+	void STDMETHODCALLTYPE ResolveSubresource(
+		ID3D12Resource* pDstResource, UINT DstSubresource, ID3D12Resource* pSrcResource,
+		UINT SrcSubresource, DXGI_FORMAT Format
+	) override;
+	void STDMETHODCALLTYPE IASetPrimitiveTopology(
+		D3D12_PRIMITIVE_TOPOLOGY PrimitiveTopology
+	) override;
+	void STDMETHODCALLTYPE RSSetViewports(
+		UINT NumViewports, const D3D12_VIEWPORT* pViewports
+	) override;
+	void STDMETHODCALLTYPE RSSetScissorRects(UINT NumRects, const D3D12_RECT* pRects) override;
+	void STDMETHODCALLTYPE OMSetBlendFactor(const FLOAT BlendFactor[4]) override;
+	void STDMETHODCALLTYPE OMSetStencilRef(UINT StencilRef) override;
+	void STDMETHODCALLTYPE SetPipelineState(ID3D12PipelineState* pPipelineState) override;
+	void STDMETHODCALLTYPE ResourceBarrier(
+		UINT NumBarriers, const D3D12_RESOURCE_BARRIER* pBarriers
+	) override;
+	void STDMETHODCALLTYPE ExecuteBundle(ID3D12GraphicsCommandList* pCommandList) override;
+	void STDMETHODCALLTYPE SetDescriptorHeaps(
+		UINT NumDescriptorHeaps, ID3D12DescriptorHeap* const* ppDescriptorHeaps
+	) override;
+	void STDMETHODCALLTYPE SetComputeRootSignature(
+		ID3D12RootSignature* pRootSignature
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRootSignature(
+		ID3D12RootSignature* pRootSignature
+	) override;
+	void STDMETHODCALLTYPE SetComputeRootDescriptorTable(
+		UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRootDescriptorTable(
+		UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor
+	) override;
+	void STDMETHODCALLTYPE SetComputeRoot32BitConstant(
+		UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRoot32BitConstant(
+		UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues
+	) override;
+	void STDMETHODCALLTYPE SetComputeRoot32BitConstants(
+		UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData,
+		UINT DestOffsetIn32BitValues
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRoot32BitConstants(
+		UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData,
+		UINT DestOffsetIn32BitValues
+	) override;
+	void STDMETHODCALLTYPE SetComputeRootConstantBufferView(
+		UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRootConstantBufferView(
+		UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+	) override;
+	void STDMETHODCALLTYPE SetComputeRootShaderResourceView(
+		UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRootShaderResourceView(
+		UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+	) override;
+	void STDMETHODCALLTYPE SetComputeRootUnorderedAccessView(
+		UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+	) override;
+	void STDMETHODCALLTYPE SetGraphicsRootUnorderedAccessView(
+		UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+	) override;
+	void STDMETHODCALLTYPE IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* pView) override;
+	void STDMETHODCALLTYPE IASetVertexBuffers(
+		UINT StartSlot, UINT NumViews, const D3D12_VERTEX_BUFFER_VIEW* pViews
+	) override;
+	void STDMETHODCALLTYPE SOSetTargets(
+		UINT StartSlot, UINT NumViews, const D3D12_STREAM_OUTPUT_BUFFER_VIEW* pViews
+	) override;
+	void STDMETHODCALLTYPE OMSetRenderTargets(
+		UINT NumRenderTargetDescriptors,
+		const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors,
+		BOOL RTsSingleHandleToDescriptorRange,
+		const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor
+	) override;
+	void STDMETHODCALLTYPE ClearDepthStencilView(
+		D3D12_CPU_DESCRIPTOR_HANDLE DepthStencilView, D3D12_CLEAR_FLAGS ClearFlags,
+		FLOAT Depth, UINT8 Stencil, UINT NumRects, const D3D12_RECT* pRects
+	) override;
+	void STDMETHODCALLTYPE ClearRenderTargetView(
+		D3D12_CPU_DESCRIPTOR_HANDLE RenderTargetView, const FLOAT ColorRGBA[4],
+		UINT NumRects, const D3D12_RECT* pRects
+	) override;
+	void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(
+		D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap,
+		D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource,
+		const UINT Values[4], UINT NumRects, const D3D12_RECT* pRects
+	) override;
+	void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(
+		D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap,
+		D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource,
+		const FLOAT Values[4], UINT NumRects, const D3D12_RECT* pRects
+	) override;
+	void STDMETHODCALLTYPE DiscardResource(
+		ID3D12Resource* pResource, const D3D12_DISCARD_REGION* pRegion
+	) override;
+	void STDMETHODCALLTYPE BeginQuery(
+		ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index
+	) override;
+	void STDMETHODCALLTYPE EndQuery(
+		ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index
+	) override;
+	void STDMETHODCALLTYPE ResolveQueryData(
+		ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT StartIndex, UINT NumQueries,
+		ID3D12Resource* pDestinationBuffer, UINT64 AlignedDestinationBufferOffset
+	) override;
+	void STDMETHODCALLTYPE SetPredication(
+		ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation
+	) override;
+	void STDMETHODCALLTYPE SetMarker(UINT Metadata, const void* pData, UINT Size) override;
+	void STDMETHODCALLTYPE BeginEvent(UINT Metadata, const void* pData, UINT Size) override;
+	void STDMETHODCALLTYPE EndEvent() override;
+	void STDMETHODCALLTYPE ExecuteIndirect(
+		ID3D12CommandSignature* pCommandSignature, UINT MaxCommandCount,
+		ID3D12Resource* pArgumentBuffer, UINT64 ArgumentBufferOffset,
+		ID3D12Resource* pCountBuffer, UINT64 CountBufferOffset
+	) override;
+
+	// ID3D12GraphicsCommandList1
+	void STDMETHODCALLTYPE AtomicCopyBufferUINT(
+		ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer,
+		UINT64 SrcOffset, UINT Dependencies, ID3D12Resource* const* ppDependentResources,
+		const D3D12_SUBRESOURCE_RANGE_UINT64* pDependentSubresourceRanges
+	) override;
+	void STDMETHODCALLTYPE AtomicCopyBufferUINT64(
+		ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer,
+		UINT64 SrcOffset, UINT Dependencies, ID3D12Resource* const* ppDependentResources,
+		const D3D12_SUBRESOURCE_RANGE_UINT64* pDependentSubresourceRanges
+	) override;
+	void STDMETHODCALLTYPE OMSetDepthBounds(FLOAT Min, FLOAT Max) override;
+	void STDMETHODCALLTYPE SetSamplePositions(
+		UINT NumSamplesPerPixel, UINT NumPixels, D3D12_SAMPLE_POSITION* pSamplePositions
+	) override;
+	void STDMETHODCALLTYPE ResolveSubresourceRegion(
+		ID3D12Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY,
+		ID3D12Resource* pSrcResource, UINT SrcSubresource, D3D12_RECT* pSrcRect,
+		DXGI_FORMAT Format, D3D12_RESOLVE_MODE ResolveMode
+	) override;
+	void STDMETHODCALLTYPE SetViewInstanceMask(UINT Mask) override;
+
+	// ID3D12GraphicsCommandList2
+	void STDMETHODCALLTYPE WriteBufferImmediate(
+		UINT Count, const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER* pParams,
+		const D3D12_WRITEBUFFERIMMEDIATE_MODE* pModes
+	) override;
+
+	// ID3D12GraphicsCommandList3
+	void STDMETHODCALLTYPE SetProtectedResourceSession(
+		ID3D12ProtectedResourceSession* pProtectedResourceSession
+	) override;
+
+	// ID3D12GraphicsCommandList4
+	void STDMETHODCALLTYPE BeginRenderPass(
+		UINT NumRenderTargets, const D3D12_RENDER_PASS_RENDER_TARGET_DESC* pRenderTargets,
+		const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* pDepthStencil,
+		D3D12_RENDER_PASS_FLAGS Flags
+	) override;
+	void STDMETHODCALLTYPE EndRenderPass() override;
+	void STDMETHODCALLTYPE InitializeMetaCommand(
+		ID3D12MetaCommand* pMetaCommand, const void* pInitializationParametersData,
+		SIZE_T InitializationParametersDataSizeInBytes
+	) override;
+	void STDMETHODCALLTYPE ExecuteMetaCommand(
+		ID3D12MetaCommand* pMetaCommand, const void* pExecutionParametersData,
+		SIZE_T ExecutionParametersDataSizeInBytes
+	) override;
+	void STDMETHODCALLTYPE BuildRaytracingAccelerationStructure(
+		const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC* pDesc,
+		UINT NumPostbuildInfoDescs,
+		const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC* pPostbuildInfoDescs
+	) override;
+	void STDMETHODCALLTYPE EmitRaytracingAccelerationStructurePostbuildInfo(
+		const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC* pDesc,
+		UINT NumSourceAccelerationStructures,
+		const D3D12_GPU_VIRTUAL_ADDRESS* pSourceAccelerationStructureData
+	) override;
+	void STDMETHODCALLTYPE CopyRaytracingAccelerationStructure(
+		D3D12_GPU_VIRTUAL_ADDRESS DestAccelerationStructureData,
+		D3D12_GPU_VIRTUAL_ADDRESS SourceAccelerationStructureData,
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE Mode
+	) override;
+	void STDMETHODCALLTYPE SetPipelineState1(ID3D12StateObject* pStateObject) override;
+	void STDMETHODCALLTYPE DispatchRays(const D3D12_DISPATCH_RAYS_DESC* pDesc) override;
+
+	// ID3D12GraphicsCommandList5
+	void STDMETHODCALLTYPE RSSetShadingRate(
+		D3D12_SHADING_RATE baseShadingRate, const D3D12_SHADING_RATE_COMBINER* combiners
+	) override;
+	void STDMETHODCALLTYPE RSSetShadingRateImage(ID3D12Resource* shadingRateImage) override;
+
+	// ID3D12GraphicsCommandList6
+	void STDMETHODCALLTYPE DispatchMesh(
+		UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ
+	) override;
+
+private:
+	void Record(RecordedCommandType type, char const* name, UINT count = 1u);
+
+private:
+	std::atomic<ULONG> m_referenceCount;
+	ComPtr<ID3D12GraphicsCommandList> m_pCommandList;
+	ComPtr<ID3D12GraphicsCommandList6> m_pCommandList6;
+	D3D12_COMMAND_LIST_TYPE m_type;
+	std::vector<RecordedCommand> m_commands;
+};
+#endif
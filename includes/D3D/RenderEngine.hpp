@@ -1,53 +1,83 @@
-#ifndef RENDER_ENGINE_
-#define RENDER_ENGINE_
-#include <D3DHeaders.hpp>
-#include <vector>
-#include <array>
-#include <memory>
-#include <string>
-#include <IModel.hpp>
-
-class RenderEngine {
-public:
-	RenderEngine() noexcept;
-	virtual ~RenderEngine() = default;
-
-	virtual void ExecuteRenderStage(size_t frameIndex) = 0;
-	virtual void Present(size_t frameIndex) = 0;
-	virtual void ExecutePostRenderStage() = 0;
-	virtual void ConstructPipelines() = 0;
-	virtual void UpdateModelBuffers(size_t frameIndex) const noexcept = 0;
-
-	virtual void CreateDepthBufferView(
-		ID3D12Device* device, std::uint32_t width, std::uint32_t height
-	) = 0;
-	virtual void ResizeViewportAndScissor(
-		std::uint32_t width, std::uint32_t height
-	) noexcept = 0;
-	virtual void AddGVerticesAndIndices(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-	) noexcept = 0;
-	virtual void RecordModelDataSet(
-		const std::vector<std::shared_ptr<IModel>>& models, const std::wstring& pixelShader
-	) noexcept = 0;
-	virtual void AddMeshletModelSet(
-		std::vector<MeshletModel>& meshletModels, const std::wstring& pixelShader
-	) noexcept = 0;
-	virtual void AddGVerticesAndPrimIndices(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
-		std::vector<std::uint32_t>&& gPrimIndices
-	) noexcept = 0;
-
-	virtual void CreateBuffers(ID3D12Device* device) = 0;
-	virtual void ReserveBuffers(ID3D12Device* device) = 0;
-	virtual void RecordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept = 0;
-	virtual void ReleaseUploadResources() noexcept = 0;
-
-	void SetBackgroundColour(const std::array<float, 4>& colour) noexcept;
-	void SetShaderPath(const wchar_t* path) noexcept;
-
-protected:
-	std::array<float, 4> m_backgroundColour;
-	std::wstring m_shaderPath;
-};
-#endif
+#ifndef RENDER_ENGINE_
+#define RENDER_ENGINE_
+#include <D3DHeaders.hpp>
+#include <vector>
+#include <array>
+#include <memory>
+#include <string>
+#include <IModel.hpp>
+#include <FrameTaskGraph.hpp>
+
+class RenderEngine {
+public:
+	struct CullingStats {
+		size_t visibleModels;
+		size_t culledModels;
+	};
+
+public:
+	RenderEngine() noexcept;
+	virtual ~RenderEngine() = default;
+
+	// Adds the buffer updates and the command recording of a frame, everything up to the
+	// present.
+	virtual void RegisterFrameTasks(FrameTaskGraph& frameTasks) = 0;
+	virtual void Present(size_t frameIndex) = 0;
+	virtual void ExecutePostRenderStage() = 0;
+	virtual void ConstructPipelines() = 0;
+
+	virtual void CreateDepthBufferView(
+		ID3D12Device* device, std::uint32_t width, std::uint32_t height
+	) = 0;
+	virtual void ResizeViewportAndScissor(
+		std::uint32_t width, std::uint32_t height
+	) noexcept = 0;
+	[[nodiscard]]
+	virtual ModelInputRange AddGVerticesAndIndices(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) = 0;
+	[[nodiscard]]
+	virtual ModelInputRange AddGVerticesAndIndices(
+		std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) = 0;
+	virtual void RemoveGVerticesAndIndices(size_t inputId) = 0;
+	// Returns the index of the set. The model ids are where the models are in the model
+	// buffers.
+	[[nodiscard]]
+	virtual size_t RecordModelDataSet(
+		const std::vector<std::shared_ptr<IModel>>& models,
+		const std::vector<std::uint32_t>& modelIds, const std::wstring& pixelShader
+	) = 0;
+	virtual void RemoveModelDataSet(size_t modelSetIndex) = 0;
+	// The room for model sets and inputs added after the buffers are reserved.
+	virtual void SetSpareCapacity(
+		size_t modelCount, size_t modelSetCount, size_t vertexCount, size_t indexCount
+	) noexcept = 0;
+	virtual void AddMeshletModelSet(
+		std::vector<MeshletModel>& meshletModels, const std::wstring& pixelShader
+	) noexcept = 0;
+	virtual void AddGVerticesAndPrimIndices(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
+		std::vector<std::uint32_t>&& gPrimIndices
+	) noexcept = 0;
+
+	virtual void CreateBuffers(ID3D12Device* device) = 0;
+	virtual void ReserveBuffers(ID3D12Device* device) = 0;
+	virtual void RecordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept = 0;
+	virtual void ReleaseUploadResources() noexcept = 0;
+
+	void SetBackgroundColour(const std::array<float, 4>& colour) noexcept;
+	void SetShaderPath(const wchar_t* path) noexcept;
+	// Only the engines culling on the compute queue overlap it with the drawing.
+	virtual void SetCullingOverlap(bool enable) noexcept;
+	// Only the individual draw engine draws the models sharing an index range as instances.
+	virtual void SetAutoInstancing(bool enable) noexcept;
+
+	[[nodiscard]]
+	virtual CullingStats GetCullingStats() const noexcept;
+
+protected:
+	std::array<float, 4> m_backgroundColour;
+	std::wstring m_shaderPath;
+};
+#endif
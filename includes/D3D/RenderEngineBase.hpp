@@ -1,74 +1,203 @@
-#ifndef RENDER_ENGINE_BASE_HPP_
-#define RENDER_ENGINE_BASE_HPP_
-#include <concepts>
-#include <RenderEngine.hpp>
-#include <RootSignatureDynamic.hpp>
-#include <GraphicsPipelineBase.hpp>
-#include <ViewportAndScissorManager.hpp>
-#include <DepthBuffer.hpp>
-
-class RenderEngineBase : public RenderEngine {
-public:
-	RenderEngineBase(ID3D12Device* device);
-
-	void Present(size_t frameIndex) final;
-	void ExecutePostRenderStage() final;
-
-	void ResizeViewportAndScissor(std::uint32_t width, std::uint32_t height) noexcept final;
-	void CreateDepthBufferView(
-		ID3D12Device* device, std::uint32_t width, std::uint32_t height
-	) final;
-	void ReserveBuffers(ID3D12Device* device) final;
-
-	virtual void AddGVerticesAndIndices(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-	) noexcept override;
-	virtual void RecordModelDataSet(
-		const std::vector<std::shared_ptr<IModel>>& models, const std::wstring& pixelShader
-	) noexcept override;
-	virtual void AddMeshletModelSet(
-		std::vector<MeshletModel>& meshletModels, const std::wstring& pixelShader
-	) noexcept override;
-	virtual void AddGVerticesAndPrimIndices(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
-		std::vector<std::uint32_t>&& gPrimIndices
-	) noexcept override;
-
-protected:
-	void ExecutePreGraphicsStage(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	);
-	void BindCommonGraphicsBuffers(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	);
-
-	[[nodiscard]]
-	virtual std::unique_ptr<RootSignatureDynamic> CreateGraphicsRootSignature(
-		ID3D12Device* device
-	) const noexcept = 0;
-
-	virtual void ReserveBuffersDerived(ID3D12Device* device);
-
-	void ConstructGraphicsRootSignature(ID3D12Device* device);
-
-	template<std::derived_from<GraphicsPipelineBase> Pipeline>
-	void CreateGraphicsPipelines(
-		ID3D12Device2* device, std::unique_ptr<Pipeline>& graphicsPipeline0,
-		std::vector<std::unique_ptr<Pipeline>>& graphicsPipelines
-	) const noexcept {
-		ID3D12RootSignature* graphicsRootSig = m_graphicsRS->Get();
-
-		graphicsPipeline0->CreateGraphicsPipeline(device, graphicsRootSig, m_shaderPath);
-		for (auto& graphicsPipeline : graphicsPipelines)
-			graphicsPipeline->CreateGraphicsPipeline(device, graphicsRootSig, m_shaderPath);
-	}
-
-protected:
-	std::unique_ptr<RootSignatureBase> m_graphicsRS;
-	RSLayoutType m_graphicsRSLayout;
-
-private:
-	ViewportAndScissorManager m_viewportAndScissor;
-	DepthBuffer m_depthBuffer;
-};
-#endif
+#ifndef RENDER_ENGINE_BASE_HPP_
+#define RENDER_ENGINE_BASE_HPP_
+#include <concepts>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <RenderEngine.hpp>
+#include <RootSignatureDynamic.hpp>
+#include <GraphicsPipelineBase.hpp>
+#include <ViewportAndScissorManager.hpp>
+#include <DepthBuffer.hpp>
+
+class RenderEngineBase : public RenderEngine {
+public:
+	RenderEngineBase(ID3D12Device* device);
+
+	void Present(size_t frameIndex) final;
+	void ExecutePostRenderStage() final;
+
+	void ResizeViewportAndScissor(std::uint32_t width, std::uint32_t height) noexcept final;
+	void CreateDepthBufferView(
+		ID3D12Device* device, std::uint32_t width, std::uint32_t height
+	) final;
+	void ReserveBuffers(ID3D12Device* device) final;
+
+	[[nodiscard]]
+	virtual ModelInputRange AddGVerticesAndIndices(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) override;
+	[[nodiscard]]
+	virtual ModelInputRange AddGVerticesAndIndices(
+		std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) override;
+	virtual void RemoveGVerticesAndIndices(size_t inputId) override;
+	[[nodiscard]]
+	virtual size_t RecordModelDataSet(
+		const std::vector<std::shared_ptr<IModel>>& models,
+		const std::vector<std::uint32_t>& modelIds, const std::wstring& pixelShader
+	) override;
+	virtual void RemoveModelDataSet(size_t modelSetIndex) override;
+	virtual void SetSpareCapacity(
+		size_t modelCount, size_t modelSetCount, size_t vertexCount, size_t indexCount
+	) noexcept override;
+	virtual void AddMeshletModelSet(
+		std::vector<MeshletModel>& meshletModels, const std::wstring& pixelShader
+	) noexcept override;
+	virtual void AddGVerticesAndPrimIndices(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
+		std::vector<std::uint32_t>&& gPrimIndices
+	) noexcept override;
+
+protected:
+	// A part of the draws of a pipeline, recorded by one job.
+	struct DrawRange {
+		size_t pipelineIndex;
+		size_t drawStart;
+		size_t drawEnd;
+	};
+
+protected:
+	void ExecutePreGraphicsStage(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	);
+	void BindCommonGraphicsBuffers(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	);
+
+	static void RegisterBufferUpdateTasks(FrameTaskGraph& frameTasks, bool modelWithNoBB);
+	void RegisterPreGraphicsTask(FrameTaskGraph& frameTasks);
+
+	// Every job records into a list of its own from the pool, on the thread pool. The lists
+	// are submitted after the main list in the job order. The jobs must bind their pipeline
+	// and buffers, the render targets are already set.
+	void RecordDrawJobs(
+		size_t jobCount, const std::function<void(D3DCommandList&, size_t)>& recordJob,
+		size_t frameIndex
+	);
+	[[nodiscard]]
+	static bool ShouldRecordInParallel(size_t drawCount) noexcept;
+	static void AddDrawRanges(
+		std::vector<DrawRange>& drawRanges, size_t pipelineIndex, size_t drawCount
+	);
+
+	[[nodiscard]]
+	virtual std::unique_ptr<RootSignatureDynamic> CreateGraphicsRootSignature(
+		ID3D12Device* device
+	) const noexcept = 0;
+
+	virtual void ReserveBuffersDerived(ID3D12Device* device);
+	// For the data added after the buffers were created, recorded before any draws.
+	virtual void RecordRuntimeUploads(ID3D12GraphicsCommandList* graphicsCommandList);
+
+	void ConstructGraphicsRootSignature(ID3D12Device* device);
+
+	// The objects are created on the thread pool, one per pixel shader, along with the other
+	// creations passed in. Each creation only writes its own pipeline, so the result doesn't
+	// depend on the order they run in.
+	template<std::derived_from<GraphicsPipelineBase> Pipeline>
+	void CreateGraphicsPipelines(
+		ID3D12Device2* device, std::unique_ptr<Pipeline>& graphicsPipeline0,
+		std::vector<std::unique_ptr<Pipeline>>& graphicsPipelines,
+		std::vector<std::function<void()>> pipelineCreations = {}
+	) const {
+		ID3D12RootSignature* graphicsRootSig = m_graphicsRS->Get();
+
+		// The sets with the same pixel shader share the object of the first one, once it has
+		// been created.
+		std::unordered_map<std::wstring, const Pipeline*> createdPipelines{};
+		std::vector<std::pair<Pipeline*, const Pipeline*>> sharingPipelines{};
+
+		auto addPipeline = [&](Pipeline& graphicsPipeline) {
+			const auto [createdPipeline, newShader] = createdPipelines.try_emplace(
+				graphicsPipeline.GetPixelShader(), &graphicsPipeline
+			);
+
+			if (newShader)
+				pipelineCreations.emplace_back([this, device, graphicsRootSig, &graphicsPipeline] {
+					graphicsPipeline.CreateGraphicsPipeline(device, graphicsRootSig, m_shaderPath);
+				});
+			else
+				sharingPipelines.emplace_back(&graphicsPipeline, createdPipeline->second);
+		};
+
+		// Every set might be added later on.
+		if (graphicsPipeline0)
+			addPipeline(*graphicsPipeline0);
+
+		for (auto& graphicsPipeline : graphicsPipelines)
+			if (graphicsPipeline)
+				addPipeline(*graphicsPipeline);
+
+		RunPipelineCreations(pipelineCreations);
+
+		for (auto [graphicsPipeline, createdPipeline] : sharingPipelines)
+			graphicsPipeline->SharePipelineObject(*createdPipeline);
+	}
+
+	// Every creation is run, even if some of them fail. The failures are thrown afterwards as
+	// one exception, with their messages in the creation order.
+	static void RunPipelineCreations(const std::vector<std::function<void()>>& pipelineCreations);
+
+	// Returns the pipeline index, the set index for the engines with a pipeline per set. Once
+	// the pipelines are constructed, new ones are created here.
+	template<std::derived_from<GraphicsPipelineBase> Pipeline>
+	[[nodiscard]]
+	size_t AddGraphicsPipeline(
+		ID3D12Device2* device, std::unique_ptr<Pipeline>&& graphicsPipeline,
+		std::unique_ptr<Pipeline>& graphicsPipeline0,
+		std::vector<std::unique_ptr<Pipeline>>& graphicsPipelines
+	) const {
+		if (m_graphicsRS) {
+			auto samePixelShader = [&graphicsPipeline](const std::unique_ptr<Pipeline>& pipeline) {
+				return pipeline && pipeline->GetPixelShader() == graphicsPipeline->GetPixelShader();
+			};
+
+			const auto sharedPipeline = std::ranges::find_if(graphicsPipelines, samePixelShader);
+
+			if (samePixelShader(graphicsPipeline0))
+				graphicsPipeline->SharePipelineObject(*graphicsPipeline0);
+			else if (sharedPipeline != std::end(graphicsPipelines))
+				graphicsPipeline->SharePipelineObject(**sharedPipeline);
+			else
+				graphicsPipeline->CreateGraphicsPipeline(
+					device, m_graphicsRS->Get(), m_shaderPath
+				);
+		}
+
+		if (!graphicsPipeline0) {
+			graphicsPipeline0 = std::move(graphicsPipeline);
+
+			return 0u;
+		}
+
+		graphicsPipelines.emplace_back(std::move(graphicsPipeline));
+
+		return std::size(graphicsPipelines);
+	}
+
+	// The frames in flight might still be using the pipeline object.
+	static void ReleaseGraphicsPipeline(std::shared_ptr<GraphicsPipelineBase> graphicsPipeline);
+
+protected:
+	std::unique_ptr<RootSignatureBase> m_graphicsRS;
+	RSLayoutType m_graphicsRSLayout;
+
+	// Below this many draws a single list is quicker.
+	static constexpr size_t s_parallelDrawThreshold = 2048u;
+	static constexpr size_t s_drawsPerJob = 512u;
+
+private:
+	void BindRenderTargets(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	) const noexcept;
+
+private:
+	ViewportAndScissorManager m_viewportAndScissor;
+	DepthBuffer m_depthBuffer;
+	std::vector<D3DCommandList*> m_drawCommandLists;
+
+protected:
+	std::vector<DrawRange> m_drawRanges;
+};
+#endif
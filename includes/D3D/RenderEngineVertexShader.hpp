@@ -1,127 +1,224 @@
-#ifndef RENDER_ENGINE_VERTEX_SHADER_HPP_
-#define RENDER_ENGINE_VERTEX_SHADER_HPP_
-#include <RenderEngineBase.hpp>
-#include <ComputePipelineIndirectDraw.hpp>
-#include <GraphicsPipelineVertexShader.hpp>
-#include <VertexManagerVertexShader.hpp>
-#include <optional>
-
-class RenderEngineVertexShader : public RenderEngineBase {
-public:
-	RenderEngineVertexShader(ID3D12Device* device);
-
-	void AddGVerticesAndIndices(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-	) noexcept final;
-	void ExecuteRenderStage(size_t frameIndex) final;
-
-	void CreateBuffers(ID3D12Device* device) final;
-	void RecordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept final;
-	void ReleaseUploadResources() noexcept final;
-
-protected:
-	[[nodiscard]]
-	std::unique_ptr<RootSignatureDynamic> CreateGraphicsRootSignature(
-		ID3D12Device* device
-	) const noexcept final;
-
-	void ReserveBuffersDerived(ID3D12Device* device) final;
-
-	void BindGraphicsBuffers(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	);
-
-	virtual void _createBuffers(ID3D12Device* device);
-	virtual void _reserveBuffers(ID3D12Device* device);
-	virtual void _recordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept;
-	virtual void _releaseUploadResources() noexcept;
-
-	virtual void ExecutePreRenderStage(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	) = 0;
-	virtual void RecordDrawCommands(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	) = 0;
-
-private:
-	VertexManagerVertexShader m_vertexManager;
-};
-
-class RenderEngineIndirectDraw final : public RenderEngineVertexShader {
-public:
-	struct Args {
-		std::optional<ID3D12Device*> device;
-		std::optional<std::uint32_t> frameCount;
-	};
-
-public:
-	RenderEngineIndirectDraw(const Args& arguments);
-
-	void ConstructPipelines() final;
-
-	void RecordModelDataSet(
-		const std::vector<std::shared_ptr<IModel>>& models, const std::wstring& pixelShader
-	) noexcept final;
-
-private:
-	void _createBuffers(ID3D12Device* device) override;
-	void _reserveBuffers(ID3D12Device* device) override;
-	void _recordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept override;
-	void _releaseUploadResources() noexcept override;
-
-	void CreateCommandSignature(ID3D12Device* device);
-	void ExecuteComputeStage(size_t frameIndex);
-
-	void ExecutePreRenderStage(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	) final;
-	void RecordDrawCommands(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	) final;
-	void UpdateModelBuffers(size_t frameIndex) const noexcept final;
-
-	using GraphicsPipeline = std::unique_ptr<GraphicsPipelineIndirectDraw>;
-
-private:
-	ComputePipelineIndirectDraw m_computePipeline;
-	GraphicsPipeline m_graphicsPipeline0;
-	std::vector<GraphicsPipeline> m_graphicsPipelines;
-
-	ComPtr<ID3D12CommandSignature> m_commandSignature;
-};
-
-class RenderEngineIndividualDraw final : public RenderEngineVertexShader {
-public:
-	struct Args {
-		std::optional<ID3D12Device*> device;
-	};
-
-public:
-	RenderEngineIndividualDraw(const Args& arguments);
-
-	void ConstructPipelines() final;
-
-	void RecordModelDataSet(
-		const std::vector<std::shared_ptr<IModel>>& models, const std::wstring& pixelShader
-	) noexcept final;
-	void UpdateModelBuffers(size_t frameIndex) const noexcept final;
-
-private:
-	using GraphicsPipeline = std::unique_ptr<GraphicsPipelineIndividualDraw>;
-
-	void RecordModelArguments(const std::vector<std::shared_ptr<IModel>>& models) noexcept;
-
-	void ExecutePreRenderStage(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	) final;
-	void RecordDrawCommands(
-		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-	) final;
-
-private:
-	GraphicsPipeline m_graphicsPipeline0;
-	std::vector<GraphicsPipeline> m_graphicsPipelines;
-
-	std::vector<ModelDrawArguments> m_modelArguments;
-};
-#endif
+#ifndef RENDER_ENGINE_VERTEX_SHADER_HPP_
+#define RENDER_ENGINE_VERTEX_SHADER_HPP_
+#include <RenderEngineBase.hpp>
+#include <ComputePipelineIndirectDraw.hpp>
+#include <GraphicsPipelineVertexShader.hpp>
+#include <VertexManagerVertexShader.hpp>
+#include <FrustumCuller.hpp>
+#include <CullingSchedule.hpp>
+#include <D3DDescriptorView.hpp>
+#include <DrawKeySorter.hpp>
+#include <optional>
+#include <unordered_map>
+
+class RenderEngineVertexShader : public RenderEngineBase {
+public:
+	RenderEngineVertexShader(ID3D12Device* device, VertexFormat vertexFormat);
+
+	[[nodiscard]]
+	ModelInputRange AddGVerticesAndIndices(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) final;
+	[[nodiscard]]
+	ModelInputRange AddGVerticesAndIndices(
+		std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) final;
+	void RemoveGVerticesAndIndices(size_t inputId) final;
+
+	void CreateBuffers(ID3D12Device* device) final;
+	void RecordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept final;
+	void ReleaseUploadResources() noexcept final;
+
+protected:
+	[[nodiscard]]
+	std::unique_ptr<RootSignatureDynamic> CreateGraphicsRootSignature(
+		ID3D12Device* device
+	) const noexcept final;
+
+	void ReserveBuffersDerived(ID3D12Device* device) final;
+	void RecordRuntimeUploads(ID3D12GraphicsCommandList* graphicsCommandList) final;
+	void SetSpareInputCapacity(size_t vertexCount, size_t indexCount) noexcept;
+
+	void BindGraphicsBuffers(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	);
+
+	virtual void _createBuffers(ID3D12Device* device);
+	virtual void _reserveBuffers(ID3D12Device* device);
+	virtual void _recordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept;
+	virtual void _releaseUploadResources() noexcept;
+	virtual void _addGraphicsRootParameters(RootSignatureDynamic& signature) const noexcept;
+
+	virtual void RecordDrawCommands(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	) = 0;
+	void RegisterDrawTask(FrameTaskGraph& frameTasks, FrameResource reads);
+
+protected:
+	VertexFormat m_vertexFormat;
+
+private:
+	VertexManagerVertexShader m_vertexManager;
+};
+
+class RenderEngineIndirectDraw final : public RenderEngineVertexShader {
+public:
+	struct Args {
+		std::optional<ID3D12Device*> device;
+		std::optional<std::uint32_t> frameCount;
+		std::optional<VertexFormat> vertexFormat = VertexFormat::Full;
+	};
+
+public:
+	RenderEngineIndirectDraw(const Args& arguments);
+
+	void ConstructPipelines() final;
+	void RegisterFrameTasks(FrameTaskGraph& frameTasks) final;
+
+	[[nodiscard]]
+	size_t RecordModelDataSet(
+		const std::vector<std::shared_ptr<IModel>>& models,
+		const std::vector<std::uint32_t>& modelIds, const std::wstring& pixelShader
+	) final;
+	void RemoveModelDataSet(size_t modelSetIndex) final;
+	void SetSpareCapacity(
+		size_t modelCount, size_t modelSetCount, size_t vertexCount, size_t indexCount
+	) noexcept final;
+	void SetCullingOverlap(bool enable) noexcept final;
+
+private:
+	void _createBuffers(ID3D12Device* device) override;
+	void _reserveBuffers(ID3D12Device* device) override;
+	void _recordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept override;
+	void _releaseUploadResources() noexcept override;
+
+	void CreateCommandSignature(ID3D12Device* device);
+	void ScheduleCulling(size_t frameIndex);
+	void ExecuteComputeStage(size_t frameIndex);
+	void UpdateDrawOrder();
+
+	[[nodiscard]]
+	GraphicsPipelineIndirectDraw* GetGraphicsPipeline(size_t modelSetIndex) const noexcept;
+
+	void RecordDrawCommands(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	) final;
+
+	using GraphicsPipeline = std::unique_ptr<GraphicsPipelineIndirectDraw>;
+
+private:
+	ComputePipelineIndirectDraw m_computePipeline;
+	CullingSchedule m_cullingSchedule;
+	CullingSchedule::FrameSync m_frameSync;
+	GraphicsPipeline m_graphicsPipeline0;
+	std::vector<GraphicsPipeline> m_graphicsPipelines;
+	// Indexed by the set index, an empty optional marks a removed set.
+	std::vector<std::optional<ComputePipelineIndirectDraw::ArgumentRange>> m_setArgumentRanges;
+	// The sets which aren't removed, the ones with the same pixel shader next to each other.
+	std::vector<size_t> m_drawOrder;
+
+	ComPtr<ID3D12CommandSignature> m_commandSignature;
+};
+
+class RenderEngineIndividualDraw final : public RenderEngineVertexShader {
+public:
+	struct Args {
+		std::optional<ID3D12Device*> device;
+		std::optional<std::uint32_t> frameCount;
+		std::optional<VertexFormat> vertexFormat = VertexFormat::Full;
+	};
+
+public:
+	RenderEngineIndividualDraw(const Args& arguments);
+
+	void ConstructPipelines() final;
+	void RegisterFrameTasks(FrameTaskGraph& frameTasks) final;
+
+	[[nodiscard]]
+	size_t RecordModelDataSet(
+		const std::vector<std::shared_ptr<IModel>>& models,
+		const std::vector<std::uint32_t>& modelIds, const std::wstring& pixelShader
+	) final;
+	void RemoveModelDataSet(size_t modelSetIndex) final;
+	void SetSpareCapacity(
+		size_t modelCount, size_t modelSetCount, size_t vertexCount, size_t indexCount
+	) noexcept final;
+
+	// Must be set before the model sets are added, as the instanced draws have vertex shaders
+	// of their own.
+	void SetAutoInstancing(bool enable) noexcept final;
+
+	[[nodiscard]]
+	CullingStats GetCullingStats() const noexcept final;
+
+private:
+	using GraphicsPipeline = std::unique_ptr<GraphicsPipelineIndividualDraw>;
+
+	// The sets with the same pixel shader are drawn with the same pipeline.
+	[[nodiscard]]
+	size_t AddPixelShaderPipeline(const std::wstring& pixelShader);
+	void RecordModelArguments(
+		const std::vector<std::shared_ptr<IModel>>& models,
+		const std::vector<std::uint32_t>& modelIds, std::uint32_t pipelineIndex
+	) noexcept;
+	void CullModels(size_t frameIndex);
+	void BuildInstanceBatches(size_t frameIndex);
+	void RecordDrawCommandsInParallel(size_t frameIndex);
+	void DrawPipelineModels(
+		const GraphicsPipelineIndividualDraw& graphicsPipeline,
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t drawStart, size_t drawEnd
+	) const noexcept;
+	void BindInstanceBuffer(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	) const noexcept;
+
+	[[nodiscard]]
+	GraphicsPipelineIndividualDraw* GetGraphicsPipeline(size_t pipelineIndex) const noexcept;
+	// The instance batches when the frame is drawn instanced, otherwise the visible models.
+	[[nodiscard]]
+	size_t GetPipelineDrawCount(
+		const GraphicsPipelineIndividualDraw& graphicsPipeline
+	) const noexcept;
+
+	void _createBuffers(ID3D12Device* device) override;
+	void _reserveBuffers(ID3D12Device* device) override;
+	void _addGraphicsRootParameters(RootSignatureDynamic& signature) const noexcept override;
+
+	void RecordDrawCommands(
+		ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+	) final;
+
+private:
+	GraphicsPipeline m_graphicsPipeline0;
+	std::vector<GraphicsPipeline> m_graphicsPipelines;
+
+	std::unordered_map<std::wstring, size_t> m_pixelShaderPipelines;
+	// Indexed by the pipeline index.
+	std::vector<size_t> m_pipelineSetCounts;
+
+	// Indexed by the model id.
+	std::vector<ModelDrawArguments> m_modelArguments;
+	// The key has the model's pipeline.
+	std::vector<std::uint64_t> m_modelDrawKeys;
+	// The index of the model's range in its pipeline's meshes.
+	std::vector<std::uint32_t> m_modelMeshIndices;
+	// Indexed by the set index, an empty optional marks a removed set.
+	std::vector<std::optional<size_t>> m_setPipelineIndices;
+	std::vector<std::vector<std::uint32_t>> m_modelSetModelIds;
+	size_t m_activeModelCount;
+	FrustumCuller m_frustumCuller;
+	std::vector<std::uint32_t> m_visibleModels;
+	std::vector<DrawKey> m_drawKeys;
+	DrawKeySorter m_drawKeySorter;
+	CullingStats m_cullingStats;
+
+	// The model ids of each frame's instances, in the order of the batches.
+	D3DDescriptorView m_instanceModelBuffers;
+	std::vector<std::uint32_t> m_instanceModelIndices;
+	std::uint32_t m_frameCount;
+	size_t m_spareModelCount;
+	size_t m_instanceCapacity;
+	bool m_autoInstancing;
+	bool m_drawInstanced;
+};
+#endif
@@ -1,58 +1,128 @@
-#ifndef RENDERER_DX12_HPP_
-#define RENDERER_DX12_HPP_
-#include <Renderer.hpp>
-#include <string>
-#include <ObjectManager.hpp>
-
-class RendererDx12 final : public Renderer {
-public:
-	RendererDx12(
-		const char* appName,
-		void* windowHandle, std::uint32_t width, std::uint32_t height,
-		std::uint32_t bufferCount, RenderEngineType engineType
-	);
-
-	void Resize(std::uint32_t width, std::uint32_t height) override;
-
-	[[nodiscard]]
-	Resolution GetFirstDisplayCoordinates() const override;
-
-	void SetThreadPool(std::shared_ptr<IThreadPool> threadPoolArg) noexcept override;
-	void SetBackgroundColour(const std::array<float, 4>& colour) noexcept override;
-	void SetShaderPath(const wchar_t* path) noexcept override;
-	void SetSharedDataContainer(
-		std::shared_ptr<ISharedDataContainer> sharedData
-	) noexcept override;
-
-	[[nodiscard]]
-	size_t AddTexture(
-		std::unique_ptr<std::uint8_t> textureData, size_t width, size_t height
-	) override;
-
-	void AddModelSet(
-		std::vector<std::shared_ptr<IModel>>&& models, const std::wstring& pixelShader
-	) override;
-	void AddMeshletModelSet(
-		std::vector<MeshletModel>&& meshletModels, const std::wstring& pixelShader
-	) override;
-	void AddModelInputs(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-	) override;
-	void AddModelInputs(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
-		std::vector<std::uint32_t>&& gPrimIndices
-	) override;
-
-	void Update() override;
-	void Render() override;
-	void WaitForAsyncTasks() override;
-	void ProcessData() override;
-
-private:
-	const std::string m_appName;
-	std::uint32_t m_width;
-	std::uint32_t m_height;
-	std::uint32_t m_bufferCount;
-	ObjectManager m_objectManager;
-};
-#endif
+#ifndef RENDERER_DX12_HPP_
+#define RENDERER_DX12_HPP_
+#include <Renderer.hpp>
+#include <string>
+#include <vector>
+#include <ObjectManager.hpp>
+#include <FrameTaskGraph.hpp>
+#include <FramePacketQueue.hpp>
+#include <memory>
+#include <thread>
+#include <exception>
+#include <optional>
+
+class D3DCommandList;
+
+class RendererDx12 final : public Renderer {
+public:
+	RendererDx12(
+		const char* appName,
+		void* windowHandle, std::uint32_t width, std::uint32_t height,
+		std::uint32_t bufferCount, RenderEngineType engineType, VertexFormat vertexFormat
+	);
+	~RendererDx12() noexcept override;
+
+	void Resize(std::uint32_t width, std::uint32_t height) override;
+
+	[[nodiscard]]
+	Resolution GetFirstDisplayCoordinates() const override;
+	[[nodiscard]]
+	FrameStatistics GetFrameStatistics() const noexcept override;
+	[[nodiscard]]
+	std::vector<std::string> GetFrameCriticalPath() const override;
+	[[nodiscard]]
+	UploadStatistics GetUploadStatistics() const override;
+	[[nodiscard]]
+	CommandStatistics GetCommandStatistics() const noexcept override;
+	[[nodiscard]]
+	ShaderStatistics GetShaderStatistics() const noexcept override;
+	[[nodiscard]]
+	PipelineStatistics GetPipelineStatistics() const noexcept override;
+	[[nodiscard]]
+	StartupStatistics GetStartupStatistics() const noexcept override;
+	[[nodiscard]]
+	ModelTransformStore& GetModelTransformStore() noexcept override;
+
+	void QueryModelsInBox(
+		const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum,
+		std::vector<std::uint32_t>& modelIds
+	) override;
+	void QueryModelsOnRay(
+		const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		std::vector<std::uint32_t>& modelIds
+	) override;
+
+	void SetThreadPool(std::shared_ptr<IThreadPool> threadPoolArg) noexcept override;
+	void SetBackgroundColour(const std::array<float, 4>& colour) noexcept override;
+	void SetShaderPath(const wchar_t* path) noexcept override;
+	void SetPipelineCachePath(const wchar_t* path) override;
+	void SetSharedDataContainer(
+		std::shared_ptr<ISharedDataContainer> sharedData
+	) noexcept override;
+	void SetRuntimeCapacity(const RuntimeCapacity& capacity) noexcept override;
+	void SetCommandRecording(bool enable) override;
+	void SetRenderThread(bool enable) override;
+	void SetCullingOverlap(bool enable) override;
+	void SetAutoInstancing(bool enable) override;
+
+	[[nodiscard]]
+	size_t AddTexture(
+		std::unique_ptr<std::uint8_t> textureData, size_t width, size_t height
+	) override;
+	void RemoveTexture(size_t textureIndex) override;
+
+	size_t AddModelSet(
+		std::vector<std::shared_ptr<IModel>>&& models, const std::wstring& pixelShader
+	) override;
+	void RemoveModelSet(size_t modelSetId) override;
+	void AddMeshletModelSet(
+		std::vector<MeshletModel>&& meshletModels, const std::wstring& pixelShader
+	) override;
+	[[nodiscard]]
+	ModelInputRange AddModelInputs(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) override;
+	[[nodiscard]]
+	ModelInputRange AddModelInputs(
+		std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	) override;
+	void RemoveModelInputs(size_t inputId) override;
+	void AddModelInputs(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
+		std::vector<std::uint32_t>&& gPrimIndices
+	) override;
+
+	void Update() override;
+	void Render() override;
+	void WaitForAsyncTasks() override;
+	void ProcessData() override;
+
+private:
+	void ReleaseCompletedFrames();
+	void RenderFrame();
+	void RenderThreadLoop();
+	void StopRenderThread() noexcept;
+	// Waits for the queued frames, the render thread's error is rethrown here.
+	void WaitForRenderThread();
+
+	static void AddCommandStatistics(
+		const D3DCommandList& commandList, CommandStatistics& statistics
+	) noexcept;
+
+private:
+	const std::string m_appName;
+	std::uint32_t m_width;
+	std::uint32_t m_height;
+	std::uint32_t m_bufferCount;
+	RuntimeCapacity m_runtimeCapacity;
+	// The model ids of each set, indexed by the set id. Removed sets have none.
+	std::vector<std::optional<std::vector<std::uint32_t>>> m_modelSetIds;
+	bool m_dataProcessed;
+	StartupStatistics m_startupStatistics;
+	FrameTaskGraph m_frameTasks;
+	std::unique_ptr<FramePacketQueue> m_framePackets;
+	std::thread m_renderThread;
+	std::exception_ptr m_renderThreadError;
+	ObjectManager m_objectManager;
+};
+#endif
@@ -1,17 +1,29 @@
-#ifndef ROOT_SIGNATURE_BASE_HPP_
-#define ROOT_SIGNATURE_BASE_HPP_
-#include <D3DHeaders.hpp>
-
-class RootSignatureBase {
-public:
-	void CreateSignature(ID3D12Device* device);
-	[[nodiscard]]
-	ID3D12RootSignature* Get() const noexcept;
-
-protected:
-	ComPtr<ID3DBlob> m_pSignatureBinary;
-
-private:
-	ComPtr<ID3D12RootSignature> m_pRootSignature;
-};
-#endif
+#ifndef ROOT_SIGNATURE_BASE_HPP_
+#define ROOT_SIGNATURE_BASE_HPP_
+#include <D3DHeaders.hpp>
+#include <cstdint>
+
+class RootSignatureBase {
+public:
+	void CreateSignature(ID3D12Device* device);
+	[[nodiscard]]
+	ID3D12RootSignature* Get() const noexcept;
+
+	// The hash of the binary the signature was created from, the pipeline cache keys need its
+	// content, which the signature object doesn't keep.
+	[[nodiscard]]
+	static std::uint64_t GetSignatureHash(ID3D12RootSignature* rootSignature) noexcept;
+
+protected:
+	ComPtr<ID3DBlob> m_pSignatureBinary;
+
+private:
+	// {5C1A8E4B-3F2D-4C7A-9B61-2E8D07A4F3C9}
+	static constexpr GUID s_signatureHashGuid{
+		0x5c1a8e4bu, 0x3f2du, 0x4c7au, { 0x9bu, 0x61u, 0x2eu, 0x8du, 0x07u, 0xa4u, 0xf3u, 0xc9u }
+	};
+
+private:
+	ComPtr<ID3D12RootSignature> m_pRootSignature;
+};
+#endif
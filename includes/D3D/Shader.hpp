@@ -1,20 +1,31 @@
-#ifndef SHADER_HPP_
-#define SHADER_HPP_
-#include <D3DHeaders.hpp>
-#include <string>
-
-class Shader {
-public:
-	void LoadBinary(const std::wstring& fileName);
-	void CompileBinary(
-		const std::wstring& fileName, const char* target,
-		const char* entryPoint = "main"
-	);
-
-	[[nodiscard]]
-	D3D12_SHADER_BYTECODE GetByteCode() const noexcept;
-
-private:
-	ComPtr<ID3DBlob> m_pBinary;
-};
-#endif
+#ifndef SHADER_HPP_
+#define SHADER_HPP_
+#include <D3DHeaders.hpp>
+#include <string>
+
+class Shader {
+public:
+	Shader() noexcept;
+	~Shader() noexcept;
+
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+
+	void LoadBinary(const std::wstring& fileName);
+	// The file stays mapped while the object lives, instead of being copied into a blob.
+	void MapBinary(const std::wstring& fileName);
+	void CompileBinary(
+		const std::wstring& fileName, const char* target,
+		const char* entryPoint = "main"
+	);
+
+	[[nodiscard]]
+	D3D12_SHADER_BYTECODE GetByteCode() const noexcept;
+
+private:
+	ComPtr<ID3DBlob> m_pBinary;
+	HANDLE m_fileMapping;
+	void const* m_mappedView;
+	size_t m_mappedSize;
+};
+#endif
@@ -0,0 +1,55 @@
+#ifndef SHADER_CACHE_HPP_
+#define SHADER_CACHE_HPP_
+#include <Shader.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+
+// Hands out the same mapped binary to every pipeline which loads a shader file, so a shader is
+// only read once no matter how many pipelines use it. Safe to call from multiple threads.
+class ShaderCache {
+public:
+	struct CacheStats {
+		std::uint64_t hits;
+		// Loads of a different or changed file whose content was already mapped.
+		std::uint64_t contentHits;
+		std::uint64_t misses;
+		std::uint64_t bytesMapped;
+	};
+
+	ShaderCache() noexcept;
+
+	// The file is mapped again if its write time or size have changed since the last load.
+	[[nodiscard]]
+	std::shared_ptr<const Shader> LoadBinary(const std::wstring& fileName);
+	// The shaders already handed out stay valid.
+	void Clear() noexcept;
+
+	[[nodiscard]]
+	CacheStats GetCacheStats() const noexcept;
+
+private:
+	struct FileEntry {
+		std::filesystem::file_time_type writeTime;
+		std::uintmax_t fileSize;
+		std::shared_ptr<const Shader> shader;
+	};
+
+	[[nodiscard]]
+	static std::uint64_t HashByteCode(const D3D12_SHADER_BYTECODE& byteCode) noexcept;
+	[[nodiscard]]
+	static bool IsSameByteCode(
+		const D3D12_SHADER_BYTECODE& lhs, const D3D12_SHADER_BYTECODE& rhs
+	) noexcept;
+
+private:
+	std::unordered_map<std::wstring, FileEntry> m_files;
+	// By content hash, so the copies of a binary under different names share a mapping.
+	std::unordered_multimap<std::uint64_t, std::weak_ptr<const Shader>> m_contents;
+	CacheStats m_stats;
+	mutable std::mutex m_cacheMutex;
+};
+#endif
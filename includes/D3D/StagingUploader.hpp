@@ -0,0 +1,38 @@
+#ifndef STAGING_UPLOADER_HPP_
+#define STAGING_UPLOADER_HPP_
+#include <D3DHeaders.hpp>
+#include <vector>
+
+// Uploads into resources which are already in use. The data is copied into the upload ring
+// straight away and the GPU copies are recorded on the next list passed to RecordUploads,
+// which must be one of the current frame.
+class StagingUploader {
+public:
+	void AddBuffer(
+		ID3D12Device* device, void const* source, size_t size, ID3D12Resource* destination,
+		UINT64 destinationOffset
+	);
+	// The source rows are tightly packed RGBA8.
+	void AddTexture(ID3D12Device* device, void const* source, ID3D12Resource* destination);
+
+	void RecordUploads(ID3D12GraphicsCommandList* commandList);
+
+	[[nodiscard]]
+	bool IsEmpty() const noexcept;
+
+private:
+	struct PendingCopy {
+		ID3D12Resource* source;
+		UINT64 sourceOffset;
+		ID3D12Resource* destination;
+		UINT64 destinationOffset;
+		UINT64 size;
+		bool texture;
+	};
+
+private:
+	std::vector<PendingCopy> m_pendingCopies;
+
+	static constexpr size_t BUFFERCOPYALIGNMENT = 16u;
+};
+#endif
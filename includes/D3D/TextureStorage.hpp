@@ -1,33 +1,54 @@
-#ifndef TEXTURE_STORAGE_HPP_
-#define TEXTURE_STORAGE_HPP_
-#include <D3DHeaders.hpp>
-#include <DescriptorTableManager.hpp>
-#include <vector>
-#include <memory>
-#include <D3DDescriptorView.hpp>
-
-class TextureStorage {
-public:
-	TextureStorage() noexcept;
-
-	[[nodiscard]]
-	size_t AddTexture(
-		ID3D12Device* device, std::unique_ptr<std::uint8_t> textureDataHandle, size_t width,
-		size_t height
-	) noexcept;
-
-	void SetGraphicsRootSignatureLayout(std::vector<UINT> rsLayout) noexcept;
-
-	void CreateBufferViews(ID3D12Device* device);
-	void RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept;
-	void ReleaseUploadResource() noexcept;
-
-	void BindTextures(ID3D12GraphicsCommandList* graphicsList) const noexcept;
-
-private:
-	std::vector<std::unique_ptr<D3DUploadResourceDescriptorView>> m_textureDescriptors;
-	D3D12_GPU_DESCRIPTOR_HANDLE m_textureDescriptorStart;
-	std::vector<std::unique_ptr<std::uint8_t>> m_textureHandles;
-	std::vector<UINT> m_graphicsRSLayout;
-};
-#endif
+#ifndef TEXTURE_STORAGE_HPP_
+#define TEXTURE_STORAGE_HPP_
+#include <D3DHeaders.hpp>
+#include <DescriptorTableManager.hpp>
+#include <vector>
+#include <memory>
+#include <D3DDescriptorView.hpp>
+#include <StagingUploader.hpp>
+
+class TextureStorage {
+public:
+	TextureStorage() noexcept;
+
+	// Once the views are created, the texture goes into one of the spare descriptors and
+	// throws if there isn't one left.
+	[[nodiscard]]
+	size_t AddTexture(
+		ID3D12Device* device, std::unique_ptr<std::uint8_t> textureDataHandle, size_t width,
+		size_t height
+	);
+	// The memory of a texture added before the views were created stays reserved, only its
+	// descriptor can be reused.
+	void RemoveTexture(size_t textureIndex);
+	// Must be called before the descriptor table is created.
+	void SetSpareCapacity(size_t textureCount) noexcept;
+
+	void SetGraphicsRootSignatureLayout(std::vector<UINT> rsLayout) noexcept;
+
+	void CreateBufferViews(ID3D12Device* device);
+	void RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept;
+	void ReleaseUploadResource() noexcept;
+	void RecordRuntimeUploads(ID3D12GraphicsCommandList* graphicsList);
+
+	void BindTextures(ID3D12GraphicsCommandList* graphicsList) const noexcept;
+
+private:
+	[[nodiscard]]
+	size_t AddRuntimeTexture(
+		ID3D12Device* device, std::uint8_t const* textureData, size_t width, size_t height
+	);
+
+private:
+	std::vector<std::unique_ptr<D3DUploadResourceDescriptorView>> m_textureDescriptors;
+	D3D12_GPU_DESCRIPTOR_HANDLE m_textureDescriptorStart;
+	std::vector<std::unique_ptr<std::uint8_t>> m_textureHandles;
+	std::vector<UINT> m_graphicsRSLayout;
+	// Indexed by the texture index.
+	std::vector<std::shared_ptr<D3DResourceView>> m_runtimeTextures;
+	std::vector<size_t> m_freeTextureIndices;
+	std::vector<ID3D12Resource*> m_pendingTextures;
+	StagingUploader m_stagingUploader;
+	bool m_viewsCreated;
+};
+#endif
@@ -0,0 +1,43 @@
+#ifndef UPLOAD_RING_HPP_
+#define UPLOAD_RING_HPP_
+#include <D3DHeaders.hpp>
+#include <D3DResource.hpp>
+#include <UploadRingAllocator.hpp>
+
+// A persistently mapped buffer in the upload heap for the uploads after ProcessData. The
+// memory is tagged with the fence value of the current frame, so it must be consumed by the
+// copies recorded in that frame.
+class UploadRing {
+public:
+	struct Allocation {
+		ID3D12Resource* resource;
+		UINT64 offset;
+		std::uint8_t* cpuAddress;
+	};
+
+public:
+	UploadRing() noexcept;
+
+	void SetCapacity(size_t capacity) noexcept;
+	void ReserveHeapSpace(ID3D12Device* device);
+	void CreateResource(ID3D12Device* device);
+
+	// Large allocations and the ones which don't fit in the free part of the ring get a
+	// dedicated chunk, which is released after the frame.
+	[[nodiscard]]
+	Allocation Allocate(ID3D12Device* device, size_t size, size_t alignment);
+	void Reclaim(UINT64 completedFenceValue) noexcept;
+
+	[[nodiscard]]
+	size_t GetUsedSize() const noexcept;
+
+private:
+	[[nodiscard]]
+	Allocation AllocateDedicatedChunk(ID3D12Device* device, size_t size);
+
+private:
+	D3DResourceView m_ringBuffer;
+	UploadRingAllocator m_allocator;
+	bool m_ringCreated;
+};
+#endif
@@ -0,0 +1,44 @@
+#ifndef UPLOAD_RING_ALLOCATOR_HPP_
+#define UPLOAD_RING_ALLOCATOR_HPP_
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+// Hands out offsets from a ring in allocation order. Consecutive allocations with the same
+// fence value form a region, which is reclaimed once the fence has reached that value.
+class UploadRingAllocator {
+public:
+	UploadRingAllocator(size_t capacity = 0u) noexcept;
+
+	// Alignment must be a power of two. Returns nothing if the free part of the ring isn't
+	// large enough. The fence values must not decrease between allocations.
+	[[nodiscard]]
+	std::optional<size_t> Allocate(
+		size_t size, size_t alignment, std::uint64_t fenceValue
+	) noexcept;
+	void Reclaim(std::uint64_t completedFenceValue) noexcept;
+
+	// Drops every allocation.
+	void SetCapacity(size_t capacity) noexcept;
+
+	[[nodiscard]]
+	size_t GetCapacity() const noexcept;
+	[[nodiscard]]
+	size_t GetUsedSize() const noexcept;
+	[[nodiscard]]
+	size_t GetRegionCount() const noexcept;
+
+private:
+	struct Region {
+		std::uint64_t fenceValue;
+		// Includes the padding before the allocations.
+		size_t size;
+	};
+
+private:
+	std::deque<Region> m_regions;
+	size_t m_capacity;
+	size_t m_head;
+	size_t m_usedSize;
+};
+#endif
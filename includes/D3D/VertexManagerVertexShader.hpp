@@ -1,34 +1,83 @@
-#ifndef VERTEX_MANAGER_VERTEX_SHADER_HPP_
-#define VERTEX_MANAGER_VERTEX_SHADER_HPP_
-#include <D3DHeaders.hpp>
-#include <memory>
-#include <cstdint>
-#include <atomic>
-#include <D3DResourceBuffer.hpp>
-#include <IModel.hpp>
-
-class VertexManagerVertexShader {
-public:
-	VertexManagerVertexShader() noexcept;
-
-	void AddGVerticesAndIndices(
-		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-	) noexcept;
-
-	void BindVertexAndIndexBuffer(ID3D12GraphicsCommandList* graphicsCmdList) const noexcept;
-
-	void CreateBuffers(ID3D12Device* device);
-	void ReserveBuffers(ID3D12Device* device);
-	void RecordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept;
-	void ReleaseUploadResources() noexcept;
-
-private:
-	D3DUploadableResourceBuffer m_vertexBuffer;
-	D3D12_VERTEX_BUFFER_VIEW m_gVertexBufferView;
-	D3D12_INDEX_BUFFER_VIEW m_gIndexBufferView;
-	std::vector<Vertex> m_gVertices;
-	std::vector<std::uint32_t> m_gIndices;
-	size_t m_verticesOffset;
-	size_t m_indicesOffset;
-};
-#endif
+#ifndef VERTEX_MANAGER_VERTEX_SHADER_HPP_
+#define VERTEX_MANAGER_VERTEX_SHADER_HPP_
+#include <D3DHeaders.hpp>
+#include <memory>
+#include <cstdint>
+#include <atomic>
+#include <optional>
+#include <D3DResourceBuffer.hpp>
+#include <OffsetAllocator.hpp>
+#include <StagingUploader.hpp>
+#include <IModel.hpp>
+
+// The vertices and the indices each have a region in one buffer, sized for the inputs added
+// before the buffer is created plus the spare capacity. Later inputs go into free space.
+// Only the vertices of its format can be added.
+class VertexManagerVertexShader {
+public:
+	VertexManagerVertexShader(VertexFormat vertexFormat) noexcept;
+
+	[[nodiscard]]
+	ModelInputRange AddGVerticesAndIndices(
+		std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	);
+	[[nodiscard]]
+	ModelInputRange AddGVerticesAndIndices(
+		std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+	);
+	// Throws if the inputs don't exist, were already removed or a model still draws them.
+	void RemoveGVerticesAndIndices(size_t inputId);
+	void SetSpareCapacity(size_t vertexCount, size_t indexCount) noexcept;
+
+	void BindVertexAndIndexBuffer(ID3D12GraphicsCommandList* graphicsCmdList) const noexcept;
+
+	void CreateBuffers(ID3D12Device* device);
+	void ReserveBuffers(ID3D12Device* device);
+	void RecordResourceUploads(ID3D12GraphicsCommandList* copyList) noexcept;
+	void ReleaseUploadResources() noexcept;
+	// Copies the inputs added since the buffer was created.
+	void RecordRuntimeUploads(ID3D12GraphicsCommandList* graphicsCmdList);
+
+private:
+	struct InputAllocation {
+		std::uint32_t vertexHandle;
+		std::uint32_t indexHandle;
+		std::uint32_t indexOffset;
+		std::uint32_t indexCount;
+	};
+
+private:
+	template<typename VertexType>
+	[[nodiscard]]
+	ModelInputRange AddInputs(
+		std::vector<VertexType>& gVertices, std::vector<std::uint32_t>& gIndices,
+		std::vector<VertexType>& gBufferVertices
+	);
+
+	[[nodiscard]]
+	static std::optional<OffsetAllocator::Allocation> AllocateElements(
+		OffsetAllocator& allocator, size_t elementCount, bool bufferCreated
+	) noexcept;
+
+private:
+	D3DUploadableResourceBuffer m_vertexBuffer;
+	D3D12_VERTEX_BUFFER_VIEW m_gVertexBufferView;
+	D3D12_INDEX_BUFFER_VIEW m_gIndexBufferView;
+	std::vector<Vertex> m_gVertices;
+	std::vector<PackedVertex> m_gPackedVertices;
+	std::vector<std::uint32_t> m_gIndices;
+	size_t m_verticesOffset;
+	size_t m_indicesOffset;
+	// In elements, not bytes.
+	OffsetAllocator m_vertexAllocator;
+	OffsetAllocator m_indexAllocator;
+	// Indexed by the input id, an empty optional marks removed inputs.
+	std::vector<std::optional<InputAllocation>> m_inputAllocations;
+	std::vector<size_t> m_freeInputIds;
+	size_t m_spareVertexCount;
+	size_t m_spareIndexCount;
+	VertexFormat m_vertexFormat;
+	bool m_bufferCreated;
+	StagingUploader m_stagingUploader;
+};
+#endif
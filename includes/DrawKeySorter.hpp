@@ -0,0 +1,49 @@
+#ifndef DRAW_KEY_SORTER_HPP_
+#define DRAW_KEY_SORTER_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+
+// The state which costs the most to change is in the highest bits, so the draws in key order
+// change it the least often.
+struct DrawKey {
+	std::uint64_t key;
+	std::uint32_t modelIndex;
+};
+
+class DrawKeySorter {
+public:
+	// The pipeline takes the top 16 bits, the texture the next 24 and the mesh the last 24. The
+	// texture and the mesh only order the draws, so theirs are wrapped.
+	[[nodiscard]]
+	static std::uint64_t MakeKey(
+		std::uint32_t pipelineIndex, std::uint32_t textureIndex, std::uint32_t meshIndex
+	) noexcept;
+	[[nodiscard]]
+	static std::uint32_t GetPipelineIndex(std::uint64_t key) noexcept;
+
+	// A stable LSD radix sort on the key and then the model index, a byte at a time. The bytes
+	// which are the same in every key are skipped and large counts are sorted in parallel.
+	void Sort(std::vector<DrawKey>& drawKeys);
+
+	static constexpr std::uint32_t s_maxPipelineIndex = 0xFFFFu;
+
+private:
+	static constexpr size_t s_radixSize = 256u;
+	// The four bytes of the model index and the eight of the key.
+	static constexpr size_t s_digitCount = 12u;
+	static constexpr size_t s_keysPerJob = 16384u;
+
+	using Histogram = std::array<std::uint32_t, s_radixSize>;
+
+	// The keys of each job change with every pass, so the digit's counts are taken again.
+	void CountDigit(const std::vector<DrawKey>& drawKeys, size_t digitIndex);
+
+private:
+	std::vector<DrawKey> m_sortedKeys;
+	// Per job, the counts of every digit.
+	std::vector<std::array<Histogram, s_digitCount>> m_jobHistograms;
+	std::vector<Histogram> m_jobOffsets;
+};
+#endif
@@ -0,0 +1,29 @@
+#ifndef FRAME_PACKET_HPP_
+#define FRAME_PACKET_HPP_
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include <IModel.hpp>
+#include <ModelTransformStore.hpp>
+
+struct ModelTransformSnapshot {
+	std::uint32_t modelId;
+	DirectX::XMFLOAT4X4 modelMatrix;
+	DirectX::XMFLOAT3 modelOffset;
+	ModelBounds boundingBox;
+};
+
+struct ModelMaterialSnapshot {
+	std::uint32_t modelId;
+	ModelMaterial material;
+};
+
+// What the application thread hands the render thread for a frame. Only the models which
+// changed since the last packet are in it, the store keeps the rest.
+struct FramePacket {
+	DirectX::XMFLOAT4X4 viewMatrix;
+	std::uint32_t fovAngleInDegree;
+	std::vector<ModelTransformSnapshot> transforms;
+	std::vector<ModelMaterialSnapshot> materials;
+};
+#endif
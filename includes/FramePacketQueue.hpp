@@ -0,0 +1,37 @@
+#ifndef FRAME_PACKET_QUEUE_HPP_
+#define FRAME_PACKET_QUEUE_HPP_
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <condition_variable>
+#include <FramePacket.hpp>
+
+// Bounded, so the producer can't get further ahead than the frames which can be in flight.
+class FramePacketQueue {
+public:
+	FramePacketQueue(size_t capacity) noexcept;
+
+	// Blocks while the queue is full. Drops the packet once the queue is closed.
+	void Push(FramePacket&& framePacket);
+	// Blocks while the queue is empty. Empty once the queue is closed and drained. The
+	// previous packet counts as done once this is called again.
+	[[nodiscard]]
+	std::optional<FramePacket> Pop();
+	void Close();
+
+	// Returns once every pushed packet is done or the queue is closed.
+	void WaitUntilDrained();
+
+	[[nodiscard]]
+	bool IsClosed();
+
+private:
+	std::mutex m_packetMutex;
+	std::condition_variable m_packetPushed;
+	std::condition_variable m_packetPopped;
+	std::deque<FramePacket> m_packets;
+	size_t m_capacity;
+	bool m_consumerBusy;
+	bool m_closed;
+};
+#endif
@@ -0,0 +1,114 @@
+#ifndef FRAME_TASK_GRAPH_HPP_
+#define FRAME_TASK_GRAPH_HPP_
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <exception>
+
+// The per frame data a task reads or writes. A task waits for the earlier tasks which write
+// what it uses and for the earlier tasks which read what it writes.
+enum class FrameResource : std::uint32_t {
+	None = 0u,
+	Camera = 1u << 0u,
+	ModelStore = 1u << 1u,
+	ModelBuffers = 1u << 2u,
+	LightBuffers = 1u << 3u,
+	PixelBuffers = 1u << 4u,
+	VisibleModels = 1u << 5u,
+	ComputeCommandList = 1u << 6u,
+	GraphicsCommandList = 1u << 7u
+};
+
+[[nodiscard]]
+constexpr FrameResource operator|(FrameResource left, FrameResource right) noexcept {
+	return static_cast<FrameResource>(
+		static_cast<std::uint32_t>(left) | static_cast<std::uint32_t>(right)
+	);
+}
+
+[[nodiscard]]
+constexpr bool Overlaps(FrameResource left, FrameResource right) noexcept {
+	return (static_cast<std::uint32_t>(left) & static_cast<std::uint32_t>(right)) != 0u;
+}
+
+class FrameTaskGraph {
+public:
+	using TaskFunction = std::function<void(size_t)>;
+
+	struct FrameStats {
+		double frameSeconds;
+		// The longest chain of dependent tasks, the frame can't be shorter than it.
+		double criticalPathSeconds;
+	};
+
+public:
+	FrameTaskGraph() noexcept;
+
+	// The tasks are run in the order they are added in when there is no thread pool, so the
+	// order must be a valid serial one.
+	void AddTask(
+		char const* name, TaskFunction function, FrameResource reads, FrameResource writes
+	);
+	void Clear() noexcept;
+
+	// Returns once every task has finished. The calling thread runs tasks as well. The tasks
+	// which haven't started when one throws are skipped, the exception is rethrown once the
+	// running ones are done.
+	void Execute(size_t frameIndex);
+
+	[[nodiscard]]
+	FrameStats GetFrameStats() const noexcept;
+	// The names of the tasks on the critical path of the last frame, in order.
+	[[nodiscard]]
+	const std::vector<char const*>& GetCriticalPath() const noexcept;
+	[[nodiscard]]
+	size_t GetTaskCount() const noexcept;
+
+private:
+	struct Task {
+		char const* name;
+		TaskFunction function;
+		FrameResource reads;
+		FrameResource writes;
+		std::vector<size_t> successors;
+		size_t predecessorCount;
+		double startSeconds;
+		double endSeconds;
+	};
+
+	// The ready tasks, shared with the pool jobs so a late job never touches a dead graph.
+	struct ReadyQueue {
+		std::mutex mutex;
+		std::deque<size_t> taskIndices;
+	};
+
+private:
+	void ExecuteSerial();
+	void RunTask(size_t taskIndex);
+	void PushReadyTask(size_t taskIndex);
+	[[nodiscard]]
+	static bool PopReadyTask(ReadyQueue& readyQueue, size_t& taskIndex);
+	[[nodiscard]]
+	double GetSecondsSinceStart() const noexcept;
+
+	void CalculateCriticalPath();
+
+private:
+	std::vector<Task> m_tasks;
+	std::unique_ptr<std::atomic_size_t[]> m_predecessorsLeft;
+	std::shared_ptr<ReadyQueue> m_readyQueue;
+	std::atomic_size_t m_tasksLeft;
+	std::atomic_bool m_taskFailed;
+	std::mutex m_exceptionMutex;
+	std::exception_ptr m_exception;
+	std::chrono::steady_clock::time_point m_frameStart;
+	size_t m_frameIndex;
+	FrameStats m_frameStats;
+	std::vector<char const*> m_criticalPath;
+};
+#endif
@@ -0,0 +1,32 @@
+#ifndef FRUSTUM_CULLER_HPP_
+#define FRUSTUM_CULLER_HPP_
+#include <array>
+#include <DirectXMath.h>
+#include <AxisAlignedBox.hpp>
+
+enum class FrustumTest {
+	Outside,
+	Intersecting,
+	Inside
+};
+
+class FrustumCuller {
+public:
+	FrustumCuller() noexcept;
+
+	void SetViewProjection(const DirectX::XMMATRIX& viewProjection) noexcept;
+
+	[[nodiscard]]
+	FrustumTest TestBox(const AxisAlignedBox& box) const noexcept;
+	[[nodiscard]]
+	FrustumTest TestSphere(const DirectX::XMFLOAT3& centre, float radius) const noexcept;
+
+private:
+	// Left, Right, Bottom, Top, Near, Far as a structure of arrays, so four planes are tested
+	// at once. The second group repeats the far plane as padding. Each normal points inside.
+	std::array<DirectX::XMFLOAT4, 2u> m_planesX;
+	std::array<DirectX::XMFLOAT4, 2u> m_planesY;
+	std::array<DirectX::XMFLOAT4, 2u> m_planesZ;
+	std::array<DirectX::XMFLOAT4, 2u> m_planesW;
+};
+#endif
@@ -1,70 +1,84 @@
-#ifndef GAIA_HPP_
-#define GAIA_HPP_
-#include <memory>
-#include <Renderer.hpp>
-#include <DeviceManager.hpp>
-#include <SwapChainManager.hpp>
-#include <D3DCommandQueue.hpp>
-#include <D3DCommandList.hpp>
-#include <D3DDebugLogger.hpp>
-#include <BufferManager.hpp>
-#include <DescriptorTableManager.hpp>
-#include <TextureStorage.hpp>
-#include <IThreadPool.hpp>
-#include <ISharedDataContainer.hpp>
-#include <CameraManager.hpp>
-#include <D3DHeap.hpp>
-#include <D3DResourceBuffer.hpp>
-#include <UploadContainer.hpp>
-#include <D3DFence.hpp>
-#include <RenderEngine.hpp>
-#include <ObjectManager.hpp>
-
-namespace Gaia {
-	// Variables
-	extern std::unique_ptr<DeviceManager> device;
-	extern std::unique_ptr<SwapChainManager> swapChain;
-	extern std::unique_ptr<D3DCommandQueue> graphicsQueue;
-	extern std::unique_ptr<D3DCommandList> graphicsCmdList;
-	extern std::unique_ptr<D3DFence> graphicsFence;
-	extern std::unique_ptr<D3DDebugLogger> debugLogger;
-	extern std::unique_ptr<BufferManager> bufferManager;
-	extern std::unique_ptr<D3DCommandQueue> copyQueue;
-	extern std::unique_ptr<D3DCommandList> copyCmdList;
-	extern std::unique_ptr<DescriptorTableManager> descriptorTable;
-	extern std::unique_ptr<TextureStorage> textureStorage;
-	extern std::shared_ptr<IThreadPool> threadPool;
-	extern std::unique_ptr<CameraManager> cameraManager;
-	extern std::shared_ptr<ISharedDataContainer> sharedData;
-	extern std::unique_ptr<D3DCommandQueue> computeQueue;
-	extern std::unique_ptr<D3DCommandList> computeCmdList;
-	extern std::unique_ptr<D3DFence> computeFence;
-	extern std::unique_ptr<RenderEngine> renderEngine;
-
-	namespace Resources {
-		extern std::unique_ptr<D3DHeap> uploadHeap;
-		extern std::unique_ptr<D3DHeap> cpuWriteHeap;
-		extern std::unique_ptr<D3DHeap> gpuOnlyHeap;
-		extern std::unique_ptr<D3DHeap> cpuReadBackHeap;
-		extern std::unique_ptr<D3DResourceBuffer> cpuWriteBuffer;
-		extern std::unique_ptr<UploadContainer> uploadContainer;
-	}
-
-	// Initialization functions
-	void InitGraphicsQueueAndList(
-		ObjectManager& om, ID3D12Device4* d3dDevice, bool cmdList6,
-		std::uint32_t commandAllocatorCount
-	);
-	void InitCopyQueueAndList(ObjectManager& om, ID3D12Device4* d3dDevice);
-	void InitComputeQueueAndList(
-		ObjectManager& om, ID3D12Device4* d3dDevice, std::uint32_t commandAllocatorCount
-	);
-	void SetThreadPool(std::shared_ptr<IThreadPool>&& threadPoolArg);
-	void SetSharedData(std::shared_ptr<ISharedDataContainer>&& sharedDataArg);
-	void InitResources(ObjectManager& om);
-	void InitRenderEngine(
-		ObjectManager& om, RenderEngineType engineType, ID3D12Device* d3dDevice,
-		std::uint32_t frameCount
-	);
-}
-#endif
+#ifndef GAIA_HPP_
+#define GAIA_HPP_
+#include <memory>
+#include <functional>
+#include <Renderer.hpp>
+#include <DeviceManager.hpp>
+#include <SwapChainManager.hpp>
+#include <D3DCommandQueue.hpp>
+#include <D3DCommandList.hpp>
+#include <D3DCommandListPool.hpp>
+#include <D3DDebugLogger.hpp>
+#include <BufferManager.hpp>
+#include <DescriptorTableManager.hpp>
+#include <TextureStorage.hpp>
+#include <IThreadPool.hpp>
+#include <ISharedDataContainer.hpp>
+#include <CameraManager.hpp>
+#include <D3DHeap.hpp>
+#include <D3DResourceBuffer.hpp>
+#include <UploadContainer.hpp>
+#include <D3DFence.hpp>
+#include <DeferredReleaseQueue.hpp>
+#include <UploadRing.hpp>
+#include <RenderEngine.hpp>
+#include <ShaderCache.hpp>
+#include <PipelineLibrary.hpp>
+#include <ObjectManager.hpp>
+#include <JobRunner.hpp>
+
+namespace Gaia {
+	// Variables
+	extern std::unique_ptr<DeviceManager> device;
+	extern std::unique_ptr<SwapChainManager> swapChain;
+	extern std::unique_ptr<D3DCommandQueue> graphicsQueue;
+	extern std::unique_ptr<D3DCommandList> graphicsCmdList;
+	extern std::unique_ptr<D3DCommandListPool> graphicsCmdListPool;
+	extern std::unique_ptr<D3DFence> graphicsFence;
+	extern std::unique_ptr<D3DDebugLogger> debugLogger;
+	extern std::unique_ptr<BufferManager> bufferManager;
+	extern std::unique_ptr<D3DCommandQueue> copyQueue;
+	extern std::unique_ptr<D3DCommandList> copyCmdList;
+	extern std::unique_ptr<DescriptorTableManager> descriptorTable;
+	extern std::unique_ptr<TextureStorage> textureStorage;
+	extern std::unique_ptr<CameraManager> cameraManager;
+	extern std::shared_ptr<ISharedDataContainer> sharedData;
+	extern std::unique_ptr<D3DCommandQueue> computeQueue;
+	extern std::unique_ptr<D3DCommandList> computeCmdList;
+	extern std::unique_ptr<D3DFence> computeFence;
+	extern std::unique_ptr<RenderEngine> renderEngine;
+	extern std::unique_ptr<DeferredReleaseQueue> releaseQueue;
+	extern std::unique_ptr<ShaderCache> shaderCache;
+	extern std::unique_ptr<PipelineLibrary> pipelineLibrary;
+
+	namespace Resources {
+		extern std::unique_ptr<D3DHeap> uploadHeap;
+		extern std::unique_ptr<UploadRing> uploadRing;
+		extern std::unique_ptr<D3DHeap> cpuWriteHeap;
+		extern std::unique_ptr<D3DHeap> gpuOnlyHeap;
+		extern std::unique_ptr<D3DHeap> cpuReadBackHeap;
+		extern std::unique_ptr<D3DResourceBuffer> cpuWriteBuffer;
+		extern std::unique_ptr<UploadContainer> uploadContainer;
+	}
+
+	// Initialization functions
+	void InitGraphicsQueueAndList(
+		ObjectManager& om, ID3D12Device4* d3dDevice, bool cmdList6,
+		std::uint32_t commandAllocatorCount
+	);
+	void InitCopyQueueAndList(ObjectManager& om, ID3D12Device4* d3dDevice);
+	void InitComputeQueueAndList(
+		ObjectManager& om, ID3D12Device4* d3dDevice, std::uint32_t commandAllocatorCount
+	);
+	void SetThreadPool(std::shared_ptr<IThreadPool>&& threadPoolArg);
+	void SetSharedData(std::shared_ptr<ISharedDataContainer>&& sharedDataArg);
+	void InitResources(ObjectManager& om);
+	void InitRenderEngine(
+		ObjectManager& om, RenderEngineType engineType, ID3D12Device* d3dDevice,
+		std::uint32_t frameCount, VertexFormat vertexFormat
+	);
+
+	// Runs the release after every frame recorded up to now has finished on the GPU.
+	void ReleaseAfterCurrentFrame(std::function<void()> release);
+}
+#endif
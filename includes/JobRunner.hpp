@@ -0,0 +1,20 @@
+#ifndef JOB_RUNNER_HPP_
+#define JOB_RUNNER_HPP_
+#include <memory>
+#include <functional>
+#include <IThreadPool.hpp>
+
+namespace Gaia {
+	extern std::shared_ptr<IThreadPool> threadPool;
+
+	// Runs the jobs on the thread pool if there is one. The calling thread takes jobs as well
+	// and only waits for the ones already started, so it can be called from a pool job. On a
+	// pool the jobs after a throwing one still run, the first exception is rethrown once all
+	// of them are done. Without one the exception leaves straight away.
+	void RunJobs(size_t jobCount, const std::function<void(size_t)>& job);
+	// The same on a pool other than the renderer's, it can be null.
+	void RunJobs(
+		IThreadPool* pool, size_t jobCount, const std::function<void(size_t)>& job
+	);
+}
+#endif
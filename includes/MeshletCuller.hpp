@@ -0,0 +1,36 @@
+#ifndef MESHLET_CULLER_HPP_
+#define MESHLET_CULLER_HPP_
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include <IModel.hpp>
+#include <FrustumCuller.hpp>
+
+// The CPU reference of the meshlet culling an amplification stage does.
+class MeshletCuller {
+public:
+	MeshletCuller() noexcept;
+
+	// The primitive indices are packed 10 bits per corner.
+	[[nodiscard]]
+	static MeshletBounds ComputeBounds(
+		const Meshlet& meshlet, const std::vector<Vertex>& vertices,
+		const std::vector<std::uint32_t>& vertexIndices,
+		const std::vector<std::uint32_t>& primIndices
+	) noexcept;
+
+	// In the model's space, so the view projection has the model matrix in it and the
+	// camera position is moved by its inverse.
+	void SetCamera(
+		const DirectX::XMMATRIX& modelViewProjection, const DirectX::XMFLOAT3& cameraPosition
+	) noexcept;
+
+	// False when the sphere is outside the frustum or no triangle can face the camera.
+	[[nodiscard]]
+	bool IsMeshletVisible(const MeshletBounds& bounds) const noexcept;
+
+private:
+	FrustumCuller m_frustumCuller;
+	DirectX::XMFLOAT3 m_cameraPosition;
+};
+#endif
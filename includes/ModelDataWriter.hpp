@@ -0,0 +1,182 @@
+#ifndef MODEL_DATA_WRITER_HPP_
+#define MODEL_DATA_WRITER_HPP_
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <DirectXMath.h>
+#include <ModelTransformStore.hpp>
+#include <NormalMatrix.hpp>
+
+// Writes the dirty entries of a model store into the mapped model and material buffers of a
+// frame. It doesn't touch the GPU, so it runs on plain host memory as well.
+class ModelDataWriter {
+public:
+	struct ModelBuffer {
+		DirectX::XMMATRIX modelMatrix;
+		DirectX::XMMATRIX viewNormalMatrix;
+		DirectX::XMFLOAT3 modelOffset;
+		ModelBounds boundingBox;
+	};
+
+	struct ModelBufferNoBB {
+		DirectX::XMMATRIX modelMatrix;
+		DirectX::XMMATRIX viewNormalMatrix;
+		DirectX::XMFLOAT3 modelOffset;
+	};
+
+	using MaterialBuffer = ModelMaterial;
+
+	struct UpdateStats {
+		size_t modelsWritten;
+		size_t materialsWritten;
+		size_t bytesWritten;
+	};
+
+	// Called with each chunk before it is written, so the store can be brought up to date on
+	// the same thread.
+	using SyncFunction = std::function<void(size_t, size_t)>;
+
+public:
+	ModelDataWriter(ModelTransformStore& modelStore) noexcept;
+
+	template<bool modelWithNoBB>
+	[[nodiscard]]
+	UpdateStats WriteModels(
+		std::uint8_t* modelBufferStart, std::uint8_t* materialBufferStart, size_t frameIndex,
+		const DirectX::XMMATRIX& viewMatrix, bool viewChanged, const SyncFunction& syncRange
+	) {
+		const auto frameBit = static_cast<std::uint32_t>(1u << frameIndex);
+
+		std::atomic_size_t modelsWritten = 0u;
+		std::atomic_size_t materialsWritten = 0u;
+
+		UpdateModelsInChunks(
+			m_modelStore.GetModelCount(),
+			[&](size_t modelStart, size_t modelEnd) {
+				if (syncRange)
+					syncRange(modelStart, modelEnd);
+
+				modelsWritten += UpdateModelDataRange<modelWithNoBB>(
+					modelBufferStart, viewMatrix, frameBit, viewChanged, modelStart, modelEnd
+				);
+				materialsWritten += UpdateMaterialDataRange(
+					materialBufferStart, frameBit, modelStart, modelEnd
+				);
+			}
+		);
+
+		using ModelBufferType = std::conditional_t<modelWithNoBB, ModelBufferNoBB, ModelBuffer>;
+
+		return UpdateStats{
+			.modelsWritten = modelsWritten,
+			.materialsWritten = materialsWritten,
+			.bytesWritten = modelsWritten * sizeof(ModelBufferType)
+				+ materialsWritten * sizeof(MaterialBuffer)
+		};
+	}
+
+	// Below the threshold or without a thread pool the range is updated on the calling thread,
+	// otherwise it is split into a chunk for each hardware thread.
+	static void UpdateModelsInChunks(
+		size_t modelCount, const std::function<void(size_t, size_t)>& updateRange
+	);
+
+private:
+	[[nodiscard]]
+	size_t UpdateMaterialDataRange(
+		std::uint8_t* materialBufferStart, std::uint32_t frameBit, size_t modelStart,
+		size_t modelEnd
+	) noexcept;
+
+	template<bool modelWithNoBB>
+	[[nodiscard]]
+	size_t UpdateModelDataRange(
+		std::uint8_t* modelBufferStart, const DirectX::XMMATRIX& viewMatrix,
+		std::uint32_t frameBit, bool viewChanged, size_t modelStart, size_t modelEnd
+	) noexcept {
+		using ModelBufferType = std::conditional_t<modelWithNoBB, ModelBufferNoBB, ModelBuffer>;
+
+		const DirectX::XMFLOAT4X4* modelMatrices = m_modelStore.GetModelMatrices();
+		const DirectX::XMFLOAT3* modelOffsets = m_modelStore.GetModelOffsets();
+		const ModelBounds* boundingBoxes = m_modelStore.GetBoundingBoxes();
+		std::uint32_t* dirtyFrames = m_modelStore.GetTransformDirtyFrames();
+
+		std::array<std::uint32_t, s_normalMatrixBatchSize> batchIndices{};
+		std::array<DirectX::XMFLOAT4X4, s_normalMatrixBatchSize> normalMatrices{};
+
+		size_t modelsWritten = 0u;
+
+		for (size_t index = modelStart; index < modelEnd;) {
+			size_t batchCount = 0u;
+
+			for (; index < modelEnd && batchCount < s_normalMatrixBatchSize; ++index)
+				if (viewChanged || (dirtyFrames[index] & frameBit)) {
+					batchIndices[batchCount] = static_cast<std::uint32_t>(index);
+					++batchCount;
+				}
+
+			ComputeNormalMatrices(
+				modelMatrices, std::data(batchIndices), batchCount, viewMatrix,
+				std::data(normalMatrices)
+			);
+
+			for (size_t batchIndex = 0u; batchIndex < batchCount; ++batchIndex) {
+				const size_t modelIndex = batchIndices[batchIndex];
+				const DirectX::XMMATRIX modelMatrix =
+					DirectX::XMLoadFloat4x4(&modelMatrices[modelIndex]);
+				const DirectX::XMMATRIX viewNormalMatrix =
+					DirectX::XMLoadFloat4x4(&normalMatrices[batchIndex]);
+				size_t modelOffset = sizeof(ModelBufferType) * modelIndex;
+
+				if constexpr (modelWithNoBB)
+					CopyStruct(
+						ModelBufferNoBB{
+							.modelMatrix = modelMatrix,
+							.viewNormalMatrix = viewNormalMatrix,
+							.modelOffset = modelOffsets[modelIndex]
+						},
+						modelBufferStart, modelOffset
+					);
+				else
+					CopyStruct(
+						ModelBuffer{
+						.modelMatrix = modelMatrix,
+						.viewNormalMatrix = viewNormalMatrix,
+						.modelOffset = modelOffsets[modelIndex],
+						.boundingBox = boundingBoxes[modelIndex]
+						},
+						modelBufferStart, modelOffset
+					);
+
+				dirtyFrames[modelIndex] &= ~frameBit;
+			}
+
+			modelsWritten += batchCount;
+		}
+
+		return modelsWritten;
+	}
+
+	template<typename T>
+	static void CopyStruct(
+		const T& data, std::uint8_t* offsetInMemory, size_t& currentOffset
+	) noexcept {
+		static constexpr size_t stride = sizeof(T);
+
+		memcpy(offsetInMemory + currentOffset, &data, stride);
+		currentOffset += stride;
+	}
+
+private:
+	ModelTransformStore& m_modelStore;
+
+	// Below this many models the fan out costs more than it saves.
+	static constexpr size_t s_parallelUpdateThreshold = 1024u;
+	// A multiple of 64 models keeps every chunk boundary on a cache line for any stride.
+	static constexpr size_t s_modelChunkGranularity = 64u;
+	static constexpr size_t s_normalMatrixBatchSize = 64u;
+};
+#endif
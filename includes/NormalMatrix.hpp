@@ -0,0 +1,25 @@
+#ifndef NORMAL_MATRIX_HPP_
+#define NORMAL_MATRIX_HPP_
+#include <cstdint>
+#include <DirectXMath.h>
+
+enum class NormalMatrixPath {
+	Reference,
+	Affine,
+	AffineAVX2
+};
+
+// Writes transpose(inverse(model * view)) for modelMatrices[modelIndices[i]] into
+// normalMatrices[i]. Models which aren't affine always take the reference path.
+void ComputeNormalMatrices(
+	const DirectX::XMFLOAT4X4* modelMatrices, const std::uint32_t* modelIndices, size_t count,
+	const DirectX::XMMATRIX& viewMatrix, DirectX::XMFLOAT4X4* normalMatrices
+) noexcept;
+
+// The fastest path supported by the CPU is picked on first use.
+void SetNormalMatrixPath(NormalMatrixPath path) noexcept;
+[[nodiscard]]
+NormalMatrixPath GetNormalMatrixPath() noexcept;
+[[nodiscard]]
+bool IsAVX2Supported() noexcept;
+#endif
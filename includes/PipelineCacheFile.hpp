@@ -0,0 +1,52 @@
+#ifndef PIPELINE_CACHE_FILE_HPP_
+#define PIPELINE_CACHE_FILE_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <filesystem>
+
+// The keys are the hashes of the descriptions of the pipelines in the library, a changed
+// description gets a new key, so its old pipeline is never loaded again.
+struct PipelineCacheData {
+	std::vector<std::uint64_t> pipelineKeys;
+	std::vector<std::uint8_t> library;
+};
+
+// The header holds the format version and the id of the adapter and driver which created the
+// library. The file is ignored if either differs or if the checksum of its content doesn't
+// match. Every value is stored as little endian.
+class PipelineCacheFile {
+public:
+	PipelineCacheFile(std::uint64_t deviceId) noexcept;
+
+	[[nodiscard]]
+	std::vector<std::uint8_t> Serialise(const PipelineCacheData& cacheData) const;
+	// Returns false if the data isn't a cache of this format version and device.
+	[[nodiscard]]
+	bool Deserialise(const std::vector<std::uint8_t>& fileData, PipelineCacheData& cacheData) const;
+
+	// A missing file is the same as a stale one.
+	[[nodiscard]]
+	bool Read(const std::filesystem::path& filePath, PipelineCacheData& cacheData) const;
+	// The data is written to a temporary file which then replaces the old one, so a failed
+	// write doesn't leave a partial cache.
+	[[nodiscard]]
+	bool Write(const std::filesystem::path& filePath, const PipelineCacheData& cacheData) const;
+
+	static constexpr std::uint32_t s_formatVersion = 1u;
+
+private:
+	// "GXPC"
+	static constexpr std::uint32_t s_magic = 0x43505847u;
+	// The magic, the version, the device id, the key count, the library size and the checksum.
+	static constexpr size_t s_headerSize = 40u;
+
+	[[nodiscard]]
+	static std::uint64_t GetChecksum(
+		const std::vector<std::uint8_t>& fileData, size_t contentOffset
+	) noexcept;
+
+private:
+	std::uint64_t m_deviceId;
+};
+#endif
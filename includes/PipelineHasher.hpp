@@ -0,0 +1,29 @@
+#ifndef PIPELINE_HASHER_HPP_
+#define PIPELINE_HASHER_HPP_
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// FNV-1a over the parts of a pipeline description which are added, in the order they are added.
+// The values must not have padding, as its bytes are undefined.
+class PipelineHasher {
+public:
+	PipelineHasher() noexcept;
+
+	PipelineHasher& AddBytes(void const* data, size_t size) noexcept;
+	// The length is added as well, so two strings don't hash the same as their concatenation.
+	PipelineHasher& AddString(const char* string) noexcept;
+
+	template<typename T>
+	requires std::is_trivially_copyable_v<T>
+	PipelineHasher& AddValue(const T& value) noexcept {
+		return AddBytes(&value, sizeof(T));
+	}
+
+	[[nodiscard]]
+	std::uint64_t GetHash() const noexcept;
+
+private:
+	std::uint64_t m_hash;
+};
+#endif
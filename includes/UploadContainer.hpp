@@ -1,32 +1,82 @@
-#ifndef UPLOAD_CONTAINER_HPP_
-#define UPLOAD_CONTAINER_HPP_
-#include <memory>
-#include <vector>
-#include <atomic>
-
-class UploadContainer {
-public:
-	void AddMemory(void const* srcMemoryRef, void* dstMemoryRef, size_t size) noexcept;
-	void AddMemory(
-		void const* srcMemoryRef, void* dstMemoryRef, size_t rowPitch, size_t height
-	) noexcept;
-
-	void CopyData(std::atomic_size_t& workCount) const noexcept;
-
-private:
-	struct MemoryData {
-		size_t rowPitch;
-		size_t height;
-		void const* src;
-		void* dst;
-		bool texture;
-	};
-
-private:
-	void CopyTexture(const MemoryData& memData) const noexcept;
-	void CopyBuffer(const MemoryData& memData) const noexcept;
-
-private:
-	std::vector<MemoryData> m_memoryData;
-};
-#endif
+#ifndef UPLOAD_CONTAINER_HPP_
+#define UPLOAD_CONTAINER_HPP_
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <latch>
+
+class UploadContainer {
+public:
+	struct CopyStats {
+		std::uint64_t bytesCopied;
+		double copySeconds;
+		double gigabytesPerSecond;
+		// Indexed by the batch, each batch runs on its own thread.
+		std::vector<double> batchSeconds;
+	};
+
+public:
+	UploadContainer() noexcept;
+
+	void AddMemory(void const* srcMemoryRef, void* dstMemoryRef, size_t size) noexcept;
+	void AddMemory(
+		void const* srcMemoryRef, void* dstMemoryRef, size_t rowPitch, size_t height
+	) noexcept;
+
+	// Large copies are split into stripes and the stripes into batches of about the same
+	// size, one for each worker. The calling thread copies the first batch itself.
+	void CopyData();
+	// Blocks until every batch is copied, then drops the recorded memory.
+	void WaitForCopies();
+
+	[[nodiscard]]
+	CopyStats GetCopyStats() const;
+
+private:
+	struct MemoryData {
+		size_t rowPitch;
+		size_t height;
+		void const* src;
+		void* dst;
+		bool texture;
+	};
+
+	// Rows for textures and bytes for buffers.
+	struct CopyStripe {
+		size_t memoryIndex;
+		size_t start;
+		size_t count;
+	};
+
+	struct CopyBatch {
+		size_t stripeStart;
+		size_t stripeEnd;
+	};
+
+private:
+	[[nodiscard]]
+	size_t CreateStripes();
+	void CreateBatches(size_t totalSize, size_t batchCount);
+
+	void CopyBatchStripes(size_t batchIndex) noexcept;
+	void CopyTextureRows(
+		const MemoryData& memData, size_t rowStart, size_t rowCount
+	) const noexcept;
+	void CopyBufferBytes(
+		const MemoryData& memData, size_t byteStart, size_t byteCount
+	) const noexcept;
+
+private:
+	std::vector<MemoryData> m_memoryData;
+	std::vector<CopyStripe> m_copyStripes;
+	std::vector<CopyBatch> m_copyBatches;
+	std::unique_ptr<std::latch> m_workerBatchesLeft;
+	std::chrono::steady_clock::time_point m_copyStart;
+	CopyStats m_copyStats;
+
+	static constexpr size_t s_stripeSize = 4u * 1024u * 1024u;
+	// D3D12_TEXTURE_DATA_PITCH_ALIGNMENT, without the D3D headers the copies run headless.
+	static constexpr size_t s_rowPitchAlignment = 256u;
+};
+#endif
@@ -0,0 +1,65 @@
+#include <AxisAlignedBox.hpp>
+
+AxisAlignedBox GetBoxUnion(const AxisAlignedBox& box1, const AxisAlignedBox& box2) noexcept {
+	using namespace DirectX;
+
+	AxisAlignedBox box{};
+	XMStoreFloat3(
+		&box.minimum, XMVectorMin(XMLoadFloat3(&box1.minimum), XMLoadFloat3(&box2.minimum))
+	);
+	XMStoreFloat3(
+		&box.maximum, XMVectorMax(XMLoadFloat3(&box1.maximum), XMLoadFloat3(&box2.maximum))
+	);
+
+	return box;
+}
+
+float GetBoxSurfaceArea(const AxisAlignedBox& box) noexcept {
+	const float width = box.maximum.x - box.minimum.x;
+	const float height = box.maximum.y - box.minimum.y;
+	const float depth = box.maximum.z - box.minimum.z;
+
+	return 2.f * (width * height + height * depth + depth * width);
+}
+
+bool DoBoxesOverlap(const AxisAlignedBox& box1, const AxisAlignedBox& box2) noexcept {
+	return box1.minimum.x <= box2.maximum.x && box1.maximum.x >= box2.minimum.x
+		&& box1.minimum.y <= box2.maximum.y && box1.maximum.y >= box2.minimum.y
+		&& box1.minimum.z <= box2.maximum.z && box1.maximum.z >= box2.minimum.z;
+}
+
+AxisAlignedBox GetWorldBox(
+	const DirectX::XMFLOAT4X4& modelMatrix, const DirectX::XMFLOAT3& modelOffset,
+	const ModelBounds& bounds
+) noexcept {
+	using namespace DirectX;
+
+	const XMMATRIX matrix = XMLoadFloat4x4(&modelMatrix);
+	const XMVECTOR positiveAxes = XMLoadFloat3(&bounds.positiveAxes);
+	const XMVECTOR negativeAxes = XMLoadFloat3(&bounds.negativeAxes);
+
+	const XMVECTOR half = XMVectorReplicate(0.5f);
+	const XMVECTOR maximum = XMVectorMax(positiveAxes, negativeAxes);
+	const XMVECTOR minimum = XMVectorMin(positiveAxes, negativeAxes);
+	const XMVECTOR localCenter = XMVectorMultiply(XMVectorAdd(maximum, minimum), half);
+	const XMVECTOR localExtent = XMVectorMultiply(XMVectorSubtract(maximum, minimum), half);
+
+	const XMVECTOR center = XMVectorAdd(
+		XMVector3Transform(localCenter, matrix), XMLoadFloat3(&modelOffset)
+	);
+
+	// The tightest axis aligned box around the transformed box.
+	const XMVECTOR extent = XMVectorMultiplyAdd(
+		XMVectorAbs(matrix.r[0]), XMVectorSplatX(localExtent),
+		XMVectorMultiplyAdd(
+			XMVectorAbs(matrix.r[1]), XMVectorSplatY(localExtent),
+			XMVectorMultiply(XMVectorAbs(matrix.r[2]), XMVectorSplatZ(localExtent))
+		)
+	);
+
+	AxisAlignedBox box{};
+	XMStoreFloat3(&box.minimum, XMVectorSubtract(center, extent));
+	XMStoreFloat3(&box.maximum, XMVectorAdd(center, extent));
+
+	return box;
+}
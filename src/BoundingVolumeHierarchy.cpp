@@ -0,0 +1,463 @@
+#include <BoundingVolumeHierarchy.hpp>
+#include <algorithm>
+#include <cstring>
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() noexcept
+	: m_rootIndex{ s_nullNode }, m_leafCount{ 0u } {}
+
+bool BoundingVolumeHierarchy::IsLeaf(std::uint32_t nodeIndex) const noexcept {
+	return m_nodes[nodeIndex].left == s_nullNode;
+}
+
+std::uint32_t BoundingVolumeHierarchy::AllocateNode() noexcept {
+	const Node emptyNode{
+		.box = {}, .parent = s_nullNode, .left = s_nullNode, .right = s_nullNode
+	};
+
+	if (!std::empty(m_freeNodes)) {
+		const std::uint32_t nodeIndex = m_freeNodes.back();
+		m_freeNodes.pop_back();
+
+		m_nodes[nodeIndex] = emptyNode;
+
+		return nodeIndex;
+	}
+
+	const auto nodeIndex = static_cast<std::uint32_t>(std::size(m_nodes));
+
+	m_nodes.emplace_back(emptyNode);
+
+	return nodeIndex;
+}
+
+std::uint32_t BoundingVolumeHierarchy::CreateLeaf(
+	std::uint32_t modelId, const AxisAlignedBox& box
+) noexcept {
+	const std::uint32_t leafIndex = AllocateNode();
+
+	m_nodes[leafIndex].box = box;
+	m_nodes[leafIndex].right = modelId;
+
+	m_leafNodes[modelId] = leafIndex;
+	++m_leafCount;
+
+	return leafIndex;
+}
+
+size_t BoundingVolumeHierarchy::GetModelCount() const noexcept {
+	return m_leafCount;
+}
+
+void BoundingVolumeHierarchy::Update(const ModelTransformStore& modelStore) noexcept {
+	const DirectX::XMFLOAT4X4* modelMatrices = modelStore.GetModelMatrices();
+	const DirectX::XMFLOAT3* modelOffsets = modelStore.GetModelOffsets();
+	const ModelBounds* boundingBoxes = modelStore.GetBoundingBoxes();
+	const std::uint32_t* transformVersions = modelStore.GetTransformVersions();
+	const std::uint8_t* activeModels = modelStore.GetActiveModels();
+
+	const size_t oldModelCount = std::size(m_leafNodes);
+	const size_t modelCount = modelStore.GetModelCount();
+
+	auto getWorldBox = [&](size_t modelId) noexcept {
+		return GetWorldBox(modelMatrices[modelId], modelOffsets[modelId], boundingBoxes[modelId]);
+	};
+
+	m_leafNodes.resize(modelCount, s_nullNode);
+	m_leafVersions.resize(modelCount, 0u);
+
+	std::vector<std::uint32_t> movedLeaves;
+	std::vector<std::uint32_t> newLeaves;
+
+	for (size_t modelId = 0u; modelId < oldModelCount; ++modelId) {
+		if (m_leafVersions[modelId] == transformVersions[modelId])
+			continue;
+
+		m_leafVersions[modelId] = transformVersions[modelId];
+
+		const std::uint32_t leafIndex = m_leafNodes[modelId];
+
+		if (!activeModels[modelId]) {
+			if (leafIndex != s_nullNode)
+				RemoveLeaf(leafIndex);
+		}
+		else if (leafIndex == s_nullNode)
+			newLeaves.emplace_back(
+				CreateLeaf(static_cast<std::uint32_t>(modelId), getWorldBox(modelId))
+			);
+		else {
+			m_nodes[leafIndex].box = getWorldBox(modelId);
+
+			movedLeaves.emplace_back(leafIndex);
+		}
+	}
+
+	// Walking up from each leaf stops early, but once most of the leaves have moved one pass
+	// over the whole tree is cheaper.
+	if (std::size(movedLeaves) * 4u > m_leafCount)
+		RefitAll();
+	else
+		for (std::uint32_t leafIndex : movedLeaves)
+			RefitAncestors(m_nodes[leafIndex].parent);
+
+	for (size_t modelId = oldModelCount; modelId < modelCount; ++modelId) {
+		m_leafVersions[modelId] = transformVersions[modelId];
+
+		if (activeModels[modelId])
+			newLeaves.emplace_back(
+				CreateLeaf(static_cast<std::uint32_t>(modelId), getWorldBox(modelId))
+			);
+	}
+
+	if (std::empty(newLeaves))
+		return;
+
+	if (std::size(newLeaves) * 4u > m_leafCount)
+		Rebuild();
+	else
+		for (std::uint32_t leafIndex : newLeaves)
+			InsertLeaf(leafIndex);
+}
+
+void BoundingVolumeHierarchy::Rebuild() noexcept {
+	std::vector<Node> leafNodes;
+	leafNodes.reserve(m_leafCount * 2u);
+
+	for (std::uint32_t& leafIndex : m_leafNodes) {
+		if (leafIndex == s_nullNode)
+			continue;
+
+		Node leaf = m_nodes[leafIndex];
+		leaf.parent = s_nullNode;
+
+		leafIndex = static_cast<std::uint32_t>(std::size(leafNodes));
+		leafNodes.emplace_back(leaf);
+	}
+
+	m_nodes = std::move(leafNodes);
+	m_freeNodes.clear();
+
+	// Leaves were copied in order, so they are the first nodes.
+	std::vector<std::uint32_t> leaves(std::size(m_nodes));
+	for (size_t index = 0u; index < std::size(leaves); ++index)
+		leaves[index] = static_cast<std::uint32_t>(index);
+
+	m_rootIndex =
+		std::empty(leaves) ? s_nullNode : BuildRange(std::data(leaves), std::size(leaves));
+}
+
+// Splits at the median of the centroids along their longest axis.
+std::uint32_t BoundingVolumeHierarchy::BuildRange(
+	std::uint32_t* leaves, size_t leafCount
+) noexcept {
+	if (leafCount == 1u)
+		return leaves[0];
+
+	auto getCentroid = [this](std::uint32_t nodeIndex) noexcept {
+		const AxisAlignedBox& box = m_nodes[nodeIndex].box;
+
+		return DirectX::XMFLOAT3{
+			box.minimum.x + box.maximum.x, box.minimum.y + box.maximum.y,
+			box.minimum.z + box.maximum.z
+		};
+	};
+
+	DirectX::XMFLOAT3 firstCentroid = getCentroid(leaves[0]);
+	AxisAlignedBox centroidBounds{ .minimum = firstCentroid, .maximum = firstCentroid };
+
+	for (size_t index = 1u; index < leafCount; ++index) {
+		const DirectX::XMFLOAT3 centroid = getCentroid(leaves[index]);
+
+		centroidBounds = GetBoxUnion(
+			centroidBounds, AxisAlignedBox{ .minimum = centroid, .maximum = centroid }
+		);
+	}
+
+	const float width = centroidBounds.maximum.x - centroidBounds.minimum.x;
+	const float height = centroidBounds.maximum.y - centroidBounds.minimum.y;
+	const float depth = centroidBounds.maximum.z - centroidBounds.minimum.z;
+
+	const size_t axis = width >= height && width >= depth ? 0u : (height >= depth ? 1u : 2u);
+
+	auto getAxisValue = [axis](const DirectX::XMFLOAT3& point) noexcept {
+		return axis == 0u ? point.x : (axis == 1u ? point.y : point.z);
+	};
+
+	const size_t middle = leafCount / 2u;
+	std::nth_element(
+		leaves, leaves + middle, leaves + leafCount,
+		[&](std::uint32_t leaf1, std::uint32_t leaf2) noexcept {
+			return getAxisValue(getCentroid(leaf1)) < getAxisValue(getCentroid(leaf2));
+		}
+	);
+
+	const std::uint32_t left = BuildRange(leaves, middle);
+	const std::uint32_t right = BuildRange(leaves + middle, leafCount - middle);
+	const std::uint32_t nodeIndex = AllocateNode();
+
+	m_nodes[nodeIndex].box = GetBoxUnion(m_nodes[left].box, m_nodes[right].box);
+	m_nodes[nodeIndex].left = left;
+	m_nodes[nodeIndex].right = right;
+	m_nodes[left].parent = nodeIndex;
+	m_nodes[right].parent = nodeIndex;
+
+	return nodeIndex;
+}
+
+// Picks the sibling with the lowest surface area cost, as described by Catto's dynamic tree.
+void BoundingVolumeHierarchy::InsertLeaf(std::uint32_t leafIndex) noexcept {
+	if (m_rootIndex == s_nullNode) {
+		m_rootIndex = leafIndex;
+		m_nodes[leafIndex].parent = s_nullNode;
+
+		return;
+	}
+
+	const AxisAlignedBox leafBox = m_nodes[leafIndex].box;
+	std::uint32_t siblingIndex = m_rootIndex;
+
+	while (!IsLeaf(siblingIndex)) {
+		const Node& node = m_nodes[siblingIndex];
+
+		const float area = GetBoxSurfaceArea(node.box);
+		const float combinedArea = GetBoxSurfaceArea(GetBoxUnion(node.box, leafBox));
+
+		// The cost of a new parent for this node and the leaf.
+		const float cost = 2.f * combinedArea;
+		// The least cost of pushing the leaf further down.
+		const float inheritanceCost = 2.f * (combinedArea - area);
+
+		auto getChildCost = [&](std::uint32_t childIndex) noexcept {
+			const AxisAlignedBox& childBox = m_nodes[childIndex].box;
+			const float unionArea = GetBoxSurfaceArea(GetBoxUnion(leafBox, childBox));
+
+			if (IsLeaf(childIndex))
+				return unionArea + inheritanceCost;
+
+			return unionArea - GetBoxSurfaceArea(childBox) + inheritanceCost;
+		};
+
+		const float leftCost = getChildCost(node.left);
+		const float rightCost = getChildCost(node.right);
+
+		if (cost < leftCost && cost < rightCost)
+			break;
+
+		siblingIndex = leftCost < rightCost ? node.left : node.right;
+	}
+
+	const std::uint32_t oldParentIndex = m_nodes[siblingIndex].parent;
+	const std::uint32_t newParentIndex = AllocateNode();
+
+	m_nodes[newParentIndex] = Node{
+		.box = GetBoxUnion(leafBox, m_nodes[siblingIndex].box),
+		.parent = oldParentIndex,
+		.left = siblingIndex,
+		.right = leafIndex
+	};
+	m_nodes[siblingIndex].parent = newParentIndex;
+	m_nodes[leafIndex].parent = newParentIndex;
+
+	if (oldParentIndex == s_nullNode)
+		m_rootIndex = newParentIndex;
+	else if (m_nodes[oldParentIndex].left == siblingIndex)
+		m_nodes[oldParentIndex].left = newParentIndex;
+	else
+		m_nodes[oldParentIndex].right = newParentIndex;
+
+	RefitAncestors(oldParentIndex);
+}
+
+void BoundingVolumeHierarchy::RemoveLeaf(std::uint32_t leafIndex) noexcept {
+	const std::uint32_t modelId = m_nodes[leafIndex].right;
+
+	m_leafNodes[modelId] = s_nullNode;
+	--m_leafCount;
+	m_freeNodes.emplace_back(leafIndex);
+
+	if (leafIndex == m_rootIndex) {
+		m_rootIndex = s_nullNode;
+
+		return;
+	}
+
+	// The sibling takes the place of the parent.
+	const std::uint32_t parentIndex = m_nodes[leafIndex].parent;
+	const std::uint32_t grandParentIndex = m_nodes[parentIndex].parent;
+	const std::uint32_t siblingIndex = m_nodes[parentIndex].left == leafIndex ?
+		m_nodes[parentIndex].right : m_nodes[parentIndex].left;
+
+	m_nodes[siblingIndex].parent = grandParentIndex;
+	m_freeNodes.emplace_back(parentIndex);
+
+	if (grandParentIndex == s_nullNode) {
+		m_rootIndex = siblingIndex;
+
+		return;
+	}
+
+	if (m_nodes[grandParentIndex].left == parentIndex)
+		m_nodes[grandParentIndex].left = siblingIndex;
+	else
+		m_nodes[grandParentIndex].right = siblingIndex;
+
+	RefitAncestors(grandParentIndex);
+}
+
+void BoundingVolumeHierarchy::RefitAncestors(std::uint32_t nodeIndex) noexcept {
+	while (nodeIndex != s_nullNode) {
+		Node& node = m_nodes[nodeIndex];
+
+		const AxisAlignedBox box = GetBoxUnion(m_nodes[node.left].box, m_nodes[node.right].box);
+
+		if (std::memcmp(&box, &node.box, sizeof(AxisAlignedBox)) == 0)
+			break;
+
+		node.box = box;
+		nodeIndex = node.parent;
+	}
+}
+
+void BoundingVolumeHierarchy::RefitAll() noexcept {
+	if (m_rootIndex == s_nullNode)
+		return;
+
+	// Children come after their parents in pre-order, so going backwards visits them first.
+	std::vector<std::uint32_t> preOrder;
+	std::vector<std::uint32_t> stack{ m_rootIndex };
+
+	while (!std::empty(stack)) {
+		const std::uint32_t nodeIndex = stack.back();
+		stack.pop_back();
+
+		if (IsLeaf(nodeIndex))
+			continue;
+
+		preOrder.emplace_back(nodeIndex);
+		stack.emplace_back(m_nodes[nodeIndex].left);
+		stack.emplace_back(m_nodes[nodeIndex].right);
+	}
+
+	for (auto nodeIndex = std::rbegin(preOrder); nodeIndex != std::rend(preOrder); ++nodeIndex) {
+		Node& node = m_nodes[*nodeIndex];
+
+		node.box = GetBoxUnion(m_nodes[node.left].box, m_nodes[node.right].box);
+	}
+}
+
+void BoundingVolumeHierarchy::AddSubtreeModels(
+	std::uint32_t nodeIndex, std::vector<std::uint32_t>& modelIds
+) const noexcept {
+	std::vector<std::uint32_t> stack{ nodeIndex };
+
+	while (!std::empty(stack)) {
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.left == s_nullNode)
+			modelIds.emplace_back(node.right);
+		else {
+			stack.emplace_back(node.left);
+			stack.emplace_back(node.right);
+		}
+	}
+}
+
+void BoundingVolumeHierarchy::QueryFrustum(
+	const FrustumCuller& frustum, std::vector<std::uint32_t>& modelIds
+) const noexcept {
+	if (m_rootIndex == s_nullNode)
+		return;
+
+	std::vector<std::uint32_t> stack{ m_rootIndex };
+
+	while (!std::empty(stack)) {
+		const std::uint32_t nodeIndex = stack.back();
+		stack.pop_back();
+
+		const Node& node = m_nodes[nodeIndex];
+		const FrustumTest result = frustum.TestBox(node.box);
+
+		if (result == FrustumTest::Outside)
+			continue;
+
+		if (result == FrustumTest::Inside)
+			AddSubtreeModels(nodeIndex, modelIds);
+		else if (node.left == s_nullNode)
+			modelIds.emplace_back(node.right);
+		else {
+			stack.emplace_back(node.left);
+			stack.emplace_back(node.right);
+		}
+	}
+}
+
+void BoundingVolumeHierarchy::QueryBox(
+	const AxisAlignedBox& box, std::vector<std::uint32_t>& modelIds
+) const noexcept {
+	if (m_rootIndex == s_nullNode)
+		return;
+
+	std::vector<std::uint32_t> stack{ m_rootIndex };
+
+	while (!std::empty(stack)) {
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (!DoBoxesOverlap(node.box, box))
+			continue;
+
+		if (node.left == s_nullNode)
+			modelIds.emplace_back(node.right);
+		else {
+			stack.emplace_back(node.left);
+			stack.emplace_back(node.right);
+		}
+	}
+}
+
+void BoundingVolumeHierarchy::QueryRay(
+	const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+	std::vector<std::uint32_t>& modelIds
+) const noexcept {
+	if (m_rootIndex == s_nullNode)
+		return;
+
+	const float rayOrigin[3]{ origin.x, origin.y, origin.z };
+	const float inverseDirection[3]{ 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+
+	// Slab test, the ray hits the box if its entry and exit distances overlap on every axis.
+	auto hitsBox = [&](const AxisAlignedBox& box) noexcept {
+		const float minimum[3]{ box.minimum.x, box.minimum.y, box.minimum.z };
+		const float maximum[3]{ box.maximum.x, box.maximum.y, box.maximum.z };
+
+		float entry = 0.f;
+		float exit = maxDistance;
+
+		for (size_t axis = 0u; axis < 3u; ++axis) {
+			const float distance1 = (minimum[axis] - rayOrigin[axis]) * inverseDirection[axis];
+			const float distance2 = (maximum[axis] - rayOrigin[axis]) * inverseDirection[axis];
+
+			entry = std::max(entry, std::min(distance1, distance2));
+			exit = std::min(exit, std::max(distance1, distance2));
+		}
+
+		return entry <= exit;
+	};
+
+	std::vector<std::uint32_t> stack{ m_rootIndex };
+
+	while (!std::empty(stack)) {
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (!hitsBox(node.box))
+			continue;
+
+		if (node.left == s_nullNode)
+			modelIds.emplace_back(node.right);
+		else {
+			stack.emplace_back(node.left);
+			stack.emplace_back(node.right);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#include <CullingSchedule.hpp>
+
+CullingSchedule::CullingSchedule(size_t slotCount)
+	: m_cullFenceValues(slotCount, 0u), m_drawFenceValues(slotCount, 0u),
+	m_previousCullSlot{ 0u }, m_hasPreviousCull{ false }, m_overlap{ false } {}
+
+void CullingSchedule::SetOverlap(bool enable) noexcept {
+	m_overlap = enable;
+
+	ResetHistory();
+}
+
+void CullingSchedule::ResetHistory() noexcept {
+	m_hasPreviousCull = false;
+}
+
+CullingSchedule::FrameSync CullingSchedule::ScheduleFrame(
+	size_t slot, std::uint64_t frameFenceValue
+) noexcept {
+	const size_t drawSlot = m_overlap && m_hasPreviousCull ? m_previousCullSlot : slot;
+
+	FrameSync frameSync{
+		.cullSlot = slot,
+		.drawSlot = drawSlot,
+		.cpuWaitOnCompute = m_cullFenceValues[slot],
+		.computeWaitOnGraphics = m_drawFenceValues[slot],
+		.computeSignal = frameFenceValue,
+		.graphicsWaitOnCompute = 0u
+	};
+
+	m_cullFenceValues[slot] = frameFenceValue;
+	m_drawFenceValues[drawSlot] = frameFenceValue;
+
+	frameSync.graphicsWaitOnCompute = m_cullFenceValues[drawSlot];
+
+	m_previousCullSlot = slot;
+	m_hasPreviousCull = true;
+
+	return frameSync;
+}
+
+bool CullingSchedule::IsOverlapEnabled() const noexcept {
+	return m_overlap;
+}
@@ -1,203 +1,389 @@
-#include <BufferManager.hpp>
-#include <ranges>
-#include <algorithm>
-#include <Gaia.hpp>
-
-#include <CameraManager.hpp>
-
-BufferManager::BufferManager(const Args& arguments)
-	: m_cameraBuffer{}, m_pixelDataBuffer{},
-	m_modelBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
-	m_materialBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
-	m_lightBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
-	m_frameCount{ arguments.frameCount.value() },
-	m_modelDataNoBB{ arguments.modelDataNoBB.value() } {}
-
-void BufferManager::ReserveBuffers(ID3D12Device* device) noexcept {
-	// Camera
-	size_t cameraBufferSize = sizeof(DirectX::XMMATRIX) * 2u;
-	constexpr size_t constantBufferAlignment = 256u;
-	size_t cameraOffset =
-		Gaia::Resources::cpuWriteBuffer->ReserveSpaceSuballocatedAndGetOffset(
-			cameraBufferSize, m_frameCount, constantBufferAlignment
-		);
-	m_cameraBuffer.SetAddressesStart(cameraOffset, cameraBufferSize, constantBufferAlignment);
-
-	// Pixel Data
-	constexpr size_t pixelDataBufferSize = sizeof(PixelData);
-	size_t pixelDataOffset =
-		Gaia::Resources::cpuWriteBuffer->ReserveSpaceSuballocatedAndGetOffset(
-			pixelDataBufferSize, m_frameCount, constantBufferAlignment
-		);
-	m_pixelDataBuffer.SetAddressesStart(
-		pixelDataOffset, pixelDataBufferSize, constantBufferAlignment
-	);
-
-	// Model Data
-	const size_t modelBufferDescriptorOffset =
-		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
-	const auto modelCount = static_cast<UINT>(std::size(m_opaqueModels));
-	const UINT64 modelBufferStride = m_modelDataNoBB ?
-		static_cast<UINT64>(sizeof(ModelBufferNoBB)) : static_cast<UINT64>(sizeof(ModelBuffer));
-
-	SetDescBufferInfo(
-		device, modelBufferDescriptorOffset, modelBufferStride, modelCount, m_modelBuffers,
-		m_frameCount
-	);
-
-	// Material Data
-	const size_t materialBufferDescriptorOffset =
-		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
-
-	SetDescBufferInfo(
-		device, materialBufferDescriptorOffset, static_cast<UINT64>(sizeof(MaterialBuffer)),
-		modelCount, m_materialBuffers, m_frameCount
-	);
-
-	// Light Data
-	const size_t lightBufferDescriptorOffset =
-		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
-
-	SetDescBufferInfo(
-		device, lightBufferDescriptorOffset, static_cast<UINT64>(sizeof(LightBuffer)),
-		static_cast<UINT>(std::size(m_lightModelIndices)), m_lightBuffers, m_frameCount
-	);
-}
-
-void BufferManager::CreateBuffers(ID3D12Device* device) {
-	const D3D12_CPU_DESCRIPTOR_HANDLE uploadDescriptorStart =
-		Gaia::descriptorTable->GetUploadDescriptorStart();
-
-	const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorStart =
-		Gaia::descriptorTable->GetGPUDescriptorStart();
-
-	m_modelBuffers.CreateDescriptorView(
-		device, uploadDescriptorStart, gpuDescriptorStart, D3D12_RESOURCE_STATE_GENERIC_READ
-	);
-	m_materialBuffers.CreateDescriptorView(
-		device, uploadDescriptorStart, gpuDescriptorStart, D3D12_RESOURCE_STATE_GENERIC_READ
-	);
-	m_lightBuffers.CreateDescriptorView(
-		device, uploadDescriptorStart, gpuDescriptorStart, D3D12_RESOURCE_STATE_GENERIC_READ
-	);
-
-	SetMemoryAddresses();
-}
-
-void BufferManager::SetMemoryAddresses() noexcept {
-	std::uint8_t* cpuOffset = Gaia::Resources::cpuWriteBuffer->GetCPUStartAddress();
-	D3D12_GPU_VIRTUAL_ADDRESS gpuOffset = Gaia::Resources::cpuWriteBuffer->GetGPUStartAddress();
-
-	m_cameraBuffer.UpdateCPUAddressStart(cpuOffset);
-	m_cameraBuffer.UpdateGPUAddressStart(gpuOffset);
-	m_pixelDataBuffer.UpdateCPUAddressStart(cpuOffset);
-	m_pixelDataBuffer.UpdateGPUAddressStart(gpuOffset);
-}
-
-DirectX::XMMATRIX BufferManager::GetViewMatrix() const noexcept {
-	return Gaia::sharedData->GetViewMatrix();
-}
-
-void BufferManager::BindBuffersToGraphics(
-	ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
-) const noexcept {
-	BindBuffers<
-		&ID3D12GraphicsCommandList::SetGraphicsRootConstantBufferView,
-		&ID3D12GraphicsCommandList::SetGraphicsRootDescriptorTable
-	>(graphicsCmdList, frameIndex, m_graphicsRSLayout);
-}
-
-void BufferManager::BindBuffersToCompute(
-	ID3D12GraphicsCommandList* computeCmdList, size_t frameIndex
-) const noexcept {
-	BindBuffers<
-		&ID3D12GraphicsCommandList::SetComputeRootConstantBufferView,
-		&ID3D12GraphicsCommandList::SetComputeRootDescriptorTable
-	>(computeCmdList, frameIndex, m_computeRSLayout);
-}
-
-void BufferManager::BindPixelOnlyBuffers(
-	ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
-) const noexcept {
-	static constexpr auto materialTypeIndex = static_cast<size_t>(RootSigElement::MaterialData);
-	graphicsCmdList->SetGraphicsRootDescriptorTable(
-		m_graphicsRSLayout[materialTypeIndex],
-		m_materialBuffers.GetGPUDescriptorHandle(frameIndex)
-	);
-
-	static constexpr auto lightTypeIndex = static_cast<size_t>(RootSigElement::LightData);
-	graphicsCmdList->SetGraphicsRootDescriptorTable(
-		m_graphicsRSLayout[lightTypeIndex], m_lightBuffers.GetGPUDescriptorHandle(frameIndex)
-	);
-
-	static constexpr auto pixelDataTypeIndex = static_cast<size_t>(RootSigElement::PixelData);
-	graphicsCmdList->SetGraphicsRootConstantBufferView(
-		m_graphicsRSLayout[pixelDataTypeIndex],
-		m_pixelDataBuffer.GetGPUAddressStart(frameIndex)
-	);
-}
-
-void BufferManager::SetComputeRootSignatureLayout(RSLayoutType rsLayout) noexcept {
-	m_computeRSLayout = std::move(rsLayout);
-}
-
-void BufferManager::SetGraphicsRootSignatureLayout(RSLayoutType rsLayout) noexcept {
-	m_graphicsRSLayout = std::move(rsLayout);
-}
-
-void BufferManager::CheckLightSourceAndAddOpaque(std::shared_ptr<IModel>&& model) noexcept {
-	if (model->IsLightSource())
-		m_lightModelIndices.emplace_back(std::size(m_opaqueModels));
-
-	m_opaqueModels.emplace_back(std::move(model));
-}
-
-void BufferManager::AddOpaqueModels(std::vector<std::shared_ptr<IModel>>&& models) noexcept {
-	for (size_t index = 0u; index < std::size(models); ++index)
-		CheckLightSourceAndAddOpaque(std::move(models[index]));
-}
-
-void BufferManager::AddOpaqueModels(std::vector<MeshletModel>&& meshletModels) noexcept {
-	for (size_t index = 0u; index < std::size(meshletModels); ++index)
-		CheckLightSourceAndAddOpaque(std::move(meshletModels[index].model));
-}
-
-void BufferManager::UpdateCameraData(size_t bufferIndex) const noexcept {
-	std::uint8_t* cameraCpuHandle = m_cameraBuffer.GetCPUAddressStart(bufferIndex);
-
-	Gaia::cameraManager->CopyData(cameraCpuHandle);
-}
-
-void BufferManager::UpdateLightData(
-	size_t bufferIndex, const DirectX::XMMATRIX& viewMatrix
-) const noexcept {
-	size_t offset = 0u;
-	std::uint8_t* lightBufferOffset = m_lightBuffers.GetCPUWPointer(bufferIndex);
-
-	for (auto& lightIndex : m_lightModelIndices) {
-		auto& model = m_opaqueModels[lightIndex];
-		const auto& modelMaterial = model->GetMaterial();
-
-		LightBuffer light{
-			.ambient = modelMaterial.ambient,
-			.diffuse = modelMaterial.diffuse,
-			.specular = modelMaterial.specular
-		};
-
-		DirectX::XMFLOAT3 modelPosition = model->GetModelOffset();
-		DirectX::XMMATRIX viewSpace = model->GetModelMatrix() * viewMatrix;
-		DirectX::XMVECTOR viewPosition = DirectX::XMVector3Transform(
-			DirectX::XMLoadFloat3(&modelPosition), viewMatrix
-		);
-		DirectX::XMStoreFloat3(&light.position, viewPosition);
-
-		CopyStruct(light, lightBufferOffset, offset);
-	}
-}
-
-void BufferManager::UpdatePixelData(size_t bufferIndex) const noexcept {
-	std::uint8_t* pixelDataOffset = m_pixelDataBuffer.GetCPUAddressStart(bufferIndex);
-	const auto lightCount = static_cast<std::uint32_t>(std::size(m_lightModelIndices));
-
-	memcpy(pixelDataOffset, &lightCount, sizeof(PixelData));
-}
+#include <BufferManager.hpp>
+#include <ranges>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <limits>
+#include <Gaia.hpp>
+#include <Exception.hpp>
+
+#include <CameraManager.hpp>
+#include <D3DHelperFunctions.hpp>
+
+BufferManager::BufferManager(const Args& arguments)
+	: m_cameraBuffer{}, m_pixelDataBuffer{},
+	m_modelBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
+	m_materialBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
+	m_lightBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
+	m_modelStore{ arguments.frameCount.value() }, m_modelDataWriter{ m_modelStore },
+	m_frameViewMatrices(arguments.frameCount.value()),
+	m_frameCount{ arguments.frameCount.value() }, m_spareModelCount{ 0u },
+	m_spareLightCount{ 0u }, m_modelCapacity{ std::numeric_limits<size_t>::max() },
+	m_lightCapacity{ std::numeric_limits<size_t>::max() },
+	m_modelDataNoBB{ arguments.modelDataNoBB.value() }, m_externalModelSync{ false },
+	m_updateStats{} {}
+
+void BufferManager::SetSpareCapacity(size_t modelCount, size_t lightCount) noexcept {
+	m_spareModelCount = modelCount;
+	m_spareLightCount = lightCount;
+}
+
+void BufferManager::ReserveBuffers(ID3D12Device* device) noexcept {
+	// Camera
+	size_t cameraBufferSize = sizeof(DirectX::XMMATRIX) * 2u;
+	constexpr size_t constantBufferAlignment = 256u;
+	size_t cameraOffset =
+		Gaia::Resources::cpuWriteBuffer->ReserveSpaceSuballocatedAndGetOffset(
+			cameraBufferSize, m_frameCount, constantBufferAlignment
+		);
+	m_cameraBuffer.SetAddressesStart(cameraOffset, cameraBufferSize, constantBufferAlignment);
+
+	// Pixel Data
+	constexpr size_t pixelDataBufferSize = sizeof(PixelData);
+	size_t pixelDataOffset =
+		Gaia::Resources::cpuWriteBuffer->ReserveSpaceSuballocatedAndGetOffset(
+			pixelDataBufferSize, m_frameCount, constantBufferAlignment
+		);
+	m_pixelDataBuffer.SetAddressesStart(
+		pixelDataOffset, pixelDataBufferSize, constantBufferAlignment
+	);
+
+	m_modelCapacity = std::size(m_opaqueModels) + m_spareModelCount;
+	m_lightCapacity = std::size(m_lightModelIndices) + m_spareLightCount;
+
+	// Model Data
+	const size_t modelBufferDescriptorOffset =
+		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
+	const auto modelCount = static_cast<UINT>(m_modelCapacity);
+	const UINT64 modelBufferStride = m_modelDataNoBB ?
+		static_cast<UINT64>(sizeof(ModelBufferNoBB)) : static_cast<UINT64>(sizeof(ModelBuffer));
+
+	SetDescBufferInfo(
+		device, modelBufferDescriptorOffset, modelBufferStride, modelCount, m_modelBuffers,
+		m_frameCount
+	);
+
+	// Material Data
+	const size_t materialBufferDescriptorOffset =
+		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
+
+	SetDescBufferInfo(
+		device, materialBufferDescriptorOffset, static_cast<UINT64>(sizeof(MaterialBuffer)),
+		modelCount, m_materialBuffers, m_frameCount
+	);
+
+	// Light Data
+	const size_t lightBufferDescriptorOffset =
+		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
+
+	SetDescBufferInfo(
+		device, lightBufferDescriptorOffset, static_cast<UINT64>(sizeof(LightBuffer)),
+		static_cast<UINT>(m_lightCapacity), m_lightBuffers, m_frameCount
+	);
+}
+
+void BufferManager::CreateBuffers(ID3D12Device* device) {
+	const D3D12_CPU_DESCRIPTOR_HANDLE uploadDescriptorStart =
+		Gaia::descriptorTable->GetUploadDescriptorStart();
+
+	const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorStart =
+		Gaia::descriptorTable->GetGPUDescriptorStart();
+
+	m_modelBuffers.CreateDescriptorView(
+		device, uploadDescriptorStart, gpuDescriptorStart, D3D12_RESOURCE_STATE_GENERIC_READ
+	);
+	m_materialBuffers.CreateDescriptorView(
+		device, uploadDescriptorStart, gpuDescriptorStart, D3D12_RESOURCE_STATE_GENERIC_READ
+	);
+	m_lightBuffers.CreateDescriptorView(
+		device, uploadDescriptorStart, gpuDescriptorStart, D3D12_RESOURCE_STATE_GENERIC_READ
+	);
+
+	SetMemoryAddresses();
+}
+
+void BufferManager::SetMemoryAddresses() noexcept {
+	std::uint8_t* cpuOffset = Gaia::Resources::cpuWriteBuffer->GetCPUStartAddress();
+	D3D12_GPU_VIRTUAL_ADDRESS gpuOffset = Gaia::Resources::cpuWriteBuffer->GetGPUStartAddress();
+
+	m_cameraBuffer.UpdateCPUAddressStart(cpuOffset);
+	m_cameraBuffer.UpdateGPUAddressStart(gpuOffset);
+	m_pixelDataBuffer.UpdateCPUAddressStart(cpuOffset);
+	m_pixelDataBuffer.UpdateGPUAddressStart(gpuOffset);
+}
+
+DirectX::XMMATRIX BufferManager::GetViewMatrix() const noexcept {
+	return Gaia::cameraManager->GetViewMatrix();
+}
+
+void BufferManager::BindBuffersToGraphics(
+	ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
+) const noexcept {
+	BindBuffers<
+		&ID3D12GraphicsCommandList::SetGraphicsRootConstantBufferView,
+		&ID3D12GraphicsCommandList::SetGraphicsRootDescriptorTable
+	>(graphicsCmdList, frameIndex, m_graphicsRSLayout);
+}
+
+void BufferManager::BindBuffersToCompute(
+	ID3D12GraphicsCommandList* computeCmdList, size_t frameIndex
+) const noexcept {
+	BindBuffers<
+		&ID3D12GraphicsCommandList::SetComputeRootConstantBufferView,
+		&ID3D12GraphicsCommandList::SetComputeRootDescriptorTable
+	>(computeCmdList, frameIndex, m_computeRSLayout);
+}
+
+void BufferManager::BindPixelOnlyBuffers(
+	ID3D12GraphicsCommandList* graphicsCmdList, size_t frameIndex
+) const noexcept {
+	static constexpr auto materialTypeIndex = static_cast<size_t>(RootSigElement::MaterialData);
+	graphicsCmdList->SetGraphicsRootDescriptorTable(
+		m_graphicsRSLayout[materialTypeIndex],
+		m_materialBuffers.GetGPUDescriptorHandle(frameIndex)
+	);
+
+	static constexpr auto lightTypeIndex = static_cast<size_t>(RootSigElement::LightData);
+	graphicsCmdList->SetGraphicsRootDescriptorTable(
+		m_graphicsRSLayout[lightTypeIndex], m_lightBuffers.GetGPUDescriptorHandle(frameIndex)
+	);
+
+	static constexpr auto pixelDataTypeIndex = static_cast<size_t>(RootSigElement::PixelData);
+	graphicsCmdList->SetGraphicsRootConstantBufferView(
+		m_graphicsRSLayout[pixelDataTypeIndex],
+		m_pixelDataBuffer.GetGPUAddressStart(frameIndex)
+	);
+}
+
+void BufferManager::SetComputeRootSignatureLayout(RSLayoutType rsLayout) noexcept {
+	m_computeRSLayout = std::move(rsLayout);
+}
+
+void BufferManager::SetGraphicsRootSignatureLayout(RSLayoutType rsLayout) noexcept {
+	m_graphicsRSLayout = std::move(rsLayout);
+}
+
+std::uint32_t BufferManager::CheckLightSourceAndAddOpaque(std::shared_ptr<IModel> model) {
+	const bool lightSource = model->IsLightSource();
+
+	if (lightSource && std::size(m_lightModelIndices) >= m_lightCapacity)
+		throw Exception("BufferManager Error", "The light capacity is exceeded.");
+
+	size_t modelId = std::size(m_opaqueModels);
+
+	if (!std::empty(m_freeModelIds)) {
+		// The data of every frame in flight is in its own buffer, so a slot can be reused
+		// straight away.
+		modelId = m_freeModelIds.back();
+		m_freeModelIds.pop_back();
+
+		m_opaqueModels[modelId] = std::move(model);
+		m_modelAdapterStates[modelId] = ModelAdapterState{
+			.modelVersion = 0u, .materialVersion = 0u
+		};
+		m_modelStore.SetModelActive(modelId, true);
+	}
+	else {
+		if (modelId >= m_modelCapacity)
+			throw Exception("BufferManager Error", "The model capacity is exceeded.");
+
+		m_opaqueModels.emplace_back(std::move(model));
+		m_modelAdapterStates.emplace_back(
+			ModelAdapterState{ .modelVersion = 0u, .materialVersion = 0u }
+		);
+		m_modelStore.AddModel();
+	}
+
+	if (lightSource)
+		m_lightModelIndices.emplace_back(modelId);
+
+	return static_cast<std::uint32_t>(modelId);
+}
+
+std::vector<std::uint32_t> BufferManager::AddOpaqueModels(
+	const std::vector<std::shared_ptr<IModel>>& models
+) {
+	std::vector<std::uint32_t> modelIds;
+	modelIds.reserve(std::size(models));
+
+	for (const auto& model : models)
+		modelIds.emplace_back(CheckLightSourceAndAddOpaque(model));
+
+	return modelIds;
+}
+
+void BufferManager::AddOpaqueModels(std::vector<MeshletModel>&& meshletModels) {
+	for (size_t index = 0u; index < std::size(meshletModels); ++index)
+		CheckLightSourceAndAddOpaque(std::move(meshletModels[index].model));
+}
+
+void BufferManager::RemoveOpaqueModels(const std::vector<std::uint32_t>& modelIds) noexcept {
+	for (std::uint32_t modelId : modelIds) {
+		m_opaqueModels[modelId].reset();
+		m_modelStore.SetModelActive(modelId, false);
+
+		std::erase(m_lightModelIndices, static_cast<size_t>(modelId));
+
+		m_freeModelIds.emplace_back(modelId);
+	}
+}
+
+bool BufferManager::IsIndexRangeUsed(
+	std::uint32_t indexOffset, std::uint32_t indexCount
+) const noexcept {
+	const std::uint64_t indexEnd = std::uint64_t{ indexOffset } + indexCount;
+
+	return std::ranges::any_of(m_opaqueModels, [indexOffset, indexEnd](const auto& model) {
+		if (!model || model->GetIndexCount() == 0u)
+			return false;
+
+		const std::uint32_t modelIndexOffset = model->GetIndexOffset();
+
+		return modelIndexOffset < indexEnd
+			&& std::uint64_t{ modelIndexOffset } + model->GetIndexCount() > indexOffset;
+	});
+}
+
+void BufferManager::UpdateCameraData(size_t frameIndex) const noexcept {
+	std::uint8_t* cameraCpuHandle = m_cameraBuffer.GetCPUAddressStart(frameIndex);
+
+	Gaia::cameraManager->CopyData(cameraCpuHandle);
+}
+
+bool BufferManager::CheckAndStoreViewMatrix(
+	size_t bufferIndex, const DirectX::XMMATRIX& viewMatrix
+) noexcept {
+	DirectX::XMFLOAT4X4 currentView{};
+	DirectX::XMStoreFloat4x4(&currentView, viewMatrix);
+
+	DirectX::XMFLOAT4X4& frameView = m_frameViewMatrices[bufferIndex];
+	const bool viewChanged = memcmp(&frameView, &currentView, sizeof(DirectX::XMFLOAT4X4)) != 0;
+
+	if (viewChanged)
+		frameView = currentView;
+
+	return viewChanged;
+}
+
+BufferManager::UpdateStats BufferManager::GetUpdateStats() const noexcept {
+	return m_updateStats;
+}
+
+ModelTransformStore& BufferManager::GetModelStore() noexcept {
+	return m_modelStore;
+}
+
+const BoundingVolumeHierarchy& BufferManager::GetBoundingVolumeHierarchy() noexcept {
+	m_boundingVolumeHierarchy.Update(m_modelStore);
+
+	return m_boundingVolumeHierarchy;
+}
+
+ModelMaterial BufferManager::GetModelMaterial(const IModel& model) noexcept {
+	const auto& modelMaterial = model.GetMaterial();
+
+	return ModelMaterial{
+		.ambient = modelMaterial.ambient,
+		.diffuse = modelMaterial.diffuse,
+		.specular = modelMaterial.specular,
+		.diffuseTexUVInfo = model.GetDiffuseTexUVInfo(),
+		.specularTexUVInfo = model.GetSpecularTexUVInfo(),
+		.diffuseTexIndex = model.GetDiffuseTexIndex(),
+		.specularTexIndex = model.GetSpecularTexIndex(),
+		.shininess = modelMaterial.shininess
+	};
+}
+
+void BufferManager::SyncModelStoreRange(size_t modelStart, size_t modelEnd) noexcept {
+	VisitChangedModels(
+		modelStart, modelEnd,
+		[this](size_t modelId, const IModel& model) {
+			m_modelStore.SetModelMatrix(modelId, model.GetModelMatrix());
+			m_modelStore.SetModelOffset(modelId, model.GetModelOffset());
+			m_modelStore.SetBoundingBox(modelId, model.GetBoundingBox());
+		},
+		[this](size_t modelId, const IModel& model) {
+			m_modelStore.SetMaterial(modelId, GetModelMaterial(model));
+		}
+	);
+}
+
+void BufferManager::SetExternalModelSync(bool enable) noexcept {
+	m_externalModelSync = enable;
+}
+
+void BufferManager::CaptureModelChanges(FramePacket& framePacket) {
+	VisitChangedModels(
+		0u, std::size(m_opaqueModels),
+		[&framePacket](size_t modelId, const IModel& model) {
+			ModelTransformSnapshot& transform = framePacket.transforms.emplace_back(
+				ModelTransformSnapshot{
+					.modelId = static_cast<std::uint32_t>(modelId),
+					.modelMatrix = {},
+					.modelOffset = model.GetModelOffset(),
+					.boundingBox = model.GetBoundingBox()
+				}
+			);
+
+			DirectX::XMStoreFloat4x4(&transform.modelMatrix, model.GetModelMatrix());
+		},
+		[&framePacket](size_t modelId, const IModel& model) {
+			framePacket.materials.emplace_back(
+				ModelMaterialSnapshot{
+					.modelId = static_cast<std::uint32_t>(modelId),
+					.material = GetModelMaterial(model)
+				}
+			);
+		}
+	);
+}
+
+void BufferManager::ApplyFramePacket(const FramePacket& framePacket) noexcept {
+	for (const ModelTransformSnapshot& transform : framePacket.transforms) {
+		m_modelStore.SetModelMatrix(
+			transform.modelId, DirectX::XMLoadFloat4x4(&transform.modelMatrix)
+		);
+		m_modelStore.SetModelOffset(transform.modelId, transform.modelOffset);
+		m_modelStore.SetBoundingBox(transform.modelId, transform.boundingBox);
+	}
+
+	for (const ModelMaterialSnapshot& material : framePacket.materials)
+		m_modelStore.SetMaterial(material.modelId, material.material);
+}
+
+void BufferManager::UpdateLightData(size_t frameIndex) const noexcept {
+	size_t offset = 0u;
+	std::uint8_t* lightBufferOffset = m_lightBuffers.GetCPUWPointer(frameIndex);
+
+	// The view the model data of this frame was written with.
+	const DirectX::XMMATRIX viewMatrix =
+		DirectX::XMLoadFloat4x4(&m_frameViewMatrices[frameIndex]);
+
+	const DirectX::XMFLOAT3* modelOffsets = m_modelStore.GetModelOffsets();
+	const ModelMaterial* materials = m_modelStore.GetMaterials();
+
+	for (auto& lightIndex : m_lightModelIndices) {
+		const ModelMaterial& modelMaterial = materials[lightIndex];
+
+		LightBuffer light{
+			.ambient = modelMaterial.ambient,
+			.diffuse = modelMaterial.diffuse,
+			.specular = modelMaterial.specular
+		};
+
+		DirectX::XMVECTOR viewPosition = DirectX::XMVector3Transform(
+			DirectX::XMLoadFloat3(&modelOffsets[lightIndex]), viewMatrix
+		);
+		DirectX::XMStoreFloat3(&light.position, viewPosition);
+
+		CopyStruct(light, lightBufferOffset, offset);
+	}
+}
+
+void BufferManager::UpdatePixelData(size_t frameIndex) const noexcept {
+	std::uint8_t* pixelDataOffset = m_pixelDataBuffer.GetCPUAddressStart(frameIndex);
+	const auto lightCount = static_cast<std::uint32_t>(std::size(m_lightModelIndices));
+
+	memcpy(pixelDataOffset, &lightCount, sizeof(PixelData));
+}
@@ -1,46 +1,69 @@
-#include <D3DCommandList.hpp>
-#include <Exception.hpp>
-
-D3DCommandList::D3DCommandList(const Args& arguments)
-	: m_pCommandAllocators{ arguments.allocatorCount.value()} {
-
-	ID3D12Device4* device = arguments.device.value();
-	D3D12_COMMAND_LIST_TYPE type = arguments.type.value();
-
-	for (auto& commandAllocator : m_pCommandAllocators)
-		device->CreateCommandAllocator(type, IID_PPV_ARGS(&commandAllocator));
-
-	device->CreateCommandList1(
-		0u, type, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&m_pCommandList)
-	);
-
-	if (arguments.cmdList6.value()) {
-		HRESULT hr = m_pCommandList.As(&m_pCommandList6);
-
-		if (hr == E_NOINTERFACE)
-			throw Exception("Interface Query Error", "CommandList6 is not supported.");
-	}
-}
-
-void D3DCommandList::Reset(size_t allocatorIndex) {
-	ComPtr<ID3D12CommandAllocator>& currentAllocator = m_pCommandAllocators[allocatorIndex];
-
-	currentAllocator->Reset();
-	m_pCommandList->Reset(currentAllocator.Get(), nullptr);
-}
-
-void D3DCommandList::ResetFirst() {
-	Reset(0u);
-}
-
-void D3DCommandList::Close() const {
-	m_pCommandList->Close();
-}
-
-ID3D12GraphicsCommandList* D3DCommandList::GetCommandList() const noexcept {
-	return m_pCommandList.Get();
-}
-
-ID3D12GraphicsCommandList6* D3DCommandList::GetCommandList6() const noexcept {
-	return m_pCommandList6.Get();
-}
+#include <D3DCommandList.hpp>
+#include <Exception.hpp>
+
+D3DCommandList::D3DCommandList(const Args& arguments)
+	: m_pCommandAllocators{ arguments.allocatorCount.value()}, m_type{ arguments.type.value() } {
+
+	ID3D12Device4* device = arguments.device.value();
+	D3D12_COMMAND_LIST_TYPE type = arguments.type.value();
+
+	for (auto& commandAllocator : m_pCommandAllocators)
+		device->CreateCommandAllocator(type, IID_PPV_ARGS(&commandAllocator));
+
+	device->CreateCommandList1(
+		0u, type, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&m_pCommandList)
+	);
+
+	if (arguments.cmdList6.value()) {
+		HRESULT hr = m_pCommandList.As(&m_pCommandList6);
+
+		if (hr == E_NOINTERFACE)
+			throw Exception("Interface Query Error", "CommandList6 is not supported.");
+	}
+}
+
+void D3DCommandList::Reset(size_t allocatorIndex) {
+	ComPtr<ID3D12CommandAllocator>& currentAllocator = m_pCommandAllocators[allocatorIndex];
+
+	currentAllocator->Reset();
+	GetCommandList()->Reset(currentAllocator.Get(), nullptr);
+}
+
+void D3DCommandList::ResetFirst() {
+	Reset(0u);
+}
+
+void D3DCommandList::Close() const {
+	GetCommandList()->Close();
+}
+
+void D3DCommandList::SetRecording(bool enable) {
+	if (!enable)
+		m_pRecordingList.Reset();
+	else if (!m_pRecordingList)
+		m_pRecordingList.Attach(
+			new RecordingCommandList{ m_pCommandList.Get(), m_pCommandList6.Get(), m_type }
+		);
+}
+
+ID3D12GraphicsCommandList* D3DCommandList::GetCommandList() const noexcept {
+	if (m_pRecordingList)
+		return m_pRecordingList.Get();
+
+	return m_pCommandList.Get();
+}
+
+ID3D12GraphicsCommandList6* D3DCommandList::GetCommandList6() const noexcept {
+	if (m_pRecordingList && m_pCommandList6)
+		return m_pRecordingList.Get();
+
+	return m_pCommandList6.Get();
+}
+
+ID3D12GraphicsCommandList* D3DCommandList::GetExecutableCommandList() const noexcept {
+	return m_pCommandList.Get();
+}
+
+RecordingCommandList const* D3DCommandList::GetRecordingList() const noexcept {
+	return m_pRecordingList.Get();
+}
@@ -0,0 +1,75 @@
+#include <D3DCommandListPool.hpp>
+
+D3DCommandListPool::D3DCommandListPool(const Args& arguments)
+	: m_device{ arguments.device.value() }, m_type{ arguments.type.value() },
+	m_cmdList6{ arguments.cmdList6.value() }, m_recording{ false }, m_listCount{ 0u } {}
+
+D3DCommandList* D3DCommandListPool::AcquireCommandList() {
+	std::unique_ptr<D3DCommandList> commandList;
+
+	{
+		std::lock_guard lock{ m_listMutex };
+
+		if (!std::empty(m_freeLists)) {
+			commandList = std::move(m_freeLists.back());
+			m_freeLists.pop_back();
+		}
+	}
+
+	// Creating a list is slow, so it is done outside of the lock.
+	if (!commandList) {
+		commandList = std::make_unique<D3DCommandList>(
+			D3DCommandList::Args{
+				.device = m_device,
+				.type = m_type,
+				.cmdList6 = m_cmdList6
+			}
+		);
+
+		std::lock_guard lock{ m_listMutex };
+		++m_listCount;
+	}
+
+	commandList->SetRecording(m_recording);
+	commandList->ResetFirst();
+
+	D3DCommandList* commandListRef = commandList.get();
+
+	std::lock_guard lock{ m_listMutex };
+	m_acquiredLists.emplace_back(std::move(commandList));
+
+	return commandListRef;
+}
+
+void D3DCommandListPool::RetireCommandLists(UINT64 fenceValue) {
+	m_frameLists.clear();
+
+	for (std::unique_ptr<D3DCommandList>& commandList : m_acquiredLists) {
+		m_frameLists.emplace_back(commandList.get());
+		m_listsInFlight.emplace_back(
+			ListInFlight{ .commandList = std::move(commandList), .fenceValue = fenceValue }
+		);
+	}
+
+	m_acquiredLists.clear();
+}
+
+void D3DCommandListPool::Reclaim(UINT64 completedFenceValue) {
+	while (!std::empty(m_listsInFlight)
+		&& m_listsInFlight.front().fenceValue <= completedFenceValue) {
+		m_freeLists.emplace_back(std::move(m_listsInFlight.front().commandList));
+		m_listsInFlight.pop_front();
+	}
+}
+
+void D3DCommandListPool::SetRecording(bool enable) noexcept {
+	m_recording = enable;
+}
+
+const std::vector<D3DCommandList*>& D3DCommandListPool::GetFrameCommandLists() const noexcept {
+	return m_frameLists;
+}
+
+size_t D3DCommandListPool::GetCommandListCount() const noexcept {
+	return m_listCount;
+}
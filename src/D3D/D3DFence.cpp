@@ -1,64 +1,88 @@
-#include <D3DFence.hpp>
-#include <Exception.hpp>
-
-D3DFence::D3DFence(const Args& arguments)
-	: m_fenceValues(std::deque<UINT64>{arguments.fenceValueCount.value(), 0u}),
-	m_fenceCPUEvent{ nullptr } {
-
-	arguments.device.value()->CreateFence(
-		GetFrontValue(), D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)
-	);
-	IncreaseFrontValue(0u);
-
-	m_fenceCPUEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-
-	if (!m_fenceCPUEvent)
-		throw Exception(
-			"System Error", "Fence event creation failed."
-		);
-}
-
-void D3DFence::IncreaseFrontValue(UINT64 oldValue) noexcept {
-	m_fenceValues.front() = oldValue + 1u;
-}
-
-void D3DFence::AdvanceValueInQueue() noexcept {
-	UINT64 currentValue = GetFrontValue();
-	m_fenceValues.pop();
-	m_fenceValues.push(currentValue);
-}
-
-void D3DFence::WaitOnCPUConditional() {
-	UINT64 currentValue = GetFrontValue();
-	if (m_fence->GetCompletedValue() < currentValue)
-		WaitOnCPU(currentValue);
-}
-
-void D3DFence::SignalFence(UINT64 fenceValue) const {
-	m_fence->Signal(fenceValue);
-}
-
-void D3DFence::WaitOnCPU() {
-	WaitOnCPU(GetFrontValue());
-}
-
-void D3DFence::WaitOnCPU(UINT64 fenceValue) {
-	m_fence->SetEventOnCompletion(fenceValue, m_fenceCPUEvent);
-	WaitForSingleObjectEx(m_fenceCPUEvent, INFINITE, FALSE);
-}
-
-void D3DFence::ResetFenceValues(UINT64 value) noexcept {
-	const size_t fenceCount = std::size(m_fenceValues);
-	for (size_t _ = 0u; _ < fenceCount; ++_) {
-		m_fenceValues.pop();
-		m_fenceValues.push(value);
-	}
-}
-
-UINT64 D3DFence::GetFrontValue() const noexcept {
-	return m_fenceValues.front();
-}
-
-ID3D12Fence* D3DFence::GetFence() const noexcept {
-	return m_fence.Get();
-}
+#include <D3DFence.hpp>
+#include <Exception.hpp>
+
+D3DFence::D3DFence(const Args& arguments)
+	: m_fenceValues(std::deque<UINT64>{arguments.fenceValueCount.value(), 0u}),
+	m_fenceCPUEvent{ nullptr }, m_lastSignalledValue{ 0u } {
+
+	arguments.device.value()->CreateFence(
+		GetFrontValue(), D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)
+	);
+	IncreaseFrontValue(0u);
+
+	m_fenceCPUEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+	if (!m_fenceCPUEvent)
+		throw Exception(
+			"System Error", "Fence event creation failed."
+		);
+}
+
+void D3DFence::IncreaseFrontValue(UINT64 oldValue) noexcept {
+	m_fenceValues.front() = oldValue + 1u;
+}
+
+void D3DFence::AdvanceValueInQueue() noexcept {
+	UINT64 currentValue = GetFrontValue();
+	m_fenceValues.pop();
+	m_fenceValues.push(currentValue);
+}
+
+void D3DFence::WaitOnCPUConditional() {
+	UINT64 currentValue = GetFrontValue();
+	if (m_fence->GetCompletedValue() < currentValue)
+		WaitOnCPU(currentValue);
+}
+
+void D3DFence::SignalFence(UINT64 fenceValue) const {
+	m_fence->Signal(fenceValue);
+}
+
+void D3DFence::SignalOnQueue(ID3D12CommandQueue* queue, UINT64 fenceValue) {
+	queue->Signal(m_fence.Get(), fenceValue);
+
+	m_lastSignalledValue = fenceValue;
+}
+
+void D3DFence::WaitOnQueue(ID3D12CommandQueue* queue, UINT64 fenceValue) const {
+	if (fenceValue != 0u && m_fence->GetCompletedValue() < fenceValue)
+		queue->Wait(m_fence.Get(), fenceValue);
+}
+
+void D3DFence::WaitOnCPUConditional(UINT64 fenceValue) {
+	if (fenceValue != 0u && m_fence->GetCompletedValue() < fenceValue)
+		WaitOnCPU(fenceValue);
+}
+
+void D3DFence::WaitOnCPU() {
+	WaitOnCPU(GetFrontValue());
+}
+
+void D3DFence::WaitOnCPU(UINT64 fenceValue) {
+	m_fence->SetEventOnCompletion(fenceValue, m_fenceCPUEvent);
+	WaitForSingleObjectEx(m_fenceCPUEvent, INFINITE, FALSE);
+}
+
+void D3DFence::ResetFenceValues(UINT64 value) noexcept {
+	const size_t fenceCount = std::size(m_fenceValues);
+	for (size_t _ = 0u; _ < fenceCount; ++_) {
+		m_fenceValues.pop();
+		m_fenceValues.push(value);
+	}
+}
+
+UINT64 D3DFence::GetFrontValue() const noexcept {
+	return m_fenceValues.front();
+}
+
+UINT64 D3DFence::GetCompletedValue() const noexcept {
+	return m_fence->GetCompletedValue();
+}
+
+UINT64 D3DFence::GetLastSignalledValue() const noexcept {
+	return m_lastSignalledValue;
+}
+
+ID3D12Fence* D3DFence::GetFence() const noexcept {
+	return m_fence.Get();
+}
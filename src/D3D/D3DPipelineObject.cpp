@@ -1,47 +1,148 @@
-#include <D3DPipelineObject.hpp>
-#include <Gaia.hpp>
-
-void D3DPipelineObject::CreateGFXPipelineStateVertex(
-	ID3D12Device2* device, const D3D12_INPUT_LAYOUT_DESC& vertexLayout,
-	ID3D12RootSignature* gfxRootSignature, const D3D12_SHADER_BYTECODE& vertexShader,
-	const D3D12_SHADER_BYTECODE& pixelShader
-) {
-	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc{
-		.VS = vertexShader,
-		.InputLayout = vertexLayout
-	};
-
-	PopulateGeneralGFXStates(psoDesc, gfxRootSignature, pixelShader);
-
-	CreatePipelineState(device, CD3DX12_PIPELINE_STATE_STREAM1(psoDesc));
-}
-
-void D3DPipelineObject::CreateComputePipelineState(
-	ID3D12Device2* device, ID3D12RootSignature* computeRootSignature,
-	const D3D12_SHADER_BYTECODE& computeShader
-) {
-	D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{
-		.CS = computeShader
-	};
-
-	PopulateRootSignature(psoDesc, computeRootSignature);
-
-	CreatePipelineState(device, CD3DX12_PIPELINE_STATE_STREAM1(psoDesc));
-}
-
-ID3D12PipelineState* D3DPipelineObject::Get() const noexcept {
-	return m_pPipelineState.Get();
-}
-
-void D3DPipelineObject::CreateGFXPipelineStateMesh(
-	ID3D12Device2* device, ID3D12RootSignature* gfxRootSignature,
-	const D3D12_SHADER_BYTECODE& meshShader, const D3D12_SHADER_BYTECODE& pixelShader
-) {
-	D3DX12_MESH_SHADER_PIPELINE_STATE_DESC psoDesc{
-		.MS = meshShader,
-	};
-
-	PopulateGeneralGFXStates(psoDesc, gfxRootSignature, pixelShader);
-
-	CreatePipelineState(device, CD3DX12_PIPELINE_MESH_STATE_STREAM(psoDesc));
-}
+#include <D3DPipelineObject.hpp>
+#include <RootSignatureBase.hpp>
+#include <PipelineHasher.hpp>
+#include <Gaia.hpp>
+
+namespace {
+	enum class PipelineType : std::uint32_t {
+		Vertex,
+		Compute,
+		Mesh
+	};
+
+	void AddShader(PipelineHasher& hasher, const D3D12_SHADER_BYTECODE& shader) noexcept {
+		hasher.AddValue(shader.BytecodeLength)
+			.AddBytes(shader.pShaderBytecode, shader.BytecodeLength);
+	}
+
+	void AddInputLayout(
+		PipelineHasher& hasher, const D3D12_INPUT_LAYOUT_DESC& inputLayout
+	) noexcept {
+		hasher.AddValue(inputLayout.NumElements);
+
+		for (UINT index = 0u; index < inputLayout.NumElements; ++index) {
+			const D3D12_INPUT_ELEMENT_DESC& element = inputLayout.pInputElementDescs[index];
+
+			hasher.AddString(element.SemanticName).AddValue(element.SemanticIndex)
+				.AddValue(element.Format).AddValue(element.InputSlot)
+				.AddValue(element.AlignedByteOffset).AddValue(element.InputSlotClass)
+				.AddValue(element.InstanceDataStepRate);
+		}
+	}
+
+	// Field by field, as the state structs have padding.
+	template<typename T>
+	void AddGeneralGFXStates(PipelineHasher& hasher, const T& psoDesc) noexcept {
+		hasher.AddValue(RootSignatureBase::GetSignatureHash(psoDesc.pRootSignature));
+
+		AddShader(hasher, psoDesc.PS);
+
+		const D3D12_BLEND_DESC& blendState = psoDesc.BlendState;
+		hasher.AddValue(blendState.AlphaToCoverageEnable)
+			.AddValue(blendState.IndependentBlendEnable);
+
+		for (UINT index = 0u; index < psoDesc.NumRenderTargets; ++index) {
+			const D3D12_RENDER_TARGET_BLEND_DESC& target = blendState.RenderTarget[index];
+
+			hasher.AddValue(target.BlendEnable).AddValue(target.LogicOpEnable)
+				.AddValue(target.SrcBlend).AddValue(target.DestBlend).AddValue(target.BlendOp)
+				.AddValue(target.SrcBlendAlpha).AddValue(target.DestBlendAlpha)
+				.AddValue(target.BlendOpAlpha).AddValue(target.LogicOp)
+				.AddValue(target.RenderTargetWriteMask)
+				.AddValue(psoDesc.RTVFormats[index]);
+		}
+
+		const D3D12_RASTERIZER_DESC& rasterizerState = psoDesc.RasterizerState;
+		hasher.AddValue(rasterizerState.FillMode).AddValue(rasterizerState.CullMode)
+			.AddValue(rasterizerState.FrontCounterClockwise).AddValue(rasterizerState.DepthBias)
+			.AddValue(rasterizerState.DepthBiasClamp)
+			.AddValue(rasterizerState.SlopeScaledDepthBias)
+			.AddValue(rasterizerState.DepthClipEnable)
+			.AddValue(rasterizerState.MultisampleEnable)
+			.AddValue(rasterizerState.AntialiasedLineEnable)
+			.AddValue(rasterizerState.ForcedSampleCount)
+			.AddValue(rasterizerState.ConservativeRaster);
+
+		const D3D12_DEPTH_STENCIL_DESC& depthStencilState = psoDesc.DepthStencilState;
+		hasher.AddValue(depthStencilState.DepthEnable)
+			.AddValue(depthStencilState.DepthWriteMask).AddValue(depthStencilState.DepthFunc)
+			.AddValue(depthStencilState.StencilEnable);
+
+		hasher.AddValue(psoDesc.SampleMask).AddValue(psoDesc.PrimitiveTopologyType)
+			.AddValue(psoDesc.NumRenderTargets).AddValue(psoDesc.DSVFormat)
+			.AddValue(psoDesc.SampleDesc.Count).AddValue(psoDesc.SampleDesc.Quality);
+	}
+}
+
+void D3DPipelineObject::CreateGFXPipelineStateVertex(
+	ID3D12Device2* device, const D3D12_INPUT_LAYOUT_DESC& vertexLayout,
+	ID3D12RootSignature* gfxRootSignature, const D3D12_SHADER_BYTECODE& vertexShader,
+	const D3D12_SHADER_BYTECODE& pixelShader
+) {
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc{
+		.VS = vertexShader,
+		.InputLayout = vertexLayout
+	};
+
+	PopulateGeneralGFXStates(psoDesc, gfxRootSignature, pixelShader);
+
+	PipelineHasher hasher{};
+	hasher.AddValue(PipelineType::Vertex);
+
+	AddShader(hasher, vertexShader);
+	AddInputLayout(hasher, vertexLayout);
+	AddGeneralGFXStates(hasher, psoDesc);
+
+	CreatePipelineState(device, CD3DX12_PIPELINE_STATE_STREAM1(psoDesc), hasher.GetHash());
+}
+
+void D3DPipelineObject::CreateComputePipelineState(
+	ID3D12Device2* device, ID3D12RootSignature* computeRootSignature,
+	const D3D12_SHADER_BYTECODE& computeShader
+) {
+	D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{
+		.CS = computeShader
+	};
+
+	PopulateRootSignature(psoDesc, computeRootSignature);
+
+	PipelineHasher hasher{};
+	hasher.AddValue(PipelineType::Compute)
+		.AddValue(RootSignatureBase::GetSignatureHash(computeRootSignature));
+
+	AddShader(hasher, computeShader);
+
+	CreatePipelineState(device, CD3DX12_PIPELINE_STATE_STREAM1(psoDesc), hasher.GetHash());
+}
+
+ID3D12PipelineState* D3DPipelineObject::Get() const noexcept {
+	return m_pPipelineState.Get();
+}
+
+void D3DPipelineObject::CreateGFXPipelineStateMesh(
+	ID3D12Device2* device, ID3D12RootSignature* gfxRootSignature,
+	const D3D12_SHADER_BYTECODE& meshShader, const D3D12_SHADER_BYTECODE& pixelShader
+) {
+	D3DX12_MESH_SHADER_PIPELINE_STATE_DESC psoDesc{
+		.MS = meshShader,
+	};
+
+	PopulateGeneralGFXStates(psoDesc, gfxRootSignature, pixelShader);
+
+	PipelineHasher hasher{};
+	hasher.AddValue(PipelineType::Mesh);
+
+	AddShader(hasher, meshShader);
+	AddGeneralGFXStates(hasher, psoDesc);
+
+	CreatePipelineState(device, CD3DX12_PIPELINE_MESH_STATE_STREAM(psoDesc), hasher.GetHash());
+}
+
+void D3DPipelineObject::_createPipelineState(
+	ID3D12Device2* device, const D3D12_PIPELINE_STATE_STREAM_DESC& streamDesc,
+	std::uint64_t pipelineKey
+) {
+	m_pPipelineState = Gaia::pipelineLibrary->CreatePipelineState(
+		device, streamDesc, pipelineKey
+	);
+}
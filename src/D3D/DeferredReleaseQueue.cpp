@@ -0,0 +1,28 @@
+#include <DeferredReleaseQueue.hpp>
+
+void DeferredReleaseQueue::Push(UINT64 fenceValue, std::function<void()> release) {
+	m_entries.emplace_back(Entry{ .fenceValue = fenceValue, .release = std::move(release) });
+}
+
+void DeferredReleaseQueue::Release(UINT64 completedFenceValue) {
+	while (!std::empty(m_entries) && m_entries.front().fenceValue <= completedFenceValue) {
+		// Popped first, so a release can push new entries.
+		std::function<void()> release = std::move(m_entries.front().release);
+		m_entries.pop_front();
+
+		release();
+	}
+}
+
+void DeferredReleaseQueue::ReleaseAll() {
+	while (!std::empty(m_entries)) {
+		std::function<void()> release = std::move(m_entries.front().release);
+		m_entries.pop_front();
+
+		release();
+	}
+}
+
+size_t DeferredReleaseQueue::GetPendingCount() const noexcept {
+	return std::size(m_entries);
+}
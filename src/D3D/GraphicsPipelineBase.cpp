@@ -1,18 +1,40 @@
-#include <GraphicsPipelineBase.hpp>
-
-void GraphicsPipelineBase::BindGraphicsPipeline(
-	ID3D12GraphicsCommandList* graphicsCommandList, ID3D12RootSignature* graphicsRS
-) const noexcept {
-	graphicsCommandList->SetPipelineState(m_graphicPSO->Get());
-	graphicsCommandList->SetGraphicsRootSignature(graphicsRS);
-	graphicsCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-}
-
-void GraphicsPipelineBase::CreateGraphicsPipeline(
-	ID3D12Device2* device, ID3D12RootSignature* graphicsRootSignature,
-	const std::wstring& shaderPath
-) noexcept {
-	m_graphicPSO = _createGraphicsPipelineObject(
-		device, shaderPath, m_pixelShader, graphicsRootSignature
-	);
-}
+#include <GraphicsPipelineBase.hpp>
+
+void GraphicsPipelineBase::BindGraphicsPipeline(
+	ID3D12GraphicsCommandList* graphicsCommandList, ID3D12RootSignature* graphicsRS
+) const noexcept {
+	graphicsCommandList->SetPipelineState(m_graphicPSO->Get());
+	graphicsCommandList->SetGraphicsRootSignature(graphicsRS);
+	graphicsCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void GraphicsPipelineBase::SwitchGraphicsPipeline(
+	ID3D12GraphicsCommandList* graphicsCommandList
+) const noexcept {
+	graphicsCommandList->SetPipelineState(m_graphicPSO->Get());
+}
+
+void GraphicsPipelineBase::SharePipelineObject(
+	const GraphicsPipelineBase& graphicsPipeline
+) noexcept {
+	m_graphicPSO = graphicsPipeline.m_graphicPSO;
+}
+
+bool GraphicsPipelineBase::SharesPipelineObject(
+	const GraphicsPipelineBase& graphicsPipeline
+) const noexcept {
+	return m_graphicPSO == graphicsPipeline.m_graphicPSO;
+}
+
+const std::wstring& GraphicsPipelineBase::GetPixelShader() const noexcept {
+	return m_pixelShader;
+}
+
+void GraphicsPipelineBase::CreateGraphicsPipeline(
+	ID3D12Device2* device, ID3D12RootSignature* graphicsRootSignature,
+	const std::wstring& shaderPath
+) {
+	m_graphicPSO = _createGraphicsPipelineObject(
+		device, shaderPath, m_pixelShader, graphicsRootSignature
+	);
+}
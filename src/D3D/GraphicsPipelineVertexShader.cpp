@@ -1,105 +1,297 @@
-#include <GraphicsPipelineVertexShader.hpp>
-#include <VertexLayout.hpp>
-#include <Shader.hpp>
-
-// Vertex Shader
-std::unique_ptr<D3DPipelineObject> GraphicsPipelineVertexShader::CreateGraphicsPipelineObjectVS(
-	ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
-	const std::wstring& vertexShader, ID3D12RootSignature* graphicsRootSignature
-) const noexcept {
-	auto vs = std::make_unique<Shader>();
-	vs->LoadBinary(shaderPath + vertexShader);
-
-	auto ps = std::make_unique<Shader>();
-	ps->LoadBinary(shaderPath + pixelShader);
-
-	auto pso = std::make_unique<D3DPipelineObject>();
-	pso->CreateGFXPipelineStateVertex(
-		device,
-		VertexLayout()
-		.AddInputElement("Position", DXGI_FORMAT_R32G32B32_FLOAT, 12u)
-		.AddInputElement("Normal", DXGI_FORMAT_R32G32B32_FLOAT, 12u)
-		.AddInputElement("UV", DXGI_FORMAT_R32G32_FLOAT, 8u).GetLayoutDesc(),
-		graphicsRootSignature, vs->GetByteCode(), ps->GetByteCode()
-	);
-
-	return pso;
-}
-
-// Indirect Draw
-GraphicsPipelineIndirectDraw::GraphicsPipelineIndirectDraw() noexcept
-	: m_modelCount{ 0u }, m_counterBufferOffset{ 0u }, m_argumentBufferOffset{ 0u } {}
-
-void GraphicsPipelineIndirectDraw::DrawModels(
-	ID3D12CommandSignature* commandSignature, ID3D12GraphicsCommandList* graphicsCommandList,
-	ID3D12Resource* argumentBuffer, ID3D12Resource* counterBuffer
-) const noexcept {
-	graphicsCommandList->ExecuteIndirect(
-		commandSignature, m_modelCount, argumentBuffer, m_argumentBufferOffset,
-		counterBuffer, m_counterBufferOffset
-	);
-}
-
-void GraphicsPipelineIndirectDraw::ConfigureGraphicsPipelineObject(
-	const std::wstring& pixelShader, UINT modelCount, std::uint32_t modelCountOffset,
-	size_t counterIndex
-) noexcept {
-	m_modelCount = modelCount;
-
-	m_argumentBufferOffset = sizeof(ModelDrawArguments) * modelCountOffset;
-	m_counterBufferOffset = sizeof(std::uint32_t) * 2u * counterIndex;
-	m_pixelShader = pixelShader;
-}
-
-std::unique_ptr<D3DPipelineObject> GraphicsPipelineIndirectDraw::_createGraphicsPipelineObject(
-	ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
-	ID3D12RootSignature* graphicsRootSignature
-) const noexcept {
-	return CreateGraphicsPipelineObjectVS(
-		device, shaderPath, pixelShader, L"VertexShaderIndirect.cso", graphicsRootSignature
-	);
-}
-
-// Individual Draw
-GraphicsPipelineIndividualDraw::GraphicsPipelineIndividualDraw() noexcept
-	: m_modelCount{ 0u }, m_modelOffset{ 0u } {}
-
-void GraphicsPipelineIndividualDraw::ConfigureGraphicsPipelineObject(
-	const std::wstring& pixelShader, size_t modelCount, size_t modelOffset
-) noexcept {
-	m_pixelShader = pixelShader;
-	m_modelCount = modelCount;
-	m_modelOffset = modelOffset;
-}
-
-void GraphicsPipelineIndividualDraw::DrawModels(
-	ID3D12GraphicsCommandList* graphicsCommandList,
-	const std::vector<ModelDrawArguments>& drawArguments,
-	const RSLayoutType& graphicsRSLayout
-) const noexcept {
-	for (size_t index = 0u; index < m_modelCount; ++index) {
-		const auto& modelArgs = drawArguments[m_modelOffset + index];
-
-		static constexpr size_t modelInfoIndex = static_cast<size_t>(RootSigElement::ModelInfo);
-
-		graphicsCommandList->SetGraphicsRoot32BitConstant(
-			graphicsRSLayout[modelInfoIndex], modelArgs.modelIndex, 0u
-		);
-
-		const D3D12_DRAW_INDEXED_ARGUMENTS& args = modelArgs.drawIndexed;
-
-		graphicsCommandList->DrawIndexedInstanced(
-			args.IndexCountPerInstance, args.InstanceCount, args.StartIndexLocation,
-			args.BaseVertexLocation, args.StartInstanceLocation
-		);
-	}
-}
-
-std::unique_ptr<D3DPipelineObject> GraphicsPipelineIndividualDraw::_createGraphicsPipelineObject(
-	ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
-	ID3D12RootSignature* graphicsRootSignature
-) const noexcept {
-	return CreateGraphicsPipelineObjectVS(
-		device, shaderPath, pixelShader, L"VertexShaderIndividual.cso", graphicsRootSignature
-	);
-}
+#include <GraphicsPipelineVertexShader.hpp>
+#include <VertexLayout.hpp>
+#include <Gaia.hpp>
+#include <algorithm>
+
+// Vertex Shader
+GraphicsPipelineVertexShader::GraphicsPipelineVertexShader() noexcept
+	: m_vertexFormat{ VertexFormat::Full } {}
+
+void GraphicsPipelineVertexShader::SetVertexFormat(VertexFormat vertexFormat) noexcept {
+	m_vertexFormat = vertexFormat;
+}
+
+std::unique_ptr<D3DPipelineObject> GraphicsPipelineVertexShader::CreateGraphicsPipelineObjectVS(
+	ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
+	const std::wstring& vertexShader, ID3D12RootSignature* graphicsRootSignature
+) const {
+	const bool packedVertices = m_vertexFormat == VertexFormat::Packed;
+
+	auto vs = Gaia::shaderCache->LoadBinary(
+		shaderPath + vertexShader + (packedVertices ? L"Packed.cso" : L".cso")
+	);
+	auto ps = Gaia::shaderCache->LoadBinary(shaderPath + pixelShader);
+
+	VertexLayout vertexLayout{};
+
+	if (packedVertices)
+		vertexLayout.AddInputElement("Position", DXGI_FORMAT_R16G16B16A16_UNORM, 8u)
+		.AddInputElement("Normal", DXGI_FORMAT_R16G16_SNORM, 4u)
+		.AddInputElement("UV", DXGI_FORMAT_R16G16_FLOAT, 4u);
+	else
+		vertexLayout.AddInputElement("Position", DXGI_FORMAT_R32G32B32_FLOAT, 12u)
+		.AddInputElement("Normal", DXGI_FORMAT_R32G32B32_FLOAT, 12u)
+		.AddInputElement("UV", DXGI_FORMAT_R32G32_FLOAT, 8u);
+
+	auto pso = std::make_unique<D3DPipelineObject>();
+	pso->CreateGFXPipelineStateVertex(
+		device, vertexLayout.GetLayoutDesc(), graphicsRootSignature, vs->GetByteCode(),
+		ps->GetByteCode()
+	);
+
+	return pso;
+}
+
+// Indirect Draw
+GraphicsPipelineIndirectDraw::GraphicsPipelineIndirectDraw() noexcept
+	: m_modelCount{ 0u }, m_counterBufferOffset{ 0u }, m_argumentBufferOffset{ 0u } {}
+
+void GraphicsPipelineIndirectDraw::DrawModels(
+	ID3D12CommandSignature* commandSignature, ID3D12GraphicsCommandList* graphicsCommandList,
+	ID3D12Resource* argumentBuffer, ID3D12Resource* counterBuffer
+) const noexcept {
+	if (m_modelCount == 0u)
+		return;
+
+	graphicsCommandList->ExecuteIndirect(
+		commandSignature, m_modelCount, argumentBuffer, m_argumentBufferOffset,
+		counterBuffer, m_counterBufferOffset
+	);
+}
+
+void GraphicsPipelineIndirectDraw::ConfigureGraphicsPipelineObject(
+	const std::wstring& pixelShader, UINT modelCount, std::uint32_t modelCountOffset,
+	size_t counterIndex
+) noexcept {
+	m_modelCount = modelCount;
+
+	m_argumentBufferOffset = sizeof(ModelDrawArguments) * modelCountOffset;
+	m_counterBufferOffset = sizeof(std::uint32_t) * 2u * counterIndex;
+	m_pixelShader = pixelShader;
+}
+
+void GraphicsPipelineIndirectDraw::ClearModels() noexcept {
+	m_modelCount = 0u;
+}
+
+std::unique_ptr<D3DPipelineObject> GraphicsPipelineIndirectDraw::_createGraphicsPipelineObject(
+	ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
+	ID3D12RootSignature* graphicsRootSignature
+) const {
+	return CreateGraphicsPipelineObjectVS(
+		device, shaderPath, pixelShader, L"VertexShaderIndirect", graphicsRootSignature
+	);
+}
+
+// Individual Draw
+GraphicsPipelineIndividualDraw::GraphicsPipelineIndividualDraw() noexcept
+	: m_instancing{ false } {}
+
+void GraphicsPipelineIndividualDraw::ConfigureGraphicsPipelineObject(
+	const std::wstring& pixelShader
+) noexcept {
+	m_pixelShader = pixelShader;
+}
+
+void GraphicsPipelineIndividualDraw::SetInstancing(bool enable) noexcept {
+	m_instancing = enable;
+}
+
+void GraphicsPipelineIndividualDraw::CreateGraphicsPipeline(
+	ID3D12Device2* device, ID3D12RootSignature* graphicsRootSignature,
+	const std::wstring& shaderPath
+) {
+	GraphicsPipelineBase::CreateGraphicsPipeline(device, graphicsRootSignature, shaderPath);
+
+	if (m_instancing)
+		m_individualPSO = CreateGraphicsPipelineObjectVS(
+			device, shaderPath, m_pixelShader, L"VertexShaderIndividual", graphicsRootSignature
+		);
+}
+
+void GraphicsPipelineIndividualDraw::SharePipelineObject(
+	const GraphicsPipelineBase& graphicsPipeline
+) noexcept {
+	GraphicsPipelineBase::SharePipelineObject(graphicsPipeline);
+
+	// The pipelines of an engine are all of the same type.
+	m_individualPSO =
+		static_cast<const GraphicsPipelineIndividualDraw&>(graphicsPipeline).m_individualPSO;
+}
+
+void GraphicsPipelineIndividualDraw::BindGraphicsPipeline(
+	ID3D12GraphicsCommandList* graphicsCommandList, ID3D12RootSignature* graphicsRS,
+	bool drawInstanced
+) const noexcept {
+	graphicsCommandList->SetPipelineState(GetPipelineState(drawInstanced));
+	graphicsCommandList->SetGraphicsRootSignature(graphicsRS);
+	graphicsCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void GraphicsPipelineIndividualDraw::SwitchGraphicsPipeline(
+	ID3D12GraphicsCommandList* graphicsCommandList, bool drawInstanced
+) const noexcept {
+	graphicsCommandList->SetPipelineState(GetPipelineState(drawInstanced));
+}
+
+ID3D12PipelineState* GraphicsPipelineIndividualDraw::GetPipelineState(
+	bool drawInstanced
+) const noexcept {
+	// The instanced vertex shader would read the unbound instance buffer.
+	if (m_instancing && !drawInstanced)
+		return m_individualPSO->Get();
+
+	return m_graphicPSO->Get();
+}
+
+std::uint64_t GraphicsPipelineIndividualDraw::GetMeshKey(
+	const D3D12_DRAW_INDEXED_ARGUMENTS& drawArguments
+) noexcept {
+	return static_cast<std::uint64_t>(drawArguments.StartIndexLocation) << 32u
+		| drawArguments.IndexCountPerInstance;
+}
+
+std::uint32_t GraphicsPipelineIndividualDraw::AddMesh(
+	const D3D12_DRAW_INDEXED_ARGUMENTS& drawArguments
+) noexcept {
+	// The indices of the removed meshes are reused, so the mesh count stays in the draw keys.
+	const bool reuseMeshIndex = !std::empty(m_freeMeshIndices);
+	const std::uint32_t nextMeshIndex = reuseMeshIndex ?
+		m_freeMeshIndices.back() : static_cast<std::uint32_t>(std::size(m_meshArguments));
+
+	const auto [meshIndex, newMesh] = m_meshIndices.try_emplace(
+		GetMeshKey(drawArguments), nextMeshIndex
+	);
+
+	if (newMesh) {
+		if (reuseMeshIndex) {
+			m_freeMeshIndices.pop_back();
+			m_meshArguments[nextMeshIndex] = drawArguments;
+		}
+		else {
+			m_meshArguments.emplace_back(drawArguments);
+			m_meshModelCounts.emplace_back(0u);
+			m_meshInstanceOffsets.resize(std::size(m_meshArguments) + 1u);
+		}
+	}
+
+	++m_meshModelCounts[meshIndex->second];
+
+	return meshIndex->second;
+}
+
+void GraphicsPipelineIndividualDraw::RemoveMesh(std::uint32_t meshIndex) noexcept {
+	if (--m_meshModelCounts[meshIndex] != 0u)
+		return;
+
+	m_meshIndices.erase(GetMeshKey(m_meshArguments[meshIndex]));
+	m_freeMeshIndices.emplace_back(meshIndex);
+}
+
+void GraphicsPipelineIndividualDraw::ClearVisibleModels() noexcept {
+	m_visibleModels.clear();
+}
+
+void GraphicsPipelineIndividualDraw::AddVisibleModel(std::uint32_t modelIndex) noexcept {
+	m_visibleModels.emplace_back(modelIndex);
+}
+
+size_t GraphicsPipelineIndividualDraw::GetVisibleModelCount() const noexcept {
+	return std::size(m_visibleModels);
+}
+
+size_t GraphicsPipelineIndividualDraw::GetInstanceBatchCount() const noexcept {
+	return std::size(m_instanceBatches);
+}
+
+std::uint32_t GraphicsPipelineIndividualDraw::BuildInstanceBatches(
+	const std::vector<std::uint32_t>& modelMeshIndices, std::uint32_t* instanceModelIndices,
+	std::uint32_t instanceOffset
+) {
+	m_instanceBatches.clear();
+
+	// A counting sort, so the visible models keep their order within a mesh.
+	std::ranges::fill(m_meshInstanceOffsets, 0u);
+
+	for (std::uint32_t modelIndex : m_visibleModels)
+		++m_meshInstanceOffsets[modelMeshIndices[modelIndex] + 1u];
+
+	for (size_t meshIndex = 0u; meshIndex < std::size(m_meshArguments); ++meshIndex) {
+		const std::uint32_t instanceCount = m_meshInstanceOffsets[meshIndex + 1u];
+		const std::uint32_t meshInstanceOffset = m_meshInstanceOffsets[meshIndex];
+
+		if (instanceCount != 0u)
+			m_instanceBatches.emplace_back(
+				InstanceBatch{
+					.meshIndex = static_cast<std::uint32_t>(meshIndex),
+					.instanceOffset = instanceOffset + meshInstanceOffset,
+					.instanceCount = instanceCount
+				}
+			);
+
+		m_meshInstanceOffsets[meshIndex + 1u] = meshInstanceOffset + instanceCount;
+	}
+
+	for (std::uint32_t modelIndex : m_visibleModels)
+		instanceModelIndices[
+			instanceOffset + m_meshInstanceOffsets[modelMeshIndices[modelIndex]]++
+		] = modelIndex;
+
+	return static_cast<std::uint32_t>(std::size(m_visibleModels));
+}
+
+void GraphicsPipelineIndividualDraw::DrawInstances(
+	ID3D12GraphicsCommandList* graphicsCommandList, const RSLayoutType& graphicsRSLayout,
+	size_t batchStart, size_t batchEnd
+) const noexcept {
+	static constexpr size_t modelInfoIndex = static_cast<size_t>(RootSigElement::ModelInfo);
+
+	for (size_t index = batchStart; index < batchEnd; ++index) {
+		const InstanceBatch& batch = m_instanceBatches[index];
+
+		graphicsCommandList->SetGraphicsRoot32BitConstant(
+			graphicsRSLayout[modelInfoIndex], batch.instanceOffset, 0u
+		);
+
+		const D3D12_DRAW_INDEXED_ARGUMENTS& args = m_meshArguments[batch.meshIndex];
+
+		graphicsCommandList->DrawIndexedInstanced(
+			args.IndexCountPerInstance, batch.instanceCount, args.StartIndexLocation,
+			args.BaseVertexLocation, 0u
+		);
+	}
+}
+
+void GraphicsPipelineIndividualDraw::DrawModels(
+	ID3D12GraphicsCommandList* graphicsCommandList,
+	const std::vector<ModelDrawArguments>& drawArguments,
+	const RSLayoutType& graphicsRSLayout, size_t visibleStart, size_t visibleEnd
+) const noexcept {
+	for (size_t index = visibleStart; index < visibleEnd; ++index) {
+		const auto& modelArgs = drawArguments[m_visibleModels[index]];
+
+		static constexpr size_t modelInfoIndex = static_cast<size_t>(RootSigElement::ModelInfo);
+
+		graphicsCommandList->SetGraphicsRoot32BitConstant(
+			graphicsRSLayout[modelInfoIndex], modelArgs.modelIndex, 0u
+		);
+
+		const D3D12_DRAW_INDEXED_ARGUMENTS& args = modelArgs.drawIndexed;
+
+		graphicsCommandList->DrawIndexedInstanced(
+			args.IndexCountPerInstance, args.InstanceCount, args.StartIndexLocation,
+			args.BaseVertexLocation, args.StartInstanceLocation
+		);
+	}
+}
+
+std::unique_ptr<D3DPipelineObject> GraphicsPipelineIndividualDraw::_createGraphicsPipelineObject(
+	ID3D12Device2* device, const std::wstring& shaderPath, const std::wstring& pixelShader,
+	ID3D12RootSignature* graphicsRootSignature
+) const {
+	return CreateGraphicsPipelineObjectVS(
+		device, shaderPath, pixelShader,
+		m_instancing ? L"VertexShaderIndividualInstanced" : L"VertexShaderIndividual",
+		graphicsRootSignature
+	);
+}
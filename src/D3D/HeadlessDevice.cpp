@@ -0,0 +1,908 @@
+#include <HeadlessDevice.hpp>
+#include <RecordingCommandList.hpp>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+// The bytes of a texel, or of a 4x4 block for the block compressed formats.
+[[nodiscard]]
+static UINT64 GetElementSize(DXGI_FORMAT format) noexcept {
+	switch (format) {
+	case DXGI_FORMAT_UNKNOWN:
+	case DXGI_FORMAT_R8_TYPELESS:
+	case DXGI_FORMAT_R8_UNORM:
+	case DXGI_FORMAT_R8_UINT:
+	case DXGI_FORMAT_R8_SNORM:
+	case DXGI_FORMAT_R8_SINT:
+	case DXGI_FORMAT_A8_UNORM:
+		return 1u;
+	case DXGI_FORMAT_R8G8_TYPELESS:
+	case DXGI_FORMAT_R8G8_UNORM:
+	case DXGI_FORMAT_R8G8_UINT:
+	case DXGI_FORMAT_R16_TYPELESS:
+	case DXGI_FORMAT_R16_FLOAT:
+	case DXGI_FORMAT_D16_UNORM:
+	case DXGI_FORMAT_R16_UNORM:
+	case DXGI_FORMAT_R16_UINT:
+		return 2u;
+	case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+	case DXGI_FORMAT_R16G16B16A16_UNORM:
+	case DXGI_FORMAT_R16G16B16A16_UINT:
+	case DXGI_FORMAT_R32G32_TYPELESS:
+	case DXGI_FORMAT_R32G32_FLOAT:
+	case DXGI_FORMAT_R32G32_UINT:
+	case DXGI_FORMAT_BC1_TYPELESS:
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_TYPELESS:
+	case DXGI_FORMAT_BC4_UNORM:
+	case DXGI_FORMAT_BC4_SNORM:
+		return 8u;
+	case DXGI_FORMAT_R32G32B32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32_FLOAT:
+	case DXGI_FORMAT_R32G32B32_UINT:
+		return 12u;
+	case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+	case DXGI_FORMAT_R32G32B32A32_UINT:
+	case DXGI_FORMAT_BC2_TYPELESS:
+	case DXGI_FORMAT_BC2_UNORM:
+	case DXGI_FORMAT_BC2_UNORM_SRGB:
+	case DXGI_FORMAT_BC3_TYPELESS:
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC5_TYPELESS:
+	case DXGI_FORMAT_BC5_UNORM:
+	case DXGI_FORMAT_BC5_SNORM:
+	case DXGI_FORMAT_BC6H_TYPELESS:
+	case DXGI_FORMAT_BC6H_UF16:
+	case DXGI_FORMAT_BC6H_SF16:
+	case DXGI_FORMAT_BC7_TYPELESS:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return 16u;
+	default:
+		return 4u;
+	}
+}
+
+[[nodiscard]]
+static bool IsBlockCompressed(DXGI_FORMAT format) noexcept {
+	return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM)
+		|| (format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+}
+
+HeadlessDevice::HeadlessDevice() noexcept
+	: m_referenceCount{ 1u }, m_nextAddress{ 0x1'0000'0000u } {}
+
+D3D12_GPU_VIRTUAL_ADDRESS HeadlessDevice::ReserveAddressRange(UINT64 size) noexcept {
+	return m_nextAddress.fetch_add(Align(std::max(size, UINT64{ 1u }), s_addressAlignment));
+}
+
+void HeadlessDevice::WriteDescriptor(
+	D3D12_CPU_DESCRIPTOR_HANDLE destination, const HeadlessDescriptor& descriptor
+) noexcept {
+	std::memcpy(reinterpret_cast<void*>(destination.ptr), &descriptor, sizeof(descriptor));
+}
+
+HeadlessDescriptor HeadlessDevice::MakeResourceDescriptor(
+	ID3D12Resource* resource, HeadlessDescriptorType type, DXGI_FORMAT format
+) {
+	HeadlessDescriptor descriptor{
+		.address = 0u, .size = 0u, .type = type, .format = format, .resource = resource
+	};
+
+	if (resource) {
+		const D3D12_RESOURCE_DESC desc = resource->GetDesc();
+
+		descriptor.address = resource->GetGPUVirtualAddress();
+		descriptor.size = desc.Width;
+
+		if (format == DXGI_FORMAT_UNKNOWN)
+			descriptor.format = desc.Format;
+	}
+
+	return descriptor;
+}
+
+// IUnknown
+HRESULT STDMETHODCALLTYPE HeadlessDevice::QueryInterface(REFIID riid, void** ppvObject) {
+	if (!ppvObject)
+		return E_POINTER;
+
+	if (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D12Object)
+		|| riid == __uuidof(ID3D12Device) || riid == __uuidof(ID3D12Device1)
+		|| riid == __uuidof(ID3D12Device2) || riid == __uuidof(ID3D12Device3)
+		|| riid == __uuidof(ID3D12Device4) || riid == __uuidof(ID3D12Device5)) {
+		*ppvObject = static_cast<ID3D12Device5*>(this);
+		AddRef();
+
+		return S_OK;
+	}
+
+	*ppvObject = nullptr;
+
+	return E_NOINTERFACE;
+}
+
+ULONG STDMETHODCALLTYPE HeadlessDevice::AddRef() {
+	return ++m_referenceCount;
+}
+
+ULONG STDMETHODCALLTYPE HeadlessDevice::Release() {
+	const ULONG referenceCount = --m_referenceCount;
+
+	if (referenceCount == 0u)
+		delete this;
+
+	return referenceCount;
+}
+
+// ID3D12Object
+HRESULT STDMETHODCALLTYPE HeadlessDevice::GetPrivateData(
+	REFGUID guid, UINT* pDataSize, void* pData
+) {
+	return m_privateData.Get(guid, pDataSize, pData);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::SetPrivateData(
+	REFGUID guid, UINT DataSize, const void* pData
+) {
+	return m_privateData.Set(guid, DataSize, pData);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::SetPrivateDataInterface(
+	[[maybe_unused]] REFGUID guid, [[maybe_unused]] const IUnknown* pData
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::SetName([[maybe_unused]] LPCWSTR Name) {
+	return S_OK;
+}
+
+// ID3D12Device
+UINT STDMETHODCALLTYPE HeadlessDevice::GetNodeCount() {
+	return 1u;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommandQueue(
+	const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue
+) {
+	if (!pDesc)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(new HeadlessCommandQueue{ this, *pDesc }, riid, ppCommandQueue);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommandAllocator(
+	[[maybe_unused]] D3D12_COMMAND_LIST_TYPE type, REFIID riid, void** ppCommandAllocator
+) {
+	return QueryHeadlessObject(new HeadlessCommandAllocator{ this }, riid, ppCommandAllocator);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateGraphicsPipelineState(
+	const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState
+) {
+	if (!pDesc)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(new HeadlessPipelineState{ this }, riid, ppPipelineState);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateComputePipelineState(
+	const D3D12_COMPUTE_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState
+) {
+	if (!pDesc)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(new HeadlessPipelineState{ this }, riid, ppPipelineState);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommandList(
+	[[maybe_unused]] UINT nodeMask, D3D12_COMMAND_LIST_TYPE type,
+	[[maybe_unused]] ID3D12CommandAllocator* pCommandAllocator,
+	[[maybe_unused]] ID3D12PipelineState* pInitialState, REFIID riid, void** ppCommandList
+) {
+	return QueryHeadlessObject(
+		new RecordingCommandList{ nullptr, nullptr, type }, riid, ppCommandList
+	);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CheckFeatureSupport(
+	D3D12_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize
+) {
+	if (!pFeatureSupportData)
+		return E_INVALIDARG;
+
+	// The highest of everything the renderer asks for.
+	switch (Feature) {
+	case D3D12_FEATURE_FEATURE_LEVELS: {
+		if (FeatureSupportDataSize != sizeof(D3D12_FEATURE_DATA_FEATURE_LEVELS))
+			return E_INVALIDARG;
+
+		auto& featureLevels = *static_cast<D3D12_FEATURE_DATA_FEATURE_LEVELS*>(
+			pFeatureSupportData
+		);
+
+		featureLevels.MaxSupportedFeatureLevel = D3D_FEATURE_LEVEL_12_1;
+
+		return S_OK;
+	}
+	case D3D12_FEATURE_SHADER_MODEL: {
+		if (FeatureSupportDataSize != sizeof(D3D12_FEATURE_DATA_SHADER_MODEL))
+			return E_INVALIDARG;
+
+		static_cast<D3D12_FEATURE_DATA_SHADER_MODEL*>(pFeatureSupportData)->HighestShaderModel
+			= D3D_SHADER_MODEL_6_5;
+
+		return S_OK;
+	}
+	case D3D12_FEATURE_ROOT_SIGNATURE: {
+		if (FeatureSupportDataSize != sizeof(D3D12_FEATURE_DATA_ROOT_SIGNATURE))
+			return E_INVALIDARG;
+
+		static_cast<D3D12_FEATURE_DATA_ROOT_SIGNATURE*>(pFeatureSupportData)->HighestVersion
+			= D3D_ROOT_SIGNATURE_VERSION_1_1;
+
+		return S_OK;
+	}
+	case D3D12_FEATURE_D3D12_OPTIONS7: {
+		if (FeatureSupportDataSize != sizeof(D3D12_FEATURE_DATA_D3D12_OPTIONS7))
+			return E_INVALIDARG;
+
+		*static_cast<D3D12_FEATURE_DATA_D3D12_OPTIONS7*>(pFeatureSupportData) = {
+			.MeshShaderTier = D3D12_MESH_SHADER_TIER_1,
+			.SamplerFeedbackTier = D3D12_SAMPLER_FEEDBACK_TIER_NOT_SUPPORTED
+		};
+
+		return S_OK;
+	}
+	default:
+		return E_INVALIDARG;
+	}
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateDescriptorHeap(
+	const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap
+) {
+	if (!pDescriptorHeapDesc)
+		return E_INVALIDARG;
+
+	const D3D12_GPU_VIRTUAL_ADDRESS address = ReserveAddressRange(
+		UINT64{ pDescriptorHeapDesc->NumDescriptors } * sizeof(HeadlessDescriptor)
+	);
+
+	return QueryHeadlessObject(
+		new HeadlessDescriptorHeap{ this, *pDescriptorHeapDesc, address }, riid, ppvHeap
+	);
+}
+
+UINT STDMETHODCALLTYPE HeadlessDevice::GetDescriptorHandleIncrementSize(
+	[[maybe_unused]] D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapType
+) {
+	return static_cast<UINT>(sizeof(HeadlessDescriptor));
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateRootSignature(
+	[[maybe_unused]] UINT nodeMask, const void* pBlobWithRootSignature,
+	SIZE_T blobLengthInBytes, REFIID riid, void** ppvRootSignature
+) {
+	if (!pBlobWithRootSignature || blobLengthInBytes == 0u)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(new HeadlessRootSignature{ this }, riid, ppvRootSignature);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CreateConstantBufferView(
+	const D3D12_CONSTANT_BUFFER_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+) {
+	WriteDescriptor(
+		DestDescriptor,
+		HeadlessDescriptor{
+			.address = pDesc ? pDesc->BufferLocation : 0u,
+			.size = pDesc ? pDesc->SizeInBytes : 0u,
+			.type = HeadlessDescriptorType::ConstantBuffer,
+			.format = DXGI_FORMAT_UNKNOWN,
+			.resource = nullptr
+		}
+	);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CreateShaderResourceView(
+	ID3D12Resource* pResource, const D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc,
+	D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+) {
+	WriteDescriptor(
+		DestDescriptor,
+		MakeResourceDescriptor(
+			pResource, HeadlessDescriptorType::ShaderResource,
+			pDesc ? pDesc->Format : DXGI_FORMAT_UNKNOWN
+		)
+	);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CreateUnorderedAccessView(
+	ID3D12Resource* pResource, [[maybe_unused]] ID3D12Resource* pCounterResource,
+	const D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+) {
+	WriteDescriptor(
+		DestDescriptor,
+		MakeResourceDescriptor(
+			pResource, HeadlessDescriptorType::UnorderedAccess,
+			pDesc ? pDesc->Format : DXGI_FORMAT_UNKNOWN
+		)
+	);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CreateRenderTargetView(
+	ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
+	D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+) {
+	WriteDescriptor(
+		DestDescriptor,
+		MakeResourceDescriptor(
+			pResource, HeadlessDescriptorType::RenderTarget,
+			pDesc ? pDesc->Format : DXGI_FORMAT_UNKNOWN
+		)
+	);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CreateDepthStencilView(
+	ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC* pDesc,
+	D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+) {
+	WriteDescriptor(
+		DestDescriptor,
+		MakeResourceDescriptor(
+			pResource, HeadlessDescriptorType::DepthStencil,
+			pDesc ? pDesc->Format : DXGI_FORMAT_UNKNOWN
+		)
+	);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CreateSampler(
+	[[maybe_unused]] const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor
+) {
+	WriteDescriptor(
+		DestDescriptor,
+		HeadlessDescriptor{
+			.address = 0u,
+			.size = 0u,
+			.type = HeadlessDescriptorType::Sampler,
+			.format = DXGI_FORMAT_UNKNOWN,
+			.resource = nullptr
+		}
+	);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CopyDescriptors(
+	UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts,
+	const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges,
+	const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts,
+	const UINT* pSrcDescriptorRangeSizes,
+	[[maybe_unused]] D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType
+) {
+	// The ranges are walked as one run of descriptors on either side.
+	UINT destinationRange = 0u;
+	UINT destinationIndex = 0u;
+
+	for (UINT sourceRange = 0u; sourceRange < NumSrcDescriptorRanges; ++sourceRange) {
+		const UINT sourceSize = pSrcDescriptorRangeSizes ? pSrcDescriptorRangeSizes[sourceRange]
+			: 1u;
+
+		for (UINT sourceIndex = 0u; sourceIndex < sourceSize; ++sourceIndex) {
+			while (destinationRange < NumDestDescriptorRanges
+				&& destinationIndex == (pDestDescriptorRangeSizes
+					? pDestDescriptorRangeSizes[destinationRange] : 1u)) {
+				++destinationRange;
+				destinationIndex = 0u;
+			}
+
+			if (destinationRange == NumDestDescriptorRanges)
+				return;
+
+			CopyDescriptorsSimple(
+				1u,
+				{ pDestDescriptorRangeStarts[destinationRange].ptr
+					+ destinationIndex * sizeof(HeadlessDescriptor) },
+				{ pSrcDescriptorRangeStarts[sourceRange].ptr
+					+ sourceIndex * sizeof(HeadlessDescriptor) },
+				DescriptorHeapsType
+			);
+
+			++destinationIndex;
+		}
+	}
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::CopyDescriptorsSimple(
+	UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart,
+	D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart,
+	[[maybe_unused]] D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType
+) {
+	std::memmove(
+		reinterpret_cast<void*>(DestDescriptorRangeStart.ptr),
+		reinterpret_cast<const void*>(SrcDescriptorRangeStart.ptr),
+		NumDescriptors * sizeof(HeadlessDescriptor)
+	);
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE HeadlessDevice::GetResourceAllocationInfo(
+	[[maybe_unused]] UINT visibleMask, UINT numResourceDescs,
+	const D3D12_RESOURCE_DESC* pResourceDescs
+) {
+	D3D12_RESOURCE_ALLOCATION_INFO allocationInfo{ .SizeInBytes = 0u, .Alignment = 0u };
+
+	for (UINT index = 0u; index < numResourceDescs; ++index) {
+		const D3D12_RESOURCE_DESC& desc = pResourceDescs[index];
+
+		UINT64 size = desc.Width;
+		UINT64 alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+		if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER) {
+			const UINT subresourceCount = std::max<UINT>(desc.MipLevels, 1u)
+				* (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1u
+					: std::max<UINT>(desc.DepthOrArraySize, 1u));
+
+			GetCopyableFootprints(
+				&desc, 0u, subresourceCount, 0u, nullptr, nullptr, nullptr, &size
+			);
+
+			if (desc.Alignment != 0u)
+				alignment = desc.Alignment;
+			else if (desc.SampleDesc.Count > 1u)
+				alignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+		}
+
+		allocationInfo.Alignment = std::max(allocationInfo.Alignment, alignment);
+		allocationInfo.SizeInBytes = Align(allocationInfo.SizeInBytes, alignment)
+			+ Align(size, alignment);
+	}
+
+	return allocationInfo;
+}
+
+D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE HeadlessDevice::GetCustomHeapProperties(
+	[[maybe_unused]] UINT nodeMask, D3D12_HEAP_TYPE heapType
+) {
+	D3D12_HEAP_PROPERTIES properties{
+		.Type = D3D12_HEAP_TYPE_CUSTOM,
+		.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE,
+		.MemoryPoolPreference = D3D12_MEMORY_POOL_L0,
+		.CreationNodeMask = 1u,
+		.VisibleNodeMask = 1u
+	};
+
+	if (heapType == D3D12_HEAP_TYPE_UPLOAD)
+		properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE;
+	else if (heapType == D3D12_HEAP_TYPE_READBACK)
+		properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_BACK;
+
+	return properties;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommittedResource(
+	const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags,
+	const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState,
+	const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riidResource, void** ppvResource
+) {
+	if (!pHeapProperties || !pDesc)
+		return E_INVALIDARG;
+
+	// A heap of its own, as the implicit heap of a device.
+	const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = GetResourceAllocationInfo(
+		0u, 1u, pDesc
+	);
+
+	const D3D12_HEAP_DESC heapDesc{
+		.SizeInBytes = allocationInfo.SizeInBytes,
+		.Properties = *pHeapProperties,
+		.Alignment = allocationInfo.Alignment,
+		.Flags = HeapFlags
+	};
+
+	ComPtr<ID3D12Heap> heap{};
+
+	if (HRESULT hr = CreateHeap(&heapDesc, IID_PPV_ARGS(&heap)); FAILED(hr))
+		return hr;
+
+	return CreatePlacedResource(
+		heap.Get(), 0u, pDesc, InitialResourceState, pOptimizedClearValue, riidResource,
+		ppvResource
+	);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateHeap(
+	const D3D12_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap
+) {
+	if (!pDesc || pDesc->SizeInBytes == 0u)
+		return E_INVALIDARG;
+
+	HeadlessHeap* heap = nullptr;
+
+	try {
+		heap = new HeadlessHeap{ this, *pDesc, ReserveAddressRange(pDesc->SizeInBytes) };
+	}
+	catch (const std::bad_alloc&) {
+		return E_OUTOFMEMORY;
+	}
+
+	return QueryHeadlessObject(heap, riid, ppvHeap);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreatePlacedResource(
+	ID3D12Heap* pHeap, UINT64 HeapOffset, const D3D12_RESOURCE_DESC* pDesc,
+	[[maybe_unused]] D3D12_RESOURCE_STATES InitialState,
+	[[maybe_unused]] const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid,
+	void** ppvResource
+) {
+	if (!pHeap || !pDesc)
+		return E_INVALIDARG;
+
+	// Only heaps from this device can be passed, like on any other.
+	auto heap = static_cast<HeadlessHeap*>(pHeap);
+
+	const UINT64 resourceSize = GetResourceAllocationInfo(0u, 1u, pDesc).SizeInBytes;
+
+	if (HeapOffset + resourceSize > heap->GetDesc().SizeInBytes)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(
+		new HeadlessResource{ this, heap, HeapOffset, *pDesc }, riid, ppvResource
+	);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateReservedResource(
+	[[maybe_unused]] const D3D12_RESOURCE_DESC* pDesc,
+	[[maybe_unused]] D3D12_RESOURCE_STATES InitialState,
+	[[maybe_unused]] const D3D12_CLEAR_VALUE* pOptimizedClearValue,
+	[[maybe_unused]] REFIID riid, [[maybe_unused]] void** ppvResource
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateSharedHandle(
+	[[maybe_unused]] ID3D12DeviceChild* pObject,
+	[[maybe_unused]] const SECURITY_ATTRIBUTES* pAttributes, [[maybe_unused]] DWORD Access,
+	[[maybe_unused]] LPCWSTR Name, [[maybe_unused]] HANDLE* pHandle
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::OpenSharedHandle(
+	[[maybe_unused]] HANDLE NTHandle, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppvObj
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::OpenSharedHandleByName(
+	[[maybe_unused]] LPCWSTR Name, [[maybe_unused]] DWORD Access,
+	[[maybe_unused]] HANDLE* pNTHandle
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::MakeResident(
+	[[maybe_unused]] UINT NumObjects, [[maybe_unused]] ID3D12Pageable* const* ppObjects
+) {
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::Evict(
+	[[maybe_unused]] UINT NumObjects, [[maybe_unused]] ID3D12Pageable* const* ppObjects
+) {
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateFence(
+	UINT64 InitialValue, [[maybe_unused]] D3D12_FENCE_FLAGS Flags, REFIID riid, void** ppFence
+) {
+	return QueryHeadlessObject(new HeadlessFence{ this, InitialValue }, riid, ppFence);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::GetDeviceRemovedReason() {
+	return S_OK;
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::GetCopyableFootprints(
+	const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource, UINT NumSubresources,
+	UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows,
+	UINT64* pRowSizeInBytes, UINT64* pTotalBytes
+) {
+	const D3D12_RESOURCE_DESC& desc = *pResourceDesc;
+	const bool buffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+	const bool blockCompressed = IsBlockCompressed(desc.Format);
+	const UINT mipLevels = std::max<UINT>(desc.MipLevels, 1u);
+	const UINT64 elementSize = buffer ? 1u : GetElementSize(desc.Format);
+
+	UINT64 offset = BaseOffset;
+	UINT64 totalBytes = 0u;
+
+	for (UINT index = 0u; index < NumSubresources; ++index) {
+		const UINT mipLevel = (FirstSubresource + index) % mipLevels;
+
+		const UINT64 width = std::max<UINT64>(desc.Width >> mipLevel, 1u);
+		const UINT height = buffer ? 1u : std::max<UINT>(desc.Height >> mipLevel, 1u);
+		const UINT depth = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D
+			? std::max<UINT>(desc.DepthOrArraySize >> mipLevel, 1u) : 1u;
+
+		// The compressed formats are laid out in rows of 4x4 blocks.
+		const UINT64 rowElements = blockCompressed ? (width + 3u) / 4u : width;
+		const UINT rowCount = blockCompressed ? (height + 3u) / 4u : height;
+		const UINT64 rowSize = rowElements * elementSize;
+		const UINT64 rowPitch = Align(rowSize, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+
+		offset = Align(offset, buffer ? 1u : D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+		if (pLayouts)
+			pLayouts[index] = D3D12_PLACED_SUBRESOURCE_FOOTPRINT{
+				.Offset = offset,
+				.Footprint = {
+					.Format = desc.Format,
+					.Width = static_cast<UINT>(width),
+					.Height = height,
+					.Depth = depth,
+					.RowPitch = static_cast<UINT>(rowPitch)
+				}
+			};
+
+		if (pNumRows)
+			pNumRows[index] = rowCount;
+
+		if (pRowSizeInBytes)
+			pRowSizeInBytes[index] = rowSize;
+
+		// The last row of a subresource isn't padded.
+		const UINT64 subresourceSize = rowPitch * (UINT64{ rowCount } * depth - 1u) + rowSize;
+
+		totalBytes = offset + subresourceSize - BaseOffset;
+		offset += subresourceSize;
+	}
+
+	if (pTotalBytes)
+		*pTotalBytes = totalBytes;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateQueryHeap(
+	[[maybe_unused]] const D3D12_QUERY_HEAP_DESC* pDesc, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppvHeap
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::SetStablePowerState([[maybe_unused]] BOOL Enable) {
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommandSignature(
+	const D3D12_COMMAND_SIGNATURE_DESC* pDesc,
+	[[maybe_unused]] ID3D12RootSignature* pRootSignature, REFIID riid,
+	void** ppvCommandSignature
+) {
+	if (!pDesc)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(new HeadlessCommandSignature{ this }, riid, ppvCommandSignature);
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::GetResourceTiling(
+	[[maybe_unused]] ID3D12Resource* pTiledResource, UINT* pNumTilesForEntireResource,
+	[[maybe_unused]] D3D12_PACKED_MIP_INFO* pPackedMipDesc,
+	[[maybe_unused]] D3D12_TILE_SHAPE* pStandardTileShapeForNonPackedMips,
+	UINT* pNumSubresourceTilings, [[maybe_unused]] UINT FirstSubresourceTilingToGet,
+	[[maybe_unused]] D3D12_SUBRESOURCE_TILING* pSubresourceTilingsForNonPackedMips
+) {
+	// There are no reserved resources.
+	if (pNumTilesForEntireResource)
+		*pNumTilesForEntireResource = 0u;
+
+	if (pNumSubresourceTilings)
+		*pNumSubresourceTilings = 0u;
+}
+
+LUID STDMETHODCALLTYPE HeadlessDevice::GetAdapterLuid() {
+	return LUID{ .LowPart = 0u, .HighPart = 0 };
+}
+
+// ID3D12Device1
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreatePipelineLibrary(
+	[[maybe_unused]] const void* pLibraryBlob, [[maybe_unused]] SIZE_T BlobLength,
+	[[maybe_unused]] REFIID riid, [[maybe_unused]] void** ppPipelineLibrary
+) {
+	// As on a driver without library support, the pipelines are then created one by one.
+	return DXGI_ERROR_UNSUPPORTED;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::SetEventOnMultipleFenceCompletion(
+	[[maybe_unused]] ID3D12Fence* const* ppFences, [[maybe_unused]] const UINT64* pFenceValues,
+	[[maybe_unused]] UINT NumFences, [[maybe_unused]] D3D12_MULTIPLE_FENCE_WAIT_FLAGS Flags,
+	[[maybe_unused]] HANDLE hEvent
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::SetResidencyPriority(
+	[[maybe_unused]] UINT NumObjects, [[maybe_unused]] ID3D12Pageable* const* ppObjects,
+	[[maybe_unused]] const D3D12_RESIDENCY_PRIORITY* pPriorities
+) {
+	return S_OK;
+}
+
+// ID3D12Device2
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreatePipelineState(
+	const D3D12_PIPELINE_STATE_STREAM_DESC* pDesc, REFIID riid, void** ppPipelineState
+) {
+	if (!pDesc || !pDesc->pPipelineStateSubobjectStream)
+		return E_INVALIDARG;
+
+	return QueryHeadlessObject(new HeadlessPipelineState{ this }, riid, ppPipelineState);
+}
+
+// ID3D12Device3
+HRESULT STDMETHODCALLTYPE HeadlessDevice::OpenExistingHeapFromAddress(
+	[[maybe_unused]] const void* pAddress, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppvHeap
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::OpenExistingHeapFromFileMapping(
+	[[maybe_unused]] HANDLE hFileMapping, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppvHeap
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::EnqueueMakeResident(
+	[[maybe_unused]] D3D12_RESIDENCY_FLAGS Flags, [[maybe_unused]] UINT NumObjects,
+	[[maybe_unused]] ID3D12Pageable* const* ppObjects, ID3D12Fence* pFenceToSignal,
+	UINT64 FenceValueToSignal
+) {
+	if (!pFenceToSignal)
+		return E_INVALIDARG;
+
+	return pFenceToSignal->Signal(FenceValueToSignal);
+}
+
+// ID3D12Device4
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommandList1(
+	[[maybe_unused]] UINT nodeMask, D3D12_COMMAND_LIST_TYPE type,
+	[[maybe_unused]] D3D12_COMMAND_LIST_FLAGS flags, REFIID riid, void** ppCommandList
+) {
+	return QueryHeadlessObject(
+		new RecordingCommandList{ nullptr, nullptr, type }, riid, ppCommandList
+	);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateProtectedResourceSession(
+	[[maybe_unused]] const D3D12_PROTECTED_RESOURCE_SESSION_DESC* pDesc,
+	[[maybe_unused]] REFIID riid, [[maybe_unused]] void** ppSession
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateCommittedResource1(
+	const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags,
+	const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState,
+	const D3D12_CLEAR_VALUE* pOptimizedClearValue,
+	ID3D12ProtectedResourceSession* pProtectedSession, REFIID riidResource, void** ppvResource
+) {
+	if (pProtectedSession)
+		return E_NOTIMPL;
+
+	return CreateCommittedResource(
+		pHeapProperties, HeapFlags, pDesc, InitialResourceState, pOptimizedClearValue,
+		riidResource, ppvResource
+	);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateHeap1(
+	const D3D12_HEAP_DESC* pDesc, ID3D12ProtectedResourceSession* pProtectedSession,
+	REFIID riid, void** ppvHeap
+) {
+	if (pProtectedSession)
+		return E_NOTIMPL;
+
+	return CreateHeap(pDesc, riid, ppvHeap);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateReservedResource1(
+	[[maybe_unused]] const D3D12_RESOURCE_DESC* pDesc,
+	[[maybe_unused]] D3D12_RESOURCE_STATES InitialState,
+	[[maybe_unused]] const D3D12_CLEAR_VALUE* pOptimizedClearValue,
+	[[maybe_unused]] ID3D12ProtectedResourceSession* pProtectedSession,
+	[[maybe_unused]] REFIID riid, [[maybe_unused]] void** ppvResource
+) {
+	return E_NOTIMPL;
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE HeadlessDevice::GetResourceAllocationInfo1(
+	UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs,
+	D3D12_RESOURCE_ALLOCATION_INFO1* pResourceAllocationInfo1
+) {
+	if (pResourceAllocationInfo1) {
+		UINT64 offset = 0u;
+
+		for (UINT index = 0u; index < numResourceDescs; ++index) {
+			const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = GetResourceAllocationInfo(
+				visibleMask, 1u, pResourceDescs + index
+			);
+
+			offset = Align(offset, allocationInfo.Alignment);
+
+			pResourceAllocationInfo1[index] = D3D12_RESOURCE_ALLOCATION_INFO1{
+				.Offset = offset,
+				.Alignment = allocationInfo.Alignment,
+				.SizeInBytes = allocationInfo.SizeInBytes
+			};
+
+			offset += allocationInfo.SizeInBytes;
+		}
+	}
+
+	return GetResourceAllocationInfo(visibleMask, numResourceDescs, pResourceDescs);
+}
+
+// ID3D12Device5
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateLifetimeTracker(
+	[[maybe_unused]] ID3D12LifetimeOwner* pOwner, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppvTracker
+) {
+	return E_NOTIMPL;
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::RemoveDevice() {}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::EnumerateMetaCommands(
+	UINT* pNumMetaCommands, [[maybe_unused]] D3D12_META_COMMAND_DESC* pDescs
+) {
+	if (!pNumMetaCommands)
+		return E_INVALIDARG;
+
+	*pNumMetaCommands = 0u;
+
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::EnumerateMetaCommandParameters(
+	[[maybe_unused]] REFGUID CommandId, [[maybe_unused]] D3D12_META_COMMAND_PARAMETER_STAGE Stage,
+	[[maybe_unused]] UINT* pTotalStructureSizeInBytes, [[maybe_unused]] UINT* pParameterCount,
+	[[maybe_unused]] D3D12_META_COMMAND_PARAMETER_DESC* pParameterDescs
+) {
+	return E_INVALIDARG;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateMetaCommand(
+	[[maybe_unused]] REFGUID CommandId, [[maybe_unused]] UINT NodeMask,
+	[[maybe_unused]] const void* pCreationParametersData,
+	[[maybe_unused]] SIZE_T CreationParametersDataSizeInBytes, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppMetaCommand
+) {
+	return E_INVALIDARG;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessDevice::CreateStateObject(
+	[[maybe_unused]] const D3D12_STATE_OBJECT_DESC* pDesc, [[maybe_unused]] REFIID riid,
+	[[maybe_unused]] void** ppStateObject
+) {
+	return E_NOTIMPL;
+}
+
+void STDMETHODCALLTYPE HeadlessDevice::GetRaytracingAccelerationStructurePrebuildInfo(
+	[[maybe_unused]] const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS* pDesc,
+	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO* pInfo
+) {
+	if (pInfo)
+		*pInfo = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO{};
+}
+
+D3D12_DRIVER_MATCHING_IDENTIFIER_STATUS STDMETHODCALLTYPE
+HeadlessDevice::CheckDriverMatchingIdentifier(
+	[[maybe_unused]] D3D12_SERIALIZED_DATA_TYPE SerializedDataType,
+	[[maybe_unused]] const D3D12_SERIALIZED_DATA_DRIVER_MATCHING_IDENTIFIER* pIdentifierToCheck
+) {
+	return D3D12_DRIVER_MATCHING_IDENTIFIER_UNSUPPORTED_TYPE;
+}
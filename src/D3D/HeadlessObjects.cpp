@@ -0,0 +1,318 @@
+#include <HeadlessObjects.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// HeadlessPrivateData
+HRESULT HeadlessPrivateData::Get(REFGUID guid, UINT* pDataSize, void* pData) {
+	if (!pDataSize)
+		return E_INVALIDARG;
+
+	std::lock_guard lock{ m_dataMutex };
+
+	auto entry = std::ranges::find(m_entries, guid, &Entry::guid);
+
+	if (entry == std::end(m_entries)) {
+		*pDataSize = 0u;
+
+		return DXGI_ERROR_NOT_FOUND;
+	}
+
+	const auto dataSize = static_cast<UINT>(std::size(entry->data));
+
+	if (pData) {
+		if (*pDataSize < dataSize) {
+			*pDataSize = dataSize;
+
+			return DXGI_ERROR_MORE_DATA;
+		}
+
+		std::memcpy(pData, std::data(entry->data), dataSize);
+	}
+
+	*pDataSize = dataSize;
+
+	return S_OK;
+}
+
+HRESULT HeadlessPrivateData::Set(REFGUID guid, UINT dataSize, const void* pData) {
+	std::lock_guard lock{ m_dataMutex };
+
+	std::erase_if(m_entries, [&guid](const Entry& entry) { return entry.guid == guid; });
+
+	// No data removes the entry.
+	if (pData && dataSize != 0u) {
+		auto bytes = static_cast<const std::uint8_t*>(pData);
+
+		m_entries.emplace_back(
+			Entry{ .guid = guid, .data = std::vector<std::uint8_t>{ bytes, bytes + dataSize } }
+		);
+	}
+
+	return S_OK;
+}
+
+// HeadlessHeap
+HeadlessHeap::HeadlessHeap(
+	ID3D12Device* device, const D3D12_HEAP_DESC& desc, D3D12_GPU_VIRTUAL_ADDRESS address
+) : HeadlessDeviceChild{ device }, m_desc{ desc }, m_address{ address } {
+	const D3D12_HEAP_PROPERTIES& properties = desc.Properties;
+
+	const bool cpuVisible = properties.Type == D3D12_HEAP_TYPE_UPLOAD
+		|| properties.Type == D3D12_HEAP_TYPE_READBACK
+		|| (properties.Type == D3D12_HEAP_TYPE_CUSTOM
+			&& properties.CPUPageProperty != D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE);
+
+	if (cpuVisible)
+		m_memory = std::make_unique<std::uint8_t[]>(static_cast<size_t>(desc.SizeInBytes));
+}
+
+std::uint8_t* HeadlessHeap::GetMemory() const noexcept {
+	return m_memory.get();
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS HeadlessHeap::GetAddress() const noexcept {
+	return m_address;
+}
+
+D3D12_HEAP_DESC STDMETHODCALLTYPE HeadlessHeap::GetDesc() {
+	return m_desc;
+}
+
+// HeadlessResource
+HeadlessResource::HeadlessResource(
+	ID3D12Device* device, HeadlessHeap* heap, UINT64 heapOffset, const D3D12_RESOURCE_DESC& desc
+) noexcept : HeadlessDeviceChild{ device }, m_pHeap{ heap }, m_heapOffset{ heapOffset },
+	m_desc{ desc } {}
+
+HRESULT STDMETHODCALLTYPE HeadlessResource::Map(
+	[[maybe_unused]] UINT Subresource, [[maybe_unused]] const D3D12_RANGE* pReadRange,
+	void** ppData
+) {
+	std::uint8_t* memory = m_pHeap->GetMemory();
+
+	if (!memory)
+		return E_INVALIDARG;
+
+	if (ppData)
+		*ppData = memory + m_heapOffset;
+
+	return S_OK;
+}
+
+void STDMETHODCALLTYPE HeadlessResource::Unmap(
+	[[maybe_unused]] UINT Subresource, [[maybe_unused]] const D3D12_RANGE* pWrittenRange
+) {}
+
+D3D12_RESOURCE_DESC STDMETHODCALLTYPE HeadlessResource::GetDesc() {
+	return m_desc;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE HeadlessResource::GetGPUVirtualAddress() {
+	// Like on a device, only the buffers have one.
+	if (m_desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+		return 0u;
+
+	return m_pHeap->GetAddress() + m_heapOffset;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessResource::WriteToSubresource(
+	[[maybe_unused]] UINT DstSubresource, [[maybe_unused]] const D3D12_BOX* pDstBox,
+	[[maybe_unused]] const void* pSrcData, [[maybe_unused]] UINT SrcRowPitch,
+	[[maybe_unused]] UINT SrcDepthPitch
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessResource::ReadFromSubresource(
+	[[maybe_unused]] void* pDstData, [[maybe_unused]] UINT DstRowPitch,
+	[[maybe_unused]] UINT DstDepthPitch, [[maybe_unused]] UINT SrcSubresource,
+	[[maybe_unused]] const D3D12_BOX* pSrcBox
+) {
+	return E_NOTIMPL;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessResource::GetHeapProperties(
+	D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags
+) {
+	const D3D12_HEAP_DESC heapDesc = m_pHeap->GetDesc();
+
+	if (pHeapProperties)
+		*pHeapProperties = heapDesc.Properties;
+
+	if (pHeapFlags)
+		*pHeapFlags = heapDesc.Flags;
+
+	return S_OK;
+}
+
+// HeadlessDescriptorHeap
+HeadlessDescriptorHeap::HeadlessDescriptorHeap(
+	ID3D12Device* device, const D3D12_DESCRIPTOR_HEAP_DESC& desc,
+	D3D12_GPU_VIRTUAL_ADDRESS address
+) : HeadlessDeviceChild{ device }, m_desc{ desc }, m_address{ address },
+	m_descriptors(desc.NumDescriptors) {}
+
+D3D12_DESCRIPTOR_HEAP_DESC STDMETHODCALLTYPE HeadlessDescriptorHeap::GetDesc() {
+	return m_desc;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE
+HeadlessDescriptorHeap::GetCPUDescriptorHandleForHeapStart() {
+	return { .ptr = reinterpret_cast<SIZE_T>(std::data(m_descriptors)) };
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE
+HeadlessDescriptorHeap::GetGPUDescriptorHandleForHeapStart() {
+	if (!(m_desc.Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE))
+		return { .ptr = 0u };
+
+	return { .ptr = m_address };
+}
+
+// HeadlessFence
+HeadlessFence::HeadlessFence(ID3D12Device* device, UINT64 initialValue) noexcept
+	: HeadlessDeviceChild{ device }, m_completedValue{ initialValue } {}
+
+UINT64 STDMETHODCALLTYPE HeadlessFence::GetCompletedValue() {
+	std::lock_guard lock{ m_fenceMutex };
+
+	return m_completedValue;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessFence::SetEventOnCompletion(UINT64 Value, HANDLE hEvent) {
+	std::lock_guard lock{ m_fenceMutex };
+
+	// Without an event the call blocks until the value is reached, which nothing would signal
+	// while it holds the lock.
+	if (!hEvent)
+		return m_completedValue >= Value ? S_OK : E_FAIL;
+
+	if (m_completedValue >= Value)
+		SetEvent(hEvent);
+	else
+		m_pendingEvents.emplace_back(PendingEvent{ .value = Value, .event = hEvent });
+
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessFence::Signal(UINT64 Value) {
+	std::lock_guard lock{ m_fenceMutex };
+
+	// The value can go back, as it does on a device.
+	m_completedValue = Value;
+
+	std::erase_if(
+		m_pendingEvents,
+		[Value](const PendingEvent& pendingEvent) {
+			if (pendingEvent.value > Value)
+				return false;
+
+			SetEvent(pendingEvent.event);
+
+			return true;
+		}
+	);
+
+	return S_OK;
+}
+
+// HeadlessCommandAllocator
+HRESULT STDMETHODCALLTYPE HeadlessCommandAllocator::Reset() {
+	return S_OK;
+}
+
+// HeadlessCommandQueue
+HeadlessCommandQueue::HeadlessCommandQueue(
+	ID3D12Device* device, const D3D12_COMMAND_QUEUE_DESC& desc
+) noexcept : HeadlessDeviceChild{ device }, m_desc{ desc } {}
+
+void STDMETHODCALLTYPE HeadlessCommandQueue::UpdateTileMappings(
+	[[maybe_unused]] ID3D12Resource* pResource, [[maybe_unused]] UINT NumResourceRegions,
+	[[maybe_unused]] const D3D12_TILED_RESOURCE_COORDINATE* pResourceRegionStartCoordinates,
+	[[maybe_unused]] const D3D12_TILE_REGION_SIZE* pResourceRegionSizes,
+	[[maybe_unused]] ID3D12Heap* pHeap, [[maybe_unused]] UINT NumRanges,
+	[[maybe_unused]] const D3D12_TILE_RANGE_FLAGS* pRangeFlags,
+	[[maybe_unused]] const UINT* pHeapRangeStartOffsets,
+	[[maybe_unused]] const UINT* pRangeTileCounts, [[maybe_unused]] D3D12_TILE_MAPPING_FLAGS Flags
+) {}
+
+void STDMETHODCALLTYPE HeadlessCommandQueue::CopyTileMappings(
+	[[maybe_unused]] ID3D12Resource* pDstResource,
+	[[maybe_unused]] const D3D12_TILED_RESOURCE_COORDINATE* pDstRegionStartCoordinate,
+	[[maybe_unused]] ID3D12Resource* pSrcResource,
+	[[maybe_unused]] const D3D12_TILED_RESOURCE_COORDINATE* pSrcRegionStartCoordinate,
+	[[maybe_unused]] const D3D12_TILE_REGION_SIZE* pRegionSize,
+	[[maybe_unused]] D3D12_TILE_MAPPING_FLAGS Flags
+) {}
+
+void STDMETHODCALLTYPE HeadlessCommandQueue::ExecuteCommandLists(
+	[[maybe_unused]] UINT NumCommandLists,
+	[[maybe_unused]] ID3D12CommandList* const* ppCommandLists
+) {}
+
+void STDMETHODCALLTYPE HeadlessCommandQueue::SetMarker(
+	[[maybe_unused]] UINT Metadata, [[maybe_unused]] const void* pData,
+	[[maybe_unused]] UINT Size
+) {}
+
+void STDMETHODCALLTYPE HeadlessCommandQueue::BeginEvent(
+	[[maybe_unused]] UINT Metadata, [[maybe_unused]] const void* pData,
+	[[maybe_unused]] UINT Size
+) {}
+
+void STDMETHODCALLTYPE HeadlessCommandQueue::EndEvent() {}
+
+HRESULT STDMETHODCALLTYPE HeadlessCommandQueue::Signal(ID3D12Fence* pFence, UINT64 Value) {
+	if (!pFence)
+		return E_INVALIDARG;
+
+	return pFence->Signal(Value);
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessCommandQueue::Wait(
+	[[maybe_unused]] ID3D12Fence* pFence, [[maybe_unused]] UINT64 Value
+) {
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessCommandQueue::GetTimestampFrequency(UINT64* pFrequency) {
+	if (!pFrequency)
+		return E_INVALIDARG;
+
+	// The timestamps are nanoseconds.
+	*pFrequency = 1'000'000'000u;
+
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE HeadlessCommandQueue::GetClockCalibration(
+	UINT64* pGpuTimestamp, UINT64* pCpuTimestamp
+) {
+	if (!pGpuTimestamp || !pCpuTimestamp)
+		return E_INVALIDARG;
+
+	LARGE_INTEGER cpuTimestamp{};
+	QueryPerformanceCounter(&cpuTimestamp);
+
+	*pCpuTimestamp = static_cast<UINT64>(cpuTimestamp.QuadPart);
+	*pGpuTimestamp = static_cast<UINT64>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count()
+	);
+
+	return S_OK;
+}
+
+D3D12_COMMAND_QUEUE_DESC STDMETHODCALLTYPE HeadlessCommandQueue::GetDesc() {
+	return m_desc;
+}
+
+// HeadlessPipelineState
+HRESULT STDMETHODCALLTYPE HeadlessPipelineState::GetCachedBlob(ID3DBlob** ppBlob) {
+	if (ppBlob)
+		*ppBlob = nullptr;
+
+	return E_NOTIMPL;
+}
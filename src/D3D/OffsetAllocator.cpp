@@ -0,0 +1,390 @@
+#include <OffsetAllocator.hpp>
+#include <algorithm>
+#include <bit>
+#include <SizeHelpers.hpp>
+
+OffsetAllocator::OffsetAllocator(size_t capacity) noexcept
+	: m_freeLists{}, m_secondLevelBitmaps{}, m_firstLevelBitmap{ 0u },
+	m_lastBlock{ s_nullBlock }, m_capacity{ 0u }, m_usedSize{ 0u }, m_freeBlockCount{ 0u },
+	m_allocationCount{ 0u } {
+
+	m_freeLists.fill(s_nullBlock);
+
+	Grow(capacity);
+}
+
+OffsetAllocator::BinIndex OffsetAllocator::GetBinIndex(size_t size) noexcept {
+	// Sizes below the second level count get a bin each.
+	if (size < s_secondLevelCount)
+		return BinIndex{ .firstLevel = 0u, .secondLevel = static_cast<std::uint32_t>(size) };
+
+	const auto highestBit = static_cast<std::uint32_t>(std::bit_width(size) - 1u);
+
+	return BinIndex{
+		.firstLevel = highestBit - s_secondLevelBits + 1u,
+		.secondLevel = static_cast<std::uint32_t>(
+			(size >> (highestBit - s_secondLevelBits)) - s_secondLevelCount
+		)
+	};
+}
+
+std::uint32_t OffsetAllocator::GetListIndex(const BinIndex& binIndex) noexcept {
+	return binIndex.firstLevel * s_secondLevelCount + binIndex.secondLevel;
+}
+
+std::uint32_t OffsetAllocator::CreateBlock(size_t offset, size_t size) noexcept {
+	const Block block{
+		.offset = offset,
+		.size = size,
+		.previousPhysical = s_nullBlock,
+		.nextPhysical = s_nullBlock,
+		.previousFree = s_nullBlock,
+		.nextFree = s_nullBlock,
+		.free = false
+	};
+
+	if (!std::empty(m_unusedBlocks)) {
+		const std::uint32_t blockIndex = m_unusedBlocks.back();
+		m_unusedBlocks.pop_back();
+
+		m_blocks[blockIndex] = block;
+
+		return blockIndex;
+	}
+
+	const auto blockIndex = static_cast<std::uint32_t>(std::size(m_blocks));
+	m_blocks.emplace_back(block);
+
+	return blockIndex;
+}
+
+void OffsetAllocator::ReleaseBlock(std::uint32_t blockIndex) noexcept {
+	m_unusedBlocks.emplace_back(blockIndex);
+}
+
+void OffsetAllocator::InsertFreeBlock(std::uint32_t blockIndex) noexcept {
+	Block& block = m_blocks[blockIndex];
+	const BinIndex binIndex = GetBinIndex(block.size);
+	const std::uint32_t listIndex = GetListIndex(binIndex);
+
+	const std::uint32_t headIndex = m_freeLists[listIndex];
+
+	block.free = true;
+	block.previousFree = s_nullBlock;
+	block.nextFree = headIndex;
+
+	if (headIndex != s_nullBlock)
+		m_blocks[headIndex].previousFree = blockIndex;
+
+	m_freeLists[listIndex] = blockIndex;
+	m_secondLevelBitmaps[binIndex.firstLevel] |= 1u << binIndex.secondLevel;
+	m_firstLevelBitmap |= 1ull << binIndex.firstLevel;
+
+	++m_freeBlockCount;
+}
+
+void OffsetAllocator::RemoveFreeBlock(std::uint32_t blockIndex) noexcept {
+	Block& block = m_blocks[blockIndex];
+
+	if (block.previousFree != s_nullBlock)
+		m_blocks[block.previousFree].nextFree = block.nextFree;
+	else {
+		const BinIndex binIndex = GetBinIndex(block.size);
+		const std::uint32_t listIndex = GetListIndex(binIndex);
+
+		m_freeLists[listIndex] = block.nextFree;
+
+		if (block.nextFree == s_nullBlock) {
+			m_secondLevelBitmaps[binIndex.firstLevel] &= ~(1u << binIndex.secondLevel);
+
+			if (!m_secondLevelBitmaps[binIndex.firstLevel])
+				m_firstLevelBitmap &= ~(1ull << binIndex.firstLevel);
+		}
+	}
+
+	if (block.nextFree != s_nullBlock)
+		m_blocks[block.nextFree].previousFree = block.previousFree;
+
+	block.free = false;
+	block.previousFree = s_nullBlock;
+	block.nextFree = s_nullBlock;
+
+	--m_freeBlockCount;
+}
+
+size_t OffsetAllocator::RoundUpToBin(size_t size) noexcept {
+	if (size < s_secondLevelCount)
+		return size;
+
+	const auto highestBit = static_cast<std::uint32_t>(std::bit_width(size) - 1u);
+
+	return size + (size_t{ 1u } << (highestBit - s_secondLevelBits)) - 1u;
+}
+
+std::uint32_t OffsetAllocator::FindFreeBlock(size_t size) const noexcept {
+	// Rounding the size up to the next bin means any block in the found bin is large enough.
+	const BinIndex binIndex = GetBinIndex(RoundUpToBin(size));
+
+	if (binIndex.firstLevel >= s_firstLevelCount)
+		return s_nullBlock;
+
+	std::uint32_t firstLevel = binIndex.firstLevel;
+	std::uint32_t secondLevelMap =
+		m_secondLevelBitmaps[firstLevel] & (~0u << binIndex.secondLevel);
+
+	if (!secondLevelMap) {
+		const std::uint64_t firstLevelMap = firstLevel + 1u < 64u ?
+			m_firstLevelBitmap & (~0ull << (firstLevel + 1u)) : 0u;
+
+		if (!firstLevelMap)
+			return s_nullBlock;
+
+		firstLevel = static_cast<std::uint32_t>(std::countr_zero(firstLevelMap));
+		secondLevelMap = m_secondLevelBitmaps[firstLevel];
+	}
+
+	const auto secondLevel = static_cast<std::uint32_t>(std::countr_zero(secondLevelMap));
+
+	return m_freeLists[GetListIndex(
+		BinIndex{ .firstLevel = firstLevel, .secondLevel = secondLevel }
+	)];
+}
+
+std::uint32_t OffsetAllocator::FindFittingBlock(size_t size, size_t alignment) const noexcept {
+	const BinIndex binIndex = GetBinIndex(size);
+
+	if (binIndex.firstLevel >= s_firstLevelCount)
+		return s_nullBlock;
+
+	// The good fit searches only failed if the bins from the one of the rounded up worst case
+	// are empty, so the bins below it are left. Only the head of each list is checked.
+	const BinIndex endBinIndex = GetBinIndex(RoundUpToBin(size + alignment - 1u));
+	const std::uint32_t endListIndex = endBinIndex.firstLevel < s_firstLevelCount ?
+		GetListIndex(endBinIndex) : s_firstLevelCount * s_secondLevelCount;
+
+	for (std::uint32_t listIndex = GetListIndex(binIndex); listIndex < endListIndex;
+		++listIndex)
+		if (const std::uint32_t blockIndex = m_freeLists[listIndex];
+			blockIndex != s_nullBlock && DoesBlockFit(blockIndex, size, alignment))
+			return blockIndex;
+
+	return s_nullBlock;
+}
+
+bool OffsetAllocator::DoesBlockFit(
+	std::uint32_t blockIndex, size_t size, size_t alignment
+) const noexcept {
+	const Block& block = m_blocks[blockIndex];
+
+	return Align(block.offset, alignment) - block.offset + size <= block.size;
+}
+
+OffsetAllocator::Allocation OffsetAllocator::AllocateFromBlock(
+	std::uint32_t blockIndex, size_t size, size_t alignment
+) noexcept {
+	RemoveFreeBlock(blockIndex);
+
+	const size_t blockOffset = m_blocks[blockIndex].offset;
+	const size_t alignedOffset = Align(blockOffset, alignment);
+
+	// Neither of the physical neighbours of a free block can be free, so the split off parts
+	// don't need to be merged.
+	if (const size_t padding = alignedOffset - blockOffset; padding) {
+		const std::uint32_t paddingIndex = CreateBlock(blockOffset, padding);
+		Block& block = m_blocks[blockIndex];
+		Block& paddingBlock = m_blocks[paddingIndex];
+
+		paddingBlock.previousPhysical = block.previousPhysical;
+		paddingBlock.nextPhysical = blockIndex;
+
+		if (block.previousPhysical != s_nullBlock)
+			m_blocks[block.previousPhysical].nextPhysical = paddingIndex;
+
+		block.previousPhysical = paddingIndex;
+		block.offset = alignedOffset;
+		block.size -= padding;
+
+		InsertFreeBlock(paddingIndex);
+	}
+
+	if (const size_t remainder = m_blocks[blockIndex].size - size; remainder) {
+		const std::uint32_t remainderIndex = CreateBlock(alignedOffset + size, remainder);
+		Block& block = m_blocks[blockIndex];
+		Block& remainderBlock = m_blocks[remainderIndex];
+
+		remainderBlock.previousPhysical = blockIndex;
+		remainderBlock.nextPhysical = block.nextPhysical;
+
+		if (block.nextPhysical != s_nullBlock)
+			m_blocks[block.nextPhysical].previousPhysical = remainderIndex;
+		else
+			m_lastBlock = remainderIndex;
+
+		block.nextPhysical = remainderIndex;
+		block.size = size;
+
+		InsertFreeBlock(remainderIndex);
+	}
+
+	m_usedSize += size;
+	++m_allocationCount;
+
+	return Allocation{ .offset = alignedOffset, .handle = blockIndex };
+}
+
+std::optional<OffsetAllocator::Allocation> OffsetAllocator::Allocate(
+	size_t size, size_t alignment
+) noexcept {
+	size = std::max(size, size_t{ 1u });
+	alignment = std::max(alignment, size_t{ 1u });
+
+	// The good fit search only rounds the size up, the padding of the block it finds is checked
+	// afterwards. Failing that, the worst case padding is searched for.
+	std::uint32_t blockIndex = FindFreeBlock(size);
+
+	if (blockIndex != s_nullBlock && !DoesBlockFit(blockIndex, size, alignment))
+		blockIndex = FindFreeBlock(size + alignment - 1u);
+
+	// Rounding up skips the bins the size falls into, an exact fit can still be in them.
+	if (blockIndex == s_nullBlock)
+		blockIndex = FindFittingBlock(size, alignment);
+
+	if (blockIndex == s_nullBlock)
+		return {};
+
+	return AllocateFromBlock(blockIndex, size, alignment);
+}
+
+OffsetAllocator::Allocation OffsetAllocator::AllocateAndGrow(
+	size_t size, size_t alignment
+) noexcept {
+	if (auto allocation = Allocate(size, alignment); allocation)
+		return *allocation;
+
+	size = std::max(size, size_t{ 1u });
+	alignment = std::max(alignment, size_t{ 1u });
+
+	// Extends the last block just enough to fit, the same as bumping an offset would.
+	const bool isLastBlockFree = m_lastBlock != s_nullBlock && m_blocks[m_lastBlock].free;
+	const size_t tailOffset = isLastBlockFree ? m_blocks[m_lastBlock].offset : m_capacity;
+
+	Grow(Align(tailOffset, alignment) + size);
+
+	return AllocateFromBlock(m_lastBlock, size, alignment);
+}
+
+void OffsetAllocator::Free(std::uint32_t handle) noexcept {
+	std::uint32_t blockIndex = handle;
+
+	m_usedSize -= m_blocks[blockIndex].size;
+	--m_allocationCount;
+
+	if (const std::uint32_t previousIndex = m_blocks[blockIndex].previousPhysical;
+		previousIndex != s_nullBlock && m_blocks[previousIndex].free) {
+		RemoveFreeBlock(previousIndex);
+
+		Block& previousBlock = m_blocks[previousIndex];
+		const Block& block = m_blocks[blockIndex];
+
+		previousBlock.size += block.size;
+		previousBlock.nextPhysical = block.nextPhysical;
+
+		if (block.nextPhysical != s_nullBlock)
+			m_blocks[block.nextPhysical].previousPhysical = previousIndex;
+		else
+			m_lastBlock = previousIndex;
+
+		ReleaseBlock(blockIndex);
+		blockIndex = previousIndex;
+	}
+
+	if (const std::uint32_t nextIndex = m_blocks[blockIndex].nextPhysical;
+		nextIndex != s_nullBlock && m_blocks[nextIndex].free) {
+		RemoveFreeBlock(nextIndex);
+
+		Block& block = m_blocks[blockIndex];
+		const Block& nextBlock = m_blocks[nextIndex];
+
+		block.size += nextBlock.size;
+		block.nextPhysical = nextBlock.nextPhysical;
+
+		if (nextBlock.nextPhysical != s_nullBlock)
+			m_blocks[nextBlock.nextPhysical].previousPhysical = blockIndex;
+		else
+			m_lastBlock = blockIndex;
+
+		ReleaseBlock(nextIndex);
+	}
+
+	InsertFreeBlock(blockIndex);
+}
+
+void OffsetAllocator::Grow(size_t capacity) noexcept {
+	if (capacity <= m_capacity)
+		return;
+
+	const size_t growth = capacity - m_capacity;
+
+	if (m_lastBlock != s_nullBlock && m_blocks[m_lastBlock].free) {
+		RemoveFreeBlock(m_lastBlock);
+		m_blocks[m_lastBlock].size += growth;
+		InsertFreeBlock(m_lastBlock);
+	}
+	else {
+		const std::uint32_t blockIndex = CreateBlock(m_capacity, growth);
+
+		m_blocks[blockIndex].previousPhysical = m_lastBlock;
+
+		if (m_lastBlock != s_nullBlock)
+			m_blocks[m_lastBlock].nextPhysical = blockIndex;
+
+		m_lastBlock = blockIndex;
+
+		InsertFreeBlock(blockIndex);
+	}
+
+	m_capacity = capacity;
+}
+
+void OffsetAllocator::AddSpareSpace(size_t size, size_t alignment) noexcept {
+	Grow(Align(m_capacity, std::max(alignment, size_t{ 1u })) + size);
+}
+
+size_t OffsetAllocator::GetCapacity() const noexcept {
+	return m_capacity;
+}
+
+OffsetAllocator::Stats OffsetAllocator::GetStats() const noexcept {
+	size_t largestFreeBlock = 0u;
+
+	// Only the highest non empty bin needs to be searched.
+	if (m_firstLevelBitmap) {
+		const auto firstLevel = static_cast<std::uint32_t>(std::bit_width(m_firstLevelBitmap) - 1u);
+		const auto secondLevel = static_cast<std::uint32_t>(
+			std::bit_width(m_secondLevelBitmaps[firstLevel]) - 1u
+		);
+
+		for (std::uint32_t blockIndex = m_freeLists[GetListIndex(
+				BinIndex{ .firstLevel = firstLevel, .secondLevel = secondLevel }
+			)]; blockIndex != s_nullBlock; blockIndex = m_blocks[blockIndex].nextFree)
+			largestFreeBlock = std::max(largestFreeBlock, m_blocks[blockIndex].size);
+	}
+
+	return Stats{
+		.capacity = m_capacity,
+		.usedSize = m_usedSize,
+		.freeSize = m_capacity - m_usedSize,
+		.largestFreeBlock = largestFreeBlock,
+		.freeBlockCount = m_freeBlockCount,
+		.allocationCount = m_allocationCount
+	};
+}
+
+float OffsetAllocator::GetFragmentation() const noexcept {
+	const Stats stats = GetStats();
+
+	if (!stats.freeSize)
+		return 0.f;
+
+	return 1.f - static_cast<float>(stats.largestFreeBlock) / static_cast<float>(stats.freeSize);
+}
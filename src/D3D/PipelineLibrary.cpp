@@ -0,0 +1,197 @@
+#include <PipelineLibrary.hpp>
+#include <PipelineHasher.hpp>
+#include <Exception.hpp>
+#include <algorithm>
+#include <chrono>
+
+PipelineLibrary::PipelineLibrary() noexcept
+	: m_deviceId{ 0u }, m_libraryChanged{ false }, m_stats{} {}
+
+void PipelineLibrary::SetCachePath(std::wstring cachePath) noexcept {
+	m_cachePath = std::move(cachePath);
+}
+
+void PipelineLibrary::ReadCacheFile(ID3D12Device1* device, IDXGIFactory4* factory) {
+	if (std::empty(m_cachePath))
+		return;
+
+	m_deviceId = GetDeviceId(device, factory);
+
+	PipelineCacheData cacheData{};
+
+	if (!PipelineCacheFile{ m_deviceId }.Read(m_cachePath, cacheData))
+		cacheData = PipelineCacheData{};
+
+	CreateLibrary(device, std::move(cacheData.library));
+
+	// The data was rejected by the runtime, so none of the keys are in the library.
+	if (std::empty(m_libraryData))
+		cacheData.pipelineKeys.clear();
+
+	m_libraryKeys = std::unordered_set<std::uint64_t>{
+		std::begin(cacheData.pipelineKeys), std::end(cacheData.pipelineKeys)
+	};
+	m_libraryChanged = false;
+}
+
+void PipelineLibrary::CreateLibrary(
+	ID3D12Device1* device, std::vector<std::uint8_t> libraryData
+) {
+	m_pLibrary.Reset();
+	m_libraryData = std::move(libraryData);
+
+	HRESULT hr = E_FAIL;
+
+	if (!std::empty(m_libraryData))
+		hr = device->CreatePipelineLibrary(
+			std::data(m_libraryData), std::size(m_libraryData), IID_PPV_ARGS(&m_pLibrary)
+		);
+
+	// A library from another driver fails here even if the device id didn't change.
+	if (FAILED(hr)) {
+		m_libraryData.clear();
+
+		hr = device->CreatePipelineLibrary(nullptr, 0u, IID_PPV_ARGS(&m_pLibrary));
+
+		// Without library support, as on the headless device, the pipelines aren't kept.
+		if (FAILED(hr) && hr != DXGI_ERROR_UNSUPPORTED)
+			throw Exception("PipelineLibrary Error", "The pipeline library couldn't be created.");
+	}
+}
+
+void PipelineLibrary::WriteCacheFile(ID3D12Device1* device) {
+	std::lock_guard<std::mutex> lock{ m_libraryMutex };
+
+	if (!m_pLibrary)
+		return;
+
+	const bool staleKeys = std::ranges::any_of(m_libraryKeys, [this](std::uint64_t key) {
+		return !m_pipelines.contains(key);
+	});
+
+	if (!m_libraryChanged && !staleKeys)
+		return;
+
+	// A library can't remove a pipeline, so a new one is made with the pipelines of this run.
+	if (staleKeys) {
+		CreateLibrary(device, {});
+
+		m_libraryKeys.clear();
+
+		for (const auto& [pipelineKey, pipelineState] : m_pipelines) {
+			const std::wstring pipelineName = GetPipelineName(pipelineKey);
+
+			if (SUCCEEDED(m_pLibrary->StorePipeline(pipelineName.c_str(), pipelineState.Get())))
+				m_libraryKeys.emplace(pipelineKey);
+		}
+	}
+
+	PipelineCacheData cacheData{
+		.pipelineKeys = { std::begin(m_libraryKeys), std::end(m_libraryKeys) },
+		.library = std::vector<std::uint8_t>(m_pLibrary->GetSerializedSize())
+	};
+
+	if (FAILED(m_pLibrary->Serialize(std::data(cacheData.library), std::size(cacheData.library))))
+		return;
+
+	// The cache only saves time, so the run goes on if the file can't be written.
+	if (PipelineCacheFile{ m_deviceId }.Write(m_cachePath, cacheData))
+		m_libraryChanged = false;
+}
+
+ComPtr<ID3D12PipelineState> PipelineLibrary::CreatePipelineState(
+	ID3D12Device2* device, const D3D12_PIPELINE_STATE_STREAM_DESC& streamDesc,
+	std::uint64_t pipelineKey
+) {
+	ComPtr<ID3D12PipelineState> pipelineState{};
+
+	const std::wstring pipelineName = GetPipelineName(pipelineKey);
+
+	{
+		// The library isn't safe to load the same pipeline from multiple threads.
+		std::lock_guard<std::mutex> lock{ m_libraryMutex };
+
+		auto pipeline = m_pipelines.find(pipelineKey);
+
+		if (pipeline != std::end(m_pipelines))
+			return pipeline->second;
+
+		if (m_pLibrary && m_libraryKeys.contains(pipelineKey)
+			&& SUCCEEDED(m_pLibrary->LoadPipeline(
+				pipelineName.c_str(), &streamDesc, IID_PPV_ARGS(&pipelineState)
+			))) {
+			++m_stats.libraryHits;
+
+			m_pipelines.emplace(pipelineKey, pipelineState);
+
+			return pipelineState;
+		}
+	}
+
+	// The compilation is the slow part, so the other threads can go on with theirs meanwhile.
+	const auto compileStart = std::chrono::steady_clock::now();
+
+	if (FAILED(device->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pipelineState))))
+		throw Exception("PipelineLibrary Error", "The pipeline state couldn't be created.");
+
+	const double compileSeconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - compileStart
+	).count();
+
+	std::lock_guard<std::mutex> lock{ m_libraryMutex };
+
+	m_stats.compileSeconds += compileSeconds;
+
+	// Another thread might have created the same one.
+	const auto [pipeline, newPipeline] = m_pipelines.try_emplace(pipelineKey, pipelineState);
+
+	if (!newPipeline)
+		return pipeline->second;
+
+	++m_stats.misses;
+
+	if (m_pLibrary && !m_libraryKeys.contains(pipelineKey)
+		&& SUCCEEDED(m_pLibrary->StorePipeline(pipelineName.c_str(), pipelineState.Get()))) {
+		m_libraryKeys.emplace(pipelineKey);
+		m_libraryChanged = true;
+	}
+
+	return pipelineState;
+}
+
+PipelineLibrary::CacheStats PipelineLibrary::GetCacheStats() const noexcept {
+	std::lock_guard<std::mutex> lock{ m_libraryMutex };
+
+	return m_stats;
+}
+
+std::uint64_t PipelineLibrary::GetDeviceId(
+	ID3D12Device1* device, IDXGIFactory4* factory
+) noexcept {
+	PipelineHasher hasher{};
+
+	ComPtr<IDXGIAdapter1> adapter{};
+
+	// The headless device has no adapter.
+	if (factory && SUCCEEDED(
+		factory->EnumAdapterByLuid(device->GetAdapterLuid(), IID_PPV_ARGS(&adapter))
+	)) {
+		DXGI_ADAPTER_DESC1 adapterDesc{};
+		adapter->GetDesc1(&adapterDesc);
+
+		hasher.AddValue(adapterDesc.VendorId).AddValue(adapterDesc.DeviceId)
+			.AddValue(adapterDesc.SubSysId).AddValue(adapterDesc.Revision);
+
+		// The user mode driver version.
+		LARGE_INTEGER driverVersion{};
+
+		if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+			hasher.AddValue(driverVersion.QuadPart);
+	}
+
+	return hasher.GetHash();
+}
+
+std::wstring PipelineLibrary::GetPipelineName(std::uint64_t pipelineKey) {
+	return std::to_wstring(pipelineKey);
+}
@@ -0,0 +1,823 @@
+#include <RecordingCommandList.hpp>
+#include <algorithm>
+
+RecordingCommandList::RecordingCommandList(
+	ID3D12GraphicsCommandList* commandList, ID3D12GraphicsCommandList6* commandList6,
+	D3D12_COMMAND_LIST_TYPE type
+) noexcept : m_referenceCount{ 1u }, m_pCommandList{ commandList },
+	m_pCommandList6{ commandList6 }, m_type{ type } {}
+
+void RecordingCommandList::Record(RecordedCommandType type, char const* name, UINT count) {
+	m_commands.emplace_back(RecordedCommand{ .type = type, .name = name, .count = count });
+}
+
+const std::vector<RecordedCommand>& RecordingCommandList::GetCommands() const noexcept {
+	return m_commands;
+}
+
+size_t RecordingCommandList::GetCommandCount(RecordedCommandType type) const noexcept {
+	return static_cast<size_t>(std::ranges::count(m_commands, type, &RecordedCommand::type));
+}
+
+// IUnknown
+HRESULT STDMETHODCALLTYPE RecordingCommandList::QueryInterface(REFIID riid, void** ppvObject) {
+	if (!ppvObject)
+		return E_POINTER;
+
+	if (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D12Object)
+		|| riid == __uuidof(ID3D12DeviceChild) || riid == __uuidof(ID3D12CommandList)
+		|| riid == __uuidof(ID3D12GraphicsCommandList)
+		|| ((m_pCommandList6 || !m_pCommandList)
+			&& riid == __uuidof(ID3D12GraphicsCommandList6))) {
+		*ppvObject = static_cast<ID3D12GraphicsCommandList6*>(this);
+		AddRef();
+
+		return S_OK;
+	}
+
+	*ppvObject = nullptr;
+
+	return E_NOINTERFACE;
+}
+
+ULONG STDMETHODCALLTYPE RecordingCommandList::AddRef() {
+	return ++m_referenceCount;
+}
+
+ULONG STDMETHODCALLTYPE RecordingCommandList::Release() {
+	const ULONG referenceCount = --m_referenceCount;
+
+	if (referenceCount == 0u)
+		delete this;
+
+	return referenceCount;
+}
+
+// ID3D12Object
+HRESULT STDMETHODCALLTYPE RecordingCommandList::GetPrivateData(
+	REFGUID guid, UINT* pDataSize, void* pData
+) {
+	if (!m_pCommandList)
+		return DXGI_ERROR_NOT_FOUND;
+
+	return m_pCommandList->GetPrivateData(guid, pDataSize, pData);
+}
+
+HRESULT STDMETHODCALLTYPE RecordingCommandList::SetPrivateData(
+	REFGUID guid, UINT DataSize, const void* pData
+) {
+	if (!m_pCommandList)
+		return E_NOTIMPL;
+
+	return m_pCommandList->SetPrivateData(guid, DataSize, pData);
+}
+
+HRESULT STDMETHODCALLTYPE RecordingCommandList::SetPrivateDataInterface(
+	REFGUID guid, const IUnknown* pData
+) {
+	if (!m_pCommandList)
+		return E_NOTIMPL;
+
+	return m_pCommandList->SetPrivateDataInterface(guid, pData);
+}
+
+HRESULT STDMETHODCALLTYPE RecordingCommandList::SetName(LPCWSTR Name) {
+	if (!m_pCommandList)
+		return E_NOTIMPL;
+
+	return m_pCommandList->SetName(Name);
+}
+
+// ID3D12DeviceChild
+HRESULT STDMETHODCALLTYPE RecordingCommandList::GetDevice(REFIID riid, void** ppvDevice) {
+	if (!m_pCommandList)
+		return E_NOTIMPL;
+
+	return m_pCommandList->GetDevice(riid, ppvDevice);
+}
+
+// ID3D12CommandList
+D3D12_COMMAND_LIST_TYPE STDMETHODCALLTYPE RecordingCommandList::GetType() {
+	return m_type;
+}
+
+// ID3D12GraphicsCommandList
+HRESULT STDMETHODCALLTYPE RecordingCommandList::Close() {
+	if (!m_pCommandList)
+		return S_OK;
+
+	return m_pCommandList->Close();
+}
+
+HRESULT STDMETHODCALLTYPE RecordingCommandList::Reset(
+	ID3D12CommandAllocator* pAllocator, ID3D12PipelineState* pInitialState
+) {
+	m_commands.clear();
+
+	if (!m_pCommandList)
+		return S_OK;
+
+	return m_pCommandList->Reset(pAllocator, pInitialState);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ClearState(ID3D12PipelineState* pPipelineState) {
+	Record(RecordedCommandType::Other, "ClearState");
+
+	if (m_pCommandList)
+		m_pCommandList->ClearState(pPipelineState);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::DrawInstanced(
+	UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation,
+	UINT StartInstanceLocation
+) {
+	Record(RecordedCommandType::Draw, "DrawInstanced", InstanceCount);
+
+	if (m_pCommandList)
+		m_pCommandList->DrawInstanced(
+			VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::DrawIndexedInstanced(
+	UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation,
+	INT BaseVertexLocation, UINT StartInstanceLocation
+) {
+	Record(RecordedCommandType::Draw, "DrawIndexedInstanced", InstanceCount);
+
+	if (m_pCommandList)
+		m_pCommandList->DrawIndexedInstanced(
+			IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation,
+			StartInstanceLocation
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::Dispatch(
+	UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ
+) {
+	Record(
+		RecordedCommandType::Dispatch, "Dispatch",
+		ThreadGroupCountX * ThreadGroupCountY * ThreadGroupCountZ
+	);
+
+	if (m_pCommandList)
+		m_pCommandList->Dispatch(ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::CopyBufferRegion(
+	ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer,
+	UINT64 SrcOffset, UINT64 NumBytes
+) {
+	Record(RecordedCommandType::Copy, "CopyBufferRegion");
+
+	if (m_pCommandList)
+		m_pCommandList->CopyBufferRegion(pDstBuffer, DstOffset, pSrcBuffer, SrcOffset, NumBytes);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::CopyTextureRegion(
+	const D3D12_TEXTURE_COPY_LOCATION* pDst, UINT DstX, UINT DstY, UINT DstZ,
+	const D3D12_TEXTURE_COPY_LOCATION* pSrc, const D3D12_BOX* pSrcBox
+) {
+	Record(RecordedCommandType::Copy, "CopyTextureRegion");
+
+	if (m_pCommandList)
+		m_pCommandList->CopyTextureRegion(pDst, DstX, DstY, DstZ, pSrc, pSrcBox);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::CopyResource(
+	ID3D12Resource* pDstResource, ID3D12Resource* pSrcResource
+) {
+	Record(RecordedCommandType::Copy, "CopyResource");
+
+	if (m_pCommandList)
+		m_pCommandList->CopyResource(pDstResource, pSrcResource);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::CopyTiles(
+	ID3D12Resource* pTiledResource,
+	const D3D12_TILED_RESOURCE_COORDINATE* pTileRegionStartCoordinate,
+	const D3D12_TILE_REGION_SIZE* pTileRegionSize, ID3D12Resource* pBuffer,
+	UINT64 BufferStartOffsetInBytes, D3D12_TILE_COPY_FLAGS Flags
+) {
+	Record(RecordedCommandType::Copy, "CopyTiles");
+
+	if (m_pCommandList)
+		m_pCommandList->CopyTiles(
+			pTiledResource, pTileRegionStartCoordinate, pTileRegionSize, pBuffer,
+			BufferStartOffsetInBytes, Flags
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ResolveSubresource(
+	ID3D12Resource* pDstResource, UINT DstSubresource, ID3D12Resource* pSrcResource,
+	UINT SrcSubresource, DXGI_FORMAT Format
+) {
+	Record(RecordedCommandType::Copy, "ResolveSubresource");
+
+	if (m_pCommandList)
+		m_pCommandList->ResolveSubresource(
+			pDstResource, DstSubresource, pSrcResource, SrcSubresource, Format
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::IASetPrimitiveTopology(
+	D3D12_PRIMITIVE_TOPOLOGY PrimitiveTopology
+) {
+	Record(RecordedCommandType::Bind, "IASetPrimitiveTopology");
+
+	if (m_pCommandList)
+		m_pCommandList->IASetPrimitiveTopology(PrimitiveTopology);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::RSSetViewports(
+	UINT NumViewports, const D3D12_VIEWPORT* pViewports
+) {
+	Record(RecordedCommandType::Bind, "RSSetViewports", NumViewports);
+
+	if (m_pCommandList)
+		m_pCommandList->RSSetViewports(NumViewports, pViewports);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::RSSetScissorRects(
+	UINT NumRects, const D3D12_RECT* pRects
+) {
+	Record(RecordedCommandType::Bind, "RSSetScissorRects", NumRects);
+
+	if (m_pCommandList)
+		m_pCommandList->RSSetScissorRects(NumRects, pRects);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::OMSetBlendFactor(const FLOAT BlendFactor[4]) {
+	Record(RecordedCommandType::Bind, "OMSetBlendFactor");
+
+	if (m_pCommandList)
+		m_pCommandList->OMSetBlendFactor(BlendFactor);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::OMSetStencilRef(UINT StencilRef) {
+	Record(RecordedCommandType::Bind, "OMSetStencilRef");
+
+	if (m_pCommandList)
+		m_pCommandList->OMSetStencilRef(StencilRef);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetPipelineState(ID3D12PipelineState* pPipelineState) {
+	Record(RecordedCommandType::Bind, "SetPipelineState");
+
+	if (m_pCommandList)
+		m_pCommandList->SetPipelineState(pPipelineState);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ResourceBarrier(
+	UINT NumBarriers, const D3D12_RESOURCE_BARRIER* pBarriers
+) {
+	Record(RecordedCommandType::Barrier, "ResourceBarrier", NumBarriers);
+
+	if (m_pCommandList)
+		m_pCommandList->ResourceBarrier(NumBarriers, pBarriers);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ExecuteBundle(
+	ID3D12GraphicsCommandList* pCommandList
+) {
+	Record(RecordedCommandType::Other, "ExecuteBundle");
+
+	if (m_pCommandList)
+		m_pCommandList->ExecuteBundle(pCommandList);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetDescriptorHeaps(
+	UINT NumDescriptorHeaps, ID3D12DescriptorHeap* const* ppDescriptorHeaps
+) {
+	Record(RecordedCommandType::Bind, "SetDescriptorHeaps", NumDescriptorHeaps);
+
+	if (m_pCommandList)
+		m_pCommandList->SetDescriptorHeaps(NumDescriptorHeaps, ppDescriptorHeaps);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRootSignature(
+	ID3D12RootSignature* pRootSignature
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRootSignature");
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRootSignature(pRootSignature);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRootSignature(
+	ID3D12RootSignature* pRootSignature
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRootSignature");
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRootSignature(pRootSignature);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRootDescriptorTable(
+	UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRootDescriptorTable");
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRootDescriptorTable(RootParameterIndex, BaseDescriptor);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRootDescriptorTable(
+	UINT RootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRootDescriptorTable");
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRootDescriptorTable(RootParameterIndex, BaseDescriptor);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRoot32BitConstant(
+	UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRoot32BitConstant");
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRoot32BitConstant(
+			RootParameterIndex, SrcData, DestOffsetIn32BitValues
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRoot32BitConstant(
+	UINT RootParameterIndex, UINT SrcData, UINT DestOffsetIn32BitValues
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRoot32BitConstant");
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRoot32BitConstant(
+			RootParameterIndex, SrcData, DestOffsetIn32BitValues
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRoot32BitConstants(
+	UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData,
+	UINT DestOffsetIn32BitValues
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRoot32BitConstants", Num32BitValuesToSet);
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRoot32BitConstants(
+			RootParameterIndex, Num32BitValuesToSet, pSrcData, DestOffsetIn32BitValues
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRoot32BitConstants(
+	UINT RootParameterIndex, UINT Num32BitValuesToSet, const void* pSrcData,
+	UINT DestOffsetIn32BitValues
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRoot32BitConstants", Num32BitValuesToSet);
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRoot32BitConstants(
+			RootParameterIndex, Num32BitValuesToSet, pSrcData, DestOffsetIn32BitValues
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRootConstantBufferView(
+	UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRootConstantBufferView");
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRootConstantBufferView(RootParameterIndex, BufferLocation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRootConstantBufferView(
+	UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRootConstantBufferView");
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRootConstantBufferView(RootParameterIndex, BufferLocation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRootShaderResourceView(
+	UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRootShaderResourceView");
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRootShaderResourceView(RootParameterIndex, BufferLocation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRootShaderResourceView(
+	UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRootShaderResourceView");
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRootShaderResourceView(RootParameterIndex, BufferLocation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetComputeRootUnorderedAccessView(
+	UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+) {
+	Record(RecordedCommandType::Bind, "SetComputeRootUnorderedAccessView");
+
+	if (m_pCommandList)
+		m_pCommandList->SetComputeRootUnorderedAccessView(RootParameterIndex, BufferLocation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetGraphicsRootUnorderedAccessView(
+	UINT RootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS BufferLocation
+) {
+	Record(RecordedCommandType::Bind, "SetGraphicsRootUnorderedAccessView");
+
+	if (m_pCommandList)
+		m_pCommandList->SetGraphicsRootUnorderedAccessView(RootParameterIndex, BufferLocation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::IASetIndexBuffer(
+	const D3D12_INDEX_BUFFER_VIEW* pView
+) {
+	Record(RecordedCommandType::Bind, "IASetIndexBuffer");
+
+	if (m_pCommandList)
+		m_pCommandList->IASetIndexBuffer(pView);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::IASetVertexBuffers(
+	UINT StartSlot, UINT NumViews, const D3D12_VERTEX_BUFFER_VIEW* pViews
+) {
+	Record(RecordedCommandType::Bind, "IASetVertexBuffers", NumViews);
+
+	if (m_pCommandList)
+		m_pCommandList->IASetVertexBuffers(StartSlot, NumViews, pViews);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SOSetTargets(
+	UINT StartSlot, UINT NumViews, const D3D12_STREAM_OUTPUT_BUFFER_VIEW* pViews
+) {
+	Record(RecordedCommandType::Bind, "SOSetTargets", NumViews);
+
+	if (m_pCommandList)
+		m_pCommandList->SOSetTargets(StartSlot, NumViews, pViews);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::OMSetRenderTargets(
+	UINT NumRenderTargetDescriptors, const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors,
+	BOOL RTsSingleHandleToDescriptorRange,
+	const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor
+) {
+	Record(RecordedCommandType::Bind, "OMSetRenderTargets", NumRenderTargetDescriptors);
+
+	if (m_pCommandList)
+		m_pCommandList->OMSetRenderTargets(
+			NumRenderTargetDescriptors, pRenderTargetDescriptors,
+			RTsSingleHandleToDescriptorRange, pDepthStencilDescriptor
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ClearDepthStencilView(
+	D3D12_CPU_DESCRIPTOR_HANDLE DepthStencilView, D3D12_CLEAR_FLAGS ClearFlags,
+	FLOAT Depth, UINT8 Stencil, UINT NumRects, const D3D12_RECT* pRects
+) {
+	Record(RecordedCommandType::Clear, "ClearDepthStencilView");
+
+	if (m_pCommandList)
+		m_pCommandList->ClearDepthStencilView(
+			DepthStencilView, ClearFlags, Depth, Stencil, NumRects, pRects
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ClearRenderTargetView(
+	D3D12_CPU_DESCRIPTOR_HANDLE RenderTargetView, const FLOAT ColorRGBA[4],
+	UINT NumRects, const D3D12_RECT* pRects
+) {
+	Record(RecordedCommandType::Clear, "ClearRenderTargetView");
+
+	if (m_pCommandList)
+		m_pCommandList->ClearRenderTargetView(RenderTargetView, ColorRGBA, NumRects, pRects);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ClearUnorderedAccessViewUint(
+	D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap,
+	D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource,
+	const UINT Values[4], UINT NumRects, const D3D12_RECT* pRects
+) {
+	Record(RecordedCommandType::Clear, "ClearUnorderedAccessViewUint");
+
+	if (m_pCommandList)
+		m_pCommandList->ClearUnorderedAccessViewUint(
+			ViewGPUHandleInCurrentHeap, ViewCPUHandle, pResource, Values, NumRects, pRects
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ClearUnorderedAccessViewFloat(
+	D3D12_GPU_DESCRIPTOR_HANDLE ViewGPUHandleInCurrentHeap,
+	D3D12_CPU_DESCRIPTOR_HANDLE ViewCPUHandle, ID3D12Resource* pResource,
+	const FLOAT Values[4], UINT NumRects, const D3D12_RECT* pRects
+) {
+	Record(RecordedCommandType::Clear, "ClearUnorderedAccessViewFloat");
+
+	if (m_pCommandList)
+		m_pCommandList->ClearUnorderedAccessViewFloat(
+			ViewGPUHandleInCurrentHeap, ViewCPUHandle, pResource, Values, NumRects, pRects
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::DiscardResource(
+	ID3D12Resource* pResource, const D3D12_DISCARD_REGION* pRegion
+) {
+	Record(RecordedCommandType::Other, "DiscardResource");
+
+	if (m_pCommandList)
+		m_pCommandList->DiscardResource(pResource, pRegion);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::BeginQuery(
+	ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index
+) {
+	Record(RecordedCommandType::Other, "BeginQuery");
+
+	if (m_pCommandList)
+		m_pCommandList->BeginQuery(pQueryHeap, Type, Index);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::EndQuery(
+	ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index
+) {
+	Record(RecordedCommandType::Other, "EndQuery");
+
+	if (m_pCommandList)
+		m_pCommandList->EndQuery(pQueryHeap, Type, Index);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ResolveQueryData(
+	ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT StartIndex, UINT NumQueries,
+	ID3D12Resource* pDestinationBuffer, UINT64 AlignedDestinationBufferOffset
+) {
+	Record(RecordedCommandType::Copy, "ResolveQueryData", NumQueries);
+
+	if (m_pCommandList)
+		m_pCommandList->ResolveQueryData(
+			pQueryHeap, Type, StartIndex, NumQueries, pDestinationBuffer,
+			AlignedDestinationBufferOffset
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetPredication(
+	ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation
+) {
+	Record(RecordedCommandType::Other, "SetPredication");
+
+	if (m_pCommandList)
+		m_pCommandList->SetPredication(pBuffer, AlignedBufferOffset, Operation);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetMarker(
+	UINT Metadata, const void* pData, UINT Size
+) {
+	Record(RecordedCommandType::Other, "SetMarker");
+
+	if (m_pCommandList)
+		m_pCommandList->SetMarker(Metadata, pData, Size);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::BeginEvent(
+	UINT Metadata, const void* pData, UINT Size
+) {
+	Record(RecordedCommandType::Other, "BeginEvent");
+
+	if (m_pCommandList)
+		m_pCommandList->BeginEvent(Metadata, pData, Size);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::EndEvent() {
+	Record(RecordedCommandType::Other, "EndEvent");
+
+	if (m_pCommandList)
+		m_pCommandList->EndEvent();
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ExecuteIndirect(
+	ID3D12CommandSignature* pCommandSignature, UINT MaxCommandCount,
+	ID3D12Resource* pArgumentBuffer, UINT64 ArgumentBufferOffset,
+	ID3D12Resource* pCountBuffer, UINT64 CountBufferOffset
+) {
+	Record(RecordedCommandType::Indirect, "ExecuteIndirect", MaxCommandCount);
+
+	if (m_pCommandList)
+		m_pCommandList->ExecuteIndirect(
+			pCommandSignature, MaxCommandCount, pArgumentBuffer, ArgumentBufferOffset,
+			pCountBuffer, CountBufferOffset
+		);
+}
+
+// ID3D12GraphicsCommandList1
+void STDMETHODCALLTYPE RecordingCommandList::AtomicCopyBufferUINT(
+	ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer,
+	UINT64 SrcOffset, UINT Dependencies, ID3D12Resource* const* ppDependentResources,
+	const D3D12_SUBRESOURCE_RANGE_UINT64* pDependentSubresourceRanges
+) {
+	Record(RecordedCommandType::Copy, "AtomicCopyBufferUINT");
+
+	if (m_pCommandList6)
+		m_pCommandList6->AtomicCopyBufferUINT(
+			pDstBuffer, DstOffset, pSrcBuffer, SrcOffset, Dependencies, ppDependentResources,
+			pDependentSubresourceRanges
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::AtomicCopyBufferUINT64(
+	ID3D12Resource* pDstBuffer, UINT64 DstOffset, ID3D12Resource* pSrcBuffer,
+	UINT64 SrcOffset, UINT Dependencies, ID3D12Resource* const* ppDependentResources,
+	const D3D12_SUBRESOURCE_RANGE_UINT64* pDependentSubresourceRanges
+) {
+	Record(RecordedCommandType::Copy, "AtomicCopyBufferUINT64");
+
+	if (m_pCommandList6)
+		m_pCommandList6->AtomicCopyBufferUINT64(
+			pDstBuffer, DstOffset, pSrcBuffer, SrcOffset, Dependencies, ppDependentResources,
+			pDependentSubresourceRanges
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::OMSetDepthBounds(FLOAT Min, FLOAT Max) {
+	Record(RecordedCommandType::Bind, "OMSetDepthBounds");
+
+	if (m_pCommandList6)
+		m_pCommandList6->OMSetDepthBounds(Min, Max);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetSamplePositions(
+	UINT NumSamplesPerPixel, UINT NumPixels, D3D12_SAMPLE_POSITION* pSamplePositions
+) {
+	Record(RecordedCommandType::Bind, "SetSamplePositions");
+
+	if (m_pCommandList6)
+		m_pCommandList6->SetSamplePositions(NumSamplesPerPixel, NumPixels, pSamplePositions);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ResolveSubresourceRegion(
+	ID3D12Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY,
+	ID3D12Resource* pSrcResource, UINT SrcSubresource, D3D12_RECT* pSrcRect,
+	DXGI_FORMAT Format, D3D12_RESOLVE_MODE ResolveMode
+) {
+	Record(RecordedCommandType::Copy, "ResolveSubresourceRegion");
+
+	if (m_pCommandList6)
+		m_pCommandList6->ResolveSubresourceRegion(
+			pDstResource, DstSubresource, DstX, DstY, pSrcResource, SrcSubresource, pSrcRect,
+			Format, ResolveMode
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetViewInstanceMask(UINT Mask) {
+	Record(RecordedCommandType::Bind, "SetViewInstanceMask");
+
+	if (m_pCommandList6)
+		m_pCommandList6->SetViewInstanceMask(Mask);
+}
+
+// ID3D12GraphicsCommandList2
+void STDMETHODCALLTYPE RecordingCommandList::WriteBufferImmediate(
+	UINT Count, const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER* pParams,
+	const D3D12_WRITEBUFFERIMMEDIATE_MODE* pModes
+) {
+	Record(RecordedCommandType::Copy, "WriteBufferImmediate", Count);
+
+	if (m_pCommandList6)
+		m_pCommandList6->WriteBufferImmediate(Count, pParams, pModes);
+}
+
+// ID3D12GraphicsCommandList3
+void STDMETHODCALLTYPE RecordingCommandList::SetProtectedResourceSession(
+	ID3D12ProtectedResourceSession* pProtectedResourceSession
+) {
+	Record(RecordedCommandType::Other, "SetProtectedResourceSession");
+
+	if (m_pCommandList6)
+		m_pCommandList6->SetProtectedResourceSession(pProtectedResourceSession);
+}
+
+// ID3D12GraphicsCommandList4
+void STDMETHODCALLTYPE RecordingCommandList::BeginRenderPass(
+	UINT NumRenderTargets, const D3D12_RENDER_PASS_RENDER_TARGET_DESC* pRenderTargets,
+	const D3D12_RENDER_PASS_DEPTH_STENCIL_DESC* pDepthStencil, D3D12_RENDER_PASS_FLAGS Flags
+) {
+	Record(RecordedCommandType::Bind, "BeginRenderPass", NumRenderTargets);
+
+	if (m_pCommandList6)
+		m_pCommandList6->BeginRenderPass(NumRenderTargets, pRenderTargets, pDepthStencil, Flags);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::EndRenderPass() {
+	Record(RecordedCommandType::Other, "EndRenderPass");
+
+	if (m_pCommandList6)
+		m_pCommandList6->EndRenderPass();
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::InitializeMetaCommand(
+	ID3D12MetaCommand* pMetaCommand, const void* pInitializationParametersData,
+	SIZE_T InitializationParametersDataSizeInBytes
+) {
+	Record(RecordedCommandType::Other, "InitializeMetaCommand");
+
+	if (m_pCommandList6)
+		m_pCommandList6->InitializeMetaCommand(
+			pMetaCommand, pInitializationParametersData, InitializationParametersDataSizeInBytes
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::ExecuteMetaCommand(
+	ID3D12MetaCommand* pMetaCommand, const void* pExecutionParametersData,
+	SIZE_T ExecutionParametersDataSizeInBytes
+) {
+	Record(RecordedCommandType::Other, "ExecuteMetaCommand");
+
+	if (m_pCommandList6)
+		m_pCommandList6->ExecuteMetaCommand(
+			pMetaCommand, pExecutionParametersData, ExecutionParametersDataSizeInBytes
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::BuildRaytracingAccelerationStructure(
+	const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC* pDesc,
+	UINT NumPostbuildInfoDescs,
+	const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC* pPostbuildInfoDescs
+) {
+	Record(RecordedCommandType::Other, "BuildRaytracingAccelerationStructure");
+
+	if (m_pCommandList6)
+		m_pCommandList6->BuildRaytracingAccelerationStructure(
+			pDesc, NumPostbuildInfoDescs, pPostbuildInfoDescs
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::EmitRaytracingAccelerationStructurePostbuildInfo(
+	const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC* pDesc,
+	UINT NumSourceAccelerationStructures,
+	const D3D12_GPU_VIRTUAL_ADDRESS* pSourceAccelerationStructureData
+) {
+	Record(RecordedCommandType::Other, "EmitRaytracingAccelerationStructurePostbuildInfo");
+
+	if (m_pCommandList6)
+		m_pCommandList6->EmitRaytracingAccelerationStructurePostbuildInfo(
+			pDesc, NumSourceAccelerationStructures, pSourceAccelerationStructureData
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::CopyRaytracingAccelerationStructure(
+	D3D12_GPU_VIRTUAL_ADDRESS DestAccelerationStructureData,
+	D3D12_GPU_VIRTUAL_ADDRESS SourceAccelerationStructureData,
+	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE Mode
+) {
+	Record(RecordedCommandType::Copy, "CopyRaytracingAccelerationStructure");
+
+	if (m_pCommandList6)
+		m_pCommandList6->CopyRaytracingAccelerationStructure(
+			DestAccelerationStructureData, SourceAccelerationStructureData, Mode
+		);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::SetPipelineState1(ID3D12StateObject* pStateObject) {
+	Record(RecordedCommandType::Bind, "SetPipelineState1");
+
+	if (m_pCommandList6)
+		m_pCommandList6->SetPipelineState1(pStateObject);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::DispatchRays(const D3D12_DISPATCH_RAYS_DESC* pDesc) {
+	Record(RecordedCommandType::Dispatch, "DispatchRays");
+
+	if (m_pCommandList6)
+		m_pCommandList6->DispatchRays(pDesc);
+}
+
+// ID3D12GraphicsCommandList5
+void STDMETHODCALLTYPE RecordingCommandList::RSSetShadingRate(
+	D3D12_SHADING_RATE baseShadingRate, const D3D12_SHADING_RATE_COMBINER* combiners
+) {
+	Record(RecordedCommandType::Bind, "RSSetShadingRate");
+
+	if (m_pCommandList6)
+		m_pCommandList6->RSSetShadingRate(baseShadingRate, combiners);
+}
+
+void STDMETHODCALLTYPE RecordingCommandList::RSSetShadingRateImage(
+	ID3D12Resource* shadingRateImage
+) {
+	Record(RecordedCommandType::Bind, "RSSetShadingRateImage");
+
+	if (m_pCommandList6)
+		m_pCommandList6->RSSetShadingRateImage(shadingRateImage);
+}
+
+// ID3D12GraphicsCommandList6
+void STDMETHODCALLTYPE RecordingCommandList::DispatchMesh(
+	UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ
+) {
+	Record(
+		RecordedCommandType::Draw, "DispatchMesh",
+		ThreadGroupCountX * ThreadGroupCountY * ThreadGroupCountZ
+	);
+
+	if (m_pCommandList6)
+		m_pCommandList6->DispatchMesh(ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
+}
@@ -1,12 +1,20 @@
-#include <RenderEngine.hpp>
-
-RenderEngine::RenderEngine() noexcept :
-	m_backgroundColour{ 0.0001f, 0.0001f, 0.0001f, 0.0001f } {}
-
-void RenderEngine::SetBackgroundColour(const std::array<float, 4>& colour) noexcept {
-	m_backgroundColour = colour;
-}
-
-void RenderEngine::SetShaderPath(const wchar_t* path) noexcept {
-	m_shaderPath = path;
-}
+#include <RenderEngine.hpp>
+
+RenderEngine::RenderEngine() noexcept :
+	m_backgroundColour{ 0.0001f, 0.0001f, 0.0001f, 0.0001f } {}
+
+void RenderEngine::SetBackgroundColour(const std::array<float, 4>& colour) noexcept {
+	m_backgroundColour = colour;
+}
+
+void RenderEngine::SetShaderPath(const wchar_t* path) noexcept {
+	m_shaderPath = path;
+}
+
+void RenderEngine::SetCullingOverlap([[maybe_unused]] bool enable) noexcept {}
+
+void RenderEngine::SetAutoInstancing([[maybe_unused]] bool enable) noexcept {}
+
+RenderEngine::CullingStats RenderEngine::GetCullingStats() const noexcept {
+	return { .visibleModels = 0u, .culledModels = 0u };
+}
@@ -1,117 +1,323 @@
-#include <RenderEngineBase.hpp>
-#include <Gaia.hpp>
-#include <D3DResourceBarrier.hpp>
-
-RenderEngineBase::RenderEngineBase(ID3D12Device* device) : m_depthBuffer{ device } {
-	m_depthBuffer.SetMaxResolution(7680u, 4320u);
-}
-
-void RenderEngineBase::Present(size_t frameIndex) {
-	ID3D12GraphicsCommandList* graphicsCommandList = Gaia::graphicsCmdList->GetCommandList();
-
-	D3DResourceBarrier().AddBarrier(
-		Gaia::swapChain->GetRTV(frameIndex),
-		D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT
-	).RecordBarriers(graphicsCommandList);
-
-	Gaia::graphicsCmdList->Close();
-	Gaia::graphicsQueue->ExecuteCommandLists(graphicsCommandList);
-
-	Gaia::swapChain->PresentWithTear();
-}
-
-void RenderEngineBase::ExecutePostRenderStage() {
-	UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
-
-	Gaia::graphicsQueue->SignalCommandQueue(Gaia::graphicsFence->GetFence(), fenceValue);
-	Gaia::graphicsFence->AdvanceValueInQueue();
-	Gaia::graphicsFence->WaitOnCPUConditional();
-	Gaia::graphicsFence->IncreaseFrontValue(fenceValue);
-}
-
-void RenderEngineBase::ExecutePreGraphicsStage(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	Gaia::graphicsCmdList->Reset(frameIndex);
-
-	D3DResourceBarrier<1u>().AddBarrier(
-		Gaia::swapChain->GetRTV(frameIndex),
-		D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET
-	).RecordBarriers(graphicsCommandList);
-
-	ID3D12DescriptorHeap* descriptorHeap[] = { Gaia::descriptorTable->GetDescHeapRef() };
-	graphicsCommandList->SetDescriptorHeaps(1u, descriptorHeap);
-
-	graphicsCommandList->RSSetViewports(1u, m_viewportAndScissor.GetViewportRef());
-	graphicsCommandList->RSSetScissorRects(1u, m_viewportAndScissor.GetScissorRef());
-
-	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = Gaia::swapChain->GetRTVHandle(frameIndex);
-
-	Gaia::swapChain->ClearRTV(
-		graphicsCommandList, std::data(m_backgroundColour), rtvHandle
-	);
-
-	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = m_depthBuffer.GetDSVHandle();
-
-	m_depthBuffer.ClearDSV(graphicsCommandList, dsvHandle);
-
-	graphicsCommandList->OMSetRenderTargets(1u, &rtvHandle, FALSE, &dsvHandle);
-}
-
-void RenderEngineBase::BindCommonGraphicsBuffers(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	Gaia::textureStorage->BindTextures(graphicsCommandList);
-	Gaia::bufferManager->BindBuffersToGraphics(graphicsCommandList, frameIndex);
-	Gaia::bufferManager->BindPixelOnlyBuffers(graphicsCommandList, frameIndex);
-}
-
-void RenderEngineBase::ConstructGraphicsRootSignature(ID3D12Device* device) {
-	auto graphicsRS = CreateGraphicsRootSignature(device);
-
-	m_graphicsRSLayout = graphicsRS->GetElementLayout();
-	m_graphicsRS = std::move(graphicsRS);
-
-	Gaia::bufferManager->SetGraphicsRootSignatureLayout(m_graphicsRSLayout);
-	Gaia::textureStorage->SetGraphicsRootSignatureLayout(m_graphicsRSLayout);
-}
-
-void RenderEngineBase::ResizeViewportAndScissor(
-	std::uint32_t width, std::uint32_t height
-) noexcept {
-	m_viewportAndScissor.Resize(width, height);
-}
-
-void RenderEngineBase::CreateDepthBufferView(
-	ID3D12Device* device, std::uint32_t width, std::uint32_t height
-) {
-	m_depthBuffer.CreateDepthBufferView(device, width, height);
-}
-
-void RenderEngineBase::ReserveBuffers(ID3D12Device* device) {
-	m_depthBuffer.ReserveHeapSpace(device);
-	ReserveBuffersDerived(device);
-}
-
-void RenderEngineBase::ReserveBuffersDerived([[maybe_unused]] ID3D12Device* device) {}
-
-void RenderEngineBase::AddGVerticesAndIndices(
-	[[maybe_unused]] std::vector<Vertex>&& gVertices,
-	[[maybe_unused]] std::vector<std::uint32_t>&& gIndices
-) noexcept {}
-
-void RenderEngineBase::RecordModelDataSet(
-	[[maybe_unused]] const std::vector<std::shared_ptr<IModel>>& models,
-	[[maybe_unused]] const std::wstring& pixelShader
-) noexcept {}
-
-void RenderEngineBase::AddMeshletModelSet(
-	[[maybe_unused]] std::vector<MeshletModel>& meshletModels,
-	[[maybe_unused]] const std::wstring& pixelShader
-) noexcept {}
-
-void RenderEngineBase::AddGVerticesAndPrimIndices(
-	[[maybe_unused]] std::vector<Vertex>&& gVertices,
-	[[maybe_unused]] std::vector<std::uint32_t>&& gVerticesIndices,
-	[[maybe_unused]] std::vector<std::uint32_t>&& gPrimIndices
-) noexcept {}
+#include <RenderEngineBase.hpp>
+#include <Gaia.hpp>
+#include <D3DResourceBarrier.hpp>
+#include <Exception.hpp>
+#include <algorithm>
+#include <exception>
+#include <string>
+
+RenderEngineBase::RenderEngineBase(ID3D12Device* device) : m_depthBuffer{ device } {
+	m_depthBuffer.SetMaxResolution(7680u, 4320u);
+}
+
+void RenderEngineBase::Present(size_t frameIndex) {
+	// The last list of the frame takes the barrier.
+	ID3D12GraphicsCommandList* graphicsCommandList = std::empty(m_drawCommandLists) ?
+		Gaia::graphicsCmdList->GetCommandList() : m_drawCommandLists.back()->GetCommandList();
+
+	D3DResourceBarrier().AddBarrier(
+		Gaia::swapChain->GetRTV(frameIndex),
+		D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT
+	).RecordBarriers(graphicsCommandList);
+
+	Gaia::graphicsCmdList->Close();
+
+	if (std::empty(m_drawCommandLists))
+		Gaia::graphicsQueue->ExecuteCommandLists(
+			Gaia::graphicsCmdList->GetExecutableCommandList()
+		);
+	else {
+		std::vector<ID3D12CommandList*> commandLists{
+			Gaia::graphicsCmdList->GetExecutableCommandList()
+		};
+
+		for (D3DCommandList* drawCommandList : m_drawCommandLists) {
+			drawCommandList->Close();
+			commandLists.emplace_back(drawCommandList->GetExecutableCommandList());
+		}
+
+		Gaia::graphicsQueue->ExecuteCommandLists(commandLists);
+
+		m_drawCommandLists.clear();
+	}
+
+	// ExecutePostRenderStage signals the front value.
+	Gaia::graphicsCmdListPool->RetireCommandLists(Gaia::graphicsFence->GetFrontValue());
+
+	Gaia::swapChain->PresentWithTear();
+}
+
+void RenderEngineBase::ExecutePostRenderStage() {
+	UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
+
+	Gaia::graphicsQueue->SignalCommandQueue(Gaia::graphicsFence->GetFence(), fenceValue);
+	Gaia::graphicsFence->AdvanceValueInQueue();
+	Gaia::graphicsFence->WaitOnCPUConditional();
+	Gaia::graphicsFence->IncreaseFrontValue(fenceValue);
+}
+
+void RenderEngineBase::ExecutePreGraphicsStage(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) {
+	Gaia::graphicsCmdList->Reset(frameIndex);
+
+	Gaia::textureStorage->RecordRuntimeUploads(graphicsCommandList);
+	RecordRuntimeUploads(graphicsCommandList);
+
+	D3DResourceBarrier<1u>().AddBarrier(
+		Gaia::swapChain->GetRTV(frameIndex),
+		D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET
+	).RecordBarriers(graphicsCommandList);
+
+	Gaia::swapChain->ClearRTV(
+		graphicsCommandList, std::data(m_backgroundColour),
+		Gaia::swapChain->GetRTVHandle(frameIndex)
+	);
+
+	m_depthBuffer.ClearDSV(graphicsCommandList, m_depthBuffer.GetDSVHandle());
+
+	BindRenderTargets(graphicsCommandList, frameIndex);
+}
+
+void RenderEngineBase::BindRenderTargets(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) const noexcept {
+	ID3D12DescriptorHeap* descriptorHeap[] = { Gaia::descriptorTable->GetDescHeapRef() };
+	graphicsCommandList->SetDescriptorHeaps(1u, descriptorHeap);
+
+	graphicsCommandList->RSSetViewports(1u, m_viewportAndScissor.GetViewportRef());
+	graphicsCommandList->RSSetScissorRects(1u, m_viewportAndScissor.GetScissorRef());
+
+	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = Gaia::swapChain->GetRTVHandle(frameIndex);
+	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = m_depthBuffer.GetDSVHandle();
+
+	graphicsCommandList->OMSetRenderTargets(1u, &rtvHandle, FALSE, &dsvHandle);
+}
+
+void RenderEngineBase::RecordDrawJobs(
+	size_t jobCount, const std::function<void(D3DCommandList&, size_t)>& recordJob,
+	size_t frameIndex
+) {
+	m_drawCommandLists.resize(jobCount);
+
+	Gaia::RunJobs(
+		jobCount,
+		[&](size_t jobIndex) {
+			D3DCommandList* drawCommandList = Gaia::graphicsCmdListPool->AcquireCommandList();
+
+			BindRenderTargets(drawCommandList->GetCommandList(), frameIndex);
+			recordJob(*drawCommandList, jobIndex);
+
+			m_drawCommandLists[jobIndex] = drawCommandList;
+		}
+	);
+}
+
+bool RenderEngineBase::ShouldRecordInParallel(size_t drawCount) noexcept {
+	return Gaia::threadPool && drawCount >= s_parallelDrawThreshold;
+}
+
+void RenderEngineBase::AddDrawRanges(
+	std::vector<DrawRange>& drawRanges, size_t pipelineIndex, size_t drawCount
+) {
+	for (size_t drawStart = 0u; drawStart < drawCount; drawStart += s_drawsPerJob)
+		drawRanges.emplace_back(
+			DrawRange{
+				.pipelineIndex = pipelineIndex,
+				.drawStart = drawStart,
+				.drawEnd = std::min(drawStart + s_drawsPerJob, drawCount)
+			}
+		);
+}
+
+void RenderEngineBase::BindCommonGraphicsBuffers(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) {
+	Gaia::textureStorage->BindTextures(graphicsCommandList);
+	Gaia::bufferManager->BindBuffersToGraphics(graphicsCommandList, frameIndex);
+	Gaia::bufferManager->BindPixelOnlyBuffers(graphicsCommandList, frameIndex);
+}
+
+void RenderEngineBase::RegisterBufferUpdateTasks(
+	FrameTaskGraph& frameTasks, bool modelWithNoBB
+) {
+	frameTasks.AddTask(
+		"UpdateCameraData",
+		[](size_t frameIndex) { Gaia::bufferManager->UpdateCameraData(frameIndex); },
+		FrameResource::None, FrameResource::Camera
+	);
+
+	if (modelWithNoBB)
+		frameTasks.AddTask(
+			"UpdatePerModelData",
+			[](size_t frameIndex) { Gaia::bufferManager->UpdatePerModelData<true>(frameIndex); },
+			FrameResource::None, FrameResource::ModelStore | FrameResource::ModelBuffers
+		);
+	else
+		frameTasks.AddTask(
+			"UpdatePerModelData",
+			[](size_t frameIndex) { Gaia::bufferManager->UpdatePerModelData<false>(frameIndex); },
+			FrameResource::None, FrameResource::ModelStore | FrameResource::ModelBuffers
+		);
+
+	frameTasks.AddTask(
+		"UpdateLightData",
+		[](size_t frameIndex) { Gaia::bufferManager->UpdateLightData(frameIndex); },
+		FrameResource::ModelStore, FrameResource::LightBuffers
+	);
+	frameTasks.AddTask(
+		"UpdatePixelData",
+		[](size_t frameIndex) { Gaia::bufferManager->UpdatePixelData(frameIndex); },
+		FrameResource::None, FrameResource::PixelBuffers
+	);
+}
+
+void RenderEngineBase::RegisterPreGraphicsTask(FrameTaskGraph& frameTasks) {
+	frameTasks.AddTask(
+		"ExecutePreGraphicsStage",
+		[this](size_t frameIndex) {
+			ExecutePreGraphicsStage(Gaia::graphicsCmdList->GetCommandList(), frameIndex);
+		},
+		FrameResource::None, FrameResource::GraphicsCommandList
+	);
+}
+
+void RenderEngineBase::ConstructGraphicsRootSignature(ID3D12Device* device) {
+	auto graphicsRS = CreateGraphicsRootSignature(device);
+
+	m_graphicsRSLayout = graphicsRS->GetElementLayout();
+	m_graphicsRS = std::move(graphicsRS);
+
+	Gaia::bufferManager->SetGraphicsRootSignatureLayout(m_graphicsRSLayout);
+	Gaia::textureStorage->SetGraphicsRootSignatureLayout(m_graphicsRSLayout);
+}
+
+void RenderEngineBase::ResizeViewportAndScissor(
+	std::uint32_t width, std::uint32_t height
+) noexcept {
+	m_viewportAndScissor.Resize(width, height);
+}
+
+void RenderEngineBase::CreateDepthBufferView(
+	ID3D12Device* device, std::uint32_t width, std::uint32_t height
+) {
+	m_depthBuffer.CreateDepthBufferView(device, width, height);
+}
+
+void RenderEngineBase::ReserveBuffers(ID3D12Device* device) {
+	m_depthBuffer.ReserveHeapSpace(device);
+	ReserveBuffersDerived(device);
+}
+
+void RenderEngineBase::ReserveBuffersDerived([[maybe_unused]] ID3D12Device* device) {}
+
+void RenderEngineBase::ReleaseGraphicsPipeline(
+	std::shared_ptr<GraphicsPipelineBase> graphicsPipeline
+) {
+	if (!graphicsPipeline)
+		return;
+
+	Gaia::ReleaseAfterCurrentFrame(
+		[graphicsPipeline = std::move(graphicsPipeline)]() mutable { graphicsPipeline.reset(); }
+	);
+}
+
+void RenderEngineBase::RecordRuntimeUploads(
+	[[maybe_unused]] ID3D12GraphicsCommandList* graphicsCommandList
+) {}
+
+ModelInputRange RenderEngineBase::AddGVerticesAndIndices(
+	[[maybe_unused]] std::vector<Vertex>&& gVertices,
+	[[maybe_unused]] std::vector<std::uint32_t>&& gIndices
+) {
+	return ModelInputRange{ .inputId = 0u, .indexOffset = 0u };
+}
+
+ModelInputRange RenderEngineBase::AddGVerticesAndIndices(
+	[[maybe_unused]] std::vector<PackedVertex>&& gVertices,
+	[[maybe_unused]] std::vector<std::uint32_t>&& gIndices
+) {
+	return ModelInputRange{ .inputId = 0u, .indexOffset = 0u };
+}
+
+void RenderEngineBase::RemoveGVerticesAndIndices([[maybe_unused]] size_t inputId) {
+	// No input ids are handed out, so every id is unknown.
+	throw Exception("RenderEngine Error", "The engine's model inputs can't be removed.");
+}
+
+size_t RenderEngineBase::RecordModelDataSet(
+	[[maybe_unused]] const std::vector<std::shared_ptr<IModel>>& models,
+	[[maybe_unused]] const std::vector<std::uint32_t>& modelIds,
+	[[maybe_unused]] const std::wstring& pixelShader
+) {
+	return 0u;
+}
+
+void RenderEngineBase::RemoveModelDataSet([[maybe_unused]] size_t modelSetIndex) {}
+
+void RenderEngineBase::SetSpareCapacity(
+	[[maybe_unused]] size_t modelCount, [[maybe_unused]] size_t modelSetCount,
+	[[maybe_unused]] size_t vertexCount, [[maybe_unused]] size_t indexCount
+) noexcept {}
+
+void RenderEngineBase::AddMeshletModelSet(
+	[[maybe_unused]] std::vector<MeshletModel>& meshletModels,
+	[[maybe_unused]] const std::wstring& pixelShader
+) noexcept {}
+
+void RenderEngineBase::AddGVerticesAndPrimIndices(
+	[[maybe_unused]] std::vector<Vertex>&& gVertices,
+	[[maybe_unused]] std::vector<std::uint32_t>&& gVerticesIndices,
+	[[maybe_unused]] std::vector<std::uint32_t>&& gPrimIndices
+) noexcept {}
+
+void RenderEngineBase::RunPipelineCreations(
+	const std::vector<std::function<void()>>& pipelineCreations
+) {
+	const size_t creationCount = std::size(pipelineCreations);
+
+	// The jobs must not throw, so the errors are kept until every creation has run.
+	std::vector<std::exception_ptr> creationErrors(creationCount);
+
+	Gaia::RunJobs(
+		creationCount,
+		[&](size_t creationIndex) {
+			try {
+				pipelineCreations[creationIndex]();
+			}
+			catch (...) {
+				creationErrors[creationIndex] = std::current_exception();
+			}
+		}
+	);
+
+	std::string errorMessages{};
+	size_t errorCount = 0u;
+
+	for (const std::exception_ptr& creationError : creationErrors) {
+		if (!creationError)
+			continue;
+
+		++errorCount;
+
+		try {
+			std::rethrow_exception(creationError);
+		}
+		catch (const Exception& exception) {
+			errorMessages += std::string{ "\n" } + exception.GetType() + ": " + exception.what();
+		}
+		catch (const std::exception& exception) {
+			errorMessages += std::string{ "\n" } + exception.what();
+		}
+		catch (...) {
+			errorMessages += "\nUnknown error.";
+		}
+	}
+
+	if (errorCount != 0u)
+		throw Exception(
+			"RenderEngine Error",
+			std::to_string(errorCount) + " of " + std::to_string(creationCount)
+			+ " pipeline objects couldn't be created." + errorMessages
+		);
+}
@@ -1,160 +1,264 @@
-#include <ranges>
-#include <algorithm>
-#include <RenderEngineMeshShader.hpp>
-#include <Gaia.hpp>
-
-RenderEngineMeshDraw::RenderEngineMeshDraw(const Args& arguments) noexcept
-	: RenderEngineBase{ arguments.device.value() }, m_meshletBuffer{ DescriptorType::SRV } {}
-
-void RenderEngineMeshDraw::ExecuteRenderStage(size_t frameIndex) {
-	ID3D12GraphicsCommandList6* graphicsCommandList = Gaia::graphicsCmdList->GetCommandList6();
-
-	ExecutePreGraphicsStage(graphicsCommandList, frameIndex);
-	RecordDrawCommands(graphicsCommandList, frameIndex);
-}
-
-void RenderEngineMeshDraw::BindGraphicsBuffers(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	BindCommonGraphicsBuffers(graphicsCommandList, frameIndex);
-	m_vertexManager.BindVertexBuffers(graphicsCommandList, m_graphicsRSLayout);
-
-	static constexpr auto meshletsIndex = static_cast<size_t>(RootSigElement::Meshlets);
-	graphicsCommandList->SetGraphicsRootDescriptorTable(
-		m_graphicsRSLayout[meshletsIndex], m_meshletBuffer.GetFirstGPUDescriptorHandle()
-	);
-}
-
-void RenderEngineMeshDraw::RecordDrawCommands(
-	ID3D12GraphicsCommandList6* graphicsCommandList, size_t frameIndex
-) {
-	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
-
-	// One Pipeline needs to be bound before Descriptors can be bound.
-	m_graphicsPipeline0->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
-	BindGraphicsBuffers(graphicsCommandList, frameIndex);
-
-	m_graphicsPipeline0->DrawModels(graphicsCommandList, m_graphicsRSLayout);
-
-	for (auto& graphicsPipeline : m_graphicsPipelines) {
-		graphicsPipeline->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
-		graphicsPipeline->DrawModels(graphicsCommandList, m_graphicsRSLayout);
-	}
-}
-
-void RenderEngineMeshDraw::UpdateModelBuffers(size_t frameIndex) const noexcept {
-	Gaia::bufferManager->Update<true>(frameIndex);
-}
-
-void RenderEngineMeshDraw::AddMeshletModelSet(
-	std::vector<MeshletModel>& meshletModels, const std::wstring& pixelShader
-) noexcept {
-	auto graphicsPipeline = std::make_unique<GraphicsPipelineMeshShader>();
-
-	graphicsPipeline->ConfigureGraphicsPipelineObject(pixelShader);
-
-	static std::uint32_t modelCount = 0u;
-
-	for (size_t index = 0u; index < std::size(meshletModels); ++index) {
-		std::vector<Meshlet>&& meshlets = std::move(meshletModels[index].meshlets);
-
-		graphicsPipeline->AddModelDetails(
-			static_cast<std::uint32_t>(std::size(meshlets)),
-			static_cast<std::uint32_t>(std::size(m_meshlets)), modelCount
-		);
-
-		++modelCount;
-
-		std::ranges::move(meshlets, std::back_inserter(m_meshlets));
-	}
-
-	if (!m_graphicsPipeline0)
-		m_graphicsPipeline0 = std::move(graphicsPipeline);
-	else
-		m_graphicsPipelines.emplace_back(std::move(graphicsPipeline));
-}
-
-void RenderEngineMeshDraw::AddGVerticesAndPrimIndices(
-	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
-	std::vector<std::uint32_t>&& gPrimIndices
-) noexcept {
-	m_vertexManager.AddGVerticesAndPrimIndices(
-		std::move(gVertices), std::move(gVerticesIndices), std::move(gPrimIndices)
-	);
-}
-
-void RenderEngineMeshDraw::CreateBuffers(ID3D12Device* device) {
-	m_vertexManager.CreateBuffers(device);
-
-	CreateUploadDescView(device, m_meshletBuffer, m_meshlets);
-}
-
-void RenderEngineMeshDraw::RecordResourceUploads(
-	ID3D12GraphicsCommandList* copyList
-) noexcept {
-	m_vertexManager.RecordResourceUpload(copyList);
-	m_meshletBuffer.RecordResourceUpload(copyList);
-}
-
-void RenderEngineMeshDraw::ReleaseUploadResources() noexcept {
-	m_vertexManager.ReleaseUploadResource();
-	m_meshletBuffer.ReleaseUploadResource();
-
-	m_meshlets = std::vector<Meshlet>{};
-}
-
-void RenderEngineMeshDraw::ReserveBuffersDerived(ID3D12Device* device) {
-	m_vertexManager.ReserveBuffers(device);
-
-	const size_t meshletDescriptorOffset =
-		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset();
-
-	SetDescBufferInfo(device, meshletDescriptorOffset, m_meshlets, m_meshletBuffer);
-}
-
-void RenderEngineMeshDraw::ConstructPipelines() {
-	ID3D12Device2* device = Gaia::device->GetDeviceRef();
-
-	ConstructGraphicsRootSignature(device);
-	CreateGraphicsPipelines(device, m_graphicsPipeline0, m_graphicsPipelines);
-}
-
-std::unique_ptr<RootSignatureDynamic> RenderEngineMeshDraw::CreateGraphicsRootSignature(
-	ID3D12Device* device
-) const noexcept {
-	auto signature = std::make_unique<RootSignatureDynamic>();
-
-	signature->AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, D3D12_SHADER_VISIBILITY_PIXEL,
-		RootSigElement::Textures, true, 0u, 1u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
-		RootSigElement::ModelData, false, 0u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
-		RootSigElement::MaterialData, false, 1u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
-		RootSigElement::LightData, false, 2u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
-		RootSigElement::VertexData, false, 3u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
-		RootSigElement::VertexIndices, false, 4u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
-		RootSigElement::PrimIndices, false, 5u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
-		RootSigElement::Meshlets, false, 6u
-	).AddConstants(
-		2u, D3D12_SHADER_VISIBILITY_MESH, RootSigElement::ModelInfo, 0u
-	).AddConstantBufferView(
-		D3D12_SHADER_VISIBILITY_MESH, RootSigElement::Camera, 1u
-	).AddConstantBufferView(
-		D3D12_SHADER_VISIBILITY_PIXEL, RootSigElement::PixelData, 2u
-	).CompileSignature().CreateSignature(device);
-
-	return signature;
-}
+#include <ranges>
+#include <algorithm>
+#include <RenderEngineMeshShader.hpp>
+#include <Gaia.hpp>
+#include <MeshletCuller.hpp>
+
+RenderEngineMeshDraw::RenderEngineMeshDraw(const Args& arguments) noexcept
+	: RenderEngineBase{ arguments.device.value() }, m_meshletBuffer{ DescriptorType::SRV },
+	m_meshletBoundsBuffer{ DescriptorType::SRV } {}
+
+void RenderEngineMeshDraw::RegisterFrameTasks(FrameTaskGraph& frameTasks) {
+	RegisterBufferUpdateTasks(frameTasks, true);
+	RegisterPreGraphicsTask(frameTasks);
+
+	frameTasks.AddTask(
+		"RecordDrawCommands",
+		[this](size_t frameIndex) {
+			RecordDrawCommands(Gaia::graphicsCmdList->GetCommandList6(), frameIndex);
+		},
+		FrameResource::None, FrameResource::GraphicsCommandList
+	);
+}
+
+void RenderEngineMeshDraw::BindGraphicsBuffers(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) {
+	BindCommonGraphicsBuffers(graphicsCommandList, frameIndex);
+	m_vertexManager.BindVertexBuffers(graphicsCommandList, m_graphicsRSLayout);
+
+	static constexpr auto meshletsIndex = static_cast<size_t>(RootSigElement::Meshlets);
+	graphicsCommandList->SetGraphicsRootDescriptorTable(
+		m_graphicsRSLayout[meshletsIndex], m_meshletBuffer.GetFirstGPUDescriptorHandle()
+	);
+
+	static constexpr auto boundsIndex = static_cast<size_t>(RootSigElement::MeshletBounds);
+	graphicsCommandList->SetGraphicsRootDescriptorTable(
+		m_graphicsRSLayout[boundsIndex], m_meshletBoundsBuffer.GetFirstGPUDescriptorHandle()
+	);
+}
+
+void RenderEngineMeshDraw::RecordDrawCommands(
+	ID3D12GraphicsCommandList6* graphicsCommandList, size_t frameIndex
+) {
+	size_t drawCount = m_graphicsPipeline0->GetModelCount();
+
+	for (auto& graphicsPipeline : m_graphicsPipelines)
+		drawCount += graphicsPipeline->GetModelCount();
+
+	if (ShouldRecordInParallel(drawCount)) {
+		RecordDrawCommandsInParallel(frameIndex);
+
+		return;
+	}
+
+	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
+
+	// One Pipeline needs to be bound before Descriptors can be bound.
+	m_graphicsPipeline0->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
+	BindGraphicsBuffers(graphicsCommandList, frameIndex);
+
+	m_graphicsPipeline0->DrawModels(
+		graphicsCommandList, m_graphicsRSLayout, 0u, m_graphicsPipeline0->GetModelCount()
+	);
+
+	const GraphicsPipelineMeshShader* boundPipeline = m_graphicsPipeline0.get();
+
+	// The root signature stays bound, so only the pipeline objects which differ are switched.
+	for (auto& graphicsPipeline : m_graphicsPipelines) {
+		if (!graphicsPipeline->SharesPipelineObject(*boundPipeline)) {
+			graphicsPipeline->SwitchGraphicsPipeline(graphicsCommandList);
+			boundPipeline = graphicsPipeline.get();
+		}
+
+		graphicsPipeline->DrawModels(
+			graphicsCommandList, m_graphicsRSLayout, 0u, graphicsPipeline->GetModelCount()
+		);
+	}
+}
+
+void RenderEngineMeshDraw::RecordDrawCommandsInParallel(size_t frameIndex) {
+	m_drawRanges.clear();
+
+	AddDrawRanges(m_drawRanges, 0u, m_graphicsPipeline0->GetModelCount());
+
+	for (size_t index = 0u; index < std::size(m_graphicsPipelines); ++index)
+		AddDrawRanges(m_drawRanges, index + 1u, m_graphicsPipelines[index]->GetModelCount());
+
+	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
+
+	RecordDrawJobs(
+		std::size(m_drawRanges),
+		[&](D3DCommandList& drawCommandList, size_t jobIndex) {
+			const DrawRange& drawRange = m_drawRanges[jobIndex];
+			GraphicsPipelineMeshShader* graphicsPipeline =
+				GetGraphicsPipeline(drawRange.pipelineIndex);
+			ID3D12GraphicsCommandList6* graphicsCommandList = drawCommandList.GetCommandList6();
+
+			graphicsPipeline->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
+			BindGraphicsBuffers(graphicsCommandList, frameIndex);
+
+			graphicsPipeline->DrawModels(
+				graphicsCommandList, m_graphicsRSLayout, drawRange.drawStart, drawRange.drawEnd
+			);
+		},
+		frameIndex
+	);
+}
+
+GraphicsPipelineMeshShader* RenderEngineMeshDraw::GetGraphicsPipeline(
+	size_t modelSetIndex
+) const noexcept {
+	if (modelSetIndex == 0u)
+		return m_graphicsPipeline0.get();
+
+	return m_graphicsPipelines[modelSetIndex - 1u].get();
+}
+
+void RenderEngineMeshDraw::AddMeshletModelSet(
+	std::vector<MeshletModel>& meshletModels, const std::wstring& pixelShader
+) noexcept {
+	auto graphicsPipeline = std::make_unique<GraphicsPipelineMeshShader>();
+
+	graphicsPipeline->ConfigureGraphicsPipelineObject(pixelShader);
+
+	static std::uint32_t modelCount = 0u;
+
+	for (size_t index = 0u; index < std::size(meshletModels); ++index) {
+		std::vector<Meshlet>&& meshlets = std::move(meshletModels[index].meshlets);
+
+		graphicsPipeline->AddModelDetails(
+			static_cast<std::uint32_t>(std::size(meshlets)),
+			static_cast<std::uint32_t>(std::size(m_meshlets)), modelCount
+		);
+
+		++modelCount;
+
+		std::ranges::move(meshlets, std::back_inserter(m_meshlets));
+	}
+
+	if (!m_graphicsPipeline0)
+		m_graphicsPipeline0 = std::move(graphicsPipeline);
+	else
+		m_graphicsPipelines.emplace_back(std::move(graphicsPipeline));
+}
+
+void RenderEngineMeshDraw::AddGVerticesAndPrimIndices(
+	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
+	std::vector<std::uint32_t>&& gPrimIndices
+) noexcept {
+	m_vertexManager.AddGVerticesAndPrimIndices(
+		std::move(gVertices), std::move(gVerticesIndices), std::move(gPrimIndices)
+	);
+}
+
+void RenderEngineMeshDraw::CreateBuffers(ID3D12Device* device) {
+	m_vertexManager.CreateBuffers(device);
+
+	CreateUploadDescView(device, m_meshletBuffer, m_meshlets);
+	CreateUploadDescView(device, m_meshletBoundsBuffer, m_meshletBounds);
+}
+
+void RenderEngineMeshDraw::RecordResourceUploads(
+	ID3D12GraphicsCommandList* copyList
+) noexcept {
+	m_vertexManager.RecordResourceUpload(copyList);
+	m_meshletBuffer.RecordResourceUpload(copyList);
+	m_meshletBoundsBuffer.RecordResourceUpload(copyList);
+}
+
+void RenderEngineMeshDraw::ReleaseUploadResources() noexcept {
+	m_vertexManager.ReleaseUploadResource();
+	m_meshletBuffer.ReleaseUploadResource();
+	m_meshletBoundsBuffer.ReleaseUploadResource();
+
+	m_meshlets = std::vector<Meshlet>{};
+	m_meshletBounds = std::vector<MeshletBounds>{};
+}
+
+void RenderEngineMeshDraw::ReserveBuffersDerived(ID3D12Device* device) {
+	m_vertexManager.ReserveBuffers(device);
+
+	const size_t meshletDescriptorOffset =
+		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset();
+
+	SetDescBufferInfo(device, meshletDescriptorOffset, m_meshlets, m_meshletBuffer);
+
+	// The vertices and the meshlets can be added in either order, both are here by now.
+	ComputeMeshletBounds();
+
+	const size_t boundsDescriptorOffset =
+		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset();
+
+	SetDescBufferInfo(device, boundsDescriptorOffset, m_meshletBounds, m_meshletBoundsBuffer);
+}
+
+void RenderEngineMeshDraw::ComputeMeshletBounds() {
+	static constexpr size_t s_meshletsPerJob = 1024u;
+
+	const size_t meshletCount = std::size(m_meshlets);
+	m_meshletBounds.resize(meshletCount);
+
+	Gaia::RunJobs(
+		(meshletCount + s_meshletsPerJob - 1u) / s_meshletsPerJob,
+		[this, meshletCount](size_t jobIndex) {
+			const size_t meshletEnd = std::min((jobIndex + 1u) * s_meshletsPerJob, meshletCount);
+
+			for (size_t index = jobIndex * s_meshletsPerJob; index < meshletEnd; ++index)
+				m_meshletBounds[index] = MeshletCuller::ComputeBounds(
+					m_meshlets[index], m_vertexManager.GetVertices(),
+					m_vertexManager.GetVertexIndices(), m_vertexManager.GetPrimIndices()
+				);
+		}
+	);
+}
+
+void RenderEngineMeshDraw::ConstructPipelines() {
+	ID3D12Device2* device = Gaia::device->GetDeviceRef();
+
+	ConstructGraphicsRootSignature(device);
+	CreateGraphicsPipelines(device, m_graphicsPipeline0, m_graphicsPipelines);
+}
+
+std::unique_ptr<RootSignatureDynamic> RenderEngineMeshDraw::CreateGraphicsRootSignature(
+	ID3D12Device* device
+) const noexcept {
+	auto signature = std::make_unique<RootSignatureDynamic>();
+
+	signature->AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, D3D12_SHADER_VISIBILITY_PIXEL,
+		RootSigElement::Textures, true, 0u, 1u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
+		RootSigElement::ModelData, false, 0u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
+		RootSigElement::MaterialData, false, 1u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
+		RootSigElement::LightData, false, 2u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
+		RootSigElement::VertexData, false, 3u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
+		RootSigElement::VertexIndices, false, 4u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
+		RootSigElement::PrimIndices, false, 5u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_MESH,
+		RootSigElement::Meshlets, false, 6u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_ALL,
+		RootSigElement::MeshletBounds, false, 7u
+	).AddConstants(
+		2u, D3D12_SHADER_VISIBILITY_MESH, RootSigElement::ModelInfo, 0u
+	).AddConstantBufferView(
+		D3D12_SHADER_VISIBILITY_MESH, RootSigElement::Camera, 1u
+	).AddConstantBufferView(
+		D3D12_SHADER_VISIBILITY_PIXEL, RootSigElement::PixelData, 2u
+	).CompileSignature().CreateSignature(device);
+
+	return signature;
+}
@@ -1,304 +1,762 @@
-#include <RenderEngineVertexShader.hpp>
-#include <Gaia.hpp>
-#include <D3DResourceBarrier.hpp>
-#include <VertexLayout.hpp>
-#include <Shader.hpp>
-#include <cassert>
-
-// Vertex Shader
-RenderEngineVertexShader::RenderEngineVertexShader(ID3D12Device* device)
-	: RenderEngineBase{ device } {}
-
-void RenderEngineVertexShader::AddGVerticesAndIndices(
-	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-) noexcept {
-	m_vertexManager.AddGVerticesAndIndices(std::move(gVertices), std::move(gIndices));
-}
-
-void RenderEngineVertexShader::CreateBuffers(ID3D12Device* device) {
-	m_vertexManager.CreateBuffers(device);
-	_createBuffers(device);
-}
-
-void RenderEngineVertexShader::ReserveBuffersDerived(ID3D12Device* device) {
-	m_vertexManager.ReserveBuffers(device);
-	_reserveBuffers(device);
-}
-
-void RenderEngineVertexShader::RecordResourceUploads(
-	ID3D12GraphicsCommandList* copyList
-) noexcept {
-	m_vertexManager.RecordResourceUploads(copyList);
-	_recordResourceUploads(copyList);
-}
-
-void RenderEngineVertexShader::ReleaseUploadResources() noexcept {
-	m_vertexManager.ReleaseUploadResources();
-	_releaseUploadResources();
-}
-
-void RenderEngineVertexShader::_createBuffers([[maybe_unused]] ID3D12Device* device) {}
-void RenderEngineVertexShader::_reserveBuffers([[maybe_unused]] ID3D12Device* device) {}
-void RenderEngineVertexShader::_recordResourceUploads(
-	[[maybe_unused]] ID3D12GraphicsCommandList* copyList
-) noexcept {}
-void RenderEngineVertexShader::_releaseUploadResources() noexcept {}
-
-std::unique_ptr<RootSignatureDynamic> RenderEngineVertexShader::CreateGraphicsRootSignature(
-	ID3D12Device* device
-) const noexcept {
-	auto signature = std::make_unique<RootSignatureDynamic>();
-
-	signature->AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, D3D12_SHADER_VISIBILITY_PIXEL,
-		RootSigElement::Textures, true, 0u, 1u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_VERTEX,
-		RootSigElement::ModelData, false, 0u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
-		RootSigElement::MaterialData, false, 1u
-	).AddDescriptorTable(
-		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
-		RootSigElement::LightData, false, 2u
-	).AddConstants(
-		1u, D3D12_SHADER_VISIBILITY_VERTEX, RootSigElement::ModelInfo, 0u
-	).AddConstantBufferView(
-		D3D12_SHADER_VISIBILITY_VERTEX, RootSigElement::Camera, 1u
-	).AddConstantBufferView(
-		D3D12_SHADER_VISIBILITY_PIXEL, RootSigElement::PixelData, 2u
-	).CompileSignature().CreateSignature(device);
-
-	return signature;
-}
-
-void RenderEngineVertexShader::BindGraphicsBuffers(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	BindCommonGraphicsBuffers(graphicsCommandList, frameIndex);
-	m_vertexManager.BindVertexAndIndexBuffer(graphicsCommandList);
-}
-
-void RenderEngineVertexShader::ExecuteRenderStage(size_t frameIndex) {
-	ID3D12GraphicsCommandList* graphicsCommandList = Gaia::graphicsCmdList->GetCommandList();
-
-	ExecutePreRenderStage(graphicsCommandList, frameIndex);
-	RecordDrawCommands(graphicsCommandList, frameIndex);
-}
-
-// Indirect Draw
-RenderEngineIndirectDraw::RenderEngineIndirectDraw(const Args& arguments)
-	: RenderEngineVertexShader{ arguments.device.value() },
-	m_computePipeline{ arguments.frameCount.value() } {}
-
-void RenderEngineIndirectDraw::ExecuteComputeStage(size_t frameIndex) {
-	ID3D12GraphicsCommandList* computeCommandList = Gaia::computeCmdList->GetCommandList();
-	Gaia::computeCmdList->Reset(frameIndex);
-
-	ID3D12DescriptorHeap* descriptorHeap[] = { Gaia::descriptorTable->GetDescHeapRef() };
-	computeCommandList->SetDescriptorHeaps(1u, descriptorHeap);
-
-	// Record compute commands
-	m_computePipeline.ResetCounterBuffer(computeCommandList, frameIndex);
-
-	m_computePipeline.BindComputePipeline(computeCommandList);
-
-	Gaia::bufferManager->BindBuffersToCompute(computeCommandList, frameIndex);
-	m_computePipeline.DispatchCompute(computeCommandList, frameIndex);
-
-	Gaia::computeCmdList->Close();
-	Gaia::computeQueue->ExecuteCommandLists(computeCommandList);
-
-	UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
-
-	Gaia::computeQueue->SignalCommandQueue(Gaia::computeFence->GetFence(), fenceValue);
-
-	Gaia::graphicsQueue->WaitOnGPU(Gaia::computeFence->GetFence(), fenceValue);
-}
-
-void RenderEngineIndirectDraw::ExecutePreRenderStage(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	ExecuteComputeStage(frameIndex);
-	ExecutePreGraphicsStage(graphicsCommandList, frameIndex);
-}
-
-void RenderEngineIndirectDraw::UpdateModelBuffers(size_t frameIndex) const noexcept {
-	Gaia::bufferManager->Update<false>(frameIndex);
-}
-
-void RenderEngineIndirectDraw::RecordDrawCommands(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
-
-	// One Pipeline needs to be bound before Descriptors can be bound.
-	m_graphicsPipeline0->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
-	BindGraphicsBuffers(graphicsCommandList, frameIndex);
-
-	m_graphicsPipeline0->DrawModels(
-		m_commandSignature.Get(), graphicsCommandList,
-		m_computePipeline.GetArgumentBuffer(frameIndex),
-		m_computePipeline.GetCounterBuffer(frameIndex)
-	);
-
-	for (auto& graphicsPipeline : m_graphicsPipelines) {
-		graphicsPipeline->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
-		graphicsPipeline->DrawModels(
-			m_commandSignature.Get(), graphicsCommandList,
-			m_computePipeline.GetArgumentBuffer(frameIndex),
-			m_computePipeline.GetCounterBuffer(frameIndex)
-		);
-	}
-}
-
-void RenderEngineIndirectDraw::ConstructPipelines() {
-	ID3D12Device2* device = Gaia::device->GetDeviceRef();
-
-	ConstructGraphicsRootSignature(device);
-	CreateGraphicsPipelines(device, m_graphicsPipeline0, m_graphicsPipelines);
-
-	m_computePipeline.CreateComputeRootSignature(device);
-
-	m_computePipeline.CreateComputePipelineObject(device, m_shaderPath);
-	Gaia::bufferManager->SetComputeRootSignatureLayout(
-		m_computePipeline.GetComputeRSLayout()
-	);
-
-	CreateCommandSignature(device);
-}
-
-void RenderEngineIndirectDraw::RecordModelDataSet(
-	const std::vector<std::shared_ptr<IModel>>& models, const std::wstring& pixelShader
-) noexcept {
-	auto graphicsPipeline = std::make_unique<GraphicsPipelineIndirectDraw>();
-
-	// old currentModelCount hold the modelCountOffset value
-	graphicsPipeline->ConfigureGraphicsPipelineObject(
-		pixelShader, static_cast<std::uint32_t>(std::size(models)),
-		m_computePipeline.GetCurrentModelCount(), m_computePipeline.GetCounterCount()
-	);
-
-	m_computePipeline.RecordIndirectArguments(models);
-
-	if (!m_graphicsPipeline0)
-		m_graphicsPipeline0 = std::move(graphicsPipeline);
-	else
-		m_graphicsPipelines.emplace_back(std::move(graphicsPipeline));
-}
-
-void RenderEngineIndirectDraw::_createBuffers(ID3D12Device* device) {
-	m_computePipeline.CreateBuffers(device);
-}
-
-void RenderEngineIndirectDraw::_reserveBuffers(ID3D12Device* device) {
-	m_computePipeline.ReserveBuffers(device);
-}
-
-void RenderEngineIndirectDraw::_recordResourceUploads(
-	ID3D12GraphicsCommandList* copyList
-) noexcept {
-	m_computePipeline.RecordResourceUpload(copyList);
-}
-
-void RenderEngineIndirectDraw::_releaseUploadResources() noexcept {
-	m_computePipeline.ReleaseUploadResource();
-}
-
-void RenderEngineIndirectDraw::CreateCommandSignature(ID3D12Device* device) {
-	static constexpr size_t modelInfoIndex = static_cast<size_t>(RootSigElement::ModelInfo);
-
-	std::array<D3D12_INDIRECT_ARGUMENT_DESC, 2u> arguments{};
-	arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
-	arguments[0].Constant.RootParameterIndex = m_graphicsRSLayout[modelInfoIndex];
-	arguments[0].Constant.DestOffsetIn32BitValues = 0u;
-	arguments[0].Constant.Num32BitValuesToSet = 1u;
-	arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
-
-	D3D12_COMMAND_SIGNATURE_DESC desc{};
-	desc.ByteStride = static_cast<UINT>(sizeof(ModelDrawArguments));
-	desc.NumArgumentDescs = static_cast<UINT>(std::size(arguments));
-	desc.pArgumentDescs = std::data(arguments);
-
-	assert(m_graphicsRS->Get() != nullptr && "Graphics RootSignature not initialised");
-
-	device->CreateCommandSignature(
-		&desc, m_graphicsRS->Get(), IID_PPV_ARGS(&m_commandSignature)
-	);
-}
-
-// Individual Draw
-RenderEngineIndividualDraw::RenderEngineIndividualDraw(const Args& arguments)
-	: RenderEngineVertexShader{ arguments.device.value() } {}
-
-void RenderEngineIndividualDraw::ExecutePreRenderStage(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	ExecutePreGraphicsStage(graphicsCommandList, frameIndex);
-}
-
-void RenderEngineIndividualDraw::UpdateModelBuffers(size_t frameIndex) const noexcept {
-	Gaia::bufferManager->Update<true>(frameIndex);
-}
-
-void RenderEngineIndividualDraw::RecordDrawCommands(
-	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
-) {
-	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
-
-	// One Pipeline needs to be bound before Descriptors can be bound.
-	m_graphicsPipeline0->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
-	BindGraphicsBuffers(graphicsCommandList, frameIndex);
-
-	m_graphicsPipeline0->DrawModels(graphicsCommandList, m_modelArguments, m_graphicsRSLayout);
-
-	for (auto& graphicsPipeline : m_graphicsPipelines) {
-		graphicsPipeline->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
-		graphicsPipeline->DrawModels(graphicsCommandList, m_modelArguments, m_graphicsRSLayout);
-	}
-}
-
-void RenderEngineIndividualDraw::ConstructPipelines() {
-	ID3D12Device2* device = Gaia::device->GetDeviceRef();
-
-	ConstructGraphicsRootSignature(device);
-	CreateGraphicsPipelines(device, m_graphicsPipeline0, m_graphicsPipelines);
-}
-
-void RenderEngineIndividualDraw::RecordModelDataSet(
-	const std::vector<std::shared_ptr<IModel>>& models, const std::wstring& pixelShader
-) noexcept {
-	auto graphicsPipeline = std::make_unique<GraphicsPipelineIndividualDraw>();
-
-	graphicsPipeline->ConfigureGraphicsPipelineObject(
-		pixelShader, static_cast<std::uint32_t>(std::size(models)), std::size(m_modelArguments)
-	);
-
-	RecordModelArguments(models);
-
-	if (!m_graphicsPipeline0)
-		m_graphicsPipeline0 = std::move(graphicsPipeline);
-	else
-		m_graphicsPipelines.emplace_back(std::move(graphicsPipeline));
-}
-
-void RenderEngineIndividualDraw::RecordModelArguments(
-	const std::vector<std::shared_ptr<IModel>>& models
-) noexcept {
-	for (const auto& model : models) {
-		D3D12_DRAW_INDEXED_ARGUMENTS arguments{
-			.IndexCountPerInstance = model->GetIndexCount(),
-			.InstanceCount = 1u,
-			.StartIndexLocation = model->GetIndexOffset(),
-			.BaseVertexLocation = 0u,
-			.StartInstanceLocation = 0u
-		};
-
-		ModelDrawArguments modelArgs{
-			.modelIndex = static_cast<std::uint32_t>(std::size(m_modelArguments)),
-			.drawIndexed = arguments
-		};
-
-		m_modelArguments.emplace_back(modelArgs);
-	}
-}
+#include <RenderEngineVertexShader.hpp>
+#include <Gaia.hpp>
+#include <D3DResourceBarrier.hpp>
+#include <VertexLayout.hpp>
+#include <Shader.hpp>
+#include <Exception.hpp>
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+
+// Vertex Shader
+RenderEngineVertexShader::RenderEngineVertexShader(
+	ID3D12Device* device, VertexFormat vertexFormat
+) : RenderEngineBase{ device }, m_vertexFormat{ vertexFormat },
+	m_vertexManager{ vertexFormat } {}
+
+ModelInputRange RenderEngineVertexShader::AddGVerticesAndIndices(
+	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+) {
+	return m_vertexManager.AddGVerticesAndIndices(std::move(gVertices), std::move(gIndices));
+}
+
+ModelInputRange RenderEngineVertexShader::AddGVerticesAndIndices(
+	std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+) {
+	return m_vertexManager.AddGVerticesAndIndices(std::move(gVertices), std::move(gIndices));
+}
+
+void RenderEngineVertexShader::RemoveGVerticesAndIndices(size_t inputId) {
+	m_vertexManager.RemoveGVerticesAndIndices(inputId);
+}
+
+void RenderEngineVertexShader::SetSpareInputCapacity(
+	size_t vertexCount, size_t indexCount
+) noexcept {
+	m_vertexManager.SetSpareCapacity(vertexCount, indexCount);
+}
+
+void RenderEngineVertexShader::RecordRuntimeUploads(
+	ID3D12GraphicsCommandList* graphicsCommandList
+) {
+	m_vertexManager.RecordRuntimeUploads(graphicsCommandList);
+}
+
+void RenderEngineVertexShader::CreateBuffers(ID3D12Device* device) {
+	m_vertexManager.CreateBuffers(device);
+	_createBuffers(device);
+}
+
+void RenderEngineVertexShader::ReserveBuffersDerived(ID3D12Device* device) {
+	m_vertexManager.ReserveBuffers(device);
+	_reserveBuffers(device);
+}
+
+void RenderEngineVertexShader::RecordResourceUploads(
+	ID3D12GraphicsCommandList* copyList
+) noexcept {
+	m_vertexManager.RecordResourceUploads(copyList);
+	_recordResourceUploads(copyList);
+}
+
+void RenderEngineVertexShader::ReleaseUploadResources() noexcept {
+	m_vertexManager.ReleaseUploadResources();
+	_releaseUploadResources();
+}
+
+void RenderEngineVertexShader::_createBuffers([[maybe_unused]] ID3D12Device* device) {}
+void RenderEngineVertexShader::_reserveBuffers([[maybe_unused]] ID3D12Device* device) {}
+void RenderEngineVertexShader::_recordResourceUploads(
+	[[maybe_unused]] ID3D12GraphicsCommandList* copyList
+) noexcept {}
+void RenderEngineVertexShader::_releaseUploadResources() noexcept {}
+void RenderEngineVertexShader::_addGraphicsRootParameters(
+	[[maybe_unused]] RootSignatureDynamic& signature
+) const noexcept {}
+
+std::unique_ptr<RootSignatureDynamic> RenderEngineVertexShader::CreateGraphicsRootSignature(
+	ID3D12Device* device
+) const noexcept {
+	auto signature = std::make_unique<RootSignatureDynamic>();
+
+	signature->AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, D3D12_SHADER_VISIBILITY_PIXEL,
+		RootSigElement::Textures, true, 0u, 1u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_VERTEX,
+		RootSigElement::ModelData, false, 0u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
+		RootSigElement::MaterialData, false, 1u
+	).AddDescriptorTable(
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_PIXEL,
+		RootSigElement::LightData, false, 2u
+	).AddConstants(
+		1u, D3D12_SHADER_VISIBILITY_VERTEX, RootSigElement::ModelInfo, 0u
+	).AddConstantBufferView(
+		D3D12_SHADER_VISIBILITY_VERTEX, RootSigElement::Camera, 1u
+	).AddConstantBufferView(
+		D3D12_SHADER_VISIBILITY_PIXEL, RootSigElement::PixelData, 2u
+	);
+
+	_addGraphicsRootParameters(*signature);
+
+	signature->CompileSignature().CreateSignature(device);
+
+	return signature;
+}
+
+void RenderEngineVertexShader::BindGraphicsBuffers(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) {
+	BindCommonGraphicsBuffers(graphicsCommandList, frameIndex);
+	m_vertexManager.BindVertexAndIndexBuffer(graphicsCommandList);
+}
+
+void RenderEngineVertexShader::RegisterDrawTask(
+	FrameTaskGraph& frameTasks, FrameResource reads
+) {
+	frameTasks.AddTask(
+		"RecordDrawCommands",
+		[this](size_t frameIndex) {
+			RecordDrawCommands(Gaia::graphicsCmdList->GetCommandList(), frameIndex);
+		},
+		reads, FrameResource::GraphicsCommandList
+	);
+}
+
+// Indirect Draw
+RenderEngineIndirectDraw::RenderEngineIndirectDraw(const Args& arguments)
+	: RenderEngineVertexShader{ arguments.device.value(), arguments.vertexFormat.value() },
+	m_computePipeline{ arguments.frameCount.value() },
+	m_cullingSchedule{ arguments.frameCount.value() }, m_frameSync{} {}
+
+void RenderEngineIndirectDraw::SetCullingOverlap(bool enable) noexcept {
+	m_cullingSchedule.SetOverlap(enable);
+}
+
+void RenderEngineIndirectDraw::ScheduleCulling(size_t frameIndex) {
+	m_frameSync = m_cullingSchedule.ScheduleFrame(
+		frameIndex, Gaia::graphicsFence->GetFrontValue()
+	);
+
+	// Waiting for the graphics queue doesn't cover the culling anymore once it overlaps.
+	Gaia::computeFence->WaitOnCPUConditional(m_frameSync.cpuWaitOnCompute);
+}
+
+void RenderEngineIndirectDraw::ExecuteComputeStage(size_t frameIndex) {
+	ID3D12GraphicsCommandList* computeCommandList = Gaia::computeCmdList->GetCommandList();
+	Gaia::computeCmdList->Reset(frameIndex);
+
+	ID3D12DescriptorHeap* descriptorHeap[] = { Gaia::descriptorTable->GetDescHeapRef() };
+	computeCommandList->SetDescriptorHeaps(1u, descriptorHeap);
+
+	// Record compute commands
+	m_computePipeline.RecordRuntimeUploads(computeCommandList, frameIndex);
+	m_computePipeline.ResetCounterBuffer(computeCommandList, frameIndex);
+
+	m_computePipeline.BindComputePipeline(computeCommandList);
+
+	Gaia::bufferManager->BindBuffersToCompute(computeCommandList, frameIndex);
+	m_computePipeline.DispatchCompute(computeCommandList, frameIndex);
+
+	Gaia::computeCmdList->Close();
+
+	ID3D12CommandQueue* computeQueue = Gaia::computeQueue->GetQueue();
+
+	Gaia::graphicsFence->WaitOnQueue(computeQueue, m_frameSync.computeWaitOnGraphics);
+	Gaia::computeQueue->ExecuteCommandLists(Gaia::computeCmdList->GetExecutableCommandList());
+	Gaia::computeFence->SignalOnQueue(computeQueue, m_frameSync.computeSignal);
+
+	// With the overlap, this culling's results are drawn by the next frame.
+	Gaia::computeFence->WaitOnQueue(
+		Gaia::graphicsQueue->GetQueue(), m_frameSync.graphicsWaitOnCompute
+	);
+}
+
+void RenderEngineIndirectDraw::RegisterFrameTasks(FrameTaskGraph& frameTasks) {
+	// The slot's buffers can still be read by the culling of an earlier frame.
+	frameTasks.AddTask(
+		"ScheduleCulling",
+		[this](size_t frameIndex) { ScheduleCulling(frameIndex); },
+		FrameResource::None,
+		FrameResource::Camera | FrameResource::ModelBuffers | FrameResource::ComputeCommandList
+	);
+
+	RegisterBufferUpdateTasks(frameTasks, false);
+
+	// The list is submitted straight away, so the buffers it reads must be written already.
+	frameTasks.AddTask(
+		"ExecuteComputeStage",
+		[this](size_t frameIndex) { ExecuteComputeStage(frameIndex); },
+		FrameResource::Camera | FrameResource::ModelBuffers, FrameResource::ComputeCommandList
+	);
+
+	RegisterPreGraphicsTask(frameTasks);
+	// The slot it draws with is picked by the schedule.
+	RegisterDrawTask(frameTasks, FrameResource::ComputeCommandList);
+}
+
+void RenderEngineIndirectDraw::RecordDrawCommands(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) {
+	// Nothing has been added yet.
+	if (!m_graphicsPipeline0)
+		return;
+
+	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
+	ID3D12Resource* argumentBuffer = m_computePipeline.GetArgumentBuffer(m_frameSync.drawSlot);
+	ID3D12Resource* counterBuffer = m_computePipeline.GetCounterBuffer(m_frameSync.drawSlot);
+
+	// One Pipeline needs to be bound before Descriptors can be bound.
+	m_graphicsPipeline0->BindGraphicsPipeline(graphicsCommandList, graphicsRS);
+	BindGraphicsBuffers(graphicsCommandList, frameIndex);
+
+	const GraphicsPipelineIndirectDraw* boundPipeline = m_graphicsPipeline0.get();
+
+	// The root signature stays bound, so only the pipeline objects which differ are switched.
+	for (size_t modelSetIndex : m_drawOrder) {
+		const GraphicsPipelineIndirectDraw* graphicsPipeline = GetGraphicsPipeline(modelSetIndex);
+
+		if (!graphicsPipeline->SharesPipelineObject(*boundPipeline)) {
+			graphicsPipeline->SwitchGraphicsPipeline(graphicsCommandList);
+			boundPipeline = graphicsPipeline;
+		}
+
+		graphicsPipeline->DrawModels(
+			m_commandSignature.Get(), graphicsCommandList, argumentBuffer, counterBuffer
+		);
+	}
+}
+
+void RenderEngineIndirectDraw::UpdateDrawOrder() {
+	m_drawOrder.clear();
+
+	for (size_t modelSetIndex = 0u; modelSetIndex < std::size(m_setArgumentRanges);
+		++modelSetIndex)
+		if (m_setArgumentRanges[modelSetIndex])
+			m_drawOrder.emplace_back(modelSetIndex);
+
+	std::ranges::stable_sort(
+		m_drawOrder, {},
+		[this](size_t modelSetIndex) -> const std::wstring& {
+			return GetGraphicsPipeline(modelSetIndex)->GetPixelShader();
+		}
+	);
+}
+
+GraphicsPipelineIndirectDraw* RenderEngineIndirectDraw::GetGraphicsPipeline(
+	size_t modelSetIndex
+) const noexcept {
+	if (modelSetIndex == 0u)
+		return m_graphicsPipeline0.get();
+
+	return m_graphicsPipelines[modelSetIndex - 1u].get();
+}
+
+void RenderEngineIndirectDraw::ConstructPipelines() {
+	ID3D12Device2* device = Gaia::device->GetDeviceRef();
+
+	ConstructGraphicsRootSignature(device);
+	m_computePipeline.CreateComputeRootSignature(device);
+
+	// The compute object is created alongside the graphics ones.
+	CreateGraphicsPipelines(
+		device, m_graphicsPipeline0, m_graphicsPipelines,
+		{ [this, device] { m_computePipeline.CreateComputePipelineObject(device, m_shaderPath); } }
+	);
+
+	Gaia::bufferManager->SetComputeRootSignatureLayout(
+		m_computePipeline.GetComputeRSLayout()
+	);
+
+	CreateCommandSignature(device);
+}
+
+size_t RenderEngineIndirectDraw::RecordModelDataSet(
+	const std::vector<std::shared_ptr<IModel>>& models,
+	const std::vector<std::uint32_t>& modelIds, const std::wstring& pixelShader
+) {
+	const ComputePipelineIndirectDraw::ArgumentRange argumentRange =
+		m_computePipeline.RecordIndirectArguments(models, modelIds);
+
+	// The earlier results don't have the new set's arguments.
+	m_cullingSchedule.ResetHistory();
+
+	auto graphicsPipeline = std::make_unique<GraphicsPipelineIndirectDraw>();
+
+	graphicsPipeline->SetVertexFormat(m_vertexFormat);
+	graphicsPipeline->ConfigureGraphicsPipelineObject(
+		pixelShader, argumentRange.argumentCount, argumentRange.argumentOffset,
+		argumentRange.counterIndex
+	);
+
+	const size_t modelSetIndex = AddGraphicsPipeline(
+		Gaia::device->GetDeviceRef(), std::move(graphicsPipeline), m_graphicsPipeline0,
+		m_graphicsPipelines
+	);
+
+	if (modelSetIndex >= std::size(m_setArgumentRanges))
+		m_setArgumentRanges.resize(modelSetIndex + 1u);
+
+	m_setArgumentRanges[modelSetIndex] = argumentRange;
+
+	UpdateDrawOrder();
+
+	return modelSetIndex;
+}
+
+void RenderEngineIndirectDraw::RemoveModelDataSet(size_t modelSetIndex) {
+	auto& argumentRange = m_setArgumentRanges[modelSetIndex];
+
+	if (!argumentRange)
+		return;
+
+	m_computePipeline.RemoveIndirectArguments(*argumentRange);
+	argumentRange.reset();
+	m_cullingSchedule.ResetHistory();
+
+	// The first pipeline is kept to bind the descriptors with, it just doesn't draw anymore.
+	if (modelSetIndex == 0u)
+		m_graphicsPipeline0->ClearModels();
+	else
+		ReleaseGraphicsPipeline(std::move(m_graphicsPipelines[modelSetIndex - 1u]));
+
+	UpdateDrawOrder();
+}
+
+void RenderEngineIndirectDraw::SetSpareCapacity(
+	size_t modelCount, size_t modelSetCount, size_t vertexCount, size_t indexCount
+) noexcept {
+	m_computePipeline.SetSpareCapacity(modelCount, modelSetCount);
+	SetSpareInputCapacity(vertexCount, indexCount);
+}
+
+void RenderEngineIndirectDraw::_createBuffers(ID3D12Device* device) {
+	m_computePipeline.CreateBuffers(device);
+}
+
+void RenderEngineIndirectDraw::_reserveBuffers(ID3D12Device* device) {
+	m_computePipeline.ReserveBuffers(device);
+}
+
+void RenderEngineIndirectDraw::_recordResourceUploads(
+	ID3D12GraphicsCommandList* copyList
+) noexcept {
+	m_computePipeline.RecordResourceUpload(copyList);
+}
+
+void RenderEngineIndirectDraw::_releaseUploadResources() noexcept {
+	m_computePipeline.ReleaseUploadResource();
+}
+
+void RenderEngineIndirectDraw::CreateCommandSignature(ID3D12Device* device) {
+	static constexpr size_t modelInfoIndex = static_cast<size_t>(RootSigElement::ModelInfo);
+
+	std::array<D3D12_INDIRECT_ARGUMENT_DESC, 2u> arguments{};
+	arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+	arguments[0].Constant.RootParameterIndex = m_graphicsRSLayout[modelInfoIndex];
+	arguments[0].Constant.DestOffsetIn32BitValues = 0u;
+	arguments[0].Constant.Num32BitValuesToSet = 1u;
+	arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+	D3D12_COMMAND_SIGNATURE_DESC desc{};
+	desc.ByteStride = static_cast<UINT>(sizeof(ModelDrawArguments));
+	desc.NumArgumentDescs = static_cast<UINT>(std::size(arguments));
+	desc.pArgumentDescs = std::data(arguments);
+
+	assert(m_graphicsRS->Get() != nullptr && "Graphics RootSignature not initialised");
+
+	device->CreateCommandSignature(
+		&desc, m_graphicsRS->Get(), IID_PPV_ARGS(&m_commandSignature)
+	);
+}
+
+// Individual Draw
+RenderEngineIndividualDraw::RenderEngineIndividualDraw(const Args& arguments)
+	: RenderEngineVertexShader{ arguments.device.value(), arguments.vertexFormat.value() },
+	m_activeModelCount{ 0u }, m_cullingStats{},
+	m_instanceModelBuffers{ ResourceType::cpuWrite, DescriptorType::SRV },
+	m_frameCount{ arguments.frameCount.value() }, m_spareModelCount{ 0u },
+	m_instanceCapacity{ 0u }, m_autoInstancing{ false }, m_drawInstanced{ false } {}
+
+void RenderEngineIndividualDraw::SetAutoInstancing(bool enable) noexcept {
+	m_autoInstancing = enable;
+}
+
+void RenderEngineIndividualDraw::RegisterFrameTasks(FrameTaskGraph& frameTasks) {
+	// The packed vertices are decoded with the bounding boxes.
+	RegisterBufferUpdateTasks(frameTasks, m_vertexFormat != VertexFormat::Packed);
+
+	frameTasks.AddTask(
+		"CullModels",
+		[this](size_t frameIndex) { CullModels(frameIndex); },
+		FrameResource::Camera | FrameResource::ModelStore, FrameResource::VisibleModels
+	);
+
+	RegisterPreGraphicsTask(frameTasks);
+	RegisterDrawTask(frameTasks, FrameResource::VisibleModels);
+}
+
+void RenderEngineIndividualDraw::CullModels(size_t frameIndex) {
+	// The camera data was refreshed by the buffer update of this frame.
+	m_frustumCuller.SetViewProjection(Gaia::cameraManager->GetViewProjectionMatrix());
+
+	m_visibleModels.clear();
+	Gaia::bufferManager->GetBoundingVolumeHierarchy().QueryFrustum(
+		m_frustumCuller, m_visibleModels
+	);
+
+	m_drawKeys.clear();
+
+	for (std::uint32_t modelIndex : m_visibleModels)
+		m_drawKeys.emplace_back(
+			DrawKey{ .key = m_modelDrawKeys[modelIndex], .modelIndex = modelIndex }
+		);
+
+	// Sorted by the state of the draws, and the model index so the draw order stays the same.
+	m_drawKeySorter.Sort(m_drawKeys);
+
+	if (m_graphicsPipeline0)
+		m_graphicsPipeline0->ClearVisibleModels();
+
+	for (auto& graphicsPipeline : m_graphicsPipelines)
+		if (graphicsPipeline)
+			graphicsPipeline->ClearVisibleModels();
+
+	for (const DrawKey& drawKey : m_drawKeys)
+		GetGraphicsPipeline(DrawKeySorter::GetPipelineIndex(drawKey.key))->AddVisibleModel(
+			drawKey.modelIndex
+		);
+
+	const size_t visibleModels = std::size(m_visibleModels);
+
+	m_cullingStats = CullingStats{
+		.visibleModels = visibleModels,
+		.culledModels = m_activeModelCount - visibleModels
+	};
+
+	// The buffer only has room for the models there was capacity for.
+	m_drawInstanced = m_autoInstancing && visibleModels <= m_instanceCapacity;
+
+	if (m_drawInstanced)
+		BuildInstanceBatches(frameIndex);
+}
+
+void RenderEngineIndividualDraw::BuildInstanceBatches(size_t frameIndex) {
+	m_instanceModelIndices.resize(std::size(m_visibleModels));
+
+	std::uint32_t instanceOffset = 0u;
+
+	if (m_graphicsPipeline0)
+		instanceOffset += m_graphicsPipeline0->BuildInstanceBatches(
+			m_modelMeshIndices, std::data(m_instanceModelIndices), instanceOffset
+		);
+
+	for (auto& graphicsPipeline : m_graphicsPipelines)
+		if (graphicsPipeline)
+			instanceOffset += graphicsPipeline->BuildInstanceBatches(
+				m_modelMeshIndices, std::data(m_instanceModelIndices), instanceOffset
+			);
+
+	// Sorted on the side, as the upload memory is slow to write out of order.
+	std::memcpy(
+		m_instanceModelBuffers.GetCPUWPointer(frameIndex), std::data(m_instanceModelIndices),
+		sizeof(std::uint32_t) * instanceOffset
+	);
+}
+
+size_t RenderEngineIndividualDraw::GetPipelineDrawCount(
+	const GraphicsPipelineIndividualDraw& graphicsPipeline
+) const noexcept {
+	if (m_drawInstanced)
+		return graphicsPipeline.GetInstanceBatchCount();
+
+	return graphicsPipeline.GetVisibleModelCount();
+}
+
+void RenderEngineIndividualDraw::DrawPipelineModels(
+	const GraphicsPipelineIndividualDraw& graphicsPipeline,
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t drawStart, size_t drawEnd
+) const noexcept {
+	if (m_drawInstanced)
+		graphicsPipeline.DrawInstances(
+			graphicsCommandList, m_graphicsRSLayout, drawStart, drawEnd
+		);
+	else
+		graphicsPipeline.DrawModels(
+			graphicsCommandList, m_modelArguments, m_graphicsRSLayout, drawStart, drawEnd
+		);
+}
+
+void RenderEngineIndividualDraw::BindInstanceBuffer(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) const noexcept {
+	if (!m_drawInstanced)
+		return;
+
+	static constexpr auto instanceModelIndicesIndex =
+		static_cast<size_t>(RootSigElement::InstanceModelIndices);
+
+	graphicsCommandList->SetGraphicsRootDescriptorTable(
+		m_graphicsRSLayout[instanceModelIndicesIndex],
+		m_instanceModelBuffers.GetGPUDescriptorHandle(frameIndex)
+	);
+}
+
+void RenderEngineIndividualDraw::_addGraphicsRootParameters(
+	RootSignatureDynamic& signature
+) const noexcept {
+	if (m_autoInstancing)
+		signature.AddDescriptorTable(
+			D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1u, D3D12_SHADER_VISIBILITY_VERTEX,
+			RootSigElement::InstanceModelIndices, false, 3u
+		);
+}
+
+void RenderEngineIndividualDraw::_reserveBuffers(ID3D12Device* device) {
+	if (!m_autoInstancing)
+		return;
+
+	// Every visible model is an instance at most once.
+	m_instanceCapacity = m_activeModelCount + m_spareModelCount;
+
+	const size_t instanceDescriptorOffset =
+		Gaia::descriptorTable->ReserveDescriptorsAndGetOffset(m_frameCount);
+
+	SetDescBufferInfo(
+		device, instanceDescriptorOffset, static_cast<UINT64>(sizeof(std::uint32_t)),
+		static_cast<UINT>(std::max(m_instanceCapacity, size_t{ 1u })), m_instanceModelBuffers,
+		m_frameCount
+	);
+}
+
+void RenderEngineIndividualDraw::_createBuffers(ID3D12Device* device) {
+	if (!m_autoInstancing)
+		return;
+
+	m_instanceModelBuffers.CreateDescriptorView(
+		device, Gaia::descriptorTable->GetUploadDescriptorStart(),
+		Gaia::descriptorTable->GetGPUDescriptorStart(), D3D12_RESOURCE_STATE_GENERIC_READ
+	);
+}
+
+GraphicsPipelineIndividualDraw* RenderEngineIndividualDraw::GetGraphicsPipeline(
+	size_t pipelineIndex
+) const noexcept {
+	if (pipelineIndex == 0u)
+		return m_graphicsPipeline0.get();
+
+	return m_graphicsPipelines[pipelineIndex - 1u].get();
+}
+
+RenderEngine::CullingStats RenderEngineIndividualDraw::GetCullingStats() const noexcept {
+	return m_cullingStats;
+}
+
+void RenderEngineIndividualDraw::RecordDrawCommands(
+	ID3D12GraphicsCommandList* graphicsCommandList, size_t frameIndex
+) {
+	// Nothing has been added yet.
+	if (!m_graphicsPipeline0)
+		return;
+
+	size_t drawCount = GetPipelineDrawCount(*m_graphicsPipeline0);
+
+	for (auto& graphicsPipeline : m_graphicsPipelines)
+		if (graphicsPipeline)
+			drawCount += GetPipelineDrawCount(*graphicsPipeline);
+
+	if (ShouldRecordInParallel(drawCount)) {
+		RecordDrawCommandsInParallel(frameIndex);
+
+		return;
+	}
+
+	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
+
+	// One Pipeline needs to be bound before Descriptors can be bound.
+	m_graphicsPipeline0->BindGraphicsPipeline(graphicsCommandList, graphicsRS, m_drawInstanced);
+	BindGraphicsBuffers(graphicsCommandList, frameIndex);
+	BindInstanceBuffer(graphicsCommandList, frameIndex);
+
+	DrawPipelineModels(
+		*m_graphicsPipeline0, graphicsCommandList, 0u, GetPipelineDrawCount(*m_graphicsPipeline0)
+	);
+
+	// The root signature stays bound, so only the pipeline objects with draws are switched.
+	for (auto& graphicsPipeline : m_graphicsPipelines) {
+		if (!graphicsPipeline)
+			continue;
+
+		const size_t drawCount = GetPipelineDrawCount(*graphicsPipeline);
+
+		if (drawCount == 0u)
+			continue;
+
+		graphicsPipeline->SwitchGraphicsPipeline(graphicsCommandList, m_drawInstanced);
+		DrawPipelineModels(*graphicsPipeline, graphicsCommandList, 0u, drawCount);
+	}
+}
+
+void RenderEngineIndividualDraw::RecordDrawCommandsInParallel(size_t frameIndex) {
+	m_drawRanges.clear();
+
+	AddDrawRanges(m_drawRanges, 0u, GetPipelineDrawCount(*m_graphicsPipeline0));
+
+	for (size_t index = 0u; index < std::size(m_graphicsPipelines); ++index)
+		if (m_graphicsPipelines[index])
+			AddDrawRanges(
+				m_drawRanges, index + 1u, GetPipelineDrawCount(*m_graphicsPipelines[index])
+			);
+
+	ID3D12RootSignature* graphicsRS = m_graphicsRS->Get();
+
+	RecordDrawJobs(
+		std::size(m_drawRanges),
+		[&](D3DCommandList& drawCommandList, size_t jobIndex) {
+			const DrawRange& drawRange = m_drawRanges[jobIndex];
+			GraphicsPipelineIndividualDraw* graphicsPipeline =
+				GetGraphicsPipeline(drawRange.pipelineIndex);
+			ID3D12GraphicsCommandList* graphicsCommandList = drawCommandList.GetCommandList();
+
+			graphicsPipeline->BindGraphicsPipeline(
+				graphicsCommandList, graphicsRS, m_drawInstanced
+			);
+			BindGraphicsBuffers(graphicsCommandList, frameIndex);
+			BindInstanceBuffer(graphicsCommandList, frameIndex);
+
+			DrawPipelineModels(
+				*graphicsPipeline, graphicsCommandList, drawRange.drawStart, drawRange.drawEnd
+			);
+		},
+		frameIndex
+	);
+}
+
+void RenderEngineIndividualDraw::ConstructPipelines() {
+	ID3D12Device2* device = Gaia::device->GetDeviceRef();
+
+	ConstructGraphicsRootSignature(device);
+	CreateGraphicsPipelines(device, m_graphicsPipeline0, m_graphicsPipelines);
+}
+
+size_t RenderEngineIndividualDraw::RecordModelDataSet(
+	const std::vector<std::shared_ptr<IModel>>& models,
+	const std::vector<std::uint32_t>& modelIds, const std::wstring& pixelShader
+) {
+	const size_t pipelineIndex = AddPixelShaderPipeline(pixelShader);
+	const size_t modelSetIndex = std::size(m_setPipelineIndices);
+
+	m_setPipelineIndices.emplace_back(pipelineIndex);
+	++m_pipelineSetCounts[pipelineIndex];
+
+	RecordModelArguments(models, modelIds, static_cast<std::uint32_t>(pipelineIndex));
+
+	m_modelSetModelIds.emplace_back(modelIds);
+
+	return modelSetIndex;
+}
+
+size_t RenderEngineIndividualDraw::AddPixelShaderPipeline(const std::wstring& pixelShader) {
+	const auto pixelShaderPipeline = m_pixelShaderPipelines.find(pixelShader);
+
+	if (pixelShaderPipeline != std::end(m_pixelShaderPipelines))
+		return pixelShaderPipeline->second;
+
+	// The pipeline index is in the draw keys.
+	if (std::size(m_graphicsPipelines) >= DrawKeySorter::s_maxPipelineIndex)
+		throw Exception("RenderEngine Error", "There are too many pipelines for the draw keys.");
+
+	auto graphicsPipeline = std::make_unique<GraphicsPipelineIndividualDraw>();
+
+	graphicsPipeline->SetVertexFormat(m_vertexFormat);
+	graphicsPipeline->SetInstancing(m_autoInstancing);
+	graphicsPipeline->ConfigureGraphicsPipelineObject(pixelShader);
+
+	const size_t pipelineIndex = AddGraphicsPipeline(
+		Gaia::device->GetDeviceRef(), std::move(graphicsPipeline), m_graphicsPipeline0,
+		m_graphicsPipelines
+	);
+
+	m_pixelShaderPipelines.emplace(pixelShader, pipelineIndex);
+
+	if (pipelineIndex >= std::size(m_pipelineSetCounts))
+		m_pipelineSetCounts.resize(pipelineIndex + 1u, 0u);
+
+	return pipelineIndex;
+}
+
+void RenderEngineIndividualDraw::RemoveModelDataSet(size_t modelSetIndex) {
+	std::optional<size_t>& pipelineIndex = m_setPipelineIndices[modelSetIndex];
+
+	if (!pipelineIndex)
+		return;
+
+	std::vector<std::uint32_t>& modelIds = m_modelSetModelIds[modelSetIndex];
+
+	for (std::uint32_t modelId : modelIds)
+		GetGraphicsPipeline(*pipelineIndex)->RemoveMesh(m_modelMeshIndices[modelId]);
+
+	// The removed models are inactive in the model store, so culling won't return them.
+	m_activeModelCount -= std::size(modelIds);
+	modelIds = std::vector<std::uint32_t>{};
+
+	// A pipeline is kept while a set uses it, and the first one to bind the descriptors with.
+	if (--m_pipelineSetCounts[*pipelineIndex] == 0u && *pipelineIndex != 0u) {
+		GraphicsPipeline& graphicsPipeline = m_graphicsPipelines[*pipelineIndex - 1u];
+
+		m_pixelShaderPipelines.erase(graphicsPipeline->GetPixelShader());
+		ReleaseGraphicsPipeline(std::move(graphicsPipeline));
+	}
+
+	pipelineIndex.reset();
+}
+
+void RenderEngineIndividualDraw::SetSpareCapacity(
+	size_t modelCount, [[maybe_unused]] size_t modelSetCount, size_t vertexCount,
+	size_t indexCount
+) noexcept {
+	m_spareModelCount = modelCount;
+	SetSpareInputCapacity(vertexCount, indexCount);
+}
+
+void RenderEngineIndividualDraw::RecordModelArguments(
+	const std::vector<std::shared_ptr<IModel>>& models,
+	const std::vector<std::uint32_t>& modelIds, std::uint32_t pipelineIndex
+) noexcept {
+	GraphicsPipelineIndividualDraw* graphicsPipeline = GetGraphicsPipeline(pipelineIndex);
+
+	for (size_t index = 0u; index < std::size(models); ++index) {
+		const auto& model = models[index];
+		const std::uint32_t modelId = modelIds[index];
+
+		D3D12_DRAW_INDEXED_ARGUMENTS arguments{
+			.IndexCountPerInstance = model->GetIndexCount(),
+			.InstanceCount = 1u,
+			.StartIndexLocation = model->GetIndexOffset(),
+			.BaseVertexLocation = 0u,
+			.StartInstanceLocation = 0u
+		};
+
+		if (modelId >= std::size(m_modelArguments)) {
+			m_modelArguments.resize(modelId + 1u);
+			m_modelDrawKeys.resize(modelId + 1u);
+			m_modelMeshIndices.resize(modelId + 1u);
+		}
+
+		m_modelArguments[modelId] = ModelDrawArguments{
+			.modelIndex = modelId,
+			.drawIndexed = arguments
+		};
+
+		const std::uint32_t meshIndex = graphicsPipeline->AddMesh(arguments);
+
+		m_modelMeshIndices[modelId] = meshIndex;
+		m_modelDrawKeys[modelId] = DrawKeySorter::MakeKey(
+			pipelineIndex, model->GetDiffuseTexIndex(), meshIndex
+		);
+	}
+
+	m_activeModelCount += std::size(models);
+}
@@ -1,226 +1,664 @@
-#include <RendererDx12.hpp>
-#include <Gaia.hpp>
-#include <D3DHelperFunctions.hpp>
-#include <D3DResourceBarrier.hpp>
-
-RendererDx12::RendererDx12(
-	const char* appName,
-	void* windowHandle, std::uint32_t width, std::uint32_t height, std::uint32_t bufferCount,
-	RenderEngineType engineType
-) : m_appName(appName), m_width(width), m_height(height), m_bufferCount{ bufferCount } {
-
-	m_objectManager.CreateObject(Gaia::device, 3u);
-
-	ID3D12Device4* deviceRef = Gaia::device.get()->GetDeviceRef();
-
-	Gaia::InitRenderEngine(m_objectManager, engineType, deviceRef, bufferCount);
-	Gaia::renderEngine->ResizeViewportAndScissor(width, height);
-
-	Gaia::InitResources(m_objectManager);
-
-#ifdef _DEBUG
-	m_objectManager.CreateObject(Gaia::debugLogger, { deviceRef }, 4u);
-#endif
-
-	const bool meshDrawType = engineType == RenderEngineType::MeshDraw ? true : false;
-
-	Gaia::InitGraphicsQueueAndList(m_objectManager, deviceRef, meshDrawType, bufferCount);
-
-	SwapChainManager::Args swapChainArguments{
-		.device = deviceRef,
-		.factory = Gaia::device->GetFactoryRef(),
-		.graphicsQueue = Gaia::graphicsQueue->GetQueue(),
-		.windowHandle = static_cast<HWND>(windowHandle),
-		.width = width,
-		.height = height,
-		.bufferCount = bufferCount,
-		.variableRefreshRate = true
-	};
-
-	m_objectManager.CreateObject(Gaia::swapChain, swapChainArguments, 1u);
-
-	Gaia::InitCopyQueueAndList(m_objectManager, deviceRef);
-	Gaia::InitComputeQueueAndList(m_objectManager, deviceRef, bufferCount);
-
-	m_objectManager.CreateObject(Gaia::descriptorTable, 0u);
-
-	const bool modelDataNoBB = engineType == RenderEngineType::IndirectDraw ? false : true;
-
-	m_objectManager.CreateObject(Gaia::bufferManager, { bufferCount, modelDataNoBB }, 1u);
-	m_objectManager.CreateObject(Gaia::textureStorage, 0u);
-
-	m_objectManager.CreateObject(Gaia::cameraManager, 0u);
-	Gaia::cameraManager->SetSceneResolution(width, height);
-}
-
-void RendererDx12::AddModelSet(
-	std::vector<std::shared_ptr<IModel>>&& models, const std::wstring& pixelShader
-) {
-	Gaia::renderEngine->RecordModelDataSet(models, pixelShader + L".cso");
-	Gaia::bufferManager->AddOpaqueModels(std::move(models));
-}
-
-void RendererDx12::AddMeshletModelSet(
-	std::vector<MeshletModel>&& meshletModels, const std::wstring& pixelShader
-) {
-	Gaia::renderEngine->AddMeshletModelSet(meshletModels, pixelShader + L".cso");
-	Gaia::bufferManager->AddOpaqueModels(std::move(meshletModels));
-}
-
-void RendererDx12::AddModelInputs(
-	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-) {
-	Gaia::renderEngine->AddGVerticesAndIndices(std::move(gVertices), std::move(gIndices));
-}
-
-void RendererDx12::AddModelInputs(
-	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
-	std::vector<std::uint32_t>&& gPrimIndices
-) {
-	Gaia::renderEngine->AddGVerticesAndPrimIndices(
-		std::move(gVertices), std::move(gVerticesIndices), std::move(gPrimIndices)
-	);
-}
-
-void RendererDx12::Update() {
-	const size_t currentBackIndex = Gaia::swapChain->GetCurrentBackBufferIndex();
-
-	Gaia::renderEngine->UpdateModelBuffers(currentBackIndex);
-}
-
-void RendererDx12::Render() {
-	const size_t currentBackIndex = Gaia::swapChain->GetCurrentBackBufferIndex();
-
-	Gaia::renderEngine->ExecuteRenderStage(currentBackIndex);
-	Gaia::renderEngine->Present(currentBackIndex);
-	Gaia::renderEngine->ExecutePostRenderStage();
-}
-
-void RendererDx12::Resize(std::uint32_t width, std::uint32_t height) {
-	if (m_width != width || m_height != height) {
-		m_width = width;
-		m_height = height;
-
-		ID3D12Device* deviceRef = Gaia::device->GetDeviceRef();
-
-		UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
-
-		Gaia::graphicsQueue->SignalCommandQueue(Gaia::graphicsFence->GetFence(), fenceValue);
-		Gaia::graphicsFence->WaitOnCPU();
-
-		Gaia::swapChain->Resize(deviceRef, width, height);
-
-		Gaia::graphicsFence->ResetFenceValues(fenceValue + 1u);
-
-		Gaia::renderEngine->CreateDepthBufferView(deviceRef, width, height);
-		Gaia::renderEngine->ResizeViewportAndScissor(width, height);
-
-		Gaia::cameraManager->SetSceneResolution(width, height);
-	}
-}
-
-Renderer::Resolution RendererDx12::GetFirstDisplayCoordinates() const {
-	auto [width, height] = GetDisplayResolution(
-		Gaia::device->GetDeviceRef(), Gaia::device->GetFactoryRef(), 0u
-	);
-
-	return { width, height };
-}
-
-void RendererDx12::SetBackgroundColour(const std::array<float, 4>& colour) noexcept {
-	Gaia::renderEngine->SetBackgroundColour(colour);
-}
-
-void RendererDx12::SetShaderPath(const wchar_t* path) noexcept {
-	Gaia::renderEngine->SetShaderPath(path);
-}
-
-void RendererDx12::ProcessData() {
-	ID3D12Device* device = Gaia::device->GetDeviceRef();
-
-	// Reserve Heap Space start
-	Gaia::renderEngine->ReserveBuffers(device);
-	Gaia::bufferManager->ReserveBuffers(device);
-	Gaia::Resources::cpuWriteBuffer->ReserveHeapSpace(device);
-	// Reserve Heap Space end
-
-	// Create heaps start
-	Gaia::Resources::uploadHeap->CreateHeap(device);
-	Gaia::Resources::gpuOnlyHeap->CreateHeap(device);
-	Gaia::Resources::cpuWriteHeap->CreateHeap(device);
-	// Create heaps end
-
-	Gaia::descriptorTable->CreateDescriptorTable(device);
-
-	// Create Buffers start
-	Gaia::renderEngine->CreateDepthBufferView(device, m_width, m_height);
-	Gaia::Resources::cpuWriteBuffer->CreateResource(device);
-	Gaia::renderEngine->CreateBuffers(device);
-	Gaia::bufferManager->CreateBuffers(device);
-	Gaia::textureStorage->CreateBufferViews(device);
-	// Create Buffers end
-
-	// Async copy start
-	std::atomic_size_t workCount = 0u;
-
-	Gaia::Resources::uploadContainer->CopyData(workCount);
-
-	Gaia::descriptorTable->CopyUploadHeap(device);
-
-	while (workCount != 0u);
-	// Async copy end
-
-	// GPU upload start
-	Gaia::copyCmdList->ResetFirst();
-	ID3D12GraphicsCommandList* copyList = Gaia::copyCmdList->GetCommandList();
-
-	Gaia::renderEngine->RecordResourceUploads(copyList);
-	Gaia::textureStorage->RecordResourceUpload(copyList);
-
-	Gaia::copyCmdList->Close();
-
-	Gaia::copyQueue->ExecuteCommandLists(copyList);
-
-	UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
-	Gaia::copyQueue->SignalCommandQueue(Gaia::graphicsFence->GetFence(), fenceValue);
-	Gaia::graphicsFence->WaitOnCPU();
-	Gaia::graphicsFence->SignalFence(fenceValue - 1u);
-	// GPU upload end
-
-	Gaia::renderEngine->ConstructPipelines();
-
-	// Release Upload Resource start
-	Gaia::renderEngine->ReleaseUploadResources();
-	Gaia::textureStorage->ReleaseUploadResource();
-	Gaia::descriptorTable->ReleaseUploadHeap();
-	Gaia::Resources::uploadHeap.reset();
-	// Release Upload Resource end
-}
-
-size_t RendererDx12::AddTexture(
-	std::unique_ptr<std::uint8_t> textureData, size_t width, size_t height
-) {
-	return Gaia::textureStorage->AddTexture(
-		Gaia::device->GetDeviceRef(), std::move(textureData), width, height
-	);
-}
-
-void RendererDx12::SetThreadPool(std::shared_ptr<IThreadPool> threadPoolArg) noexcept {
-	Gaia::SetThreadPool(std::move(threadPoolArg));
-}
-
-void RendererDx12::SetSharedDataContainer(
-	std::shared_ptr<ISharedDataContainer> sharedData
-) noexcept {
-	Gaia::SetSharedData(std::move(sharedData));
-}
-
-void RendererDx12::WaitForAsyncTasks() {
-	// Current frame's value is already checked. So, check the rest
-	for (std::uint32_t _ = 0u; _ < m_bufferCount - 1u; ++_) {
-		Gaia::graphicsFence->AdvanceValueInQueue();
-		Gaia::graphicsFence->WaitOnCPUConditional();
-		Gaia::computeFence->AdvanceValueInQueue();
-		Gaia::computeFence->WaitOnCPUConditional();
-	}
-}
+#include <RendererDx12.hpp>
+#include <Gaia.hpp>
+#include <D3DHelperFunctions.hpp>
+#include <D3DResourceBarrier.hpp>
+#include <Exception.hpp>
+#include <algorithm>
+#include <utility>
+#include <string_view>
+#include <chrono>
+
+RendererDx12::RendererDx12(
+	const char* appName,
+	void* windowHandle, std::uint32_t width, std::uint32_t height, std::uint32_t bufferCount,
+	RenderEngineType engineType, VertexFormat vertexFormat
+) : m_appName(appName), m_width(width), m_height(height), m_bufferCount{ bufferCount },
+	m_runtimeCapacity{}, m_dataProcessed{ false }, m_startupStatistics{} {
+
+	if (engineType == RenderEngineType::MeshDraw && vertexFormat == VertexFormat::Packed)
+		throw Exception("Renderer Error", "The mesh draw engine only takes full vertices.");
+
+	// Without a window, the renderer runs on the headless device.
+	m_objectManager.CreateObject(Gaia::device, { .headless = windowHandle == nullptr }, 3u);
+
+	ID3D12Device4* deviceRef = Gaia::device.get()->GetDeviceRef();
+
+	Gaia::InitRenderEngine(m_objectManager, engineType, deviceRef, bufferCount, vertexFormat);
+	Gaia::renderEngine->ResizeViewportAndScissor(width, height);
+	Gaia::renderEngine->RegisterFrameTasks(m_frameTasks);
+
+	Gaia::InitResources(m_objectManager);
+
+#ifdef _DEBUG
+	m_objectManager.CreateObject(Gaia::debugLogger, { deviceRef }, 4u);
+#endif
+
+	const bool meshDrawType = engineType == RenderEngineType::MeshDraw ? true : false;
+
+	Gaia::InitGraphicsQueueAndList(m_objectManager, deviceRef, meshDrawType, bufferCount);
+
+	SwapChainManager::Args swapChainArguments{
+		.device = deviceRef,
+		.factory = Gaia::device->GetFactoryRef(),
+		.graphicsQueue = Gaia::graphicsQueue->GetQueue(),
+		.windowHandle = static_cast<HWND>(windowHandle),
+		.width = width,
+		.height = height,
+		.bufferCount = bufferCount,
+		.variableRefreshRate = true
+	};
+
+	m_objectManager.CreateObject(Gaia::swapChain, swapChainArguments, 1u);
+
+	Gaia::InitCopyQueueAndList(m_objectManager, deviceRef);
+	Gaia::InitComputeQueueAndList(m_objectManager, deviceRef, bufferCount);
+
+	m_objectManager.CreateObject(Gaia::descriptorTable, 0u);
+
+	// The packed vertices are decoded with the bounding boxes.
+	const bool modelDataNoBB = engineType != RenderEngineType::IndirectDraw
+		&& vertexFormat != VertexFormat::Packed;
+
+	m_objectManager.CreateObject(Gaia::bufferManager, { bufferCount, modelDataNoBB }, 1u);
+	m_objectManager.CreateObject(Gaia::textureStorage, 0u);
+
+	m_objectManager.CreateObject(Gaia::cameraManager, 0u);
+	Gaia::cameraManager->SetSceneResolution(width, height);
+}
+
+RendererDx12::~RendererDx12() noexcept {
+	StopRenderThread();
+
+	// For the pipelines added after ProcessData, the cache is only worth a try here.
+	if (m_dataProcessed) {
+		try {
+			Gaia::pipelineLibrary->WriteCacheFile(Gaia::device->GetDeviceRef());
+		}
+		catch (...) {}
+	}
+}
+
+size_t RendererDx12::AddModelSet(
+	std::vector<std::shared_ptr<IModel>>&& models, const std::wstring& pixelShader
+) {
+	WaitForRenderThread();
+
+	std::vector<std::uint32_t> modelIds = Gaia::bufferManager->AddOpaqueModels(models);
+
+	size_t modelSetId = 0u;
+
+	// The models would otherwise stay active without being drawn.
+	try {
+		modelSetId = Gaia::renderEngine->RecordModelDataSet(
+			models, modelIds, pixelShader + L".cso"
+		);
+	}
+	catch (...) {
+		Gaia::bufferManager->RemoveOpaqueModels(modelIds);
+
+		throw;
+	}
+
+	if (modelSetId >= std::size(m_modelSetIds))
+		m_modelSetIds.resize(modelSetId + 1u);
+
+	m_modelSetIds[modelSetId] = std::move(modelIds);
+
+	return modelSetId;
+}
+
+void RendererDx12::RemoveModelSet(size_t modelSetId) {
+	if (!m_dataProcessed)
+		throw Exception("Renderer Error", "Model sets can only be removed after ProcessData.");
+
+	// Removing a set twice would put its model ids on the free list twice.
+	if (modelSetId >= std::size(m_modelSetIds) || !m_modelSetIds[modelSetId])
+		throw Exception("Renderer Error", "The model set doesn't exist or was already removed.");
+
+	WaitForRenderThread();
+
+	Gaia::renderEngine->RemoveModelDataSet(modelSetId);
+	Gaia::bufferManager->RemoveOpaqueModels(*m_modelSetIds[modelSetId]);
+
+	m_modelSetIds[modelSetId].reset();
+}
+
+void RendererDx12::AddMeshletModelSet(
+	std::vector<MeshletModel>&& meshletModels, const std::wstring& pixelShader
+) {
+	if (m_dataProcessed)
+		throw Exception("Renderer Error", "Meshlet models can't be added after ProcessData.");
+
+	Gaia::renderEngine->AddMeshletModelSet(meshletModels, pixelShader + L".cso");
+	Gaia::bufferManager->AddOpaqueModels(std::move(meshletModels));
+}
+
+ModelInputRange RendererDx12::AddModelInputs(
+	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+) {
+	WaitForRenderThread();
+
+	return Gaia::renderEngine->AddGVerticesAndIndices(std::move(gVertices), std::move(gIndices));
+}
+
+ModelInputRange RendererDx12::AddModelInputs(
+	std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+) {
+	WaitForRenderThread();
+
+	return Gaia::renderEngine->AddGVerticesAndIndices(std::move(gVertices), std::move(gIndices));
+}
+
+void RendererDx12::RemoveModelInputs(size_t inputId) {
+	if (!m_dataProcessed)
+		throw Exception("Renderer Error", "Model inputs can only be removed after ProcessData.");
+
+	WaitForRenderThread();
+
+	Gaia::renderEngine->RemoveGVerticesAndIndices(inputId);
+}
+
+void RendererDx12::AddModelInputs(
+	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gVerticesIndices,
+	std::vector<std::uint32_t>&& gPrimIndices
+) {
+	if (m_dataProcessed)
+		throw Exception("Renderer Error", "Meshlet inputs can't be added after ProcessData.");
+
+	Gaia::renderEngine->AddGVerticesAndPrimIndices(
+		std::move(gVertices), std::move(gVerticesIndices), std::move(gPrimIndices)
+	);
+}
+
+void RendererDx12::Update() {
+	// The render thread does it before each of its frames.
+	if (m_framePackets)
+		return;
+
+	ReleaseCompletedFrames();
+}
+
+void RendererDx12::ReleaseCompletedFrames() {
+	const UINT64 completedFenceValue = Gaia::graphicsFence->GetCompletedValue();
+
+	Gaia::releaseQueue->Release(completedFenceValue);
+	Gaia::Resources::uploadRing->Reclaim(completedFenceValue);
+	Gaia::graphicsCmdListPool->Reclaim(completedFenceValue);
+}
+
+void RendererDx12::Render() {
+	if (!m_framePackets) {
+		RenderFrame();
+
+		return;
+	}
+
+	FramePacket framePacket{};
+
+	DirectX::XMStoreFloat4x4(&framePacket.viewMatrix, Gaia::sharedData->GetViewMatrix());
+	framePacket.fovAngleInDegree = Gaia::sharedData->GetFov();
+
+	Gaia::bufferManager->CaptureModelChanges(framePacket);
+
+	m_framePackets->Push(std::move(framePacket));
+
+	// The render thread only closes the queue when it has failed.
+	if (m_framePackets->IsClosed() && m_renderThreadError)
+		std::rethrow_exception(std::exchange(m_renderThreadError, nullptr));
+}
+
+void RendererDx12::RenderFrame() {
+	const size_t currentBackIndex = Gaia::swapChain->GetCurrentBackBufferIndex();
+
+	// The buffer updates run here as well, so the independent stages can overlap.
+	m_frameTasks.Execute(currentBackIndex);
+
+	Gaia::renderEngine->Present(currentBackIndex);
+	Gaia::renderEngine->ExecutePostRenderStage();
+}
+
+void RendererDx12::Resize(std::uint32_t width, std::uint32_t height) {
+	if (m_width != width || m_height != height) {
+		WaitForRenderThread();
+
+		m_width = width;
+		m_height = height;
+
+		ID3D12Device* deviceRef = Gaia::device->GetDeviceRef();
+
+		UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
+
+		Gaia::graphicsQueue->SignalCommandQueue(Gaia::graphicsFence->GetFence(), fenceValue);
+		Gaia::graphicsFence->WaitOnCPU();
+
+		Gaia::swapChain->Resize(deviceRef, width, height);
+
+		Gaia::graphicsFence->ResetFenceValues(fenceValue + 1u);
+
+		Gaia::renderEngine->CreateDepthBufferView(deviceRef, width, height);
+		Gaia::renderEngine->ResizeViewportAndScissor(width, height);
+
+		Gaia::cameraManager->SetSceneResolution(width, height);
+	}
+}
+
+Renderer::Resolution RendererDx12::GetFirstDisplayCoordinates() const {
+	// There is no display to ask.
+	if (Gaia::device->IsHeadless())
+		return { m_width, m_height };
+
+	auto [width, height] = GetDisplayResolution(
+		Gaia::device->GetDeviceRef(), Gaia::device->GetFactoryRef(), 0u
+	);
+
+	return { width, height };
+}
+
+Renderer::FrameStatistics RendererDx12::GetFrameStatistics() const noexcept {
+	const BufferManager::UpdateStats updateStats = Gaia::bufferManager->GetUpdateStats();
+	const RenderEngine::CullingStats cullingStats = Gaia::renderEngine->GetCullingStats();
+	const FrameTaskGraph::FrameStats frameTaskStats = m_frameTasks.GetFrameStats();
+
+	return {
+		.modelsWritten = updateStats.modelsWritten,
+		.materialsWritten = updateStats.materialsWritten,
+		.bytesWritten = updateStats.bytesWritten,
+		.modelsVisible = cullingStats.visibleModels,
+		.modelsCulled = cullingStats.culledModels,
+		.frameTaskSeconds = frameTaskStats.frameSeconds,
+		.criticalPathSeconds = frameTaskStats.criticalPathSeconds
+	};
+}
+
+std::vector<std::string> RendererDx12::GetFrameCriticalPath() const {
+	const std::vector<char const*>& criticalPath = m_frameTasks.GetCriticalPath();
+
+	return std::vector<std::string>(std::begin(criticalPath), std::end(criticalPath));
+}
+
+Renderer::UploadStatistics RendererDx12::GetUploadStatistics() const {
+	UploadContainer::CopyStats copyStats = Gaia::Resources::uploadContainer->GetCopyStats();
+
+	return {
+		.bytesCopied = copyStats.bytesCopied,
+		.copySeconds = copyStats.copySeconds,
+		.gigabytesPerSecond = copyStats.gigabytesPerSecond,
+		.threadSeconds = std::move(copyStats.batchSeconds)
+	};
+}
+
+Renderer::CommandStatistics RendererDx12::GetCommandStatistics() const noexcept {
+	CommandStatistics statistics{};
+
+	AddCommandStatistics(*Gaia::graphicsCmdList, statistics);
+	AddCommandStatistics(*Gaia::computeCmdList, statistics);
+
+	for (D3DCommandList const* drawCommandList : Gaia::graphicsCmdListPool->GetFrameCommandLists())
+		AddCommandStatistics(*drawCommandList, statistics);
+
+	return statistics;
+}
+
+Renderer::ShaderStatistics RendererDx12::GetShaderStatistics() const noexcept {
+	const ShaderCache::CacheStats cacheStats = Gaia::shaderCache->GetCacheStats();
+
+	return {
+		.hits = cacheStats.hits,
+		.contentHits = cacheStats.contentHits,
+		.misses = cacheStats.misses,
+		.bytesMapped = cacheStats.bytesMapped
+	};
+}
+
+Renderer::PipelineStatistics RendererDx12::GetPipelineStatistics() const noexcept {
+	const PipelineLibrary::CacheStats cacheStats = Gaia::pipelineLibrary->GetCacheStats();
+
+	return {
+		.cacheHits = cacheStats.libraryHits,
+		.cacheMisses = cacheStats.misses,
+		.compileSeconds = cacheStats.compileSeconds
+	};
+}
+
+Renderer::StartupStatistics RendererDx12::GetStartupStatistics() const noexcept {
+	return m_startupStatistics;
+}
+
+void RendererDx12::AddCommandStatistics(
+	const D3DCommandList& commandList, CommandStatistics& statistics
+) noexcept {
+	RecordingCommandList const* recordingList = commandList.GetRecordingList();
+
+	if (!recordingList)
+		return;
+
+	for (const RecordedCommand& command : recordingList->GetCommands())
+		switch (command.type) {
+		case RecordedCommandType::Bind: {
+			++statistics.binds;
+
+			const std::string_view commandName{ command.name };
+
+			if (commandName.starts_with("SetPipelineState"))
+				++statistics.pipelineChanges;
+			else if (commandName.starts_with("SetGraphicsRoot32BitConstant"))
+				++statistics.rootConstantChanges;
+
+			break;
+		}
+		case RecordedCommandType::Draw:
+			++statistics.draws;
+			break;
+		case RecordedCommandType::Dispatch:
+			++statistics.dispatches;
+			break;
+		case RecordedCommandType::Indirect:
+			++statistics.indirectCommands;
+			break;
+		case RecordedCommandType::Barrier:
+			statistics.barriers += command.count;
+			break;
+		case RecordedCommandType::Copy:
+			++statistics.copies;
+			break;
+		case RecordedCommandType::Clear:
+			++statistics.clears;
+			break;
+		default:
+			break;
+		}
+}
+
+ModelTransformStore& RendererDx12::GetModelTransformStore() noexcept {
+	return Gaia::bufferManager->GetModelStore();
+}
+
+void RendererDx12::QueryModelsInBox(
+	const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum,
+	std::vector<std::uint32_t>& modelIds
+) {
+	WaitForRenderThread();
+
+	Gaia::bufferManager->GetBoundingVolumeHierarchy().QueryBox(
+		AxisAlignedBox{ .minimum = minimum, .maximum = maximum }, modelIds
+	);
+}
+
+void RendererDx12::QueryModelsOnRay(
+	const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+	std::vector<std::uint32_t>& modelIds
+) {
+	WaitForRenderThread();
+
+	Gaia::bufferManager->GetBoundingVolumeHierarchy().QueryRay(
+		origin, direction, maxDistance, modelIds
+	);
+}
+
+void RendererDx12::SetBackgroundColour(const std::array<float, 4>& colour) noexcept {
+	Gaia::renderEngine->SetBackgroundColour(colour);
+}
+
+void RendererDx12::SetShaderPath(const wchar_t* path) noexcept {
+	Gaia::renderEngine->SetShaderPath(path);
+}
+
+void RendererDx12::SetPipelineCachePath(const wchar_t* path) {
+	if (m_dataProcessed)
+		throw Exception(
+			"Renderer Error", "The pipeline cache path must be set before ProcessData."
+		);
+
+	Gaia::pipelineLibrary->SetCachePath(path);
+}
+
+void RendererDx12::ProcessData() {
+	ID3D12Device* device = Gaia::device->GetDeviceRef();
+
+	const auto processStart = std::chrono::steady_clock::now();
+	auto stageStart = processStart;
+
+	// Returns the time since the last stage ended.
+	auto endStage = [&stageStart] {
+		const auto stageEnd = std::chrono::steady_clock::now();
+		const double stageSeconds = std::chrono::duration<double>(stageEnd - stageStart).count();
+
+		stageStart = stageEnd;
+
+		return stageSeconds;
+	};
+
+	// Runtime capacity start
+	Gaia::bufferManager->SetSpareCapacity(
+		m_runtimeCapacity.modelCount, m_runtimeCapacity.lightCount
+	);
+	Gaia::renderEngine->SetSpareCapacity(
+		m_runtimeCapacity.modelCount, m_runtimeCapacity.modelSetCount,
+		m_runtimeCapacity.vertexCount, m_runtimeCapacity.indexCount
+	);
+	Gaia::textureStorage->SetSpareCapacity(m_runtimeCapacity.textureCount);
+	Gaia::Resources::uploadRing->SetCapacity(m_runtimeCapacity.uploadMemorySize);
+	// Runtime capacity end
+
+	// Reserve Heap Space start
+	Gaia::renderEngine->ReserveBuffers(device);
+	Gaia::bufferManager->ReserveBuffers(device);
+	Gaia::Resources::cpuWriteBuffer->ReserveHeapSpace(device);
+	Gaia::Resources::uploadRing->ReserveHeapSpace(device);
+	// Textures are placed at up to 64KB alignment.
+	Gaia::Resources::gpuOnlyHeap->AddSpareSize(
+		m_runtimeCapacity.textureMemorySize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT
+	);
+	// Reserve Heap Space end
+
+	m_startupStatistics.reserveSeconds = endStage();
+
+	// Create heaps start
+	Gaia::Resources::uploadHeap->CreateHeap(device);
+	Gaia::Resources::gpuOnlyHeap->CreateHeap(device);
+	Gaia::Resources::cpuWriteHeap->CreateHeap(device);
+	// Create heaps end
+
+	Gaia::descriptorTable->CreateDescriptorTable(device);
+
+	m_startupStatistics.heapSeconds = endStage();
+
+	// Create Buffers start
+	Gaia::renderEngine->CreateDepthBufferView(device, m_width, m_height);
+	Gaia::Resources::cpuWriteBuffer->CreateResource(device);
+	Gaia::Resources::uploadRing->CreateResource(device);
+	Gaia::renderEngine->CreateBuffers(device);
+	Gaia::bufferManager->CreateBuffers(device);
+	Gaia::textureStorage->CreateBufferViews(device);
+	// Create Buffers end
+
+	m_startupStatistics.bufferSeconds = endStage();
+
+	// Async copy start
+	Gaia::Resources::uploadContainer->CopyData();
+
+	Gaia::descriptorTable->CopyUploadHeap(device);
+
+	Gaia::Resources::uploadContainer->WaitForCopies();
+	// Async copy end
+
+	m_startupStatistics.copySeconds = endStage();
+
+	// GPU upload start
+	Gaia::copyCmdList->ResetFirst();
+	ID3D12GraphicsCommandList* copyList = Gaia::copyCmdList->GetCommandList();
+
+	Gaia::renderEngine->RecordResourceUploads(copyList);
+	Gaia::textureStorage->RecordResourceUpload(copyList);
+
+	Gaia::copyCmdList->Close();
+
+	Gaia::copyQueue->ExecuteCommandLists(Gaia::copyCmdList->GetExecutableCommandList());
+
+	UINT64 fenceValue = Gaia::graphicsFence->GetFrontValue();
+	Gaia::copyQueue->SignalCommandQueue(Gaia::graphicsFence->GetFence(), fenceValue);
+	Gaia::graphicsFence->WaitOnCPU();
+	Gaia::graphicsFence->SignalFence(fenceValue - 1u);
+	// GPU upload end
+
+	m_startupStatistics.gpuUploadSeconds = endStage();
+
+	Gaia::pipelineLibrary->ReadCacheFile(
+		Gaia::device->GetDeviceRef(), Gaia::device->GetFactoryRef()
+	);
+
+	Gaia::renderEngine->ConstructPipelines();
+
+	Gaia::pipelineLibrary->WriteCacheFile(Gaia::device->GetDeviceRef());
+
+	m_startupStatistics.pipelineSeconds = endStage();
+
+	// Release Upload Resource start
+	Gaia::renderEngine->ReleaseUploadResources();
+	Gaia::textureStorage->ReleaseUploadResource();
+	Gaia::descriptorTable->ReleaseUploadHeap();
+	// The upload heap is kept for the runtime uploads.
+	// Release Upload Resource end
+
+	m_startupStatistics.totalSeconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - processStart
+	).count();
+
+	m_dataProcessed = true;
+}
+
+size_t RendererDx12::AddTexture(
+	std::unique_ptr<std::uint8_t> textureData, size_t width, size_t height
+) {
+	WaitForRenderThread();
+
+	return Gaia::textureStorage->AddTexture(
+		Gaia::device->GetDeviceRef(), std::move(textureData), width, height
+	);
+}
+
+void RendererDx12::RemoveTexture(size_t textureIndex) {
+	if (!m_dataProcessed)
+		throw Exception("Renderer Error", "Textures can only be removed after ProcessData.");
+
+	WaitForRenderThread();
+
+	Gaia::textureStorage->RemoveTexture(textureIndex);
+}
+
+void RendererDx12::SetRuntimeCapacity(const RuntimeCapacity& capacity) noexcept {
+	m_runtimeCapacity = capacity;
+}
+
+void RendererDx12::SetCommandRecording(bool enable) {
+	WaitForRenderThread();
+
+	Gaia::graphicsCmdList->SetRecording(enable);
+	Gaia::computeCmdList->SetRecording(enable);
+	Gaia::graphicsCmdListPool->SetRecording(enable);
+}
+
+void RendererDx12::SetThreadPool(std::shared_ptr<IThreadPool> threadPoolArg) noexcept {
+	Gaia::SetThreadPool(std::move(threadPoolArg));
+}
+
+void RendererDx12::SetSharedDataContainer(
+	std::shared_ptr<ISharedDataContainer> sharedData
+) noexcept {
+	Gaia::SetSharedData(std::move(sharedData));
+}
+
+void RendererDx12::SetRenderThread(bool enable) {
+	if (enable == static_cast<bool>(m_framePackets))
+		return;
+
+	if (enable) {
+		Gaia::bufferManager->SetExternalModelSync(true);
+
+		m_framePackets = std::make_unique<FramePacketQueue>(
+			std::max(m_bufferCount, 2u) - 1u
+		);
+		m_renderThread = std::thread{ &RendererDx12::RenderThreadLoop, this };
+	}
+	else {
+		StopRenderThread();
+
+		if (m_renderThreadError)
+			std::rethrow_exception(std::exchange(m_renderThreadError, nullptr));
+	}
+}
+
+void RendererDx12::SetCullingOverlap(bool enable) {
+	WaitForRenderThread();
+
+	Gaia::renderEngine->SetCullingOverlap(enable);
+}
+
+void RendererDx12::SetAutoInstancing(bool enable) {
+	if (m_dataProcessed || !std::empty(m_modelSetIds))
+		throw Exception(
+			"Renderer Error", "Auto instancing can only be set before the model sets are added."
+		);
+
+	Gaia::renderEngine->SetAutoInstancing(enable);
+}
+
+void RendererDx12::RenderThreadLoop() {
+	try {
+		while (std::optional<FramePacket> framePacket = m_framePackets->Pop()) {
+			ReleaseCompletedFrames();
+
+			Gaia::cameraManager->SetFrameCamera(
+				framePacket->viewMatrix, framePacket->fovAngleInDegree
+			);
+			Gaia::bufferManager->ApplyFramePacket(*framePacket);
+
+			RenderFrame();
+		}
+	}
+	catch (...) {
+		// Set before the queue is closed, which the application thread synchronises with.
+		m_renderThreadError = std::current_exception();
+
+		m_framePackets->Close();
+	}
+}
+
+void RendererDx12::StopRenderThread() noexcept {
+	if (!m_framePackets)
+		return;
+
+	// The queued frames are still rendered.
+	m_framePackets->Close();
+	m_renderThread.join();
+
+	m_framePackets.reset();
+
+	Gaia::bufferManager->SetExternalModelSync(false);
+	Gaia::cameraManager->ClearFrameCamera();
+}
+
+void RendererDx12::WaitForRenderThread() {
+	if (!m_framePackets)
+		return;
+
+	m_framePackets->WaitUntilDrained();
+
+	if (m_framePackets->IsClosed() && m_renderThreadError)
+		std::rethrow_exception(std::exchange(m_renderThreadError, nullptr));
+}
+
+void RendererDx12::WaitForAsyncTasks() {
+	WaitForRenderThread();
+
+	// Current frame's value is already checked. So, check the rest
+	for (std::uint32_t _ = 0u; _ < m_bufferCount - 1u; ++_) {
+		Gaia::graphicsFence->AdvanceValueInQueue();
+		Gaia::graphicsFence->WaitOnCPUConditional();
+		Gaia::computeFence->AdvanceValueInQueue();
+		Gaia::computeFence->WaitOnCPUConditional();
+	}
+
+	// The last culling isn't waited for by any frame when it overlaps.
+	Gaia::computeFence->WaitOnCPUConditional(Gaia::computeFence->GetLastSignalledValue());
+}
@@ -1,12 +1,30 @@
-#include <RootSignatureBase.hpp>
-
-void RootSignatureBase::CreateSignature(ID3D12Device* device) {
-	device->CreateRootSignature(
-		0u, m_pSignatureBinary->GetBufferPointer(), m_pSignatureBinary->GetBufferSize(),
-		IID_PPV_ARGS(&m_pRootSignature)
-	);
-}
-
-ID3D12RootSignature* RootSignatureBase::Get() const noexcept {
-	return m_pRootSignature.Get();
-}
+#include <RootSignatureBase.hpp>
+#include <PipelineHasher.hpp>
+
+void RootSignatureBase::CreateSignature(ID3D12Device* device) {
+	device->CreateRootSignature(
+		0u, m_pSignatureBinary->GetBufferPointer(), m_pSignatureBinary->GetBufferSize(),
+		IID_PPV_ARGS(&m_pRootSignature)
+	);
+
+	const std::uint64_t signatureHash = PipelineHasher{}.AddBytes(
+		m_pSignatureBinary->GetBufferPointer(), m_pSignatureBinary->GetBufferSize()
+	).GetHash();
+
+	m_pRootSignature->SetPrivateData(
+		s_signatureHashGuid, static_cast<UINT>(sizeof(signatureHash)), &signatureHash
+	);
+}
+
+ID3D12RootSignature* RootSignatureBase::Get() const noexcept {
+	return m_pRootSignature.Get();
+}
+
+std::uint64_t RootSignatureBase::GetSignatureHash(ID3D12RootSignature* rootSignature) noexcept {
+	std::uint64_t signatureHash = 0u;
+	auto dataSize = static_cast<UINT>(sizeof(signatureHash));
+
+	rootSignature->GetPrivateData(s_signatureHashGuid, &dataSize, &signatureHash);
+
+	return signatureHash;
+}
@@ -1,43 +1,91 @@
-#include <Shader.hpp>
-#include <d3dcompiler.h>
-#include <fstream>
-#include <cassert>
-
-void Shader::LoadBinary(const std::wstring& fileName) {
-	D3DReadFileToBlob(fileName.c_str(), &m_pBinary);
-}
-
-void Shader::CompileBinary(
-	const std::wstring& fileName, const char* target,
-	const char* entryPoint
-) {
-#if defined(_DEBUG)
-	std::uint32_t compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#else
-	std::uint32_t compileFlags = 0;
-#endif
-
-	ComPtr<ID3DBlob> error;
-	D3DCompileFromFile(
-		fileName.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryPoint, target,
-		compileFlags, 0u, &m_pBinary, &error
-	);
-
-	if (error) {
-		std::ofstream log("ErrorLog.txt", std::ios_base::app | std::ios_base::out);
-		log << "Category : Shader Creation error    "
-			<< "Description : " << reinterpret_cast<char*>(error->GetBufferPointer()) << "    "
-			<< std::endl;
-	}
-
-	assert(!error && "Shader Creation error.");
-}
-
-D3D12_SHADER_BYTECODE Shader::GetByteCode() const noexcept {
-	D3D12_SHADER_BYTECODE byteCode{};
-
-	byteCode.BytecodeLength = m_pBinary->GetBufferSize();
-	byteCode.pShaderBytecode = m_pBinary->GetBufferPointer();
-
-	return byteCode;
-}
+#include <Shader.hpp>
+#include <Exception.hpp>
+#include <d3dcompiler.h>
+#include <fstream>
+#include <cassert>
+
+Shader::Shader() noexcept
+	: m_fileMapping{ nullptr }, m_mappedView{ nullptr }, m_mappedSize{ 0u } {}
+
+Shader::~Shader() noexcept {
+	if (m_mappedView)
+		UnmapViewOfFile(m_mappedView);
+
+	if (m_fileMapping)
+		CloseHandle(m_fileMapping);
+}
+
+void Shader::LoadBinary(const std::wstring& fileName) {
+	D3DReadFileToBlob(fileName.c_str(), &m_pBinary);
+}
+
+void Shader::MapBinary(const std::wstring& fileName) {
+	// Shared for deletion, so the file can still be replaced by a rename.
+	HANDLE file = CreateFileW(
+		fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+	);
+
+	if (file == INVALID_HANDLE_VALUE)
+		throw Exception("Shader Error", "The shader file couldn't be opened.");
+
+	LARGE_INTEGER fileSize{};
+	const BOOL sizeRead = GetFileSizeEx(file, &fileSize);
+
+	// The mapping keeps its own reference to the file.
+	if (sizeRead && fileSize.QuadPart != 0)
+		m_fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+
+	CloseHandle(file);
+
+	if (!m_fileMapping)
+		throw Exception("Shader Error", "The shader file couldn't be mapped.");
+
+	m_mappedView = MapViewOfFile(m_fileMapping, FILE_MAP_READ, 0u, 0u, 0u);
+
+	if (!m_mappedView)
+		throw Exception("Shader Error", "The shader file couldn't be mapped.");
+
+	m_mappedSize = static_cast<size_t>(fileSize.QuadPart);
+}
+
+void Shader::CompileBinary(
+	const std::wstring& fileName, const char* target,
+	const char* entryPoint
+) {
+#if defined(_DEBUG)
+	std::uint32_t compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	std::uint32_t compileFlags = 0;
+#endif
+
+	ComPtr<ID3DBlob> error;
+	D3DCompileFromFile(
+		fileName.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryPoint, target,
+		compileFlags, 0u, &m_pBinary, &error
+	);
+
+	if (error) {
+		std::ofstream log("ErrorLog.txt", std::ios_base::app | std::ios_base::out);
+		log << "Category : Shader Creation error    "
+			<< "Description : " << reinterpret_cast<char*>(error->GetBufferPointer()) << "    "
+			<< std::endl;
+	}
+
+	assert(!error && "Shader Creation error.");
+}
+
+D3D12_SHADER_BYTECODE Shader::GetByteCode() const noexcept {
+	D3D12_SHADER_BYTECODE byteCode{};
+
+	if (m_mappedView) {
+		byteCode.BytecodeLength = m_mappedSize;
+		byteCode.pShaderBytecode = m_mappedView;
+	}
+	else {
+		byteCode.BytecodeLength = m_pBinary->GetBufferSize();
+		byteCode.pShaderBytecode = m_pBinary->GetBufferPointer();
+	}
+
+	return byteCode;
+}
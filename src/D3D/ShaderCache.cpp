@@ -0,0 +1,111 @@
+#include <ShaderCache.hpp>
+#include <Exception.hpp>
+#include <cstring>
+
+ShaderCache::ShaderCache() noexcept : m_stats{} {}
+
+std::shared_ptr<const Shader> ShaderCache::LoadBinary(const std::wstring& fileName) {
+	std::error_code errorCode{};
+
+	const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(
+		fileName, errorCode
+	);
+	const std::uintmax_t fileSize = errorCode ? 0u : std::filesystem::file_size(
+		fileName, errorCode
+	);
+
+	if (errorCode)
+		throw Exception("ShaderCache Error", "The shader file couldn't be found.");
+
+	{
+		std::lock_guard<std::mutex> lock{ m_cacheMutex };
+
+		auto file = m_files.find(fileName);
+
+		if (file != std::end(m_files) && file->second.writeTime == writeTime
+			&& file->second.fileSize == fileSize) {
+			++m_stats.hits;
+
+			return file->second.shader;
+		}
+	}
+
+	// Mapping and hashing don't touch the cache, so other loads don't wait on them.
+	auto shader = std::make_shared<Shader>();
+	shader->MapBinary(fileName);
+
+	const D3D12_SHADER_BYTECODE byteCode = shader->GetByteCode();
+	const std::uint64_t contentHash = HashByteCode(byteCode);
+
+	std::lock_guard<std::mutex> lock{ m_cacheMutex };
+
+	std::shared_ptr<const Shader> cachedShader{};
+
+	auto [content, contentEnd] = m_contents.equal_range(contentHash);
+
+	while (content != contentEnd) {
+		std::shared_ptr<const Shader> contentShader = content->second.lock();
+
+		if (!contentShader) {
+			content = m_contents.erase(content);
+
+			continue;
+		}
+
+		if (IsSameByteCode(contentShader->GetByteCode(), byteCode)) {
+			cachedShader = std::move(contentShader);
+
+			break;
+		}
+
+		++content;
+	}
+
+	if (cachedShader)
+		++m_stats.contentHits;
+	else {
+		++m_stats.misses;
+		m_stats.bytesMapped += byteCode.BytecodeLength;
+
+		m_contents.emplace(contentHash, shader);
+		cachedShader = std::move(shader);
+	}
+
+	m_files.insert_or_assign(fileName, FileEntry{ writeTime, fileSize, cachedShader });
+
+	return cachedShader;
+}
+
+void ShaderCache::Clear() noexcept {
+	std::lock_guard<std::mutex> lock{ m_cacheMutex };
+
+	m_files.clear();
+	m_contents.clear();
+}
+
+ShaderCache::CacheStats ShaderCache::GetCacheStats() const noexcept {
+	std::lock_guard<std::mutex> lock{ m_cacheMutex };
+
+	return m_stats;
+}
+
+std::uint64_t ShaderCache::HashByteCode(const D3D12_SHADER_BYTECODE& byteCode) noexcept {
+	// FNV-1a, the hash only picks the candidates and the bytes are compared anyway.
+	std::uint64_t hash = 14695981039346656037u;
+
+	auto bytes = static_cast<const std::uint8_t*>(byteCode.pShaderBytecode);
+
+	for (size_t index = 0u; index < byteCode.BytecodeLength; ++index) {
+		hash ^= bytes[index];
+		hash *= 1099511628211u;
+	}
+
+	return hash;
+}
+
+bool ShaderCache::IsSameByteCode(
+	const D3D12_SHADER_BYTECODE& lhs, const D3D12_SHADER_BYTECODE& rhs
+) noexcept {
+	return lhs.BytecodeLength == rhs.BytecodeLength
+		&& std::memcmp(lhs.pShaderBytecode, rhs.pShaderBytecode, lhs.BytecodeLength) == 0;
+}
@@ -0,0 +1,92 @@
+#include <StagingUploader.hpp>
+#include <Gaia.hpp>
+#include <cstring>
+
+void StagingUploader::AddBuffer(
+	ID3D12Device* device, void const* source, size_t size, ID3D12Resource* destination,
+	UINT64 destinationOffset
+) {
+	const UploadRing::Allocation allocation = Gaia::Resources::uploadRing->Allocate(
+		device, size, BUFFERCOPYALIGNMENT
+	);
+
+	memcpy(allocation.cpuAddress, source, size);
+
+	m_pendingCopies.emplace_back(
+		PendingCopy{
+			.source = allocation.resource,
+			.sourceOffset = allocation.offset,
+			.destination = destination,
+			.destinationOffset = destinationOffset,
+			.size = static_cast<UINT64>(size),
+			.texture = false
+		}
+	);
+}
+
+void StagingUploader::AddTexture(
+	ID3D12Device* device, void const* source, ID3D12Resource* destination
+) {
+	const D3D12_RESOURCE_DESC textureDesc = destination->GetDesc();
+	const UINT64 rowPitch = D3DResourceView::CalculateRowPitch(textureDesc.Width);
+
+	const UploadRing::Allocation allocation = Gaia::Resources::uploadRing->Allocate(
+		device, static_cast<size_t>(rowPitch * textureDesc.Height),
+		D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+	);
+
+	const size_t sourceRowPitch = textureDesc.Width * 4u;
+
+	for (size_t row = 0u; row < textureDesc.Height; ++row)
+		memcpy(
+			allocation.cpuAddress + rowPitch * row,
+			static_cast<std::uint8_t const*>(source) + sourceRowPitch * row, sourceRowPitch
+		);
+
+	m_pendingCopies.emplace_back(
+		PendingCopy{
+			.source = allocation.resource,
+			.sourceOffset = allocation.offset,
+			.destination = destination,
+			.destinationOffset = 0u,
+			.size = rowPitch,
+			.texture = true
+		}
+	);
+}
+
+void StagingUploader::RecordUploads(ID3D12GraphicsCommandList* commandList) {
+	for (const PendingCopy& copy : m_pendingCopies) {
+		if (copy.texture) {
+			const D3D12_RESOURCE_DESC textureDesc = copy.destination->GetDesc();
+
+			D3D12_TEXTURE_COPY_LOCATION dest{};
+			dest.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+			dest.pResource = copy.destination;
+			dest.SubresourceIndex = 0u;
+
+			D3D12_TEXTURE_COPY_LOCATION src{};
+			src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+			src.pResource = copy.source;
+			src.PlacedFootprint.Offset = copy.sourceOffset;
+			src.PlacedFootprint.Footprint.Format = textureDesc.Format;
+			src.PlacedFootprint.Footprint.Width = static_cast<UINT>(textureDesc.Width);
+			src.PlacedFootprint.Footprint.Height = textureDesc.Height;
+			src.PlacedFootprint.Footprint.Depth = 1u;
+			src.PlacedFootprint.Footprint.RowPitch = static_cast<UINT>(copy.size);
+
+			commandList->CopyTextureRegion(&dest, 0u, 0u, 0u, &src, nullptr);
+		}
+		else
+			commandList->CopyBufferRegion(
+				copy.destination, copy.destinationOffset, copy.source, copy.sourceOffset,
+				copy.size
+			);
+	}
+
+	m_pendingCopies.clear();
+}
+
+bool StagingUploader::IsEmpty() const noexcept {
+	return std::empty(m_pendingCopies);
+}
@@ -1,81 +1,177 @@
-#include <TextureStorage.hpp>
-#include <Gaia.hpp>
-
-TextureStorage::TextureStorage() noexcept : m_textureDescriptorStart{} {}
-
-size_t TextureStorage::AddTexture(
-	ID3D12Device* device, std::unique_ptr<std::uint8_t> textureDataHandle, size_t width,
-	size_t height
-) noexcept {
-	const size_t relativeTextureOffset =
-		Gaia::descriptorTable->ReserveDescriptorsTextureAndGetRelativeOffset();
-
-	auto textureDescriptor =
-		std::make_unique<D3DUploadResourceDescriptorView>(DescriptorType::SRV);
-	textureDescriptor->SetDescriptorOffset(
-		relativeTextureOffset,
-		device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
-	);
-	textureDescriptor->SetTextureInfo(
-		device, static_cast<UINT64>(width), static_cast<UINT>(height),
-		DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, false
-	);
-
-	m_textureHandles.emplace_back(std::move(textureDataHandle));
-	m_textureDescriptors.emplace_back(std::move(textureDescriptor));
-
-	return relativeTextureOffset;
-}
-
-void TextureStorage::CreateBufferViews(ID3D12Device* device) {
-	const D3D12_CPU_DESCRIPTOR_HANDLE uploadDescriptorStart =
-		Gaia::descriptorTable->GetUploadDescriptorStart();
-	const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorStart =
-		Gaia::descriptorTable->GetGPUDescriptorStart();
-
-	const size_t textureRangeStart = Gaia::descriptorTable->GetTextureRangeStart();
-
-	const size_t descSize =
-		device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	m_textureDescriptorStart.ptr = gpuDescriptorStart.ptr + (descSize * textureRangeStart);
-
-	for (size_t index = 0u; index < std::size(m_textureDescriptors); ++index) {
-		auto& textureDescriptor = m_textureDescriptors[index];
-
-		textureDescriptor->UpdateDescriptorOffset(textureRangeStart);
-		textureDescriptor->CreateDescriptorView(
-			device, uploadDescriptorStart, gpuDescriptorStart,
-			D3D12_RESOURCE_STATE_COPY_DEST
-		);
-
-		const D3D12_RESOURCE_DESC textureDesc = textureDescriptor->GetResourceDesc();
-		Gaia::Resources::uploadContainer->AddMemory(
-			m_textureHandles[index].get(), textureDescriptor->GetFirstCPUWPointer(),
-			textureDesc.Width * 4u, textureDesc.Height
-		);
-	}
-}
-
-void TextureStorage::BindTextures(ID3D12GraphicsCommandList* graphicsList) const noexcept {
-	static constexpr size_t texturesIndex = static_cast<size_t>(RootSigElement::Textures);
-
-	graphicsList->SetGraphicsRootDescriptorTable(
-		m_graphicsRSLayout[texturesIndex], m_textureDescriptorStart
-	);
-}
-
-void TextureStorage::RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept {
-	for (auto& textureDesc : m_textureDescriptors)
-		textureDesc->RecordResourceUpload(copyList);
-}
-
-void TextureStorage::ReleaseUploadResource() noexcept {
-	for (auto& textureDesc : m_textureDescriptors)
-		textureDesc->ReleaseUploadResource();
-
-	m_textureHandles = std::vector<std::unique_ptr<std::uint8_t>>();
-}
-
-void TextureStorage::SetGraphicsRootSignatureLayout(std::vector<UINT> rsLayout) noexcept {
-	m_graphicsRSLayout = std::move(rsLayout);
-}
+#include <TextureStorage.hpp>
+#include <Gaia.hpp>
+#include <D3DHelperFunctions.hpp>
+#include <Exception.hpp>
+
+TextureStorage::TextureStorage() noexcept
+	: m_textureDescriptorStart{}, m_viewsCreated{ false } {}
+
+size_t TextureStorage::AddTexture(
+	ID3D12Device* device, std::unique_ptr<std::uint8_t> textureDataHandle, size_t width,
+	size_t height
+) {
+	if (m_viewsCreated)
+		return AddRuntimeTexture(device, textureDataHandle.get(), width, height);
+
+	const size_t relativeTextureOffset =
+		Gaia::descriptorTable->ReserveDescriptorsTextureAndGetRelativeOffset();
+
+	auto textureDescriptor =
+		std::make_unique<D3DUploadResourceDescriptorView>(DescriptorType::SRV);
+	textureDescriptor->SetDescriptorOffset(
+		relativeTextureOffset,
+		device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
+	);
+	textureDescriptor->SetTextureInfo(
+		device, static_cast<UINT64>(width), static_cast<UINT>(height),
+		DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, false
+	);
+
+	m_textureHandles.emplace_back(std::move(textureDataHandle));
+	m_textureDescriptors.emplace_back(std::move(textureDescriptor));
+
+	return relativeTextureOffset;
+}
+
+size_t TextureStorage::AddRuntimeTexture(
+	ID3D12Device* device, std::uint8_t const* textureData, size_t width, size_t height
+) {
+	if (std::empty(m_freeTextureIndices))
+		throw Exception("TextureStorage Error", "The texture capacity is exceeded.");
+
+	auto texture = std::make_shared<D3DResourceView>(ResourceType::gpuOnly);
+	texture->SetTextureInfo(
+		static_cast<UINT64>(width), static_cast<UINT>(height),
+		DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, false
+	);
+	texture->ReserveHeapSpace(device);
+	texture->CreateResource(device, D3D12_RESOURCE_STATE_COPY_DEST);
+
+	m_stagingUploader.AddTexture(device, textureData, texture->GetResource());
+	m_pendingTextures.emplace_back(texture->GetResource());
+
+	const size_t textureIndex = m_freeTextureIndices.back();
+	m_freeTextureIndices.pop_back();
+
+	// The free descriptors aren't used by any frame, so they can be written directly.
+	const size_t descSize =
+		device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = Gaia::descriptorTable->GetCPUDescriptorStart();
+	cpuHandle.ptr += descSize * (Gaia::descriptorTable->GetTextureRangeStart() + textureIndex);
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC desc{
+		.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+		.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D,
+		.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING
+	};
+	desc.Texture2D.MipLevels = 1u;
+
+	device->CreateShaderResourceView(texture->GetResource(), &desc, cpuHandle);
+
+	m_runtimeTextures[textureIndex] = std::move(texture);
+
+	return textureIndex;
+}
+
+void TextureStorage::RemoveTexture(size_t textureIndex) {
+	std::shared_ptr<D3DResourceView> texture = std::move(m_runtimeTextures[textureIndex]);
+
+	// The frames in flight might still sample the texture through the descriptor.
+	Gaia::ReleaseAfterCurrentFrame(
+		[this, textureIndex, texture = std::move(texture)] {
+			if (texture)
+				texture->ReleaseResource();
+
+			m_freeTextureIndices.emplace_back(textureIndex);
+		}
+	);
+}
+
+void TextureStorage::SetSpareCapacity(size_t textureCount) noexcept {
+	if (!textureCount)
+		return;
+
+	const size_t spareStart =
+		Gaia::descriptorTable->ReserveDescriptorsTextureAndGetRelativeOffset(textureCount);
+
+	// Reversed, so the lower indices are handed out first.
+	for (size_t index = spareStart + textureCount; index > spareStart; --index)
+		m_freeTextureIndices.emplace_back(index - 1u);
+}
+
+void TextureStorage::CreateBufferViews(ID3D12Device* device) {
+	const D3D12_CPU_DESCRIPTOR_HANDLE uploadDescriptorStart =
+		Gaia::descriptorTable->GetUploadDescriptorStart();
+	const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorStart =
+		Gaia::descriptorTable->GetGPUDescriptorStart();
+
+	const size_t textureRangeStart = Gaia::descriptorTable->GetTextureRangeStart();
+
+	const size_t descSize =
+		device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	m_textureDescriptorStart.ptr = gpuDescriptorStart.ptr + (descSize * textureRangeStart);
+
+	for (size_t index = 0u; index < std::size(m_textureDescriptors); ++index) {
+		auto& textureDescriptor = m_textureDescriptors[index];
+
+		textureDescriptor->UpdateDescriptorOffset(textureRangeStart);
+		textureDescriptor->CreateDescriptorView(
+			device, uploadDescriptorStart, gpuDescriptorStart,
+			D3D12_RESOURCE_STATE_COPY_DEST
+		);
+
+		const D3D12_RESOURCE_DESC textureDesc = textureDescriptor->GetResourceDesc();
+		Gaia::Resources::uploadContainer->AddMemory(
+			m_textureHandles[index].get(), textureDescriptor->GetFirstCPUWPointer(),
+			textureDesc.Width * 4u, textureDesc.Height
+		);
+	}
+
+	m_runtimeTextures.resize(Gaia::descriptorTable->GetTextureDescriptorCount());
+	m_viewsCreated = true;
+}
+
+void TextureStorage::BindTextures(ID3D12GraphicsCommandList* graphicsList) const noexcept {
+	static constexpr size_t texturesIndex = static_cast<size_t>(RootSigElement::Textures);
+
+	graphicsList->SetGraphicsRootDescriptorTable(
+		m_graphicsRSLayout[texturesIndex], m_textureDescriptorStart
+	);
+}
+
+void TextureStorage::RecordResourceUpload(ID3D12GraphicsCommandList* copyList) noexcept {
+	for (auto& textureDesc : m_textureDescriptors)
+		textureDesc->RecordResourceUpload(copyList);
+}
+
+void TextureStorage::RecordRuntimeUploads(ID3D12GraphicsCommandList* graphicsList) {
+	if (m_stagingUploader.IsEmpty())
+		return;
+
+	m_stagingUploader.RecordUploads(graphicsList);
+
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+	for (ID3D12Resource* texture : m_pendingTextures)
+		barriers.emplace_back(
+			GetTransitionBarrier(
+				texture, D3D12_RESOURCE_STATE_COPY_DEST,
+				D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+			)
+		);
+
+	graphicsList->ResourceBarrier(static_cast<UINT>(std::size(barriers)), std::data(barriers));
+
+	m_pendingTextures.clear();
+}
+
+void TextureStorage::ReleaseUploadResource() noexcept {
+	for (auto& textureDesc : m_textureDescriptors)
+		textureDesc->ReleaseUploadResource();
+
+	m_textureHandles = std::vector<std::unique_ptr<std::uint8_t>>();
+}
+
+void TextureStorage::SetGraphicsRootSignatureLayout(std::vector<UINT> rsLayout) noexcept {
+	m_graphicsRSLayout = std::move(rsLayout);
+}
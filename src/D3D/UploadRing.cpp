@@ -0,0 +1,72 @@
+#include <UploadRing.hpp>
+#include <Gaia.hpp>
+
+UploadRing::UploadRing() noexcept
+	: m_ringBuffer{ ResourceType::upload }, m_ringCreated{ false } {}
+
+void UploadRing::SetCapacity(size_t capacity) noexcept {
+	m_allocator.SetCapacity(capacity);
+}
+
+void UploadRing::ReserveHeapSpace(ID3D12Device* device) {
+	if (!m_allocator.GetCapacity())
+		return;
+
+	m_ringBuffer.SetBufferInfo(static_cast<UINT64>(m_allocator.GetCapacity()));
+	m_ringBuffer.ReserveHeapSpace(device);
+}
+
+void UploadRing::CreateResource(ID3D12Device* device) {
+	if (!m_allocator.GetCapacity())
+		return;
+
+	m_ringBuffer.CreateResource(device, D3D12_RESOURCE_STATE_GENERIC_READ);
+	m_ringCreated = true;
+}
+
+UploadRing::Allocation UploadRing::Allocate(
+	ID3D12Device* device, size_t size, size_t alignment
+) {
+	// A single large upload would otherwise hold most of the ring for a whole frame.
+	if (!m_ringCreated || size > m_allocator.GetCapacity() / 4u)
+		return AllocateDedicatedChunk(device, size);
+
+	const std::optional<size_t> offset = m_allocator.Allocate(
+		size, alignment, Gaia::graphicsFence->GetFrontValue()
+	);
+
+	if (!offset)
+		return AllocateDedicatedChunk(device, size);
+
+	return Allocation{
+		.resource = m_ringBuffer.GetResource(),
+		.offset = static_cast<UINT64>(*offset),
+		.cpuAddress = m_ringBuffer.GetFirstCPUWPointer() + *offset
+	};
+}
+
+UploadRing::Allocation UploadRing::AllocateDedicatedChunk(ID3D12Device* device, size_t size) {
+	auto chunk = std::make_shared<D3DResourceView>(ResourceType::upload);
+
+	chunk->SetBufferInfo(static_cast<UINT64>(size));
+	chunk->ReserveHeapSpace(device);
+	chunk->CreateResource(device, D3D12_RESOURCE_STATE_GENERIC_READ);
+
+	const Allocation allocation{
+		.resource = chunk->GetResource(),
+		.offset = 0u,
+		.cpuAddress = chunk->GetFirstCPUWPointer()
+	};
+
+	Gaia::ReleaseAfterCurrentFrame([chunk] { chunk->ReleaseResource(); });
+
+	return allocation;
+}
+
+void UploadRing::Reclaim(UINT64 completedFenceValue) noexcept {
+	m_allocator.Reclaim(static_cast<std::uint64_t>(completedFenceValue));
+}
+
+size_t UploadRing::GetUsedSize() const noexcept {
+	return m_allocator.GetUsedSize();
+}
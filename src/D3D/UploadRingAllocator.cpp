@@ -0,0 +1,61 @@
+#include <UploadRingAllocator.hpp>
+#include <SizeHelpers.hpp>
+
+UploadRingAllocator::UploadRingAllocator(size_t capacity) noexcept
+	: m_capacity{ capacity }, m_head{ 0u }, m_usedSize{ 0u } {}
+
+std::optional<size_t> UploadRingAllocator::Allocate(
+	size_t size, size_t alignment, std::uint64_t fenceValue
+) noexcept {
+	size_t offset = Align(m_head, alignment);
+
+	// The end of the ring is skipped if the allocation doesn't fit before it.
+	if (offset + size > m_capacity)
+		offset = 0u;
+
+	const size_t padding = offset >= m_head ? offset - m_head : m_capacity - m_head;
+	const size_t requiredSize = padding + size;
+
+	if (m_usedSize + requiredSize > m_capacity)
+		return {};
+
+	if (!std::empty(m_regions) && m_regions.back().fenceValue == fenceValue)
+		m_regions.back().size += requiredSize;
+	else
+		m_regions.emplace_back(Region{ .fenceValue = fenceValue, .size = requiredSize });
+
+	m_usedSize += requiredSize;
+	m_head = offset + size;
+
+	return offset;
+}
+
+void UploadRingAllocator::Reclaim(std::uint64_t completedFenceValue) noexcept {
+	while (!std::empty(m_regions) && m_regions.front().fenceValue <= completedFenceValue) {
+		m_usedSize -= m_regions.front().size;
+		m_regions.pop_front();
+	}
+
+	// Starting over keeps the next allocations from being split at the end.
+	if (std::empty(m_regions))
+		m_head = 0u;
+}
+
+void UploadRingAllocator::SetCapacity(size_t capacity) noexcept {
+	m_capacity = capacity;
+	m_head = 0u;
+	m_usedSize = 0u;
+	m_regions.clear();
+}
+
+size_t UploadRingAllocator::GetCapacity() const noexcept {
+	return m_capacity;
+}
+
+size_t UploadRingAllocator::GetUsedSize() const noexcept {
+	return m_usedSize;
+}
+
+size_t UploadRingAllocator::GetRegionCount() const noexcept {
+	return std::size(m_regions);
+}
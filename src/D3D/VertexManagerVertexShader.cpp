@@ -1,82 +1,239 @@
-#include <VertexManagerVertexShader.hpp>
-#include <Gaia.hpp>
-
-VertexManagerVertexShader::VertexManagerVertexShader() noexcept
-	: m_gVertexBufferView{}, m_gIndexBufferView{}, m_verticesOffset{ 0u },
-	m_indicesOffset{ 0u } {}
-
-void VertexManagerVertexShader::AddGVerticesAndIndices(
-	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
-) noexcept {
-	const auto vertexStrideSize = static_cast<UINT>(sizeof(Vertex));
-	const size_t vertexBufferSize = vertexStrideSize * std::size(gVertices);
-	const size_t indexBufferSize = sizeof(std::uint32_t) * std::size(gIndices);
-
-	const size_t vertexOffset = m_vertexBuffer.ReserveSpaceAndGetOffset(
-		vertexBufferSize
-	);
-	const size_t indexOffset = m_vertexBuffer.ReserveSpaceAndGetOffset(
-		indexBufferSize
-	);
-
-	m_gVertexBufferView = D3D12_VERTEX_BUFFER_VIEW{
-		.BufferLocation = static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(vertexOffset),
-		.SizeInBytes = static_cast<UINT>(vertexBufferSize),
-		.StrideInBytes = vertexStrideSize
-	};
-
-	m_gVertices = std::move(gVertices);
-
-	m_gIndexBufferView = D3D12_INDEX_BUFFER_VIEW{
-		.BufferLocation = static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(indexOffset),
-		.SizeInBytes = static_cast<UINT>(indexBufferSize),
-		.Format = DXGI_FORMAT_R32_UINT
-	};
-
-	m_gIndices = std::move(gIndices);
-}
-
-void VertexManagerVertexShader::BindVertexAndIndexBuffer(
-	ID3D12GraphicsCommandList* graphicsCmdList
-) const noexcept {
-	graphicsCmdList->IASetVertexBuffers(0u, 1u, &m_gVertexBufferView);
-	graphicsCmdList->IASetIndexBuffer(&m_gIndexBufferView);
-}
-
-void VertexManagerVertexShader::CreateBuffers(ID3D12Device* device) {
-	m_vertexBuffer.CreateResource(device);
-
-	std::uint8_t* vertexCpuStart = m_vertexBuffer.GetCPUStartAddress();
-
-	Gaia::Resources::uploadContainer->AddMemory(
-		std::data(m_gVertices), vertexCpuStart + m_gVertexBufferView.BufferLocation,
-		m_gVertexBufferView.SizeInBytes
-	);
-
-	Gaia::Resources::uploadContainer->AddMemory(
-		std::data(m_gIndices), vertexCpuStart + m_gIndexBufferView.BufferLocation,
-		m_gIndexBufferView.SizeInBytes
-	);
-
-	const D3D12_GPU_VIRTUAL_ADDRESS vertexGpuStart = m_vertexBuffer.GetGPUStartAddress();
-
-	m_gVertexBufferView.BufferLocation += vertexGpuStart;
-	m_gIndexBufferView.BufferLocation += vertexGpuStart;
-}
-
-void VertexManagerVertexShader::ReserveBuffers(ID3D12Device* device) {
-	m_vertexBuffer.ReserveHeapSpace(device);
-}
-
-void VertexManagerVertexShader::RecordResourceUploads(
-	ID3D12GraphicsCommandList* copyList
-) noexcept {
-	m_vertexBuffer.RecordResourceUpload(copyList);
-}
-
-void VertexManagerVertexShader::ReleaseUploadResources() noexcept {
-	m_vertexBuffer.ReleaseUploadResource();
-
-	m_gIndices = std::vector<std::uint32_t>{};
-	m_gVertices = std::vector<Vertex>{};
-}
+#include <VertexManagerVertexShader.hpp>
+#include <Gaia.hpp>
+#include <D3DResourceBarrier.hpp>
+#include <Exception.hpp>
+#include <algorithm>
+
+VertexManagerVertexShader::VertexManagerVertexShader(VertexFormat vertexFormat) noexcept
+	: m_gVertexBufferView{}, m_gIndexBufferView{}, m_verticesOffset{ 0u },
+	m_indicesOffset{ 0u }, m_spareVertexCount{ 0u }, m_spareIndexCount{ 0u },
+	m_vertexFormat{ vertexFormat }, m_bufferCreated{ false } {}
+
+std::optional<OffsetAllocator::Allocation> VertexManagerVertexShader::AllocateElements(
+	OffsetAllocator& allocator, size_t elementCount, bool bufferCreated
+) noexcept {
+	// Empty inputs still get an allocation, so every input can be freed the same way.
+	elementCount = std::max(elementCount, size_t{ 1u });
+
+	if (!bufferCreated)
+		return allocator.AllocateAndGrow(elementCount, 1u);
+
+	return allocator.Allocate(elementCount, 1u);
+}
+
+template<typename VertexType>
+ModelInputRange VertexManagerVertexShader::AddInputs(
+	std::vector<VertexType>& gVertices, std::vector<std::uint32_t>& gIndices,
+	std::vector<VertexType>& gBufferVertices
+) {
+	std::optional<OffsetAllocator::Allocation> vertexAllocation = AllocateElements(
+		m_vertexAllocator, std::size(gVertices), m_bufferCreated
+	);
+	std::optional<OffsetAllocator::Allocation> indexAllocation;
+
+	if (vertexAllocation)
+		indexAllocation = AllocateElements(m_indexAllocator, std::size(gIndices), m_bufferCreated);
+
+	if (!indexAllocation) {
+		if (vertexAllocation)
+			m_vertexAllocator.Free(vertexAllocation->handle);
+
+		throw Exception("VertexManager Error", "Not enough free space for the model inputs.");
+	}
+
+	const size_t vertexOffset = vertexAllocation->offset;
+	const size_t indexOffset = indexAllocation->offset;
+
+	// The draws don't set a base vertex.
+	for (std::uint32_t& index : gIndices)
+		index += static_cast<std::uint32_t>(vertexOffset);
+
+	if (!m_bufferCreated) {
+		gBufferVertices.resize(
+			std::max(std::size(gBufferVertices), vertexOffset + std::size(gVertices))
+		);
+		std::ranges::copy(gVertices, std::begin(gBufferVertices) + vertexOffset);
+
+		m_gIndices.resize(std::max(std::size(m_gIndices), indexOffset + std::size(gIndices)));
+		std::ranges::copy(gIndices, std::begin(m_gIndices) + indexOffset);
+	}
+	else {
+		// Nothing in flight reads the free ranges and the copies are ordered after the
+		// earlier frames on the graphics queue.
+		ID3D12Device* device = Gaia::device->GetDeviceRef();
+		ID3D12Resource* buffer = m_vertexBuffer.GetResource();
+
+		if (!std::empty(gVertices))
+			m_stagingUploader.AddBuffer(
+				device, std::data(gVertices), sizeof(VertexType) * std::size(gVertices),
+				buffer, m_verticesOffset + sizeof(VertexType) * vertexOffset
+			);
+
+		if (!std::empty(gIndices))
+			m_stagingUploader.AddBuffer(
+				device, std::data(gIndices), sizeof(std::uint32_t) * std::size(gIndices), buffer,
+				m_indicesOffset + sizeof(std::uint32_t) * indexOffset
+			);
+	}
+
+	size_t inputId = std::size(m_inputAllocations);
+
+	if (!std::empty(m_freeInputIds)) {
+		inputId = m_freeInputIds.back();
+		m_freeInputIds.pop_back();
+	}
+	else
+		m_inputAllocations.emplace_back();
+
+	m_inputAllocations[inputId] = InputAllocation{
+		.vertexHandle = vertexAllocation->handle,
+		.indexHandle = indexAllocation->handle,
+		.indexOffset = static_cast<std::uint32_t>(indexOffset),
+		.indexCount = static_cast<std::uint32_t>(std::size(gIndices))
+	};
+
+	return ModelInputRange{
+		.inputId = inputId, .indexOffset = static_cast<std::uint32_t>(indexOffset)
+	};
+}
+
+ModelInputRange VertexManagerVertexShader::AddGVerticesAndIndices(
+	std::vector<Vertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+) {
+	if (m_vertexFormat != VertexFormat::Full)
+		throw Exception("VertexManager Error", "The renderer takes packed vertices.");
+
+	return AddInputs(gVertices, gIndices, m_gVertices);
+}
+
+ModelInputRange VertexManagerVertexShader::AddGVerticesAndIndices(
+	std::vector<PackedVertex>&& gVertices, std::vector<std::uint32_t>&& gIndices
+) {
+	if (m_vertexFormat != VertexFormat::Packed)
+		throw Exception("VertexManager Error", "The renderer takes full vertices.");
+
+	return AddInputs(gVertices, gIndices, m_gPackedVertices);
+}
+
+void VertexManagerVertexShader::RemoveGVerticesAndIndices(size_t inputId) {
+	// Freeing the handles twice would corrupt the allocators.
+	if (inputId >= std::size(m_inputAllocations) || !m_inputAllocations[inputId])
+		throw Exception(
+			"VertexManager Error", "The model inputs don't exist or were already removed."
+		);
+
+	std::optional<InputAllocation>& inputAllocation = m_inputAllocations[inputId];
+
+	// Later inputs could be copied over the indices the model still draws.
+	if (Gaia::bufferManager->IsIndexRangeUsed(
+		inputAllocation->indexOffset, inputAllocation->indexCount
+	))
+		throw Exception("VertexManager Error", "A model which isn't removed draws the inputs.");
+
+	m_vertexAllocator.Free(inputAllocation->vertexHandle);
+	m_indexAllocator.Free(inputAllocation->indexHandle);
+
+	inputAllocation.reset();
+	m_freeInputIds.emplace_back(inputId);
+}
+
+void VertexManagerVertexShader::SetSpareCapacity(
+	size_t vertexCount, size_t indexCount
+) noexcept {
+	m_spareVertexCount = vertexCount;
+	m_spareIndexCount = indexCount;
+}
+
+void VertexManagerVertexShader::BindVertexAndIndexBuffer(
+	ID3D12GraphicsCommandList* graphicsCmdList
+) const noexcept {
+	graphicsCmdList->IASetVertexBuffers(0u, 1u, &m_gVertexBufferView);
+	graphicsCmdList->IASetIndexBuffer(&m_gIndexBufferView);
+}
+
+void VertexManagerVertexShader::CreateBuffers(ID3D12Device* device) {
+	m_vertexBuffer.CreateResource(device);
+
+	std::uint8_t* vertexCpuStart = m_vertexBuffer.GetCPUStartAddress();
+
+	// Only the vertices of the format were added.
+	if (m_vertexFormat == VertexFormat::Packed)
+		Gaia::Resources::uploadContainer->AddMemory(
+			std::data(m_gPackedVertices), vertexCpuStart + m_verticesOffset,
+			sizeof(PackedVertex) * std::size(m_gPackedVertices)
+		);
+	else
+		Gaia::Resources::uploadContainer->AddMemory(
+			std::data(m_gVertices), vertexCpuStart + m_verticesOffset,
+			sizeof(Vertex) * std::size(m_gVertices)
+		);
+
+	Gaia::Resources::uploadContainer->AddMemory(
+		std::data(m_gIndices), vertexCpuStart + m_indicesOffset,
+		sizeof(std::uint32_t) * std::size(m_gIndices)
+	);
+
+	const D3D12_GPU_VIRTUAL_ADDRESS vertexGpuStart = m_vertexBuffer.GetGPUStartAddress();
+
+	m_gVertexBufferView.BufferLocation = vertexGpuStart + m_verticesOffset;
+	m_gIndexBufferView.BufferLocation = vertexGpuStart + m_indicesOffset;
+
+	m_bufferCreated = true;
+}
+
+void VertexManagerVertexShader::ReserveBuffers(ID3D12Device* device) {
+	m_vertexAllocator.AddSpareSpace(m_spareVertexCount, 1u);
+	m_indexAllocator.AddSpareSpace(m_spareIndexCount, 1u);
+
+	const auto vertexStrideSize = static_cast<UINT>(
+		m_vertexFormat == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex)
+	);
+	const size_t vertexBufferSize = vertexStrideSize * m_vertexAllocator.GetCapacity();
+	const size_t indexBufferSize = sizeof(std::uint32_t) * m_indexAllocator.GetCapacity();
+
+	m_verticesOffset = m_vertexBuffer.ReserveSpaceAndGetOffset(vertexBufferSize);
+	m_indicesOffset = m_vertexBuffer.ReserveSpaceAndGetOffset(indexBufferSize);
+
+	m_gVertexBufferView = D3D12_VERTEX_BUFFER_VIEW{
+		.BufferLocation = 0u,
+		.SizeInBytes = static_cast<UINT>(vertexBufferSize),
+		.StrideInBytes = vertexStrideSize
+	};
+
+	m_gIndexBufferView = D3D12_INDEX_BUFFER_VIEW{
+		.BufferLocation = 0u,
+		.SizeInBytes = static_cast<UINT>(indexBufferSize),
+		.Format = DXGI_FORMAT_R32_UINT
+	};
+
+	m_vertexBuffer.ReserveHeapSpace(device);
+}
+
+void VertexManagerVertexShader::RecordResourceUploads(
+	ID3D12GraphicsCommandList* copyList
+) noexcept {
+	m_vertexBuffer.RecordResourceUpload(copyList);
+}
+
+void VertexManagerVertexShader::RecordRuntimeUploads(
+	ID3D12GraphicsCommandList* graphicsCmdList
+) {
+	if (m_stagingUploader.IsEmpty())
+		return;
+
+	// The buffer decays to common between frames and the copies promote it.
+	m_stagingUploader.RecordUploads(graphicsCmdList);
+
+	D3DResourceBarrier().AddBarrier(
+		m_vertexBuffer.GetResource(), D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_INDEX_BUFFER
+	).RecordBarriers(graphicsCmdList);
+}
+
+void VertexManagerVertexShader::ReleaseUploadResources() noexcept {
+	m_vertexBuffer.ReleaseUploadResource();
+
+	m_gIndices = std::vector<std::uint32_t>{};
+	m_gVertices = std::vector<Vertex>{};
+	m_gPackedVertices = std::vector<PackedVertex>{};
+}
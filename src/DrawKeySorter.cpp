@@ -0,0 +1,140 @@
+#include <DrawKeySorter.hpp>
+#include <JobRunner.hpp>
+#include <algorithm>
+
+namespace {
+	[[nodiscard]]
+	std::uint32_t GetDigit(const DrawKey& drawKey, size_t digitIndex) noexcept {
+		// The model index bytes come first, as they are the least significant.
+		if (digitIndex < 4u)
+			return (drawKey.modelIndex >> (digitIndex * 8u)) & 0xFFu;
+
+		return static_cast<std::uint32_t>(drawKey.key >> ((digitIndex - 4u) * 8u)) & 0xFFu;
+	}
+}
+
+std::uint64_t DrawKeySorter::MakeKey(
+	std::uint32_t pipelineIndex, std::uint32_t textureIndex, std::uint32_t meshIndex
+) noexcept {
+	return static_cast<std::uint64_t>(pipelineIndex & 0xFFFFu) << 48u
+		| static_cast<std::uint64_t>(textureIndex & 0xFFFFFFu) << 24u
+		| static_cast<std::uint64_t>(meshIndex & 0xFFFFFFu);
+}
+
+std::uint32_t DrawKeySorter::GetPipelineIndex(std::uint64_t key) noexcept {
+	return static_cast<std::uint32_t>(key >> 48u);
+}
+
+void DrawKeySorter::CountDigit(const std::vector<DrawKey>& drawKeys, size_t digitIndex) {
+	const size_t keyCount = std::size(drawKeys);
+
+	Gaia::RunJobs(
+		std::size(m_jobHistograms),
+		[&](size_t jobIndex) {
+			Histogram& histogram = m_jobHistograms[jobIndex][digitIndex];
+			histogram.fill(0u);
+
+			const size_t keyEnd = std::min((jobIndex + 1u) * s_keysPerJob, keyCount);
+
+			for (size_t index = jobIndex * s_keysPerJob; index < keyEnd; ++index)
+				++histogram[GetDigit(drawKeys[index], digitIndex)];
+		}
+	);
+}
+
+void DrawKeySorter::Sort(std::vector<DrawKey>& drawKeys) {
+	const size_t keyCount = std::size(drawKeys);
+
+	if (keyCount < 2u)
+		return;
+
+	const size_t jobCount = (keyCount + s_keysPerJob - 1u) / s_keysPerJob;
+
+	m_sortedKeys.resize(keyCount);
+	m_jobHistograms.resize(jobCount);
+	m_jobOffsets.resize(jobCount);
+
+	// The totals of a digit don't depend on the order, so a single read finds the digits to
+	// skip and has the counts for the first pass.
+	Gaia::RunJobs(
+		jobCount,
+		[&](size_t jobIndex) {
+			auto& histograms = m_jobHistograms[jobIndex];
+
+			for (Histogram& histogram : histograms)
+				histogram.fill(0u);
+
+			const size_t keyEnd = std::min((jobIndex + 1u) * s_keysPerJob, keyCount);
+
+			for (size_t index = jobIndex * s_keysPerJob; index < keyEnd; ++index) {
+				const std::uint32_t modelIndex = drawKeys[index].modelIndex;
+				const std::uint64_t key = drawKeys[index].key;
+
+				for (size_t byteIndex = 0u; byteIndex < 4u; ++byteIndex)
+					++histograms[byteIndex][(modelIndex >> (byteIndex * 8u)) & 0xFFu];
+
+				for (size_t byteIndex = 0u; byteIndex < 8u; ++byteIndex)
+					++histograms[byteIndex + 4u][(key >> (byteIndex * 8u)) & 0xFFu];
+			}
+		}
+	);
+
+	std::array<bool, s_digitCount> sortDigits{};
+
+	for (size_t digitIndex = 0u; digitIndex < s_digitCount; ++digitIndex) {
+		Histogram totals{};
+
+		for (const auto& histograms : m_jobHistograms)
+			for (size_t radix = 0u; radix < s_radixSize; ++radix)
+				totals[radix] += histograms[digitIndex][radix];
+
+		// A digit all the keys share doesn't move any of them.
+		sortDigits[digitIndex] = std::ranges::none_of(totals, [keyCount](std::uint32_t total) {
+			return total == keyCount;
+		});
+	}
+
+	std::vector<DrawKey>* sourceKeys = &drawKeys;
+	std::vector<DrawKey>* destinationKeys = &m_sortedKeys;
+	bool firstPass = true;
+
+	for (size_t digitIndex = 0u; digitIndex < s_digitCount; ++digitIndex) {
+		if (!sortDigits[digitIndex])
+			continue;
+
+		if (!firstPass)
+			CountDigit(*sourceKeys, digitIndex);
+
+		firstPass = false;
+
+		// Each job writes its keys of a radix after the ones of the jobs before it, which
+		// keeps the sort stable.
+		std::uint32_t radixOffset = 0u;
+
+		for (size_t radix = 0u; radix < s_radixSize; ++radix)
+			for (size_t jobIndex = 0u; jobIndex < jobCount; ++jobIndex) {
+				m_jobOffsets[jobIndex][radix] = radixOffset;
+				radixOffset += m_jobHistograms[jobIndex][digitIndex][radix];
+			}
+
+		const std::vector<DrawKey>& source = *sourceKeys;
+		std::vector<DrawKey>& destination = *destinationKeys;
+
+		Gaia::RunJobs(
+			jobCount,
+			[&](size_t jobIndex) {
+				Histogram& offsets = m_jobOffsets[jobIndex];
+
+				const size_t keyEnd = std::min((jobIndex + 1u) * s_keysPerJob, keyCount);
+
+				for (size_t index = jobIndex * s_keysPerJob; index < keyEnd; ++index)
+					destination[offsets[GetDigit(source[index], digitIndex)]++] = source[index];
+			}
+		);
+
+		std::swap(sourceKeys, destinationKeys);
+	}
+
+	if (sourceKeys != &drawKeys)
+		drawKeys.swap(m_sortedKeys);
+}
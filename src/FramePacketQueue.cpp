@@ -0,0 +1,70 @@
+#include <FramePacketQueue.hpp>
+
+FramePacketQueue::FramePacketQueue(size_t capacity) noexcept
+	: m_capacity{ capacity }, m_consumerBusy{ false }, m_closed{ false } {}
+
+void FramePacketQueue::Push(FramePacket&& framePacket) {
+	{
+		std::unique_lock lock{ m_packetMutex };
+
+		m_packetPopped.wait(
+			lock, [this] { return m_closed || std::size(m_packets) < m_capacity; }
+		);
+
+		if (m_closed)
+			return;
+
+		m_packets.emplace_back(std::move(framePacket));
+	}
+
+	m_packetPushed.notify_one();
+}
+
+std::optional<FramePacket> FramePacketQueue::Pop() {
+	std::optional<FramePacket> framePacket{};
+
+	{
+		std::unique_lock lock{ m_packetMutex };
+
+		m_consumerBusy = false;
+		m_packetPopped.notify_all();
+
+		m_packetPushed.wait(lock, [this] { return m_closed || !std::empty(m_packets); });
+
+		if (std::empty(m_packets))
+			return {};
+
+		framePacket = std::move(m_packets.front());
+		m_packets.pop_front();
+		m_consumerBusy = true;
+	}
+
+	m_packetPopped.notify_all();
+
+	return framePacket;
+}
+
+void FramePacketQueue::Close() {
+	{
+		std::lock_guard lock{ m_packetMutex };
+
+		m_closed = true;
+	}
+
+	m_packetPushed.notify_all();
+	m_packetPopped.notify_all();
+}
+
+void FramePacketQueue::WaitUntilDrained() {
+	std::unique_lock lock{ m_packetMutex };
+
+	m_packetPopped.wait(
+		lock, [this] { return m_closed || (std::empty(m_packets) && !m_consumerBusy); }
+	);
+}
+
+bool FramePacketQueue::IsClosed() {
+	std::lock_guard lock{ m_packetMutex };
+
+	return m_closed;
+}
@@ -0,0 +1,212 @@
+#include <FrameTaskGraph.hpp>
+#include <algorithm>
+#include <JobRunner.hpp>
+
+FrameTaskGraph::FrameTaskGraph() noexcept
+	: m_readyQueue{ std::make_shared<ReadyQueue>() }, m_tasksLeft{ 0u }, m_taskFailed{ false },
+	m_frameIndex{ 0u }, m_frameStats{} {}
+
+void FrameTaskGraph::AddTask(
+	char const* name, TaskFunction function, FrameResource reads, FrameResource writes
+) {
+	const size_t taskIndex = std::size(m_tasks);
+	size_t predecessorCount = 0u;
+
+	for (Task& earlierTask : m_tasks)
+		if (Overlaps(earlierTask.writes, reads | writes) || Overlaps(earlierTask.reads, writes)) {
+			earlierTask.successors.emplace_back(taskIndex);
+			++predecessorCount;
+		}
+
+	m_tasks.emplace_back(
+		Task{
+			.name = name,
+			.function = std::move(function),
+			.reads = reads,
+			.writes = writes,
+			.successors = {},
+			.predecessorCount = predecessorCount,
+			.startSeconds = 0.,
+			.endSeconds = 0.
+		}
+	);
+
+	m_predecessorsLeft = std::make_unique<std::atomic_size_t[]>(std::size(m_tasks));
+}
+
+void FrameTaskGraph::Clear() noexcept {
+	m_tasks = std::vector<Task>{};
+	m_predecessorsLeft.reset();
+	m_frameStats = FrameStats{};
+	m_criticalPath.clear();
+}
+
+void FrameTaskGraph::Execute(size_t frameIndex) {
+	m_frameStart = std::chrono::steady_clock::now();
+	m_frameIndex = frameIndex;
+
+	const size_t taskCount = std::size(m_tasks);
+
+	if (!Gaia::threadPool || taskCount < 2u)
+		ExecuteSerial();
+	else {
+		m_tasksLeft.store(taskCount, std::memory_order_relaxed);
+		m_taskFailed.store(false, std::memory_order_relaxed);
+
+		for (size_t index = 0u; index < taskCount; ++index)
+			m_predecessorsLeft[index].store(
+				m_tasks[index].predecessorCount, std::memory_order_relaxed
+			);
+
+		for (size_t index = 0u; index < taskCount; ++index)
+			if (m_tasks[index].predecessorCount == 0u)
+				PushReadyTask(index);
+
+		// A ready task is always either taken here or by a pool job, so a busy pool only
+		// makes this thread do more of them.
+		size_t tasksLeft = m_tasksLeft.load(std::memory_order_acquire);
+
+		while (tasksLeft != 0u) {
+			size_t taskIndex = 0u;
+
+			if (PopReadyTask(*m_readyQueue, taskIndex))
+				RunTask(taskIndex);
+			else
+				// A task is made ready before the one releasing it is counted as done.
+				m_tasksLeft.wait(tasksLeft, std::memory_order_acquire);
+
+			tasksLeft = m_tasksLeft.load(std::memory_order_acquire);
+		}
+
+		if (m_taskFailed.load(std::memory_order_acquire)) {
+			std::exception_ptr exception{};
+			std::swap(exception, m_exception);
+
+			std::rethrow_exception(exception);
+		}
+	}
+
+	m_frameStats.frameSeconds = GetSecondsSinceStart();
+
+	CalculateCriticalPath();
+}
+
+void FrameTaskGraph::ExecuteSerial() {
+	for (Task& task : m_tasks) {
+		task.startSeconds = GetSecondsSinceStart();
+		task.function(m_frameIndex);
+		task.endSeconds = GetSecondsSinceStart();
+	}
+}
+
+void FrameTaskGraph::RunTask(size_t taskIndex) {
+	Task& task = m_tasks[taskIndex];
+
+	task.startSeconds = GetSecondsSinceStart();
+
+	// The pool jobs can't throw, and the successors must still be released so the frame ends.
+	if (!m_taskFailed.load(std::memory_order_acquire))
+		try {
+			task.function(m_frameIndex);
+		}
+		catch (...) {
+			std::lock_guard lock{ m_exceptionMutex };
+
+			if (!m_exception)
+				m_exception = std::current_exception();
+
+			m_taskFailed.store(true, std::memory_order_release);
+		}
+
+	task.endSeconds = GetSecondsSinceStart();
+
+	for (size_t successorIndex : task.successors)
+		if (m_predecessorsLeft[successorIndex].fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+			PushReadyTask(successorIndex);
+
+	m_tasksLeft.fetch_sub(1u, std::memory_order_acq_rel);
+	m_tasksLeft.notify_all();
+}
+
+void FrameTaskGraph::PushReadyTask(size_t taskIndex) {
+	{
+		std::lock_guard lock{ m_readyQueue->mutex };
+
+		m_readyQueue->taskIndices.emplace_back(taskIndex);
+	}
+
+	// The job might only run after the graph is done, it only touches the graph once it has
+	// taken a task.
+	Gaia::threadPool->SubmitWork(
+		[readyQueue = m_readyQueue, this] {
+			size_t readyTaskIndex = 0u;
+
+			if (PopReadyTask(*readyQueue, readyTaskIndex))
+				RunTask(readyTaskIndex);
+		}
+	);
+}
+
+bool FrameTaskGraph::PopReadyTask(ReadyQueue& readyQueue, size_t& taskIndex) {
+	std::lock_guard lock{ readyQueue.mutex };
+
+	if (std::empty(readyQueue.taskIndices))
+		return false;
+
+	taskIndex = readyQueue.taskIndices.front();
+	readyQueue.taskIndices.pop_front();
+
+	return true;
+}
+
+double FrameTaskGraph::GetSecondsSinceStart() const noexcept {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_frameStart).count();
+}
+
+void FrameTaskGraph::CalculateCriticalPath() {
+	const size_t taskCount = std::size(m_tasks);
+
+	// The tasks are already in a topological order, so every predecessor is done first.
+	std::vector<double> pathSeconds(taskCount, 0.);
+	std::vector<size_t> previousTasks(taskCount, taskCount);
+
+	size_t lastTask = taskCount;
+	double criticalPathSeconds = 0.;
+
+	for (size_t index = 0u; index < taskCount; ++index) {
+		const Task& task = m_tasks[index];
+
+		pathSeconds[index] += task.endSeconds - task.startSeconds;
+
+		if (pathSeconds[index] > criticalPathSeconds) {
+			criticalPathSeconds = pathSeconds[index];
+			lastTask = index;
+		}
+
+		for (size_t successorIndex : task.successors)
+			if (pathSeconds[index] > pathSeconds[successorIndex]) {
+				pathSeconds[successorIndex] = pathSeconds[index];
+				previousTasks[successorIndex] = index;
+			}
+	}
+
+	m_frameStats.criticalPathSeconds = criticalPathSeconds;
+	m_criticalPath.clear();
+
+	for (size_t index = lastTask; index < taskCount; index = previousTasks[index])
+		m_criticalPath.emplace_back(m_tasks[index].name);
+
+	std::ranges::reverse(m_criticalPath);
+}
+
+FrameTaskGraph::FrameStats FrameTaskGraph::GetFrameStats() const noexcept {
+	return m_frameStats;
+}
+
+const std::vector<char const*>& FrameTaskGraph::GetCriticalPath() const noexcept {
+	return m_criticalPath;
+}
+
+size_t FrameTaskGraph::GetTaskCount() const noexcept {
+	return std::size(m_tasks);
+}
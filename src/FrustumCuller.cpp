@@ -0,0 +1,135 @@
+#include <FrustumCuller.hpp>
+
+FrustumCuller::FrustumCuller() noexcept
+	: m_planesX{}, m_planesY{}, m_planesZ{}, m_planesW{} {}
+
+void FrustumCuller::SetViewProjection(const DirectX::XMMATRIX& viewProjection) noexcept {
+	using namespace DirectX;
+
+	// With row vectors the clip coordinates are dot products with the columns of the matrix.
+	const XMMATRIX columns = XMMatrixTranspose(viewProjection);
+
+	const std::array<XMVECTOR, 8u> planes{
+		XMVectorAdd(columns.r[3], columns.r[0]),
+		XMVectorSubtract(columns.r[3], columns.r[0]),
+		XMVectorAdd(columns.r[3], columns.r[1]),
+		XMVectorSubtract(columns.r[3], columns.r[1]),
+		columns.r[2],
+		XMVectorSubtract(columns.r[3], columns.r[2]),
+		XMVectorSubtract(columns.r[3], columns.r[2]),
+		XMVectorSubtract(columns.r[3], columns.r[2])
+	};
+
+	std::array<XMFLOAT4, 8u> normalisedPlanes{};
+	for (size_t index = 0u; index < std::size(planes); ++index)
+		XMStoreFloat4(&normalisedPlanes[index], XMPlaneNormalize(planes[index]));
+
+	for (size_t group = 0u; group < std::size(m_planesX); ++group) {
+		const XMFLOAT4* groupPlanes = &normalisedPlanes[group * 4u];
+
+		m_planesX[group] = {
+			groupPlanes[0].x, groupPlanes[1].x, groupPlanes[2].x, groupPlanes[3].x
+		};
+		m_planesY[group] = {
+			groupPlanes[0].y, groupPlanes[1].y, groupPlanes[2].y, groupPlanes[3].y
+		};
+		m_planesZ[group] = {
+			groupPlanes[0].z, groupPlanes[1].z, groupPlanes[2].z, groupPlanes[3].z
+		};
+		m_planesW[group] = {
+			groupPlanes[0].w, groupPlanes[1].w, groupPlanes[2].w, groupPlanes[3].w
+		};
+	}
+}
+
+FrustumTest FrustumCuller::TestBox(const AxisAlignedBox& box) const noexcept {
+	using namespace DirectX;
+
+	const XMVECTOR minimum = XMLoadFloat3(&box.minimum);
+	const XMVECTOR maximum = XMLoadFloat3(&box.maximum);
+	const XMVECTOR half = XMVectorReplicate(0.5f);
+	const XMVECTOR center = XMVectorMultiply(XMVectorAdd(maximum, minimum), half);
+	const XMVECTOR extent = XMVectorMultiply(XMVectorSubtract(maximum, minimum), half);
+
+	const XMVECTOR centerX = XMVectorSplatX(center);
+	const XMVECTOR centerY = XMVectorSplatY(center);
+	const XMVECTOR centerZ = XMVectorSplatZ(center);
+	const XMVECTOR extentX = XMVectorSplatX(extent);
+	const XMVECTOR extentY = XMVectorSplatY(extent);
+	const XMVECTOR extentZ = XMVectorSplatZ(extent);
+
+	const XMVECTOR zero = XMVectorZero();
+	XMVECTOR outsideMask = XMVectorFalseInt();
+	XMVECTOR intersectingMask = XMVectorFalseInt();
+
+	for (size_t group = 0u; group < std::size(m_planesX); ++group) {
+		const XMVECTOR planeX = XMLoadFloat4(&m_planesX[group]);
+		const XMVECTOR planeY = XMLoadFloat4(&m_planesY[group]);
+		const XMVECTOR planeZ = XMLoadFloat4(&m_planesZ[group]);
+
+		const XMVECTOR distance = XMVectorMultiplyAdd(
+			planeX, centerX,
+			XMVectorMultiplyAdd(
+				planeY, centerY,
+				XMVectorMultiplyAdd(planeZ, centerZ, XMLoadFloat4(&m_planesW[group]))
+			)
+		);
+		const XMVECTOR radius = XMVectorMultiplyAdd(
+			XMVectorAbs(planeX), extentX,
+			XMVectorMultiplyAdd(
+				XMVectorAbs(planeY), extentY, XMVectorMultiply(XMVectorAbs(planeZ), extentZ)
+			)
+		);
+
+		outsideMask = XMVectorOrInt(
+			outsideMask, XMVectorLess(XMVectorAdd(distance, radius), zero)
+		);
+		intersectingMask = XMVectorOrInt(
+			intersectingMask, XMVectorLess(XMVectorSubtract(distance, radius), zero)
+		);
+	}
+
+	if (_mm_movemask_ps(outsideMask))
+		return FrustumTest::Outside;
+
+	return _mm_movemask_ps(intersectingMask) ? FrustumTest::Intersecting : FrustumTest::Inside;
+}
+
+FrustumTest FrustumCuller::TestSphere(
+	const DirectX::XMFLOAT3& centre, float radius
+) const noexcept {
+	using namespace DirectX;
+
+	const XMVECTOR centerX = XMVectorReplicate(centre.x);
+	const XMVECTOR centerY = XMVectorReplicate(centre.y);
+	const XMVECTOR centerZ = XMVectorReplicate(centre.z);
+	const XMVECTOR sphereRadius = XMVectorReplicate(radius);
+
+	const XMVECTOR zero = XMVectorZero();
+	XMVECTOR outsideMask = XMVectorFalseInt();
+	XMVECTOR intersectingMask = XMVectorFalseInt();
+
+	for (size_t group = 0u; group < std::size(m_planesX); ++group) {
+		const XMVECTOR distance = XMVectorMultiplyAdd(
+			XMLoadFloat4(&m_planesX[group]), centerX,
+			XMVectorMultiplyAdd(
+				XMLoadFloat4(&m_planesY[group]), centerY,
+				XMVectorMultiplyAdd(
+					XMLoadFloat4(&m_planesZ[group]), centerZ, XMLoadFloat4(&m_planesW[group])
+				)
+			)
+		);
+
+		outsideMask = XMVectorOrInt(
+			outsideMask, XMVectorLess(XMVectorAdd(distance, sphereRadius), zero)
+		);
+		intersectingMask = XMVectorOrInt(
+			intersectingMask, XMVectorLess(XMVectorSubtract(distance, sphereRadius), zero)
+		);
+	}
+
+	if (_mm_movemask_ps(outsideMask))
+		return FrustumTest::Outside;
+
+	return _mm_movemask_ps(intersectingMask) ? FrustumTest::Intersecting : FrustumTest::Inside;
+}
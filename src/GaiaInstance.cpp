@@ -1,14 +1,25 @@
-#include <GaiaInstance.hpp>
-#include <RendererDx12.hpp>
-
-Renderer* CreateGaiaInstance(
-	const char* appName,
-	void* windowHandle,
-	std::uint32_t width, std::uint32_t height,
-	RenderEngineType engineType, std::uint32_t bufferCount
-) {
-	return new RendererDx12(
-		appName,
-		windowHandle, width, height, bufferCount, engineType
-	);
-}
+#include <GaiaInstance.hpp>
+#include <RendererDx12.hpp>
+
+Renderer* CreateGaiaInstance(
+	const char* appName,
+	void* windowHandle,
+	std::uint32_t width, std::uint32_t height,
+	RenderEngineType engineType, std::uint32_t bufferCount, VertexFormat vertexFormat
+) {
+	return new RendererDx12(
+		appName,
+		windowHandle, width, height, bufferCount, engineType, vertexFormat
+	);
+}
+
+Renderer* CreateHeadlessGaiaInstance(
+	const char* appName,
+	std::uint32_t width, std::uint32_t height,
+	RenderEngineType engineType, std::uint32_t bufferCount, VertexFormat vertexFormat
+) {
+	return new RendererDx12(
+		appName,
+		nullptr, width, height, bufferCount, engineType, vertexFormat
+	);
+}
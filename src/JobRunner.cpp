@@ -0,0 +1,68 @@
+#include <JobRunner.hpp>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace Gaia {
+	std::shared_ptr<IThreadPool> threadPool;
+
+	void RunJobs(size_t jobCount, const std::function<void(size_t)>& job) {
+		RunJobs(threadPool.get(), jobCount, job);
+	}
+
+	void RunJobs(
+		IThreadPool* pool, size_t jobCount, const std::function<void(size_t)>& job
+	) {
+		if (!pool || jobCount < 2u) {
+			for (size_t jobIndex = 0u; jobIndex < jobCount; ++jobIndex)
+				job(jobIndex);
+
+			return;
+		}
+
+		// The jobs are claimed instead of handed out, so a pool job which starts after all of
+		// them are done finds none left and never touches the job function.
+		struct JobState {
+			std::atomic_size_t nextJob;
+			std::atomic_size_t jobsLeft;
+			std::mutex exceptionMutex;
+			std::exception_ptr exception;
+		};
+
+		auto jobState = std::make_shared<JobState>();
+		jobState->nextJob = 0u;
+		jobState->jobsLeft = jobCount;
+
+		// A throwing job still counts as done, otherwise the caller would wait forever while
+		// the pool jobs hold a reference to the job function.
+		auto runJobs = [&job, jobCount](JobState& state) {
+			for (size_t jobIndex = state.nextJob++; jobIndex < jobCount;
+				jobIndex = state.nextJob++) {
+				try {
+					job(jobIndex);
+				}
+				catch (...) {
+					std::lock_guard lock{ state.exceptionMutex };
+
+					if (!state.exception)
+						state.exception = std::current_exception();
+				}
+
+				if (--state.jobsLeft == 0u)
+					state.jobsLeft.notify_all();
+			}
+		};
+
+		for (size_t poolJob = 1u; poolJob < jobCount; ++poolJob)
+			pool->SubmitWork([jobState, runJobs] { runJobs(*jobState); });
+
+		runJobs(*jobState);
+
+		for (size_t jobsLeft = jobState->jobsLeft; jobsLeft != 0u;
+			jobsLeft = jobState->jobsLeft)
+			jobState->jobsLeft.wait(jobsLeft);
+
+		if (jobState->exception)
+			std::rethrow_exception(jobState->exception);
+	}
+}
@@ -0,0 +1,368 @@
+#include <MeshletBuilder.hpp>
+#include <JobRunner.hpp>
+#include <Exception.hpp>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+
+MeshletBuilder::MeshletBuilder(const Args& arguments)
+	: m_maxVertices{ arguments.maxVertices.value() },
+	m_maxPrimitives{ arguments.maxPrimitives.value() },
+	m_threadPool{ arguments.threadPool.value() } {
+
+	if (m_maxVertices < 3u || m_maxVertices > 256u)
+		throw Exception("MeshletBuilder Error", "The max vertices must be from 3 to 256.");
+
+	if (m_maxPrimitives < 1u || m_maxPrimitives > 256u)
+		throw Exception("MeshletBuilder Error", "The max primitives must be from 1 to 256.");
+}
+
+MeshletBuilder::MeshletData MeshletBuilder::BuildMeshlets(
+	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+	const std::vector<std::shared_ptr<IModel>>& models
+) const {
+	// Checked here, as the pool jobs can't throw.
+	for (const std::shared_ptr<IModel>& model : models) {
+		const size_t indexEnd =
+			static_cast<size_t>(model->GetIndexOffset()) + model->GetIndexCount();
+
+		if (indexEnd > std::size(indices) || model->GetIndexCount() % 3u != 0u)
+			throw Exception(
+				"MeshletBuilder Error", "A model's indices aren't whole triangles in range."
+			);
+	}
+
+	const size_t vertexCount = std::size(vertices);
+
+	if (std::ranges::any_of(indices, [vertexCount](std::uint32_t index) {
+		return index >= vertexCount;
+	}))
+		throw Exception("MeshletBuilder Error", "An index is out of the vertex range.");
+
+	const size_t modelCount = std::size(models);
+	std::vector<ModelMeshlets> builtModels(modelCount);
+
+	Gaia::RunJobs(
+		m_threadPool, modelCount,
+		[&](size_t modelIndex) {
+			const IModel& model = *models[modelIndex];
+
+			builtModels[modelIndex] = BuildModelMeshlets(
+				vertices, std::data(indices) + model.GetIndexOffset(),
+				model.GetIndexCount() / 3u
+			);
+		}
+	);
+
+	MeshletData meshletData{};
+	meshletData.modelMeshlets.reserve(modelCount);
+
+	for (ModelMeshlets& builtModel : builtModels) {
+		const auto vertexOffset = static_cast<std::uint32_t>(
+			std::size(meshletData.vertexIndices)
+		);
+		const auto primitiveOffset = static_cast<std::uint32_t>(
+			std::size(meshletData.primIndices)
+		);
+
+		for (Meshlet& meshlet : builtModel.meshlets) {
+			meshlet.vertexOffset += vertexOffset;
+			meshlet.primitiveOffset += primitiveOffset;
+		}
+
+		meshletData.modelMeshlets.emplace_back(std::move(builtModel.meshlets));
+		meshletData.vertexIndices.insert(
+			std::end(meshletData.vertexIndices), std::begin(builtModel.vertexIndices),
+			std::end(builtModel.vertexIndices)
+		);
+		meshletData.primIndices.insert(
+			std::end(meshletData.primIndices), std::begin(builtModel.primIndices),
+			std::end(builtModel.primIndices)
+		);
+	}
+
+	return meshletData;
+}
+
+MeshletBuilder::ModelMeshlets MeshletBuilder::BuildModelMeshlets(
+	const std::vector<Vertex>& vertices, const std::uint32_t* triangleIndices,
+	size_t triangleCount
+) const {
+	static constexpr std::uint32_t s_noSlot = std::numeric_limits<std::uint32_t>::max();
+	static constexpr size_t s_noTriangle = std::numeric_limits<size_t>::max();
+
+	// The model's vertices are numbered from zero, so the per vertex data stays small.
+	std::unordered_map<std::uint32_t, std::uint32_t> localVertexIndices;
+	std::vector<std::uint32_t> globalVertexIndices;
+	std::vector<std::uint32_t> localIndices(triangleCount * 3u);
+
+	for (size_t index = 0u; index < triangleCount * 3u; ++index) {
+		const auto [vertex, inserted] = localVertexIndices.try_emplace(
+			triangleIndices[index], static_cast<std::uint32_t>(std::size(globalVertexIndices))
+		);
+
+		if (inserted)
+			globalVertexIndices.emplace_back(triangleIndices[index]);
+
+		localIndices[index] = vertex->second;
+	}
+
+	const size_t vertexCount = std::size(globalVertexIndices);
+
+	// The triangles using each vertex, a degenerate one is listed once per corner.
+	std::vector<std::uint32_t> liveTriangleCounts(vertexCount, 0u);
+
+	for (std::uint32_t localIndex : localIndices)
+		++liveTriangleCounts[localIndex];
+
+	std::vector<size_t> adjacencyOffsets(vertexCount + 1u, 0u);
+
+	for (size_t vertex = 0u; vertex < vertexCount; ++vertex)
+		adjacencyOffsets[vertex + 1u] = adjacencyOffsets[vertex] + liveTriangleCounts[vertex];
+
+	std::vector<std::uint32_t> adjacentTriangles(std::size(localIndices));
+
+	{
+		std::vector<size_t> adjacencyEnds(
+			std::begin(adjacencyOffsets), std::prev(std::end(adjacencyOffsets))
+		);
+
+		for (size_t index = 0u; index < std::size(localIndices); ++index)
+			adjacentTriangles[adjacencyEnds[localIndices[index]]++] =
+				static_cast<std::uint32_t>(index / 3u);
+	}
+
+	std::vector<bool> emittedTriangles(triangleCount, false);
+	std::vector<std::uint32_t> meshletSlots(vertexCount, s_noSlot);
+	std::vector<std::uint32_t> meshletVertices;
+	std::vector<std::uint32_t> meshletPrimitives;
+	DirectX::XMFLOAT3 meshletPositionSum{ 0.f, 0.f, 0.f };
+
+	ModelMeshlets modelMeshlets{};
+
+	auto getPosition = [&](std::uint32_t localVertex) noexcept {
+		return vertices[globalVertexIndices[localVertex]].position;
+	};
+
+	auto flushMeshlet = [&] {
+		modelMeshlets.meshlets.emplace_back(
+			Meshlet{
+				.vertexCount = static_cast<std::uint32_t>(std::size(meshletVertices)),
+				.vertexOffset = static_cast<std::uint32_t>(
+					std::size(modelMeshlets.vertexIndices)
+				),
+				.primitiveCount = static_cast<std::uint32_t>(std::size(meshletPrimitives)),
+				.primitiveOffset = static_cast<std::uint32_t>(
+					std::size(modelMeshlets.primIndices)
+				)
+			}
+		);
+
+		for (std::uint32_t localVertex : meshletVertices) {
+			modelMeshlets.vertexIndices.emplace_back(globalVertexIndices[localVertex]);
+			meshletSlots[localVertex] = s_noSlot;
+		}
+
+		modelMeshlets.primIndices.insert(
+			std::end(modelMeshlets.primIndices), std::begin(meshletPrimitives),
+			std::end(meshletPrimitives)
+		);
+
+		meshletVertices.clear();
+		meshletPrimitives.clear();
+		meshletPositionSum = DirectX::XMFLOAT3{ 0.f, 0.f, 0.f };
+	};
+
+	auto getNewVertexCount = [&](size_t triangle) noexcept {
+		const std::uint32_t* corners = &localIndices[triangle * 3u];
+		std::uint32_t newVertexCount = 0u;
+
+		for (size_t corner = 0u; corner < 3u; ++corner)
+			if (meshletSlots[corners[corner]] == s_noSlot
+				&& std::find(corners, corners + corner, corners[corner]) == corners + corner)
+				++newVertexCount;
+
+		return newVertexCount;
+	};
+
+	size_t seedTriangle = 0u;
+	size_t lastTriangle = s_noTriangle;
+
+	for (size_t emittedCount = 0u; emittedCount < triangleCount;) {
+		size_t bestTriangle = s_noTriangle;
+		std::uint32_t bestNewVertices = 0u;
+		std::uint32_t bestLiveTriangles = 0u;
+		float bestDistance = 0.f;
+
+		const size_t meshletVertexCount = std::size(meshletVertices);
+		const float inverseVertexCount =
+			meshletVertexCount != 0u ? 1.f / static_cast<float>(meshletVertexCount) : 0.f;
+		const DirectX::XMFLOAT3 meshletCentre{
+			meshletPositionSum.x * inverseVertexCount,
+			meshletPositionSum.y * inverseVertexCount,
+			meshletPositionSum.z * inverseVertexCount
+		};
+
+		auto getDistanceSquared = [&meshletCentre](const DirectX::XMFLOAT3& position) noexcept {
+			const float x = position.x - meshletCentre.x;
+			const float y = position.y - meshletCentre.y;
+			const float z = position.z - meshletCentre.z;
+
+			return x * x + y * y + z * z;
+		};
+
+		// The fewest new vertices first, then the triangles whose vertices have the fewest
+		// triangles left, so no vertex is left behind to be sent again. The distance to the
+		// meshlet's centre breaks the rest of the ties.
+		auto scanVertex = [&](std::uint32_t localVertex) noexcept {
+			if (liveTriangleCounts[localVertex] == 0u)
+				return;
+
+			for (size_t adjacency = adjacencyOffsets[localVertex];
+				adjacency < adjacencyOffsets[localVertex + 1u]; ++adjacency) {
+				const std::uint32_t triangle = adjacentTriangles[adjacency];
+
+				if (emittedTriangles[triangle])
+					continue;
+
+				const std::uint32_t newVertices = getNewVertexCount(triangle);
+
+				if (meshletVertexCount + newVertices > m_maxVertices)
+					continue;
+
+				const std::uint32_t* corners = &localIndices[triangle * 3u];
+				const std::uint32_t liveTriangles = liveTriangleCounts[corners[0]]
+					+ liveTriangleCounts[corners[1]] + liveTriangleCounts[corners[2]];
+
+				float distance = 0.f;
+
+				for (size_t corner = 0u; corner < 3u; ++corner)
+					distance += getDistanceSquared(getPosition(corners[corner]));
+
+				if (bestTriangle == s_noTriangle || newVertices < bestNewVertices
+					|| (newVertices == bestNewVertices && (liveTriangles < bestLiveTriangles
+					|| (liveTriangles == bestLiveTriangles && distance < bestDistance)))) {
+					bestTriangle = triangle;
+					bestNewVertices = newVertices;
+					bestLiveTriangles = liveTriangles;
+					bestDistance = distance;
+				}
+			}
+		};
+
+		// The last triangle's neighbours are nearly always the best, the whole meshlet is
+		// only searched once they run out.
+		if (lastTriangle != s_noTriangle)
+			for (size_t corner = 0u; corner < 3u; ++corner)
+				scanVertex(localIndices[lastTriangle * 3u + corner]);
+
+		if (bestTriangle == s_noTriangle)
+			for (std::uint32_t localVertex : meshletVertices)
+				scanVertex(localVertex);
+
+		if (bestTriangle == s_noTriangle) {
+			while (emittedTriangles[seedTriangle])
+				++seedTriangle;
+
+			// An unconnected triangle close to the meshlet goes in as well, so meshes of many
+			// small pieces still fill their meshlets.
+			bool seedFits = meshletVertexCount + 3u <= m_maxVertices;
+
+			if (seedFits && meshletVertexCount != 0u) {
+				float radiusSquared = 0.f;
+
+				for (std::uint32_t localVertex : meshletVertices)
+					radiusSquared = std::max(
+						radiusSquared, getDistanceSquared(getPosition(localVertex))
+					);
+
+				const std::uint32_t* corners = &localIndices[seedTriangle * 3u];
+
+				for (size_t corner = 0u; corner < 3u && seedFits; ++corner)
+					seedFits = getDistanceSquared(getPosition(corners[corner]))
+						<= 4.f * radiusSquared;
+			}
+
+			if (meshletVertexCount != 0u && !seedFits) {
+				flushMeshlet();
+				lastTriangle = s_noTriangle;
+
+				continue;
+			}
+
+			bestTriangle = seedTriangle;
+		}
+
+		std::uint32_t primitiveSlots[3]{};
+
+		for (size_t corner = 0u; corner < 3u; ++corner) {
+			const std::uint32_t localVertex = localIndices[bestTriangle * 3u + corner];
+
+			if (meshletSlots[localVertex] == s_noSlot) {
+				meshletSlots[localVertex] = static_cast<std::uint32_t>(std::size(meshletVertices));
+				meshletVertices.emplace_back(localVertex);
+
+				const DirectX::XMFLOAT3 position = getPosition(localVertex);
+
+				meshletPositionSum.x += position.x;
+				meshletPositionSum.y += position.y;
+				meshletPositionSum.z += position.z;
+			}
+
+			primitiveSlots[corner] = meshletSlots[localVertex];
+			--liveTriangleCounts[localVertex];
+		}
+
+		meshletPrimitives.emplace_back(
+			PackPrimitive(primitiveSlots[0], primitiveSlots[1], primitiveSlots[2])
+		);
+		emittedTriangles[bestTriangle] = true;
+		lastTriangle = bestTriangle;
+		++emittedCount;
+
+		if (std::size(meshletPrimitives) == m_maxPrimitives) {
+			flushMeshlet();
+			lastTriangle = s_noTriangle;
+		}
+	}
+
+	if (!std::empty(meshletPrimitives))
+		flushMeshlet();
+
+	return modelMeshlets;
+}
+
+MeshletBuilder::MeshletStats MeshletBuilder::GetMeshletStats(
+	const MeshletData& meshletData
+) const noexcept {
+	MeshletStats meshletStats{};
+	size_t vertexCount = 0u;
+
+	for (const std::vector<Meshlet>& meshlets : meshletData.modelMeshlets)
+		for (const Meshlet& meshlet : meshlets) {
+			++meshletStats.meshletCount;
+			meshletStats.triangleCount += meshlet.primitiveCount;
+			vertexCount += meshlet.vertexCount;
+		}
+
+	if (meshletStats.meshletCount == 0u)
+		return meshletStats;
+
+	const auto meshletCount = static_cast<float>(meshletStats.meshletCount);
+
+	meshletStats.vertexFillRatio =
+		static_cast<float>(vertexCount) / (meshletCount * static_cast<float>(m_maxVertices));
+	meshletStats.primitiveFillRatio = static_cast<float>(meshletStats.triangleCount)
+		/ (meshletCount * static_cast<float>(m_maxPrimitives));
+	meshletStats.verticesPerTriangle =
+		static_cast<float>(vertexCount) / static_cast<float>(meshletStats.triangleCount);
+
+	return meshletStats;
+}
+
+std::uint32_t MeshletBuilder::PackPrimitive(
+	std::uint32_t vertex0, std::uint32_t vertex1, std::uint32_t vertex2
+) noexcept {
+	return (vertex0 & 0x3FFu) | ((vertex1 & 0x3FFu) << 10u) | ((vertex2 & 0x3FFu) << 20u);
+}
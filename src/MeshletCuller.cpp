@@ -0,0 +1,140 @@
+#include <MeshletCuller.hpp>
+#include <algorithm>
+#include <cmath>
+
+MeshletCuller::MeshletCuller() noexcept : m_frustumCuller{}, m_cameraPosition{ 0.f, 0.f, 0.f } {}
+
+MeshletBounds MeshletCuller::ComputeBounds(
+	const Meshlet& meshlet, const std::vector<Vertex>& vertices,
+	const std::vector<std::uint32_t>& vertexIndices,
+	const std::vector<std::uint32_t>& primIndices
+) noexcept {
+	using namespace DirectX;
+
+	auto getPosition = [&](std::uint32_t meshletVertex) noexcept {
+		const std::uint32_t vertexIndex = vertexIndices[meshlet.vertexOffset + meshletVertex];
+
+		return XMLoadFloat3(&vertices[vertexIndex].position);
+	};
+
+	MeshletBounds bounds{
+		.sphereCentre = { 0.f, 0.f, 0.f },
+		.sphereRadius = 0.f,
+		.coneApex = { 0.f, 0.f, 0.f },
+		.coneCutoff = 2.f,
+		.coneAxis = { 0.f, 0.f, 0.f },
+		.padding = 0.f
+	};
+
+	if (meshlet.vertexCount == 0u)
+		return bounds;
+
+	// The centre of the box around the vertices is close enough to the smallest sphere's.
+	XMVECTOR minimum = getPosition(0u);
+	XMVECTOR maximum = minimum;
+
+	for (std::uint32_t index = 1u; index < meshlet.vertexCount; ++index) {
+		minimum = XMVectorMin(minimum, getPosition(index));
+		maximum = XMVectorMax(maximum, getPosition(index));
+	}
+
+	const XMVECTOR centre = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+	float radius = 0.f;
+
+	for (std::uint32_t index = 0u; index < meshlet.vertexCount; ++index)
+		radius = std::max(
+			radius, XMVectorGetX(XMVector3Length(XMVectorSubtract(getPosition(index), centre)))
+		);
+
+	XMStoreFloat3(&bounds.sphereCentre, centre);
+	bounds.sphereRadius = radius;
+	bounds.coneApex = bounds.sphereCentre;
+
+	// The triangles face the side the clockwise winding is seen from, which is where
+	// cross(p1 - p0, p2 - p0) points to in a left-handed space.
+	std::vector<XMVECTOR> normals;
+	std::vector<XMVECTOR> corners;
+	normals.reserve(meshlet.primitiveCount);
+	corners.reserve(meshlet.primitiveCount);
+
+	XMVECTOR normalSum = XMVectorZero();
+
+	for (std::uint32_t index = 0u; index < meshlet.primitiveCount; ++index) {
+		const std::uint32_t primitive = primIndices[meshlet.primitiveOffset + index];
+
+		const XMVECTOR position0 = getPosition(primitive & 0x3FFu);
+		const XMVECTOR position1 = getPosition((primitive >> 10u) & 0x3FFu);
+		const XMVECTOR position2 = getPosition((primitive >> 20u) & 0x3FFu);
+
+		const XMVECTOR normal = XMVector3Cross(
+			XMVectorSubtract(position1, position0), XMVectorSubtract(position2, position0)
+		);
+
+		// A degenerate triangle is never drawn, so it doesn't bound the cone.
+		if (XMVectorGetX(XMVector3LengthSq(normal)) == 0.f)
+			continue;
+
+		normals.emplace_back(XMVector3Normalize(normal));
+		corners.emplace_back(position0);
+		normalSum = XMVectorAdd(normalSum, normals.back());
+	}
+
+	if (std::empty(normals) || XMVectorGetX(XMVector3LengthSq(normalSum)) == 0.f)
+		return bounds;
+
+	const XMVECTOR axis = XMVector3Normalize(normalSum);
+	float minimumDot = 1.f;
+
+	for (const XMVECTOR& normal : normals)
+		minimumDot = std::min(minimumDot, XMVectorGetX(XMVector3Dot(axis, normal)));
+
+	// The cone of a meshlet this spread would almost never cull it, and the apex gets far.
+	if (minimumDot <= 0.1f)
+		return bounds;
+
+	// The apex is moved back until it is behind every triangle's plane.
+	float apexDistance = 0.f;
+
+	for (size_t index = 0u; index < std::size(normals); ++index) {
+		const float centreDistance = XMVectorGetX(
+			XMVector3Dot(XMVectorSubtract(centre, corners[index]), normals[index])
+		);
+
+		apexDistance = std::max(
+			apexDistance, centreDistance / XMVectorGetX(XMVector3Dot(axis, normals[index]))
+		);
+	}
+
+	XMStoreFloat3(&bounds.coneApex, XMVectorSubtract(centre, XMVectorScale(axis, apexDistance)));
+	XMStoreFloat3(&bounds.coneAxis, axis);
+	bounds.coneCutoff = std::sqrt(1.f - minimumDot * minimumDot);
+
+	return bounds;
+}
+
+void MeshletCuller::SetCamera(
+	const DirectX::XMMATRIX& modelViewProjection, const DirectX::XMFLOAT3& cameraPosition
+) noexcept {
+	m_frustumCuller.SetViewProjection(modelViewProjection);
+	m_cameraPosition = cameraPosition;
+}
+
+bool MeshletCuller::IsMeshletVisible(const MeshletBounds& bounds) const noexcept {
+	using namespace DirectX;
+
+	if (m_frustumCuller.TestSphere(bounds.sphereCentre, bounds.sphereRadius)
+		== FrustumTest::Outside)
+		return false;
+
+	const XMVECTOR apexOffset = XMVectorSubtract(
+		XMLoadFloat3(&bounds.coneApex), XMLoadFloat3(&m_cameraPosition)
+	);
+
+	// A camera on the apex has no direction to test.
+	if (XMVectorGetX(XMVector3LengthSq(apexOffset)) == 0.f)
+		return true;
+
+	return XMVectorGetX(
+		XMVector3Dot(XMVector3Normalize(apexOffset), XMLoadFloat3(&bounds.coneAxis))
+	) < bounds.coneCutoff;
+}
@@ -0,0 +1,66 @@
+#include <ModelDataWriter.hpp>
+#include <algorithm>
+#include <thread>
+#include <JobRunner.hpp>
+#include <SizeHelpers.hpp>
+
+ModelDataWriter::ModelDataWriter(ModelTransformStore& modelStore) noexcept
+	: m_modelStore{ modelStore } {}
+
+size_t ModelDataWriter::UpdateMaterialDataRange(
+	std::uint8_t* materialBufferStart, std::uint32_t frameBit, size_t modelStart,
+	size_t modelEnd
+) noexcept {
+	const ModelMaterial* materials = m_modelStore.GetMaterials();
+	std::uint32_t* dirtyFrames = m_modelStore.GetMaterialDirtyFrames();
+
+	size_t materialsWritten = 0u;
+
+	// The store has the same layout as the buffer, so each run of dirty entries is one copy.
+	for (size_t index = modelStart; index < modelEnd;) {
+		if (!(dirtyFrames[index] & frameBit)) {
+			++index;
+
+			continue;
+		}
+
+		const size_t runStart = index;
+		for (; index < modelEnd && (dirtyFrames[index] & frameBit); ++index)
+			dirtyFrames[index] &= ~frameBit;
+
+		const size_t runLength = index - runStart;
+		memcpy(
+			materialBufferStart + sizeof(MaterialBuffer) * runStart, materials + runStart,
+			sizeof(MaterialBuffer) * runLength
+		);
+
+		materialsWritten += runLength;
+	}
+
+	return materialsWritten;
+}
+
+void ModelDataWriter::UpdateModelsInChunks(
+	size_t modelCount, const std::function<void(size_t, size_t)>& updateRange
+) {
+	if (!Gaia::threadPool || modelCount < s_parallelUpdateThreshold) {
+		updateRange(0u, modelCount);
+
+		return;
+	}
+
+	const size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	const size_t chunkSize = Align(
+		(modelCount + threadCount - 1u) / threadCount, s_modelChunkGranularity
+	);
+	const size_t chunkCount = (modelCount + chunkSize - 1u) / chunkSize;
+
+	Gaia::RunJobs(
+		chunkCount,
+		[&updateRange, chunkSize, modelCount](size_t chunkIndex) {
+			const size_t chunkStart = chunkIndex * chunkSize;
+
+			updateRange(chunkStart, std::min(chunkStart + chunkSize, modelCount));
+		}
+	);
+}
@@ -0,0 +1,289 @@
+#include <NormalMatrix.hpp>
+#include <atomic>
+#include <cmath>
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC compiles the AVX2 intrinsics in any function.
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+static NormalMatrixPath PickFastestPath() noexcept {
+	return IsAVX2Supported() ? NormalMatrixPath::AffineAVX2 : NormalMatrixPath::Affine;
+}
+
+static std::atomic<NormalMatrixPath> s_normalMatrixPath = PickFastestPath();
+
+static bool IsAffine(const DirectX::XMFLOAT4X4& matrix) noexcept {
+	return matrix._14 == 0.f && matrix._24 == 0.f && matrix._34 == 0.f && matrix._44 == 1.f;
+}
+
+static void ComputeNormalMatrixReference(
+	const DirectX::XMMATRIX& modelView, DirectX::XMFLOAT4X4& normalMatrix
+) noexcept {
+	DirectX::XMStoreFloat4x4(
+		&normalMatrix, DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(nullptr, modelView))
+	);
+}
+
+// For an affine matrix with the upper 3x3 L and the translation t, the transposed inverse is
+// L^-T with -(L^-T * t) in the last column. L^-T is L / s^2 if L is a rotation with a
+// uniform scale s, otherwise it is the cofactor matrix of L divided by its determinant.
+static void ComputeNormalMatrixAffine(
+	const DirectX::XMMATRIX& modelView, DirectX::XMFLOAT4X4& normalMatrix
+) noexcept {
+	using namespace DirectX;
+
+	static constexpr float epsilon = 1e-5f;
+
+	const XMVECTOR row0 = modelView.r[0];
+	const XMVECTOR row1 = modelView.r[1];
+	const XMVECTOR row2 = modelView.r[2];
+	const XMVECTOR translation = modelView.r[3];
+
+	const float lengthSq0 = XMVectorGetX(XMVector3LengthSq(row0));
+	const float lengthSq1 = XMVectorGetX(XMVector3LengthSq(row1));
+	const float lengthSq2 = XMVectorGetX(XMVector3LengthSq(row2));
+	const float tolerance = epsilon * lengthSq0;
+
+	const bool uniformScale =
+		std::abs(XMVectorGetX(XMVector3Dot(row0, row1))) <= tolerance
+		&& std::abs(XMVectorGetX(XMVector3Dot(row0, row2))) <= tolerance
+		&& std::abs(XMVectorGetX(XMVector3Dot(row1, row2))) <= tolerance
+		&& std::abs(lengthSq1 - lengthSq0) <= tolerance
+		&& std::abs(lengthSq2 - lengthSq0) <= tolerance;
+
+	XMVECTOR normalRow0{};
+	XMVECTOR normalRow1{};
+	XMVECTOR normalRow2{};
+
+	if (uniformScale) {
+		const XMVECTOR inverseScaleSq = XMVectorReplicate(1.f / lengthSq0);
+
+		normalRow0 = XMVectorMultiply(row0, inverseScaleSq);
+		normalRow1 = XMVectorMultiply(row1, inverseScaleSq);
+		normalRow2 = XMVectorMultiply(row2, inverseScaleSq);
+	}
+	else {
+		const XMVECTOR cofactor0 = XMVector3Cross(row1, row2);
+		const XMVECTOR inverseDeterminant = XMVectorReciprocal(XMVector3Dot(row0, cofactor0));
+
+		normalRow0 = XMVectorMultiply(cofactor0, inverseDeterminant);
+		normalRow1 = XMVectorMultiply(XMVector3Cross(row2, row0), inverseDeterminant);
+		normalRow2 = XMVectorMultiply(XMVector3Cross(row0, row1), inverseDeterminant);
+	}
+
+	XMMATRIX result{};
+	result.r[0] = XMVectorSetW(normalRow0, -XMVectorGetX(XMVector3Dot(normalRow0, translation)));
+	result.r[1] = XMVectorSetW(normalRow1, -XMVectorGetX(XMVector3Dot(normalRow1, translation)));
+	result.r[2] = XMVectorSetW(normalRow2, -XMVectorGetX(XMVector3Dot(normalRow2, translation)));
+	result.r[3] = XMVectorSet(0.f, 0.f, 0.f, 1.f);
+
+	XMStoreFloat4x4(&normalMatrix, result);
+}
+
+static void ComputeNormalMatricesScalar(
+	const DirectX::XMFLOAT4X4* modelMatrices, const std::uint32_t* modelIndices, size_t count,
+	const DirectX::XMMATRIX& viewMatrix, bool viewAffine, bool reference,
+	DirectX::XMFLOAT4X4* normalMatrices
+) noexcept {
+	for (size_t index = 0u; index < count; ++index) {
+		const DirectX::XMFLOAT4X4& modelMatrix = modelMatrices[modelIndices[index]];
+		const DirectX::XMMATRIX modelView = DirectX::XMLoadFloat4x4(&modelMatrix) * viewMatrix;
+
+		if (reference || !viewAffine || !IsAffine(modelMatrix))
+			ComputeNormalMatrixReference(modelView, normalMatrices[index]);
+		else
+			ComputeNormalMatrixAffine(modelView, normalMatrices[index]);
+	}
+}
+
+AVX2_TARGET
+static void Cross8(const __m256* a, const __m256* b, __m256* result) noexcept {
+	result[0] = _mm256_fmsub_ps(a[1], b[2], _mm256_mul_ps(a[2], b[1]));
+	result[1] = _mm256_fmsub_ps(a[2], b[0], _mm256_mul_ps(a[0], b[2]));
+	result[2] = _mm256_fmsub_ps(a[0], b[1], _mm256_mul_ps(a[1], b[0]));
+}
+
+// Eight models at a time, one per lane. Only the cofactor form is used here, as it holds for
+// every affine matrix and avoids divergent lanes.
+AVX2_TARGET
+static void ComputeNormalMatricesAVX2(
+	const DirectX::XMFLOAT4X4* modelMatrices, const std::uint32_t* modelIndices, size_t count,
+	const DirectX::XMMATRIX& viewMatrix, DirectX::XMFLOAT4X4* normalMatrices
+) noexcept {
+	static constexpr size_t laneCount = 8u;
+
+	DirectX::XMFLOAT4X4 view{};
+	DirectX::XMStoreFloat4x4(&view, viewMatrix);
+
+	__m256 v[4][3];
+	for (size_t row = 0u; row < 4u; ++row)
+		for (size_t column = 0u; column < 3u; ++column)
+			v[row][column] = _mm256_set1_ps(view.m[row][column]);
+
+	const float* matrixStart = &modelMatrices[0]._11;
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.f);
+
+	size_t index = 0u;
+	for (; index + laneCount <= count; index += laneCount) {
+		const __m256i elementOffsets = _mm256_slli_epi32(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(modelIndices + index)), 4
+		);
+
+		__m256 m[4][4];
+		for (int row = 0; row < 4; ++row)
+			for (int column = 0; column < 4; ++column)
+				m[row][column] = _mm256_i32gather_ps(
+					matrixStart + row * 4 + column, elementOffsets, 4
+				);
+
+		const __m256 affineMask = _mm256_and_ps(
+			_mm256_and_ps(
+				_mm256_cmp_ps(m[0][3], zero, _CMP_EQ_OQ), _mm256_cmp_ps(m[1][3], zero, _CMP_EQ_OQ)
+			),
+			_mm256_and_ps(
+				_mm256_cmp_ps(m[2][3], zero, _CMP_EQ_OQ), _mm256_cmp_ps(m[3][3], one, _CMP_EQ_OQ)
+			)
+		);
+
+		if (_mm256_movemask_ps(affineMask) != 0xFF) {
+			ComputeNormalMatricesScalar(
+				modelMatrices, modelIndices + index, laneCount, viewMatrix, true, false,
+				normalMatrices + index
+			);
+
+			continue;
+		}
+
+		// The upper 3x3 and the translation of model * view.
+		__m256 l[3][3];
+		__m256 t[3];
+		for (size_t column = 0u; column < 3u; ++column) {
+			for (size_t row = 0u; row < 3u; ++row)
+				l[row][column] = _mm256_fmadd_ps(
+					m[row][0], v[0][column],
+					_mm256_fmadd_ps(m[row][1], v[1][column], _mm256_mul_ps(m[row][2], v[2][column]))
+				);
+
+			t[column] = _mm256_fmadd_ps(
+				m[3][0], v[0][column],
+				_mm256_fmadd_ps(
+					m[3][1], v[1][column], _mm256_fmadd_ps(m[3][2], v[2][column], v[3][column])
+				)
+			);
+		}
+
+		__m256 n[3][3];
+		Cross8(l[1], l[2], n[0]);
+		Cross8(l[2], l[0], n[1]);
+		Cross8(l[0], l[1], n[2]);
+
+		const __m256 determinant = _mm256_fmadd_ps(
+			l[0][0], n[0][0], _mm256_fmadd_ps(l[0][1], n[0][1], _mm256_mul_ps(l[0][2], n[0][2]))
+		);
+		const __m256 inverseDeterminant = _mm256_div_ps(one, determinant);
+
+		alignas(32) float result[12][laneCount];
+		for (size_t row = 0u; row < 3u; ++row) {
+			for (size_t column = 0u; column < 3u; ++column) {
+				n[row][column] = _mm256_mul_ps(n[row][column], inverseDeterminant);
+				_mm256_store_ps(result[row * 3u + column], n[row][column]);
+			}
+
+			const __m256 translationDot = _mm256_fmadd_ps(
+				n[row][0], t[0], _mm256_fmadd_ps(n[row][1], t[1], _mm256_mul_ps(n[row][2], t[2]))
+			);
+			_mm256_store_ps(result[9u + row], _mm256_sub_ps(zero, translationDot));
+		}
+
+		for (size_t lane = 0u; lane < laneCount; ++lane) {
+			DirectX::XMFLOAT4X4& normalMatrix = normalMatrices[index + lane];
+
+			for (size_t row = 0u; row < 3u; ++row) {
+				normalMatrix.m[row][0] = result[row * 3u][lane];
+				normalMatrix.m[row][1] = result[row * 3u + 1u][lane];
+				normalMatrix.m[row][2] = result[row * 3u + 2u][lane];
+				normalMatrix.m[row][3] = result[9u + row][lane];
+			}
+
+			normalMatrix.m[3][0] = 0.f;
+			normalMatrix.m[3][1] = 0.f;
+			normalMatrix.m[3][2] = 0.f;
+			normalMatrix.m[3][3] = 1.f;
+		}
+	}
+
+	ComputeNormalMatricesScalar(
+		modelMatrices, modelIndices + index, count - index, viewMatrix, true, false,
+		normalMatrices + index
+	);
+}
+
+void ComputeNormalMatrices(
+	const DirectX::XMFLOAT4X4* modelMatrices, const std::uint32_t* modelIndices, size_t count,
+	const DirectX::XMMATRIX& viewMatrix, DirectX::XMFLOAT4X4* normalMatrices
+) noexcept {
+	DirectX::XMFLOAT4X4 view{};
+	DirectX::XMStoreFloat4x4(&view, viewMatrix);
+
+	const bool viewAffine = IsAffine(view);
+	const NormalMatrixPath path = s_normalMatrixPath.load(std::memory_order_relaxed);
+
+	if (path == NormalMatrixPath::AffineAVX2 && viewAffine)
+		ComputeNormalMatricesAVX2(
+			modelMatrices, modelIndices, count, viewMatrix, normalMatrices
+		);
+	else
+		ComputeNormalMatricesScalar(
+			modelMatrices, modelIndices, count, viewMatrix, viewAffine,
+			path == NormalMatrixPath::Reference, normalMatrices
+		);
+}
+
+void SetNormalMatrixPath(NormalMatrixPath path) noexcept {
+	if (path == NormalMatrixPath::AffineAVX2 && !IsAVX2Supported())
+		path = NormalMatrixPath::Affine;
+
+	s_normalMatrixPath.store(path, std::memory_order_relaxed);
+}
+
+NormalMatrixPath GetNormalMatrixPath() noexcept {
+	return s_normalMatrixPath.load(std::memory_order_relaxed);
+}
+
+bool IsAVX2Supported() noexcept {
+#ifndef _MSC_VER
+	// The path is picked during static initialisation, which can run before libgcc's own.
+	__builtin_cpu_init();
+
+	// These check that the OS preserves the YMM registers as well.
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+	int cpuInfo[4]{};
+
+	__cpuid(cpuInfo, 0);
+	if (cpuInfo[0] < 7)
+		return false;
+
+	__cpuid(cpuInfo, 1);
+	const bool fma = cpuInfo[2] & (1 << 12);
+	const bool osxsave = cpuInfo[2] & (1 << 27);
+	const bool avx = cpuInfo[2] & (1 << 28);
+
+	if (!fma || !osxsave || !avx)
+		return false;
+
+	// The OS has to preserve the YMM registers as well.
+	if ((_xgetbv(_XCR_XFEATURE_ENABLED_MASK) & 0x6u) != 0x6u)
+		return false;
+
+	__cpuidex(cpuInfo, 7, 0);
+
+	return cpuInfo[1] & (1 << 5);
+#endif
+}
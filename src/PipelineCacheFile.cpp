@@ -0,0 +1,144 @@
+#include <PipelineCacheFile.hpp>
+#include <PipelineHasher.hpp>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+	template<typename T>
+	void WriteValue(std::vector<std::uint8_t>& data, size_t offset, T value) noexcept {
+		for (size_t byteIndex = 0u; byteIndex < sizeof(T); ++byteIndex)
+			data[offset + byteIndex] = static_cast<std::uint8_t>(value >> (byteIndex * 8u));
+	}
+
+	template<typename T>
+	[[nodiscard]]
+	T ReadValue(const std::vector<std::uint8_t>& data, size_t offset) noexcept {
+		T value = 0u;
+
+		for (size_t byteIndex = 0u; byteIndex < sizeof(T); ++byteIndex)
+			value |= static_cast<T>(data[offset + byteIndex]) << (byteIndex * 8u);
+
+		return value;
+	}
+}
+
+PipelineCacheFile::PipelineCacheFile(std::uint64_t deviceId) noexcept : m_deviceId{ deviceId } {}
+
+std::vector<std::uint8_t> PipelineCacheFile::Serialise(const PipelineCacheData& cacheData) const {
+	const size_t keyCount = std::size(cacheData.pipelineKeys);
+	const size_t librarySize = std::size(cacheData.library);
+	const size_t libraryOffset = s_headerSize + keyCount * sizeof(std::uint64_t);
+
+	std::vector<std::uint8_t> fileData(libraryOffset + librarySize);
+
+	WriteValue<std::uint32_t>(fileData, 0u, s_magic);
+	WriteValue<std::uint32_t>(fileData, 4u, s_formatVersion);
+	WriteValue<std::uint64_t>(fileData, 8u, m_deviceId);
+	WriteValue<std::uint64_t>(fileData, 16u, keyCount);
+	WriteValue<std::uint64_t>(fileData, 24u, librarySize);
+
+	for (size_t keyIndex = 0u; keyIndex < keyCount; ++keyIndex)
+		WriteValue<std::uint64_t>(
+			fileData, s_headerSize + keyIndex * sizeof(std::uint64_t),
+			cacheData.pipelineKeys[keyIndex]
+		);
+
+	std::ranges::copy(cacheData.library, std::begin(fileData) + libraryOffset);
+
+	WriteValue<std::uint64_t>(fileData, 32u, GetChecksum(fileData, s_headerSize));
+
+	return fileData;
+}
+
+bool PipelineCacheFile::Deserialise(
+	const std::vector<std::uint8_t>& fileData, PipelineCacheData& cacheData
+) const {
+	const size_t fileSize = std::size(fileData);
+
+	if (fileSize < s_headerSize)
+		return false;
+
+	if (ReadValue<std::uint32_t>(fileData, 0u) != s_magic
+		|| ReadValue<std::uint32_t>(fileData, 4u) != s_formatVersion
+		|| ReadValue<std::uint64_t>(fileData, 8u) != m_deviceId)
+		return false;
+
+	const std::uint64_t keyCount = ReadValue<std::uint64_t>(fileData, 16u);
+	const std::uint64_t librarySize = ReadValue<std::uint64_t>(fileData, 24u);
+
+	// Checked one at a time, so a damaged count can't wrap the total around.
+	const size_t contentSize = fileSize - s_headerSize;
+
+	if (keyCount > contentSize / sizeof(std::uint64_t)
+		|| librarySize != contentSize - keyCount * sizeof(std::uint64_t))
+		return false;
+
+	if (ReadValue<std::uint64_t>(fileData, 32u) != GetChecksum(fileData, s_headerSize))
+		return false;
+
+	cacheData.pipelineKeys.resize(keyCount);
+
+	for (size_t keyIndex = 0u; keyIndex < keyCount; ++keyIndex)
+		cacheData.pipelineKeys[keyIndex] = ReadValue<std::uint64_t>(
+			fileData, s_headerSize + keyIndex * sizeof(std::uint64_t)
+		);
+
+	const size_t libraryOffset = s_headerSize + keyCount * sizeof(std::uint64_t);
+
+	cacheData.library.assign(std::begin(fileData) + libraryOffset, std::end(fileData));
+
+	return true;
+}
+
+bool PipelineCacheFile::Read(
+	const std::filesystem::path& filePath, PipelineCacheData& cacheData
+) const {
+	std::ifstream file{ filePath, std::ios_base::binary | std::ios_base::in };
+
+	if (!file)
+		return false;
+
+	std::vector<std::uint8_t> fileData{
+		std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{}
+	};
+
+	return Deserialise(fileData, cacheData);
+}
+
+bool PipelineCacheFile::Write(
+	const std::filesystem::path& filePath, const PipelineCacheData& cacheData
+) const {
+	const std::vector<std::uint8_t> fileData = Serialise(cacheData);
+
+	std::filesystem::path temporaryPath = filePath;
+	temporaryPath += ".tmp";
+
+	{
+		std::ofstream file{
+			temporaryPath, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc
+		};
+
+		file.write(
+			reinterpret_cast<const char*>(std::data(fileData)),
+			static_cast<std::streamsize>(std::size(fileData))
+		);
+
+		if (!file)
+			return false;
+	}
+
+	std::error_code errorCode{};
+	std::filesystem::rename(temporaryPath, filePath, errorCode);
+
+	return !errorCode;
+}
+
+std::uint64_t PipelineCacheFile::GetChecksum(
+	const std::vector<std::uint8_t>& fileData, size_t contentOffset
+) noexcept {
+	// The part of the header before the checksum is covered as well.
+	return PipelineHasher{}.AddBytes(std::data(fileData), 32u)
+		.AddBytes(std::data(fileData) + contentOffset, std::size(fileData) - contentOffset)
+		.GetHash();
+}
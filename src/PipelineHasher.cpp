@@ -0,0 +1,27 @@
+#include <PipelineHasher.hpp>
+#include <cstring>
+
+PipelineHasher::PipelineHasher() noexcept : m_hash{ 14695981039346656037u } {}
+
+PipelineHasher& PipelineHasher::AddBytes(void const* data, size_t size) noexcept {
+	auto bytes = static_cast<const std::uint8_t*>(data);
+
+	for (size_t index = 0u; index < size; ++index) {
+		m_hash ^= bytes[index];
+		m_hash *= 1099511628211u;
+	}
+
+	return *this;
+}
+
+PipelineHasher& PipelineHasher::AddString(const char* string) noexcept {
+	const std::uint64_t length = string ? std::strlen(string) : 0u;
+
+	AddValue(length);
+
+	return AddBytes(string, length);
+}
+
+std::uint64_t PipelineHasher::GetHash() const noexcept {
+	return m_hash;
+}
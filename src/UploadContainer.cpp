@@ -1,69 +1,207 @@
-#include <UploadContainer.hpp>
-#include <cstring>
-#include <Gaia.hpp>
-#include <D3DHelperFunctions.hpp>
-
-void UploadContainer::AddMemory(
-	void const* srcMemoryRef, void* dstMemoryRef, size_t size
-) noexcept {
-	MemoryData memData{
-		.rowPitch = size,
-		.height = 1u,
-		.src = srcMemoryRef,
-		.dst = dstMemoryRef,
-		.texture = false
-	};
-
-	m_memoryData.emplace_back(memData);
-}
-
-void UploadContainer::AddMemory(
-	void const* srcMemoryRef, void* dstMemoryRef, size_t rowPitch, size_t height
-) noexcept {
-	MemoryData memData{
-		.rowPitch = rowPitch,
-		.height = height,
-		.src = srcMemoryRef,
-		.dst = dstMemoryRef,
-		.texture = true
-	};
-
-	m_memoryData.emplace_back(memData);
-}
-
-void UploadContainer::CopyTexture(const MemoryData& memData) const noexcept {
-	const size_t alignedRowPitch = Align(
-		memData.rowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
-	);
-
-	for (size_t row = 0; row < memData.height; ++row) {
-		void* dst = reinterpret_cast<std::uint8_t*>(memData.dst) + (alignedRowPitch * row);
-		void const* src =
-			reinterpret_cast<std::uint8_t const*>(memData.src) + (memData.rowPitch * row);
-
-		memcpy(dst, src, memData.rowPitch);
-	}
-}
-
-void UploadContainer::CopyBuffer(const MemoryData& memData) const noexcept {
-	memcpy(memData.dst, memData.src, memData.rowPitch);
-}
-
-void UploadContainer::CopyData(std::atomic_size_t& workCount) const noexcept {
-	++workCount;
-
-	Gaia::threadPool->SubmitWork(
-		[&] {
-			for (size_t index = 0u; index < std::size(m_memoryData); ++index) {
-				const MemoryData& memoryData = m_memoryData[index];
-
-				if (memoryData.texture)
-					CopyTexture(memoryData);
-				else
-					CopyBuffer(memoryData);
-			}
-
-			--workCount;
-		}
-	);
-}
+#include <UploadContainer.hpp>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <JobRunner.hpp>
+#include <SizeHelpers.hpp>
+
+UploadContainer::UploadContainer() noexcept : m_copyStats{} {}
+
+void UploadContainer::AddMemory(
+	void const* srcMemoryRef, void* dstMemoryRef, size_t size
+) noexcept {
+	MemoryData memData{
+		.rowPitch = size,
+		.height = 1u,
+		.src = srcMemoryRef,
+		.dst = dstMemoryRef,
+		.texture = false
+	};
+
+	m_memoryData.emplace_back(memData);
+}
+
+void UploadContainer::AddMemory(
+	void const* srcMemoryRef, void* dstMemoryRef, size_t rowPitch, size_t height
+) noexcept {
+	MemoryData memData{
+		.rowPitch = rowPitch,
+		.height = height,
+		.src = srcMemoryRef,
+		.dst = dstMemoryRef,
+		.texture = true
+	};
+
+	m_memoryData.emplace_back(memData);
+}
+
+void UploadContainer::CopyTextureRows(
+	const MemoryData& memData, size_t rowStart, size_t rowCount
+) const noexcept {
+	const size_t alignedRowPitch = Align(memData.rowPitch, s_rowPitchAlignment);
+
+	for (size_t row = rowStart; row < rowStart + rowCount; ++row) {
+		void* dst = reinterpret_cast<std::uint8_t*>(memData.dst) + (alignedRowPitch * row);
+		void const* src =
+			reinterpret_cast<std::uint8_t const*>(memData.src) + (memData.rowPitch * row);
+
+		memcpy(dst, src, memData.rowPitch);
+	}
+}
+
+void UploadContainer::CopyBufferBytes(
+	const MemoryData& memData, size_t byteStart, size_t byteCount
+) const noexcept {
+	memcpy(
+		reinterpret_cast<std::uint8_t*>(memData.dst) + byteStart,
+		reinterpret_cast<std::uint8_t const*>(memData.src) + byteStart, byteCount
+	);
+}
+
+size_t UploadContainer::CreateStripes() {
+	m_copyStripes.clear();
+
+	size_t totalSize = 0u;
+
+	for (size_t index = 0u; index < std::size(m_memoryData); ++index) {
+		const MemoryData& memData = m_memoryData[index];
+
+		if (memData.texture) {
+			const size_t stripeRows = std::max(s_stripeSize / std::max(memData.rowPitch, 1_B), 1_B);
+
+			for (size_t row = 0u; row < memData.height; row += stripeRows)
+				m_copyStripes.emplace_back(
+					CopyStripe{
+						.memoryIndex = index,
+						.start = row,
+						.count = std::min(stripeRows, memData.height - row)
+					}
+				);
+
+			totalSize += memData.rowPitch * memData.height;
+		}
+		else {
+			for (size_t byte = 0u; byte < memData.rowPitch; byte += s_stripeSize)
+				m_copyStripes.emplace_back(
+					CopyStripe{
+						.memoryIndex = index,
+						.start = byte,
+						.count = std::min(s_stripeSize, memData.rowPitch - byte)
+					}
+				);
+
+			totalSize += memData.rowPitch;
+		}
+	}
+
+	return totalSize;
+}
+
+void UploadContainer::CreateBatches(size_t totalSize, size_t batchCount) {
+	m_copyBatches.clear();
+
+	// The stripes are small enough for a greedy split to stay close to the target.
+	const size_t targetSize = (totalSize + batchCount - 1u) / batchCount;
+
+	size_t stripeStart = 0u;
+	size_t batchSize = 0u;
+
+	for (size_t index = 0u; index < std::size(m_copyStripes); ++index) {
+		const CopyStripe& stripe = m_copyStripes[index];
+		const MemoryData& memData = m_memoryData[stripe.memoryIndex];
+
+		batchSize += memData.texture ? memData.rowPitch * stripe.count : stripe.count;
+
+		if (batchSize >= targetSize) {
+			m_copyBatches.emplace_back(
+				CopyBatch{ .stripeStart = stripeStart, .stripeEnd = index + 1u }
+			);
+
+			stripeStart = index + 1u;
+			batchSize = 0u;
+		}
+	}
+
+	if (stripeStart < std::size(m_copyStripes) || std::empty(m_copyBatches))
+		m_copyBatches.emplace_back(
+			CopyBatch{ .stripeStart = stripeStart, .stripeEnd = std::size(m_copyStripes) }
+		);
+}
+
+void UploadContainer::CopyBatchStripes(size_t batchIndex) noexcept {
+	const auto batchStart = std::chrono::steady_clock::now();
+
+	const CopyBatch& batch = m_copyBatches[batchIndex];
+
+	for (size_t index = batch.stripeStart; index < batch.stripeEnd; ++index) {
+		const CopyStripe& stripe = m_copyStripes[index];
+		const MemoryData& memData = m_memoryData[stripe.memoryIndex];
+
+		if (memData.texture)
+			CopyTextureRows(memData, stripe.start, stripe.count);
+		else
+			CopyBufferBytes(memData, stripe.start, stripe.count);
+	}
+
+	// Each batch writes its own element.
+	m_copyStats.batchSeconds[batchIndex] = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - batchStart
+	).count();
+}
+
+void UploadContainer::CopyData() {
+	m_copyStart = std::chrono::steady_clock::now();
+
+	const size_t totalSize = CreateStripes();
+	const size_t threadCount = Gaia::threadPool ?
+		std::max(std::thread::hardware_concurrency(), 1u) : 1u;
+
+	// Small uploads aren't worth waking every worker for.
+	CreateBatches(totalSize, std::clamp(totalSize / s_stripeSize, 1_B, threadCount));
+
+	const size_t batchCount = std::size(m_copyBatches);
+
+	m_copyStats = CopyStats{
+		.bytesCopied = static_cast<std::uint64_t>(totalSize),
+		.copySeconds = 0.,
+		.gigabytesPerSecond = 0.,
+		.batchSeconds = std::vector<double>(batchCount, 0.)
+	};
+
+	m_workerBatchesLeft = std::make_unique<std::latch>(
+		static_cast<std::ptrdiff_t>(batchCount - 1u)
+	);
+
+	for (size_t batchIndex = 1u; batchIndex < batchCount; ++batchIndex)
+		Gaia::threadPool->SubmitWork(
+			[this, batchIndex] {
+				CopyBatchStripes(batchIndex);
+
+				m_workerBatchesLeft->count_down();
+			}
+		);
+
+	CopyBatchStripes(0u);
+}
+
+void UploadContainer::WaitForCopies() {
+	if (m_workerBatchesLeft)
+		m_workerBatchesLeft->wait();
+
+	m_copyStats.copySeconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - m_copyStart
+	).count();
+
+	if (m_copyStats.copySeconds > 0.)
+		m_copyStats.gigabytesPerSecond =
+			static_cast<double>(m_copyStats.bytesCopied) / 1e9 / m_copyStats.copySeconds;
+
+	m_workerBatchesLeft.reset();
+	m_memoryData = std::vector<MemoryData>{};
+	m_copyStripes = std::vector<CopyStripe>{};
+	m_copyBatches = std::vector<CopyBatch>{};
+}
+
+UploadContainer::CopyStats UploadContainer::GetCopyStats() const {
+	return m_copyStats;
+}
@@ -0,0 +1,504 @@
+#include <VertexCacheOptimiser.hpp>
+#include <JobRunner.hpp>
+#include <Exception.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace {
+	struct IndexRange {
+		std::uint32_t indexOffset;
+		std::uint32_t indexCount;
+	};
+
+	// The models sharing a range only need it once, but ranges which only partly overlap
+	// can't be reordered on their own.
+	[[nodiscard]]
+	std::vector<IndexRange> GetModelRanges(
+		const std::vector<std::uint32_t>& indices,
+		const std::vector<std::shared_ptr<IModel>>& models
+	) {
+		std::vector<IndexRange> ranges;
+		ranges.reserve(std::size(models));
+
+		for (const std::shared_ptr<IModel>& model : models) {
+			const IndexRange range{
+				.indexOffset = model->GetIndexOffset(), .indexCount = model->GetIndexCount()
+			};
+
+			if (static_cast<size_t>(range.indexOffset) + range.indexCount > std::size(indices)
+				|| range.indexCount % 3u != 0u)
+				throw Exception(
+					"VertexCacheOptimiser Error",
+					"A model's indices aren't whole triangles in range."
+				);
+
+			ranges.emplace_back(range);
+		}
+
+		std::ranges::sort(ranges, [](const IndexRange& left, const IndexRange& right) {
+			return left.indexOffset < right.indexOffset
+				|| (left.indexOffset == right.indexOffset && left.indexCount < right.indexCount);
+		});
+
+		const auto duplicates = std::ranges::unique(
+			ranges, [](const IndexRange& left, const IndexRange& right) {
+				return left.indexOffset == right.indexOffset
+					&& left.indexCount == right.indexCount;
+			}
+		);
+		ranges.erase(std::begin(duplicates), std::end(duplicates));
+
+		for (size_t index = 1u; index < std::size(ranges); ++index)
+			if (ranges[index - 1u].indexOffset + ranges[index - 1u].indexCount
+				> ranges[index].indexOffset)
+				throw Exception(
+					"VertexCacheOptimiser Error", "The models' index ranges partly overlap."
+				);
+
+		return ranges;
+	}
+
+	// The vertices are numbered from zero for each model, so the per vertex data stays small.
+	[[nodiscard]]
+	size_t MakeLocalIndices(
+		const std::uint32_t* triangleIndices, size_t indexCount,
+		std::vector<std::uint32_t>& localIndices
+	) {
+		std::unordered_map<std::uint32_t, std::uint32_t> localVertexIndices;
+		localIndices.resize(indexCount);
+
+		for (size_t index = 0u; index < indexCount; ++index)
+			localIndices[index] = localVertexIndices.try_emplace(
+				triangleIndices[index], static_cast<std::uint32_t>(std::size(localVertexIndices))
+			).first->second;
+
+		return std::size(localVertexIndices);
+	}
+}
+
+VertexCacheOptimiser::VertexCacheOptimiser(const Args& arguments)
+	: m_cacheSize{ arguments.cacheSize.value() },
+	m_optimiseOverdraw{ arguments.optimiseOverdraw.value() },
+	m_reorderVertices{ arguments.reorderVertices.value() },
+	m_threadPool{ arguments.threadPool.value() } {
+
+	if (m_cacheSize < 3u)
+		throw Exception("VertexCacheOptimiser Error", "The cache must hold a triangle.");
+}
+
+VertexCacheOptimiser::OptimisationStats VertexCacheOptimiser::Optimise(
+	std::vector<Vertex>& vertices, std::vector<std::uint32_t>& indices,
+	const std::vector<std::shared_ptr<IModel>>& models
+) const {
+	const size_t vertexCount = std::size(vertices);
+
+	if (std::ranges::any_of(indices, [vertexCount](std::uint32_t index) {
+		return index >= vertexCount;
+	}))
+		throw Exception("VertexCacheOptimiser Error", "An index is out of the vertex range.");
+
+	// Checked here, as the pool jobs can't throw.
+	const std::vector<IndexRange> ranges = GetModelRanges(indices, models);
+
+	OptimisationStats optimisationStats{
+		.before = GetCacheStats(indices, models), .after = {}
+	};
+
+	Gaia::RunJobs(
+		m_threadPool, std::size(ranges),
+		[&](size_t rangeIndex) {
+			const IndexRange& range = ranges[rangeIndex];
+			std::uint32_t* triangleIndices = std::data(indices) + range.indexOffset;
+
+			OptimiseModel(vertices, triangleIndices, range.indexCount / 3u);
+
+			if (m_optimiseOverdraw)
+				SortClusters(vertices, triangleIndices, range.indexCount / 3u);
+		}
+	);
+
+	// Doesn't change the cache hits, only how far apart the fetched vertices are.
+	if (m_reorderVertices)
+		ReorderVertices(vertices, indices);
+
+	optimisationStats.after = GetCacheStats(indices, models);
+
+	return optimisationStats;
+}
+
+// Tom Forsyth's "Linear-Speed Vertex Cache Optimisation". Each vertex is scored by where it
+// is in a simulated LRU cache and by how few triangles it has left, and the triangle with
+// the highest score next to the cache goes next.
+void VertexCacheOptimiser::OptimiseModel(
+	const std::vector<Vertex>& vertices, std::uint32_t* triangleIndices, size_t triangleCount
+) const {
+	static constexpr std::int32_t s_scoringCacheSize = 32;
+	static constexpr size_t s_noTriangle = std::numeric_limits<size_t>::max();
+
+	// Only the topology decides the order.
+	static_cast<void>(vertices);
+
+	std::vector<std::uint32_t> localIndices;
+	const size_t vertexCount = MakeLocalIndices(
+		triangleIndices, triangleCount * 3u, localIndices
+	);
+
+	auto getVertexScore = [](std::int32_t cachePosition, std::uint32_t trianglesLeft) noexcept {
+		if (trianglesLeft == 0u)
+			return -1.f;
+
+		float score = 0.f;
+
+		// The last triangle's vertices are all just as good, so none of them is preferred.
+		if (cachePosition >= 0)
+			score = cachePosition < 3 ? 0.75f : std::pow(
+				1.f - static_cast<float>(cachePosition - 3)
+				/ static_cast<float>(s_scoringCacheSize - 3), 1.5f
+			);
+
+		// The vertices with few triangles left are finished off, so they leave the cache.
+		return score + 2.f / std::sqrt(static_cast<float>(trianglesLeft));
+	};
+
+	std::vector<std::uint32_t> trianglesLeft(vertexCount, 0u);
+
+	for (std::uint32_t localIndex : localIndices)
+		++trianglesLeft[localIndex];
+
+	std::vector<size_t> adjacencyOffsets(vertexCount + 1u, 0u);
+
+	for (size_t vertex = 0u; vertex < vertexCount; ++vertex)
+		adjacencyOffsets[vertex + 1u] = adjacencyOffsets[vertex] + trianglesLeft[vertex];
+
+	// The triangles left of each vertex are kept at the start of its list.
+	std::vector<std::uint32_t> adjacentTriangles(std::size(localIndices));
+
+	{
+		std::vector<size_t> adjacencyEnds(vertexCount, 0u);
+
+		for (size_t index = 0u; index < std::size(localIndices); ++index) {
+			const std::uint32_t vertex = localIndices[index];
+
+			adjacentTriangles[adjacencyOffsets[vertex] + adjacencyEnds[vertex]++] =
+				static_cast<std::uint32_t>(index / 3u);
+		}
+	}
+
+	std::vector<std::int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount, 0.f);
+
+	for (size_t vertex = 0u; vertex < vertexCount; ++vertex)
+		vertexScores[vertex] = getVertexScore(-1, trianglesLeft[vertex]);
+
+	std::vector<float> triangleScores(triangleCount, 0.f);
+	size_t bestTriangle = s_noTriangle;
+
+	for (size_t triangle = 0u; triangle < triangleCount; ++triangle) {
+		for (size_t corner = 0u; corner < 3u; ++corner)
+			triangleScores[triangle] += vertexScores[localIndices[triangle * 3u + corner]];
+
+		if (bestTriangle == s_noTriangle
+			|| triangleScores[triangle] > triangleScores[bestTriangle])
+			bestTriangle = triangle;
+	}
+
+	std::vector<bool> emittedTriangles(triangleCount, false);
+	std::vector<std::uint32_t> cache;
+	std::vector<std::uint32_t> nextCache;
+	std::vector<std::uint32_t> orderedIndices;
+	orderedIndices.reserve(triangleCount * 3u);
+
+	size_t nextUnemitted = 0u;
+
+	for (size_t emittedCount = 0u; emittedCount < triangleCount; ++emittedCount) {
+		// Nothing next to the cache has triangles left, so it starts somewhere else.
+		if (bestTriangle == s_noTriangle) {
+			while (emittedTriangles[nextUnemitted])
+				++nextUnemitted;
+
+			bestTriangle = nextUnemitted;
+		}
+
+		emittedTriangles[bestTriangle] = true;
+
+		const std::uint32_t* corners = &localIndices[bestTriangle * 3u];
+		nextCache.clear();
+
+		for (size_t corner = 0u; corner < 3u; ++corner) {
+			const std::uint32_t vertex = corners[corner];
+
+			orderedIndices.emplace_back(triangleIndices[bestTriangle * 3u + corner]);
+
+			// Moves the triangle past the ones the vertex has left.
+			const size_t adjacencyStart = adjacencyOffsets[vertex];
+			const size_t lastLeft = adjacencyStart + trianglesLeft[vertex] - 1u;
+
+			for (size_t adjacency = adjacencyStart; adjacency <= lastLeft; ++adjacency)
+				if (adjacentTriangles[adjacency] == bestTriangle) {
+					std::swap(adjacentTriangles[adjacency], adjacentTriangles[lastLeft]);
+
+					break;
+				}
+
+			--trianglesLeft[vertex];
+
+			if (std::ranges::find(nextCache, vertex) == std::end(nextCache))
+				nextCache.emplace_back(vertex);
+		}
+
+		for (std::uint32_t vertex : cache)
+			if (std::ranges::find(nextCache, vertex) == std::end(nextCache))
+				nextCache.emplace_back(vertex);
+
+		std::swap(cache, nextCache);
+
+		// The evicted vertices lose their cache score as well.
+		for (size_t position = 0u; position < std::size(cache); ++position)
+			cachePositions[cache[position]] =
+				position < static_cast<size_t>(s_scoringCacheSize) ?
+				static_cast<std::int32_t>(position) : -1;
+
+		bestTriangle = s_noTriangle;
+
+		for (std::uint32_t vertex : cache) {
+			const float vertexScore = getVertexScore(cachePositions[vertex], trianglesLeft[vertex]);
+			const float scoreChange = vertexScore - vertexScores[vertex];
+
+			vertexScores[vertex] = vertexScore;
+
+			for (size_t adjacency = adjacencyOffsets[vertex];
+				adjacency < adjacencyOffsets[vertex] + trianglesLeft[vertex]; ++adjacency)
+				triangleScores[adjacentTriangles[adjacency]] += scoreChange;
+		}
+
+		for (std::uint32_t vertex : cache)
+			for (size_t adjacency = adjacencyOffsets[vertex];
+				adjacency < adjacencyOffsets[vertex] + trianglesLeft[vertex]; ++adjacency) {
+				const std::uint32_t triangle = adjacentTriangles[adjacency];
+
+				if (bestTriangle == s_noTriangle
+					|| triangleScores[triangle] > triangleScores[bestTriangle])
+					bestTriangle = triangle;
+			}
+
+		if (std::size(cache) > static_cast<size_t>(s_scoringCacheSize))
+			cache.resize(static_cast<size_t>(s_scoringCacheSize));
+	}
+
+	std::ranges::copy(orderedIndices, triangleIndices);
+}
+
+// A cut of "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw". The order
+// is split where a triangle misses the cache with all of its vertices, so moving the
+// clusters hardly costs any hits, and the clusters facing away from the centre go first.
+void VertexCacheOptimiser::SortClusters(
+	const std::vector<Vertex>& vertices, std::uint32_t* triangleIndices, size_t triangleCount
+) const {
+	struct Cluster {
+		size_t triangleStart;
+		size_t triangleEnd;
+		DirectX::XMFLOAT3 centroid;
+		DirectX::XMFLOAT3 normal;
+		float area;
+		float sortKey;
+	};
+
+	std::vector<Cluster> clusters;
+	std::vector<std::uint32_t> fifoCache;
+
+	for (size_t triangle = 0u; triangle < triangleCount; ++triangle) {
+		std::uint32_t misses = 0u;
+
+		for (size_t corner = 0u; corner < 3u; ++corner) {
+			const std::uint32_t vertex = triangleIndices[triangle * 3u + corner];
+
+			if (std::ranges::find(fifoCache, vertex) != std::end(fifoCache))
+				continue;
+
+			++misses;
+
+			if (std::size(fifoCache) == m_cacheSize)
+				fifoCache.erase(std::begin(fifoCache));
+
+			fifoCache.emplace_back(vertex);
+		}
+
+		if (std::empty(clusters) || misses == 3u)
+			clusters.emplace_back(
+				Cluster{
+					.triangleStart = triangle, .triangleEnd = triangle,
+					.centroid = {}, .normal = {}, .area = 0.f, .sortKey = 0.f
+				}
+			);
+
+		clusters.back().triangleEnd = triangle + 1u;
+	}
+
+	if (std::size(clusters) < 2u)
+		return;
+
+	DirectX::XMFLOAT3 meshCentroid{ 0.f, 0.f, 0.f };
+	float meshArea = 0.f;
+
+	for (Cluster& cluster : clusters) {
+		for (size_t triangle = cluster.triangleStart; triangle < cluster.triangleEnd;
+			++triangle) {
+			const DirectX::XMFLOAT3& position0 = vertices[triangleIndices[triangle * 3u]].position;
+			const DirectX::XMFLOAT3& position1 =
+				vertices[triangleIndices[triangle * 3u + 1u]].position;
+			const DirectX::XMFLOAT3& position2 =
+				vertices[triangleIndices[triangle * 3u + 2u]].position;
+
+			const DirectX::XMFLOAT3 edge0{
+				position1.x - position0.x, position1.y - position0.y, position1.z - position0.z
+			};
+			const DirectX::XMFLOAT3 edge1{
+				position2.x - position0.x, position2.y - position0.y, position2.z - position0.z
+			};
+			const DirectX::XMFLOAT3 normal{
+				edge0.y * edge1.z - edge0.z * edge1.y,
+				edge0.z * edge1.x - edge0.x * edge1.z,
+				edge0.x * edge1.y - edge0.y * edge1.x
+			};
+
+			const float area = std::sqrt(
+				normal.x * normal.x + normal.y * normal.y + normal.z * normal.z
+			);
+
+			cluster.centroid.x += (position0.x + position1.x + position2.x) * area;
+			cluster.centroid.y += (position0.y + position1.y + position2.y) * area;
+			cluster.centroid.z += (position0.z + position1.z + position2.z) * area;
+			cluster.normal.x += normal.x;
+			cluster.normal.y += normal.y;
+			cluster.normal.z += normal.z;
+			cluster.area += area;
+		}
+
+		meshCentroid.x += cluster.centroid.x;
+		meshCentroid.y += cluster.centroid.y;
+		meshCentroid.z += cluster.centroid.z;
+		meshArea += cluster.area;
+
+		if (cluster.area > 0.f) {
+			const float centroidScale = 1.f / (cluster.area * 3.f);
+
+			cluster.centroid.x *= centroidScale;
+			cluster.centroid.y *= centroidScale;
+			cluster.centroid.z *= centroidScale;
+		}
+	}
+
+	// Degenerate, so there's no outside to go by.
+	if (meshArea == 0.f)
+		return;
+
+	const float meshCentroidScale = 1.f / (meshArea * 3.f);
+
+	meshCentroid.x *= meshCentroidScale;
+	meshCentroid.y *= meshCentroidScale;
+	meshCentroid.z *= meshCentroidScale;
+
+	for (Cluster& cluster : clusters) {
+		const float normalLength = std::sqrt(
+			cluster.normal.x * cluster.normal.x + cluster.normal.y * cluster.normal.y
+			+ cluster.normal.z * cluster.normal.z
+		);
+
+		if (normalLength == 0.f)
+			continue;
+
+		cluster.sortKey = (
+			(cluster.centroid.x - meshCentroid.x) * cluster.normal.x
+			+ (cluster.centroid.y - meshCentroid.y) * cluster.normal.y
+			+ (cluster.centroid.z - meshCentroid.z) * cluster.normal.z
+		) / normalLength;
+	}
+
+	std::ranges::stable_sort(clusters, [](const Cluster& left, const Cluster& right) {
+		return left.sortKey > right.sortKey;
+	});
+
+	std::vector<std::uint32_t> sortedIndices;
+	sortedIndices.reserve(triangleCount * 3u);
+
+	for (const Cluster& cluster : clusters)
+		sortedIndices.insert(
+			std::end(sortedIndices), triangleIndices + cluster.triangleStart * 3u,
+			triangleIndices + cluster.triangleEnd * 3u
+		);
+
+	std::ranges::copy(sortedIndices, triangleIndices);
+}
+
+void VertexCacheOptimiser::ReorderVertices(
+	std::vector<Vertex>& vertices, std::vector<std::uint32_t>& indices
+) {
+	static constexpr std::uint32_t s_unused = std::numeric_limits<std::uint32_t>::max();
+
+	std::vector<std::uint32_t> newIndices(std::size(vertices), s_unused);
+	std::uint32_t nextIndex = 0u;
+
+	for (std::uint32_t& index : indices) {
+		if (newIndices[index] == s_unused)
+			newIndices[index] = nextIndex++;
+
+		index = newIndices[index];
+	}
+
+	// The unused vertices are kept at the end, so the vertex count doesn't change.
+	for (std::uint32_t& newIndex : newIndices)
+		if (newIndex == s_unused)
+			newIndex = nextIndex++;
+
+	std::vector<Vertex> reorderedVertices(std::size(vertices));
+
+	for (size_t index = 0u; index < std::size(vertices); ++index)
+		reorderedVertices[newIndices[index]] = vertices[index];
+
+	vertices = std::move(reorderedVertices);
+}
+
+VertexCacheOptimiser::CacheStats VertexCacheOptimiser::GetCacheStats(
+	const std::vector<std::uint32_t>& indices,
+	const std::vector<std::shared_ptr<IModel>>& models
+) const {
+	size_t misses = 0u;
+	size_t triangleCount = 0u;
+	size_t vertexCount = 0u;
+
+	std::vector<std::uint32_t> fifoCache;
+	std::vector<std::uint32_t> localIndices;
+
+	// Each model is a draw of its own, so its cache starts empty.
+	for (const IndexRange& range : GetModelRanges(indices, models)) {
+		const std::uint32_t* triangleIndices = std::data(indices) + range.indexOffset;
+
+		fifoCache.clear();
+
+		for (size_t index = 0u; index < range.indexCount; ++index) {
+			if (std::ranges::find(fifoCache, triangleIndices[index]) != std::end(fifoCache))
+				continue;
+
+			++misses;
+
+			if (std::size(fifoCache) == m_cacheSize)
+				fifoCache.erase(std::begin(fifoCache));
+
+			fifoCache.emplace_back(triangleIndices[index]);
+		}
+
+		triangleCount += range.indexCount / 3u;
+		vertexCount += MakeLocalIndices(triangleIndices, range.indexCount, localIndices);
+	}
+
+	if (triangleCount == 0u)
+		return CacheStats{ .acmr = 0.f, .atvr = 0.f };
+
+	return CacheStats{
+		.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount),
+		.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount)
+	};
+}
@@ -0,0 +1,287 @@
+#include <VertexPacker.hpp>
+#include <JobRunner.hpp>
+#include <Exception.hpp>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace {
+	[[nodiscard]]
+	bool AreBoundsEqual(const ModelBounds& bounds1, const ModelBounds& bounds2) noexcept {
+		return bounds1.positiveAxes.x == bounds2.positiveAxes.x
+			&& bounds1.positiveAxes.y == bounds2.positiveAxes.y
+			&& bounds1.positiveAxes.z == bounds2.positiveAxes.z
+			&& bounds1.negativeAxes.x == bounds2.negativeAxes.x
+			&& bounds1.negativeAxes.y == bounds2.negativeAxes.y
+			&& bounds1.negativeAxes.z == bounds2.negativeAxes.z;
+	}
+
+	[[nodiscard]]
+	std::uint16_t QuantiseUNorm(float value, float axis1, float axis2) noexcept {
+		const float minimum = std::min(axis1, axis2);
+		const float extent = std::max(axis1, axis2) - minimum;
+
+		// A flat box only has the one value on that axis.
+		if (extent <= 0.f)
+			return 0u;
+
+		const float unorm = std::clamp((value - minimum) / extent, 0.f, 1.f);
+
+		return static_cast<std::uint16_t>(std::lround(unorm * 65535.f));
+	}
+
+	[[nodiscard]]
+	float DequantiseUNorm(std::uint16_t value, float axis1, float axis2) noexcept {
+		const float minimum = std::min(axis1, axis2);
+		const float extent = std::max(axis1, axis2) - minimum;
+
+		return minimum + static_cast<float>(value) / 65535.f * extent;
+	}
+
+	[[nodiscard]]
+	std::int16_t QuantiseSNorm(float value) noexcept {
+		return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.f, 1.f) * 32767.f));
+	}
+
+	[[nodiscard]]
+	float DequantiseSNorm(std::int16_t value) noexcept {
+		return std::max(static_cast<float>(value) / 32767.f, -1.f);
+	}
+
+	[[nodiscard]]
+	float SignNotZero(float value) noexcept {
+		return value >= 0.f ? 1.f : -1.f;
+	}
+}
+
+VertexPacker::VertexPacker(const Args& arguments) : m_threadPool{ arguments.threadPool.value() } {}
+
+VertexPacker::VertexBounds VertexPacker::GetVertexBounds(
+	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+	const std::vector<std::shared_ptr<IModel>>& models
+) {
+	static constexpr std::uint32_t s_noBounds = std::numeric_limits<std::uint32_t>::max();
+
+	const size_t vertexCount = std::size(vertices);
+
+	if (std::ranges::any_of(indices, [vertexCount](std::uint32_t index) {
+		return index >= vertexCount;
+	}))
+		throw Exception("VertexPacker Error", "An index is out of the vertex range.");
+
+	VertexBounds vertexBounds{};
+	vertexBounds.bounds.reserve(std::size(models) + 1u);
+	vertexBounds.boundsIndices.resize(vertexCount, s_noBounds);
+
+	for (const std::shared_ptr<IModel>& model : models) {
+		const size_t indexStart = model->GetIndexOffset();
+		const size_t indexEnd = indexStart + model->GetIndexCount();
+
+		if (indexEnd > std::size(indices))
+			throw Exception("VertexPacker Error", "A model's indices are out of range.");
+
+		const ModelBounds bounds = model->GetBoundingBox();
+		const auto boundsIndex = static_cast<std::uint32_t>(std::size(vertexBounds.bounds));
+
+		vertexBounds.bounds.emplace_back(bounds);
+
+		for (size_t index = indexStart; index < indexEnd; ++index) {
+			std::uint32_t& vertexBoundsIndex = vertexBounds.boundsIndices[indices[index]];
+
+			if (vertexBoundsIndex == s_noBounds)
+				vertexBoundsIndex = boundsIndex;
+			else if (!AreBoundsEqual(vertexBounds.bounds[vertexBoundsIndex], bounds))
+				throw Exception(
+					"VertexPacker Error", "A vertex is shared by models with different bounds."
+				);
+		}
+	}
+
+	ModelBounds vertexRange{
+		.positiveAxes = { 0.f, 0.f, 0.f }, .negativeAxes = { 0.f, 0.f, 0.f }
+	};
+
+	if (!std::empty(vertices)) {
+		vertexRange.positiveAxes = vertices.front().position;
+		vertexRange.negativeAxes = vertices.front().position;
+	}
+
+	for (const Vertex& vertex : vertices) {
+		vertexRange.positiveAxes.x = std::max(vertexRange.positiveAxes.x, vertex.position.x);
+		vertexRange.positiveAxes.y = std::max(vertexRange.positiveAxes.y, vertex.position.y);
+		vertexRange.positiveAxes.z = std::max(vertexRange.positiveAxes.z, vertex.position.z);
+		vertexRange.negativeAxes.x = std::min(vertexRange.negativeAxes.x, vertex.position.x);
+		vertexRange.negativeAxes.y = std::min(vertexRange.negativeAxes.y, vertex.position.y);
+		vertexRange.negativeAxes.z = std::min(vertexRange.negativeAxes.z, vertex.position.z);
+	}
+
+	const auto vertexRangeIndex = static_cast<std::uint32_t>(std::size(vertexBounds.bounds));
+	vertexBounds.bounds.emplace_back(vertexRange);
+
+	for (std::uint32_t& boundsIndex : vertexBounds.boundsIndices)
+		if (boundsIndex == s_noBounds)
+			boundsIndex = vertexRangeIndex;
+
+	return vertexBounds;
+}
+
+std::vector<PackedVertex> VertexPacker::PackVertices(
+	const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+	const std::vector<std::shared_ptr<IModel>>& models
+) const {
+	static constexpr size_t s_verticesPerJob = 4096u;
+
+	// Checked here, as the pool jobs can't throw.
+	const VertexBounds vertexBounds = GetVertexBounds(vertices, indices, models);
+
+	const size_t vertexCount = std::size(vertices);
+	std::vector<PackedVertex> packedVertices(vertexCount);
+
+	Gaia::RunJobs(
+		m_threadPool, (vertexCount + s_verticesPerJob - 1u) / s_verticesPerJob,
+		[&](size_t jobIndex) {
+			const size_t vertexEnd = std::min((jobIndex + 1u) * s_verticesPerJob, vertexCount);
+
+			for (size_t index = jobIndex * s_verticesPerJob; index < vertexEnd; ++index)
+				packedVertices[index] = PackVertex(
+					vertices[index], vertexBounds.bounds[vertexBounds.boundsIndices[index]]
+				);
+		}
+	);
+
+	return packedVertices;
+}
+
+VertexPacker::PackingError VertexPacker::GetPackingError(
+	const std::vector<Vertex>& vertices, const std::vector<PackedVertex>& packedVertices,
+	const std::vector<std::uint32_t>& indices,
+	const std::vector<std::shared_ptr<IModel>>& models
+) const {
+	if (std::size(packedVertices) != std::size(vertices))
+		throw Exception("VertexPacker Error", "The packed vertices don't match the vertices.");
+
+	const VertexBounds vertexBounds = GetVertexBounds(vertices, indices, models);
+
+	PackingError packingError{ .maxPositionError = 0.f, .maxNormalError = 0.f, .maxUVError = 0.f };
+
+	for (size_t index = 0u; index < std::size(vertices); ++index) {
+		const Vertex& vertex = vertices[index];
+		const Vertex unpackedVertex = UnpackVertex(
+			packedVertices[index], vertexBounds.bounds[vertexBounds.boundsIndices[index]]
+		);
+
+		packingError.maxPositionError = std::max({
+			packingError.maxPositionError,
+			std::abs(unpackedVertex.position.x - vertex.position.x),
+			std::abs(unpackedVertex.position.y - vertex.position.y),
+			std::abs(unpackedVertex.position.z - vertex.position.z)
+		});
+
+		packingError.maxUVError = std::max({
+			packingError.maxUVError,
+			std::abs(unpackedVertex.uv.x - vertex.uv.x),
+			std::abs(unpackedVertex.uv.y - vertex.uv.y)
+		});
+
+		const float normalLength = std::sqrt(
+			vertex.normal.x * vertex.normal.x + vertex.normal.y * vertex.normal.y
+			+ vertex.normal.z * vertex.normal.z
+		);
+
+		// A zero normal has no direction to keep.
+		if (normalLength == 0.f)
+			continue;
+
+		const float normalDot = (
+			unpackedVertex.normal.x * vertex.normal.x + unpackedVertex.normal.y * vertex.normal.y
+			+ unpackedVertex.normal.z * vertex.normal.z
+		) / normalLength;
+
+		packingError.maxNormalError = std::max(
+			packingError.maxNormalError,
+			DirectX::XMConvertToDegrees(std::acos(std::clamp(normalDot, -1.f, 1.f)))
+		);
+	}
+
+	return packingError;
+}
+
+PackedVertex VertexPacker::PackVertex(const Vertex& vertex, const ModelBounds& bounds) noexcept {
+	PackedVertex packedVertex{};
+
+	packedVertex.position.x = QuantiseUNorm(
+		vertex.position.x, bounds.positiveAxes.x, bounds.negativeAxes.x
+	);
+	packedVertex.position.y = QuantiseUNorm(
+		vertex.position.y, bounds.positiveAxes.y, bounds.negativeAxes.y
+	);
+	packedVertex.position.z = QuantiseUNorm(
+		vertex.position.z, bounds.positiveAxes.z, bounds.negativeAxes.z
+	);
+	packedVertex.position.w = 0u;
+
+	// Projected onto an octahedron, whose lower half is folded over the upper one.
+	const DirectX::XMFLOAT3& normal = vertex.normal;
+	const float normalL1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+
+	float octahedralX = 0.f;
+	float octahedralY = 0.f;
+
+	if (normalL1 > 0.f) {
+		octahedralX = normal.x / normalL1;
+		octahedralY = normal.y / normalL1;
+
+		if (normal.z < 0.f) {
+			const float foldedX = (1.f - std::abs(octahedralY)) * SignNotZero(octahedralX);
+
+			octahedralY = (1.f - std::abs(octahedralX)) * SignNotZero(octahedralY);
+			octahedralX = foldedX;
+		}
+	}
+
+	packedVertex.normal.x = QuantiseSNorm(octahedralX);
+	packedVertex.normal.y = QuantiseSNorm(octahedralY);
+
+	packedVertex.uv.x = DirectX::PackedVector::XMConvertFloatToHalf(vertex.uv.x);
+	packedVertex.uv.y = DirectX::PackedVector::XMConvertFloatToHalf(vertex.uv.y);
+
+	return packedVertex;
+}
+
+Vertex VertexPacker::UnpackVertex(
+	const PackedVertex& packedVertex, const ModelBounds& bounds
+) noexcept {
+	Vertex vertex{};
+
+	vertex.position.x = DequantiseUNorm(
+		packedVertex.position.x, bounds.positiveAxes.x, bounds.negativeAxes.x
+	);
+	vertex.position.y = DequantiseUNorm(
+		packedVertex.position.y, bounds.positiveAxes.y, bounds.negativeAxes.y
+	);
+	vertex.position.z = DequantiseUNorm(
+		packedVertex.position.z, bounds.positiveAxes.z, bounds.negativeAxes.z
+	);
+
+	float normalX = DequantiseSNorm(packedVertex.normal.x);
+	float normalY = DequantiseSNorm(packedVertex.normal.y);
+	const float normalZ = 1.f - std::abs(normalX) - std::abs(normalY);
+
+	if (normalZ < 0.f) {
+		const float unfoldedX = (1.f - std::abs(normalY)) * SignNotZero(normalX);
+
+		normalY = (1.f - std::abs(normalX)) * SignNotZero(normalY);
+		normalX = unfoldedX;
+	}
+
+	const float normalLength = std::sqrt(normalX * normalX + normalY * normalY + normalZ * normalZ);
+
+	vertex.normal = DirectX::XMFLOAT3{
+		normalX / normalLength, normalY / normalLength, normalZ / normalLength
+	};
+
+	vertex.uv.x = DirectX::PackedVector::XMConvertHalfToFloat(packedVertex.uv.x);
+	vertex.uv.y = DirectX::PackedVector::XMConvertHalfToFloat(packedVertex.uv.y);
+
+	return vertex;
+}
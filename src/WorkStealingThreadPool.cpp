@@ -0,0 +1,471 @@
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+#include <WorkStealingThreadPool.hpp>
+#include <thread>
+#include <algorithm>
+
+// JobCounter
+JobCounter::JobCounter() noexcept : m_count{ 0u } {}
+
+bool JobCounter::IsDone() const noexcept {
+	return m_count.load(std::memory_order_acquire) == 0u;
+}
+
+void JobCounter::Increment() noexcept {
+	m_count.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void JobCounter::Decrement() noexcept {
+	if (m_count.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+		m_count.notify_all();
+}
+
+void JobCounter::StoreException(std::exception_ptr exception) noexcept {
+	std::lock_guard lock{ m_exceptionMutex };
+
+	if (!m_exception)
+		m_exception = std::move(exception);
+}
+
+void JobCounter::RethrowException() const {
+	std::lock_guard lock{ m_exceptionMutex };
+
+	if (m_exception)
+		std::rethrow_exception(m_exception);
+}
+
+// Job
+Job::Job() noexcept
+	: m_storage{}, m_invoke{ nullptr }, m_move{ nullptr }, m_destroy{ nullptr },
+	m_counter{ nullptr } {}
+
+Job::~Job() noexcept {
+	Reset();
+}
+
+Job::Job(Job&& other) noexcept
+	: m_invoke{ other.m_invoke }, m_move{ other.m_move }, m_destroy{ other.m_destroy },
+	m_counter{ other.m_counter } {
+
+	if (m_move)
+		m_move(m_storage, other.m_storage);
+
+	other.m_invoke = nullptr;
+	other.m_move = nullptr;
+	other.m_destroy = nullptr;
+	other.m_counter = nullptr;
+}
+
+Job& Job::operator=(Job&& other) noexcept {
+	if (this != &other) {
+		Reset();
+
+		m_invoke = other.m_invoke;
+		m_move = other.m_move;
+		m_destroy = other.m_destroy;
+		m_counter = other.m_counter;
+
+		if (m_move)
+			m_move(m_storage, other.m_storage);
+
+		other.m_invoke = nullptr;
+		other.m_move = nullptr;
+		other.m_destroy = nullptr;
+		other.m_counter = nullptr;
+	}
+
+	return *this;
+}
+
+void Job::Reset() noexcept {
+	if (m_destroy)
+		m_destroy(m_storage);
+
+	m_invoke = nullptr;
+	m_move = nullptr;
+	m_destroy = nullptr;
+	m_counter = nullptr;
+}
+
+void Job::Run() {
+	JobCounter* counter = m_counter;
+	std::exception_ptr exception{};
+
+	// The waiter would never wake up if the counter wasn't decremented.
+	try {
+		m_invoke(m_storage);
+	}
+	catch (...) {
+		exception = std::current_exception();
+	}
+
+	Reset();
+
+	if (!counter) {
+		if (exception)
+			std::rethrow_exception(exception);
+
+		return;
+	}
+
+	if (exception)
+		counter->StoreException(std::move(exception));
+
+	counter->Decrement();
+}
+
+bool Job::IsEmpty() const noexcept {
+	return m_invoke == nullptr;
+}
+
+JobCounter* Job::GetCounter() const noexcept {
+	return m_counter;
+}
+
+// Chase-Lev deque with a fixed capacity. Only the owner pushes and pops at the bottom, the
+// thieves take from the top. A slot is only reused after its job has been moved out, so a
+// thief never reads a slot the owner is writing.
+class ChaseLevDeque {
+public:
+	ChaseLevDeque()
+		: m_top{ 0 }, m_bottom{ 0 }, m_slots{ std::make_unique<Slot[]>(s_capacity) } {}
+
+	[[nodiscard]]
+	bool Push(Job&& job) noexcept {
+		const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const std::int64_t top = m_top.load(std::memory_order_acquire);
+
+		if (bottom - top >= s_capacity)
+			return false;
+
+		Slot& slot = GetSlot(bottom);
+
+		if (slot.occupied.load(std::memory_order_acquire))
+			return false;
+
+		slot.job = std::move(job);
+		slot.occupied.store(true, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	[[nodiscard]]
+	bool Pop(Job& job) noexcept {
+		const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return false;
+		}
+
+		// The last job can be stolen at the same time.
+		if (top == bottom) {
+			const bool won = m_top.compare_exchange_strong(
+				top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+			);
+
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			if (!won)
+				return false;
+		}
+
+		TakeJob(GetSlot(bottom), job);
+
+		return true;
+	}
+
+	[[nodiscard]]
+	bool Steal(Job& job) noexcept {
+		std::int64_t top = m_top.load(std::memory_order_acquire);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return false;
+
+		if (!m_top.compare_exchange_strong(
+			top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+		))
+			return false;
+
+		TakeJob(GetSlot(top), job);
+
+		return true;
+	}
+
+private:
+	struct Slot {
+		Job job;
+		std::atomic_bool occupied{ false };
+	};
+
+private:
+	[[nodiscard]]
+	Slot& GetSlot(std::int64_t index) const noexcept {
+		return m_slots[static_cast<size_t>(index) & (s_capacity - 1u)];
+	}
+
+	static void TakeJob(Slot& slot, Job& job) noexcept {
+		job = std::move(slot.job);
+		slot.occupied.store(false, std::memory_order_release);
+	}
+
+private:
+	static constexpr std::int64_t s_capacity = 512;
+
+	alignas(64) std::atomic_int64_t m_top;
+	alignas(64) std::atomic_int64_t m_bottom;
+	std::unique_ptr<Slot[]> m_slots;
+};
+
+// WorkStealingThreadPool
+struct WorkStealingThreadPool::Worker {
+	ChaseLevDeque deque;
+	std::thread thread;
+};
+
+static thread_local WorkStealingThreadPool const* s_currentPool = nullptr;
+static thread_local size_t s_currentWorkerIndex = 0u;
+
+WorkStealingThreadPool::WorkStealingThreadPool(const Args& arguments)
+	: m_injectedJobs(64u), m_injectedFront{ 0u }, m_injectedCount{ 0u }, m_wakeEpoch{ 0u },
+	m_sleepingWorkers{ 0u }, m_stopping{ false } {
+
+	size_t workerCount = arguments.workerCount.value();
+
+	if (workerCount == 0u)
+		workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+
+	// The deques must exist before any worker starts stealing.
+	for (size_t index = 0u; index < workerCount; ++index)
+		m_workers.emplace_back(std::make_unique<Worker>());
+
+	for (size_t index = 0u; index < workerCount; ++index) {
+		std::thread& thread = m_workers[index]->thread;
+
+		thread = std::thread{ &WorkStealingThreadPool::WorkerLoop, this, index };
+
+#ifdef _WIN32
+		if (arguments.pinThreads.value())
+			SetThreadAffinityMask(
+				thread.native_handle(), DWORD_PTR{ 1u } << (index % (sizeof(DWORD_PTR) * 8u))
+			);
+#endif
+	}
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() noexcept {
+	// The workers finish the queued jobs first.
+	m_stopping.store(true, std::memory_order_release);
+	m_wakeEpoch.fetch_add(1u);
+	m_wakeEpoch.notify_all();
+
+	for (std::unique_ptr<Worker>& worker : m_workers)
+		worker->thread.join();
+}
+
+void WorkStealingThreadPool::SubmitWork(std::function<void()> workFunction) {
+	Push(Job{ std::move(workFunction), nullptr });
+}
+
+void WorkStealingThreadPool::Push(Job&& job) {
+	if (JobCounter* counter = job.GetCounter())
+		counter->Increment();
+
+	std::optional<size_t> workerIndex = GetCurrentWorkerIndex();
+
+	if (workerIndex) {
+		// A full deque runs the job straight away instead of growing.
+		if (!m_workers[*workerIndex]->deque.Push(std::move(job)))
+			RunJob(job);
+	}
+	else {
+		std::lock_guard lock{ m_injectedJobsMutex };
+
+		const size_t capacity = std::size(m_injectedJobs);
+		const size_t count = m_injectedCount.load(std::memory_order_relaxed);
+
+		if (count == capacity) {
+			std::vector<Job> injectedJobs(capacity * 2u);
+
+			for (size_t index = 0u; index < count; ++index)
+				injectedJobs[index] = std::move(
+					m_injectedJobs[(m_injectedFront + index) % capacity]
+				);
+
+			m_injectedJobs = std::move(injectedJobs);
+			m_injectedFront = 0u;
+		}
+
+		m_injectedJobs[(m_injectedFront + count) % std::size(m_injectedJobs)] = std::move(job);
+		m_injectedCount.store(count + 1u, std::memory_order_release);
+	}
+
+	WakeWorker();
+}
+
+void WorkStealingThreadPool::RunJob(Job& job) noexcept {
+	// Nothing waits on a job without a counter, so its exception is kept for later instead of
+	// leaving the worker.
+	try {
+		job.Run();
+	}
+	catch (...) {
+		std::lock_guard lock{ m_uncountedExceptionMutex };
+
+		if (!m_uncountedException)
+			m_uncountedException = std::current_exception();
+	}
+}
+
+void WorkStealingThreadPool::RethrowUncountedException() {
+	std::exception_ptr exception{};
+
+	{
+		std::lock_guard lock{ m_uncountedExceptionMutex };
+
+		std::swap(exception, m_uncountedException);
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+void WorkStealingThreadPool::WakeWorker() noexcept {
+	m_wakeEpoch.fetch_add(1u);
+
+	if (m_sleepingWorkers.load() != 0u)
+		m_wakeEpoch.notify_one();
+}
+
+bool WorkStealingThreadPool::PopInjectedJob(Job& job) {
+	if (m_injectedCount.load(std::memory_order_acquire) == 0u)
+		return false;
+
+	std::lock_guard lock{ m_injectedJobsMutex };
+
+	const size_t count = m_injectedCount.load(std::memory_order_relaxed);
+
+	if (count == 0u)
+		return false;
+
+	job = std::move(m_injectedJobs[m_injectedFront]);
+	m_injectedFront = (m_injectedFront + 1u) % std::size(m_injectedJobs);
+	m_injectedCount.store(count - 1u, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool WorkStealingThreadPool::FindJob(std::optional<size_t> workerIndex, Job& job) {
+	if (workerIndex && m_workers[*workerIndex]->deque.Pop(job))
+		return true;
+
+	if (PopInjectedJob(job))
+		return true;
+
+	const size_t workerCount = std::size(m_workers);
+	const size_t firstVictim = workerIndex ? *workerIndex + 1u : 0u;
+
+	for (size_t offset = 0u; offset < workerCount; ++offset) {
+		const size_t victimIndex = (firstVictim + offset) % workerCount;
+
+		if (workerIndex && victimIndex == *workerIndex)
+			continue;
+
+		if (m_workers[victimIndex]->deque.Steal(job))
+			return true;
+	}
+
+	return false;
+}
+
+void WorkStealingThreadPool::WorkerLoop(size_t workerIndex) {
+	s_currentPool = this;
+	s_currentWorkerIndex = workerIndex;
+
+	Job job;
+
+	while (true) {
+		if (FindJob(workerIndex, job)) {
+			RunJob(job);
+
+			continue;
+		}
+
+		// A push after the epoch is read changes it, so the wait returns straight away.
+		const std::uint32_t wakeEpoch = m_wakeEpoch.load();
+
+		if (FindJob(workerIndex, job)) {
+			RunJob(job);
+
+			continue;
+		}
+
+		if (m_stopping.load(std::memory_order_acquire))
+			break;
+
+		m_sleepingWorkers.fetch_add(1u);
+		m_wakeEpoch.wait(wakeEpoch);
+		m_sleepingWorkers.fetch_sub(1u);
+	}
+}
+
+void WorkStealingThreadPool::WaitAndHelp(const JobCounter& counter) {
+	const std::optional<size_t> workerIndex = GetCurrentWorkerIndex();
+
+	Job job;
+
+	while (!counter.IsDone()) {
+		if (FindJob(workerIndex, job)) {
+			RunJob(job);
+
+			continue;
+		}
+
+		const std::uint32_t count = counter.m_count.load(std::memory_order_acquire);
+
+		if (count == 0u)
+			break;
+
+		// The rest are already running elsewhere.
+		counter.m_count.wait(count, std::memory_order_acquire);
+	}
+
+	counter.RethrowException();
+}
+
+void WorkStealingThreadPool::Wait(const JobCounter& counter) const {
+	std::uint32_t count = counter.m_count.load(std::memory_order_acquire);
+
+	while (count != 0u) {
+		counter.m_count.wait(count, std::memory_order_acquire);
+		count = counter.m_count.load(std::memory_order_acquire);
+	}
+
+	counter.RethrowException();
+}
+
+size_t WorkStealingThreadPool::GetWorkerCount() const noexcept {
+	return std::size(m_workers);
+}
+
+std::optional<size_t> WorkStealingThreadPool::GetCurrentWorkerIndex() const noexcept {
+	if (s_currentPool != this)
+		return {};
+
+	return s_currentWorkerIndex;
+}
@@ -1,89 +1,130 @@
-#ifndef I_MODEL_HPP_
-#define I_MODEL_HPP_
-#include <cstdint>
-#include <memory>
-#include <vector>
-
-#include <DirectXMath.h>
-
-struct UVInfo {
-	float uOffset;
-	float vOffset;
-	float uRatio;
-	float vRatio;
-};
-
-struct ModelBounds {
-	DirectX::XMFLOAT3 positiveAxes;
-	DirectX::XMFLOAT3 negativeAxes;
-};
-
-struct Vertex {
-	DirectX::XMFLOAT3 position;
-	DirectX::XMFLOAT3 normal;
-	DirectX::XMFLOAT2 uv;
-};
-
-struct Material {
-	DirectX::XMFLOAT4 ambient;
-	DirectX::XMFLOAT4 diffuse;
-	DirectX::XMFLOAT4 specular;
-	float shininess = 1.f;
-};
-
-class IModel {
-public:
-	virtual ~IModel() = default;
-
-	[[nodiscard]]
-	virtual std::uint32_t GetIndexCount() const noexcept = 0;
-	[[nodiscard]]
-	virtual std::uint32_t GetIndexOffset() const noexcept = 0;
-	[[nodiscard]]
-	virtual std::uint32_t GetDiffuseTexIndex() const noexcept = 0;
-	[[nodiscard]]
-	virtual UVInfo GetDiffuseTexUVInfo() const noexcept = 0;
-	[[nodiscard]]
-	virtual std::uint32_t GetSpecularTexIndex() const noexcept = 0;
-	[[nodiscard]]
-	virtual UVInfo GetSpecularTexUVInfo() const noexcept = 0;
-	[[nodiscard]]
-	virtual DirectX::XMMATRIX GetModelMatrix() const noexcept = 0;
-	[[nodiscard]]
-	virtual DirectX::XMFLOAT3 GetModelOffset() const noexcept = 0;
-	[[nodiscard]]
-	virtual ModelBounds GetBoundingBox() const noexcept = 0;
-	[[nodiscard]]
-	virtual Material GetMaterial() const noexcept = 0;
-	[[nodiscard]]
-	virtual bool IsLightSource() const noexcept = 0;
-};
-
-struct Meshlet {
-	std::uint32_t vertexCount;
-	std::uint32_t vertexOffset;
-	std::uint32_t primitiveCount;
-	std::uint32_t primitiveOffset;
-};
-
-struct MeshletModel {
-	MeshletModel() = default;
-	MeshletModel(const MeshletModel&) = delete;
-
-	inline MeshletModel(std::shared_ptr<IModel> model, std::vector<Meshlet> meshlets) noexcept
-		: model{ std::move(model) }, meshlets{ std::move(meshlets) } {}
-	inline MeshletModel(MeshletModel&& other) noexcept
-		: model(std::move(other.model)), meshlets(std::move(other.meshlets)) {}
-
-	MeshletModel& operator=(const MeshletModel&) = delete;
-	inline MeshletModel& operator=(MeshletModel&& other) noexcept {
-		model = std::move(other.model);
-		meshlets = std::move(other.meshlets);
-
-		return *this;
-	}
-
-	std::shared_ptr<IModel> model;
-	std::vector<Meshlet> meshlets;
-};
-#endif
+#ifndef I_MODEL_HPP_
+#define I_MODEL_HPP_
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+struct UVInfo {
+	float uOffset;
+	float vOffset;
+	float uRatio;
+	float vRatio;
+};
+
+struct ModelBounds {
+	DirectX::XMFLOAT3 positiveAxes;
+	DirectX::XMFLOAT3 negativeAxes;
+};
+
+struct Vertex {
+	DirectX::XMFLOAT3 position;
+	DirectX::XMFLOAT3 normal;
+	DirectX::XMFLOAT2 uv;
+};
+
+// Decoded by the vertex shaders, the position is from the bounding box's smaller corner to its
+// larger one and the fourth component is unused. The normal is octahedral encoded.
+struct PackedVertex {
+	DirectX::PackedVector::XMUSHORTN4 position;
+	DirectX::PackedVector::XMSHORTN2 normal;
+	DirectX::PackedVector::XMHALF2 uv;
+};
+
+// The packed format needs the bounding boxes in the model data, which the vertex shaders
+// decode the positions with. The mesh shaders only read full vertices.
+enum class VertexFormat {
+	Full,
+	Packed
+};
+
+// Where a set of model inputs was placed. The indices are rebased onto the shared vertex
+// buffer, so the index offsets of the models using them start at indexOffset.
+struct ModelInputRange {
+	size_t inputId;
+	std::uint32_t indexOffset;
+};
+
+struct Material {
+	DirectX::XMFLOAT4 ambient;
+	DirectX::XMFLOAT4 diffuse;
+	DirectX::XMFLOAT4 specular;
+	float shininess = 1.f;
+};
+
+class IModel {
+public:
+	virtual ~IModel() = default;
+
+	[[nodiscard]]
+	virtual std::uint32_t GetIndexCount() const noexcept = 0;
+	[[nodiscard]]
+	virtual std::uint32_t GetIndexOffset() const noexcept = 0;
+	[[nodiscard]]
+	virtual std::uint32_t GetDiffuseTexIndex() const noexcept = 0;
+	[[nodiscard]]
+	virtual UVInfo GetDiffuseTexUVInfo() const noexcept = 0;
+	[[nodiscard]]
+	virtual std::uint32_t GetSpecularTexIndex() const noexcept = 0;
+	[[nodiscard]]
+	virtual UVInfo GetSpecularTexUVInfo() const noexcept = 0;
+	[[nodiscard]]
+	virtual DirectX::XMMATRIX GetModelMatrix() const noexcept = 0;
+	[[nodiscard]]
+	virtual DirectX::XMFLOAT3 GetModelOffset() const noexcept = 0;
+	[[nodiscard]]
+	virtual ModelBounds GetBoundingBox() const noexcept = 0;
+	[[nodiscard]]
+	virtual Material GetMaterial() const noexcept = 0;
+	[[nodiscard]]
+	virtual bool IsLightSource() const noexcept = 0;
+
+	// Optional dirty tracking. A version of 0 means untracked and the data is written
+	// every frame. Otherwise it is only written again after the version changes.
+	[[nodiscard]]
+	virtual std::uint64_t GetModelVersion() const noexcept { return 0u; }
+	[[nodiscard]]
+	virtual std::uint64_t GetMaterialVersion() const noexcept { return 0u; }
+};
+
+struct Meshlet {
+	std::uint32_t vertexCount;
+	std::uint32_t vertexOffset;
+	std::uint32_t primitiveCount;
+	std::uint32_t primitiveOffset;
+};
+
+// In the model's space. A meshlet whose triangles all face away from a camera inside the
+// cone can be culled. The cutoff is above 1 when the normals are too spread for a cone.
+struct MeshletBounds {
+	DirectX::XMFLOAT3 sphereCentre;
+	float sphereRadius;
+	DirectX::XMFLOAT3 coneApex;
+	float coneCutoff;
+	DirectX::XMFLOAT3 coneAxis;
+	float padding;
+};
+
+struct MeshletModel {
+	MeshletModel() = default;
+	MeshletModel(const MeshletModel&) = delete;
+
+	inline MeshletModel(std::shared_ptr<IModel> model, std::vector<Meshlet> meshlets) noexcept
+		: model{ std::move(model) }, meshlets{ std::move(meshlets) } {}
+	inline MeshletModel(MeshletModel&& other) noexcept
+		: model(std::move(other.model)), meshlets(std::move(other.meshlets)) {}
+
+	MeshletModel& operator=(const MeshletModel&) = delete;
+	inline MeshletModel& operator=(MeshletModel&& other) noexcept {
+		model = std::move(other.model);
+		meshlets = std::move(other.meshlets);
+
+		return *this;
+	}
+
+	std::shared_ptr<IModel> model;
+	std::vector<Meshlet> meshlets;
+};
+#endif
@@ -0,0 +1,140 @@
+#ifndef MODEL_TRANSFORM_STORE_HPP_
+#define MODEL_TRANSFORM_STORE_HPP_
+#include <cstdint>
+#include <vector>
+
+#include <DirectXMath.h>
+#include <IModel.hpp>
+
+// Has the same layout as the per model material data in the GPU buffer.
+struct ModelMaterial {
+	DirectX::XMFLOAT4 ambient;
+	DirectX::XMFLOAT4 diffuse;
+	DirectX::XMFLOAT4 specular;
+	UVInfo diffuseTexUVInfo;
+	UVInfo specularTexUVInfo;
+	std::uint32_t diffuseTexIndex;
+	std::uint32_t specularTexIndex;
+	float shininess;
+};
+
+// Per model data as a structure of arrays, indexed by model id. Ids follow the order the
+// models were added in, the ids of removed models are reused later on. Write only between
+// frames, never during Renderer::Update.
+// IModel is re-read only while its version is 0 or has changed, so a model reporting a
+// constant non-zero version can be driven entirely through this store.
+class ModelTransformStore {
+public:
+	inline ModelTransformStore(std::uint32_t frameCount) noexcept
+		: m_allFramesMask{ static_cast<std::uint32_t>((1ull << frameCount) - 1u) } {}
+
+	inline size_t AddModel() noexcept {
+		const size_t modelId = std::size(m_modelMatrices);
+
+		m_modelMatrices.emplace_back();
+		m_modelOffsets.emplace_back();
+		m_boundingBoxes.emplace_back();
+		m_materials.emplace_back();
+		m_transformDirtyFrames.emplace_back(m_allFramesMask);
+		m_materialDirtyFrames.emplace_back(m_allFramesMask);
+		m_transformVersions.emplace_back(0u);
+		m_activeModels.emplace_back(1u);
+
+		return modelId;
+	}
+
+	// Inactive models are left out of the spatial queries.
+	inline void SetModelActive(size_t modelId, bool active) noexcept {
+		m_activeModels[modelId] = active ? 1u : 0u;
+		MarkTransformDirty(modelId);
+		MarkMaterialDirty(modelId);
+	}
+
+	inline void SetModelMatrix(size_t modelId, const DirectX::XMMATRIX& modelMatrix) noexcept {
+		DirectX::XMStoreFloat4x4(&m_modelMatrices[modelId], modelMatrix);
+		MarkTransformDirty(modelId);
+	}
+	inline void SetModelOffset(size_t modelId, const DirectX::XMFLOAT3& modelOffset) noexcept {
+		m_modelOffsets[modelId] = modelOffset;
+		MarkTransformDirty(modelId);
+	}
+	inline void SetBoundingBox(size_t modelId, const ModelBounds& boundingBox) noexcept {
+		m_boundingBoxes[modelId] = boundingBox;
+		MarkTransformDirty(modelId);
+	}
+	inline void SetMaterial(size_t modelId, const ModelMaterial& material) noexcept {
+		m_materials[modelId] = material;
+		MarkMaterialDirty(modelId);
+	}
+
+	// Entries written through the array pointers must be marked dirty afterwards.
+	inline void MarkTransformDirty(size_t modelId) noexcept {
+		m_transformDirtyFrames[modelId] = m_allFramesMask;
+		++m_transformVersions[modelId];
+	}
+	inline void MarkMaterialDirty(size_t modelId) noexcept {
+		m_materialDirtyFrames[modelId] = m_allFramesMask;
+	}
+
+	[[nodiscard]]
+	inline size_t GetModelCount() const noexcept { return std::size(m_modelMatrices); }
+	[[nodiscard]]
+	inline bool IsModelActive(size_t modelId) const noexcept {
+		return m_activeModels[modelId] != 0u;
+	}
+
+	[[nodiscard]]
+	inline DirectX::XMFLOAT4X4* GetModelMatrices() noexcept { return std::data(m_modelMatrices); }
+	[[nodiscard]]
+	inline DirectX::XMFLOAT3* GetModelOffsets() noexcept { return std::data(m_modelOffsets); }
+	[[nodiscard]]
+	inline ModelBounds* GetBoundingBoxes() noexcept { return std::data(m_boundingBoxes); }
+	[[nodiscard]]
+	inline ModelMaterial* GetMaterials() noexcept { return std::data(m_materials); }
+
+	[[nodiscard]]
+	inline const DirectX::XMFLOAT4X4* GetModelMatrices() const noexcept {
+		return std::data(m_modelMatrices);
+	}
+	[[nodiscard]]
+	inline const DirectX::XMFLOAT3* GetModelOffsets() const noexcept {
+		return std::data(m_modelOffsets);
+	}
+	[[nodiscard]]
+	inline const ModelBounds* GetBoundingBoxes() const noexcept {
+		return std::data(m_boundingBoxes);
+	}
+	[[nodiscard]]
+	inline const ModelMaterial* GetMaterials() const noexcept { return std::data(m_materials); }
+
+	// Each bit is a frame in flight whose copy of the entry is stale.
+	[[nodiscard]]
+	inline std::uint32_t* GetTransformDirtyFrames() noexcept {
+		return std::data(m_transformDirtyFrames);
+	}
+	[[nodiscard]]
+	inline std::uint32_t* GetMaterialDirtyFrames() noexcept {
+		return std::data(m_materialDirtyFrames);
+	}
+	// Changes whenever the transform or the bounds of a model change.
+	[[nodiscard]]
+	inline const std::uint32_t* GetTransformVersions() const noexcept {
+		return std::data(m_transformVersions);
+	}
+	[[nodiscard]]
+	inline const std::uint8_t* GetActiveModels() const noexcept {
+		return std::data(m_activeModels);
+	}
+
+private:
+	std::vector<DirectX::XMFLOAT4X4> m_modelMatrices;
+	std::vector<DirectX::XMFLOAT3> m_modelOffsets;
+	std::vector<ModelBounds> m_boundingBoxes;
+	std::vector<ModelMaterial> m_materials;
+	std::vector<std::uint32_t> m_transformDirtyFrames;
+	std::vector<std::uint32_t> m_materialDirtyFrames;
+	std::vector<std::uint32_t> m_transformVersions;
+	std::vector<std::uint8_t> m_activeModels;
+	std::uint32_t m_allFramesMask;
+};
+#endif
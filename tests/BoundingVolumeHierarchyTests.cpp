@@ -0,0 +1,227 @@
+#include <BoundingVolumeHierarchy.hpp>
+#include <TestChecks.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace DirectX;
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	float Next(float minimum, float maximum) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return minimum + (maximum - minimum) * static_cast<float>(m_state >> 8u) / 16777216.f;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+static void PlaceModel(ModelTransformStore& modelStore, size_t modelId, Random& random) noexcept {
+	const float halfSize = random.Next(0.5f, 3.f);
+
+	modelStore.SetBoundingBox(
+		modelId, ModelBounds{
+			.positiveAxes = { halfSize, halfSize, halfSize },
+			.negativeAxes = { -halfSize, -halfSize, -halfSize }
+		}
+	);
+	modelStore.SetModelMatrix(
+		modelId,
+		XMMatrixTranslation(
+			random.Next(-100.f, 100.f), random.Next(-100.f, 100.f), random.Next(-100.f, 100.f)
+		)
+	);
+}
+
+static std::vector<AxisAlignedBox> GetActiveBoxes(const ModelTransformStore& modelStore) {
+	std::vector<AxisAlignedBox> boxes(modelStore.GetModelCount());
+
+	for (size_t modelId = 0u; modelId < std::size(boxes); ++modelId)
+		if (modelStore.IsModelActive(modelId))
+			boxes[modelId] = GetWorldBox(
+				modelStore.GetModelMatrices()[modelId], modelStore.GetModelOffsets()[modelId],
+				modelStore.GetBoundingBoxes()[modelId]
+			);
+		else
+			// Inverted, so it matches nothing.
+			boxes[modelId] = AxisAlignedBox{
+				.minimum = { 1.f, 1.f, 1.f }, .maximum = { -1.f, -1.f, -1.f }
+			};
+
+	return boxes;
+}
+
+template<typename Predicate>
+static std::vector<std::uint32_t> FindLinearly(
+	const ModelTransformStore& modelStore, Predicate&& predicate
+) {
+	const std::vector<AxisAlignedBox> boxes = GetActiveBoxes(modelStore);
+	std::vector<std::uint32_t> modelIds;
+
+	for (size_t modelId = 0u; modelId < std::size(boxes); ++modelId)
+		if (modelStore.IsModelActive(modelId) && predicate(boxes[modelId]))
+			modelIds.emplace_back(static_cast<std::uint32_t>(modelId));
+
+	return modelIds;
+}
+
+static std::vector<std::uint32_t> Sorted(std::vector<std::uint32_t> modelIds) {
+	std::ranges::sort(modelIds);
+
+	return modelIds;
+}
+
+static bool RayHitsBox(
+	const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+	const AxisAlignedBox& box
+) noexcept {
+	// Marches along the ray, the step is smaller than the smallest box.
+	for (float distance = 0.f; distance <= maxDistance; distance += 0.01f) {
+		const XMFLOAT3 point{
+			origin.x + direction.x * distance, origin.y + direction.y * distance,
+			origin.z + direction.z * distance
+		};
+
+		if (DoBoxesOverlap(box, AxisAlignedBox{ .minimum = point, .maximum = point }))
+			return true;
+	}
+
+	return false;
+}
+
+static void CheckQueries(
+	const BoundingVolumeHierarchy& bvh, const ModelTransformStore& modelStore
+) {
+	const AxisAlignedBox queryBox{
+		.minimum = { -40.f, -20.f, -60.f }, .maximum = { 30.f, 50.f, 10.f }
+	};
+
+	std::vector<std::uint32_t> modelIds;
+	bvh.QueryBox(queryBox, modelIds);
+
+	CHECK(
+		Sorted(modelIds) == FindLinearly(
+			modelStore, [&](const AxisAlignedBox& box) { return DoBoxesOverlap(box, queryBox); }
+		)
+	);
+
+	FrustumCuller frustum{};
+	frustum.SetViewProjection(
+		XMMatrixMultiply(
+			XMMatrixLookAtLH(
+				XMVectorSet(0.f, 0.f, -120.f, 1.f), XMVectorZero(), XMVectorSet(0.f, 1.f, 0.f, 0.f)
+			),
+			XMMatrixPerspectiveFovLH(XMConvertToRadians(40.f), 1.5f, 1.f, 200.f)
+		)
+	);
+
+	modelIds.clear();
+	bvh.QueryFrustum(frustum, modelIds);
+
+	CHECK(
+		Sorted(modelIds) == FindLinearly(
+			modelStore, [&](const AxisAlignedBox& box) {
+				return frustum.TestBox(box) != FrustumTest::Outside;
+			}
+		)
+	);
+
+	const XMFLOAT3 origin{ -100.f, -10.f, 0.f };
+	const XMFLOAT3 direction{ 1.f, 0.1f, 0.05f };
+
+	modelIds.clear();
+	bvh.QueryRay(origin, direction, 200.f, modelIds);
+
+	CHECK(
+		Sorted(modelIds) == FindLinearly(
+			modelStore, [&](const AxisAlignedBox& box) {
+				return RayHitsBox(origin, direction, 200.f, box);
+			}
+		)
+	);
+}
+
+static void TestUpdates() {
+	Random random{ 7u };
+	ModelTransformStore modelStore{ 2u };
+	BoundingVolumeHierarchy bvh{};
+
+	// Many new models at once are built from scratch.
+	for (size_t index = 0u; index < 500u; ++index)
+		PlaceModel(modelStore, modelStore.AddModel(), random);
+
+	bvh.Update(modelStore);
+
+	CHECK(bvh.GetModelCount() == 500u);
+	CheckQueries(bvh, modelStore);
+
+	// A few new ones are inserted into the existing tree.
+	for (size_t index = 0u; index < 20u; ++index)
+		PlaceModel(modelStore, modelStore.AddModel(), random);
+
+	bvh.Update(modelStore);
+
+	CHECK(bvh.GetModelCount() == 520u);
+	CheckQueries(bvh, modelStore);
+
+	// A few moved models are refitted up their ancestors, most of them refit the whole tree.
+	for (size_t modelId = 0u; modelId < 520u; modelId += 50u)
+		PlaceModel(modelStore, modelId, random);
+
+	bvh.Update(modelStore);
+	CheckQueries(bvh, modelStore);
+
+	for (size_t modelId = 0u; modelId < 520u; modelId += 2u)
+		PlaceModel(modelStore, modelId, random);
+
+	bvh.Update(modelStore);
+	CheckQueries(bvh, modelStore);
+
+	for (size_t modelId = 1u; modelId < 520u; modelId += 3u)
+		modelStore.SetModelActive(modelId, false);
+
+	bvh.Update(modelStore);
+
+	CHECK(bvh.GetModelCount() == 520u - 173u);
+	CheckQueries(bvh, modelStore);
+
+	modelStore.SetModelActive(4u, true);
+	bvh.Update(modelStore);
+
+	CHECK(bvh.GetModelCount() == 520u - 172u);
+	CheckQueries(bvh, modelStore);
+
+	bvh.Rebuild();
+
+	CHECK(bvh.GetModelCount() == 520u - 172u);
+	CheckQueries(bvh, modelStore);
+}
+
+static void TestEmpty() {
+	ModelTransformStore modelStore{ 2u };
+	BoundingVolumeHierarchy bvh{};
+
+	bvh.Update(modelStore);
+
+	std::vector<std::uint32_t> modelIds;
+	bvh.QueryBox(
+		AxisAlignedBox{ .minimum = { -1.f, -1.f, -1.f }, .maximum = { 1.f, 1.f, 1.f } }, modelIds
+	);
+	bvh.QueryRay({ 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, 10.f, modelIds);
+
+	CHECK(bvh.GetModelCount() == 0u);
+	CHECK(std::empty(modelIds));
+}
+
+int main() {
+	TestUpdates();
+	TestEmpty();
+
+	return failedChecks;
+}
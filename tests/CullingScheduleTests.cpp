@@ -0,0 +1,97 @@
+#include <CullingSchedule.hpp>
+#include <TestChecks.hpp>
+#include <cstdint>
+#include <vector>
+
+static void TestWithoutOverlap() {
+	CullingSchedule schedule{ 2u };
+
+	CHECK(!schedule.IsOverlapEnabled());
+
+	const CullingSchedule::FrameSync first = schedule.ScheduleFrame(0u, 1u);
+
+	CHECK(first.cullSlot == 0u && first.drawSlot == 0u);
+	CHECK(first.cpuWaitOnCompute == 0u && first.computeWaitOnGraphics == 0u);
+	CHECK(first.computeSignal == 1u && first.graphicsWaitOnCompute == 1u);
+
+	static_cast<void>(schedule.ScheduleFrame(1u, 2u));
+
+	// The slot is reused two frames later, after both queues are done with it.
+	const CullingSchedule::FrameSync third = schedule.ScheduleFrame(0u, 3u);
+
+	CHECK(third.drawSlot == 0u);
+	CHECK(third.cpuWaitOnCompute == 1u && third.computeWaitOnGraphics == 1u);
+	CHECK(third.graphicsWaitOnCompute == 3u);
+}
+
+static void TestWithOverlap() {
+	CullingSchedule schedule{ 2u };
+	schedule.SetOverlap(true);
+
+	CHECK(schedule.IsOverlapEnabled());
+
+	// Without earlier results, the first frame draws with its own.
+	const CullingSchedule::FrameSync first = schedule.ScheduleFrame(0u, 1u);
+
+	CHECK(first.drawSlot == 0u && first.graphicsWaitOnCompute == 1u);
+
+	const CullingSchedule::FrameSync second = schedule.ScheduleFrame(1u, 2u);
+
+	CHECK(second.cullSlot == 1u && second.drawSlot == 0u);
+	CHECK(second.graphicsWaitOnCompute == 1u);
+
+	const CullingSchedule::FrameSync third = schedule.ScheduleFrame(0u, 3u);
+
+	// Slot 0 was last drawn by the second frame.
+	CHECK(third.drawSlot == 1u && third.graphicsWaitOnCompute == 2u);
+	CHECK(third.computeWaitOnGraphics == 2u && third.cpuWaitOnCompute == 1u);
+
+	schedule.ResetHistory();
+
+	const CullingSchedule::FrameSync fourth = schedule.ScheduleFrame(1u, 4u);
+
+	CHECK(fourth.drawSlot == 1u && fourth.graphicsWaitOnCompute == 4u);
+	CHECK(fourth.computeWaitOnGraphics == 3u);
+}
+
+// Replays many frames and checks that no culling overwrites a slot before the draws reading it
+// are done, and that every draw reads the newest finished results of its slot.
+static void TestHazards(size_t slotCount, bool overlap) {
+	CullingSchedule schedule{ slotCount };
+	schedule.SetOverlap(overlap);
+
+	std::vector<std::uint64_t> lastCulls(slotCount, 0u);
+	std::vector<std::uint64_t> lastDraws(slotCount, 0u);
+
+	for (std::uint64_t fenceValue = 1u; fenceValue < 200u; ++fenceValue) {
+		const size_t slot = static_cast<size_t>(fenceValue % slotCount);
+
+		if (fenceValue % 37u == 0u)
+			schedule.ResetHistory();
+
+		const CullingSchedule::FrameSync frameSync = schedule.ScheduleFrame(slot, fenceValue);
+
+		CHECK(frameSync.cullSlot == slot);
+		CHECK(frameSync.computeWaitOnGraphics >= lastDraws[slot]);
+		CHECK(frameSync.cpuWaitOnCompute >= lastCulls[slot]);
+
+		lastCulls[slot] = fenceValue;
+
+		CHECK(frameSync.graphicsWaitOnCompute == lastCulls[frameSync.drawSlot]);
+		CHECK(frameSync.graphicsWaitOnCompute <= fenceValue);
+
+		lastDraws[frameSync.drawSlot] = fenceValue;
+	}
+}
+
+int main() {
+	TestWithoutOverlap();
+	TestWithOverlap();
+
+	for (size_t slotCount = 2u; slotCount <= 3u; ++slotCount) {
+		TestHazards(slotCount, false);
+		TestHazards(slotCount, true);
+	}
+
+	return failedChecks;
+}
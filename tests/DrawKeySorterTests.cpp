@@ -0,0 +1,130 @@
+#include <DrawKeySorter.hpp>
+#include <JobRunner.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <TestChecks.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+static void TestKeys() {
+	const std::uint64_t key = DrawKeySorter::MakeKey(3u, 0x123456u, 0xABCDEFu);
+
+	CHECK(key == 0x0003'1234'56AB'CDEFu);
+	CHECK(DrawKeySorter::GetPipelineIndex(key) == 3u);
+
+	// The texture and the mesh wrap instead of spilling into the fields above them.
+	const std::uint64_t wrappedKey = DrawKeySorter::MakeKey(
+		DrawKeySorter::s_maxPipelineIndex, 0x1000001u, 0x1000002u
+	);
+
+	CHECK(wrappedKey == 0xFFFF'0000'0100'0002u);
+	CHECK(DrawKeySorter::GetPipelineIndex(wrappedKey) == DrawKeySorter::s_maxPipelineIndex);
+}
+
+// Few pipelines and textures, so most digits of the keys are the same and are skipped.
+static std::vector<DrawKey> MakeDrawKeys(size_t keyCount, Random& random) {
+	std::vector<DrawKey> drawKeys;
+
+	for (size_t index = 0u; index < keyCount; ++index)
+		drawKeys.emplace_back(
+			DrawKey{
+				.key = DrawKeySorter::MakeKey(
+					random.Next(4u), random.Next(300u), random.Next(70000u)
+				),
+				.modelIndex = random.Next(1u << 20u)
+			}
+		);
+
+	return drawKeys;
+}
+
+static bool IsSorted(const std::vector<DrawKey>& drawKeys, std::vector<DrawKey> expectedKeys) {
+	auto keyOrder = [](const DrawKey& left, const DrawKey& right) {
+		return left.key < right.key
+			|| (left.key == right.key && left.modelIndex < right.modelIndex);
+	};
+
+	std::ranges::sort(expectedKeys, keyOrder);
+
+	return std::ranges::equal(
+		drawKeys, expectedKeys, [](const DrawKey& left, const DrawKey& right) {
+			return left.key == right.key && left.modelIndex == right.modelIndex;
+		}
+	);
+}
+
+static void TestSort() {
+	Random random{ 53u };
+	DrawKeySorter sorter{};
+
+	// Many jobs, then fewer keys with the buffers of the larger sort.
+	for (size_t keyCount : { 0u, 1u, 2u, 1000u, 100000u, 40000u, 3u }) {
+		std::vector<DrawKey> drawKeys = MakeDrawKeys(keyCount, random);
+		const std::vector<DrawKey> inputKeys = drawKeys;
+
+		sorter.Sort(drawKeys);
+
+		CHECK(IsSorted(drawKeys, inputKeys));
+	}
+
+	// The same key everywhere leaves only the model indices to sort by.
+	std::vector<DrawKey> drawKeys;
+
+	for (std::uint32_t index = 0u; index < 50000u; ++index)
+		drawKeys.emplace_back(
+			DrawKey{ .key = DrawKeySorter::MakeKey(1u, 2u, 3u), .modelIndex = 49999u - index }
+		);
+
+	const std::vector<DrawKey> inputKeys = drawKeys;
+
+	sorter.Sort(drawKeys);
+
+	CHECK(IsSorted(drawKeys, inputKeys));
+
+	// Already sorted and all the same.
+	sorter.Sort(drawKeys);
+
+	CHECK(IsSorted(drawKeys, inputKeys));
+
+	std::vector<DrawKey> sameKeys(20000u, DrawKey{ .key = 7u, .modelIndex = 9u });
+
+	sorter.Sort(sameKeys);
+
+	CHECK(std::size(sameKeys) == 20000u);
+	CHECK(std::ranges::all_of(sameKeys, [](const DrawKey& drawKey) {
+		return drawKey.key == 7u && drawKey.modelIndex == 9u;
+	}));
+}
+
+int main() {
+	TestKeys();
+	TestSort();
+
+	// The large sorts are split into jobs on the pool.
+	Gaia::threadPool = std::make_shared<WorkStealingThreadPool>(
+		WorkStealingThreadPool::Args{ .workerCount = 3u }
+	);
+
+	TestSort();
+
+	Gaia::threadPool.reset();
+
+	return failedChecks;
+}
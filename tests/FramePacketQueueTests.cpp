@@ -0,0 +1,180 @@
+#include <FramePacketQueue.hpp>
+#include <TestChecks.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+[[nodiscard]]
+static FramePacket MakePacket(std::uint32_t frame) {
+	FramePacket framePacket{
+		.viewMatrix = {}, .fovAngleInDegree = frame, .transforms = {}, .materials = {}
+	};
+
+	framePacket.transforms.emplace_back(
+		ModelTransformSnapshot{
+			.modelId = frame, .modelMatrix = {}, .modelOffset = {}, .boundingBox = {}
+		}
+	);
+
+	return framePacket;
+}
+
+static void SleepFor(std::uint32_t milliseconds) {
+	std::this_thread::sleep_for(std::chrono::milliseconds{ milliseconds });
+}
+
+static void TestPacketOrder() {
+	FramePacketQueue packetQueue{ 2u };
+
+	std::thread producer{ [&packetQueue] {
+		for (std::uint32_t frame = 0u; frame < 200u; ++frame)
+			packetQueue.Push(MakePacket(frame));
+
+		packetQueue.Close();
+	} };
+
+	std::vector<std::uint32_t> frames;
+
+	while (std::optional<FramePacket> framePacket = packetQueue.Pop()) {
+		frames.emplace_back(framePacket->fovAngleInDegree);
+
+		CHECK(
+			std::size(framePacket->transforms) == 1u
+			&& framePacket->transforms.front().modelId == framePacket->fovAngleInDegree
+		);
+	}
+
+	producer.join();
+
+	bool inOrder = std::size(frames) == 200u;
+
+	for (std::uint32_t frame = 0u; inOrder && frame < 200u; ++frame)
+		inOrder = frames[frame] == frame;
+
+	// Closing only stops the pops once the queued packets are taken.
+	CHECK(inOrder);
+}
+
+static void TestBackPressure() {
+	FramePacketQueue packetQueue{ 2u };
+
+	packetQueue.Push(MakePacket(0u));
+	packetQueue.Push(MakePacket(1u));
+
+	std::atomic_bool pushed{ false };
+
+	std::thread producer{ [&packetQueue, &pushed] {
+		packetQueue.Push(MakePacket(2u));
+
+		pushed = true;
+	} };
+
+	// The queue is full, so the third packet waits.
+	SleepFor(50u);
+
+	CHECK(!pushed);
+
+	const std::optional<FramePacket> framePacket = packetQueue.Pop();
+
+	producer.join();
+
+	CHECK(pushed);
+	CHECK(framePacket && framePacket->fovAngleInDegree == 0u);
+
+	packetQueue.Close();
+
+	std::optional<FramePacket> secondPacket = packetQueue.Pop();
+	std::optional<FramePacket> thirdPacket = packetQueue.Pop();
+
+	CHECK(secondPacket && secondPacket->fovAngleInDegree == 1u);
+	CHECK(thirdPacket && thirdPacket->fovAngleInDegree == 2u);
+	CHECK(!packetQueue.Pop());
+}
+
+static void TestCloseWhileBlocked() {
+	// A producer waiting on a full queue returns and its packet is dropped.
+	{
+		FramePacketQueue packetQueue{ 1u };
+
+		packetQueue.Push(MakePacket(0u));
+
+		std::atomic_bool returned{ false };
+
+		std::thread producer{ [&packetQueue, &returned] {
+			packetQueue.Push(MakePacket(1u));
+
+			returned = true;
+		} };
+
+		SleepFor(20u);
+		packetQueue.Close();
+		producer.join();
+
+		CHECK(returned);
+		CHECK(packetQueue.IsClosed());
+
+		const std::optional<FramePacket> framePacket = packetQueue.Pop();
+
+		CHECK(framePacket && framePacket->fovAngleInDegree == 0u);
+		CHECK(!packetQueue.Pop());
+
+		// Pushes after closing are dropped straight away.
+		packetQueue.Push(MakePacket(2u));
+
+		CHECK(!packetQueue.Pop());
+	}
+
+	// A consumer waiting on an empty queue returns without a packet.
+	{
+		FramePacketQueue packetQueue{ 2u };
+
+		std::atomic_bool gotPacket{ true };
+
+		std::thread consumer{ [&packetQueue, &gotPacket] {
+			gotPacket = packetQueue.Pop().has_value();
+		} };
+
+		SleepFor(20u);
+		packetQueue.Close();
+		consumer.join();
+
+		CHECK(!gotPacket);
+	}
+}
+
+static void TestWaitUntilDrained() {
+	FramePacketQueue packetQueue{ 2u };
+
+	std::atomic_bool processed{ false };
+
+	std::thread consumer{ [&packetQueue, &processed] {
+		while (std::optional<FramePacket> framePacket = packetQueue.Pop()) {
+			SleepFor(30u);
+
+			processed = true;
+		}
+	} };
+
+	packetQueue.Push(MakePacket(0u));
+
+	// A popped packet is only done once the consumer asks for the next one.
+	packetQueue.WaitUntilDrained();
+
+	CHECK(processed);
+
+	packetQueue.Close();
+	consumer.join();
+
+	// Closed, so it doesn't wait.
+	packetQueue.WaitUntilDrained();
+}
+
+int main() {
+	TestPacketOrder();
+	TestBackPressure();
+	TestCloseWhileBlocked();
+	TestWaitUntilDrained();
+
+	return failedChecks;
+}
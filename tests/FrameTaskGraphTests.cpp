@@ -0,0 +1,299 @@
+#include <FrameTaskGraph.hpp>
+#include <JobRunner.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <TestChecks.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class Random {
+public:
+	Random(std::uint32_t seed) : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+[[nodiscard]]
+static FrameResource RandomResources(Random& random) {
+	FrameResource resources = FrameResource::None;
+
+	for (std::uint32_t bit = 0u; bit < 8u; ++bit)
+		if (random.Next(4u) == 0u)
+			resources = resources | static_cast<FrameResource>(1u << bit);
+
+	return resources;
+}
+
+[[nodiscard]]
+static bool DependsOn(
+	FrameResource reads, FrameResource writes, FrameResource earlierReads,
+	FrameResource earlierWrites
+) noexcept {
+	return Overlaps(earlierWrites, reads | writes) || Overlaps(earlierReads, writes);
+}
+
+static void TestDependencyOrder() {
+	Random random{ 7u };
+
+	struct TaskResources {
+		FrameResource reads;
+		FrameResource writes;
+	};
+
+	std::vector<TaskResources> taskResources;
+	std::vector<std::atomic_size_t> runOrders(60u);
+	std::vector<std::atomic_size_t> runCounts(60u);
+	std::atomic_size_t nextRun{ 0u };
+	std::atomic_bool rightFrame{ true };
+
+	FrameTaskGraph frameTasks{};
+
+	for (size_t taskIndex = 0u; taskIndex < std::size(runOrders); ++taskIndex) {
+		const TaskResources resources{
+			.reads = RandomResources(random), .writes = RandomResources(random)
+		};
+		taskResources.emplace_back(resources);
+
+		frameTasks.AddTask(
+			"Task",
+			[&, taskIndex](size_t frameIndex) {
+				if (frameIndex != 3u)
+					rightFrame = false;
+
+				std::this_thread::yield();
+
+				runOrders[taskIndex] = nextRun++;
+				++runCounts[taskIndex];
+			},
+			resources.reads, resources.writes
+		);
+	}
+
+	CHECK(frameTasks.GetTaskCount() == std::size(runOrders));
+
+	for (size_t frame = 0u; frame < 20u; ++frame) {
+		nextRun = 0u;
+		frameTasks.Execute(3u);
+
+		for (size_t taskIndex = 0u; taskIndex < std::size(runOrders); ++taskIndex)
+			for (size_t earlierIndex = 0u; earlierIndex < taskIndex; ++earlierIndex) {
+				const TaskResources& resources = taskResources[taskIndex];
+				const TaskResources& earlierResources = taskResources[earlierIndex];
+
+				if (DependsOn(
+					resources.reads, resources.writes, earlierResources.reads,
+					earlierResources.writes
+				))
+					CHECK(runOrders[earlierIndex] < runOrders[taskIndex]);
+			}
+	}
+
+	bool ranEveryFrame = true;
+
+	for (const std::atomic_size_t& runCount : runCounts)
+		ranEveryFrame = ranEveryFrame && runCount == 20u;
+
+	CHECK(ranEveryFrame);
+	CHECK(rightFrame);
+
+	frameTasks.Clear();
+
+	CHECK(frameTasks.GetTaskCount() == 0u);
+}
+
+static void TestIndependentTasksOverlap() {
+	std::atomic_bool firstStarted{ false };
+	std::atomic_bool secondStarted{ false };
+	std::atomic_bool overlapped{ true };
+
+	// Each one waits a while for the other to start, which only happens on different threads.
+	const auto waitFor = [&overlapped](const std::atomic_bool& started) {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+
+		while (!started)
+			if (std::chrono::steady_clock::now() > deadline) {
+				overlapped = false;
+
+				return;
+			}
+	};
+
+	FrameTaskGraph frameTasks{};
+	frameTasks.AddTask(
+		"First",
+		[&](size_t) {
+			firstStarted = true;
+			waitFor(secondStarted);
+		},
+		FrameResource::Camera, FrameResource::ModelBuffers
+	);
+	frameTasks.AddTask(
+		"Second",
+		[&](size_t) {
+			secondStarted = true;
+			waitFor(firstStarted);
+		},
+		FrameResource::Camera, FrameResource::LightBuffers
+	);
+
+	frameTasks.Execute(0u);
+
+	CHECK(overlapped);
+}
+
+static void TestSerialFallback() {
+	std::shared_ptr<IThreadPool> threadPool = std::move(Gaia::threadPool);
+
+	std::vector<size_t> runOrder;
+	std::thread::id runThread{};
+
+	FrameTaskGraph frameTasks{};
+
+	// Independent tasks, which still run in the order they were added in.
+	for (size_t taskIndex = 0u; taskIndex < 10u; ++taskIndex)
+		frameTasks.AddTask(
+			"Task",
+			[&, taskIndex](size_t) {
+				runOrder.emplace_back(taskIndex);
+				runThread = std::this_thread::get_id();
+			},
+			FrameResource::None, FrameResource::None
+		);
+
+	frameTasks.Execute(0u);
+
+	CHECK((runOrder == std::vector<size_t>{ 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u }));
+	CHECK(runThread == std::this_thread::get_id());
+
+	Gaia::threadPool = std::move(threadPool);
+}
+
+static void SleepFor(std::uint32_t milliseconds) {
+	std::this_thread::sleep_for(std::chrono::milliseconds{ milliseconds });
+}
+
+static void TestCriticalPath() {
+	FrameTaskGraph frameTasks{};
+
+	// The copy and the update are one after the other, the lights run beside them.
+	frameTasks.AddTask(
+		"CameraCopy", [](size_t) { SleepFor(20u); }, FrameResource::None, FrameResource::Camera
+	);
+	frameTasks.AddTask(
+		"Lights", [](size_t) { SleepFor(30u); }, FrameResource::None, FrameResource::LightBuffers
+	);
+	frameTasks.AddTask(
+		"ModelUpdate", [](size_t) { SleepFor(20u); },
+		FrameResource::Camera, FrameResource::ModelBuffers
+	);
+
+	for (bool usePool : { true, false }) {
+		std::shared_ptr<IThreadPool> threadPool{};
+
+		if (!usePool)
+			threadPool = std::move(Gaia::threadPool);
+
+		frameTasks.Execute(0u);
+
+		const FrameTaskGraph::FrameStats frameStats = frameTasks.GetFrameStats();
+		const std::vector<char const*>& criticalPath = frameTasks.GetCriticalPath();
+
+		CHECK(std::size(criticalPath) == 2u);
+		CHECK(
+			std::size(criticalPath) == 2u
+			&& std::string_view{ criticalPath[0] } == "CameraCopy"
+			&& std::string_view{ criticalPath[1] } == "ModelUpdate"
+		);
+		CHECK(frameStats.criticalPathSeconds >= 0.04);
+		CHECK(frameStats.frameSeconds >= frameStats.criticalPathSeconds);
+
+		// Serially the frame takes the time of every task.
+		if (!usePool)
+			CHECK(frameStats.frameSeconds >= 0.07);
+
+		if (threadPool)
+			Gaia::threadPool = std::move(threadPool);
+	}
+}
+
+static void TestExceptions() {
+	bool shouldThrow = true;
+	std::atomic_size_t tasksRun{ 0u };
+	std::atomic_bool dependentRan{ false };
+
+	FrameTaskGraph frameTasks{};
+	frameTasks.AddTask(
+		"Update",
+		[&](size_t) {
+			++tasksRun;
+
+			if (shouldThrow)
+				throw std::runtime_error{ "Task failed" };
+		},
+		FrameResource::None, FrameResource::ModelBuffers
+	);
+	frameTasks.AddTask(
+		"Draw",
+		[&](size_t) {
+			++tasksRun;
+			dependentRan = true;
+		},
+		FrameResource::ModelBuffers, FrameResource::GraphicsCommandList
+	);
+
+	bool caught = false;
+
+	try {
+		frameTasks.Execute(0u);
+	}
+	catch (const std::runtime_error& error) {
+		caught = std::string_view{ error.what() } == "Task failed";
+	}
+
+	// The task after the failed one is skipped.
+	CHECK(caught);
+	CHECK(!dependentRan);
+	CHECK(tasksRun == 1u);
+
+	// The next frame runs as usual.
+	shouldThrow = false;
+	caught = false;
+
+	try {
+		frameTasks.Execute(1u);
+	}
+	catch (...) {
+		caught = true;
+	}
+
+	CHECK(!caught);
+	CHECK(dependentRan);
+	CHECK(tasksRun == 3u);
+}
+
+int main() {
+	Gaia::threadPool = std::make_shared<WorkStealingThreadPool>(
+		WorkStealingThreadPool::Args{ .workerCount = 3u }
+	);
+
+	TestDependencyOrder();
+	TestIndependentTasksOverlap();
+	TestSerialFallback();
+	TestCriticalPath();
+	TestExceptions();
+
+	Gaia::threadPool.reset();
+
+	return failedChecks;
+}
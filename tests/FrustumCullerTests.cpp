@@ -0,0 +1,111 @@
+#include <FrustumCuller.hpp>
+#include <AxisAlignedBox.hpp>
+#include <TestChecks.hpp>
+#include <cmath>
+
+using namespace DirectX;
+
+// A camera at the origin looking down +Z, with a 90 degree field of view and planes at 1 and 100.
+static FrustumCuller MakeCuller() {
+	FrustumCuller culler{};
+	culler.SetViewProjection(
+		XMMatrixMultiply(
+			XMMatrixLookAtLH(
+				XMVectorZero(), XMVectorSet(0.f, 0.f, 1.f, 0.f), XMVectorSet(0.f, 1.f, 0.f, 0.f)
+			),
+			XMMatrixPerspectiveFovLH(XMConvertToRadians(90.f), 1.f, 1.f, 100.f)
+		)
+	);
+
+	return culler;
+}
+
+static AxisAlignedBox MakeBox(const XMFLOAT3& centre, float halfSize) noexcept {
+	return AxisAlignedBox{
+		.minimum = { centre.x - halfSize, centre.y - halfSize, centre.z - halfSize },
+		.maximum = { centre.x + halfSize, centre.y + halfSize, centre.z + halfSize }
+	};
+}
+
+static void TestBoxes() {
+	const FrustumCuller culler = MakeCuller();
+
+	CHECK(culler.TestBox(MakeBox({ 0.f, 0.f, 50.f }, 1.f)) == FrustumTest::Inside);
+	// Behind the camera, past the far plane and off each side.
+	CHECK(culler.TestBox(MakeBox({ 0.f, 0.f, -10.f }, 1.f)) == FrustumTest::Outside);
+	CHECK(culler.TestBox(MakeBox({ 0.f, 0.f, 150.f }, 1.f)) == FrustumTest::Outside);
+	CHECK(culler.TestBox(MakeBox({ 30.f, 0.f, 10.f }, 1.f)) == FrustumTest::Outside);
+	CHECK(culler.TestBox(MakeBox({ -30.f, 0.f, 10.f }, 1.f)) == FrustumTest::Outside);
+	CHECK(culler.TestBox(MakeBox({ 0.f, 30.f, 10.f }, 1.f)) == FrustumTest::Outside);
+	CHECK(culler.TestBox(MakeBox({ 0.f, -30.f, 10.f }, 1.f)) == FrustumTest::Outside);
+	// Across the right plane, the near plane and the far plane.
+	CHECK(culler.TestBox(MakeBox({ 10.f, 0.f, 10.f }, 1.f)) == FrustumTest::Intersecting);
+	CHECK(culler.TestBox(MakeBox({ 0.f, 0.f, 1.f }, 0.5f)) == FrustumTest::Intersecting);
+	CHECK(culler.TestBox(MakeBox({ 0.f, 0.f, 100.f }, 2.f)) == FrustumTest::Intersecting);
+}
+
+static void TestSpheres() {
+	const FrustumCuller culler = MakeCuller();
+
+	CHECK(culler.TestSphere({ 0.f, 0.f, 50.f }, 1.f) == FrustumTest::Inside);
+	CHECK(culler.TestSphere({ 0.f, 0.f, -10.f }, 1.f) == FrustumTest::Outside);
+	CHECK(culler.TestSphere({ 0.f, 50.f, 20.f }, 1.f) == FrustumTest::Outside);
+	CHECK(culler.TestSphere({ 0.f, 20.f, 20.f }, 1.f) == FrustumTest::Intersecting);
+	// The sphere test is conservative, it never culls a sphere which touches the frustum.
+	CHECK(culler.TestSphere({ 0.f, 0.f, 120.f }, 25.f) == FrustumTest::Intersecting);
+}
+
+static bool NearlyEqual(const XMFLOAT3& lhs, const XMFLOAT3& rhs) noexcept {
+	return std::abs(lhs.x - rhs.x) < 1e-4f && std::abs(lhs.y - rhs.y) < 1e-4f
+		&& std::abs(lhs.z - rhs.z) < 1e-4f;
+}
+
+static void TestBoxHelpers() {
+	const AxisAlignedBox box1{ .minimum = { 0.f, 0.f, 0.f }, .maximum = { 1.f, 2.f, 3.f } };
+	const AxisAlignedBox box2{ .minimum = { -1.f, 1.f, 2.f }, .maximum = { 0.5f, 4.f, 5.f } };
+	const AxisAlignedBox box3{ .minimum = { 2.f, 0.f, 0.f }, .maximum = { 3.f, 1.f, 1.f } };
+
+	const AxisAlignedBox unionBox = GetBoxUnion(box1, box2);
+
+	CHECK(NearlyEqual(unionBox.minimum, { -1.f, 0.f, 0.f }));
+	CHECK(NearlyEqual(unionBox.maximum, { 1.f, 4.f, 5.f }));
+
+	CHECK(GetBoxSurfaceArea(box1) == 22.f);
+
+	CHECK(DoBoxesOverlap(box1, box2));
+	CHECK(DoBoxesOverlap(box2, box1));
+	CHECK(!DoBoxesOverlap(box1, box3));
+}
+
+static void TestWorldBox() {
+	const ModelBounds bounds{
+		.positiveAxes = { 1.f, 2.f, 3.f },
+		.negativeAxes = { -1.f, -2.f, -3.f }
+	};
+
+	XMFLOAT4X4 translation{};
+	XMStoreFloat4x4(&translation, XMMatrixTranslation(10.f, 0.f, 0.f));
+
+	const AxisAlignedBox movedBox = GetWorldBox(translation, { 0.f, 5.f, 0.f }, bounds);
+
+	CHECK(NearlyEqual(movedBox.minimum, { 9.f, 3.f, -3.f }));
+	CHECK(NearlyEqual(movedBox.maximum, { 11.f, 7.f, 3.f }));
+
+	// A quarter turn around Y swaps the X and Z extents.
+	XMFLOAT4X4 rotation{};
+	XMStoreFloat4x4(&rotation, XMMatrixRotationRollPitchYaw(0.f, XM_PI * 0.5f, 0.f));
+
+	const AxisAlignedBox rotatedBox = GetWorldBox(rotation, { 0.f, 0.f, 0.f }, bounds);
+
+	CHECK(NearlyEqual(rotatedBox.minimum, { -3.f, -2.f, -1.f }));
+	CHECK(NearlyEqual(rotatedBox.maximum, { 3.f, 2.f, 1.f }));
+}
+
+int main() {
+	TestBoxes();
+	TestSpheres();
+	TestBoxHelpers();
+	TestWorldBox();
+
+	return failedChecks;
+}
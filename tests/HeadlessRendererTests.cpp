@@ -0,0 +1,218 @@
+#include <GaiaInstance.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <TestChecks.hpp>
+#include <TestModel.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+// Looks at the grids from in front of them.
+class TestCamera final : public ISharedDataContainer {
+public:
+	TestCamera() noexcept
+		: m_viewMatrix{
+			XMMatrixLookAtLH(
+				XMVectorSet(4.f, 4.f, -20.f, 1.f), XMVectorSet(4.f, 4.f, 0.f, 1.f),
+				XMVectorSet(0.f, 1.f, 0.f, 0.f)
+			)
+		}, m_fov{ 65u } {}
+
+	void SetViewMatrix(const XMMATRIX& viewMatrix) noexcept override { m_viewMatrix = viewMatrix; }
+	[[nodiscard]]
+	XMMATRIX GetViewMatrix() const noexcept override { return m_viewMatrix; }
+
+	void SetFov(std::uint32_t fovAngleInDegree) noexcept override { m_fov = fovAngleInDegree; }
+	[[nodiscard]]
+	std::uint32_t GetFov() const noexcept override { return m_fov; }
+
+private:
+	XMMATRIX m_viewMatrix;
+	std::uint32_t m_fov;
+};
+
+// The headless device doesn't read the shader binaries, so any file which exists will do.
+static void WriteShaderFiles(const std::filesystem::path& directory) {
+	std::filesystem::create_directories(directory);
+
+	for (char const* name : {
+		"VertexShaderIndividual", "VertexShaderIndividualInstanced", "VertexShaderIndirect",
+		"ComputeShader", "MeshShader", "PixelShader"
+	}) {
+		std::ofstream file{ directory / (std::string{ name } + ".cso"), std::ios_base::binary };
+		file << "DXBC";
+	}
+}
+
+// Eight models drawing the same grid of 8 x 8 quads, all of them in front of the camera.
+static void AddGridModels(Renderer& renderer) {
+	static constexpr size_t modelCount = 8u;
+	static constexpr size_t gridSize = 8u;
+	static constexpr float gridExtent = static_cast<float>(gridSize);
+
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+
+	AppendGrid(gridSize, gridSize, vertices, indices);
+
+	const auto indexCount = static_cast<std::uint32_t>(std::size(indices));
+	const ModelInputRange inputRange = renderer.AddModelInputs(
+		std::move(vertices), std::move(indices)
+	);
+
+	std::vector<std::shared_ptr<IModel>> models;
+
+	for (size_t index = 0u; index < modelCount; ++index)
+		models.emplace_back(
+			std::make_shared<TestModel>(
+				inputRange.indexOffset, indexCount,
+				ModelBounds{
+					.positiveAxes = { gridExtent, gridExtent, 0.f },
+					.negativeAxes = { 0.f, 0.f, 0.f }
+				}
+			)
+		);
+
+	static_cast<void>(renderer.AddModelSet(std::move(models), L"PixelShader"));
+}
+
+struct FrameTimes {
+	double frameSeconds;
+	double frameTaskSeconds;
+	double criticalPathSeconds;
+};
+
+[[nodiscard]]
+static double GetMedian(std::vector<double>& seconds) {
+	std::ranges::sort(seconds);
+
+	return seconds[std::size(seconds) / 2u];
+}
+
+// The median times of a frame, the wall time is from Update to the end of Render.
+[[nodiscard]]
+static FrameTimes RenderFrames(Renderer& renderer, size_t frameCount) {
+	std::vector<double> frameSeconds;
+	std::vector<double> frameTaskSeconds;
+	std::vector<double> criticalPathSeconds;
+
+	for (size_t frame = 0u; frame < frameCount; ++frame) {
+		const auto frameStart = std::chrono::steady_clock::now();
+
+		renderer.Update();
+		renderer.Render();
+
+		frameSeconds.emplace_back(
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count()
+		);
+
+		const Renderer::FrameStatistics frameStatistics = renderer.GetFrameStatistics();
+
+		frameTaskSeconds.emplace_back(frameStatistics.frameTaskSeconds);
+		criticalPathSeconds.emplace_back(frameStatistics.criticalPathSeconds);
+	}
+
+	renderer.WaitForAsyncTasks();
+
+	return FrameTimes{
+		.frameSeconds = GetMedian(frameSeconds),
+		.frameTaskSeconds = GetMedian(frameTaskSeconds),
+		.criticalPathSeconds = GetMedian(criticalPathSeconds)
+	};
+}
+
+static void PrintFrameTimes(char const* name, const FrameTimes& frameTimes) {
+	std::printf(
+		"%s: median frame %.3f ms, frame tasks %.3f ms, critical path %.3f ms\n", name,
+		frameTimes.frameSeconds * 1000.0, frameTimes.frameTaskSeconds * 1000.0,
+		frameTimes.criticalPathSeconds * 1000.0
+	);
+}
+
+static void TestIndividualDraw(const std::filesystem::path& shaderDirectory) {
+	std::unique_ptr<Renderer> renderer{
+		CreateHeadlessGaiaInstance(
+			"HeadlessRendererTests", 1920u, 1080u, RenderEngineType::IndividualDraw
+		)
+	};
+
+	const std::wstring shaderPath = (shaderDirectory / L"").wstring();
+
+	renderer->SetShaderPath(shaderPath.c_str());
+	renderer->SetSharedDataContainer(std::make_shared<TestCamera>());
+
+	AddGridModels(*renderer);
+
+	renderer->ProcessData();
+	renderer->SetCommandRecording(true);
+
+	// Without a pool, the frame tasks run one after another.
+	const FrameTimes serialFrameTimes = RenderFrames(*renderer, 101u);
+
+	const Renderer::CommandStatistics commandStatistics = renderer->GetCommandStatistics();
+	const Renderer::FrameStatistics frameStatistics = renderer->GetFrameStatistics();
+
+	CHECK(frameStatistics.modelsVisible == 8u);
+	CHECK(frameStatistics.modelsCulled == 0u);
+	CHECK(commandStatistics.draws == 8u);
+	CHECK(commandStatistics.pipelineChanges > 0u);
+	CHECK(commandStatistics.barriers > 0u);
+	CHECK(commandStatistics.clears > 0u);
+
+	PrintFrameTimes("Individual draw, serial frame tasks", serialFrameTimes);
+
+	renderer->SetThreadPool(
+		std::make_shared<WorkStealingThreadPool>(WorkStealingThreadPool::Args{})
+	);
+
+	const FrameTimes pooledFrameTimes = RenderFrames(*renderer, 101u);
+
+	CHECK(renderer->GetCommandStatistics().draws == 8u);
+	CHECK(!std::empty(renderer->GetFrameCriticalPath()));
+
+	PrintFrameTimes("Individual draw, frame tasks on the pool", pooledFrameTimes);
+
+	std::printf("Critical path:");
+
+	for (const std::string& stage : renderer->GetFrameCriticalPath())
+		std::printf(" %s", stage.c_str());
+
+	std::printf("\n");
+
+	// The same frames from the render thread.
+	renderer->SetRenderThread(true);
+
+	const FrameTimes threadedFrameTimes = RenderFrames(*renderer, 101u);
+
+	renderer->SetRenderThread(false);
+
+	CHECK(renderer->GetCommandStatistics().draws == 8u);
+
+	PrintFrameTimes("Individual draw on the render thread", threadedFrameTimes);
+}
+
+int main() {
+	const std::filesystem::path shaderDirectory = std::filesystem::temp_directory_path()
+		/ "GaiaXHeadlessShaders";
+
+	WriteShaderFiles(shaderDirectory);
+
+	try {
+		TestIndividualDraw(shaderDirectory);
+	}
+	catch (const std::exception& exception) {
+		++failedChecks;
+		std::fprintf(stderr, "%s\n", exception.what());
+	}
+
+	std::filesystem::remove_all(shaderDirectory);
+
+	return failedChecks;
+}
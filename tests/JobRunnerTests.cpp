@@ -0,0 +1,70 @@
+#include <JobRunner.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <TestChecks.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+static void TestEveryJobRunsOnce(IThreadPool* pool) {
+	std::vector<std::atomic_uint32_t> runCounts(1000u);
+
+	Gaia::RunJobs(pool, std::size(runCounts), [&runCounts](size_t jobIndex) {
+		++runCounts[jobIndex];
+	});
+
+	bool ranOnce = true;
+
+	for (const std::atomic_uint32_t& runCount : runCounts)
+		ranOnce = ranOnce && runCount == 1u;
+
+	CHECK(ranOnce);
+}
+
+static void TestExceptions(IThreadPool* pool) {
+	std::atomic_size_t jobsRun{ 0u };
+	bool caught = false;
+
+	try {
+		Gaia::RunJobs(pool, 200u, [&jobsRun](size_t jobIndex) {
+			++jobsRun;
+
+			if (jobIndex % 50u == 3u)
+				throw std::runtime_error{ "Job failed" };
+		});
+	}
+	catch (const std::runtime_error&) {
+		caught = true;
+	}
+
+	// On a pool the rest of the jobs still run and the call only returns once they are done.
+	CHECK(caught);
+	CHECK(jobsRun == (pool ? 200u : 4u));
+}
+
+static void TestNestedJobs() {
+	std::atomic_size_t jobsRun{ 0u };
+
+	// The pool jobs wait for jobs of their own, which needs the callers to help.
+	Gaia::RunJobs(8u, [&jobsRun](size_t) {
+		Gaia::RunJobs(8u, [&jobsRun](size_t) { ++jobsRun; });
+	});
+
+	CHECK(jobsRun == 64u);
+}
+
+int main() {
+	TestEveryJobRunsOnce(nullptr);
+	TestExceptions(nullptr);
+
+	Gaia::threadPool = std::make_shared<WorkStealingThreadPool>(
+		WorkStealingThreadPool::Args{ .workerCount = 3u }
+	);
+
+	TestEveryJobRunsOnce(Gaia::threadPool.get());
+	TestExceptions(Gaia::threadPool.get());
+	TestNestedJobs();
+
+	Gaia::threadPool.reset();
+
+	return failedChecks;
+}
@@ -0,0 +1,283 @@
+#include <MeshletBuilder.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <Exception.hpp>
+#include <TestModel.hpp>
+#include <TestChecks.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using Triangle = std::array<std::uint32_t, 3u>;
+
+// Rotated so the smallest index is first, the winding is kept.
+static Triangle Normalise(Triangle triangle) noexcept {
+	std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+
+	return triangle;
+}
+
+static std::vector<Triangle> GetModelTriangles(
+	const std::vector<std::uint32_t>& indices, const IModel& model
+) {
+	std::vector<Triangle> triangles;
+
+	for (std::uint32_t index = 0u; index < model.GetIndexCount(); index += 3u) {
+		const std::uint32_t first = model.GetIndexOffset() + index;
+
+		triangles.emplace_back(
+			Normalise({ indices[first], indices[first + 1u], indices[first + 2u] })
+		);
+	}
+
+	std::ranges::sort(triangles);
+
+	return triangles;
+}
+
+static std::vector<Triangle> GetMeshletTriangles(
+	const MeshletBuilder::MeshletData& meshletData, const std::vector<Meshlet>& meshlets
+) {
+	std::vector<Triangle> triangles;
+
+	for (const Meshlet& meshlet : meshlets)
+		for (std::uint32_t index = 0u; index < meshlet.primitiveCount; ++index) {
+			const std::uint32_t primitive = meshletData.primIndices[
+				meshlet.primitiveOffset + index
+			];
+			Triangle triangle{};
+
+			for (size_t corner = 0u; corner < 3u; ++corner) {
+				const std::uint32_t localIndex = (primitive >> (corner * 10u)) & 0x3FFu;
+
+				CHECK(localIndex < meshlet.vertexCount);
+
+				triangle[corner] = meshletData.vertexIndices[meshlet.vertexOffset + localIndex];
+			}
+
+			triangles.emplace_back(Normalise(triangle));
+		}
+
+	std::ranges::sort(triangles);
+
+	return triangles;
+}
+
+struct TestMesh {
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	std::vector<std::shared_ptr<IModel>> models;
+};
+
+static TestMesh CreateMesh() {
+	TestMesh mesh{};
+
+	// A single triangle, a long strip and a few grids, so some models fill many meshlets.
+	const std::array<std::array<size_t, 2u>, 5u> gridSizes{ {
+		{ 1u, 1u }, { 64u, 1u }, { 16u, 16u }, { 3u, 5u }, { 40u, 25u }
+	} };
+
+	for (const auto& [columns, rows] : gridSizes) {
+		const auto indexOffset = static_cast<std::uint32_t>(std::size(mesh.indices));
+
+		AppendGrid(columns, rows, mesh.vertices, mesh.indices);
+
+		mesh.models.emplace_back(
+			std::make_shared<TestModel>(
+				indexOffset, static_cast<std::uint32_t>(std::size(mesh.indices)) - indexOffset
+			)
+		);
+	}
+
+	// The first model is half the quad only.
+	mesh.models.front() = std::make_shared<TestModel>(0u, 3u);
+
+	return mesh;
+}
+
+static void CheckMeshlets(
+	const TestMesh& mesh, const MeshletBuilder::MeshletData& meshletData,
+	std::uint32_t maxVertices, std::uint32_t maxPrimitives
+) {
+	CHECK(std::size(meshletData.modelMeshlets) == std::size(mesh.models));
+
+	size_t triangleCount = 0u;
+
+	for (size_t modelIndex = 0u; modelIndex < std::size(mesh.models); ++modelIndex) {
+		const std::vector<Meshlet>& meshlets = meshletData.modelMeshlets[modelIndex];
+
+		for (const Meshlet& meshlet : meshlets) {
+			CHECK(meshlet.vertexCount <= maxVertices);
+			CHECK(meshlet.primitiveCount && meshlet.primitiveCount <= maxPrimitives);
+			CHECK(
+				meshlet.vertexOffset + meshlet.vertexCount <= std::size(meshletData.vertexIndices)
+			);
+			CHECK(
+				meshlet.primitiveOffset + meshlet.primitiveCount
+				<= std::size(meshletData.primIndices)
+			);
+		}
+
+		// Every triangle is in exactly one meshlet of its model.
+		CHECK(
+			GetMeshletTriangles(meshletData, meshlets)
+			== GetModelTriangles(mesh.indices, *mesh.models[modelIndex])
+		);
+
+		triangleCount += mesh.models[modelIndex]->GetIndexCount() / 3u;
+	}
+
+	CHECK(std::size(meshletData.primIndices) == triangleCount);
+}
+
+static void TestLimits() {
+	const TestMesh mesh = CreateMesh();
+
+	const std::array<std::array<std::uint32_t, 2u>, 4u> limits{ {
+		{ 64u, 126u }, { 3u, 1u }, { 10u, 4u }, { 256u, 256u }
+	} };
+
+	for (const auto& [maxVertices, maxPrimitives] : limits) {
+		const MeshletBuilder builder{
+			{ .maxVertices = maxVertices, .maxPrimitives = maxPrimitives }
+		};
+
+		const MeshletBuilder::MeshletData meshletData = builder.BuildMeshlets(
+			mesh.vertices, mesh.indices, mesh.models
+		);
+
+		CheckMeshlets(mesh, meshletData, maxVertices, maxPrimitives);
+
+		const MeshletBuilder::MeshletStats stats = builder.GetMeshletStats(meshletData);
+
+		size_t meshletCount = 0u;
+
+		for (const std::vector<Meshlet>& meshlets : meshletData.modelMeshlets)
+			meshletCount += std::size(meshlets);
+
+		CHECK(stats.meshletCount == meshletCount);
+		CHECK(stats.triangleCount == std::size(meshletData.primIndices));
+		CHECK(stats.vertexFillRatio > 0.f && stats.vertexFillRatio <= 1.f);
+		CHECK(stats.primitiveFillRatio > 0.f && stats.primitiveFillRatio <= 1.f);
+	}
+
+	// With one triangle per meshlet, each sends its three vertices.
+	const MeshletBuilder builder{ { .maxVertices = 3u, .maxPrimitives = 1u } };
+	const MeshletBuilder::MeshletStats stats = builder.GetMeshletStats(
+		builder.BuildMeshlets(mesh.vertices, mesh.indices, mesh.models)
+	);
+
+	CHECK(stats.verticesPerTriangle == 3.f);
+	CHECK(stats.primitiveFillRatio == 1.f);
+}
+
+static void TestVertexReuse() {
+	TestMesh mesh{};
+	AppendGrid(32u, 32u, mesh.vertices, mesh.indices);
+	mesh.models.emplace_back(
+		std::make_shared<TestModel>(0u, static_cast<std::uint32_t>(std::size(mesh.indices)))
+	);
+
+	const MeshletBuilder builder{ {} };
+	const MeshletBuilder::MeshletStats stats = builder.GetMeshletStats(
+		builder.BuildMeshlets(mesh.vertices, mesh.indices, mesh.models)
+	);
+
+	// A grid shares most vertices, a meshlet of scattered triangles would send close to 3.
+	CHECK(stats.verticesPerTriangle < 1.f);
+}
+
+static void TestThreadPool() {
+	const TestMesh mesh = CreateMesh();
+
+	WorkStealingThreadPool pool{ { .workerCount = 3u } };
+
+	const MeshletBuilder serialBuilder{ {} };
+	const MeshletBuilder parallelBuilder{ { .threadPool = &pool } };
+
+	const MeshletBuilder::MeshletData serialData = serialBuilder.BuildMeshlets(
+		mesh.vertices, mesh.indices, mesh.models
+	);
+	const MeshletBuilder::MeshletData parallelData = parallelBuilder.BuildMeshlets(
+		mesh.vertices, mesh.indices, mesh.models
+	);
+
+	CHECK(serialData.vertexIndices == parallelData.vertexIndices);
+	CHECK(serialData.primIndices == parallelData.primIndices);
+	CHECK(std::size(serialData.modelMeshlets) == std::size(parallelData.modelMeshlets));
+
+	for (size_t modelIndex = 0u; modelIndex < std::size(serialData.modelMeshlets); ++modelIndex) {
+		const std::vector<Meshlet>& serialMeshlets = serialData.modelMeshlets[modelIndex];
+		const std::vector<Meshlet>& parallelMeshlets = parallelData.modelMeshlets[modelIndex];
+
+		CHECK(
+			std::ranges::equal(
+				serialMeshlets, parallelMeshlets,
+				[](const Meshlet& left, const Meshlet& right) {
+					return left.vertexCount == right.vertexCount
+						&& left.vertexOffset == right.vertexOffset
+						&& left.primitiveCount == right.primitiveCount
+						&& left.primitiveOffset == right.primitiveOffset;
+				}
+			)
+		);
+	}
+}
+
+template<typename Function>
+static bool Throws(Function&& function) {
+	try {
+		function();
+	}
+	catch (const Exception&) {
+		return true;
+	}
+
+	return false;
+}
+
+static void TestInvalidInput() {
+	CHECK(Throws([] { MeshletBuilder{ { .maxVertices = 2u } }; }));
+	CHECK(Throws([] { MeshletBuilder{ { .maxVertices = 257u } }; }));
+	CHECK(Throws([] { MeshletBuilder{ { .maxPrimitives = 0u } }; }));
+	CHECK(Throws([] { MeshletBuilder{ { .maxPrimitives = 257u } }; }));
+
+	const TestMesh mesh = CreateMesh();
+	const MeshletBuilder builder{ {} };
+
+	// Part of a triangle.
+	CHECK(Throws([&] {
+		static_cast<void>(builder.BuildMeshlets(
+			mesh.vertices, mesh.indices, { std::make_shared<TestModel>(0u, 4u) }
+		));
+	}));
+
+	// Past the end of the indices.
+	CHECK(Throws([&] {
+		static_cast<void>(builder.BuildMeshlets(
+			mesh.vertices, mesh.indices,
+			{
+				std::make_shared<TestModel>(
+					static_cast<std::uint32_t>(std::size(mesh.indices)) - 3u, 6u
+				)
+			}
+		));
+	}));
+
+	std::vector<std::uint32_t> indices = mesh.indices;
+	indices[4] = static_cast<std::uint32_t>(std::size(mesh.vertices));
+
+	CHECK(Throws([&] {
+		static_cast<void>(builder.BuildMeshlets(mesh.vertices, indices, mesh.models));
+	}));
+}
+
+int main() {
+	TestLimits();
+	TestVertexReuse();
+	TestThreadPool();
+	TestInvalidInput();
+
+	return failedChecks;
+}
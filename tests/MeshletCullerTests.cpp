@@ -0,0 +1,234 @@
+#include <MeshletCuller.hpp>
+#include <TestModel.hpp>
+#include <TestChecks.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace DirectX;
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	float Next(float minimum, float maximum) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return minimum + (maximum - minimum) * static_cast<float>(m_state >> 8u) / 16777216.f;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+// The whole mesh as one meshlet, the meshlet vertices are the mesh's.
+struct TestMeshlet {
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> vertexIndices;
+	std::vector<std::uint32_t> primIndices;
+	Meshlet meshlet;
+};
+
+static TestMeshlet CreateMeshlet(
+	std::vector<Vertex> vertices, const std::vector<std::uint32_t>& indices
+) {
+	TestMeshlet testMeshlet{
+		.vertices = std::move(vertices), .vertexIndices = {}, .primIndices = {}, .meshlet = {}
+	};
+
+	for (std::uint32_t index = 0u; index < std::size(testMeshlet.vertices); ++index)
+		testMeshlet.vertexIndices.emplace_back(index);
+
+	for (size_t index = 0u; index < std::size(indices); index += 3u)
+		testMeshlet.primIndices.emplace_back(
+			indices[index] | indices[index + 1u] << 10u | indices[index + 2u] << 20u
+		);
+
+	testMeshlet.meshlet = Meshlet{
+		.vertexCount = static_cast<std::uint32_t>(std::size(testMeshlet.vertexIndices)),
+		.vertexOffset = 0u,
+		.primitiveCount = static_cast<std::uint32_t>(std::size(testMeshlet.primIndices)),
+		.primitiveOffset = 0u
+	};
+
+	return testMeshlet;
+}
+
+// A grid facing -Z, with its heights moved by up to bumpiness.
+static TestMeshlet CreatePatch(float bumpiness, Random& random) {
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	AppendGrid(6u, 6u, vertices, indices);
+
+	for (Vertex& vertex : vertices)
+		vertex.position.z = random.Next(-bumpiness, bumpiness);
+
+	return CreateMeshlet(std::move(vertices), indices);
+}
+
+static MeshletBounds ComputeBounds(const TestMeshlet& testMeshlet) noexcept {
+	return MeshletCuller::ComputeBounds(
+		testMeshlet.meshlet, testMeshlet.vertices, testMeshlet.vertexIndices,
+		testMeshlet.primIndices
+	);
+}
+
+// The frustum is far enough back to hold the test meshes, so only the cones cull.
+static MeshletCuller MakeCuller(const XMFLOAT3& cameraPosition) {
+	MeshletCuller culler{};
+	culler.SetCamera(
+		XMMatrixMultiply(
+			XMMatrixLookAtLH(
+				XMVectorSet(3.f, 3.f, -500.f, 1.f), XMVectorSet(3.f, 3.f, 0.f, 1.f),
+				XMVectorSet(0.f, 1.f, 0.f, 0.f)
+			),
+			XMMatrixPerspectiveFovLH(XMConvertToRadians(60.f), 1.f, 1.f, 1000.f)
+		),
+		cameraPosition
+	);
+
+	return culler;
+}
+
+static bool IsAnyTriangleFacing(const TestMeshlet& testMeshlet, const XMFLOAT3& cameraPosition) {
+	const XMVECTOR camera = XMLoadFloat3(&cameraPosition);
+
+	for (const std::uint32_t primitive : testMeshlet.primIndices) {
+		const XMVECTOR position0 = XMLoadFloat3(
+			&testMeshlet.vertices[primitive & 0x3FFu].position
+		);
+		const XMVECTOR position1 = XMLoadFloat3(
+			&testMeshlet.vertices[(primitive >> 10u) & 0x3FFu].position
+		);
+		const XMVECTOR position2 = XMLoadFloat3(
+			&testMeshlet.vertices[(primitive >> 20u) & 0x3FFu].position
+		);
+
+		const XMVECTOR normal = XMVector3Cross(
+			XMVectorSubtract(position1, position0), XMVectorSubtract(position2, position0)
+		);
+
+		if (XMVectorGetX(XMVector3Dot(XMVectorSubtract(camera, position0), normal)) > 0.f)
+			return true;
+	}
+
+	return false;
+}
+
+static void TestSphere() {
+	Random random{ 3u };
+
+	for (float bumpiness : { 0.f, 0.5f, 4.f }) {
+		const TestMeshlet testMeshlet = CreatePatch(bumpiness, random);
+		const MeshletBounds bounds = ComputeBounds(testMeshlet);
+		const XMVECTOR centre = XMLoadFloat3(&bounds.sphereCentre);
+
+		for (const Vertex& vertex : testMeshlet.vertices)
+			CHECK(
+				XMVectorGetX(
+					XMVector3Length(XMVectorSubtract(XMLoadFloat3(&vertex.position), centre))
+				) <= bounds.sphereRadius * 1.0001f
+			);
+	}
+}
+
+static void TestFlatPatch() {
+	Random random{ 5u };
+	const MeshletBounds bounds = ComputeBounds(CreatePatch(0.f, random));
+
+	CHECK(bounds.coneAxis.x == 0.f && bounds.coneAxis.y == 0.f && bounds.coneAxis.z == -1.f);
+	CHECK(bounds.coneCutoff == 0.f);
+
+	// Any camera on the back side culls it, any on the front side draws it.
+	CHECK(!MakeCuller({ 3.f, 3.f, 10.f }).IsMeshletVisible(bounds));
+	CHECK(!MakeCuller({ 50.f, -20.f, 0.5f }).IsMeshletVisible(bounds));
+	CHECK(MakeCuller({ 3.f, 3.f, -10.f }).IsMeshletVisible(bounds));
+	CHECK(MakeCuller({ 50.f, -20.f, -0.5f }).IsMeshletVisible(bounds));
+}
+
+// No meshlet may be culled while any of its triangles faces the camera.
+static void TestConservative() {
+	Random random{ 9u };
+	size_t culledCount = 0u;
+
+	for (size_t patchIndex = 0u; patchIndex < 30u; ++patchIndex) {
+		const TestMeshlet testMeshlet = CreatePatch(random.Next(0.f, 1.5f), random);
+		const MeshletBounds bounds = ComputeBounds(testMeshlet);
+
+		for (float x = -20.f; x <= 26.f; x += 2.f)
+			for (float y = -20.f; y <= 26.f; y += 2.f)
+				for (float z = -20.f; z <= 20.f; z += 2.f) {
+					const XMFLOAT3 cameraPosition{ x, y, z };
+
+					if (MakeCuller(cameraPosition).IsMeshletVisible(bounds))
+						continue;
+
+					++culledCount;
+
+					CHECK(!IsAnyTriangleFacing(testMeshlet, cameraPosition));
+				}
+	}
+
+	// The cones are narrow enough to cull a good part of the cameras behind the patches.
+	CHECK(culledCount > 10000u);
+}
+
+static void TestSpreadNormals() {
+	// A tetrahedron faces every side, so the cone can't cull it.
+	const TestMeshlet testMeshlet = CreateMeshlet(
+		{
+			Vertex{ .position = { 0.f, 0.f, 0.f }, .normal = {}, .uv = {} },
+			Vertex{ .position = { 1.f, 0.f, 0.f }, .normal = {}, .uv = {} },
+			Vertex{ .position = { 0.f, 1.f, 0.f }, .normal = {}, .uv = {} },
+			Vertex{ .position = { 0.f, 0.f, 1.f }, .normal = {}, .uv = {} }
+		},
+		{ 0u, 2u, 1u, 0u, 1u, 3u, 0u, 3u, 2u, 1u, 2u, 3u }
+	);
+	const MeshletBounds bounds = ComputeBounds(testMeshlet);
+
+	CHECK(bounds.coneCutoff > 1.f);
+
+	for (const XMFLOAT3& cameraPosition : {
+		XMFLOAT3{ 5.f, 5.f, 5.f }, XMFLOAT3{ -5.f, 0.f, 0.f }, XMFLOAT3{ 0.f, 0.f, -5.f }
+	})
+		CHECK(MakeCuller(cameraPosition).IsMeshletVisible(bounds));
+
+	// Degenerate triangles only, no cone either.
+	const MeshletBounds degenerateBounds = ComputeBounds(
+		CreateMeshlet(
+			{
+				Vertex{ .position = { 0.f, 0.f, 0.f }, .normal = {}, .uv = {} },
+				Vertex{ .position = { 1.f, 0.f, 0.f }, .normal = {}, .uv = {} },
+				Vertex{ .position = { 2.f, 0.f, 0.f }, .normal = {}, .uv = {} }
+			},
+			{ 0u, 1u, 2u }
+		)
+	);
+
+	CHECK(degenerateBounds.coneCutoff > 1.f);
+	CHECK(degenerateBounds.sphereRadius == 1.f);
+}
+
+static void TestFrustum() {
+	Random random{ 13u };
+	TestMeshlet testMeshlet = CreatePatch(0.f, random);
+
+	// Far off to the side of the frustum, the front side faces the camera.
+	for (Vertex& vertex : testMeshlet.vertices)
+		vertex.position.x += 2000.f;
+
+	const MeshletBounds bounds = ComputeBounds(testMeshlet);
+
+	CHECK(!MakeCuller({ 2003.f, 3.f, -10.f }).IsMeshletVisible(bounds));
+}
+
+int main() {
+	TestSphere();
+	TestFlatPatch();
+	TestConservative();
+	TestSpreadNormals();
+	TestFrustum();
+
+	return failedChecks;
+}
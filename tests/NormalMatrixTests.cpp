@@ -0,0 +1,138 @@
+#include <NormalMatrix.hpp>
+#include <TestChecks.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+
+static bool NearlyEqual(const XMFLOAT4X4& lhs, const XMFLOAT4X4& rhs) noexcept {
+	for (size_t row = 0u; row < 4u; ++row)
+		for (size_t column = 0u; column < 4u; ++column) {
+			const float left = lhs.m[row][column];
+			const float right = rhs.m[row][column];
+
+			if (std::abs(left - right) > 1e-3f * (1.f + std::abs(right)))
+				return false;
+		}
+
+	return true;
+}
+
+static XMFLOAT4X4 Store(const XMMATRIX& matrix) noexcept {
+	XMFLOAT4X4 result{};
+	XMStoreFloat4x4(&result, matrix);
+
+	return result;
+}
+
+// More than one AVX2 batch of eight, so the scalar tail runs as well.
+static std::vector<XMFLOAT4X4> MakeModels() {
+	std::vector<XMFLOAT4X4> models;
+
+	for (size_t index = 0u; index < 13u; ++index) {
+		const float value = static_cast<float>(index);
+
+		const XMMATRIX rotation = XMMatrixRotationRollPitchYaw(
+			0.3f * value, 0.7f - 0.1f * value, 0.2f * value
+		);
+		const XMMATRIX translation = XMMatrixTranslation(value, -2.f * value, 0.5f);
+
+		// Every third model has a uniform scale, the rest a non-uniform one.
+		const XMMATRIX scaling = index % 3u == 0u ?
+			XMMatrixScaling(1.f + value, 1.f + value, 1.f + value)
+			: XMMatrixScaling(1.f + value, 0.5f, 2.f + 0.25f * value);
+
+		models.emplace_back(
+			Store(XMMatrixMultiply(XMMatrixMultiply(scaling, rotation), translation))
+		);
+	}
+
+	// A projective model, which always takes the reference path.
+	models[5]._14 = 0.25f;
+
+	return models;
+}
+
+static void TestPathsMatchTheInverse(const XMMATRIX& viewMatrix) {
+	const std::vector<XMFLOAT4X4> models = MakeModels();
+
+	// The indices are out of order, to check they are used.
+	std::vector<std::uint32_t> indices;
+
+	for (size_t index = std::size(models); index > 0u; --index)
+		indices.emplace_back(static_cast<std::uint32_t>(index - 1u));
+
+	std::vector<XMFLOAT4X4> expected;
+
+	for (std::uint32_t index : indices) {
+		const XMMATRIX modelView = XMMatrixMultiply(XMLoadFloat4x4(&models[index]), viewMatrix);
+
+		expected.emplace_back(Store(XMMatrixTranspose(XMMatrixInverse(nullptr, modelView))));
+	}
+
+	const NormalMatrixPath paths[]{
+		NormalMatrixPath::Reference, NormalMatrixPath::Affine, NormalMatrixPath::AffineAVX2
+	};
+
+	for (NormalMatrixPath path : paths) {
+		SetNormalMatrixPath(path);
+
+		std::vector<XMFLOAT4X4> normalMatrices(std::size(indices));
+
+		ComputeNormalMatrices(
+			std::data(models), std::data(indices), std::size(indices), viewMatrix,
+			std::data(normalMatrices)
+		);
+
+		for (size_t index = 0u; index < std::size(indices); ++index)
+			CHECK(NearlyEqual(normalMatrices[index], expected[index]));
+	}
+}
+
+static void TestUniformScale() {
+	SetNormalMatrixPath(NormalMatrixPath::Affine);
+
+	const XMFLOAT4X4 model = Store(XMMatrixScaling(2.f, 2.f, 2.f));
+	const std::uint32_t index = 0u;
+	XMFLOAT4X4 normalMatrix{};
+
+	ComputeNormalMatrices(&model, &index, 1u, XMMatrixIdentity(), &normalMatrix);
+
+	CHECK(std::abs(normalMatrix._11 - 0.5f) < 1e-6f);
+	CHECK(std::abs(normalMatrix._22 - 0.5f) < 1e-6f);
+	CHECK(std::abs(normalMatrix._33 - 0.5f) < 1e-6f);
+	CHECK(normalMatrix._44 == 1.f);
+}
+
+static void TestPathSelection() {
+	SetNormalMatrixPath(NormalMatrixPath::AffineAVX2);
+
+	CHECK(
+		GetNormalMatrixPath() ==
+		(IsAVX2Supported() ? NormalMatrixPath::AffineAVX2 : NormalMatrixPath::Affine)
+	);
+
+	SetNormalMatrixPath(NormalMatrixPath::Reference);
+
+	CHECK(GetNormalMatrixPath() == NormalMatrixPath::Reference);
+}
+
+int main() {
+	TestPathsMatchTheInverse(XMMatrixIdentity());
+	TestPathsMatchTheInverse(
+		XMMatrixLookAtLH(
+			XMVectorSet(3.f, 4.f, -10.f, 1.f), XMVectorZero(), XMVectorSet(0.f, 1.f, 0.f, 0.f)
+		)
+	);
+	// A projective view has to fall back to the reference path.
+	TestPathsMatchTheInverse(
+		XMMatrixMultiply(
+			XMMatrixTranslation(0.f, 0.f, 5.f),
+			XMMatrixPerspectiveFovLH(XMConvertToRadians(60.f), 1.f, 0.1f, 100.f)
+		)
+	);
+	TestUniformScale();
+	TestPathSelection();
+
+	return failedChecks;
+}
@@ -0,0 +1,246 @@
+#include <OffsetAllocator.hpp>
+#include <SizeHelpers.hpp>
+#include <TestChecks.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+static void TestFullCapacity() {
+	{
+		OffsetAllocator allocator{ 1000u };
+
+		const std::optional<OffsetAllocator::Allocation> allocation = allocator.Allocate(1000u, 1u);
+
+		CHECK(allocation.has_value() && allocation->offset == 0u);
+		CHECK(!allocator.Allocate(1u, 1u).has_value());
+		CHECK(allocator.GetStats().freeSize == 0u);
+	}
+
+	// Every size, including the ones which aren't the smallest of their bin.
+	for (size_t capacity = 1u; capacity < 5000u; capacity += 7u) {
+		OffsetAllocator allocator{ capacity };
+
+		CHECK(allocator.Allocate(capacity, 1u).has_value());
+	}
+
+	// Blocks aligned to their own size fill a region of a multiple of that size.
+	{
+		OffsetAllocator allocator{ 5u * 64_KB };
+
+		for (size_t index = 0u; index < 5u; ++index) {
+			const std::optional<OffsetAllocator::Allocation> allocation =
+				allocator.Allocate(64_KB, 64_KB);
+
+			CHECK(allocation.has_value() && allocation->offset == index * 64_KB);
+		}
+
+		CHECK(!allocator.Allocate(1u, 1u).has_value());
+	}
+}
+
+static void TestExactFitAfterFree() {
+	OffsetAllocator allocator{ 3000u };
+
+	const OffsetAllocator::Allocation first = *allocator.Allocate(1000u, 1u);
+	const OffsetAllocator::Allocation second = *allocator.Allocate(1000u, 1u);
+	const OffsetAllocator::Allocation third = *allocator.Allocate(1000u, 1u);
+
+	allocator.Free(second.handle);
+
+	const std::optional<OffsetAllocator::Allocation> reused = allocator.Allocate(1000u, 1u);
+
+	CHECK(reused.has_value() && reused->offset == second.offset);
+
+	// The free block is aligned, but the search has to check its padding is 0.
+	allocator.Free(reused->handle);
+
+	const std::optional<OffsetAllocator::Allocation> aligned = allocator.Allocate(1000u, 8u);
+
+	CHECK(aligned.has_value() && aligned->offset == 1000u);
+
+	allocator.Free(first.handle);
+	allocator.Free(third.handle);
+	allocator.Free(aligned->handle);
+
+	CHECK(allocator.GetStats().freeBlockCount == 1u);
+	CHECK(allocator.GetStats().largestFreeBlock == 3000u);
+}
+
+static void TestAlignment() {
+	OffsetAllocator allocator{ 4096u };
+
+	const OffsetAllocator::Allocation unaligned = *allocator.Allocate(3u, 1u);
+	const std::optional<OffsetAllocator::Allocation> aligned = allocator.Allocate(100u, 256u);
+
+	CHECK(unaligned.offset == 0u);
+	CHECK(aligned.has_value() && aligned->offset == 256u);
+
+	// The padding before the aligned block and the rest after it are both free.
+	const std::optional<OffsetAllocator::Allocation> rest = allocator.Allocate(3740u, 1u);
+	const std::optional<OffsetAllocator::Allocation> padding = allocator.Allocate(253u, 1u);
+
+	CHECK(rest.has_value() && rest->offset == 356u);
+	CHECK(padding.has_value() && padding->offset == 3u);
+
+	const OffsetAllocator::Stats stats = allocator.GetStats();
+
+	CHECK(stats.usedSize == 4096u);
+	CHECK(stats.allocationCount == 4u);
+}
+
+static void TestGrow() {
+	OffsetAllocator allocator{};
+
+	const OffsetAllocator::Allocation first = allocator.AllocateAndGrow(100u, 1u);
+	const OffsetAllocator::Allocation second = allocator.AllocateAndGrow(100u, 64u);
+
+	CHECK(first.offset == 0u);
+	CHECK(second.offset == 128u);
+	CHECK(allocator.GetCapacity() == 228u);
+
+	allocator.Free(second.handle);
+
+	// The free tail is extended instead of leaving a gap.
+	const OffsetAllocator::Allocation third = allocator.AllocateAndGrow(200u, 1u);
+
+	CHECK(third.offset == 100u);
+	CHECK(allocator.GetCapacity() == 300u);
+
+	allocator.Grow(1000u);
+
+	CHECK(allocator.Allocate(700u, 1u).has_value());
+}
+
+// Like the spare capacity of the heaps and the vertex buffer, which is added after the initial
+// reservations.
+static void TestSpareSpace() {
+	{
+		OffsetAllocator allocator{};
+
+		static_cast<void>(allocator.AllocateAndGrow(1000u, 256u));
+		static_cast<void>(allocator.AllocateAndGrow(70000u, 64_KB));
+		static_cast<void>(allocator.AllocateAndGrow(300u, 4u));
+
+		allocator.AddSpareSpace(3u * 64_KB, 64_KB);
+
+		const std::optional<OffsetAllocator::Allocation> first = allocator.Allocate(128_KB, 64_KB);
+		const std::optional<OffsetAllocator::Allocation> second = allocator.Allocate(64_KB, 64_KB);
+
+		CHECK(first.has_value() && second.has_value());
+
+		allocator.Free(first->handle);
+		allocator.Free(second->handle);
+
+		for (size_t index = 0u; index < 3u; ++index)
+			CHECK(allocator.Allocate(64_KB, 64_KB).has_value());
+	}
+
+	{
+		OffsetAllocator allocator{};
+
+		static_cast<void>(allocator.AllocateAndGrow(137u, 1u));
+		static_cast<void>(allocator.AllocateAndGrow(55u, 1u));
+
+		allocator.AddSpareSpace(500u, 1u);
+
+		const std::optional<OffsetAllocator::Allocation> first = allocator.Allocate(200u, 1u);
+		const std::optional<OffsetAllocator::Allocation> second = allocator.Allocate(300u, 1u);
+
+		CHECK(first.has_value() && second.has_value());
+		CHECK(allocator.GetStats().freeSize == 0u);
+
+		allocator.Free(first->handle);
+
+		CHECK(allocator.Allocate(150u, 1u).has_value());
+		CHECK(allocator.Allocate(50u, 1u).has_value());
+	}
+}
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+static void TestRandomAllocations() {
+	struct Range {
+		size_t offset;
+		size_t size;
+		std::uint32_t handle;
+	};
+
+	static constexpr size_t capacity = 1_MB;
+
+	Random random{ 11u };
+	OffsetAllocator allocator{ capacity };
+	std::vector<Range> ranges;
+
+	for (size_t step = 0u; step < 20000u; ++step) {
+		if (!std::empty(ranges) && random.Next(5u) < 2u) {
+			const size_t index = random.Next(static_cast<std::uint32_t>(std::size(ranges)));
+
+			allocator.Free(ranges[index].handle);
+
+			ranges[index] = ranges.back();
+			ranges.pop_back();
+
+			continue;
+		}
+
+		const size_t size = 1u + random.Next(random.Next(4u) ? 512u : 16_KB);
+		const size_t alignment = size_t{ 1u } << random.Next(9u);
+
+		if (const std::optional<OffsetAllocator::Allocation> allocation =
+			allocator.Allocate(size, alignment); allocation) {
+			CHECK(allocation->offset % alignment == 0u);
+			CHECK(allocation->offset + size <= capacity);
+
+			ranges.emplace_back(allocation->offset, size, allocation->handle);
+		}
+	}
+
+	std::ranges::sort(ranges, {}, &Range::offset);
+
+	size_t usedSize = 0u;
+
+	for (size_t index = 0u; index < std::size(ranges); ++index) {
+		usedSize += ranges[index].size;
+
+		if (index)
+			CHECK(ranges[index - 1u].offset + ranges[index - 1u].size <= ranges[index].offset);
+	}
+
+	CHECK(allocator.GetStats().usedSize == usedSize);
+	CHECK(allocator.GetStats().allocationCount == std::size(ranges));
+
+	for (const Range& range : ranges)
+		allocator.Free(range.handle);
+
+	const OffsetAllocator::Stats stats = allocator.GetStats();
+
+	CHECK(stats.freeBlockCount == 1u);
+	CHECK(stats.largestFreeBlock == capacity);
+	CHECK(allocator.GetFragmentation() == 0.f);
+	CHECK(allocator.Allocate(capacity, 1u).has_value());
+}
+
+int main() {
+	TestFullCapacity();
+	TestExactFitAfterFree();
+	TestAlignment();
+	TestGrow();
+	TestSpareSpace();
+	TestRandomAllocations();
+
+	return failedChecks;
+}
@@ -0,0 +1,170 @@
+#include <PipelineCacheFile.hpp>
+#include <PipelineHasher.hpp>
+#include <TestChecks.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+static void TestHasher() {
+	// The FNV-1a test vectors.
+	CHECK(PipelineHasher{}.GetHash() == 0xCBF29CE484222325u);
+	CHECK(PipelineHasher{}.AddBytes("a", 1u).GetHash() == 0xAF63DC4C8601EC8Cu);
+	CHECK(PipelineHasher{}.AddBytes("foobar", 6u).GetHash() == 0x85944171F73967E8u);
+
+	const std::uint32_t value = 0x01020304u;
+
+	CHECK(
+		PipelineHasher{}.AddValue(value).GetHash()
+		== PipelineHasher{}.AddBytes(&value, sizeof(value)).GetHash()
+	);
+
+	// The lengths keep the strings apart.
+	CHECK(
+		PipelineHasher{}.AddString("ab").AddString("c").GetHash()
+		!= PipelineHasher{}.AddString("a").AddString("bc").GetHash()
+	);
+	CHECK(
+		PipelineHasher{}.AddString(nullptr).GetHash() == PipelineHasher{}.AddString("").GetHash()
+	);
+	CHECK(PipelineHasher{}.AddString("").GetHash() != PipelineHasher{}.GetHash());
+}
+
+static PipelineCacheData MakeCacheData() {
+	PipelineCacheData cacheData{
+		.pipelineKeys = { 0x0123456789ABCDEFu, 42u, 0xFFFFFFFFFFFFFFFFu }, .library = {}
+	};
+
+	for (size_t index = 0u; index < 1000u; ++index)
+		cacheData.library.emplace_back(static_cast<std::uint8_t>(index * 7u));
+
+	return cacheData;
+}
+
+static bool IsSameData(const PipelineCacheData& left, const PipelineCacheData& right) {
+	return left.pipelineKeys == right.pipelineKeys && left.library == right.library;
+}
+
+static void TestRoundTrip() {
+	const PipelineCacheFile cacheFile{ 0xDEADBEEFu };
+	const PipelineCacheData cacheData = MakeCacheData();
+
+	const std::vector<std::uint8_t> fileData = cacheFile.Serialise(cacheData);
+
+	CHECK(std::size(fileData) == 40u + 3u * 8u + 1000u);
+	// "GXPC" and the version, little endian.
+	CHECK(fileData[0] == 'G' && fileData[1] == 'X' && fileData[2] == 'P' && fileData[3] == 'C');
+	CHECK(fileData[4] == PipelineCacheFile::s_formatVersion && fileData[5] == 0u);
+
+	PipelineCacheData readData{};
+
+	CHECK(cacheFile.Deserialise(fileData, readData));
+	CHECK(IsSameData(readData, cacheData));
+
+	const PipelineCacheData emptyData{};
+
+	CHECK(cacheFile.Deserialise(cacheFile.Serialise(emptyData), readData));
+	CHECK(IsSameData(readData, emptyData));
+}
+
+static void TestRejected() {
+	const PipelineCacheFile cacheFile{ 0xDEADBEEFu };
+	const PipelineCacheData cacheData = MakeCacheData();
+	const std::vector<std::uint8_t> fileData = cacheFile.Serialise(cacheData);
+
+	// A rejected file leaves the data as it was.
+	auto isRejected = [&cacheFile, &cacheData](const std::vector<std::uint8_t>& changedData) {
+		PipelineCacheData readData = cacheData;
+
+		return !cacheFile.Deserialise(changedData, readData) && IsSameData(readData, cacheData);
+	};
+
+	// Another adapter or driver.
+	CHECK(isRejected(PipelineCacheFile{ 0xDEADBEEEu }.Serialise(cacheData)));
+
+	auto changeByte = [&fileData](size_t offset) {
+		std::vector<std::uint8_t> changedData = fileData;
+		changedData[offset] ^= 0x10u;
+
+		return changedData;
+	};
+
+	// The magic, the version, the key count, the library size, the checksum, a key and a
+	// byte of the library.
+	for (size_t offset : { 1u, 4u, 16u, 24u, 32u, 45u, 40u + 24u + 500u })
+		CHECK(isRejected(changeByte(offset)));
+
+	// A key count which would wrap the size around.
+	{
+		std::vector<std::uint8_t> changedData = fileData;
+
+		for (size_t offset = 16u; offset < 24u; ++offset)
+			changedData[offset] = 0xFFu;
+
+		CHECK(isRejected(changedData));
+	}
+
+	std::vector<std::uint8_t> truncatedData = fileData;
+	truncatedData.pop_back();
+
+	CHECK(isRejected(truncatedData));
+
+	std::vector<std::uint8_t> extendedData = fileData;
+	extendedData.emplace_back(0u);
+
+	CHECK(isRejected(extendedData));
+	CHECK(isRejected(std::vector<std::uint8_t>(std::begin(fileData), std::begin(fileData) + 39)));
+	CHECK(isRejected({}));
+}
+
+static void TestFiles() {
+	const std::filesystem::path directory =
+		std::filesystem::temp_directory_path() / "GaiaXPipelineCacheFileTests";
+
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	const std::filesystem::path filePath = directory / "pipelines.cache";
+	const PipelineCacheFile cacheFile{ 7u };
+	PipelineCacheData readData{};
+
+	CHECK(!cacheFile.Read(filePath, readData));
+
+	PipelineCacheData cacheData = MakeCacheData();
+
+	CHECK(cacheFile.Write(filePath, cacheData));
+	CHECK(cacheFile.Read(filePath, readData));
+	CHECK(IsSameData(readData, cacheData));
+
+	// Replaced, with no temporary file left behind.
+	cacheData.pipelineKeys.pop_back();
+	cacheData.library.resize(10u);
+
+	CHECK(cacheFile.Write(filePath, cacheData));
+	CHECK(cacheFile.Read(filePath, readData));
+	CHECK(IsSameData(readData, cacheData));
+	CHECK(!std::filesystem::exists(directory / "pipelines.cache.tmp"));
+
+	CHECK(!PipelineCacheFile{ 8u }.Read(filePath, readData));
+
+	{
+		std::ofstream file{ filePath, std::ios_base::binary | std::ios_base::app };
+		file.put('x');
+	}
+
+	CHECK(!cacheFile.Read(filePath, readData));
+
+	// The directory doesn't exist.
+	CHECK(!cacheFile.Write(directory / "missing" / "pipelines.cache", cacheData));
+
+	std::filesystem::remove_all(directory);
+}
+
+int main() {
+	TestHasher();
+	TestRoundTrip();
+	TestRejected();
+	TestFiles();
+
+	return failedChecks;
+}
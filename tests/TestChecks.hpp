@@ -0,0 +1,15 @@
+#ifndef TEST_CHECKS_HPP_
+#define TEST_CHECKS_HPP_
+#include <cstdio>
+
+// The tests go on after a failed check, main returns the count.
+inline int failedChecks = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			++failedChecks; \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+		} \
+	} while (false)
+#endif
@@ -0,0 +1,79 @@
+#ifndef TEST_MODEL_HPP_
+#define TEST_MODEL_HPP_
+#include <IModel.hpp>
+#include <cstdint>
+#include <vector>
+
+// Only the index range and the bounds are used by the tests.
+class TestModel final : public IModel {
+public:
+	TestModel(
+		std::uint32_t indexOffset, std::uint32_t indexCount, const ModelBounds& bounds = {}
+	) noexcept : m_indexOffset{ indexOffset }, m_indexCount{ indexCount }, m_bounds{ bounds } {}
+
+	[[nodiscard]]
+	std::uint32_t GetIndexCount() const noexcept override { return m_indexCount; }
+	[[nodiscard]]
+	std::uint32_t GetIndexOffset() const noexcept override { return m_indexOffset; }
+	[[nodiscard]]
+	std::uint32_t GetDiffuseTexIndex() const noexcept override { return 0u; }
+	[[nodiscard]]
+	UVInfo GetDiffuseTexUVInfo() const noexcept override { return {}; }
+	[[nodiscard]]
+	std::uint32_t GetSpecularTexIndex() const noexcept override { return 0u; }
+	[[nodiscard]]
+	UVInfo GetSpecularTexUVInfo() const noexcept override { return {}; }
+	[[nodiscard]]
+	DirectX::XMMATRIX GetModelMatrix() const noexcept override {
+		return DirectX::XMMatrixIdentity();
+	}
+	[[nodiscard]]
+	DirectX::XMFLOAT3 GetModelOffset() const noexcept override { return {}; }
+	[[nodiscard]]
+	ModelBounds GetBoundingBox() const noexcept override { return m_bounds; }
+	[[nodiscard]]
+	Material GetMaterial() const noexcept override { return {}; }
+	[[nodiscard]]
+	bool IsLightSource() const noexcept override { return false; }
+
+private:
+	std::uint32_t m_indexOffset;
+	std::uint32_t m_indexCount;
+	ModelBounds m_bounds;
+};
+
+// A grid of quads in the XY plane with two triangles each, its indices are appended after the
+// ones already there and start at the first vertex appended.
+inline void AppendGrid(
+	size_t columns, size_t rows, std::vector<Vertex>& vertices,
+	std::vector<std::uint32_t>& indices
+) {
+	const auto firstVertex = static_cast<std::uint32_t>(std::size(vertices));
+
+	for (size_t row = 0u; row <= rows; ++row)
+		for (size_t column = 0u; column <= columns; ++column)
+			vertices.emplace_back(
+				Vertex{
+					.position = { static_cast<float>(column), static_cast<float>(row), 0.f },
+					.normal = { 0.f, 0.f, -1.f },
+					.uv = {
+						static_cast<float>(column) / static_cast<float>(columns),
+						static_cast<float>(row) / static_cast<float>(rows)
+					}
+				}
+			);
+
+	const auto stride = static_cast<std::uint32_t>(columns + 1u);
+
+	for (size_t row = 0u; row < rows; ++row)
+		for (size_t column = 0u; column < columns; ++column) {
+			const auto corner = firstVertex + static_cast<std::uint32_t>(row * stride + column);
+
+			indices.insert(
+				std::end(indices),
+				{ corner, corner + stride, corner + 1u, corner + 1u, corner + stride,
+					corner + stride + 1u }
+			);
+		}
+}
+#endif
@@ -0,0 +1,133 @@
+#include <UploadRingAllocator.hpp>
+#include <TestChecks.hpp>
+#include <cstdint>
+#include <deque>
+
+static void TestRegions() {
+	UploadRingAllocator allocator{ 1024u };
+
+	CHECK(allocator.Allocate(100u, 1u, 1u) == 0u);
+	CHECK(allocator.Allocate(100u, 64u, 1u) == 128u);
+	CHECK(allocator.GetRegionCount() == 1u);
+	CHECK(allocator.GetUsedSize() == 228u);
+
+	CHECK(allocator.Allocate(700u, 256u, 2u) == 256u);
+	CHECK(allocator.GetRegionCount() == 2u);
+
+	// Wrapping around would run into the first region, which is still in use.
+	CHECK(!allocator.Allocate(100u, 1u, 3u).has_value());
+
+	allocator.Reclaim(1u);
+
+	CHECK(allocator.GetUsedSize() == 728u);
+	// The skipped end of the ring counts as used until the region is reclaimed.
+	CHECK(allocator.Allocate(100u, 1u, 3u) == 0u);
+	CHECK(allocator.GetUsedSize() == 896u);
+
+	allocator.Reclaim(3u);
+
+	CHECK(allocator.GetUsedSize() == 0u);
+	CHECK(allocator.GetRegionCount() == 0u);
+	// Starts over once the ring is empty.
+	CHECK(allocator.Allocate(1024u, 1u, 4u) == 0u);
+	CHECK(!allocator.Allocate(1u, 1u, 4u).has_value());
+}
+
+static void TestTooLarge() {
+	UploadRingAllocator allocator{ 256u };
+
+	CHECK(!allocator.Allocate(257u, 1u, 1u).has_value());
+	CHECK(allocator.GetUsedSize() == 0u);
+
+	allocator.SetCapacity(512u);
+
+	CHECK(allocator.Allocate(257u, 1u, 1u) == 0u);
+
+	// Setting the capacity drops every allocation.
+	allocator.SetCapacity(512u);
+
+	CHECK(allocator.GetUsedSize() == 0u);
+	CHECK(allocator.GetRegionCount() == 0u);
+}
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+// Frames allocate and the GPU completes them a few frames later, none of the allocations which
+// are still in flight may overlap.
+static void TestFrames() {
+	struct Range {
+		size_t offset;
+		size_t size;
+		std::uint64_t fenceValue;
+	};
+
+	static constexpr size_t capacity = 64u * 1024u;
+
+	Random random{ 5u };
+	UploadRingAllocator allocator{ capacity };
+	std::deque<Range> ranges;
+	size_t failedAllocations = 0u;
+
+	for (std::uint64_t fenceValue = 1u; fenceValue < 2000u; ++fenceValue) {
+		const size_t allocationCount = random.Next(6u);
+
+		for (size_t index = 0u; index < allocationCount; ++index) {
+			const size_t size = 1u + random.Next(16384u);
+			const size_t alignment = size_t{ 1u } << random.Next(9u);
+
+			const std::optional<size_t> offset = allocator.Allocate(size, alignment, fenceValue);
+
+			if (!offset) {
+				++failedAllocations;
+
+				continue;
+			}
+
+			CHECK(*offset % alignment == 0u);
+			CHECK(*offset + size <= capacity);
+
+			for (const Range& range : ranges)
+				CHECK(*offset + size <= range.offset || range.offset + range.size <= *offset);
+
+			ranges.emplace_back(*offset, size, fenceValue);
+		}
+
+		if (fenceValue > 3u) {
+			const std::uint64_t completedFenceValue = fenceValue - 3u;
+
+			allocator.Reclaim(completedFenceValue);
+
+			while (!std::empty(ranges) && ranges.front().fenceValue <= completedFenceValue)
+				ranges.pop_front();
+		}
+	}
+
+	// The ring is small enough for a few allocations to wait for a later frame.
+	CHECK(failedAllocations > 0u);
+
+	allocator.Reclaim(2000u);
+
+	CHECK(allocator.GetUsedSize() == 0u);
+}
+
+int main() {
+	TestRegions();
+	TestTooLarge();
+	TestFrames();
+
+	return failedChecks;
+}
@@ -0,0 +1,282 @@
+#include <VertexCacheOptimiser.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <Exception.hpp>
+#include <TestModel.hpp>
+#include <TestChecks.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	std::uint32_t Next(std::uint32_t bound) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return (m_state >> 8u) % bound;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+struct TestMesh {
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	std::vector<std::shared_ptr<IModel>> models;
+};
+
+// Grids with their triangles shuffled, so there is something to optimise. Each grid is at a
+// different depth, so no two vertices have the same position.
+static TestMesh CreateMesh(Random& random) {
+	TestMesh mesh{};
+
+	const std::array<std::array<size_t, 2u>, 4u> gridSizes{ {
+		{ 1u, 1u }, { 16u, 16u }, { 40u, 3u }, { 30u, 30u }
+	} };
+
+	for (const auto& [columns, rows] : gridSizes) {
+		const size_t firstVertex = std::size(mesh.vertices);
+		const auto indexOffset = static_cast<std::uint32_t>(std::size(mesh.indices));
+
+		AppendGrid(columns, rows, mesh.vertices, mesh.indices);
+
+		for (size_t index = firstVertex; index < std::size(mesh.vertices); ++index)
+			mesh.vertices[index].position.z = static_cast<float>(std::size(mesh.models));
+
+		const auto indexCount = static_cast<std::uint32_t>(std::size(mesh.indices)) - indexOffset;
+
+		for (std::uint32_t triangle = indexCount / 3u - 1u; triangle > 0u; --triangle) {
+			const std::uint32_t other = random.Next(triangle + 1u);
+
+			std::swap_ranges(
+				std::begin(mesh.indices) + indexOffset + triangle * 3u,
+				std::begin(mesh.indices) + indexOffset + triangle * 3u + 3u,
+				std::begin(mesh.indices) + indexOffset + other * 3u
+			);
+		}
+
+		mesh.models.emplace_back(std::make_shared<TestModel>(indexOffset, indexCount));
+	}
+
+	// An unused vertex, which stays after the used ones.
+	mesh.vertices.emplace_back(Vertex{ .position = { -1.f, -1.f, -1.f }, .normal = {}, .uv = {} });
+
+	return mesh;
+}
+
+using Position = std::array<float, 3u>;
+using Triangle = std::array<Position, 3u>;
+
+// By position, as the vertices are renumbered. Rotated so the smallest corner is first, the
+// winding is kept.
+static std::vector<Triangle> GetModelTriangles(const TestMesh& mesh, const IModel& model) {
+	std::vector<Triangle> triangles;
+
+	for (std::uint32_t index = 0u; index < model.GetIndexCount(); index += 3u) {
+		Triangle triangle{};
+
+		for (size_t corner = 0u; corner < 3u; ++corner) {
+			const DirectX::XMFLOAT3& position = mesh.vertices[
+				mesh.indices[model.GetIndexOffset() + index + corner]
+			].position;
+
+			triangle[corner] = { position.x, position.y, position.z };
+		}
+
+		std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+		triangles.emplace_back(triangle);
+	}
+
+	std::ranges::sort(triangles);
+
+	return triangles;
+}
+
+static std::vector<Position> GetPositions(const std::vector<Vertex>& vertices) {
+	std::vector<Position> positions;
+
+	for (const Vertex& vertex : vertices)
+		positions.emplace_back(Position{ vertex.position.x, vertex.position.y, vertex.position.z });
+
+	std::ranges::sort(positions);
+
+	return positions;
+}
+
+static void TestOptimise(bool optimiseOverdraw, bool reorderVertices) {
+	Random random{ 17u };
+	const TestMesh input = CreateMesh(random);
+	TestMesh mesh = input;
+
+	const VertexCacheOptimiser optimiser{
+		{ .optimiseOverdraw = optimiseOverdraw, .reorderVertices = reorderVertices }
+	};
+	const VertexCacheOptimiser::CacheStats inputStats = optimiser.GetCacheStats(
+		input.indices, input.models
+	);
+	const VertexCacheOptimiser::OptimisationStats stats = optimiser.Optimise(
+		mesh.vertices, mesh.indices, mesh.models
+	);
+
+	CHECK(stats.before.acmr == inputStats.acmr && stats.before.atvr == inputStats.atvr);
+	CHECK(stats.after.acmr < stats.before.acmr * 0.5f);
+	CHECK(stats.after.acmr < 0.8f);
+	CHECK(stats.after.atvr >= 1.f && stats.after.atvr < 1.4f);
+
+	const VertexCacheOptimiser::CacheStats outputStats = optimiser.GetCacheStats(
+		mesh.indices, mesh.models
+	);
+
+	CHECK(stats.after.acmr == outputStats.acmr && stats.after.atvr == outputStats.atvr);
+
+	// The same vertices and the same triangles of each model, in its own index range.
+	CHECK(std::size(mesh.indices) == std::size(input.indices));
+	CHECK(GetPositions(mesh.vertices) == GetPositions(input.vertices));
+
+	for (const std::shared_ptr<IModel>& model : mesh.models)
+		CHECK(GetModelTriangles(mesh, *model) == GetModelTriangles(input, *model));
+
+	// Without the renumbering, the vertices don't move.
+	if (!reorderVertices) {
+		CHECK(
+			std::ranges::equal(
+				mesh.vertices, input.vertices, [](const Vertex& left, const Vertex& right) {
+					return left.position.x == right.position.x
+						&& left.position.y == right.position.y
+						&& left.position.z == right.position.z;
+				}
+			)
+		);
+
+		return;
+	}
+
+	// Numbered in the order they are first used.
+	std::uint32_t nextIndex = 0u;
+
+	for (std::uint32_t index : mesh.indices)
+		if (index == nextIndex)
+			++nextIndex;
+		else
+			CHECK(index < nextIndex);
+
+	CHECK(nextIndex == std::size(mesh.vertices) - 1u);
+	CHECK(mesh.vertices.back().position.x == -1.f);
+}
+
+static void TestThreadPool() {
+	Random random{ 23u };
+	TestMesh serialMesh = CreateMesh(random);
+	TestMesh parallelMesh = serialMesh;
+
+	WorkStealingThreadPool pool{ { .workerCount = 3u } };
+
+	static_cast<void>(VertexCacheOptimiser{ {} }.Optimise(
+		serialMesh.vertices, serialMesh.indices, serialMesh.models
+	));
+	static_cast<void>(VertexCacheOptimiser{ { .threadPool = &pool } }.Optimise(
+		parallelMesh.vertices, parallelMesh.indices, parallelMesh.models
+	));
+
+	CHECK(serialMesh.indices == parallelMesh.indices);
+	CHECK(
+		std::ranges::equal(
+			serialMesh.vertices, parallelMesh.vertices,
+			[](const Vertex& left, const Vertex& right) {
+				return left.position.x == right.position.x && left.position.y == right.position.y
+					&& left.position.z == right.position.z;
+			}
+		)
+	);
+}
+
+static void TestSharedRanges() {
+	Random random{ 29u };
+	TestMesh mesh = CreateMesh(random);
+
+	// A second model drawing the same triangles is optimised once.
+	mesh.models.emplace_back(
+		std::make_shared<TestModel>(
+			mesh.models[1]->GetIndexOffset(), mesh.models[1]->GetIndexCount()
+		)
+	);
+
+	const TestMesh input = mesh;
+
+	static_cast<void>(VertexCacheOptimiser{ {} }.Optimise(
+		mesh.vertices, mesh.indices, mesh.models
+	));
+
+	CHECK(
+		GetModelTriangles(mesh, *mesh.models.back())
+		== GetModelTriangles(input, *mesh.models[1])
+	);
+}
+
+template<typename Function>
+static bool Throws(Function&& function) {
+	try {
+		function();
+	}
+	catch (const Exception&) {
+		return true;
+	}
+
+	return false;
+}
+
+static void TestInvalidInput() {
+	CHECK(Throws([] { VertexCacheOptimiser{ { .cacheSize = 2u } }; }));
+
+	Random random{ 31u };
+	const TestMesh input = CreateMesh(random);
+	const VertexCacheOptimiser optimiser{ {} };
+
+	auto optimise = [&](std::vector<std::uint32_t> indices,
+		const std::vector<std::shared_ptr<IModel>>& models) {
+		std::vector<Vertex> vertices = input.vertices;
+
+		static_cast<void>(optimiser.Optimise(vertices, indices, models));
+	};
+
+	// Part of a triangle, past the end of the indices and two partly overlapping models.
+	CHECK(Throws([&] { optimise(input.indices, { std::make_shared<TestModel>(0u, 4u) }); }));
+	CHECK(Throws([&] {
+		optimise(
+			input.indices,
+			{
+				std::make_shared<TestModel>(
+					static_cast<std::uint32_t>(std::size(input.indices)) - 3u, 6u
+				)
+			}
+		);
+	}));
+	CHECK(Throws([&] {
+		optimise(
+			input.indices,
+			{ std::make_shared<TestModel>(0u, 12u), std::make_shared<TestModel>(6u, 12u) }
+		);
+	}));
+
+	std::vector<std::uint32_t> indices = input.indices;
+	indices[7] = static_cast<std::uint32_t>(std::size(input.vertices));
+
+	CHECK(Throws([&] { optimise(indices, input.models); }));
+}
+
+int main() {
+	TestOptimise(true, true);
+	TestOptimise(false, true);
+	TestOptimise(true, false);
+	TestThreadPool();
+	TestSharedRanges();
+	TestInvalidInput();
+
+	return failedChecks;
+}
@@ -0,0 +1,308 @@
+#include <VertexPacker.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <Exception.hpp>
+#include <TestModel.hpp>
+#include <TestChecks.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace DirectX;
+
+// A fixed sequence, so a failure can be reproduced.
+class Random {
+public:
+	Random(std::uint32_t seed) noexcept : m_state{ seed } {}
+
+	[[nodiscard]]
+	float Next(float minimum, float maximum) noexcept {
+		m_state = m_state * 1664525u + 1013904223u;
+
+		return minimum + (maximum - minimum) * static_cast<float>(m_state >> 8u) / 16777216.f;
+	}
+
+private:
+	std::uint32_t m_state;
+};
+
+static XMFLOAT3 RandomNormal(Random& random) noexcept {
+	XMFLOAT3 normal{};
+
+	XMStoreFloat3(
+		&normal,
+		XMVector3Normalize(
+			XMVectorSet(
+				random.Next(-1.f, 1.f), random.Next(-1.f, 1.f), random.Next(-1.f, 1.f), 0.f
+			)
+		)
+	);
+
+	return normal;
+}
+
+// From the cross product as well, as the arc cosine is too coarse for small angles.
+static float GetAngle(const XMFLOAT3& normal1, const XMFLOAT3& normal2) noexcept {
+	const XMVECTOR vector1 = XMLoadFloat3(&normal1);
+	const XMVECTOR vector2 = XMLoadFloat3(&normal2);
+
+	return XMConvertToDegrees(
+		std::atan2(
+			XMVectorGetX(XMVector3Length(XMVector3Cross(vector1, vector2))),
+			XMVectorGetX(XMVector3Dot(vector1, vector2))
+		)
+	);
+}
+
+static void TestRoundTrip() {
+	Random random{ 37u };
+
+	const ModelBounds bounds{
+		.positiveAxes = { 10.f, 2.f, 0.5f }, .negativeAxes = { -30.f, -2.f, -0.5f }
+	};
+
+	for (size_t index = 0u; index < 10000u; ++index) {
+		const Vertex vertex{
+			.position = {
+				random.Next(-30.f, 10.f), random.Next(-2.f, 2.f), random.Next(-0.5f, 0.5f)
+			},
+			.normal = RandomNormal(random),
+			.uv = { random.Next(0.f, 1.f), random.Next(0.f, 1.f) }
+		};
+
+		const Vertex unpackedVertex = VertexPacker::UnpackVertex(
+			VertexPacker::PackVertex(vertex, bounds), bounds
+		);
+
+		// Half a step of 16 bits over each axis of the box.
+		CHECK(std::abs(unpackedVertex.position.x - vertex.position.x) <= 40.f / 65535.f);
+		CHECK(std::abs(unpackedVertex.position.y - vertex.position.y) <= 4.f / 65535.f);
+		CHECK(std::abs(unpackedVertex.position.z - vertex.position.z) <= 1.f / 65535.f);
+		CHECK(GetAngle(unpackedVertex.normal, vertex.normal) < 0.01f);
+		CHECK(std::abs(unpackedVertex.uv.x - vertex.uv.x) <= 1.f / 2048.f);
+		CHECK(std::abs(unpackedVertex.uv.y - vertex.uv.y) <= 1.f / 2048.f);
+	}
+
+	// The axes and the corners of the octahedron, on both halves.
+	for (const XMFLOAT3& normal : {
+		XMFLOAT3{ 1.f, 0.f, 0.f }, XMFLOAT3{ -1.f, 0.f, 0.f }, XMFLOAT3{ 0.f, 1.f, 0.f },
+		XMFLOAT3{ 0.f, -1.f, 0.f }, XMFLOAT3{ 0.f, 0.f, 1.f }, XMFLOAT3{ 0.f, 0.f, -1.f }
+	}) {
+		const Vertex unpackedVertex = VertexPacker::UnpackVertex(
+			VertexPacker::PackVertex(
+				Vertex{ .position = {}, .normal = normal, .uv = {} }, bounds
+			),
+			bounds
+		);
+
+		CHECK(GetAngle(unpackedVertex.normal, normal) < 0.01f);
+	}
+}
+
+static void TestBoundsEdges() {
+	const ModelBounds bounds{
+		.positiveAxes = { 1.f, 5.f, 3.f }, .negativeAxes = { -1.f, 5.f, -3.f }
+	};
+
+	const PackedVertex minimum = VertexPacker::PackVertex(
+		Vertex{ .position = { -1.f, 5.f, -3.f }, .normal = {}, .uv = {} }, bounds
+	);
+	const PackedVertex maximum = VertexPacker::PackVertex(
+		Vertex{ .position = { 1.f, 5.f, 3.f }, .normal = {}, .uv = {} }, bounds
+	);
+
+	CHECK(minimum.position.x == 0u && minimum.position.z == 0u);
+	CHECK(maximum.position.x == 65535u && maximum.position.z == 65535u);
+
+	// A flat axis decodes to its one value.
+	CHECK(VertexPacker::UnpackVertex(maximum, bounds).position.y == 5.f);
+
+	// Outside the box, so clamped to it.
+	const Vertex clamped = VertexPacker::UnpackVertex(
+		VertexPacker::PackVertex(
+			Vertex{ .position = { 4.f, 0.f, -9.f }, .normal = {}, .uv = {} }, bounds
+		),
+		bounds
+	);
+
+	CHECK(clamped.position.x == 1.f && clamped.position.y == 5.f && clamped.position.z == -3.f);
+}
+
+struct TestMesh {
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	std::vector<std::shared_ptr<IModel>> models;
+};
+
+// Two grids in boxes of their own, and a vertex no model uses.
+static TestMesh CreateMesh(Random& random) {
+	TestMesh mesh{};
+
+	AppendGrid(80u, 60u, mesh.vertices, mesh.indices);
+
+	const auto firstIndexCount = static_cast<std::uint32_t>(std::size(mesh.indices));
+
+	mesh.models.emplace_back(
+		std::make_shared<TestModel>(
+			0u, firstIndexCount,
+			ModelBounds{
+				.positiveAxes = { 80.f, 60.f, 0.f }, .negativeAxes = { 0.f, 0.f, 0.f }
+			}
+		)
+	);
+
+	// Drawn twice with the same box.
+	mesh.models.emplace_back(
+		std::make_shared<TestModel>(0u, firstIndexCount, mesh.models[0]->GetBoundingBox())
+	);
+
+	AppendGrid(4u, 4u, mesh.vertices, mesh.indices);
+
+	mesh.models.emplace_back(
+		std::make_shared<TestModel>(
+			firstIndexCount, static_cast<std::uint32_t>(std::size(mesh.indices)) - firstIndexCount,
+			ModelBounds{
+				.positiveAxes = { 4.f, 4.f, 1.f }, .negativeAxes = { 0.f, 0.f, -1.f }
+			}
+		)
+	);
+
+	for (Vertex& vertex : mesh.vertices)
+		vertex.normal = RandomNormal(random);
+
+	mesh.vertices.emplace_back(
+		Vertex{ .position = { -20.f, 3.f, 7.f }, .normal = { 0.f, 1.f, 0.f }, .uv = {} }
+	);
+
+	return mesh;
+}
+
+static void TestPackVertices() {
+	Random random{ 41u };
+	const TestMesh mesh = CreateMesh(random);
+	const VertexPacker packer{ {} };
+
+	const std::vector<PackedVertex> packedVertices = packer.PackVertices(
+		mesh.vertices, mesh.indices, mesh.models
+	);
+
+	CHECK(std::size(packedVertices) == std::size(mesh.vertices));
+
+	const VertexPacker::PackingError packingError = packer.GetPackingError(
+		mesh.vertices, packedVertices, mesh.indices, mesh.models
+	);
+
+	// The small grid's box is the tighter one, the unused vertex is packed in the box of all
+	// the vertices.
+	CHECK(packingError.maxPositionError <= 100.f / 65535.f);
+	// Measured with an arc cosine, which can't tell smaller angles apart.
+	CHECK(packingError.maxNormalError < 0.05f);
+	CHECK(packingError.maxUVError <= 1.f / 2048.f);
+
+	const ModelBounds smallBounds = mesh.models.back()->GetBoundingBox();
+	const Vertex corner = VertexPacker::UnpackVertex(packedVertices[81u * 61u + 24u], smallBounds);
+
+	CHECK(corner.position.x == 4.f && corner.position.y == 4.f);
+	CHECK(std::abs(corner.position.z) <= 2.f / 65535.f);
+
+	const ModelBounds vertexRange{
+		.positiveAxes = { 80.f, 60.f, 7.f }, .negativeAxes = { -20.f, 0.f, 0.f }
+	};
+	const Vertex unused = VertexPacker::UnpackVertex(packedVertices.back(), vertexRange);
+
+	CHECK(unused.position.x == -20.f && unused.position.z == 7.f);
+	CHECK(std::abs(unused.position.y - 3.f) <= 60.f / 65535.f);
+}
+
+static void TestThreadPool() {
+	Random random{ 43u };
+	const TestMesh mesh = CreateMesh(random);
+
+	WorkStealingThreadPool pool{ { .workerCount = 3u } };
+
+	// More vertices than one job packs.
+	const std::vector<PackedVertex> serialVertices = VertexPacker{ {} }.PackVertices(
+		mesh.vertices, mesh.indices, mesh.models
+	);
+	const std::vector<PackedVertex> parallelVertices = VertexPacker{
+		{ .threadPool = &pool }
+	}.PackVertices(mesh.vertices, mesh.indices, mesh.models);
+
+	CHECK(std::size(mesh.vertices) > 4096u);
+	CHECK(
+		std::ranges::equal(
+			serialVertices, parallelVertices,
+			[](const PackedVertex& left, const PackedVertex& right) {
+				return left.position.x == right.position.x && left.position.y == right.position.y
+					&& left.position.z == right.position.z && left.normal.x == right.normal.x
+					&& left.normal.y == right.normal.y && left.uv.x == right.uv.x
+					&& left.uv.y == right.uv.y;
+			}
+		)
+	);
+}
+
+template<typename Function>
+static bool Throws(Function&& function) {
+	try {
+		function();
+	}
+	catch (const Exception&) {
+		return true;
+	}
+
+	return false;
+}
+
+static void TestInvalidInput() {
+	Random random{ 47u };
+	const TestMesh mesh = CreateMesh(random);
+	const VertexPacker packer{ {} };
+
+	// The small grid's vertices in a model with another box.
+	CHECK(Throws([&] {
+		std::vector<std::shared_ptr<IModel>> models = mesh.models;
+		models.emplace_back(
+			std::make_shared<TestModel>(
+				mesh.models.back()->GetIndexOffset(), 3u, mesh.models.front()->GetBoundingBox()
+			)
+		);
+
+		static_cast<void>(packer.PackVertices(mesh.vertices, mesh.indices, models));
+	}));
+
+	CHECK(Throws([&] {
+		static_cast<void>(packer.PackVertices(
+			mesh.vertices, mesh.indices,
+			{
+				std::make_shared<TestModel>(
+					static_cast<std::uint32_t>(std::size(mesh.indices)) - 3u, 6u
+				)
+			}
+		));
+	}));
+
+	CHECK(Throws([&] {
+		std::vector<std::uint32_t> indices = mesh.indices;
+		indices[5] = static_cast<std::uint32_t>(std::size(mesh.vertices));
+
+		static_cast<void>(packer.PackVertices(mesh.vertices, indices, mesh.models));
+	}));
+
+	CHECK(Throws([&] {
+		static_cast<void>(packer.GetPackingError(
+			mesh.vertices, std::vector<PackedVertex>(3u), mesh.indices, mesh.models
+		));
+	}));
+}
+
+int main() {
+	TestRoundTrip();
+	TestBoundsEdges();
+	TestPackVertices();
+	TestThreadPool();
+	TestInvalidInput();
+
+	return failedChecks;
+}
@@ -0,0 +1,186 @@
+#include <WorkStealingThreadPool.hpp>
+#include <TestChecks.hpp>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+static void TestCounter() {
+	WorkStealingThreadPool pool{ { .workerCount = 3u } };
+
+	CHECK(pool.GetWorkerCount() == 3u);
+
+	std::atomic_size_t sum{ 0u };
+	JobCounter counter{};
+
+	for (size_t index = 1u; index <= 1000u; ++index)
+		pool.Submit([&sum, index] { sum += index; }, &counter);
+
+	pool.WaitAndHelp(counter);
+
+	CHECK(counter.IsDone());
+	CHECK(sum == 500500u);
+}
+
+static void TestNestedJobs() {
+	WorkStealingThreadPool pool{ { .workerCount = 2u } };
+
+	std::atomic_size_t jobsRun{ 0u };
+	JobCounter counter{};
+
+	// More nested jobs than a worker's deque holds, the rest run straight away.
+	for (size_t index = 0u; index < 4u; ++index)
+		pool.Submit(
+			[&pool, &jobsRun, &counter] {
+				for (size_t nestedIndex = 0u; nestedIndex < 2000u; ++nestedIndex)
+					pool.Submit([&jobsRun] { ++jobsRun; }, &counter);
+
+				++jobsRun;
+			}, &counter
+		);
+
+	pool.WaitAndHelp(counter);
+
+	CHECK(jobsRun == 4u * 2001u);
+}
+
+static void TestLargeCallable() {
+	WorkStealingThreadPool pool{ { .workerCount = 2u } };
+
+	// Larger than the inline storage of a job.
+	std::array<size_t, 32u> values{};
+	values.fill(3u);
+
+	std::atomic_size_t sum{ 0u };
+	JobCounter counter{};
+
+	for (size_t index = 0u; index < 10u; ++index)
+		pool.Submit(
+			[&sum, values] {
+				for (size_t value : values)
+					sum += value;
+			}, &counter
+		);
+
+	pool.Wait(counter);
+
+	CHECK(sum == 10u * 32u * 3u);
+}
+
+static void TestExceptions() {
+	WorkStealingThreadPool pool{ { .workerCount = 3u } };
+
+	std::atomic_size_t jobsRun{ 0u };
+	JobCounter counter{};
+
+	for (size_t index = 0u; index < 100u; ++index)
+		pool.Submit(
+			[&jobsRun, index] {
+				++jobsRun;
+
+				if (index % 40u == 7u)
+					throw std::runtime_error{ "Job failed" };
+			}, &counter
+		);
+
+	bool caught = false;
+
+	try {
+		pool.WaitAndHelp(counter);
+	}
+	catch (const std::runtime_error& error) {
+		caught = std::string_view{ error.what() } == "Job failed";
+	}
+
+	// The waiter only returns once every job has finished, the failed ones included.
+	CHECK(caught);
+	CHECK(counter.IsDone());
+	CHECK(jobsRun == 100u);
+
+	caught = false;
+
+	try {
+		pool.Wait(counter);
+	}
+	catch (const std::runtime_error&) {
+		caught = true;
+	}
+
+	CHECK(caught);
+}
+
+static void TestUncountedExceptions() {
+	// A single worker runs the injected jobs in order, so the counted one is the last.
+	WorkStealingThreadPool pool{ { .workerCount = 1u } };
+
+	std::atomic_size_t jobsRun{ 0u };
+
+	for (size_t index = 0u; index < 10u; ++index)
+		pool.SubmitWork([&jobsRun, index] {
+			++jobsRun;
+
+			if (index % 4u == 1u)
+				throw std::runtime_error{ "Job failed" };
+		});
+
+	JobCounter counter{};
+
+	pool.Submit([] {}, &counter);
+	pool.Wait(counter);
+
+	// The worker outlives the failed jobs.
+	CHECK(jobsRun == 10u);
+
+	bool caught = false;
+
+	try {
+		pool.RethrowUncountedException();
+	}
+	catch (const std::runtime_error& error) {
+		caught = std::string_view{ error.what() } == "Job failed";
+	}
+
+	CHECK(caught);
+
+	// It is only rethrown once.
+	caught = false;
+
+	try {
+		pool.RethrowUncountedException();
+	}
+	catch (...) {
+		caught = true;
+	}
+
+	CHECK(!caught);
+}
+
+static void TestSubmitWork() {
+	std::atomic_size_t jobsRun{ 0u };
+
+	{
+		WorkStealingThreadPool pool{ { .workerCount = 2u } };
+
+		for (size_t index = 0u; index < 200u; ++index)
+			pool.SubmitWork([&jobsRun] {
+				std::this_thread::yield();
+
+				++jobsRun;
+			});
+	}
+
+	// The workers finish the queued jobs before they stop.
+	CHECK(jobsRun == 200u);
+}
+
+int main() {
+	TestCounter();
+	TestNestedJobs();
+	TestLargeCallable();
+	TestExceptions();
+	TestUncountedExceptions();
+	TestSubmitWork();
+
+	return failedChecks;
+}